@@ -0,0 +1,105 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#include "CAddressLatencyCache.hpp"
+
+#include <algorithm>
+
+void CAddressLatencyCache::addSample(const Telegram::DcOption &address, qint64 latency)
+{
+    Entry &entry = m_entries[key(address)];
+    latency = qMax<qint64>(latency, 0);
+    entry.latency = (entry.latency < 0) ? latency : (3 * entry.latency + latency) / 4;
+    entry.failuresCount = 0;
+}
+
+void CAddressLatencyCache::addFailure(const Telegram::DcOption &address)
+{
+    ++m_entries[key(address)].failuresCount;
+}
+
+qint64 CAddressLatencyCache::latency(const Telegram::DcOption &address) const
+{
+    return m_entries.value(key(address)).latency;
+}
+
+QVector<Telegram::DcOption> CAddressLatencyCache::sorted(const QVector<Telegram::DcOption> &addresses) const
+{
+    QVector<Telegram::DcOption> known;
+    QVector<Telegram::DcOption> unknown;
+    QVector<Telegram::DcOption> failed;
+
+    for (const Telegram::DcOption &address : addresses) {
+        const Entry entry = m_entries.value(key(address));
+        if (entry.failuresCount) {
+            failed.append(address);
+        } else if (entry.latency >= 0) {
+            known.append(address);
+        } else {
+            unknown.append(address);
+        }
+    }
+
+    std::stable_sort(known.begin(), known.end(), [this](const Telegram::DcOption &left, const Telegram::DcOption &right) {
+        return latency(left) < latency(right);
+    });
+    std::stable_sort(failed.begin(), failed.end(), [this](const Telegram::DcOption &left, const Telegram::DcOption &right) {
+        return m_entries.value(key(left)).failuresCount < m_entries.value(key(right)).failuresCount;
+    });
+
+    return known + interleaved(unknown) + interleaved(failed);
+}
+
+bool CAddressLatencyCache::isIpv6(const Telegram::DcOption &address)
+{
+    return address.address.contains(QLatin1Char(':'));
+}
+
+QString CAddressLatencyCache::key(const Telegram::DcOption &address)
+{
+    return address.address + QLatin1Char('#') + QString::number(address.port);
+}
+
+QVector<Telegram::DcOption> CAddressLatencyCache::interleaved(const QVector<Telegram::DcOption> &addresses)
+{
+    if (addresses.isEmpty()) {
+        return addresses;
+    }
+
+    QVector<Telegram::DcOption> first;
+    QVector<Telegram::DcOption> second;
+    const bool firstIsIpv6 = isIpv6(addresses.first());
+    for (const Telegram::DcOption &address : addresses) {
+        if (isIpv6(address) == firstIsIpv6) {
+            first.append(address);
+        } else {
+            second.append(address);
+        }
+    }
+
+    QVector<Telegram::DcOption> result;
+    result.reserve(addresses.count());
+    for (int i = 0; i < qMax(first.count(), second.count()); ++i) {
+        if (i < first.count()) {
+            result.append(first.at(i));
+        }
+        if (i < second.count()) {
+            result.append(second.at(i));
+        }
+    }
+    return result;
+}
@@ -0,0 +1,59 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#ifndef CADDRESSLATENCYCACHE_HPP
+#define CADDRESSLATENCYCACHE_HPP
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include "TelegramNamespace.hpp"
+
+/* The measured connection latencies of the server addresses.
+ *
+ * It is used to order the addresses, which are raced on connect (see CTcpTransport::connectToHosts()):
+ * the addresses with a known latency go first (the fastest first), then the unknown ones and the failed
+ * ones are the last. Within each group the IPv6 and IPv4 addresses are interleaved, so a broken address
+ * family does not delay the other one.
+ */
+class CAddressLatencyCache
+{
+public:
+    void addSample(const Telegram::DcOption &address, qint64 latency); // In ms
+    void addFailure(const Telegram::DcOption &address);
+    void clear() { m_entries.clear(); }
+
+    qint64 latency(const Telegram::DcOption &address) const; // -1 if unknown
+
+    QVector<Telegram::DcOption> sorted(const QVector<Telegram::DcOption> &addresses) const;
+
+    static bool isIpv6(const Telegram::DcOption &address);
+
+protected:
+    struct Entry {
+        qint64 latency = -1;
+        int failuresCount = 0; // In a row
+    };
+
+    static QString key(const Telegram::DcOption &address);
+    static QVector<Telegram::DcOption> interleaved(const QVector<Telegram::DcOption> &addresses);
+
+    QHash<QString, Entry> m_entries;
+};
+
+#endif // CADDRESSLATENCYCACHE_HPP
@@ -0,0 +1,73 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#include "CAuthCryptoJob.hpp"
+
+#include "Utils.hpp"
+
+#include <QThreadPool>
+#include <QtEndian>
+
+CAuthCryptoJob::CAuthCryptoJob(Operation operation) :
+    QObject(),
+    m_operation(operation)
+{
+    // The pool must not delete the job: it is deleted in its own thread once the result is delivered
+    setAutoDelete(false);
+}
+
+CAuthCryptoJob *CAuthCryptoJob::rsaEncrypt(const QByteArray &data, const Telegram::RsaKey &key)
+{
+    CAuthCryptoJob *job = new CAuthCryptoJob(RsaEncrypt);
+    job->m_data = data;
+    job->m_modulus = key.modulus;
+    job->m_exponent = key.exponent;
+    return job;
+}
+
+CAuthCryptoJob *CAuthCryptoJob::dhExchange(quint32 g, const QByteArray &dhPrime, const QByteArray &gA, const QByteArray &b)
+{
+    CAuthCryptoJob *job = new CAuthCryptoJob(DhExchange);
+    job->m_data.resize(sizeof(g));
+    qToBigEndian(g, (uchar *) job->m_data.data());
+    job->m_modulus = dhPrime;
+    job->m_exponent = b;
+    job->m_secondData = gA;
+    return job;
+}
+
+void CAuthCryptoJob::start()
+{
+    // Connected after the receivers, so the job is still alive (e.g. for sender()) in their slots
+    connect(this, &CAuthCryptoJob::finished, this, &QObject::deleteLater);
+    QThreadPool::globalInstance()->start(this);
+}
+
+void CAuthCryptoJob::run()
+{
+    switch (m_operation) {
+    case RsaEncrypt:
+        emit finished(Utils::binaryNumberModExp(m_data, m_modulus, m_exponent), QByteArray());
+        break;
+    case DhExchange: {
+        const QByteArray gB = Utils::binaryNumberModExp(m_data, m_modulus, m_exponent);
+        const QByteArray authKey = Utils::binaryNumberModExp(m_secondData, m_modulus, m_exponent);
+        emit finished(gB, authKey);
+        break;
+    }
+    }
+}
@@ -0,0 +1,64 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#ifndef CAUTHCRYPTOJOB_HPP
+#define CAUTHCRYPTOJOB_HPP
+
+#include <QObject>
+#include <QRunnable>
+#include <QByteArray>
+
+#include "TelegramNamespace.hpp"
+
+/* The big number math of the auth key generation, computed on the global thread pool.
+ *
+ * The job lives in the thread which created it, so the finished() signal is delivered
+ * to the receivers there (queued) and the job deletes itself after the delivery.
+ * A job which is no longer needed is just disconnected from, it can not be cancelled.
+ */
+class CAuthCryptoJob : public QObject, public QRunnable
+{
+    Q_OBJECT
+public:
+    enum Operation {
+        RsaEncrypt, // The encrypted inner data of req_DH_params
+        DhExchange // g_b and the auth key of set_client_DH_params
+    };
+
+    static CAuthCryptoJob *rsaEncrypt(const QByteArray &data, const Telegram::RsaKey &key);
+    static CAuthCryptoJob *dhExchange(quint32 g, const QByteArray &dhPrime, const QByteArray &gA, const QByteArray &b);
+
+    Operation operation() const { return m_operation; }
+
+    void start(); // Connect to finished() before the start
+    void run() override;
+
+signals:
+    // RsaEncrypt: the encrypted data; DhExchange: g_b and the auth key
+    void finished(const QByteArray &result, const QByteArray &secondResult);
+
+protected:
+    explicit CAuthCryptoJob(Operation operation);
+
+    Operation m_operation;
+    QByteArray m_data;
+    QByteArray m_modulus;
+    QByteArray m_exponent;
+    QByteArray m_secondData;
+};
+
+#endif // CAUTHCRYPTOJOB_HPP
@@ -0,0 +1,169 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#include "CChannelDifferenceScheduler.hpp"
+
+#include <QDebug>
+
+CChannelDifferenceScheduler::CChannelDifferenceScheduler(int maxActiveRequests) :
+    m_maxActiveRequests(qMax(maxActiveRequests, 1)),
+    m_pausedUntil(0)
+{
+}
+
+void CChannelDifferenceScheduler::setMaxActiveRequests(int count)
+{
+    m_maxActiveRequests = qMax(count, 1);
+}
+
+void CChannelDifferenceScheduler::schedule(quint32 channelId, quint32 pts, quint32 priority)
+{
+    if (m_active.contains(channelId)) {
+        return;
+    }
+
+    Entry entry;
+    entry.pts = pts;
+    entry.priority = priority;
+
+    const auto it = m_pending.constFind(channelId);
+    if (it != m_pending.constEnd()) {
+        entry.pts = qMin(entry.pts, it->pts);
+        entry.priority = qMax(entry.priority, it->priority);
+        entry.failures = it->failures;
+        entry.notBefore = it->notBefore;
+        m_queue.remove(queueKey(channelId, it->priority));
+    }
+    enqueue(channelId, entry);
+}
+
+bool CChannelDifferenceScheduler::takeNext(qint64 now, quint32 *channelId, quint32 *pts)
+{
+    if (m_queue.isEmpty() || (m_active.count() >= m_maxActiveRequests) || (now < m_pausedUntil)) {
+        return false;
+    }
+
+    // The highest priority first, except for the channels which wait for a retry
+    auto it = m_queue.end();
+    while (it != m_queue.begin()) {
+        --it;
+        const quint32 id = it.value();
+        if (m_pending.value(id).notBefore > now) {
+            continue;
+        }
+        m_queue.erase(it);
+        const Entry entry = m_pending.take(id);
+        m_active.insert(id, entry);
+
+        *channelId = id;
+        *pts = entry.pts;
+        return true;
+    }
+    return false;
+}
+
+void CChannelDifferenceScheduler::finish(quint32 channelId)
+{
+    m_active.remove(channelId);
+}
+
+void CChannelDifferenceScheduler::resume(quint32 channelId, quint32 pts)
+{
+    if (!m_active.contains(channelId)) {
+        qWarning() << Q_FUNC_INFO << "Unexpected channel" << channelId;
+        return;
+    }
+    Entry entry = m_active.take(channelId);
+    entry.pts = pts;
+    entry.priority = 0xffffffffu; // Finish the started channel first
+    entry.failures = 0;
+    entry.notBefore = 0;
+    enqueue(channelId, entry);
+}
+
+void CChannelDifferenceScheduler::floodWait(quint32 channelId, int seconds, qint64 now)
+{
+    m_pausedUntil = qMax(m_pausedUntil, now + qint64(seconds) * 1000);
+    if (m_active.contains(channelId)) {
+        enqueue(channelId, m_active.take(channelId));
+    }
+}
+
+bool CChannelDifferenceScheduler::retry(quint32 channelId, qint64 now)
+{
+    if (!m_active.contains(channelId)) {
+        qWarning() << Q_FUNC_INFO << "Unexpected channel" << channelId;
+        return false;
+    }
+    Entry entry = m_active.take(channelId);
+    ++entry.failures;
+    if (entry.failures > maxRetries()) {
+        return false;
+    }
+    entry.notBefore = now + retryDelay(entry.failures);
+    enqueue(channelId, entry);
+    return true;
+}
+
+qint64 CChannelDifferenceScheduler::retryDelay(int failures)
+{
+    static const qint64 baseDelay = 1000;
+    static const qint64 maxDelay = 60 * 1000;
+    if (failures < 1) {
+        return 0;
+    }
+    return qMin(baseDelay << qMin(failures - 1, 16), maxDelay);
+}
+
+void CChannelDifferenceScheduler::requeueActive()
+{
+    for (auto it = m_active.constBegin(); it != m_active.constEnd(); ++it) {
+        enqueue(it.key(), it.value());
+    }
+    m_active.clear();
+}
+
+void CChannelDifferenceScheduler::clear()
+{
+    m_queue.clear();
+    m_pending.clear();
+    m_active.clear();
+    m_pausedUntil = 0;
+}
+
+qint64 CChannelDifferenceScheduler::nextRequestTime(qint64 now) const
+{
+    if (m_queue.isEmpty() || (m_active.count() >= m_maxActiveRequests)) {
+        return -1;
+    }
+    qint64 readyTime = -1;
+    for (const Entry &entry : m_pending) {
+        if ((readyTime < 0) || (entry.notBefore < readyTime)) {
+            readyTime = entry.notBefore;
+        }
+        if (readyTime <= now) {
+            break;
+        }
+    }
+    return qMax(qMax(now, m_pausedUntil), readyTime);
+}
+
+void CChannelDifferenceScheduler::enqueue(quint32 channelId, const Entry &entry)
+{
+    m_pending.insert(channelId, entry);
+    m_queue.insert(queueKey(channelId, entry.priority), channelId);
+}
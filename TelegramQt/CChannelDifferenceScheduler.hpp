@@ -0,0 +1,83 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#ifndef CCHANNELDIFFERENCESCHEDULER_HPP
+#define CCHANNELDIFFERENCESCHEDULER_HPP
+
+#include <QHash>
+#include <QMap>
+
+/* Queue of the channels to catch up via updates.getChannelDifference.
+ *
+ * The channels are requested in order of priority (e.g. the date of the last dialog message),
+ * with at most maxActiveRequests() requests in flight. A flood wait pauses all the requests,
+ * a failed request is retried with an exponential backoff (per channel).
+ * The time is passed in by the caller (in milliseconds), so the scheduler has no timers.
+ */
+class CChannelDifferenceScheduler
+{
+public:
+    explicit CChannelDifferenceScheduler(int maxActiveRequests = 3);
+
+    int maxActiveRequests() const { return m_maxActiveRequests; }
+    void setMaxActiveRequests(int count);
+
+    int pendingCount() const { return m_pending.count(); }
+    int activeCount() const { return m_active.count(); }
+    bool isPending(quint32 channelId) const { return m_pending.contains(channelId); }
+    bool isActive(quint32 channelId) const { return m_active.contains(channelId); }
+
+    // A channel which is already pending keeps the lowest pts and the highest priority.
+    // An active channel is not scheduled again: the request in flight covers the new updates.
+    void schedule(quint32 channelId, quint32 pts, quint32 priority);
+
+    // Returns false if nothing can be requested now: the queue is empty,
+    // the active requests limit is reached or the requests are paused.
+    bool takeNext(qint64 now, quint32 *channelId, quint32 *pts);
+
+    void finish(quint32 channelId); // The channel is up to date (or can not be updated)
+    void resume(quint32 channelId, quint32 pts); // There is more to fetch, request it before the other channels
+    void floodWait(quint32 channelId, int seconds, qint64 now);
+    // The request got no answer. Returns false if the channel is dropped after maxRetries() failures.
+    bool retry(quint32 channelId, qint64 now);
+    static int maxRetries() { return 5; }
+    static qint64 retryDelay(int failures); // In milliseconds
+    void requeueActive(); // The requests in flight are lost (e.g. on reconnection)
+    void clear();
+
+    // The time to call takeNext() again, or -1 if it depends on a request in flight (or nothing is pending)
+    qint64 nextRequestTime(qint64 now) const;
+
+protected:
+    struct Entry {
+        quint32 pts = 0;
+        quint32 priority = 0;
+        int failures = 0;
+        qint64 notBefore = 0; // The retry time
+    };
+
+    static quint64 queueKey(quint32 channelId, quint32 priority) { return (quint64(priority) << 32) | channelId; }
+    void enqueue(quint32 channelId, const Entry &entry);
+
+    int m_maxActiveRequests;
+    qint64 m_pausedUntil;
+    QMap<quint64, quint32> m_queue; // Queue key (the highest is the next), channel id
+    QHash<quint32, Entry> m_pending;
+    QHash<quint32, Entry> m_active;
+};
+
+#endif // CCHANNELDIFFERENCESCHEDULER_HPP
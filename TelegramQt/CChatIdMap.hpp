@@ -0,0 +1,95 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#ifndef CCHATIDMAP_HPP
+#define CCHATIDMAP_HPP
+
+#include <QDebug>
+#include <QVector>
+
+#include "CPeerTable.hpp"
+
+/* Bidirectional map of the Telegram chat ids and the "public chat ids".
+ *
+ * A public chat id is the index of the chat in the order of appearance. It never changes
+ * while the map lives, so the ids vector can be saved and restored as is.
+ */
+class CChatIdMap
+{
+public:
+    int count() const { return m_chatIds.count(); }
+    bool isEmpty() const { return m_chatIds.isEmpty(); }
+    bool contains(quint32 chatId) const { return m_publicIds.contains(chatId); }
+
+    const QVector<quint32> &chatIds() const { return m_chatIds; } // Index is the public chat id
+
+    int publicId(quint32 chatId) const
+    {
+        const int *publicId = m_publicIds.find(chatId);
+        return publicId ? *publicId : -1;
+    }
+
+    quint32 chatId(int publicId) const
+    {
+        return m_chatIds.value(publicId);
+    }
+
+    // Returns true if the chat id is new to the map
+    bool insert(quint32 chatId, int *publicId = nullptr)
+    {
+        bool inserted = false;
+        int &id = m_publicIds.findOrInsert(chatId, &inserted);
+        if (inserted) {
+            id = m_chatIds.count();
+            m_chatIds.append(chatId);
+        }
+        if (publicId) {
+            *publicId = id;
+        }
+        return inserted;
+    }
+
+    void setChatIds(const QVector<quint32> &chatIds)
+    {
+        clear();
+        m_publicIds.reserve(chatIds.count());
+        m_chatIds.reserve(chatIds.count());
+        for (quint32 chatId : chatIds) {
+            bool inserted = false;
+            int &id = m_publicIds.findOrInsert(chatId, &inserted);
+            if (inserted) {
+                id = m_chatIds.count();
+            } else {
+                // Keep the slot, so the public ids of the next chats match the saved data
+                qWarning() << "CChatIdMap::setChatIds(): Duplicated chat id" << chatId;
+            }
+            m_chatIds.append(chatId);
+        }
+    }
+
+    void clear()
+    {
+        m_chatIds.clear();
+        m_publicIds.clear();
+    }
+
+protected:
+    QVector<quint32> m_chatIds;
+    CPeerTable<quint32, int> m_publicIds;
+};
+
+#endif // CCHATIDMAP_HPP
@@ -0,0 +1,53 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#include "CChatParticipants.hpp"
+
+#include <algorithm>
+
+void CChatParticipants::setUserIds(const QVector<quint32> &userIds)
+{
+    m_userIds = userIds;
+    std::sort(m_userIds.begin(), m_userIds.end());
+    m_userIds.erase(std::unique(m_userIds.begin(), m_userIds.end()), m_userIds.end());
+    m_userIds.squeeze();
+
+    m_set.clear();
+    m_set.reserve(m_userIds.count());
+    for (quint32 userId : m_userIds) {
+        m_set.insert(userId);
+    }
+}
+
+bool CChatParticipants::addUserId(quint32 userId)
+{
+    if (m_set.contains(userId)) {
+        return false;
+    }
+    m_set.insert(userId);
+    m_userIds.insert(std::lower_bound(m_userIds.begin(), m_userIds.end(), userId), userId);
+    return true;
+}
+
+bool CChatParticipants::removeUserId(quint32 userId)
+{
+    if (!m_set.remove(userId)) {
+        return false;
+    }
+    m_userIds.erase(std::lower_bound(m_userIds.begin(), m_userIds.end(), userId));
+    return true;
+}
@@ -0,0 +1,46 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#ifndef CCHATPARTICIPANTS_HPP
+#define CCHATPARTICIPANTS_HPP
+
+#include <QSet>
+#include <QVector>
+
+/* Participants index of a chat or a channel.
+ *
+ * The set answers the membership queries, the sorted vector keeps the ids compact and ordered.
+ * A join or a leave of a single user updates the index in place.
+ */
+class CChatParticipants
+{
+public:
+    void setUserIds(const QVector<quint32> &userIds);
+    bool addUserId(quint32 userId);
+    bool removeUserId(quint32 userId);
+
+    bool contains(quint32 userId) const { return m_set.contains(userId); }
+    int count() const { return m_userIds.count(); }
+    bool isEmpty() const { return m_userIds.isEmpty(); }
+    const QVector<quint32> &userIds() const { return m_userIds; } // Sorted
+
+protected:
+    QSet<quint32> m_set;
+    QVector<quint32> m_userIds;
+};
+
+#endif // CCHATPARTICIPANTS_HPP
@@ -41,6 +41,13 @@ bool TcpTransport::setProxy(const QNetworkProxy &proxy)
     return true;
 }
 
+QAbstractSocket *TcpTransport::createSocket()
+{
+    QTcpSocket *socket = new QTcpSocket(this);
+    socket->setProxy(m_socket->proxy());
+    return socket;
+}
+
 void TcpTransport::writeEvent()
 {
     if (Q_LIKELY(m_sessionType != Unknown)) {
@@ -33,6 +33,7 @@ public:
     bool setProxy(const QNetworkProxy &proxy);
 
 protected:
+    QAbstractSocket *createSocket() override;
     void writeEvent() final;
 };
 
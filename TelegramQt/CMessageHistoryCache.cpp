@@ -0,0 +1,441 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#include "CMessageHistoryCache.hpp"
+
+#include <QDebug>
+
+CMessageHistoryCache::CMessageHistoryCache(int memoryLimit) :
+    m_memoryLimit(memoryLimit)
+{
+}
+
+void CMessageHistoryCache::setMemoryLimit(int bytesPerPeer)
+{
+    m_memoryLimit = qMax(0, bytesPerPeer);
+    if (m_memoryLimit == 0) {
+        clear();
+        return;
+    }
+
+    const QVector<Telegram::Peer> peers = m_histories.keys();
+    for (const Telegram::Peer &peer : peers) {
+        trim(m_histories.find(peer));
+    }
+}
+
+quint32 CMessageHistoryCache::topMessageId(const Telegram::Peer &peer) const
+{
+    const History *history = m_histories.find(peer);
+    return history ? history->topMessageId : 0;
+}
+
+int CMessageHistoryCache::totalCount(const Telegram::Peer &peer) const
+{
+    const History *history = m_histories.find(peer);
+    return history ? history->totalCount : -1;
+}
+
+int CMessageHistoryCache::cachedCount(const Telegram::Peer &peer) const
+{
+    const History *history = m_histories.find(peer);
+    if (!history) {
+        return 0;
+    }
+    int count = 0;
+    for (const Run &run : history->runs) {
+        count += run.messages.count();
+    }
+    return count;
+}
+
+int CMessageHistoryCache::cachedSize(const Telegram::Peer &peer) const
+{
+    const History *history = m_histories.find(peer);
+    return history ? history->size : 0;
+}
+
+QVector<TLMessage> CMessageHistoryCache::messages(const Telegram::Peer &peer, quint32 offset, quint32 limit, QVector<Request> *missing) const
+{
+    QVector<TLMessage> result;
+    const History *history = m_histories.find(peer);
+
+    quint64 end = quint64(offset) + limit;
+    if (history && (history->totalCount >= 0)) {
+        end = qMin<quint64>(end, quint32(history->totalCount));
+    }
+
+    const Run *previousRun = nullptr;
+    quint32 position = offset;
+
+    auto addGap = [&](quint32 gapEnd) {
+        if (!missing || (gapEnd <= position)) {
+            return;
+        }
+        Request request;
+        if (previousRun) {
+            request.offsetId = previousRun->messages.last().id;
+            request.addOffset = position - previousRun->end();
+        } else {
+            request.addOffset = position;
+        }
+        request.limit = gapEnd - position;
+        missing->append(request);
+    };
+
+    if (history) {
+        for (const Run &run : history->runs) {
+            if (position >= end) {
+                break;
+            }
+            if (run.end() <= position) {
+                previousRun = &run;
+                continue;
+            }
+            if (run.position >= end) {
+                break;
+            }
+            if (run.position > position) {
+                addGap(run.position);
+                position = run.position;
+            }
+            const quint32 runEnd = qMin<quint64>(run.end(), end);
+            for (quint32 i = position; i < runEnd; ++i) {
+                result.append(run.messages.at(i - run.position));
+            }
+            position = runEnd;
+            previousRun = &run;
+        }
+    }
+
+    if (position < end) {
+        addGap(end);
+    }
+
+    return result;
+}
+
+void CMessageHistoryCache::insertPage(const Telegram::Peer &peer, const Request &request, const TLMessagesMessages &page)
+{
+    if (m_memoryLimit == 0) {
+        return;
+    }
+
+    History *history = &m_histories.findOrInsert(peer);
+
+    quint32 start = 0;
+    if (!pageStart(*history, request, &start)) {
+        qDebug() << Q_FUNC_INFO << "Unable to place the page of" << peer.id << "at the message" << request.offsetId;
+        return;
+    }
+
+    quint32 previousId = request.offsetId;
+    for (const TLMessage &message : page.messages) {
+        if (message.id >= previousId) {
+            qWarning() << Q_FUNC_INFO << "Unexpected messages order" << message.id << "after" << previousId;
+            return;
+        }
+        previousId = message.id;
+    }
+
+    if (page.tlType != TLValue::MessagesMessages) {
+        history->totalCount = int(page.count);
+    } else if (!page.messages.isEmpty()) {
+        // Not a slice, so the page ends the history
+        history->totalCount = int(start + page.messages.count());
+    }
+
+    if (page.messages.isEmpty()) {
+        return;
+    }
+
+    history->topMessageId = qMax(history->topMessageId, page.messages.first().id);
+
+    Run run;
+    run.position = start;
+    run.messages = page.messages;
+    insertRun(history, run);
+    trim(history);
+}
+
+void CMessageHistoryCache::addNewMessage(const Telegram::Peer &peer, const TLMessage &message)
+{
+    if ((m_memoryLimit == 0) || (message.tlType == TLValue::MessageEmpty)) {
+        return;
+    }
+
+    History *history = &m_histories.findOrInsert(peer);
+    if (message.id <= history->topMessageId) {
+        // An out of order or an already known message; update the known ones only
+        for (Run &run : history->runs) {
+            for (TLMessage &cachedMessage : run.messages) {
+                if (cachedMessage.id == message.id) {
+                    history->size += messageSize(message) - messageSize(cachedMessage);
+                    cachedMessage = message;
+                    return;
+                }
+            }
+        }
+        return;
+    }
+
+    history->topMessageId = message.id;
+    shiftRuns(history, 0, 1);
+    if (history->totalCount >= 0) {
+        ++history->totalCount;
+    }
+
+    if (!history->runs.isEmpty() && (history->runs.first().position == 1)) {
+        Run &topRun = history->runs.first();
+        topRun.position = 0;
+        topRun.messages.prepend(message);
+    } else {
+        Run run;
+        run.messages.append(message);
+        history->runs.prepend(run);
+    }
+    history->size += messageSize(message);
+    trim(history);
+}
+
+void CMessageHistoryCache::addUnknownMessage(const Telegram::Peer &peer, quint32 messageId)
+{
+    History *history = m_histories.find(peer);
+    if (!history || (messageId <= history->topMessageId)) {
+        return;
+    }
+
+    // Keep the gap at the top, it is fetched on the next request of the newest messages
+    history->topMessageId = messageId;
+    shiftRuns(history, 0, 1);
+    if (history->totalCount >= 0) {
+        ++history->totalCount;
+    }
+}
+
+void CMessageHistoryCache::removeMessages(const QVector<quint32> &messageIds)
+{
+    const QVector<Telegram::Peer> peers = m_histories.keys();
+    for (const Telegram::Peer &peer : peers) {
+        if (peer.type == Telegram::Peer::Channel) {
+            continue;
+        }
+        History *history = m_histories.find(peer);
+        for (quint32 messageId : messageIds) {
+            removeMessage(history, messageId, /* exactPeer */ false);
+        }
+    }
+}
+
+void CMessageHistoryCache::removeMessages(const Telegram::Peer &peer, const QVector<quint32> &messageIds)
+{
+    History *history = m_histories.find(peer);
+    if (!history) {
+        return;
+    }
+    for (quint32 messageId : messageIds) {
+        removeMessage(history, messageId, /* exactPeer */ true);
+    }
+}
+
+void CMessageHistoryCache::clear(const Telegram::Peer &peer)
+{
+    m_histories.remove(peer);
+}
+
+void CMessageHistoryCache::clear()
+{
+    m_histories.clear();
+}
+
+int CMessageHistoryCache::messageSize(const TLMessage &message)
+{
+    int size = sizeof(TLMessage);
+    size += message.message.size() * sizeof(QChar);
+    size += message.media.caption.size() * sizeof(QChar);
+    size += message.entities.count() * sizeof(TLMessageEntity);
+    return size;
+}
+
+// The page starts right after the newest cached message which is not older than request.offsetId.
+// The position is known only if that message is the one at offsetId or it is followed by an older one.
+bool CMessageHistoryCache::pageStart(const CMessageHistoryCache::History &history, const Request &request, quint32 *start) const
+{
+    if (request.offsetId > history.topMessageId) {
+        *start = request.addOffset;
+        return true;
+    }
+
+    const Run *previousRun = nullptr;
+    for (const Run &run : history.runs) {
+        if (run.messages.last().id >= request.offsetId) {
+            previousRun = &run;
+            continue;
+        }
+        int index = 0;
+        while (run.messages.at(index).id >= request.offsetId) {
+            ++index;
+        }
+        if (index > 0) {
+            *start = run.position + index + request.addOffset;
+            return true;
+        }
+        break;
+    }
+
+    if (previousRun && (previousRun->messages.last().id == request.offsetId)) {
+        *start = previousRun->end() + request.addOffset;
+        return true;
+    }
+    return false;
+}
+
+// Merges the run with the cached ones. The new run data wins; the cache is reset if the runs disagree.
+void CMessageHistoryCache::insertRun(CMessageHistoryCache::History *history, const Run &run)
+{
+    Run merged = run;
+    QVector<Run> runs;
+    runs.reserve(history->runs.count() + 1);
+
+    for (const Run &cachedRun : history->runs) {
+        if ((cachedRun.end() < merged.position) || (cachedRun.position > merged.end())) {
+            runs.append(cachedRun);
+            continue;
+        }
+
+        const quint32 overlapBegin = qMax(cachedRun.position, merged.position);
+        const quint32 overlapEnd = qMin(cachedRun.end(), merged.end());
+        for (quint32 i = overlapBegin; i < overlapEnd; ++i) {
+            if (cachedRun.messages.at(i - cachedRun.position).id != merged.messages.at(i - merged.position).id) {
+                qDebug() << Q_FUNC_INFO << "The cached history is out of date, reset it";
+                history->runs = { run };
+                updateSize(history);
+                return;
+            }
+        }
+
+        Run result;
+        result.position = qMin(cachedRun.position, merged.position);
+        if (cachedRun.position < merged.position) {
+            result.messages = cachedRun.messages.mid(0, merged.position - cachedRun.position);
+        }
+        result.messages += merged.messages;
+        if (cachedRun.end() > merged.end()) {
+            result.messages += cachedRun.messages.mid(merged.end() - cachedRun.position);
+        }
+
+        // Adjacent runs must continue the id order
+        for (int i = 1; i < result.messages.count(); ++i) {
+            if (result.messages.at(i).id >= result.messages.at(i - 1).id) {
+                qDebug() << Q_FUNC_INFO << "The cached history is out of date, reset it";
+                history->runs = { run };
+                updateSize(history);
+                return;
+            }
+        }
+        merged = result;
+    }
+
+    int index = 0;
+    while ((index < runs.count()) && (runs.at(index).position < merged.position)) {
+        ++index;
+    }
+    runs.insert(index, merged);
+    history->runs = runs;
+    updateSize(history);
+}
+
+void CMessageHistoryCache::removeMessage(CMessageHistoryCache::History *history, quint32 messageId, bool exactPeer)
+{
+    for (int runIndex = 0; runIndex < history->runs.count(); ++runIndex) {
+        Run &run = history->runs[runIndex];
+        if (run.messages.last().id > messageId) {
+            continue;
+        }
+        if (run.messages.first().id < messageId) {
+            // The message is above the run
+            const bool inGap = (runIndex > 0) || (run.position > 0);
+            if (!inGap) {
+                return; // Newer than the top of the cache
+            }
+            if (exactPeer) {
+                shiftRuns(history, runIndex, -1);
+                if (history->totalCount > 0) {
+                    --history->totalCount;
+                }
+            } else {
+                // The message can belong to this peer, so the positions of the older runs are not known anymore
+                history->runs.resize(runIndex);
+                updateSize(history);
+            }
+            return;
+        }
+
+        for (int i = 0; i < run.messages.count(); ++i) {
+            if (run.messages.at(i).id != messageId) {
+                continue;
+            }
+            history->size -= messageSize(run.messages.at(i));
+            run.messages.remove(i);
+            if (run.messages.isEmpty()) {
+                history->runs.remove(runIndex);
+            } else {
+                ++runIndex;
+            }
+            shiftRuns(history, runIndex, -1);
+            if (history->totalCount > 0) {
+                --history->totalCount;
+            }
+            return;
+        }
+        return; // Within the run span, but not a message of the peer
+    }
+
+    // The message is older than the cached ones
+    if (exactPeer && (history->totalCount > 0)) {
+        --history->totalCount;
+    }
+}
+
+void CMessageHistoryCache::shiftRuns(CMessageHistoryCache::History *history, int firstRun, int delta)
+{
+    for (int i = firstRun; i < history->runs.count(); ++i) {
+        history->runs[i].position += delta;
+    }
+}
+
+void CMessageHistoryCache::trim(CMessageHistoryCache::History *history)
+{
+    while ((history->size > m_memoryLimit) && !history->runs.isEmpty()) {
+        Run &run = history->runs.last();
+        history->size -= messageSize(run.messages.last());
+        run.messages.removeLast();
+        if (run.messages.isEmpty()) {
+            history->runs.removeLast();
+        }
+    }
+}
+
+void CMessageHistoryCache::updateSize(CMessageHistoryCache::History *history)
+{
+    history->size = 0;
+    for (const Run &run : history->runs) {
+        for (const TLMessage &message : run.messages) {
+            history->size += messageSize(message);
+        }
+    }
+}
@@ -0,0 +1,95 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#ifndef CMESSAGEHISTORYCACHE_HPP
+#define CMESSAGEHISTORYCACHE_HPP
+
+#include <QVector>
+
+#include "CPeerTable.hpp"
+#include "TLTypes.hpp"
+#include "TelegramNamespace.hpp"
+
+/* Per-peer cache of the message history pages.
+ *
+ * The history of a peer is kept as id-sorted contiguous runs of messages. The position of
+ * a message is its offset from the newest message of the peer (the same as addOffset of
+ * messages.getHistory), so the runs are separated by gaps of known size and a page request
+ * is split into the cached part and the requests for the gaps. New messages shift all the
+ * positions by one. The oldest messages are dropped once a peer exceeds the memory limit.
+ */
+class CMessageHistoryCache
+{
+public:
+    struct Request {
+        quint32 offsetId = 0; // Zero means "above the newest message of the peer"
+        quint32 addOffset = 0;
+        quint32 limit = 0;
+    };
+
+    explicit CMessageHistoryCache(int memoryLimit = 0);
+
+    int memoryLimit() const { return m_memoryLimit; }
+    void setMemoryLimit(int bytesPerPeer); // Zero disables the cache
+
+    quint32 topMessageId(const Telegram::Peer &peer) const;
+    int totalCount(const Telegram::Peer &peer) const; // -1 if unknown
+    int cachedCount(const Telegram::Peer &peer) const;
+    int cachedSize(const Telegram::Peer &peer) const;
+
+    // Returns the cached messages of the [offset, offset + limit) window (newest first) and the requests to fetch the gaps
+    QVector<TLMessage> messages(const Telegram::Peer &peer, quint32 offset, quint32 limit, QVector<Request> *missing) const;
+
+    void insertPage(const Telegram::Peer &peer, const Request &request, const TLMessagesMessages &page);
+    void addNewMessage(const Telegram::Peer &peer, const TLMessage &message);
+    void addUnknownMessage(const Telegram::Peer &peer, quint32 messageId); // A new message with no data (e.g. a sent one)
+
+    void removeMessages(const QVector<quint32> &messageIds); // The user and chat message ids are shared by the peers
+    void removeMessages(const Telegram::Peer &peer, const QVector<quint32> &messageIds);
+
+    void clear(const Telegram::Peer &peer);
+    void clear();
+
+    static int messageSize(const TLMessage &message);
+
+protected:
+    struct Run {
+        quint32 position = 0;
+        QVector<TLMessage> messages; // Newest first
+
+        quint32 end() const { return position + messages.count(); }
+    };
+
+    struct History {
+        QVector<Run> runs; // Sorted by position, never adjacent
+        quint32 topMessageId = 0;
+        int totalCount = -1;
+        int size = 0;
+    };
+
+    bool pageStart(const History &history, const Request &request, quint32 *start) const;
+    void insertRun(History *history, const Run &run);
+    void removeMessage(History *history, quint32 messageId, bool exactPeer);
+    void shiftRuns(History *history, int firstRun, int delta);
+    void trim(History *history);
+    static void updateSize(History *history);
+
+    int m_memoryLimit;
+    CPeerTable<Telegram::Peer, History> m_histories;
+};
+
+#endif // CMESSAGEHISTORYCACHE_HPP
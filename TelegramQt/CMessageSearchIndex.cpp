@@ -0,0 +1,417 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#include "CMessageSearchIndex.hpp"
+
+#include "CRawStream.hpp"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QDebug>
+
+#include <algorithm>
+
+static const quint32 s_indexMagic = 0x49535154; // "TQSI"
+static const quint32 s_indexFormatVersion = 1;
+static const int s_minRecordsToCompact = 1024;
+static const int s_maxWordLength = 64;
+
+CMessageSearchIndex::CMessageSearchIndex(const QString &fileName) :
+    m_fileName(fileName)
+{
+}
+
+CMessageSearchIndex::~CMessageSearchIndex()
+{
+    sync();
+}
+
+bool CMessageSearchIndex::load()
+{
+    m_documents.clear();
+    m_documentIds.clear();
+    m_words.clear();
+    m_pendingRecords.clear();
+    m_fileRecordsCount = 0;
+    m_pendingRecordsCount = 0;
+
+    if (m_fileName.isEmpty()) {
+        return false;
+    }
+    QFile file(m_fileName);
+    if (!file.exists()) {
+        return false;
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << Q_FUNC_INFO << "Unable to open" << m_fileName << file.errorString();
+        return false;
+    }
+
+    CRawStreamEx stream(file.readAll());
+    file.close();
+
+    quint32 magic = 0;
+    quint32 format = 0;
+    stream >> magic;
+    stream >> format;
+    if (stream.error() || (magic != s_indexMagic) || (format != s_indexFormatVersion)) {
+        qDebug() << Q_FUNC_INFO << "Drop the index of unknown format" << format;
+        clear();
+        return false;
+    }
+
+    bool truncated = false;
+    while (!stream.atEnd()) {
+        quint8 type = 0;
+        quint8 peerType = 0;
+        Document document;
+        stream >> type;
+        stream >> peerType;
+        stream >> document.peer.id;
+        stream >> document.messageId;
+        document.peer.type = static_cast<Telegram::Peer::Type>(peerType);
+        if (type == RecordAdd) {
+            QByteArray text;
+            stream >> document.timestamp;
+            stream >> text;
+            document.text = QString::fromUtf8(text);
+        }
+        if (stream.error() || ((type != RecordAdd) && (type != RecordRemove))) {
+            // The application was terminated in the middle of a sync
+            truncated = true;
+            break;
+        }
+        if (type == RecordAdd) {
+            insertDocument(document);
+        } else {
+            removeDocument(messageKey(document.peer, document.messageId));
+        }
+        ++m_fileRecordsCount;
+    }
+
+    if (truncated || needsCompaction()) {
+        rewrite();
+    }
+    return !m_documents.isEmpty();
+}
+
+void CMessageSearchIndex::sync()
+{
+    if (m_pendingRecords.isEmpty() || m_fileName.isEmpty()) {
+        return;
+    }
+    if (needsCompaction()) {
+        rewrite();
+        return;
+    }
+
+    QFile file(m_fileName);
+    if (!file.open(QIODevice::WriteOnly|QIODevice::Append)) {
+        qWarning() << Q_FUNC_INFO << "Unable to open" << m_fileName << file.errorString();
+        return;
+    }
+    if (file.size() == 0) {
+        CRawStreamEx stream(&file);
+        stream << s_indexMagic;
+        stream << s_indexFormatVersion;
+    }
+    if (file.write(m_pendingRecords) != m_pendingRecords.size()) {
+        qWarning() << Q_FUNC_INFO << "Unable to write" << m_fileName << file.errorString();
+        return;
+    }
+    m_fileRecordsCount += m_pendingRecordsCount;
+    m_pendingRecordsCount = 0;
+    m_pendingRecords.clear();
+}
+
+void CMessageSearchIndex::clear()
+{
+    m_documents.clear();
+    m_documentIds.clear();
+    m_words.clear();
+    m_pendingRecords.clear();
+    m_fileRecordsCount = 0;
+    m_pendingRecordsCount = 0;
+    if (!m_fileName.isEmpty()) {
+        QFile::remove(m_fileName);
+    }
+}
+
+bool CMessageSearchIndex::contains(const Telegram::Peer &peer, quint32 messageId) const
+{
+    return m_documentIds.contains(messageKey(peer, messageId));
+}
+
+void CMessageSearchIndex::addMessage(const Telegram::Message &message)
+{
+    const quint64 key = messageKey(message.peer(), message.id);
+    if (const quint32 documentId = m_documentIds.value(key)) {
+        if (m_documents.value(documentId).text == message.text) {
+            return; // Nothing changed, do not grow the log
+        }
+    }
+
+    Document document;
+    document.peer = message.peer();
+    document.messageId = message.id;
+    document.timestamp = message.timestamp;
+    document.text = message.text;
+
+    if (document.text.isEmpty()) {
+        if (removeDocument(key)) {
+            appendRecord(RecordRemove, document);
+        }
+        return;
+    }
+
+    insertDocument(document);
+    appendRecord(RecordAdd, document);
+}
+
+void CMessageSearchIndex::removeMessages(const QVector<quint32> &messageIds)
+{
+    for (quint32 messageId : messageIds) {
+        // The key of a user or chat message does not depend on the peer
+        const quint32 documentId = m_documentIds.value(messageKey(Telegram::Peer(), messageId));
+        if (!documentId) {
+            continue;
+        }
+        const Document document = m_documents.value(documentId);
+        removeDocument(messageKey(document.peer, messageId));
+        appendRecord(RecordRemove, document);
+    }
+}
+
+void CMessageSearchIndex::removeMessages(const Telegram::Peer &peer, const QVector<quint32> &messageIds)
+{
+    for (quint32 messageId : messageIds) {
+        if (removeDocument(messageKey(peer, messageId))) {
+            Document document;
+            document.peer = peer;
+            document.messageId = messageId;
+            appendRecord(RecordRemove, document);
+        }
+    }
+}
+
+QVector<Telegram::Message> CMessageSearchIndex::search(const QString &query, const Telegram::Peer &peer, int limit) const
+{
+    QVector<Telegram::Message> result;
+
+    const QStringList words = query.split(QLatin1Char(' '), QString::SkipEmptyParts);
+    QVector<quint32> documentIds;
+    bool first = true;
+    for (const QString &queryWord : words) {
+        const bool prefix = queryWord.endsWith(QLatin1Char('*'));
+        const QStringList tokens = tokenize(queryWord);
+        for (int i = 0; i < tokens.count(); ++i) {
+            // Only the last token of a word like "e-mai*" is a prefix
+            const QVector<quint32> matches = matchingDocuments(tokens.at(i), prefix && (i == tokens.count() - 1));
+            if (first) {
+                documentIds = matches;
+                first = false;
+            } else {
+                QVector<quint32> intersection;
+                std::set_intersection(documentIds.constBegin(), documentIds.constEnd(),
+                                      matches.constBegin(), matches.constEnd(),
+                                      std::back_inserter(intersection));
+                documentIds = intersection;
+            }
+            if (documentIds.isEmpty()) {
+                return result;
+            }
+        }
+    }
+
+    QVector<const Document *> documents;
+    documents.reserve(documentIds.count());
+    for (quint32 documentId : documentIds) {
+        const Document &document = *m_documents.find(documentId);
+        if (peer.isValid() && !(document.peer == peer)) {
+            continue;
+        }
+        documents.append(&document);
+    }
+
+    auto newerDocument = [](const Document *left, const Document *right) {
+        return left->timestamp > right->timestamp;
+    };
+    if ((limit > 0) && (documents.count() > limit)) {
+        std::partial_sort(documents.begin(), documents.begin() + limit, documents.end(), newerDocument);
+        documents.resize(limit);
+    } else {
+        std::sort(documents.begin(), documents.end(), newerDocument);
+    }
+
+    result.reserve(documents.count());
+    for (const Document *document : documents) {
+        Telegram::Message message;
+        message.setPeer(document->peer);
+        message.fromId = 0;
+        message.id = document->messageId;
+        message.timestamp = document->timestamp;
+        message.text = document->text;
+        message.type = TelegramNamespace::MessageTypeText;
+        result.append(message);
+    }
+    return result;
+}
+
+QStringList CMessageSearchIndex::tokenize(const QString &text)
+{
+    QStringList result;
+    const QString foldedText = text.toCaseFolded();
+    int wordStart = -1;
+    for (int i = 0; i <= foldedText.size(); ++i) {
+        const bool isWordChar = (i < foldedText.size()) && foldedText.at(i).isLetterOrNumber();
+        if (isWordChar) {
+            if (wordStart < 0) {
+                wordStart = i;
+            }
+            continue;
+        }
+        if (wordStart >= 0) {
+            const QString word = foldedText.mid(wordStart, qMin(i - wordStart, s_maxWordLength));
+            if (!result.contains(word)) {
+                result.append(word);
+            }
+            wordStart = -1;
+        }
+    }
+    return result;
+}
+
+quint64 CMessageSearchIndex::messageKey(const Telegram::Peer &peer, quint32 messageId)
+{
+    // The user and chat messages share the ids, the channel ones are unique within the channel only
+    if (peer.type == Telegram::Peer::Channel) {
+        return (quint64(peer.id) << 32) | messageId;
+    }
+    return messageId;
+}
+
+void CMessageSearchIndex::insertDocument(const Document &document)
+{
+    const quint64 key = messageKey(document.peer, document.messageId);
+    removeDocument(key);
+
+    const quint32 documentId = m_nextDocumentId++;
+    m_documents.insert(documentId, document);
+    m_documentIds.insert(key, documentId);
+    for (const QString &word : tokenize(document.text)) {
+        // The ids grow, so appending keeps the list sorted
+        m_words[word].append(documentId);
+    }
+}
+
+bool CMessageSearchIndex::removeDocument(quint64 key)
+{
+    const quint32 documentId = m_documentIds.take(key);
+    if (!documentId) {
+        return false;
+    }
+
+    const Document document = m_documents.take(documentId);
+    for (const QString &word : tokenize(document.text)) {
+        auto it = m_words.find(word);
+        if (it == m_words.end()) {
+            continue;
+        }
+        QVector<quint32> &documentIds = it.value();
+        auto position = std::lower_bound(documentIds.begin(), documentIds.end(), documentId);
+        if ((position != documentIds.end()) && (*position == documentId)) {
+            documentIds.erase(position);
+        }
+        if (documentIds.isEmpty()) {
+            m_words.erase(it);
+        }
+    }
+    return true;
+}
+
+void CMessageSearchIndex::appendRecord(RecordType type, const Document &document)
+{
+    if (m_fileName.isEmpty()) {
+        return;
+    }
+
+    CRawStreamEx stream(&m_pendingRecords, /* write */ true);
+    stream << quint8(type);
+    stream << quint8(document.peer.type);
+    stream << document.peer.id;
+    stream << document.messageId;
+    if (type == RecordAdd) {
+        stream << document.timestamp;
+        stream << document.text.toUtf8();
+    }
+    ++m_pendingRecordsCount;
+}
+
+QVector<quint32> CMessageSearchIndex::matchingDocuments(const QString &word, bool prefix) const
+{
+    if (!prefix) {
+        return m_words.value(word);
+    }
+
+    QVector<quint32> result;
+    for (auto it = m_words.lowerBound(word); (it != m_words.constEnd()) && it.key().startsWith(word); ++it) {
+        result += it.value();
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+bool CMessageSearchIndex::needsCompaction() const
+{
+    const int recordsCount = m_fileRecordsCount + m_pendingRecordsCount;
+    return (recordsCount > s_minRecordsToCompact) && (recordsCount > m_documents.count() * 2);
+}
+
+bool CMessageSearchIndex::rewrite()
+{
+    QSaveFile file(m_fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << Q_FUNC_INFO << "Unable to open" << m_fileName << file.errorString();
+        return false;
+    }
+
+    m_pendingRecords.clear();
+    m_pendingRecordsCount = 0;
+
+    QVector<quint32> documentIds = m_documents.keys().toVector();
+    std::sort(documentIds.begin(), documentIds.end());
+    for (quint32 documentId : documentIds) {
+        appendRecord(RecordAdd, m_documents.value(documentId));
+    }
+
+    {
+        CRawStreamEx stream(&file);
+        stream << s_indexMagic;
+        stream << s_indexFormatVersion;
+    }
+    const bool written = file.write(m_pendingRecords) == m_pendingRecords.size();
+    if (!written || !file.commit()) {
+        qWarning() << Q_FUNC_INFO << "Unable to write" << m_fileName << file.errorString();
+        return false;
+    }
+
+    m_fileRecordsCount = m_pendingRecordsCount;
+    m_pendingRecordsCount = 0;
+    m_pendingRecords.clear();
+    return true;
+}
@@ -0,0 +1,96 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#ifndef CMESSAGESEARCHINDEX_HPP
+#define CMESSAGESEARCHINDEX_HPP
+
+#include <QByteArray>
+#include <QHash>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "TelegramNamespace.hpp"
+
+/* Local full-text index of the received messages text.
+ *
+ * The words of the messages are case folded and kept in a sorted map of the words to the sorted
+ * lists of the indexed messages (an inverted index), so a word is a single lookup and a prefix
+ * is a range of the map. The index is stored the same way as CPeerCache: an append-only log
+ * of the added and removed messages, rewritten once the removed ones dominate.
+ */
+class CMessageSearchIndex
+{
+public:
+    explicit CMessageSearchIndex(const QString &fileName = QString());
+    ~CMessageSearchIndex();
+
+    QString fileName() const { return m_fileName; }
+
+    bool load();
+    void sync();
+    void clear();
+
+    int count() const { return m_documents.count(); }
+    bool contains(const Telegram::Peer &peer, quint32 messageId) const;
+
+    void addMessage(const Telegram::Message &message); // Replaces the indexed text of a known message
+    void removeMessages(const QVector<quint32> &messageIds); // The user and chat message ids are shared by the peers
+    void removeMessages(const Telegram::Peer &peer, const QVector<quint32> &messageIds);
+
+    // The query words match the whole words of a message, a word ending with '*' matches as a prefix.
+    // The messages with all of the query words are returned, the newest first. An invalid peer means all peers.
+    QVector<Telegram::Message> search(const QString &query, const Telegram::Peer &peer = Telegram::Peer(), int limit = 50) const;
+
+    static QStringList tokenize(const QString &text);
+
+protected:
+    struct Document {
+        Telegram::Peer peer;
+        quint32 messageId = 0;
+        quint32 timestamp = 0;
+        QString text;
+    };
+
+    enum RecordType {
+        RecordAdd = 1,
+        RecordRemove,
+    };
+
+    static quint64 messageKey(const Telegram::Peer &peer, quint32 messageId);
+
+    void insertDocument(const Document &document);
+    bool removeDocument(quint64 key);
+    void appendRecord(RecordType type, const Document &document);
+    QVector<quint32> matchingDocuments(const QString &word, bool prefix) const;
+
+    bool needsCompaction() const;
+    bool rewrite();
+
+    QString m_fileName;
+    QHash<quint32, Document> m_documents; // Document id, document
+    QHash<quint64, quint32> m_documentIds; // Message key (see messageKey()), document id
+    QMap<QString, QVector<quint32> > m_words; // Word, sorted document ids
+    quint32 m_nextDocumentId = 1;
+
+    QByteArray m_pendingRecords;
+    int m_fileRecordsCount = 0;
+    int m_pendingRecordsCount = 0;
+};
+
+#endif // CMESSAGESEARCHINDEX_HPP
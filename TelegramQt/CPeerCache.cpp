@@ -0,0 +1,334 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#include "CPeerCache.hpp"
+
+#include "CTelegramStream.hpp"
+#include "CTelegramStreamExtraOperators.hpp"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QDebug>
+
+static const quint32 s_cacheMagic = 0x43505154; // "TQPC"
+static const quint32 s_cacheFormatVersion = 1;
+static const int s_minRecordsToCompact = 1024;
+
+CPeerCache::CPeerCache(const QString &fileName) :
+    m_fileName(fileName)
+{
+}
+
+CPeerCache::~CPeerCache()
+{
+    sync();
+}
+
+quint64 CPeerCache::recordKey(CPeerCache::RecordType type, quint32 id, quint8 peerType)
+{
+    return (quint64(type) << 40) | (quint64(peerType) << 32) | id;
+}
+
+template <typename T>
+void CPeerCache::insertValue(quint64 key, const T &value)
+{
+    QByteArray data;
+    CTelegramStream stream(&data, /* write */ true);
+    stream << value;
+    insertRecord(key, data);
+}
+
+template <typename T>
+T CPeerCache::value(quint64 key) const
+{
+    T result = T();
+    if (!m_records.contains(key)) {
+        return result;
+    }
+    CTelegramStream stream(m_records.value(key));
+    stream >> result;
+    if (stream.error()) {
+        return T();
+    }
+    return result;
+}
+
+template <typename T>
+QVector<T> CPeerCache::values(CPeerCache::RecordType type) const
+{
+    QVector<T> result;
+    for (auto it = m_records.constBegin(); it != m_records.constEnd(); ++it) {
+        if (recordType(it.key()) != type) {
+            continue;
+        }
+        CTelegramStream stream(it.value());
+        T item;
+        stream >> item;
+        if (stream.error() || !item.isValid()) {
+            qWarning() << Q_FUNC_INFO << "Skip a broken record";
+            continue;
+        }
+        result.append(item);
+    }
+    return result;
+}
+
+bool CPeerCache::load()
+{
+    m_records.clear();
+    m_pendingRecords.clear();
+    m_fileRecordsCount = 0;
+    m_pendingRecordsCount = 0;
+
+    QFile file(m_fileName);
+    if (!file.exists()) {
+        return false;
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << Q_FUNC_INFO << "Unable to open" << m_fileName << file.errorString();
+        return false;
+    }
+
+    CRawStreamEx stream(file.readAll());
+    file.close();
+
+    quint32 magic = 0;
+    quint32 format = 0;
+    quint32 layer = 0;
+    stream >> magic;
+    stream >> format;
+    stream >> layer;
+    if (stream.error() || (magic != s_cacheMagic) || (format != s_cacheFormatVersion) || (layer != TLValue::CurrentLayer)) {
+        qDebug() << Q_FUNC_INFO << "Drop the cache of unknown format" << format << "layer" << layer;
+        clear();
+        return false;
+    }
+
+    bool truncated = false;
+    while (!stream.atEnd()) {
+        quint64 key = 0;
+        QByteArray data;
+        stream >> key;
+        stream >> data;
+        if (stream.error()) {
+            // The application was terminated in the middle of a sync
+            truncated = true;
+            break;
+        }
+        if (data.isEmpty()) {
+            m_records.remove(key);
+        } else {
+            m_records.insert(key, data);
+        }
+        ++m_fileRecordsCount;
+    }
+
+    if (truncated || needsCompaction()) {
+        rewrite();
+    }
+    return !m_records.isEmpty();
+}
+
+void CPeerCache::sync()
+{
+    if (m_pendingRecords.isEmpty()) {
+        return;
+    }
+    if (needsCompaction()) {
+        rewrite();
+        return;
+    }
+
+    QFile file(m_fileName);
+    if (!file.open(QIODevice::WriteOnly|QIODevice::Append)) {
+        qWarning() << Q_FUNC_INFO << "Unable to open" << m_fileName << file.errorString();
+        return;
+    }
+    if (file.size() == 0) {
+        CRawStreamEx stream(&file);
+        stream << s_cacheMagic;
+        stream << s_cacheFormatVersion;
+        stream << TLValue::CurrentLayer;
+    }
+    if (file.write(m_pendingRecords) != m_pendingRecords.size()) {
+        qWarning() << Q_FUNC_INFO << "Unable to write" << m_fileName << file.errorString();
+        return;
+    }
+    m_fileRecordsCount += m_pendingRecordsCount;
+    m_pendingRecordsCount = 0;
+    m_pendingRecords.clear();
+}
+
+void CPeerCache::clear()
+{
+    m_records.clear();
+    m_pendingRecords.clear();
+    m_fileRecordsCount = 0;
+    m_pendingRecordsCount = 0;
+    QFile::remove(m_fileName);
+}
+
+quint32 CPeerCache::selfUserId() const
+{
+    return value<quint32>(recordKey(RecordSelfUserId));
+}
+
+quint32 CPeerCache::maxMessageId() const
+{
+    return value<quint32>(recordKey(RecordMaxMessageId));
+}
+
+QVector<quint32> CPeerCache::contactIdList() const
+{
+    return value<TLVector<quint32>>(recordKey(RecordContactIdList));
+}
+
+QVector<TLUser> CPeerCache::users() const
+{
+    return values<TLUser>(RecordUser);
+}
+
+QVector<TLChat> CPeerCache::chats() const
+{
+    return values<TLChat>(RecordChat);
+}
+
+QVector<TLChatFull> CPeerCache::fullChats() const
+{
+    return values<TLChatFull>(RecordFullChat);
+}
+
+QVector<TLDialog> CPeerCache::dialogs() const
+{
+    return values<TLDialog>(RecordDialog);
+}
+
+void CPeerCache::setSelfUserId(quint32 userId)
+{
+    insertValue(recordKey(RecordSelfUserId), userId);
+}
+
+void CPeerCache::setMaxMessageId(quint32 messageId)
+{
+    insertValue(recordKey(RecordMaxMessageId), messageId);
+}
+
+void CPeerCache::setContactIdList(const QVector<quint32> &contactIdList)
+{
+    insertValue(recordKey(RecordContactIdList), TLVector<quint32>(contactIdList));
+}
+
+void CPeerCache::insertUser(const TLUser &user)
+{
+    insertValue(recordKey(RecordUser, user.id), user);
+}
+
+void CPeerCache::insertChat(const TLChat &chat)
+{
+    insertValue(recordKey(RecordChat, chat.id), chat);
+}
+
+void CPeerCache::insertFullChat(const TLChatFull &chat)
+{
+    insertValue(recordKey(RecordFullChat, chat.id), chat);
+}
+
+void CPeerCache::insertDialog(const Telegram::Peer &peer, const TLDialog &dialog)
+{
+    insertValue(recordKey(RecordDialog, peer.id, peer.type), dialog);
+}
+
+void CPeerCache::removeChat(quint32 chatId)
+{
+    removeRecord(recordKey(RecordChat, chatId));
+}
+
+void CPeerCache::removeFullChat(quint32 chatId)
+{
+    removeRecord(recordKey(RecordFullChat, chatId));
+}
+
+void CPeerCache::removeDialog(const Telegram::Peer &peer)
+{
+    removeRecord(recordKey(RecordDialog, peer.id, peer.type));
+}
+
+void CPeerCache::insertRecord(quint64 key, const QByteArray &data)
+{
+    auto it = m_records.find(key);
+    if (it != m_records.end()) {
+        if (it.value() == data) {
+            return; // Nothing changed, do not grow the log
+        }
+        it.value() = data;
+    } else {
+        m_records.insert(key, data);
+    }
+    appendRecord(key, data);
+}
+
+void CPeerCache::removeRecord(quint64 key)
+{
+    if (!m_records.remove(key)) {
+        return;
+    }
+    appendRecord(key, QByteArray());
+}
+
+void CPeerCache::appendRecord(quint64 key, const QByteArray &data)
+{
+    CRawStreamEx stream(&m_pendingRecords, /* write */ true);
+    stream << key;
+    stream << data;
+    ++m_pendingRecordsCount;
+}
+
+bool CPeerCache::needsCompaction() const
+{
+    const int recordsCount = m_fileRecordsCount + m_pendingRecordsCount;
+    return (recordsCount > s_minRecordsToCompact) && (recordsCount > m_records.count() * 2);
+}
+
+bool CPeerCache::rewrite()
+{
+    QSaveFile file(m_fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << Q_FUNC_INFO << "Unable to open" << m_fileName << file.errorString();
+        return false;
+    }
+
+    {
+        CRawStreamEx stream(&file);
+        stream << s_cacheMagic;
+        stream << s_cacheFormatVersion;
+        stream << TLValue::CurrentLayer;
+        for (auto it = m_records.constBegin(); it != m_records.constEnd(); ++it) {
+            stream << it.key();
+            stream << it.value();
+        }
+    }
+
+    if (!file.commit()) {
+        qWarning() << Q_FUNC_INFO << "Unable to write" << m_fileName << file.errorString();
+        return false;
+    }
+
+    m_fileRecordsCount = m_records.count();
+    m_pendingRecordsCount = 0;
+    m_pendingRecords.clear();
+    return true;
+}
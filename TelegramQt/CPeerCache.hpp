@@ -0,0 +1,103 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#ifndef CPEERCACHE_HPP
+#define CPEERCACHE_HPP
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include "TLTypes.hpp"
+#include "TelegramNamespace.hpp"
+
+/* Persistent storage of the users, chats and dialogs of an account.
+ *
+ * The file is an append-only log of records, each one is a key and a TL-serialized value.
+ * The last record of a key wins, so a change costs one appended record and loading is
+ * a single sequential read. A record with an empty value removes the key.
+ * The log is rewritten once the superseded records dominate.
+ */
+class CPeerCache
+{
+public:
+    explicit CPeerCache(const QString &fileName);
+    ~CPeerCache();
+
+    QString fileName() const { return m_fileName; }
+
+    bool load();
+    void sync();
+    void clear();
+
+    bool isEmpty() const { return m_records.isEmpty(); }
+
+    quint32 selfUserId() const;
+    quint32 maxMessageId() const;
+    QVector<quint32> contactIdList() const;
+    QVector<TLUser> users() const;
+    QVector<TLChat> chats() const;
+    QVector<TLChatFull> fullChats() const;
+    QVector<TLDialog> dialogs() const;
+
+    void setSelfUserId(quint32 userId);
+    void setMaxMessageId(quint32 messageId);
+    void setContactIdList(const QVector<quint32> &contactIdList);
+    void insertUser(const TLUser &user);
+    void insertChat(const TLChat &chat);
+    void insertFullChat(const TLChatFull &chat);
+    void insertDialog(const Telegram::Peer &peer, const TLDialog &dialog);
+    void removeChat(quint32 chatId);
+    void removeFullChat(quint32 chatId);
+    void removeDialog(const Telegram::Peer &peer);
+
+protected:
+    enum RecordType {
+        RecordSelfUserId = 1,
+        RecordMaxMessageId,
+        RecordContactIdList,
+        RecordUser,
+        RecordChat,
+        RecordFullChat,
+        RecordDialog,
+    };
+
+    static quint64 recordKey(RecordType type, quint32 id = 0, quint8 peerType = 0);
+    static RecordType recordType(quint64 key) { return static_cast<RecordType>(key >> 40); }
+
+    template <typename T>
+    void insertValue(quint64 key, const T &value);
+    template <typename T>
+    T value(quint64 key) const;
+    template <typename T>
+    QVector<T> values(RecordType type) const;
+
+    void insertRecord(quint64 key, const QByteArray &data);
+    void removeRecord(quint64 key);
+    void appendRecord(quint64 key, const QByteArray &data);
+    bool needsCompaction() const;
+    bool rewrite();
+
+    QString m_fileName;
+    QHash<quint64, QByteArray> m_records;
+    QByteArray m_pendingRecords;
+    int m_fileRecordsCount = 0;
+    int m_pendingRecordsCount = 0;
+};
+
+#endif // CPEERCACHE_HPP
@@ -0,0 +1,263 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#ifndef CPEERTABLE_HPP
+#define CPEERTABLE_HPP
+
+#include <QVector>
+
+#include "TelegramNamespace.hpp"
+
+/* Open addressing (linear probing) hash table indexed by a peer or by an id of a peer of known type.
+ *
+ * The keys are packed into a single integer, so a probe is one comparison and the buckets are
+ * contiguous. find() and findOrInsert() do a single lookup where QHash code needs contains()
+ * followed by value() or operator[]. The rest of the API follows QHash.
+ */
+template <typename Key>
+struct CPeerTableKey;
+
+template <>
+struct CPeerTableKey<Telegram::Peer>
+{
+    static quint64 pack(const Telegram::Peer &peer) { return (quint64(peer.type) << 32) | peer.id; }
+    static Telegram::Peer unpack(quint64 key) { return Telegram::Peer(quint32(key), static_cast<Telegram::Peer::Type>(key >> 32)); }
+};
+
+template <>
+struct CPeerTableKey<quint32>
+{
+    static quint64 pack(quint32 id) { return id; }
+    static quint32 unpack(quint64 key) { return quint32(key); }
+};
+
+template <typename Key, typename T>
+class CPeerTable
+{
+    static constexpr quint64 c_emptyKey = ~quint64(0); // Can not be produced by pack()
+    static constexpr int c_minCapacity = 16;
+
+    struct Bucket {
+        quint64 key = c_emptyKey;
+        T value = T();
+    };
+
+public:
+    class const_iterator
+    {
+    public:
+        const_iterator() = default;
+
+        Key key() const { return CPeerTableKey<Key>::unpack(m_bucket->key); }
+        const T &value() const { return m_bucket->value; }
+        const T &operator*() const { return m_bucket->value; }
+        const T *operator->() const { return &m_bucket->value; }
+
+        const_iterator &operator++()
+        {
+            ++m_bucket;
+            skipEmpty();
+            return *this;
+        }
+
+        bool operator==(const const_iterator &another) const { return m_bucket == another.m_bucket; }
+        bool operator!=(const const_iterator &another) const { return m_bucket != another.m_bucket; }
+
+    protected:
+        friend class CPeerTable;
+        const_iterator(const Bucket *bucket, const Bucket *end) :
+            m_bucket(bucket),
+            m_end(end)
+        {
+            skipEmpty();
+        }
+
+        void skipEmpty()
+        {
+            while ((m_bucket != m_end) && (m_bucket->key == c_emptyKey)) {
+                ++m_bucket;
+            }
+        }
+
+        const Bucket *m_bucket = nullptr;
+        const Bucket *m_end = nullptr;
+    };
+
+    int count() const { return m_count; }
+    int size() const { return m_count; }
+    bool isEmpty() const { return m_count == 0; }
+
+    void clear()
+    {
+        m_buckets.clear();
+        m_count = 0;
+    }
+
+    void reserve(int size)
+    {
+        int capacity = c_minCapacity;
+        while (!fits(size, capacity)) {
+            capacity *= 2;
+        }
+        if (capacity > m_buckets.count()) {
+            rehash(capacity);
+        }
+    }
+
+    const T *find(const Key &key) const
+    {
+        const int index = indexOf(CPeerTableKey<Key>::pack(key));
+        return index < 0 ? nullptr : &m_buckets.at(index).value;
+    }
+
+    T *find(const Key &key)
+    {
+        const int index = indexOf(CPeerTableKey<Key>::pack(key));
+        return index < 0 ? nullptr : &m_buckets[index].value;
+    }
+
+    T &findOrInsert(const Key &key, bool *inserted = nullptr)
+    {
+        if (!fits(m_count + 1, m_buckets.count())) {
+            rehash(qMax(int(c_minCapacity), m_buckets.count() * 2));
+        }
+
+        const quint64 packedKey = CPeerTableKey<Key>::pack(key);
+        const int mask = m_buckets.count() - 1;
+        Bucket *buckets = m_buckets.data();
+        int index = bucketIndex(packedKey);
+        while (buckets[index].key != c_emptyKey) {
+            if (buckets[index].key == packedKey) {
+                if (inserted) {
+                    *inserted = false;
+                }
+                return buckets[index].value;
+            }
+            index = (index + 1) & mask;
+        }
+        buckets[index].key = packedKey;
+        ++m_count;
+        if (inserted) {
+            *inserted = true;
+        }
+        return buckets[index].value;
+    }
+
+    bool contains(const Key &key) const { return find(key); }
+
+    T value(const Key &key, const T &defaultValue = T()) const
+    {
+        const T *v = find(key);
+        return v ? *v : defaultValue;
+    }
+
+    void insert(const Key &key, const T &value) { findOrInsert(key) = value; }
+    T &operator[](const Key &key) { return findOrInsert(key); }
+
+    bool remove(const Key &key)
+    {
+        int index = indexOf(CPeerTableKey<Key>::pack(key));
+        if (index < 0) {
+            return false;
+        }
+
+        // Backward shift deletion: move the following entries of the cluster to keep the probe sequences intact
+        const int mask = m_buckets.count() - 1;
+        Bucket *buckets = m_buckets.data();
+        int next = (index + 1) & mask;
+        while (buckets[next].key != c_emptyKey) {
+            const int home = bucketIndex(buckets[next].key);
+            // Move the entry if its home bucket is not within (index, next]
+            if (((next - home) & mask) >= ((next - index) & mask)) {
+                buckets[index] = buckets[next];
+                index = next;
+            }
+            next = (next + 1) & mask;
+        }
+        buckets[index] = Bucket();
+        --m_count;
+        return true;
+    }
+
+    QVector<Key> keys() const
+    {
+        QVector<Key> result;
+        result.reserve(m_count);
+        for (const_iterator it = constBegin(); it != constEnd(); ++it) {
+            result.append(it.key());
+        }
+        return result;
+    }
+
+    const_iterator begin() const { return constBegin(); }
+    const_iterator end() const { return constEnd(); }
+    const_iterator constBegin() const { return const_iterator(m_buckets.constData(), m_buckets.constData() + m_buckets.count()); }
+    const_iterator constEnd() const { return const_iterator(m_buckets.constData() + m_buckets.count(), m_buckets.constData() + m_buckets.count()); }
+
+protected:
+    static bool fits(int count, int capacity)
+    {
+        return count * 10 <= capacity * 7; // Keep the load factor under 0.7
+    }
+
+    int bucketIndex(quint64 packedKey) const
+    {
+        // Fibonacci hashing spreads the sequential ids over the whole table
+        const quint64 hash = packedKey * Q_UINT64_C(0x9E3779B97F4A7C15);
+        return int(hash >> 32) & (m_buckets.count() - 1);
+    }
+
+    int indexOf(quint64 packedKey) const
+    {
+        if (m_buckets.isEmpty()) {
+            return -1;
+        }
+        const int mask = m_buckets.count() - 1;
+        const Bucket *buckets = m_buckets.constData();
+        int index = bucketIndex(packedKey);
+        while (buckets[index].key != c_emptyKey) {
+            if (buckets[index].key == packedKey) {
+                return index;
+            }
+            index = (index + 1) & mask;
+        }
+        return -1;
+    }
+
+    void rehash(int capacity)
+    {
+        QVector<Bucket> oldBuckets = m_buckets;
+        m_buckets = QVector<Bucket>(capacity);
+        const int mask = capacity - 1;
+        Bucket *buckets = m_buckets.data();
+        for (const Bucket &bucket : oldBuckets) {
+            if (bucket.key == c_emptyKey) {
+                continue;
+            }
+            int index = bucketIndex(bucket.key);
+            while (buckets[index].key != c_emptyKey) {
+                index = (index + 1) & mask;
+            }
+            buckets[index] = bucket;
+        }
+    }
+
+    QVector<Bucket> m_buckets;
+    int m_count = 0;
+};
+
+#endif // CPEERTABLE_HPP
@@ -196,17 +196,24 @@ CRawStream &CRawStream::operator<<(const QByteArray &data)
 CRawStreamEx &CRawStreamEx::operator>>(QByteArray &data)
 {
     quint32 length = 0;
+    quint32 prefixLength = 1; // One byte before data
     read(&length, 1);
 
-    if (length < 0xfe) {
-        data.resize(length);
-        length += 1; // Plus one byte before data
-    } else {
+    if (length >= 0xfe) {
         read(&length, 3);
-        data.resize(length);
-        length += 4; // Plus four bytes before data
+        prefixLength = 4; // Four bytes before data
+    }
+
+    if (length > quint32(bytesAvailable())) {
+        // Do not allocate a (up to 16 Mb) buffer for a broken length
+        setError();
+        data.clear();
+        return *this;
     }
 
+    data.resize(length);
+    length += prefixLength;
+
     read(data.data(), data.size());
 
     if (length & 3) {
@@ -216,6 +223,45 @@ CRawStreamEx &CRawStreamEx::operator>>(QByteArray &data)
     return *this;
 }
 
+/* Reads TL bytes without copying them out of the device buffer.
+ * The buffer is set to the (shared) device data and offset/size point to the read bytes.
+ * Returns false if the device is not a QBuffer; nothing is read in this case.
+ */
+bool CRawStreamEx::readBytesSlice(QByteArray *buffer, int *offset, int *size)
+{
+    QBuffer *bufferDevice = qobject_cast<QBuffer*>(device());
+    if (!bufferDevice) {
+        return false;
+    }
+
+    quint32 length = 0;
+    quint32 prefixLength = 1;
+    read(&length, 1);
+
+    if (length >= 0xfe) {
+        read(&length, 3);
+        prefixLength = 4;
+    }
+
+    const QByteArray &data = bufferDevice->data();
+    const qint64 dataPos = bufferDevice->pos();
+    const qint64 padding = (4 - ((length + prefixLength) & 3)) & 3;
+
+    if (error() || (dataPos + length + padding > data.size())) {
+        setError();
+        *offset = 0;
+        *size = 0;
+        return true;
+    }
+
+    *buffer = data;
+    *offset = dataPos;
+    *size = length;
+    bufferDevice->seek(dataPos + length + padding);
+
+    return true;
+}
+
 CRawStreamEx &CRawStreamEx::operator<<(const QByteArray &data)
 {
     quint32 length = data.size();
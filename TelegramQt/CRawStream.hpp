@@ -20,6 +20,9 @@
 
 #include <QByteArray>
 
+#include <string.h>
+#include <type_traits>
+
 QT_FORWARD_DECLARE_CLASS(QIODevice)
 
 class CRawStream
@@ -74,9 +77,20 @@ public:
 
     CRawStream &operator<<(const QByteArray &data);
 
+    // Fixed layout codecs: read or write all the values with a single device call.
+    template <typename... Args>
+    static constexpr int fixedLayoutSize();
+
+    template <typename... Args>
+    CRawStream &readFixedLayout(Args &... args);
+
+    template <typename... Args>
+    CRawStream &writeFixedLayout(const Args &... args);
+
 protected:
     bool read(void *data, qint64 size);
     bool write(const void *data, qint64 size);
+    void setError() { m_error = true; }
 
     template<typename Int>
     inline CRawStream &protectedWrite(Int i);
@@ -84,6 +98,17 @@ protected:
     template<typename Int>
     inline CRawStream &protectedRead(Int &i);
 
+    static void unpackFixedLayout(const char *data) { Q_UNUSED(data) }
+    template <typename T, typename... Args>
+    static void unpackFixedLayout(const char *data, T &value, Args &... args);
+
+    static void packFixedLayout(char *data) { Q_UNUSED(data) }
+    template <typename T, typename... Args>
+    static void packFixedLayout(char *data, const T &value, const Args &... args);
+
+    template <typename T>
+    static void copyLittleEndian(void *destination, const void *source);
+
 private:
     QIODevice *m_device = nullptr;
     bool m_ownDevice = false;
@@ -101,6 +126,8 @@ public:
     CRawStreamEx &operator>>(QByteArray &data);
     CRawStreamEx &operator<<(const QByteArray &data);
 
+    bool readBytesSlice(QByteArray *buffer, int *offset, int *size);
+
 };
 
 inline void CRawStream::resetError()
@@ -153,4 +180,74 @@ inline CRawStream &CRawStream::operator<<(quint64 i)
     return *this << qint64(i);
 }
 
+template <typename T>
+constexpr int rawFixedLayoutSize()
+{
+    return sizeof(T);
+}
+
+template <typename T1, typename T2, typename... Args>
+constexpr int rawFixedLayoutSize()
+{
+    return sizeof(T1) + rawFixedLayoutSize<T2, Args...>();
+}
+
+template <typename... Args>
+constexpr int CRawStream::fixedLayoutSize()
+{
+    return rawFixedLayoutSize<Args...>();
+}
+
+template <typename... Args>
+CRawStream &CRawStream::readFixedLayout(Args &... args)
+{
+    char data[fixedLayoutSize<Args...>()];
+    if (!read(data, sizeof(data))) {
+        unpackFixedLayout(data, args...);
+    }
+    return *this;
+}
+
+template <typename... Args>
+CRawStream &CRawStream::writeFixedLayout(const Args &... args)
+{
+    char data[fixedLayoutSize<Args...>()];
+    packFixedLayout(data, args...);
+    write(data, sizeof(data));
+    return *this;
+}
+
+template <typename T, typename... Args>
+void CRawStream::unpackFixedLayout(const char *data, T &value, Args &... args)
+{
+    copyLittleEndian<T>(&value, data);
+    unpackFixedLayout(data + sizeof(T), args...);
+}
+
+template <typename T, typename... Args>
+void CRawStream::packFixedLayout(char *data, const T &value, const Args &... args)
+{
+    copyLittleEndian<T>(data, &value);
+    packFixedLayout(data + sizeof(T), args...);
+}
+
+template <typename T>
+inline void CRawStream::copyLittleEndian(void *destination, const void *source)
+{
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    memcpy(destination, source, sizeof(T));
+#else
+    // Numbers are little-endian on the wire; byte arrays (such as TLNumber) are copied as is.
+    if (std::is_arithmetic<T>::value) {
+        const char *from = static_cast<const char*>(source);
+        char *to = static_cast<char*>(destination);
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            to[i] = from[sizeof(T) - 1 - i];
+        }
+    } else {
+        memcpy(destination, source, sizeof(T));
+    }
+#endif
+}
+
 #endif // CRAWSTREAM_HPP
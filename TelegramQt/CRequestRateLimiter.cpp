@@ -0,0 +1,208 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#include "CRequestRateLimiter.hpp"
+
+CRequestRateLimiter::CRequestRateLimiter()
+{
+    // The server limits are not published, so no class is limited unless the client asks for it
+    // (see CTelegramCore::setRequestRateLimit()). A FLOOD_WAIT_X still pauses the class of the failed request.
+}
+
+CRequestRateLimiter::RequestClass CRequestRateLimiter::requestClass(TLValue method)
+{
+    switch (method) {
+    case TLValue::MessagesSendMessage:
+    case TLValue::MessagesSendMedia:
+    case TLValue::MessagesForwardMessage:
+    case TLValue::MessagesForwardMessages:
+    case TLValue::MessagesSendBroadcast:
+        return TelegramNamespace::RequestClassMessages;
+    case TLValue::ContactsImportContacts:
+    case TLValue::ContactsDeleteContacts:
+    case TLValue::ContactsSearch:
+    case TLValue::ContactsResolveUsername:
+    case TLValue::UsersGetFullUser:
+        return TelegramNamespace::RequestClassContacts;
+    case TLValue::UploadGetFile:
+    case TLValue::UploadSaveFilePart:
+    case TLValue::UploadSaveBigFilePart:
+        return TelegramNamespace::RequestClassFiles;
+    case TLValue::MessagesGetHistory:
+    case TLValue::MessagesSearch:
+    case TLValue::MessagesSearchGlobal:
+    case TLValue::MessagesGetMessages:
+    case TLValue::ChannelsGetMessages:
+    case TLValue::ChannelsGetImportantHistory:
+    case TLValue::ChannelsGetParticipants:
+        return TelegramNamespace::RequestClassHistory;
+    default:
+        return TelegramNamespace::RequestClassInteractive;
+    }
+}
+
+void CRequestRateLimiter::setRate(RequestClass requestClass, int requestsPerMinute, int burst)
+{
+    Class &c = m_classes[requestClass];
+    c.requestsPerMinute = qMax(requestsPerMinute, 0);
+    c.burst = qMax(burst, 1);
+    c.tokens = c.burst * s_tokenCost;
+    c.refillTime = -1;
+}
+
+bool CRequestRateLimiter::tryAcquire(RequestClass requestClass, qint64 now)
+{
+    Class &c = m_classes[requestClass];
+    if (!c.queue.isEmpty()) {
+        // Keep the order of the requests
+        return false;
+    }
+    return takeToken(&c, now);
+}
+
+void CRequestRateLimiter::enqueue(RequestClass requestClass, const Request &request, bool front)
+{
+    Class &c = m_classes[requestClass];
+    if (front) {
+        c.queue.prepend(request);
+    } else {
+        c.queue.enqueue(request);
+    }
+}
+
+bool CRequestRateLimiter::takeNext(qint64 now, Request *request)
+{
+    for (Class &c : m_classes) {
+        if (c.queue.isEmpty() || !takeToken(&c, now)) {
+            continue;
+        }
+        *request = c.queue.dequeue();
+
+        const qint64 waitTime = qMax<qint64>(now - request->queueTime, 0);
+        ++c.delayedCount;
+        c.totalWaitTime += waitTime;
+        c.maxWaitTime = qMax(c.maxWaitTime, waitTime);
+        return true;
+    }
+    return false;
+}
+
+qint64 CRequestRateLimiter::nextReadyTime(qint64 now) const
+{
+    qint64 result = -1;
+    for (const Class &c : m_classes) {
+        const qint64 time = readyTime(c, now);
+        if ((time >= 0) && ((result < 0) || (time < result))) {
+            result = time;
+        }
+    }
+    return result;
+}
+
+void CRequestRateLimiter::floodWait(RequestClass requestClass, int seconds, qint64 now)
+{
+    Class &c = m_classes[requestClass];
+    c.pausedUntil = qMax(c.pausedUntil, now + qint64(seconds) * 1000);
+    // Send a single request once the pause is over, then go on with the regular rate (if the class is limited)
+    c.tokens = s_tokenCost;
+    c.refillTime = c.pausedUntil;
+}
+
+QVector<CRequestRateLimiter::Request> CRequestRateLimiter::takeQueued(RequestClass requestClass)
+{
+    Class &c = m_classes[requestClass];
+    QVector<Request> result;
+    result.reserve(c.queue.count());
+    while (!c.queue.isEmpty()) {
+        result.append(c.queue.dequeue());
+    }
+    return result;
+}
+
+void CRequestRateLimiter::clear()
+{
+    for (Class &c : m_classes) {
+        c.queue.clear();
+        c.pausedUntil = 0;
+        c.tokens = c.burst * s_tokenCost;
+        c.refillTime = -1;
+    }
+}
+
+Telegram::RequestQueueStats CRequestRateLimiter::stats(RequestClass requestClass, qint64 now) const
+{
+    const Class &c = m_classes[requestClass];
+    Telegram::RequestQueueStats result;
+    result.queueDepth = c.queue.count();
+    result.delayedCount = c.delayedCount;
+    result.averageWaitTime = c.delayedCount ? c.totalWaitTime / c.delayedCount : 0;
+    result.maxWaitTime = c.maxWaitTime;
+    result.oldestWaitTime = c.queue.isEmpty() ? 0 : qMax<qint64>(now - c.queue.head().queueTime, 0);
+    result.floodWaitRemaining = qMax<qint64>(c.pausedUntil - now, 0);
+    return result;
+}
+
+void CRequestRateLimiter::refill(Class *requestClass, qint64 now)
+{
+    if (requestClass->refillTime < 0) {
+        requestClass->refillTime = now;
+        return;
+    }
+    if (now <= requestClass->refillTime) {
+        return;
+    }
+    const qint64 added = (now - requestClass->refillTime) * requestClass->requestsPerMinute;
+    requestClass->tokens = qMin(requestClass->burst * s_tokenCost, requestClass->tokens + added);
+    requestClass->refillTime = now;
+}
+
+qint64 CRequestRateLimiter::readyTime(const Class &requestClass, qint64 now) const
+{
+    if (requestClass.queue.isEmpty()) {
+        return -1;
+    }
+
+    const qint64 start = qMax(now, requestClass.pausedUntil);
+    if (!requestClass.requestsPerMinute) {
+        return start;
+    }
+
+    Class c = requestClass;
+    refill(&c, start);
+    if (c.tokens >= s_tokenCost) {
+        return start;
+    }
+    const qint64 missing = s_tokenCost - c.tokens;
+    return start + (missing + c.requestsPerMinute - 1) / c.requestsPerMinute;
+}
+
+bool CRequestRateLimiter::takeToken(Class *requestClass, qint64 now)
+{
+    if (now < requestClass->pausedUntil) {
+        return false;
+    }
+    if (!requestClass->requestsPerMinute) {
+        return true;
+    }
+
+    refill(requestClass, now);
+    if (requestClass->tokens < s_tokenCost) {
+        return false;
+    }
+    requestClass->tokens -= s_tokenCost;
+    return true;
+}
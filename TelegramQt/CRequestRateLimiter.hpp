@@ -0,0 +1,100 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#ifndef CREQUESTRATELIMITER_HPP
+#define CREQUESTRATELIMITER_HPP
+
+#include <QByteArray>
+#include <QQueue>
+#include <QVector>
+
+#include "TelegramNamespace.hpp"
+#include "TLValues.hpp"
+
+/* Client side rate limiter of the requests sent to a DC.
+ *
+ * The requests are split into classes (see requestClass()), each class has its own token
+ * bucket and FIFO queue. A request is sent at once if its class has a token and nothing
+ * is queued before it, otherwise it waits in the queue. A FLOOD_WAIT_X error pauses only
+ * the class of the failed request. The time is passed in by the caller (in milliseconds),
+ * so the limiter has no timers. The classes are not limited by default.
+ */
+class CRequestRateLimiter
+{
+public:
+    typedef TelegramNamespace::RequestClass RequestClass;
+    enum { RequestClassesCount = TelegramNamespace::RequestClassHistory + 1 };
+
+    struct Request {
+        quint64 requestId = 0;
+        QByteArray data;
+        qint64 queueTime = 0;
+    };
+
+    CRequestRateLimiter();
+
+    static RequestClass requestClass(TLValue method);
+
+    // Pass zero requestsPerMinute to not limit the class.
+    void setRate(RequestClass requestClass, int requestsPerMinute, int burst);
+    int rate(RequestClass requestClass) const { return m_classes[requestClass].requestsPerMinute; }
+
+    // Takes a token and returns true if a request of the class can be sent right now.
+    bool tryAcquire(RequestClass requestClass, qint64 now);
+
+    // The retried requests (e.g. after a flood wait) are put in front of the queue.
+    void enqueue(RequestClass requestClass, const Request &request, bool front = false);
+
+    // Takes the next request which can be sent now (of any class).
+    bool takeNext(qint64 now, Request *request);
+
+    // The time to call takeNext() again, or -1 if nothing is queued.
+    qint64 nextReadyTime(qint64 now) const;
+
+    void floodWait(RequestClass requestClass, int seconds, qint64 now);
+    qint64 pausedUntil(RequestClass requestClass) const { return m_classes[requestClass].pausedUntil; }
+
+    QVector<Request> takeQueued(RequestClass requestClass);
+    void clear();
+
+    int queueDepth(RequestClass requestClass) const { return m_classes[requestClass].queue.count(); }
+    Telegram::RequestQueueStats stats(RequestClass requestClass, qint64 now) const;
+
+protected:
+    static const qint64 s_tokenCost = 60000; // A token is gained in 60000 / requestsPerMinute ms
+
+    struct Class {
+        int requestsPerMinute = 0;
+        int burst = 1;
+        qint64 tokens = s_tokenCost; // In the token cost units to refill without rounding
+        qint64 refillTime = -1;
+        qint64 pausedUntil = 0;
+        QQueue<Request> queue;
+
+        quint32 delayedCount = 0;
+        qint64 totalWaitTime = 0;
+        qint64 maxWaitTime = 0;
+    };
+
+    static void refill(Class *requestClass, qint64 now);
+    qint64 readyTime(const Class &requestClass, qint64 now) const;
+    bool takeToken(Class *requestClass, qint64 now);
+
+    Class m_classes[RequestClassesCount];
+};
+
+#endif // CREQUESTRATELIMITER_HPP
@@ -0,0 +1,109 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#include "CRttEstimator.hpp"
+
+static const qint64 s_initialTimeout = 10000; // Until the first sample
+static const qint64 s_minTimeout = 2000; // Mobile links have short stalls, which should not be taken as a loss
+static const qint64 s_maxTimeout = 30000;
+static const qint64 s_clockGranularity = 100;
+static const qint64 s_minPingInterval = 5000;
+static const int s_answeredPingsToGrowInterval = 3;
+
+CRttEstimator::CRttEstimator() :
+    m_baseInterval(0),
+    m_pingInterval(0)
+{
+    reset();
+}
+
+void CRttEstimator::reset()
+{
+    m_smoothedRtt = 0;
+    m_rttVariation = 0;
+    m_minRtt = 0;
+    m_samplesCount = 0;
+
+    m_pingInterval = m_baseInterval;
+    m_answeredPingsCount = 0;
+    m_lostPingsCount = 0;
+}
+
+void CRttEstimator::addSample(qint64 rtt)
+{
+    rtt = qMax<qint64>(rtt, 0);
+
+    if (!m_samplesCount) {
+        m_smoothedRtt = rtt;
+        m_rttVariation = rtt / 2;
+        m_minRtt = rtt;
+    } else {
+        // RFC 6298: alpha = 1/8, beta = 1/4
+        m_rttVariation = (3 * m_rttVariation + qAbs(m_smoothedRtt - rtt)) / 4;
+        m_smoothedRtt = (7 * m_smoothedRtt + rtt) / 8;
+        m_minRtt = qMin(m_minRtt, rtt);
+    }
+    ++m_samplesCount;
+}
+
+qint64 CRttEstimator::timeout() const
+{
+    if (!m_samplesCount) {
+        return s_initialTimeout;
+    }
+    return qBound(s_minTimeout, m_smoothedRtt + qMax(s_clockGranularity, 4 * m_rttVariation), s_maxTimeout);
+}
+
+void CRttEstimator::setBaseInterval(qint64 interval)
+{
+    m_baseInterval = qMax<qint64>(interval, 0);
+    m_pingInterval = m_baseInterval;
+    m_answeredPingsCount = 0;
+    m_lostPingsCount = 0;
+}
+
+void CRttEstimator::pingAnswered(qint64 rtt)
+{
+    // The answer took at least twice of the usual time and more than the usual variation
+    const bool jitterSpike = m_samplesCount && (rtt > m_smoothedRtt + qMax(4 * m_rttVariation, m_smoothedRtt));
+
+    addSample(rtt);
+    m_lostPingsCount = 0;
+
+    if (jitterSpike) {
+        m_answeredPingsCount = 0;
+        m_pingInterval = qMax(minPingInterval(), m_pingInterval / 2);
+        return;
+    }
+
+    if (++m_answeredPingsCount >= s_answeredPingsToGrowInterval) {
+        m_answeredPingsCount = 0;
+        m_pingInterval = qMin(m_pingInterval * 3 / 2, m_baseInterval * 2);
+    }
+}
+
+void CRttEstimator::pingLost()
+{
+    ++m_lostPingsCount;
+    m_answeredPingsCount = 0;
+    m_pingInterval = minPingInterval();
+}
+
+qint64 CRttEstimator::minPingInterval() const
+{
+    return qMin(m_baseInterval, s_minPingInterval);
+}
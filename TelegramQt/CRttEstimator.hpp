@@ -0,0 +1,70 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#ifndef CRTTESTIMATOR_HPP
+#define CRTTESTIMATOR_HPP
+
+#include <QtGlobal>
+
+/* Round-trip time estimator of a DC connection and the keep-alive policy based on it.
+ *
+ * The smoothed RTT and its variation are computed the same way as the TCP retransmission
+ * timer (RFC 6298), the samples are fed from the ping-pongs and the RPC round-trips.
+ * The ping interval starts at the configured (base) interval, grows up to twice of it while
+ * the answers come in time with a low jitter and falls back down to the minimal interval on
+ * a jitter spike or a lost pong. All of the times are in milliseconds.
+ */
+class CRttEstimator
+{
+public:
+    CRttEstimator();
+
+    void reset();
+
+    void addSample(qint64 rtt);
+    int samplesCount() const { return m_samplesCount; }
+
+    qint64 smoothedRtt() const { return m_smoothedRtt; }
+    qint64 rttVariation() const { return m_rttVariation; }
+    qint64 minRtt() const { return m_minRtt; }
+
+    // The time to wait for an answer before considering it lost.
+    qint64 timeout() const;
+
+    qint64 baseInterval() const { return m_baseInterval; }
+    void setBaseInterval(qint64 interval);
+    qint64 pingInterval() const { return m_pingInterval; }
+
+    void pingAnswered(qint64 rtt);
+    void pingLost();
+    int lostPingsCount() const { return m_lostPingsCount; }
+
+protected:
+    qint64 minPingInterval() const;
+
+    qint64 m_smoothedRtt;
+    qint64 m_rttVariation;
+    qint64 m_minRtt;
+    int m_samplesCount;
+
+    qint64 m_baseInterval;
+    qint64 m_pingInterval;
+    int m_answeredPingsCount; // In a row, without jitter spikes
+    int m_lostPingsCount; // In a row
+};
+
+#endif // CRTTESTIMATOR_HPP
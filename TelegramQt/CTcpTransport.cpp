@@ -26,14 +26,20 @@
 #endif
 
 static const quint32 tcpTimeout = 15 * 1000;
+static const int s_connectionAttemptDelay = 250; // The next address is tried if there is no connection in 250 ms
 
 CTcpTransport::CTcpTransport(QObject *parent) :
     CTelegramTransport(parent),
     m_socket(nullptr),
-    m_timeoutTimer(new QTimer(this))
+    m_timeoutTimer(new QTimer(this)),
+    m_attemptTimer(new QTimer(this))
 {
     m_timeoutTimer->setInterval(tcpTimeout);
     connect(m_timeoutTimer, &QTimer::timeout, this, &CTcpTransport::onTimeout);
+
+    m_attemptTimer->setSingleShot(true);
+    m_attemptTimer->setInterval(s_connectionAttemptDelay);
+    connect(m_attemptTimer, &QTimer::timeout, this, &CTcpTransport::startNextAttempt);
 }
 
 CTcpTransport::~CTcpTransport()
@@ -49,19 +55,152 @@ void CTcpTransport::connectToHost(const QString &ipAddress, quint32 port)
 #ifdef DEVELOPER_BUILD
     qDebug() << Q_FUNC_INFO << ipAddress << port;
 #endif
+    cancelRace();
+    m_remoteAddress = Telegram::DcOption(ipAddress, port);
+    m_connectTimer.start();
     m_socket->connectToHost(ipAddress, port);
 }
 
+void CTcpTransport::connectToHosts(const QVector<Telegram::DcOption> &addresses)
+{
+    if (addresses.count() < 2) {
+        CTelegramTransport::connectToHosts(addresses);
+        return;
+    }
+
+#ifdef DEVELOPER_BUILD
+    qDebug() << Q_FUNC_INFO << addresses.count() << "addresses";
+#endif
+    cancelRace();
+    if (m_socket && (m_socket->state() != QAbstractSocket::UnconnectedState)) {
+        m_socket->abort();
+    }
+    m_pendingAddresses = addresses;
+    startNextAttempt();
+    if (isRacing()) {
+        setState(QAbstractSocket::ConnectingState); // The whole race is limited by the connection timeout
+    }
+}
+
 void CTcpTransport::disconnectFromHost()
 {
 #ifdef DEVELOPER_BUILD
     qDebug() << Q_FUNC_INFO;
 #endif
+    if (isRacing()) {
+        cancelRace();
+        setState(QAbstractSocket::UnconnectedState);
+        return;
+    }
     if (m_socket) {
         m_socket->disconnectFromHost();
     }
 }
 
+void CTcpTransport::startNextAttempt()
+{
+    if (m_pendingAddresses.isEmpty()) {
+        return;
+    }
+
+    QAbstractSocket *socket = createSocket();
+    if (!socket) {
+        const Telegram::DcOption address = m_pendingAddresses.first();
+        m_pendingAddresses.clear();
+        connectToHost(address.address, address.port);
+        return;
+    }
+
+    ConnectionAttempt attempt;
+    attempt.socket = socket;
+    attempt.address = m_pendingAddresses.takeFirst();
+    attempt.time.start();
+    m_attempts.append(attempt);
+
+    connect(socket, &QAbstractSocket::connected, this, &CTcpTransport::onAttemptConnected);
+    connect(socket, SIGNAL(error(QAbstractSocket::SocketError)), SLOT(onAttemptFailed()));
+    socket->connectToHost(attempt.address.address, attempt.address.port);
+
+    if (!m_pendingAddresses.isEmpty()) {
+        m_attemptTimer->start();
+    }
+}
+
+void CTcpTransport::onAttemptConnected()
+{
+    const int index = attemptIndex(sender());
+    if (index < 0) {
+        return;
+    }
+
+    const ConnectionAttempt winner = m_attempts.takeAt(index);
+    cancelRace();
+
+#ifdef DEVELOPER_BUILD
+    qDebug() << Q_FUNC_INFO << winner.address.address << winner.address.port << "in" << winner.time.elapsed() << "ms";
+#endif
+
+    disconnect(winner.socket, nullptr, this, nullptr);
+    if (m_socket) {
+        disconnect(m_socket, nullptr, this, nullptr);
+        m_socket->deleteLater();
+        m_socket = nullptr;
+    }
+    setSocket(winner.socket);
+
+    m_remoteAddress = winner.address;
+    m_connectTime = winner.time.elapsed();
+    m_connectTimer.invalidate();
+    setState(QAbstractSocket::ConnectedState);
+}
+
+void CTcpTransport::onAttemptFailed()
+{
+    const int index = attemptIndex(sender());
+    if (index < 0) {
+        return;
+    }
+
+    const ConnectionAttempt attempt = m_attempts.takeAt(index);
+    const QAbstractSocket::SocketError socketError = attempt.socket->error();
+    disconnect(attempt.socket, nullptr, this, nullptr);
+    attempt.socket->deleteLater();
+    emit connectionAttemptFailed(attempt.address);
+
+    if (!m_pendingAddresses.isEmpty()) {
+        // Do not wait for the attempt delay
+        startNextAttempt();
+        return;
+    }
+
+    if (m_attempts.isEmpty()) {
+        setError(socketError);
+        setState(QAbstractSocket::UnconnectedState);
+    }
+}
+
+int CTcpTransport::attemptIndex(QObject *socket) const
+{
+    for (int i = 0; i < m_attempts.count(); ++i) {
+        if (m_attempts.at(i).socket == socket) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void CTcpTransport::cancelRace()
+{
+    m_attemptTimer->stop();
+    m_pendingAddresses.clear();
+    for (const ConnectionAttempt &attempt : m_attempts) {
+        disconnect(attempt.socket, nullptr, this, nullptr);
+        attempt.socket->abort();
+        attempt.socket->deleteLater();
+    }
+    m_attempts.clear();
+}
+
 void CTcpTransport::sendPackageImplementation(const QByteArray &payload)
 {
     // quint32 length (included length itself + packet number + crc32 + payload // Length MUST be divisible by 4
@@ -110,6 +249,10 @@ void CTcpTransport::setState(QAbstractSocket::SocketState newState)
     case QAbstractSocket::ConnectedState:
         m_expectedLength = 0;
         setSessionType(Unknown);
+        if (m_connectTimer.isValid()) {
+            m_connectTime = m_connectTimer.elapsed();
+            m_connectTimer.invalidate();
+        }
         Q_FALLTHROUGH();
     default:
         m_timeoutTimer->stop();
@@ -157,6 +300,11 @@ void CTcpTransport::onTimeout()
     qDebug() << Q_FUNC_INFO << "(connection to " << m_socket->peerName() << m_socket->peerPort() << ").";
 #endif
     emit timeout();
+    if (isRacing()) {
+        cancelRace();
+        setState(QAbstractSocket::UnconnectedState);
+        return;
+    }
     m_socket->disconnectFromHost();
 }
 
@@ -20,6 +20,8 @@
 
 #include "CTelegramTransport.hpp"
 
+#include <QElapsedTimer>
+
 QT_FORWARD_DECLARE_CLASS(QTimer)
 
 class CTcpTransport : public CTelegramTransport
@@ -37,14 +39,31 @@ public:
     ~CTcpTransport();
 
     void connectToHost(const QString &ipAddress, quint32 port) override;
+    // The connections to the addresses are started one after another with a short delay (or at once after a failure),
+    // the first established one is used and the others are aborted ("Happy Eyeballs", RFC 8305).
+    void connectToHosts(const QVector<Telegram::DcOption> &addresses) override;
     void disconnectFromHost() override;
 
 protected slots:
     void setState(QAbstractSocket::SocketState newState) override;
     void onReadyRead();
     void onTimeout();
+    void startNextAttempt();
+    void onAttemptConnected();
+    void onAttemptFailed();
 
 protected:
+    struct ConnectionAttempt {
+        QAbstractSocket *socket = nullptr;
+        Telegram::DcOption address;
+        QElapsedTimer time;
+    };
+
+    virtual QAbstractSocket *createSocket() { return nullptr; } // The racing is not supported without a socket factory
+    bool isRacing() const { return !m_attempts.isEmpty() || !m_pendingAddresses.isEmpty(); }
+    int attemptIndex(QObject *socket) const;
+    void cancelRace();
+
     void setSocket(QAbstractSocket *socket);
     void sendPackageImplementation(const QByteArray &payload) override;
 
@@ -56,6 +75,11 @@ protected:
 
     QAbstractSocket *m_socket = nullptr;
     QTimer *m_timeoutTimer = nullptr;
+
+    QVector<ConnectionAttempt> m_attempts;
+    QVector<Telegram::DcOption> m_pendingAddresses;
+    QTimer *m_attemptTimer = nullptr;
+    QElapsedTimer m_connectTimer;
 };
 
 #endif // CTCPTRANSPORT_HPP
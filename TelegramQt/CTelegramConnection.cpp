@@ -25,6 +25,9 @@
 
 #include <QtEndian>
 
+#include <algorithm>
+#include <limits>
+
 #ifdef NETWORK_LOGGING
 #include <QDir>
 #include <QFile>
@@ -39,6 +42,7 @@ QString formatTLValue(const TLValue &val)
 #endif
 
 #include "CAppInformation.hpp"
+#include "CAuthCryptoJob.hpp"
 #include "CTelegramStream.hpp"
 #include "CTelegramTransport.hpp"
 #include "Debug_p.hpp"
@@ -54,6 +58,14 @@ using namespace TelegramUtils;
 using namespace Telegram;
 
 static const quint32 s_defaultAuthInterval = 15000; // 15 sec
+static const quint32 s_futureSaltsCount = 32; // The server returns up to 64 salts, each is valid for about an hour
+static const quint32 s_futureSaltsReserve = 60 * 60; // Request more salts once the known ones run out in an hour
+static const int s_requestsCheckInterval = 1000; // 1 sec
+static const int s_requestProbeInterval = 5000; // The state of an unanswered request is asked after 5 sec, then the interval is doubled
+static const int s_requestMaxProbeInterval = 60000; // 60 sec
+static const int s_requestMaxAttempts = 4;
+static const int s_requestDefaultDeadline = 30 * 1000; // 30 sec
+static const int s_maxLostPings = 2; // The connection is closed if the probe ping is lost too
 
 CTelegramConnection::CTelegramConnection(const CAppInformation *appInfo, QObject *parent) :
     QObject(parent),
@@ -63,20 +75,31 @@ CTelegramConnection::CTelegramConnection(const CAppInformation *appInfo, QObject
     m_authTimer(0),
     m_pingTimer(0),
     m_ackTimer(new QTimer(this)),
+    m_requestsTimer(new QTimer(this)),
+    m_requestQueueTimer(new QTimer(this)),
     m_authState(AuthStateNone),
     m_authId(0),
     m_authKeyAuxHash(0),
     m_serverSalt(0),
+    m_futureSaltsRequestId(0),
     m_sessionId(0),
     m_lastSentPingId(0),
     m_lastReceivedPingTime(0),
     m_lastSentPingTime(0),
+    m_lastReceivedPackageTime(0),
+    m_serverDisconnectionTime(0),
     m_sequenceNumber(0),
     m_contentRelatedMessages(0),
     m_pingInterval(0),
     m_serverDisconnectionExtraTime(0),
-    m_deltaTime(0),
-    m_deltaTimeHeuristicState(DeltaTimeIsOk)
+    m_timeOffset(0),
+    m_timeSyncRoundTripTime(0),
+    m_timeSyncMessageId(0),
+    m_lastReceivedMessageId(0),
+    m_authCryptoJob(nullptr),
+    m_temporaryKeyLifetime(0),
+    m_authKeyExpiresAt(0),
+    m_temporaryKeyBindingId(0)
   #ifdef NETWORK_LOGGING
   , m_logFile(0)
   #endif
@@ -84,6 +107,12 @@ CTelegramConnection::CTelegramConnection(const CAppInformation *appInfo, QObject
     m_ackTimer->setInterval(90 * 1000);
     m_ackTimer->setSingleShot(true);
     connect(m_ackTimer, &QTimer::timeout, this, &CTelegramConnection::onTimeToAckMessages);
+
+    m_requestsTimer->setInterval(s_requestsCheckInterval);
+    connect(m_requestsTimer, &QTimer::timeout, this, &CTelegramConnection::onTimeToCheckRequests);
+
+    m_requestQueueTimer->setSingleShot(true);
+    connect(m_requestQueueTimer, &QTimer::timeout, this, &CTelegramConnection::onTimeToSendQueuedRequests);
 }
 
 void CTelegramConnection::setDcInfo(const TLDcOption &newDcInfo)
@@ -91,6 +120,11 @@ void CTelegramConnection::setDcInfo(const TLDcOption &newDcInfo)
     m_dcInfo = newDcInfo;
 }
 
+void CTelegramConnection::setDcAddresses(const QVector<Telegram::DcOption> &addresses)
+{
+    m_dcAddresses = addresses;
+}
+
 void CTelegramConnection::setServerRsaKey(const Telegram::RsaKey &key)
 {
     m_rsaKey = key;
@@ -112,7 +146,38 @@ void CTelegramConnection::connectToDc()
 
     setStatus(ConnectionStatusConnecting, ConnectionStatusReasonLocal);
     setAuthState(AuthStateNone);
-    m_transport->connectToHost(m_dcInfo.ipAddress, m_dcInfo.port);
+    connectTransport();
+}
+
+void CTelegramConnection::reconnectToDc()
+{
+    if (m_status != ConnectionStatusDisconnected) {
+        return;
+    }
+
+    if (m_authState < AuthStateHaveAKey) {
+        connectToDc();
+        return;
+    }
+
+    // Keep the auth key, the server salt, the session id and the requests in flight.
+    qDebug() << Q_FUNC_INFO << m_dcInfo.id << m_dcInfo.ipAddress << m_dcInfo.port;
+
+    if (m_transport->state() != QAbstractSocket::UnconnectedState) {
+        m_transport->disconnectFromHost(); // Ensure that there is no connection
+    }
+
+    setStatus(ConnectionStatusConnecting, ConnectionStatusReasonLocal);
+    connectTransport();
+}
+
+void CTelegramConnection::connectTransport()
+{
+    if (m_dcAddresses.count() > 1) {
+        m_transport->connectToHosts(m_dcAddresses);
+    } else {
+        m_transport->connectToHost(m_dcInfo.ipAddress, m_dcInfo.port);
+    }
 }
 
 void CTelegramConnection::disconnectFromDc()
@@ -157,7 +222,23 @@ void CTelegramConnection::setAuthKey(const QByteArray &newAuthKey)
 
 void CTelegramConnection::setDeltaTime(const qint32 newDt)
 {
-    m_deltaTime = newDt;
+    m_timeOffset = qint64(newDt) * 1000;
+    m_timeSyncMessageId = 0;
+}
+
+void CTelegramConnection::setServerSalts(const QVector<ServerSalt> &salts)
+{
+    m_serverSalts = salts;
+    std::sort(m_serverSalts.begin(), m_serverSalts.end(), [](const ServerSalt &left, const ServerSalt &right) {
+        return left.validSince < right.validSince;
+    });
+    updateServerSalt();
+}
+
+qint64 CTelegramConnection::timeFromMessageId(quint64 messageId)
+{
+    // The message id is the unixtime in the upper 32 bits and the fraction of a second in the lower 32 bits.
+    return qint64(messageId >> 32) * 1000 + qint64(((messageId & 0xffffffffull) * 1000) >> 32);
 }
 
 void CTelegramConnection::initAuth()
@@ -193,6 +274,7 @@ void CTelegramConnection::setKeepAliveSettings(quint32 interval, quint32 serverD
     }
 
     m_pingInterval = interval;
+    m_rttEstimator.setBaseInterval(interval);
 
     if (interval && m_authState >= AuthStateHaveAKey) {
         startPingTimer();
@@ -267,96 +349,111 @@ quint64 CTelegramConnection::sendMedia(const TLInputPeer &peer, const TLInputMed
 // Generated Telegram API methods implementation
 quint64 CTelegramConnection::accountChangePhone(const QString &phoneNumber, const QString &phoneCodeHash, const QString &phoneCode)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(phoneNumber);
+    size += CTelegramStream::serializedSize(phoneCodeHash);
+    size += CTelegramStream::serializedSize(phoneCode);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AccountChangePhone;
     outputStream << phoneNumber;
     outputStream << phoneCodeHash;
     outputStream << phoneCode;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::accountCheckUsername(const QString &username)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(username);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AccountCheckUsername;
     outputStream << username;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::accountDeleteAccount(const QString &reason)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(reason);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AccountDeleteAccount;
     outputStream << reason;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::accountGetAccountTTL()
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AccountGetAccountTTL;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::accountGetAuthorizations()
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AccountGetAuthorizations;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::accountGetNotifySettings(const TLInputNotifyPeer &peer)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(peer);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AccountGetNotifySettings;
     outputStream << peer;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::accountGetPassword()
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AccountGetPassword;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::accountGetPasswordSettings(const QByteArray &currentPasswordHash)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(currentPasswordHash);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AccountGetPasswordSettings;
     outputStream << currentPasswordHash;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::accountGetPrivacy(const TLInputPrivacyKey &key)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(key);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AccountGetPrivacy;
     outputStream << key;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::accountGetWallPapers()
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AccountGetWallPapers;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::accountRegisterDevice(quint32 tokenType, const QString &token, const QString &deviceModel, const QString &systemVersion, const QString &appVersion, bool appSandbox, const QString &langCode)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(tokenType);
+    size += CTelegramStream::serializedSize(token);
+    size += CTelegramStream::serializedSize(deviceModel);
+    size += CTelegramStream::serializedSize(systemVersion);
+    size += CTelegramStream::serializedSize(appVersion);
+    size += CTelegramStream::serializedSize(appSandbox);
+    size += CTelegramStream::serializedSize(langCode);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AccountRegisterDevice;
     outputStream << tokenType;
     outputStream << token;
@@ -365,426 +462,507 @@ quint64 CTelegramConnection::accountRegisterDevice(quint32 tokenType, const QStr
     outputStream << appVersion;
     outputStream << appSandbox;
     outputStream << langCode;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::accountReportPeer(const TLInputPeer &peer, const TLReportReason &reason)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(peer);
+    size += CTelegramStream::serializedSize(reason);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AccountReportPeer;
     outputStream << peer;
     outputStream << reason;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::accountResetAuthorization(quint64 hash)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(hash);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AccountResetAuthorization;
     outputStream << hash;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::accountResetNotifySettings()
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AccountResetNotifySettings;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::accountSendChangePhoneCode(const QString &phoneNumber)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(phoneNumber);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AccountSendChangePhoneCode;
     outputStream << phoneNumber;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::accountSetAccountTTL(const TLAccountDaysTTL &ttl)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(ttl);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AccountSetAccountTTL;
     outputStream << ttl;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::accountSetPrivacy(const TLInputPrivacyKey &key, const TLVector<TLInputPrivacyRule> &rules)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(key);
+    size += CTelegramStream::serializedSize(rules);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AccountSetPrivacy;
     outputStream << key;
     outputStream << rules;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::accountUnregisterDevice(quint32 tokenType, const QString &token)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(tokenType);
+    size += CTelegramStream::serializedSize(token);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AccountUnregisterDevice;
     outputStream << tokenType;
     outputStream << token;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::accountUpdateDeviceLocked(quint32 period)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(period);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AccountUpdateDeviceLocked;
     outputStream << period;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::accountUpdateNotifySettings(const TLInputNotifyPeer &peer, const TLInputPeerNotifySettings &settings)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(peer);
+    size += CTelegramStream::serializedSize(settings);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AccountUpdateNotifySettings;
     outputStream << peer;
     outputStream << settings;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::accountUpdatePasswordSettings(const QByteArray &currentPasswordHash, const TLAccountPasswordInputSettings &newSettings)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(currentPasswordHash);
+    size += CTelegramStream::serializedSize(newSettings);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AccountUpdatePasswordSettings;
     outputStream << currentPasswordHash;
     outputStream << newSettings;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::accountUpdateProfile(const QString &firstName, const QString &lastName)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(firstName);
+    size += CTelegramStream::serializedSize(lastName);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AccountUpdateProfile;
     outputStream << firstName;
     outputStream << lastName;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::accountUpdateStatus(bool offline)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(offline);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AccountUpdateStatus;
     outputStream << offline;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::accountUpdateUsername(const QString &username)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(username);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AccountUpdateUsername;
     outputStream << username;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::authBindTempAuthKey(quint64 permAuthKeyId, quint64 nonce, quint32 expiresAt, const QByteArray &encryptedMessage)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(permAuthKeyId);
+    size += CTelegramStream::serializedSize(nonce);
+    size += CTelegramStream::serializedSize(expiresAt);
+    size += CTelegramStream::serializedSize(encryptedMessage);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AuthBindTempAuthKey;
     outputStream << permAuthKeyId;
     outputStream << nonce;
     outputStream << expiresAt;
     outputStream << encryptedMessage;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::authCheckPassword(const QByteArray &passwordHash)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(passwordHash);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AuthCheckPassword;
     outputStream << passwordHash;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::authCheckPhone(const QString &phoneNumber)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(phoneNumber);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AuthCheckPhone;
     outputStream << phoneNumber;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::authExportAuthorization(quint32 dcId)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(dcId);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AuthExportAuthorization;
     outputStream << dcId;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::authImportAuthorization(quint32 id, const QByteArray &bytes)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(id);
+    size += CTelegramStream::serializedSize(bytes);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AuthImportAuthorization;
     outputStream << id;
     outputStream << bytes;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::authImportBotAuthorization(quint32 flags, quint32 apiId, const QString &apiHash, const QString &botAuthToken)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(flags);
+    size += CTelegramStream::serializedSize(apiId);
+    size += CTelegramStream::serializedSize(apiHash);
+    size += CTelegramStream::serializedSize(botAuthToken);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AuthImportBotAuthorization;
     outputStream << flags;
     outputStream << apiId;
     outputStream << apiHash;
     outputStream << botAuthToken;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::authLogOut()
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AuthLogOut;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::authRecoverPassword(const QString &code)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(code);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AuthRecoverPassword;
     outputStream << code;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::authRequestPasswordRecovery()
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AuthRequestPasswordRecovery;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::authResetAuthorizations()
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AuthResetAuthorizations;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::authSendCall(const QString &phoneNumber, const QString &phoneCodeHash)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(phoneNumber);
+    size += CTelegramStream::serializedSize(phoneCodeHash);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AuthSendCall;
     outputStream << phoneNumber;
     outputStream << phoneCodeHash;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::authSendCode(const QString &phoneNumber, quint32 smsType, quint32 apiId, const QString &apiHash, const QString &langCode)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(phoneNumber);
+    size += CTelegramStream::serializedSize(smsType);
+    size += CTelegramStream::serializedSize(apiId);
+    size += CTelegramStream::serializedSize(apiHash);
+    size += CTelegramStream::serializedSize(langCode);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AuthSendCode;
     outputStream << phoneNumber;
     outputStream << smsType;
     outputStream << apiId;
     outputStream << apiHash;
     outputStream << langCode;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::authSendInvites(const TLVector<QString> &phoneNumbers, const QString &message)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(phoneNumbers);
+    size += CTelegramStream::serializedSize(message);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AuthSendInvites;
     outputStream << phoneNumbers;
     outputStream << message;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::authSendSms(const QString &phoneNumber, const QString &phoneCodeHash)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(phoneNumber);
+    size += CTelegramStream::serializedSize(phoneCodeHash);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AuthSendSms;
     outputStream << phoneNumber;
     outputStream << phoneCodeHash;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::authSignIn(const QString &phoneNumber, const QString &phoneCodeHash, const QString &phoneCode)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(phoneNumber);
+    size += CTelegramStream::serializedSize(phoneCodeHash);
+    size += CTelegramStream::serializedSize(phoneCode);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AuthSignIn;
     outputStream << phoneNumber;
     outputStream << phoneCodeHash;
     outputStream << phoneCode;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::authSignUp(const QString &phoneNumber, const QString &phoneCodeHash, const QString &phoneCode, const QString &firstName, const QString &lastName)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(phoneNumber);
+    size += CTelegramStream::serializedSize(phoneCodeHash);
+    size += CTelegramStream::serializedSize(phoneCode);
+    size += CTelegramStream::serializedSize(firstName);
+    size += CTelegramStream::serializedSize(lastName);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::AuthSignUp;
     outputStream << phoneNumber;
     outputStream << phoneCodeHash;
     outputStream << phoneCode;
     outputStream << firstName;
     outputStream << lastName;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::channelsCheckUsername(const TLInputChannel &channel, const QString &username)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(channel);
+    size += CTelegramStream::serializedSize(username);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ChannelsCheckUsername;
     outputStream << channel;
     outputStream << username;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::channelsCreateChannel(quint32 flags, const QString &title, const QString &about)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(flags);
+    size += CTelegramStream::serializedSize(title);
+    size += CTelegramStream::serializedSize(about);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ChannelsCreateChannel;
     outputStream << flags;
     // (flags & 1 << 0) stands for broadcast "true" value
     // (flags & 1 << 1) stands for megagroup "true" value
     outputStream << title;
     outputStream << about;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::channelsDeleteChannel(const TLInputChannel &channel)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(channel);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ChannelsDeleteChannel;
     outputStream << channel;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::channelsDeleteMessages(const TLInputChannel &channel, const TLVector<quint32> &id)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(channel);
+    size += CTelegramStream::serializedSize(id);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ChannelsDeleteMessages;
     outputStream << channel;
     outputStream << id;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::channelsDeleteUserHistory(const TLInputChannel &channel, const TLInputUser &userId)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(channel);
+    size += CTelegramStream::serializedSize(userId);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ChannelsDeleteUserHistory;
     outputStream << channel;
     outputStream << userId;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::channelsEditAbout(const TLInputChannel &channel, const QString &about)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(channel);
+    size += CTelegramStream::serializedSize(about);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ChannelsEditAbout;
     outputStream << channel;
     outputStream << about;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::channelsEditAdmin(const TLInputChannel &channel, const TLInputUser &userId, const TLChannelParticipantRole &role)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(channel);
+    size += CTelegramStream::serializedSize(userId);
+    size += CTelegramStream::serializedSize(role);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ChannelsEditAdmin;
     outputStream << channel;
     outputStream << userId;
     outputStream << role;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::channelsEditPhoto(const TLInputChannel &channel, const TLInputChatPhoto &photo)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(channel);
+    size += CTelegramStream::serializedSize(photo);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ChannelsEditPhoto;
     outputStream << channel;
     outputStream << photo;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::channelsEditTitle(const TLInputChannel &channel, const QString &title)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(channel);
+    size += CTelegramStream::serializedSize(title);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ChannelsEditTitle;
     outputStream << channel;
     outputStream << title;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::channelsExportInvite(const TLInputChannel &channel)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(channel);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ChannelsExportInvite;
     outputStream << channel;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::channelsGetChannels(const TLVector<TLInputChannel> &id)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(id);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ChannelsGetChannels;
     outputStream << id;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::channelsGetDialogs(quint32 offset, quint32 limit)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(offset);
+    size += CTelegramStream::serializedSize(limit);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ChannelsGetDialogs;
     outputStream << offset;
     outputStream << limit;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::channelsGetFullChannel(const TLInputChannel &channel)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(channel);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ChannelsGetFullChannel;
     outputStream << channel;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::channelsGetImportantHistory(const TLInputChannel &channel, quint32 offsetId, quint32 addOffset, quint32 limit, quint32 maxId, quint32 minId)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(channel);
+    size += CTelegramStream::serializedSize(offsetId);
+    size += CTelegramStream::serializedSize(addOffset);
+    size += CTelegramStream::serializedSize(limit);
+    size += CTelegramStream::serializedSize(maxId);
+    size += CTelegramStream::serializedSize(minId);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ChannelsGetImportantHistory;
     outputStream << channel;
     outputStream << offsetId;
@@ -792,448 +970,528 @@ quint64 CTelegramConnection::channelsGetImportantHistory(const TLInputChannel &c
     outputStream << limit;
     outputStream << maxId;
     outputStream << minId;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::channelsGetMessages(const TLInputChannel &channel, const TLVector<quint32> &id)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(channel);
+    size += CTelegramStream::serializedSize(id);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ChannelsGetMessages;
     outputStream << channel;
     outputStream << id;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::channelsGetParticipant(const TLInputChannel &channel, const TLInputUser &userId)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(channel);
+    size += CTelegramStream::serializedSize(userId);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ChannelsGetParticipant;
     outputStream << channel;
     outputStream << userId;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::channelsGetParticipants(const TLInputChannel &channel, const TLChannelParticipantsFilter &filter, quint32 offset, quint32 limit)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(channel);
+    size += CTelegramStream::serializedSize(filter);
+    size += CTelegramStream::serializedSize(offset);
+    size += CTelegramStream::serializedSize(limit);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ChannelsGetParticipants;
     outputStream << channel;
     outputStream << filter;
     outputStream << offset;
     outputStream << limit;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::channelsInviteToChannel(const TLInputChannel &channel, const TLVector<TLInputUser> &users)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(channel);
+    size += CTelegramStream::serializedSize(users);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ChannelsInviteToChannel;
     outputStream << channel;
     outputStream << users;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::channelsJoinChannel(const TLInputChannel &channel)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(channel);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ChannelsJoinChannel;
     outputStream << channel;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::channelsKickFromChannel(const TLInputChannel &channel, const TLInputUser &userId, bool kicked)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(channel);
+    size += CTelegramStream::serializedSize(userId);
+    size += CTelegramStream::serializedSize(kicked);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ChannelsKickFromChannel;
     outputStream << channel;
     outputStream << userId;
     outputStream << kicked;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::channelsLeaveChannel(const TLInputChannel &channel)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(channel);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ChannelsLeaveChannel;
     outputStream << channel;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::channelsReadHistory(const TLInputChannel &channel, quint32 maxId)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(channel);
+    size += CTelegramStream::serializedSize(maxId);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ChannelsReadHistory;
     outputStream << channel;
     outputStream << maxId;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::channelsReportSpam(const TLInputChannel &channel, const TLInputUser &userId, const TLVector<quint32> &id)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(channel);
+    size += CTelegramStream::serializedSize(userId);
+    size += CTelegramStream::serializedSize(id);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ChannelsReportSpam;
     outputStream << channel;
     outputStream << userId;
     outputStream << id;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::channelsToggleComments(const TLInputChannel &channel, bool enabled)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(channel);
+    size += CTelegramStream::serializedSize(enabled);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ChannelsToggleComments;
     outputStream << channel;
     outputStream << enabled;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::channelsUpdateUsername(const TLInputChannel &channel, const QString &username)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(channel);
+    size += CTelegramStream::serializedSize(username);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ChannelsUpdateUsername;
     outputStream << channel;
     outputStream << username;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::contactsBlock(const TLInputUser &id)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(id);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ContactsBlock;
     outputStream << id;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::contactsDeleteContact(const TLInputUser &id)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(id);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ContactsDeleteContact;
     outputStream << id;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::contactsDeleteContacts(const TLVector<TLInputUser> &id)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(id);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ContactsDeleteContacts;
     outputStream << id;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::contactsExportCard()
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ContactsExportCard;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::contactsGetBlocked(quint32 offset, quint32 limit)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(offset);
+    size += CTelegramStream::serializedSize(limit);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ContactsGetBlocked;
     outputStream << offset;
     outputStream << limit;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::contactsGetContacts(const QString &hash)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(hash);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ContactsGetContacts;
     outputStream << hash;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::contactsGetStatuses()
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ContactsGetStatuses;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::contactsGetSuggested(quint32 limit)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(limit);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ContactsGetSuggested;
     outputStream << limit;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::contactsImportCard(const TLVector<quint32> &exportCard)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(exportCard);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ContactsImportCard;
     outputStream << exportCard;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::contactsImportContacts(const TLVector<TLInputContact> &contacts, bool replace)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(contacts);
+    size += CTelegramStream::serializedSize(replace);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ContactsImportContacts;
     outputStream << contacts;
     outputStream << replace;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::contactsResolveUsername(const QString &username)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(username);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ContactsResolveUsername;
     outputStream << username;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::contactsSearch(const QString &q, quint32 limit)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(q);
+    size += CTelegramStream::serializedSize(limit);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ContactsSearch;
     outputStream << q;
     outputStream << limit;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::contactsUnblock(const TLInputUser &id)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(id);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::ContactsUnblock;
     outputStream << id;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::helpGetAppChangelog(const QString &deviceModel, const QString &systemVersion, const QString &appVersion, const QString &langCode)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(deviceModel);
+    size += CTelegramStream::serializedSize(systemVersion);
+    size += CTelegramStream::serializedSize(appVersion);
+    size += CTelegramStream::serializedSize(langCode);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::HelpGetAppChangelog;
     outputStream << deviceModel;
     outputStream << systemVersion;
     outputStream << appVersion;
     outputStream << langCode;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::helpGetAppUpdate(const QString &deviceModel, const QString &systemVersion, const QString &appVersion, const QString &langCode)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(deviceModel);
+    size += CTelegramStream::serializedSize(systemVersion);
+    size += CTelegramStream::serializedSize(appVersion);
+    size += CTelegramStream::serializedSize(langCode);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::HelpGetAppUpdate;
     outputStream << deviceModel;
     outputStream << systemVersion;
     outputStream << appVersion;
     outputStream << langCode;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::helpGetConfig()
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::HelpGetConfig;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::helpGetInviteText(const QString &langCode)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(langCode);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::HelpGetInviteText;
     outputStream << langCode;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::helpGetNearestDc()
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::HelpGetNearestDc;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::helpGetSupport()
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::HelpGetSupport;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::helpGetTermsOfService(const QString &langCode)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(langCode);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::HelpGetTermsOfService;
     outputStream << langCode;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::helpSaveAppLog(const TLVector<TLInputAppEvent> &events)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(events);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::HelpSaveAppLog;
     outputStream << events;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesAcceptEncryption(const TLInputEncryptedChat &peer, const QByteArray &gB, quint64 keyFingerprint)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(peer);
+    size += CTelegramStream::serializedSize(gB);
+    size += CTelegramStream::serializedSize(keyFingerprint);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesAcceptEncryption;
     outputStream << peer;
     outputStream << gB;
     outputStream << keyFingerprint;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesAddChatUser(quint32 chatId, const TLInputUser &userId, quint32 fwdLimit)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(chatId);
+    size += CTelegramStream::serializedSize(userId);
+    size += CTelegramStream::serializedSize(fwdLimit);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesAddChatUser;
     outputStream << chatId;
     outputStream << userId;
     outputStream << fwdLimit;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesCheckChatInvite(const QString &hash)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(hash);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesCheckChatInvite;
     outputStream << hash;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesCreateChat(const TLVector<TLInputUser> &users, const QString &title)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(users);
+    size += CTelegramStream::serializedSize(title);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesCreateChat;
     outputStream << users;
     outputStream << title;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesDeleteChatUser(quint32 chatId, const TLInputUser &userId)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(chatId);
+    size += CTelegramStream::serializedSize(userId);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesDeleteChatUser;
     outputStream << chatId;
     outputStream << userId;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesDeleteHistory(const TLInputPeer &peer, quint32 maxId)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(peer);
+    size += CTelegramStream::serializedSize(maxId);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesDeleteHistory;
     outputStream << peer;
     outputStream << maxId;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesDeleteMessages(const TLVector<quint32> &id)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(id);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesDeleteMessages;
     outputStream << id;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesDiscardEncryption(quint32 chatId)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(chatId);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesDiscardEncryption;
     outputStream << chatId;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesEditChatAdmin(quint32 chatId, const TLInputUser &userId, bool isAdmin)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(chatId);
+    size += CTelegramStream::serializedSize(userId);
+    size += CTelegramStream::serializedSize(isAdmin);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesEditChatAdmin;
     outputStream << chatId;
     outputStream << userId;
     outputStream << isAdmin;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesEditChatPhoto(quint32 chatId, const TLInputChatPhoto &photo)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(chatId);
+    size += CTelegramStream::serializedSize(photo);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesEditChatPhoto;
     outputStream << chatId;
     outputStream << photo;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesEditChatTitle(quint32 chatId, const QString &title)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(chatId);
+    size += CTelegramStream::serializedSize(title);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesEditChatTitle;
     outputStream << chatId;
     outputStream << title;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesExportChatInvite(quint32 chatId)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(chatId);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesExportChatInvite;
     outputStream << chatId;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesForwardMessage(const TLInputPeer &peer, quint32 id, quint64 randomId)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(peer);
+    size += CTelegramStream::serializedSize(id);
+    size += CTelegramStream::serializedSize(randomId);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesForwardMessage;
     outputStream << peer;
     outputStream << id;
     outputStream << randomId;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesForwardMessages(quint32 flags, const TLInputPeer &fromPeer, const TLVector<quint32> &id, const TLVector<quint64> &randomId, const TLInputPeer &toPeer)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(flags);
+    size += CTelegramStream::serializedSize(fromPeer);
+    size += CTelegramStream::serializedSize(id);
+    size += CTelegramStream::serializedSize(randomId);
+    size += CTelegramStream::serializedSize(toPeer);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesForwardMessages;
     outputStream << flags;
     // (flags & 1 << 4) stands for broadcast "true" value
@@ -1241,73 +1499,91 @@ quint64 CTelegramConnection::messagesForwardMessages(quint32 flags, const TLInpu
     outputStream << id;
     outputStream << randomId;
     outputStream << toPeer;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesGetAllStickers(quint32 hash)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(hash);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesGetAllStickers;
     outputStream << hash;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesGetChats(const TLVector<quint32> &id)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(id);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesGetChats;
     outputStream << id;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesGetDhConfig(quint32 version, quint32 randomLength)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(version);
+    size += CTelegramStream::serializedSize(randomLength);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesGetDhConfig;
     outputStream << version;
     outputStream << randomLength;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesGetDialogs(quint32 offsetDate, quint32 offsetId, const TLInputPeer &offsetPeer, quint32 limit)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(offsetDate);
+    size += CTelegramStream::serializedSize(offsetId);
+    size += CTelegramStream::serializedSize(offsetPeer);
+    size += CTelegramStream::serializedSize(limit);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesGetDialogs;
     outputStream << offsetDate;
     outputStream << offsetId;
     outputStream << offsetPeer;
     outputStream << limit;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesGetDocumentByHash(const QByteArray &sha256, quint32 size, const QString &mimeType)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(sha256);
+    size += CTelegramStream::serializedSize(size);
+    size += CTelegramStream::serializedSize(mimeType);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesGetDocumentByHash;
     outputStream << sha256;
     outputStream << size;
     outputStream << mimeType;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesGetFullChat(quint32 chatId)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(chatId);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesGetFullChat;
     outputStream << chatId;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesGetHistory(const TLInputPeer &peer, quint32 offsetId, quint32 addOffset, quint32 limit, quint32 maxId, quint32 minId)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(peer);
+    size += CTelegramStream::serializedSize(offsetId);
+    size += CTelegramStream::serializedSize(addOffset);
+    size += CTelegramStream::serializedSize(limit);
+    size += CTelegramStream::serializedSize(maxId);
+    size += CTelegramStream::serializedSize(minId);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesGetHistory;
     outputStream << peer;
     outputStream << offsetId;
@@ -1315,195 +1591,234 @@ quint64 CTelegramConnection::messagesGetHistory(const TLInputPeer &peer, quint32
     outputStream << limit;
     outputStream << maxId;
     outputStream << minId;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesGetInlineBotResults(const TLInputUser &bot, const QString &query, const QString &offset)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(bot);
+    size += CTelegramStream::serializedSize(query);
+    size += CTelegramStream::serializedSize(offset);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesGetInlineBotResults;
     outputStream << bot;
     outputStream << query;
     outputStream << offset;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesGetMessages(const TLVector<quint32> &id)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(id);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesGetMessages;
     outputStream << id;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesGetMessagesViews(const TLInputPeer &peer, const TLVector<quint32> &id, bool increment)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(peer);
+    size += CTelegramStream::serializedSize(id);
+    size += CTelegramStream::serializedSize(increment);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesGetMessagesViews;
     outputStream << peer;
     outputStream << id;
     outputStream << increment;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesGetSavedGifs(quint32 hash)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(hash);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesGetSavedGifs;
     outputStream << hash;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesGetStickerSet(const TLInputStickerSet &stickerset)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(stickerset);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesGetStickerSet;
     outputStream << stickerset;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesGetStickers(const QString &emoticon, const QString &hash)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(emoticon);
+    size += CTelegramStream::serializedSize(hash);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesGetStickers;
     outputStream << emoticon;
     outputStream << hash;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesGetWebPagePreview(const QString &message)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(message);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesGetWebPagePreview;
     outputStream << message;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesImportChatInvite(const QString &hash)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(hash);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesImportChatInvite;
     outputStream << hash;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesInstallStickerSet(const TLInputStickerSet &stickerset, bool disabled)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(stickerset);
+    size += CTelegramStream::serializedSize(disabled);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesInstallStickerSet;
     outputStream << stickerset;
     outputStream << disabled;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesMigrateChat(quint32 chatId)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(chatId);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesMigrateChat;
     outputStream << chatId;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesReadEncryptedHistory(const TLInputEncryptedChat &peer, quint32 maxDate)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(peer);
+    size += CTelegramStream::serializedSize(maxDate);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesReadEncryptedHistory;
     outputStream << peer;
     outputStream << maxDate;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesReadHistory(const TLInputPeer &peer, quint32 maxId)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(peer);
+    size += CTelegramStream::serializedSize(maxId);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesReadHistory;
     outputStream << peer;
     outputStream << maxId;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesReadMessageContents(const TLVector<quint32> &id)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(id);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesReadMessageContents;
     outputStream << id;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesReceivedMessages(quint32 maxId)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(maxId);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesReceivedMessages;
     outputStream << maxId;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesReceivedQueue(quint32 maxQts)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(maxQts);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesReceivedQueue;
     outputStream << maxQts;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesReorderStickerSets(const TLVector<quint64> &order)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(order);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesReorderStickerSets;
     outputStream << order;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesReportSpam(const TLInputPeer &peer)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(peer);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesReportSpam;
     outputStream << peer;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesRequestEncryption(const TLInputUser &userId, quint32 randomId, const QByteArray &gA)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(userId);
+    size += CTelegramStream::serializedSize(randomId);
+    size += CTelegramStream::serializedSize(gA);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesRequestEncryption;
     outputStream << userId;
     outputStream << randomId;
     outputStream << gA;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesSaveGif(const TLInputDocument &id, bool unsave)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(id);
+    size += CTelegramStream::serializedSize(unsave);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesSaveGif;
     outputStream << id;
     outputStream << unsave;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesSearch(quint32 flags, const TLInputPeer &peer, const QString &q, const TLMessagesFilter &filter, quint32 minDate, quint32 maxDate, quint32 offset, quint32 maxId, quint32 limit)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(flags);
+    size += CTelegramStream::serializedSize(peer);
+    size += CTelegramStream::serializedSize(q);
+    size += CTelegramStream::serializedSize(filter);
+    size += CTelegramStream::serializedSize(minDate);
+    size += CTelegramStream::serializedSize(maxDate);
+    size += CTelegramStream::serializedSize(offset);
+    size += CTelegramStream::serializedSize(maxId);
+    size += CTelegramStream::serializedSize(limit);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesSearch;
     outputStream << flags;
     // (flags & 1 << 0) stands for importantOnly "true" value
@@ -1515,82 +1830,111 @@ quint64 CTelegramConnection::messagesSearch(quint32 flags, const TLInputPeer &pe
     outputStream << offset;
     outputStream << maxId;
     outputStream << limit;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesSearchGifs(const QString &q, quint32 offset)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(q);
+    size += CTelegramStream::serializedSize(offset);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesSearchGifs;
     outputStream << q;
     outputStream << offset;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesSearchGlobal(const QString &q, quint32 offsetDate, const TLInputPeer &offsetPeer, quint32 offsetId, quint32 limit)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(q);
+    size += CTelegramStream::serializedSize(offsetDate);
+    size += CTelegramStream::serializedSize(offsetPeer);
+    size += CTelegramStream::serializedSize(offsetId);
+    size += CTelegramStream::serializedSize(limit);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesSearchGlobal;
     outputStream << q;
     outputStream << offsetDate;
     outputStream << offsetPeer;
     outputStream << offsetId;
     outputStream << limit;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesSendBroadcast(const TLVector<TLInputUser> &contacts, const TLVector<quint64> &randomId, const QString &message, const TLInputMedia &media)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(contacts);
+    size += CTelegramStream::serializedSize(randomId);
+    size += CTelegramStream::serializedSize(message);
+    size += CTelegramStream::serializedSize(media);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesSendBroadcast;
     outputStream << contacts;
     outputStream << randomId;
     outputStream << message;
     outputStream << media;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesSendEncrypted(const TLInputEncryptedChat &peer, quint64 randomId, const QByteArray &data)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(peer);
+    size += CTelegramStream::serializedSize(randomId);
+    size += CTelegramStream::serializedSize(data);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesSendEncrypted;
     outputStream << peer;
     outputStream << randomId;
     outputStream << data;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesSendEncryptedFile(const TLInputEncryptedChat &peer, quint64 randomId, const QByteArray &data, const TLInputEncryptedFile &file)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(peer);
+    size += CTelegramStream::serializedSize(randomId);
+    size += CTelegramStream::serializedSize(data);
+    size += CTelegramStream::serializedSize(file);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesSendEncryptedFile;
     outputStream << peer;
     outputStream << randomId;
     outputStream << data;
     outputStream << file;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesSendEncryptedService(const TLInputEncryptedChat &peer, quint64 randomId, const QByteArray &data)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(peer);
+    size += CTelegramStream::serializedSize(randomId);
+    size += CTelegramStream::serializedSize(data);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesSendEncryptedService;
     outputStream << peer;
     outputStream << randomId;
     outputStream << data;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesSendInlineBotResult(quint32 flags, const TLInputPeer &peer, quint32 replyToMsgId, quint64 randomId, quint64 queryId, const QString &id)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(flags);
+    size += CTelegramStream::serializedSize(peer);
+    if (flags & 1 << 0) {
+        size += CTelegramStream::serializedSize(replyToMsgId);
+    }
+    size += CTelegramStream::serializedSize(randomId);
+    size += CTelegramStream::serializedSize(queryId);
+    size += CTelegramStream::serializedSize(id);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesSendInlineBotResult;
     outputStream << flags;
     // (flags & 1 << 4) stands for broadcast "true" value
@@ -1601,13 +1945,23 @@ quint64 CTelegramConnection::messagesSendInlineBotResult(quint32 flags, const TL
     outputStream << randomId;
     outputStream << queryId;
     outputStream << id;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesSendMedia(quint32 flags, const TLInputPeer &peer, quint32 replyToMsgId, const TLInputMedia &media, quint64 randomId, const TLReplyMarkup &replyMarkup)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(flags);
+    size += CTelegramStream::serializedSize(peer);
+    if (flags & 1 << 0) {
+        size += CTelegramStream::serializedSize(replyToMsgId);
+    }
+    size += CTelegramStream::serializedSize(media);
+    size += CTelegramStream::serializedSize(randomId);
+    if (flags & 1 << 2) {
+        size += CTelegramStream::serializedSize(replyMarkup);
+    }
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesSendMedia;
     outputStream << flags;
     // (flags & 1 << 4) stands for broadcast "true" value
@@ -1620,13 +1974,26 @@ quint64 CTelegramConnection::messagesSendMedia(quint32 flags, const TLInputPeer
     if (flags & 1 << 2) {
         outputStream << replyMarkup;
     }
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesSendMessage(quint32 flags, const TLInputPeer &peer, quint32 replyToMsgId, const QString &message, quint64 randomId, const TLReplyMarkup &replyMarkup, const TLVector<TLMessageEntity> &entities)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(flags);
+    size += CTelegramStream::serializedSize(peer);
+    if (flags & 1 << 0) {
+        size += CTelegramStream::serializedSize(replyToMsgId);
+    }
+    size += CTelegramStream::serializedSize(message);
+    size += CTelegramStream::serializedSize(randomId);
+    if (flags & 1 << 2) {
+        size += CTelegramStream::serializedSize(replyMarkup);
+    }
+    if (flags & 1 << 3) {
+        size += CTelegramStream::serializedSize(entities);
+    }
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesSendMessage;
     outputStream << flags;
     // (flags & 1 << 1) stands for noWebpage "true" value
@@ -1643,23 +2010,32 @@ quint64 CTelegramConnection::messagesSendMessage(quint32 flags, const TLInputPee
     if (flags & 1 << 3) {
         outputStream << entities;
     }
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesSetEncryptedTyping(const TLInputEncryptedChat &peer, bool typing)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(peer);
+    size += CTelegramStream::serializedSize(typing);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesSetEncryptedTyping;
     outputStream << peer;
     outputStream << typing;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesSetInlineBotResults(quint32 flags, quint64 queryId, const TLVector<TLInputBotInlineResult> &results, quint32 cacheTime, const QString &nextOffset)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(flags);
+    size += CTelegramStream::serializedSize(queryId);
+    size += CTelegramStream::serializedSize(results);
+    size += CTelegramStream::serializedSize(cacheTime);
+    if (flags & 1 << 2) {
+        size += CTelegramStream::serializedSize(nextOffset);
+    }
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesSetInlineBotResults;
     outputStream << flags;
     // (flags & 1 << 0) stands for gallery "true" value
@@ -1670,131 +2046,159 @@ quint64 CTelegramConnection::messagesSetInlineBotResults(quint32 flags, quint64
     if (flags & 1 << 2) {
         outputStream << nextOffset;
     }
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesSetTyping(const TLInputPeer &peer, const TLSendMessageAction &action)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(peer);
+    size += CTelegramStream::serializedSize(action);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesSetTyping;
     outputStream << peer;
     outputStream << action;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesStartBot(const TLInputUser &bot, const TLInputPeer &peer, quint64 randomId, const QString &startParam)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(bot);
+    size += CTelegramStream::serializedSize(peer);
+    size += CTelegramStream::serializedSize(randomId);
+    size += CTelegramStream::serializedSize(startParam);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesStartBot;
     outputStream << bot;
     outputStream << peer;
     outputStream << randomId;
     outputStream << startParam;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesToggleChatAdmins(quint32 chatId, bool enabled)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(chatId);
+    size += CTelegramStream::serializedSize(enabled);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesToggleChatAdmins;
     outputStream << chatId;
     outputStream << enabled;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::messagesUninstallStickerSet(const TLInputStickerSet &stickerset)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(stickerset);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::MessagesUninstallStickerSet;
     outputStream << stickerset;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::updatesGetChannelDifference(const TLInputChannel &channel, const TLChannelMessagesFilter &filter, quint32 pts, quint32 limit)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(channel);
+    size += CTelegramStream::serializedSize(filter);
+    size += CTelegramStream::serializedSize(pts);
+    size += CTelegramStream::serializedSize(limit);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::UpdatesGetChannelDifference;
     outputStream << channel;
     outputStream << filter;
     outputStream << pts;
     outputStream << limit;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::updatesGetDifference(quint32 pts, quint32 date, quint32 qts)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(pts);
+    size += CTelegramStream::serializedSize(date);
+    size += CTelegramStream::serializedSize(qts);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::UpdatesGetDifference;
     outputStream << pts;
     outputStream << date;
     outputStream << qts;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::updatesGetState()
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::UpdatesGetState;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::uploadGetFile(const TLInputFileLocation &location, quint32 offset, quint32 limit)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(location);
+    size += CTelegramStream::serializedSize(offset);
+    size += CTelegramStream::serializedSize(limit);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::UploadGetFile;
     outputStream << location;
     outputStream << offset;
     outputStream << limit;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::uploadSaveBigFilePart(quint64 fileId, quint32 filePart, quint32 fileTotalParts, const QByteArray &bytes)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(fileId);
+    size += CTelegramStream::serializedSize(filePart);
+    size += CTelegramStream::serializedSize(fileTotalParts);
+    size += CTelegramStream::serializedSize(bytes);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::UploadSaveBigFilePart;
     outputStream << fileId;
     outputStream << filePart;
     outputStream << fileTotalParts;
     outputStream << bytes;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::uploadSaveFilePart(quint64 fileId, quint32 filePart, const QByteArray &bytes)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(fileId);
+    size += CTelegramStream::serializedSize(filePart);
+    size += CTelegramStream::serializedSize(bytes);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::UploadSaveFilePart;
     outputStream << fileId;
     outputStream << filePart;
     outputStream << bytes;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::usersGetFullUser(const TLInputUser &id)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(id);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::UsersGetFullUser;
     outputStream << id;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 quint64 CTelegramConnection::usersGetUsers(const TLVector<TLInputUser> &id)
 {
-    QByteArray output;
-    CTelegramStream outputStream(&output, /* write */ true);
+    quint32 size = 4;
+    size += CTelegramStream::serializedSize(id);
+    CTelegramStream outputStream(CTelegramStream::WriteOnly, size);
     outputStream << TLValue::UsersGetUsers;
     outputStream << id;
-    return sendEncryptedPackage(output);
+    return sendRequest(outputStream.getData());
 }
 
 // End of generated Telegram API methods implementation
@@ -1824,6 +2228,19 @@ quint64 CTelegramConnection::pingDelayDisconnect(quint32 disconnectInSec)
     return sendEncryptedPackage(output);
 }
 
+quint64 CTelegramConnection::getFutureSalts(quint32 count)
+{
+    // https://core.telegram.org/mtproto/service_messages#request-for-several-future-salts
+    QByteArray output;
+    CTelegramStream outputStream(&output, /* write */ true);
+
+    outputStream << TLValue::GetFutureSalts;
+    outputStream << count;
+
+    m_futureSaltsRequestId = sendEncryptedPackage(output);
+    return m_futureSaltsRequestId;
+}
+
 quint64 CTelegramConnection::acknowledgeMessages(const TLVector<quint64> &idsVector)
 {
 //    qDebug() << Q_FUNC_INFO << idsVector;
@@ -1837,13 +2254,27 @@ quint64 CTelegramConnection::acknowledgeMessages(const TLVector<quint64> &idsVec
     return sendEncryptedPackage(output, /* save package */ false);
 }
 
-bool CTelegramConnection::acceptPqAuthorization(const QByteArray &payload)
+quint64 CTelegramConnection::requestMessagesState(const TLVector<quint64> &idsVector)
 {
-    qDebug() << Q_FUNC_INFO;
-    CTelegramStream inputStream(payload);
+    // https://core.telegram.org/mtproto/service_messages_about_messages#request-for-message-status-information
+    QByteArray output;
+    CTelegramStream outputStream(&output, /* write */ true);
 
-    TLValue responsePqValue;
-    inputStream >> responsePqValue;
+    outputStream << TLValue::MsgsStateReq;
+    outputStream << idsVector;
+
+    const quint64 requestId = sendEncryptedPackage(output, /* save package */ false);
+    m_messagesStateRequests.insert(requestId, idsVector);
+    return requestId;
+}
+
+bool CTelegramConnection::acceptPqAuthorization(const QByteArray &payload)
+{
+    qDebug() << Q_FUNC_INFO;
+    CTelegramStream inputStream(payload);
+
+    TLValue responsePqValue;
+    inputStream >> responsePqValue;
 
     if (responsePqValue != TLValue::ResPQ) {
         qDebug() << "Error: Unexpected operation code";
@@ -1873,7 +2304,10 @@ bool CTelegramConnection::acceptPqAuthorization(const QByteArray &payload)
 
     m_pq = qFromBigEndian<quint64>(reinterpret_cast<const uchar*>(pq.constData()));
 
+    QElapsedTimer factorizationTimer;
+    factorizationTimer.start();
     quint64 div1 = Utils::findDivider(m_pq);
+    m_authTimings.factorization = factorizationTimer.elapsed();
 
     if (div1 == 1) {
         qDebug() << "Error: Can not solve PQ.";
@@ -1924,36 +2358,40 @@ void CTelegramConnection::requestDhParameters()
     QByteArray bigEndianNumber;
     bigEndianNumber.fill(char(0), 8);
 
-    QByteArray encryptedPackage;
-    {
-        static const int requestedEncryptedPackageLength = 255;
-        QByteArray innerData;
-        CTelegramStream encryptedStream(&innerData, /* write */ true);
+    static const int requestedEncryptedPackageLength = 255;
+    QByteArray innerData;
+    CTelegramStream encryptedStream(&innerData, /* write */ true);
 
-        encryptedStream << TLValue::PQInnerData;
+    // A temporary key is generated the same way, the server only needs to know its lifetime
+    encryptedStream << (m_temporaryKeyLifetime ? TLValue::PQInnerDataTemp : TLValue::PQInnerData);
 
-        qToBigEndian(m_pq, (uchar *) bigEndianNumber.data());
-        encryptedStream << bigEndianNumber;
+    qToBigEndian(m_pq, (uchar *) bigEndianNumber.data());
+    encryptedStream << bigEndianNumber;
 
-        bigEndianNumber.fill(char(0), 4);
-        qToBigEndian(m_p, (uchar *) bigEndianNumber.data());
-        encryptedStream << bigEndianNumber;
+    bigEndianNumber.fill(char(0), 4);
+    qToBigEndian(m_p, (uchar *) bigEndianNumber.data());
+    encryptedStream << bigEndianNumber;
 
-        qToBigEndian(m_q, (uchar *) bigEndianNumber.data());
-        encryptedStream << bigEndianNumber;
+    qToBigEndian(m_q, (uchar *) bigEndianNumber.data());
+    encryptedStream << bigEndianNumber;
 
-        encryptedStream << m_clientNonce;
-        encryptedStream << m_serverNonce;
-        encryptedStream << m_newNonce;
+    encryptedStream << m_clientNonce;
+    encryptedStream << m_serverNonce;
+    encryptedStream << m_newNonce;
+    if (m_temporaryKeyLifetime) {
+        encryptedStream << m_temporaryKeyLifetime;
+    }
 
-        QByteArray sha = Utils::sha1(innerData);
-        QByteArray randomPadding;
-        randomPadding.resize(requestedEncryptedPackageLength - (sha.length() + innerData.length()));
-        Utils::randomBytes(&randomPadding);
+    QByteArray sha = Utils::sha1(innerData);
+    QByteArray randomPadding;
+    randomPadding.resize(requestedEncryptedPackageLength - (sha.length() + innerData.length()));
+    Utils::randomBytes(&randomPadding);
 
-        encryptedPackage = Utils::rsa(sha + innerData + randomPadding, m_rsaKey);
-    }
+    startAuthCryptoJob(CAuthCryptoJob::rsaEncrypt(sha + innerData + randomPadding, m_rsaKey));
+}
 
+void CTelegramConnection::sendDhParametersRequest(const QByteArray &encryptedPackage)
+{
     QByteArray output;
     CTelegramStream outputStream(&output, /* write */ true);
 
@@ -1961,6 +2399,7 @@ void CTelegramConnection::requestDhParameters()
     outputStream << m_clientNonce;
     outputStream << m_serverNonce;
 
+    QByteArray bigEndianNumber;
     bigEndianNumber.fill(char(0), 4);
     qToBigEndian(m_p, (uchar *) bigEndianNumber.data());
     outputStream << bigEndianNumber;
@@ -2049,7 +2488,6 @@ bool CTelegramConnection::processServerDHParamsOK(const QByteArray &encryptedAns
     quint32 serverTime;
     encryptedInputStream >> serverTime;
     setDeltaTime(qint64(serverTime) - (QDateTime::currentMSecsSinceEpoch() / 1000));
-    m_deltaTimeHeuristicState = DeltaTimeIsOk;
     return true;
 }
 
@@ -2059,6 +2497,7 @@ void CTelegramConnection::generateDh()
     // #6 Client computes random 2048-bit number b (using a sufficient amount of entropy) and sends the server a message
     m_b.resize(256);
     Utils::randomBytes(&m_b);
+    m_dhAuthKey.clear();
 
     // IMPORTANT: Apart from the conditions on the Diffie-Hellman prime dh_prime and generator g,
     // both sides are to check that g, g_a and g_b are greater than 1 and less than dh_prime - 1.
@@ -2072,6 +2511,11 @@ void CTelegramConnection::generateDh()
 void CTelegramConnection::requestDhGenerationResult()
 {
     qDebug() << Q_FUNC_INFO;
+    startAuthCryptoJob(CAuthCryptoJob::dhExchange(m_g, m_dhPrime, m_gA, m_b));
+}
+
+void CTelegramConnection::sendDhGenerationResultRequest(const QByteArray &gB)
+{
     QByteArray output;
     CTelegramStream outputStream(&output, /* write */ true);
 
@@ -2089,14 +2533,7 @@ void CTelegramConnection::requestDhGenerationResult()
         encryptedStream << m_clientNonce;
         encryptedStream << m_serverNonce;
         encryptedStream << m_authRetryId;
-
-        QByteArray binNumber;
-        binNumber.resize(sizeof(m_g));
-        qToBigEndian(m_g, (uchar *) binNumber.data());
-
-        binNumber = Utils::binaryNumberModExp(binNumber, m_dhPrime, m_b);
-
-        encryptedStream << binNumber;
+        encryptedStream << gB;
 
         QByteArray sha = Utils::sha1(innerData);
         QByteArray randomPadding;
@@ -2133,7 +2570,8 @@ bool CTelegramConnection::processServerDhAnswer(const QByteArray &payload)
     TLNumber128 newNonceHashLower128;
     inputStream >> newNonceHashLower128;
     const QByteArray readedHashPart(newNonceHashLower128.data, newNonceHashLower128.size());
-    const QByteArray newAuthKey = Utils::binaryNumberModExp(m_gA, m_dhPrime, m_b);
+    const QByteArray newAuthKey = m_dhAuthKey.isEmpty() ? Utils::binaryNumberModExp(m_gA, m_dhPrime, m_b) : m_dhAuthKey;
+    m_dhAuthKey.clear();
     const QByteArray newAuthKeySha = Utils::sha1(newAuthKey);
     QByteArray expectedHashData(m_newNonce.data, m_newNonce.size());
     expectedHashData.append(newAuthKeySha.left(8));
@@ -2158,6 +2596,11 @@ bool CTelegramConnection::processServerDhAnswer(const QByteArray &payload)
         qDebug() << "Server DH answer is accepted. Setup the auth key...";
         setAuthKey(newAuthKey);
         m_serverSalt = m_serverNonce.parts[0] ^ m_newNonce.parts[0];
+        if (m_temporaryKeyLifetime) {
+            m_authKeyExpiresAt = (QDateTime::currentMSecsSinceEpoch() + m_timeOffset) / 1000 + m_temporaryKeyLifetime;
+        } else {
+            m_authKeyExpiresAt = 0;
+        }
         setAuthState(AuthStateHaveAKey);
     } else {
         qDebug() << "Server DH answer is not accepted. Retry...";
@@ -2174,7 +2617,7 @@ bool CTelegramConnection::processServerDhAnswer(const QByteArray &payload)
 
 void CTelegramConnection::processRedirectedPackage(const QByteArray &data)
 {
-    sendEncryptedPackage(data);
+    sendRequest(data);
 }
 
 TLValue CTelegramConnection::processRpcQuery(const QByteArray &data)
@@ -2211,16 +2654,17 @@ TLValue CTelegramConnection::processRpcQuery(const QByteArray &data)
     case TLValue::Pong:
         processPingPong(stream);
         break;
+    case TLValue::FutureSalts:
+        processFutureSalts(stream);
+        break;
+    case TLValue::MsgsStateInfo:
+        processMessagesStateInfo(stream);
+        break;
     default:
         qDebug() << Q_FUNC_INFO << "value:" << value;
         break;
     }
 
-    if ((value != TLValue::BadMsgNotification) && (m_deltaTimeHeuristicState != DeltaTimeIsOk)) {
-        // If we have no bad message notification, then time is synced.
-        m_deltaTimeHeuristicState = DeltaTimeIsOk;
-    }
-
     if (stream.error()) {
         qWarning() << Q_FUNC_INFO << "Read of RPC result caused error. RPC type:" << value << "(read from the package -> can be misleading)";
     }
@@ -2257,6 +2701,7 @@ void CTelegramConnection::processContainer(CTelegramStream &stream)
 
         stream >> size;
 
+        m_lastReceivedMessageId = qMax(m_lastReceivedMessageId, id);
         processRpcQuery(stream.readBytes(size));
     }
 }
@@ -2269,7 +2714,15 @@ void CTelegramConnection::processRpcResult(CTelegramStream &stream, quint64 idHi
         stream >> id;
     }
 
-    RpcProcessingContext context(stream, id, m_submittedPackages.value(id));
+    // The answer is reported with the id returned by the request method, even if the request was queued or resent
+    const PendingRequest pendingRequest = m_pendingRequests.value(id);
+    const quint64 requestId = pendingRequest.requestId ? pendingRequest.requestId : id;
+
+    // The long requests wait on the server side, so their round-trip is not the network one
+    if (pendingRequest.sentTime && (requestDeadline(pendingRequest.method) <= s_requestDefaultDeadline)) {
+        m_rttEstimator.addSample(QDateTime::currentMSecsSinceEpoch() - pendingRequest.sentTime);
+    }
+    RpcProcessingContext context(stream, requestId, m_submittedPackages.value(id));
     if (context.hasRequestData()) {
         if (!context.requestType().isValid()) {
             qWarning() << Q_FUNC_INFO << "Invalid request type from the saved package. Package with id" << id << "ignored.";
@@ -2706,6 +3159,7 @@ void CTelegramConnection::processRpcResult(CTelegramStream &stream, quint64 idHi
             addMessageToAck(id);
             break;
         }
+        m_pendingRequests.remove(id);
         if (stream.error()) {
             qWarning() << Q_FUNC_INFO << "Read of RPC result caused an error. RPC type:" << context.requestType() << "Package id:" << id;
         }
@@ -2751,6 +3205,13 @@ bool CTelegramConnection::processRpcError(CTelegramStream &stream, quint64 id, T
 
     qDebug() << Q_FUNC_INFO << QString(QLatin1String("RPC Error %1: %2 for message %3 %4 (dc %5|%6:%7)"))
                 .arg(errorCode).arg(errorMessage).arg(id).arg(request.toString()).arg(m_dcInfo.id).arg(m_dcInfo.ipAddress).arg(m_dcInfo.port);
+    if ((request == TLValue::AuthBindTempAuthKey) && isTemporaryKeyBinding(id)) {
+        // Not an error of the user session; the connection goes on with the permanent key
+        finishTemporaryKeyBinding(/* bound */ false);
+        emit errorReceived(errorCode, errorMessage, /* processed */ true);
+        return true;
+    }
+
     bool processed = false;
     switch (errorCode) {
     case 303: // ERROR_SEE_OTHER
@@ -2817,12 +3278,12 @@ bool CTelegramConnection::processRpcError(CTelegramStream &stream, quint64 id, T
         case TLValue::MessagesGetChats:
         {
             const QByteArray data = m_submittedPackages.value(id);
-            CTelegramStream stream(data);
+            CTelegramStream outputStream(data);
 
-            TLValue request;
-            stream >> request;
+            TLValue requestType;
+            outputStream >> requestType;
             TLVector<quint32> ids;
-            stream >> ids;
+            outputStream >> ids;
 
             if (ids.count() != 1) {
                 qDebug() << "Trying to restore by requesting chat one by one";
@@ -2859,15 +3320,73 @@ bool CTelegramConnection::processRpcError(CTelegramStream &stream, quint64 id, T
         }
         processed = true;
         break;
+    case 420: // FLOOD
+        if (processFloodWait(errorMessage, id, request)) {
+            processed = true;
+        }
+        break;
     default:
         qDebug() << "RPC Error can not be handled.";
         break;
     }
 
+    if (!processed && (request == TLValue::UpdatesGetChannelDifference)) {
+        // Let the dispatcher reschedule (e.g. on FLOOD_WAIT_X) or drop the channel catch up
+        const QByteArray data = m_submittedPackages.value(id);
+        CTelegramStream outputStream(data);
+        TLValue requestType;
+        TLInputChannel channel;
+        outputStream >> requestType;
+        outputStream >> channel;
+        emit updatesChannelDifferenceFailed(channel.channelId, errorCode, errorMessage);
+        processed = true;
+    }
+
     emit errorReceived(errorCode, errorMessage, processed);
     return processed;
 }
 
+bool CTelegramConnection::processFloodWait(const QString &errorMessage, quint64 id, TLValue request)
+{
+    static const QString floodWaitPrefix = QStringLiteral("FLOOD_WAIT_");
+    if (!errorMessage.startsWith(floodWaitPrefix)) {
+        return false;
+    }
+    bool ok = false;
+    const int seconds = errorMessage.mid(floodWaitPrefix.length()).toInt(&ok);
+    if (!ok) {
+        return false;
+    }
+
+    const CRequestRateLimiter::RequestClass requestClass = CRequestRateLimiter::requestClass(request);
+    if (requestClass == TelegramNamespace::RequestClassInteractive) {
+        // Do not hold the latency-sensitive requests, let the caller handle the error
+        return false;
+    }
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    qDebug() << Q_FUNC_INFO << "Requests of class" << requestClass << "are paused for" << seconds << "seconds";
+    m_rateLimiter.floodWait(requestClass, seconds, now);
+
+    if (qint64(seconds) * 1000 > requestDeadline(request)) {
+        // Fail fast instead of holding the requests for so long
+        for (const CRequestRateLimiter::Request &queued : m_rateLimiter.takeQueued(requestClass)) {
+            emit requestFailed(queued.requestId, TLValue::firstFromArray(queued.data), TelegramNamespace::RequestFailureFloodWait);
+        }
+        return false;
+    }
+
+    // Retry the request once the pause is over, before the other queued requests
+    CRequestRateLimiter::Request retry;
+    retry.requestId = m_pendingRequests.contains(id) ? m_pendingRequests.value(id).requestId : id;
+    retry.data = m_submittedPackages.take(id);
+    retry.queueTime = now;
+    m_pendingRequests.remove(id);
+    m_rateLimiter.enqueue(requestClass, retry, /* front */ true);
+    scheduleQueuedRequests();
+    return true;
+}
+
 void CTelegramConnection::processMessageAck(CTelegramStream &stream)
 {
     TLVector<quint64> idsVector;
@@ -2877,6 +3396,9 @@ void CTelegramConnection::processMessageAck(CTelegramStream &stream)
     foreach (quint64 id, idsVector) {
         qDebug() << Q_FUNC_INFO << "Package" << id << "acked";
 //        m_submittedPackages.remove(id);
+        if (m_pendingRequests.contains(id)) {
+            m_pendingRequests[id].acked = true;
+        }
     }
 }
 
@@ -2933,36 +3455,108 @@ void CTelegramConnection::processIgnoredMessageNotification(CTelegramStream &str
     }
     qDebug() << QString(QLatin1String("Bad message %1/%2: Code %3 (%4).")).arg(id).arg(seqNo).arg(errorCode).arg(errorText);
 
-    if (errorCode == 16) {
-        if (m_deltaTimeHeuristicState == DeltaTimeIsOk) {
-            m_deltaTimeHeuristicState = DeltaTimeCorrectionForward;
-        }
+    if ((errorCode == 16) || (errorCode == 17)) {
+        syncTime(id);
+        sendEncryptedPackageAgain(id);
+    } else if (errorCode == 48) {
+        m_serverSalt = m_receivedServerSalt;
+        qDebug() << "Local serverSalt fixed to" << m_serverSalt;
+        // The schedule is outdated (e.g. the salts were restored from an old session)
+        m_serverSalts.clear();
+        requestFutureSaltsIfNeeded();
+        sendEncryptedPackageAgain(id);
+    }
+}
 
-        if (m_deltaTimeHeuristicState == DeltaTimeCorrectionForward) {
-            setDeltaTime(deltaTime() + 1000);
-        } else {
-            setDeltaTime(deltaTime() + 100);
-        }
+void CTelegramConnection::processFutureSalts(CTelegramStream &stream)
+{
+    // https://core.telegram.org/mtproto/service_messages#request-for-several-future-salts
+    // The answer is not wrapped into rpc_result and the vector of the salts is bare.
+    quint64 requestId;
+    stream >> requestId;
 
-        sendEncryptedPackageAgain(id);
-        qDebug() << "DeltaTime factor increased to" << deltaTime();
-    } else if (errorCode == 17) {
-        if (m_deltaTimeHeuristicState == DeltaTimeIsOk) {
-            m_deltaTimeHeuristicState = DeltaTimeCorrectionBackward;
+    quint32 serverTime;
+    stream >> serverTime;
+
+    quint32 count;
+    stream >> count;
+
+    QVector<ServerSalt> salts;
+    for (quint32 i = 0; (i < count) && !stream.atEnd(); ++i) {
+        TLValue type;
+        stream >> type;
+        if (type != TLValue::FutureSalt) {
+            qWarning() << Q_FUNC_INFO << "Unexpected salt type" << type;
+            return;
         }
+        ServerSalt salt;
+        stream >> salt.validSince;
+        stream >> salt.validUntil;
+        stream >> salt.salt;
+        salts.append(salt);
+    }
 
-        if (m_deltaTimeHeuristicState == DeltaTimeCorrectionBackward) {
-            setDeltaTime(deltaTime() - 1000);
-        } else {
-            setDeltaTime(deltaTime() - 100);
+    m_submittedPackages.remove(requestId);
+    if (requestId == m_futureSaltsRequestId) {
+        m_futureSaltsRequestId = 0;
+    }
+
+    if (stream.error()) {
+        qWarning() << Q_FUNC_INFO << "Read error occurred.";
+        return;
+    }
+
+    qDebug() << Q_FUNC_INFO << "Received" << salts.count() << "salts";
+    setServerSalts(salts);
+}
+
+void CTelegramConnection::processMessagesStateInfo(CTelegramStream &stream)
+{
+    // https://core.telegram.org/mtproto/service_messages_about_messages#informational-message-regarding-status-of-messages
+    quint64 requestId;
+    stream >> requestId;
+
+    QByteArray info;
+    stream >> info;
+
+    const TLVector<quint64> ids = m_messagesStateRequests.take(requestId);
+    if (stream.error() || (info.size() != ids.count())) {
+        qWarning() << Q_FUNC_INFO << "Unexpected state info for request" << requestId;
+        return;
+    }
+
+    for (int i = 0; i < ids.count(); ++i) {
+        const quint64 id = ids.at(i);
+        if (!m_pendingRequests.contains(id)) {
+            continue; // Answered meanwhile
         }
 
-        sendEncryptedPackageAgain(id);
-        qDebug() << "DeltaTime factor reduced to" << deltaTime();
-    } else if (errorCode == 48) {
-        m_serverSalt = m_receivedServerSalt;
-        qDebug() << "Local serverSalt fixed to" << m_serverSalt;
-        sendEncryptedPackageAgain(id);
+        const quint8 state = info.at(i);
+        switch (state & 7) {
+        case 1: // Nothing is known about the message
+            // The id may be forgotten already (e.g. too old), so the request can not be safely sent again.
+            failRequest(id, TelegramNamespace::RequestFailureUnknownOutcome);
+            break;
+        case 2: // Not received, the id is in the range of the stored ones
+        case 3: // Not received yet, the id is too high
+            // The server has not got the request, so it is safe to send it again.
+            resendRequest(id);
+            break;
+        case 4: // Received
+            if (state & 64) {
+                // The answer is generated, but we have not got it.
+                if (isRequestIdempotent(m_pendingRequests.value(id).method)) {
+                    resendRequest(id);
+                } else {
+                    failRequest(id, TelegramNamespace::RequestFailureAnswerLost);
+                }
+            } else {
+                m_pendingRequests[id].acked = true; // Still processing
+            }
+            break;
+        default:
+            break;
+        }
     }
 }
 
@@ -2976,6 +3570,14 @@ void CTelegramConnection::processPingPong(CTelegramStream &stream)
     m_lastReceivedPingId = pid;
     m_lastReceivedPingTime = QDateTime::currentMSecsSinceEpoch();
 
+    if ((pid == m_lastSentPingId) && m_lastSentPingTime) {
+        // The answers of the previous (timed out) pings are not taken as the samples
+        m_rttEstimator.pingAnswered(m_lastReceivedPingTime - m_lastSentPingTime);
+        if (m_pingTimer && m_pingTimer->isActive()) {
+            m_pingTimer->start(int(qMax<qint64>(m_lastSentPingTime + m_rttEstimator.pingInterval() - m_lastReceivedPingTime, 0)));
+        }
+    }
+
 //    qDebug() << Q_FUNC_INFO << m_lastReceivedPingId << m_lastReceivedPingTime;
 }
 
@@ -3185,10 +3787,14 @@ void CTelegramConnection::processAccountUpdateUsername(RpcProcessingContext *con
 
 void CTelegramConnection::processAuthBindTempAuthKey(RpcProcessingContext *context)
 {
-    qWarning() << Q_FUNC_INFO << "Is not implemented yet";
     TLValue result; // bool
     context->inputStream() >> result;
     context->setReadCode(result);
+
+    // An RPC error is handled in processRpcError()
+    if ((context->requestId() == m_temporaryKeyBindingId) && ((result == TLValue::BoolTrue) || (result == TLValue::BoolFalse))) {
+        finishTemporaryKeyBinding(result == TLValue::BoolTrue);
+    }
 }
 
 void CTelegramConnection::processAuthCheckPassword(RpcProcessingContext *context)
@@ -3418,9 +4024,13 @@ void CTelegramConnection::processChannelsGetImportantHistory(RpcProcessingContex
 
 void CTelegramConnection::processChannelsGetMessages(RpcProcessingContext *context)
 {
-    qWarning() << Q_FUNC_INFO << "Is not implemented yet";
     TLMessagesMessages result;
     context->readRpcResult(&result);
+    if (!result.isValid()) {
+        return;
+    }
+
+    emit messagesMessagesReceived(result, context->requestId());
 }
 
 void CTelegramConnection::processChannelsGetParticipant(RpcProcessingContext *context)
@@ -3542,6 +4152,8 @@ void CTelegramConnection::processContactsGetContacts(RpcProcessingContext *conte
         }
 
         emit contactListReceived(contactList);
+    } else if (result.tlType == TLValue::ContactsContactsNotModified) {
+        emit contactListNotModified();
     }
 }
 
@@ -3810,10 +4422,16 @@ void CTelegramConnection::processMessagesGetHistory(RpcProcessingContext *contex
     CTelegramStream stream(context->requestData());
     TLValue value;
     TLInputPeer peer;
+    quint32 offsetId = 0;
+    quint32 addOffset = 0;
+    quint32 limit = 0;
     stream >> value;
     stream >> peer;
+    stream >> offsetId;
+    stream >> addOffset;
+    stream >> limit;
 
-    emit messagesHistoryReceived(result, peer);
+    emit messagesHistoryReceived(result, peer, offsetId, addOffset, limit);
 }
 
 void CTelegramConnection::processMessagesGetInlineBotResults(RpcProcessingContext *context)
@@ -3825,9 +4443,13 @@ void CTelegramConnection::processMessagesGetInlineBotResults(RpcProcessingContex
 
 void CTelegramConnection::processMessagesGetMessages(RpcProcessingContext *context)
 {
-    qWarning() << Q_FUNC_INFO << "Is not implemented yet";
     TLMessagesMessages result;
     context->readRpcResult(&result);
+    if (!result.isValid()) {
+        return;
+    }
+
+    emit messagesMessagesReceived(result, context->requestId());
 }
 
 void CTelegramConnection::processMessagesGetMessagesViews(RpcProcessingContext *context)
@@ -4021,7 +4643,18 @@ void CTelegramConnection::processUpdatesGetChannelDifference(RpcProcessingContex
     if (!result.isValid()) {
         return;
     }
-    emit updatesChannelDifferenceReceived(result);
+    CTelegramStream stream(context->requestData());
+    TLValue value;
+    TLInputChannel channel;
+    stream >> value;
+    stream >> channel;
+
+    if (value != TLValue::UpdatesGetChannelDifference) {
+        qWarning() << Q_FUNC_INFO << "Unexpected request data";
+        return;
+    }
+
+    emit updatesChannelDifferenceReceived(channel.channelId, result);
 }
 
 void CTelegramConnection::processUpdatesGetDifference(RpcProcessingContext *context)
@@ -4199,15 +4832,45 @@ void CTelegramConnection::onTransportStateChanged()
 
     switch (m_transport->state()) {
     case QAbstractSocket::ConnectedState:
+        if (m_dcAddresses.count() > 1) {
+            // The address which won the race
+            const Telegram::DcOption address = m_transport->remoteAddress();
+            m_dcInfo.ipAddress = address.address;
+            m_dcInfo.port = address.port;
+            if (address.address.contains(QLatin1Char(':'))) {
+                m_dcInfo.flags |= TLDcOption::Ipv6;
+            } else {
+                m_dcInfo.flags &= ~TLDcOption::Ipv6;
+            }
+        }
+
+        if (m_authState >= AuthStateHaveAKey) {
+            // The session is resumed (see reconnectToDc())
+            setStatus(ConnectionStatusConnected, ConnectionStatusReasonRemote);
+            if ((m_authState == AuthStateHaveAKey) && !m_permanentAuthKey.isEmpty()) {
+                bindTemporaryKey(); // The requests are resumed once the key is bound
+            } else {
+                resumePendingRequests();
+            }
+            break;
+        }
+
         startAuthTimer();
 
         if (m_authKey.isEmpty()) {
             initAuth();
+        } else if (!m_permanentAuthKey.isEmpty()) {
+            // A pre-generated temporary key, bind it first
+            setAuthState(AuthStateHaveAKey);
         } else {
             setAuthState(AuthStateSignedIn);
         }
 
         setStatus(ConnectionStatusConnected, ConnectionStatusReasonRemote);
+
+        if ((m_authState == AuthStateHaveAKey) && !m_permanentAuthKey.isEmpty()) {
+            bindTemporaryKey();
+        }
         break;
     case QAbstractSocket::UnconnectedState:
         setStatus(ConnectionStatusDisconnected, status() == ConnectionStatusDisconnecting ? ConnectionStatusReasonLocal : ConnectionStatusReasonRemote);
@@ -4333,6 +4996,8 @@ void CTelegramConnection::onTransportPackageReceived(const QByteArray &input)
 
         payload = decryptedStream.readAll();
 
+        m_lastReceivedMessageId = qMax(m_lastReceivedMessageId, messageId);
+        m_lastReceivedPackageTime = QDateTime::currentMSecsSinceEpoch();
         processRpcQuery(payload);
     }
 
@@ -4356,15 +5021,32 @@ void CTelegramConnection::onTimeToPing()
         return;
     }
 
-    if (m_lastSentPingTime && (m_lastSentPingTime > m_lastReceivedPingTime + m_pingInterval)) {
-        qDebug() << Q_FUNC_INFO << "pong time is out";
-        setStatus(ConnectionStatusDisconnected, ConnectionStatusReasonTimeout);
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    if (m_lastSentPingId != m_lastReceivedPingId) {
+        // The pong is not received in time
+        if (m_lastReceivedPackageTime > m_lastSentPingTime) {
+            qDebug() << Q_FUNC_INFO << "pong is late, but the connection is alive";
+        } else {
+            m_rttEstimator.pingLost();
+            qDebug() << Q_FUNC_INFO << "pong time is out" << m_rttEstimator.lostPingsCount();
+            if (m_rttEstimator.lostPingsCount() >= s_maxLostPings) {
+                setStatus(ConnectionStatusDisconnected, ConnectionStatusReasonTimeout);
+                return;
+            }
+        }
+        sendPing(); // Probe the connection again
         return;
     }
 
-    m_lastSentPingTime = QDateTime::currentMSecsSinceEpoch();
+    const qint64 interval = m_rttEstimator.pingInterval();
+    if ((m_lastReceivedPackageTime > now - interval) && (now + interval + m_rttEstimator.timeout() < m_serverDisconnectionTime)) {
+        // The other answers show that the connection is alive, and the server would not close it before the next ping
+        m_pingTimer->start(int(interval));
+        return;
+    }
 
-    pingDelayDisconnect(m_pingInterval + m_serverDisconnectionExtraTime); // Server will close the connection after m_serverDisconnectionExtraTime ms more, than our ping interval.
+    sendPing();
 }
 
 void CTelegramConnection::onTimeToAckMessages()
@@ -4373,10 +5055,46 @@ void CTelegramConnection::onTimeToAckMessages()
         return;
     }
 
+    if (status() < ConnectionStatusConnected) {
+        m_ackTimer->start(); // Acknowledge the messages in the resumed session
+        return;
+    }
+
     acknowledgeMessages(m_messagesToAck);
     m_messagesToAck.clear();
 }
 
+void CTelegramConnection::onTimeToCheckRequests()
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const bool canProbe = (status() >= ConnectionStatusConnected) && (m_authState >= AuthStateHaveAKey);
+
+    QVector<quint64> expiredIds;
+    TLVector<quint64> probeIds;
+    for (auto it = m_pendingRequests.begin(); it != m_pendingRequests.end(); ++it) {
+        if (now >= it->deadline) {
+            expiredIds.append(it.key());
+        } else if (canProbe && (now >= it->nextCheckTime)) {
+            probeIds.append(it.key());
+            it->checkInterval = qMin(it->checkInterval * 2, s_requestMaxProbeInterval);
+            it->nextCheckTime = now + it->checkInterval;
+        }
+    }
+
+    for (quint64 id : expiredIds) {
+        failRequest(id, TelegramNamespace::RequestFailureTimeout);
+    }
+
+    if (!probeIds.isEmpty()) {
+        requestMessagesState(probeIds);
+    }
+
+    if (m_pendingRequests.isEmpty()) {
+        m_messagesStateRequests.clear();
+        m_requestsTimer->stop();
+    }
+}
+
 bool CTelegramConnection::checkClientServerNonse(CTelegramStream &stream) const
 {
     TLNumber128 nonce;
@@ -4414,10 +5132,15 @@ SAesKey CTelegramConnection::generateTmpAesKey() const
 
 SAesKey CTelegramConnection::generateAesKey(const QByteArray &messageKey, int x) const
 {
-    QByteArray sha1_a = Utils::sha1(messageKey + m_authKey.mid(x, 32));
-    QByteArray sha1_b = Utils::sha1(m_authKey.mid(32 + x, 16) + messageKey + m_authKey.mid(48 + x, 16));
-    QByteArray sha1_c = Utils::sha1(m_authKey.mid(64 + x, 32) + messageKey);
-    QByteArray sha1_d = Utils::sha1(messageKey + m_authKey.mid(96 + x, 32));
+    return generateAesKey(m_authKey, messageKey, x);
+}
+
+SAesKey CTelegramConnection::generateAesKey(const QByteArray &authKey, const QByteArray &messageKey, int x)
+{
+    QByteArray sha1_a = Utils::sha1(messageKey + authKey.mid(x, 32));
+    QByteArray sha1_b = Utils::sha1(authKey.mid(32 + x, 16) + messageKey + authKey.mid(48 + x, 16));
+    QByteArray sha1_c = Utils::sha1(authKey.mid(64 + x, 32) + messageKey);
+    QByteArray sha1_d = Utils::sha1(messageKey + authKey.mid(96 + x, 32));
 
     const QByteArray key = sha1_a.mid(0, 8) + sha1_b.mid(8, 12) + sha1_c.mid(4, 12);
     const QByteArray iv  = sha1_a.mid(8, 12) + sha1_b.mid(0, 8) + sha1_c.mid(16, 4) + sha1_d.mid(0, 8);
@@ -4478,11 +5201,14 @@ quint64 CTelegramConnection::sendPlainPackage(const QByteArray &buffer)
     return messageId;
 }
 
-quint64 CTelegramConnection::sendEncryptedPackage(const QByteArray &buffer, bool savePackage)
+quint64 CTelegramConnection::sendEncryptedPackage(const QByteArray &buffer, bool savePackage, quint64 messageId)
 {
     QByteArray encryptedPackage;
     QByteArray messageKey;
-    quint64 messageId = newMessageId();
+    if (!messageId) {
+        messageId = newMessageId();
+    }
+    updateServerSalt();
     {
         m_sequenceNumber = m_contentRelatedMessages * 2 + 1;
         ++m_contentRelatedMessages;
@@ -4490,9 +5216,20 @@ quint64 CTelegramConnection::sendEncryptedPackage(const QByteArray &buffer, bool
         if (savePackage) {
             // Story only content-related messages
             m_submittedPackages.insert(messageId, buffer);
+            addPendingRequest(messageId, buffer);
         }
 
+        QByteArray header;
+        if (m_sequenceNumber == 1) {
+            insertInitConnection(&header);
+        }
+
+        // Salt, session id, message id, sequence number and the message length
+        static const int innerHeaderSize = 8 + 8 + 8 + 4 + 4;
+        const int innerDataSize = innerHeaderSize + header.length() + buffer.length();
+
         QByteArray innerData;
+        innerData.reserve(innerDataSize + 15); // Up to 15 bytes of the AES block padding
         CRawStream stream(&innerData, /* write */ true);
 
         stream << m_serverSalt;
@@ -4500,13 +5237,11 @@ quint64 CTelegramConnection::sendEncryptedPackage(const QByteArray &buffer, bool
         stream << messageId;
         stream << m_sequenceNumber;
 
-        QByteArray header;
-        if (m_sequenceNumber == 1) {
-            insertInitConnection(&header);
-        }
-
         stream << quint32(header.length() + buffer.length());
-        stream << header + buffer;
+        if (!header.isEmpty()) {
+            stream << header;
+        }
+        stream << buffer;
 
         messageKey = Utils::sha1(innerData).mid(4);
         const SAesKey key = generateClientToServerAesKey(messageKey);
@@ -4527,6 +5262,7 @@ quint64 CTelegramConnection::sendEncryptedPackage(const QByteArray &buffer, bool
     }
 
     QByteArray output;
+    output.reserve(8 + messageKey.size() + encryptedPackage.size());
     CRawStream outputStream(&output, /* write */ true);
 
     outputStream << m_authId;
@@ -4561,11 +5297,465 @@ quint64 CTelegramConnection::sendEncryptedPackage(const QByteArray &buffer, bool
 quint64 CTelegramConnection::sendEncryptedPackageAgain(quint64 id)
 {
     --m_contentRelatedMessages;
+    if (isTemporaryKeyBinding(id)) {
+        return rebindTemporaryKey(id);
+    }
     const QByteArray data = m_submittedPackages.take(id);
 #ifdef DEVELOPER_BUILD
     qDebug() << Q_FUNC_INFO << id << TLValue::firstFromArray(data);
 #endif
-    return sendEncryptedPackage(data);
+    const quint64 newId = sendEncryptedPackage(data);
+    movePendingRequest(id, newId);
+    return newId;
+}
+
+quint64 CTelegramConnection::sendRequest(const QByteArray &data)
+{
+    const CRequestRateLimiter::RequestClass requestClass = CRequestRateLimiter::requestClass(TLValue::firstFromArray(data));
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    // Nothing is written to a connecting transport (e.g. while the session is resumed), the queue is sent once it is connected
+    if ((status() >= ConnectionStatusConnected) && !m_temporaryKeyBindingId && m_rateLimiter.tryAcquire(requestClass, now)) {
+        return sendEncryptedPackage(data);
+    }
+
+    CRequestRateLimiter::Request request;
+    request.requestId = newMessageId(); // Reserved to identify the request, the package gets a new id once it is sent
+    request.data = data;
+    request.queueTime = now;
+    m_rateLimiter.enqueue(requestClass, request);
+    scheduleQueuedRequests();
+    return request.requestId;
+}
+
+void CTelegramConnection::scheduleQueuedRequests()
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const qint64 nextTime = m_rateLimiter.nextReadyTime(now);
+    if (nextTime < 0) {
+        m_requestQueueTimer->stop();
+        return;
+    }
+    m_requestQueueTimer->start(int(qBound<qint64>(0, nextTime - now, std::numeric_limits<int>::max())));
+}
+
+void CTelegramConnection::onTimeToSendQueuedRequests()
+{
+    if ((status() < ConnectionStatusConnected) || (m_authState < AuthStateHaveAKey) || m_temporaryKeyBindingId) {
+        // The queue is resumed once the connection is established (and the temporary key is bound)
+        return;
+    }
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    CRequestRateLimiter::Request request;
+    while (m_rateLimiter.takeNext(now, &request)) {
+        const quint64 messageId = sendEncryptedPackage(request.data);
+        if (m_pendingRequests.contains(messageId)) {
+            m_pendingRequests[messageId].requestId = request.requestId;
+        }
+    }
+    scheduleQueuedRequests();
+}
+
+void CTelegramConnection::setRequestRateLimit(TelegramNamespace::RequestClass requestClass, int requestsPerMinute, int burst)
+{
+    m_rateLimiter.setRate(requestClass, requestsPerMinute, burst);
+    scheduleQueuedRequests();
+}
+
+Telegram::RequestQueueStats CTelegramConnection::requestQueueStats(TelegramNamespace::RequestClass requestClass) const
+{
+    return m_rateLimiter.stats(requestClass, QDateTime::currentMSecsSinceEpoch());
+}
+
+quint64 CTelegramConnection::resendRequest(quint64 id)
+{
+    // Unlike sendEncryptedPackageAgain(), the message might be received, so the content-related messages counter is not rolled back.
+    PendingRequest &request = m_pendingRequests[id];
+    if (++request.attempts > s_requestMaxAttempts) {
+        failRequest(id, TelegramNamespace::RequestFailureRetryLimit);
+        return 0;
+    }
+
+    if (isTemporaryKeyBinding(id)) {
+        return rebindTemporaryKey(id);
+    }
+
+    const QByteArray data = m_submittedPackages.take(id);
+    qDebug() << Q_FUNC_INFO << "Resend request" << request.requestId << request.method << "attempt" << request.attempts;
+    const quint64 newId = sendEncryptedPackage(data);
+    movePendingRequest(id, newId);
+    return newId;
+}
+
+void CTelegramConnection::addPendingRequest(quint64 id, const QByteArray &data)
+{
+    PendingRequest request;
+    request.requestId = id;
+    request.method = TLValue::firstFromArray(data);
+
+    switch (request.method) {
+    case TLValue::Ping:
+    case TLValue::PingDelayDisconnect: // Checked on its own to detect the broken connection
+    case TLValue::GetFutureSalts:
+        return;
+    default:
+        break;
+    }
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    request.sentTime = now;
+    request.deadline = now + requestDeadline(request.method);
+    request.checkInterval = s_requestProbeInterval;
+    request.nextCheckTime = now + request.checkInterval;
+    m_pendingRequests.insert(id, request);
+
+    if (!m_requestsTimer->isActive()) {
+        m_requestsTimer->start();
+    }
+}
+
+void CTelegramConnection::movePendingRequest(quint64 id, quint64 newId)
+{
+    if (!m_pendingRequests.contains(id)) {
+        return;
+    }
+    PendingRequest request = m_pendingRequests.take(id);
+    request.acked = false;
+    request.sentTime = 0;
+    request.nextCheckTime = QDateTime::currentMSecsSinceEpoch() + request.checkInterval;
+    m_pendingRequests.insert(newId, request);
+}
+
+void CTelegramConnection::failRequest(quint64 id, TelegramNamespace::RequestFailureReason reason)
+{
+    if (!m_pendingRequests.contains(id)) {
+        return; // Failed meanwhile (e.g. on the session reset)
+    }
+    if (isTemporaryKeyBinding(id)) {
+        // Not a request of the client
+        qWarning() << Q_FUNC_INFO << "Temporary key binding failed:" << reason;
+        finishTemporaryKeyBinding(/* bound */ false);
+        return;
+    }
+
+    const PendingRequest request = m_pendingRequests.take(id);
+    m_submittedPackages.remove(id);
+    qWarning() << Q_FUNC_INFO << "Request" << request.requestId << request.method << "failed:" << reason;
+
+    // The dispatcher retries the channel difference on the requestFailed() signal
+    emit requestFailed(request.requestId, request.method, reason);
+}
+
+void CTelegramConnection::resumePendingRequests()
+{
+    // The requests not acknowledged by the server are likely lost with the closed connection.
+    // The idempotent ones are sent again (with new message ids) right away, the state of the others is asked first.
+    // The acknowledged requests are answered in the resumed session.
+    QList<quint64> ids = m_pendingRequests.keys();
+    std::sort(ids.begin(), ids.end()); // Keep the order of the requests
+
+    TLVector<quint64> probeIds;
+    int resentCount = 0;
+    for (quint64 id : ids) {
+        const PendingRequest request = m_pendingRequests.value(id);
+        if (request.acked) {
+            continue;
+        }
+        if (!isRequestIdempotent(request.method)) {
+            probeIds.append(id);
+            continue;
+        }
+        const QByteArray data = m_submittedPackages.take(id);
+        if (data.isEmpty()) {
+            continue;
+        }
+        const quint64 newId = sendEncryptedPackage(data);
+        movePendingRequest(id, newId);
+        ++resentCount;
+    }
+
+    qDebug() << Q_FUNC_INFO << "Resent" << resentCount << "requests, probe" << probeIds.count();
+    if (!probeIds.isEmpty()) {
+        requestMessagesState(probeIds);
+    }
+}
+
+void CTelegramConnection::startNewSession()
+{
+    Utils::randomBytes(&m_sessionId);
+    m_sequenceNumber = 0;
+    m_contentRelatedMessages = 0;
+    m_messagesToAck.clear();
+
+    // The answers of the old session are lost. The idempotent requests are sent again once the session is ready,
+    // the state of the others can not be asked anymore.
+    const QList<quint64> ids = m_pendingRequests.keys();
+    for (quint64 id : ids) {
+        if (isRequestIdempotent(m_pendingRequests.value(id).method)) {
+            m_pendingRequests[id].acked = false;
+        } else {
+            failRequest(id, TelegramNamespace::RequestFailureAnswerLost);
+        }
+    }
+}
+
+void CTelegramConnection::setTemporaryKey(const QByteArray &key, quint64 salt, quint32 expiresAt, const QByteArray &permanentKey)
+{
+    setAuthKey(key);
+    m_serverSalt = salt;
+    m_authKeyExpiresAt = expiresAt;
+    m_permanentAuthKey = permanentKey;
+}
+
+void CTelegramConnection::rotateTemporaryKey(const QByteArray &key, quint64 salt, quint32 expiresAt)
+{
+    if (m_permanentAuthKey.isEmpty()) {
+        qWarning() << Q_FUNC_INFO << "The connection has no permanent key to bind to";
+        return;
+    }
+
+    qDebug() << Q_FUNC_INFO << "dc" << m_dcInfo.id << "expires at" << expiresAt;
+    setTemporaryKey(key, salt, expiresAt, m_permanentAuthKey);
+    m_serverSalts.clear();
+    startNewSession();
+
+    if (m_authState >= AuthStateHaveAKey) {
+        setAuthState(AuthStateHaveAKey);
+    }
+    if (status() >= ConnectionStatusConnected) {
+        bindTemporaryKey();
+    }
+}
+
+void CTelegramConnection::bindTemporaryKey()
+{
+    dropTemporaryKeyBinding(); // Superseded (e.g. by the rotated key)
+    const quint64 messageId = newMessageId(); // The inner message and the request share the id
+    qDebug() << Q_FUNC_INFO << "dc" << m_dcInfo.id << "expires at" << m_authKeyExpiresAt;
+    m_temporaryKeyBindingId = sendEncryptedPackage(temporaryKeyBindingRequest(messageId), /* savePackage */ true, messageId);
+}
+
+quint64 CTelegramConnection::rebindTemporaryKey(quint64 id)
+{
+    // The inner message signs the message id of the request, so the request is built again for the new id
+    const PendingRequest previous = m_pendingRequests.take(id);
+    m_submittedPackages.remove(id);
+
+    const quint64 messageId = newMessageId();
+    qDebug() << Q_FUNC_INFO << "dc" << m_dcInfo.id << "attempt" << previous.attempts;
+    sendEncryptedPackage(temporaryKeyBindingRequest(messageId), /* savePackage */ true, messageId);
+
+    PendingRequest &request = m_pendingRequests[messageId];
+    request.requestId = m_temporaryKeyBindingId;
+    request.attempts = previous.attempts;
+    request.deadline = previous.deadline;
+    request.sentTime = 0;
+    return messageId;
+}
+
+QByteArray CTelegramConnection::temporaryKeyBindingRequest(quint64 messageId) const
+{
+    const quint64 permanentKeyId = Utils::getFingersprint(m_permanentAuthKey);
+    quint64 nonce;
+    Utils::randomBytes(&nonce);
+
+    QByteArray bindingData;
+    CTelegramStream bindingStream(&bindingData, /* write */ true);
+    bindingStream << TLValue::BindAuthKeyInner;
+    bindingStream << nonce;
+    bindingStream << m_authId;
+    bindingStream << permanentKeyId;
+    bindingStream << m_sessionId;
+    bindingStream << m_authKeyExpiresAt;
+
+    // The binding message is encrypted with the permanent key, a random salt and session id
+    quint64 salt;
+    quint64 sessionId;
+    Utils::randomBytes(&salt);
+    Utils::randomBytes(&sessionId);
+
+    QByteArray innerData;
+    CRawStream innerStream(&innerData, /* write */ true);
+    innerStream << salt;
+    innerStream << sessionId;
+    innerStream << messageId;
+    innerStream << quint32(0); // Sequence number
+    innerStream << quint32(bindingData.length());
+    innerStream << bindingData;
+
+    const QByteArray messageKey = Utils::sha1(innerData).mid(4);
+    if (innerData.length() % 16) {
+        QByteArray randomPadding;
+        randomPadding.resize(16 - (innerData.length() % 16));
+        Utils::randomBytes(&randomPadding);
+        innerStream << randomPadding;
+    }
+
+    QByteArray encryptedMessage;
+    CRawStream encryptedStream(&encryptedMessage, /* write */ true);
+    encryptedStream << permanentKeyId;
+    encryptedStream << messageKey;
+    encryptedStream << Utils::aesEncrypt(innerData, generateAesKey(m_permanentAuthKey, messageKey, 0)).left(innerData.length());
+
+    QByteArray request;
+    CTelegramStream requestStream(&request, /* write */ true);
+    requestStream << TLValue::AuthBindTempAuthKey;
+    requestStream << permanentKeyId;
+    requestStream << nonce;
+    requestStream << m_authKeyExpiresAt;
+    requestStream << encryptedMessage;
+
+    return request;
+}
+
+bool CTelegramConnection::isTemporaryKeyBinding(quint64 id) const
+{
+    return m_temporaryKeyBindingId && (m_pendingRequests.value(id).requestId == m_temporaryKeyBindingId);
+}
+
+void CTelegramConnection::dropTemporaryKeyBinding()
+{
+    if (!m_temporaryKeyBindingId) {
+        return;
+    }
+    for (auto it = m_pendingRequests.begin(); it != m_pendingRequests.end(); ) {
+        if (it->requestId == m_temporaryKeyBindingId) {
+            m_submittedPackages.remove(it.key());
+            it = m_pendingRequests.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    m_temporaryKeyBindingId = 0;
+}
+
+void CTelegramConnection::finishTemporaryKeyBinding(bool bound)
+{
+    qDebug() << Q_FUNC_INFO << "dc" << m_dcInfo.id << "bound:" << bound;
+    dropTemporaryKeyBinding(); // Answered (or failed), must not be resumed below
+
+    if (!bound) {
+        // Go on with the permanent key
+        setAuthKey(m_permanentAuthKey);
+        m_authKeyExpiresAt = 0;
+        m_permanentAuthKey.clear();
+        m_serverSalts.clear();
+        startNewSession();
+    }
+
+    setAuthState(AuthStateSignedIn);
+    resumePendingRequests();
+    scheduleQueuedRequests();
+}
+
+void CTelegramConnection::failPendingRequests(TelegramNamespace::RequestFailureReason reason)
+{
+    dropTemporaryKeyBinding(); // The key is bound again on the next connection
+    const QList<quint64> ids = m_pendingRequests.keys();
+    for (quint64 id : ids) {
+        failRequest(id, reason);
+    }
+    m_messagesStateRequests.clear();
+    m_requestsTimer->stop();
+
+    for (int i = 0; i < CRequestRateLimiter::RequestClassesCount; ++i) {
+        const CRequestRateLimiter::RequestClass requestClass = static_cast<CRequestRateLimiter::RequestClass>(i);
+        for (const CRequestRateLimiter::Request &queued : m_rateLimiter.takeQueued(requestClass)) {
+            emit requestFailed(queued.requestId, TLValue::firstFromArray(queued.data), reason);
+        }
+    }
+    m_requestQueueTimer->stop();
+}
+
+int CTelegramConnection::requestDeadline(TLValue method)
+{
+    switch (method) {
+    case TLValue::UploadGetFile:
+    case TLValue::UploadSaveFilePart:
+    case TLValue::UploadSaveBigFilePart:
+        return 120 * 1000;
+    case TLValue::UpdatesGetDifference:
+    case TLValue::UpdatesGetChannelDifference:
+    case TLValue::MessagesGetDialogs:
+    case TLValue::ChannelsGetParticipants:
+        return 60 * 1000;
+    default:
+        return s_requestDefaultDeadline;
+    }
+}
+
+bool CTelegramConnection::isRequestIdempotent(TLValue method)
+{
+    // The requests, which are safe to repeat if the server processed the first one.
+    // The sent messages are deduplicated by the server with the random id.
+    switch (method) {
+    case TLValue::AccountCheckUsername:
+    case TLValue::AccountGetAccountTTL:
+    case TLValue::AccountGetAuthorizations:
+    case TLValue::AccountGetNotifySettings:
+    case TLValue::AccountGetPassword:
+    case TLValue::AccountGetPasswordSettings:
+    case TLValue::AccountGetPrivacy:
+    case TLValue::AccountGetWallPapers:
+    case TLValue::AuthCheckPhone:
+    case TLValue::ChannelsCheckUsername:
+    case TLValue::ChannelsGetChannels:
+    case TLValue::ChannelsGetDialogs:
+    case TLValue::ChannelsGetFullChannel:
+    case TLValue::ChannelsGetImportantHistory:
+    case TLValue::ChannelsGetMessages:
+    case TLValue::ChannelsGetParticipant:
+    case TLValue::ChannelsGetParticipants:
+    case TLValue::ChannelsReadHistory:
+    case TLValue::ContactsGetBlocked:
+    case TLValue::ContactsGetContacts:
+    case TLValue::ContactsGetStatuses:
+    case TLValue::ContactsGetSuggested:
+    case TLValue::ContactsResolveUsername:
+    case TLValue::ContactsSearch:
+    case TLValue::HelpGetAppChangelog:
+    case TLValue::HelpGetAppUpdate:
+    case TLValue::HelpGetConfig:
+    case TLValue::HelpGetInviteText:
+    case TLValue::HelpGetNearestDc:
+    case TLValue::HelpGetSupport:
+    case TLValue::HelpGetTermsOfService:
+    case TLValue::MessagesCheckChatInvite:
+    case TLValue::MessagesGetAllStickers:
+    case TLValue::MessagesGetChats:
+    case TLValue::MessagesGetDhConfig:
+    case TLValue::MessagesGetDialogs:
+    case TLValue::MessagesGetDocumentByHash:
+    case TLValue::MessagesGetFullChat:
+    case TLValue::MessagesGetHistory:
+    case TLValue::MessagesGetInlineBotResults:
+    case TLValue::MessagesGetMessages:
+    case TLValue::MessagesGetMessagesViews:
+    case TLValue::MessagesGetSavedGifs:
+    case TLValue::MessagesGetStickerSet:
+    case TLValue::MessagesGetStickers:
+    case TLValue::MessagesGetWebPagePreview:
+    case TLValue::MessagesReadHistory:
+    case TLValue::MessagesReadMessageContents:
+    case TLValue::MessagesSearch:
+    case TLValue::MessagesSearchGifs:
+    case TLValue::MessagesSearchGlobal:
+    case TLValue::MessagesSetTyping:
+    case TLValue::MessagesSendMessage:
+    case TLValue::MessagesSendMedia:
+    case TLValue::MessagesForwardMessages:
+    case TLValue::UpdatesGetChannelDifference:
+    case TLValue::UpdatesGetDifference:
+    case TLValue::UpdatesGetState:
+    case TLValue::UploadGetFile:
+    case TLValue::UploadSaveBigFilePart:
+    case TLValue::UploadSaveFilePart:
+    case TLValue::UsersGetFullUser:
+    case TLValue::UsersGetUsers:
+        return true;
+    default:
+        return false;
+    }
 }
 
 void CTelegramConnection::setStatus(ConnectionStatus status, ConnectionStatusReason reason)
@@ -4577,8 +5767,20 @@ void CTelegramConnection::setStatus(ConnectionStatus status, ConnectionStatusRea
     m_status = status;
     emit statusChanged(status, reason, m_dcInfo.id);
 
+    if ((status == ConnectionStatusDisconnected) && (reason == ConnectionStatusReasonLocal)) {
+        // The requests of a remotely closed connection are kept for reconnectToDc(),
+        // the dispatcher fails them if the connection is dropped instead.
+        failPendingRequests(TelegramNamespace::RequestFailureConnectionClosed);
+    } else if (status >= ConnectionStatusConnected) {
+        scheduleQueuedRequests();
+        if (m_pingInterval && (m_authState >= AuthStateHaveAKey)) {
+            startPingTimer(); // The auth state is kept on the session resumption
+        }
+    }
+
     if (status < ConnectionStatusConnected) {
         stopPingTimer();
+        m_futureSaltsRequestId = 0; // The answer would never come
     }
 }
 
@@ -4587,8 +5789,42 @@ void CTelegramConnection::setAuthState(CTelegramConnection::AuthState newState)
     if (m_authState == newState)
         return;
 
+    if (m_authPhaseTimer.isValid()) {
+        switch (m_authState) {
+        case AuthStatePqRequested:
+            m_authTimings.pq += m_authPhaseTimer.restart();
+            break;
+        case AuthStateDhRequested:
+            m_authTimings.dhParams += m_authPhaseTimer.restart();
+            break;
+        case AuthStateDhGenerationResultRequested:
+            m_authTimings.dhGeneration += m_authPhaseTimer.restart();
+            break;
+        default:
+            break;
+        }
+    }
+
     m_authState = newState;
 
+    if (m_authState <= AuthStatePqRequested) {
+        m_authCryptoJob = nullptr; // Drop the results of the previous handshake
+    }
+
+    if (m_authState == AuthStatePqRequested) {
+        m_authTimings = AuthTimings();
+        m_authPhaseTimer.start();
+    } else if (m_authState == AuthStateHaveAKey) {
+        if (m_authPhaseTimer.isValid()) {
+            qDebug() << Q_FUNC_INFO << "Auth key is generated in" << m_authTimings.total() << "ms (pq:" << m_authTimings.pq
+                     << "factorization:" << m_authTimings.factorization << "DH params:" << m_authTimings.dhParams
+                     << "DH generation:" << m_authTimings.dhGeneration << ")" << "dc" << m_dcInfo.id;
+            m_authPhaseTimer.invalidate();
+        }
+    } else if (m_authState == AuthStateNone) {
+        m_authPhaseTimer.invalidate();
+    }
+
     if ((m_authState >= AuthStateHaveAKey) && !m_sessionId) {
         Utils::randomBytes(&m_sessionId);
     }
@@ -4601,13 +5837,84 @@ void CTelegramConnection::setAuthState(CTelegramConnection::AuthState newState)
         if (m_pingInterval) {
             startPingTimer();
         }
+        requestFutureSaltsIfNeeded();
     }
 }
 
 quint64 CTelegramConnection::newMessageId()
 {
-    quint64 newLastMessageId = formatClientTimeStamp(QDateTime::currentMSecsSinceEpoch() + deltaTime() * 1000);
-    return m_transport->getNewMessageId(newLastMessageId);
+    quint64 newLastMessageId = formatClientTimeStamp(QDateTime::currentMSecsSinceEpoch() + m_timeOffset);
+    newLastMessageId = m_transport->getNewMessageId(newLastMessageId);
+    if (!m_timeSyncMessageId) {
+        m_timeSyncMessageId = newLastMessageId;
+    }
+    return newLastMessageId;
+}
+
+void CTelegramConnection::updateServerSalt()
+{
+    // The salts of the schedule overlap, so the latest started salt is used and is replaced before it expires.
+    const quint32 serverTime = (QDateTime::currentMSecsSinceEpoch() + m_timeOffset) / 1000;
+    int expired = 0;
+    while ((expired < m_serverSalts.count()) && (m_serverSalts.at(expired).validUntil <= serverTime)) {
+        ++expired;
+    }
+    if (expired) {
+        m_serverSalts.remove(0, expired);
+    }
+
+    for (int i = m_serverSalts.count() - 1; i >= 0; --i) {
+        if (m_serverSalts.at(i).validSince <= serverTime) {
+            m_serverSalt = m_serverSalts.at(i).salt;
+            break;
+        }
+    }
+}
+
+void CTelegramConnection::requestFutureSaltsIfNeeded()
+{
+    if ((m_authState < AuthStateHaveAKey) || m_futureSaltsRequestId) {
+        return;
+    }
+
+    const quint32 serverTime = (QDateTime::currentMSecsSinceEpoch() + m_timeOffset) / 1000;
+    if (!m_serverSalts.isEmpty() && (m_serverSalts.last().validUntil > serverTime + s_futureSaltsReserve)) {
+        return;
+    }
+
+    getFutureSalts(s_futureSaltsCount);
+}
+
+void CTelegramConnection::syncTime(quint64 badMessageId)
+{
+    // https://core.telegram.org/mtproto/service_messages_about_messages#notice-of-ignored-error-message
+    // The notification comes in a server message, which id carries the server time. The bad message id
+    // carries the local time of sending plus the offset used then, so the round trip is known as well
+    // and the server time is taken at the middle of it. This syncs the clock at once, the resent
+    // message is the only extra round trip.
+    if (!m_timeSyncMessageId || (badMessageId < m_timeSyncMessageId)) {
+        // The message was sent before the last sync, the offset is already corrected.
+        return;
+    }
+    if (!m_lastReceivedMessageId) {
+        return;
+    }
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const qint64 sentAt = timeFromMessageId(badMessageId) - m_timeOffset;
+    const qint64 roundTripTime = qBound<qint64>(0, now - sentAt, 60 * 1000);
+    const qint64 serverTime = timeFromMessageId(m_lastReceivedMessageId);
+    const qint64 newOffset = serverTime + roundTripTime / 2 - now;
+
+    if (newOffset < m_timeOffset) {
+        // The ids sent with the previous offset are too high and were not accepted.
+        m_transport->resetMessageId();
+    }
+
+    m_timeOffset = newOffset;
+    m_timeSyncRoundTripTime = roundTripTime;
+    m_timeSyncMessageId = 0;
+    qDebug() << Q_FUNC_INFO << "Time offset set to" << m_timeOffset << "ms, round trip" << m_timeSyncRoundTripTime << "ms";
 }
 
 QString CTelegramConnection::userNameFromPackage(quint64 id) const
@@ -4639,6 +5946,37 @@ QString CTelegramConnection::userNameFromPackage(quint64 id) const
     return name;
 }
 
+void CTelegramConnection::startAuthCryptoJob(CAuthCryptoJob *job)
+{
+    m_authCryptoJob = job;
+    connect(job, &CAuthCryptoJob::finished, this, &CTelegramConnection::onAuthCryptoJobFinished);
+    job->start();
+}
+
+void CTelegramConnection::onAuthCryptoJobFinished(const QByteArray &result, const QByteArray &secondResult)
+{
+    const CAuthCryptoJob *job = qobject_cast<CAuthCryptoJob*>(sender());
+    if (!job || (job != m_authCryptoJob)) {
+        return; // The auth is restarted since the job start
+    }
+    m_authCryptoJob = nullptr;
+
+    if (m_transport->state() != QAbstractSocket::ConnectedState) {
+        qDebug() << Q_FUNC_INFO << "The connection is lost during the computation";
+        return;
+    }
+
+    switch (job->operation()) {
+    case CAuthCryptoJob::RsaEncrypt:
+        sendDhParametersRequest(result);
+        break;
+    case CAuthCryptoJob::DhExchange:
+        m_dhAuthKey = secondResult;
+        sendDhGenerationResultRequest(result);
+        break;
+    }
+}
+
 void CTelegramConnection::startAuthTimer()
 {
     qDebug() << Q_FUNC_INFO;
@@ -4667,14 +6005,10 @@ void CTelegramConnection::startPingTimer()
     qDebug() << Q_FUNC_INFO;
     if (!m_pingTimer) {
         m_pingTimer = new QTimer(this);
-        m_pingTimer->setSingleShot(false);
+        m_pingTimer->setSingleShot(true);
         connect(m_pingTimer, &QTimer::timeout, this, &CTelegramConnection::onTimeToPing);
     }
 
-    if (m_pingTimer->interval() != static_cast<int>(m_pingInterval)) {
-        m_pingTimer->setInterval(m_pingInterval);
-    }
-
     if (m_pingTimer->isActive()) {
         return;
     }
@@ -4683,8 +6017,10 @@ void CTelegramConnection::startPingTimer()
     m_lastSentPingId = 0;
     m_lastReceivedPingTime = 0;
     m_lastSentPingTime = 0;
+    m_serverDisconnectionTime = 0;
+    m_rttEstimator.setBaseInterval(m_pingInterval); // Keep the RTT samples of the DC, but start with the base interval
 
-    m_pingTimer->start();
+    m_pingTimer->start(int(m_rttEstimator.pingInterval()));
 }
 
 void CTelegramConnection::stopPingTimer()
@@ -4695,6 +6031,21 @@ void CTelegramConnection::stopPingTimer()
     }
 }
 
+void CTelegramConnection::sendPing()
+{
+    // The server closes the connection if the next ping does not come in time, so let it wait for one skipped ping
+    const qint64 disconnectionDelay = 2 * m_rttEstimator.pingInterval() + m_serverDisconnectionExtraTime;
+    const quint32 disconnectInSec = quint32((disconnectionDelay + 999) / 1000);
+
+    m_lastSentPingTime = QDateTime::currentMSecsSinceEpoch();
+    m_serverDisconnectionTime = m_lastSentPingTime + qint64(disconnectInSec) * 1000;
+
+    requestFutureSaltsIfNeeded();
+    pingDelayDisconnect(disconnectInSec);
+
+    m_pingTimer->start(int(m_rttEstimator.timeout())); // Wait for the pong
+}
+
 void CTelegramConnection::addMessageToAck(quint64 id)
 {
 //    qDebug() << Q_FUNC_INFO << id;
@@ -20,10 +20,14 @@
 
 #include <QObject>
 #include <QByteArray>
+#include <QElapsedTimer>
 #include <QVector>
 #include <QMap>
+#include <QHash>
 #include <QStringList>
 
+#include "CRequestRateLimiter.hpp"
+#include "CRttEstimator.hpp"
 #include "TelegramNamespace.hpp"
 #include "TLTypes.hpp"
 #include "TLNumbers.hpp"
@@ -31,6 +35,7 @@
 #include "crypto-aes.hpp"
 
 class CAppInformation;
+class CAuthCryptoJob;
 class CTelegramStream;
 class CTelegramTransport;
 class RpcProcessingContext;
@@ -70,17 +75,24 @@ public:
         AuthStateSignedIn
     };
 
-    enum DeltaTimeHeuristicState {
-        DeltaTimeIsOk,
-        DeltaTimeCorrectionForward,
-        DeltaTimeCorrectionBackward,
+    struct ServerSalt {
+        quint32 validSince = 0;
+        quint32 validUntil = 0;
+        quint64 salt = 0;
+    };
+
+    struct AuthTimings { // The durations of the auth key generation phases, in ms
+        qint64 pq = 0; // From req_pq till req_DH_params is sent (the factorization included)
+        qint64 factorization = 0;
+        qint64 dhParams = 0; // From req_DH_params till set_client_DH_params is sent
+        qint64 dhGeneration = 0; // From set_client_DH_params till the key is accepted (retries included)
+        qint64 total() const { return pq + dhParams + dhGeneration; }
     };
 
 #if QT_VERSION >= QT_VERSION_CHECK(5, 5, 0)
     Q_ENUM(ConnectionStatus)
     Q_ENUM(ConnectionStatusReason)
     Q_ENUM(AuthState)
-    Q_ENUM(DeltaTimeHeuristicState)
 #endif
 
     explicit CTelegramConnection(const CAppInformation *appInfo, QObject *parent = nullptr);
@@ -90,10 +102,16 @@ public:
 
     TLDcOption dcInfo() const { return m_dcInfo; }
 
+    // The addresses of the DC to race on connect (the most preferred first); the dcInfo address is used if empty.
+    void setDcAddresses(const QVector<Telegram::DcOption> &addresses);
+    QVector<Telegram::DcOption> dcAddresses() const { return m_dcAddresses; }
+
     void setTransport(CTelegramTransport *newTransport);
+    CTelegramTransport *transport() const { return m_transport; }
 
 public slots:
     void connectToDc();
+    void reconnectToDc(); // Resumes the session (if there is one) on a new transport connection
     void disconnectFromDc();
 
 public:
@@ -103,6 +121,7 @@ public:
 
     void initAuth();
     void setKeepAliveSettings(quint32 interval, quint32 serverDisconnectionExtraTime);
+    void failPendingRequests(TelegramNamespace::RequestFailureReason reason); // Emits requestFailed() for the pending and queued requests
 
     // Generated Telegram API methods declaration
     quint64 accountChangePhone(const QString &phoneNumber, const QString &phoneCodeHash, const QString &phoneCode);
@@ -259,8 +278,10 @@ public:
 
     quint64 ping();
     quint64 pingDelayDisconnect(quint32 disconnectInSec);
+    quint64 getFutureSalts(quint32 count);
 
     quint64 acknowledgeMessages(const TLVector<quint64> &idsVector);
+    quint64 requestMessagesState(const TLVector<quint64> &idsVector);
 
     quint64 requestPhoneCode(const QString &phoneNumber);
     quint64 signIn(const QString &phoneNumber, const QString &authCode);
@@ -276,11 +297,11 @@ public:
 
     void requestPqAuthorization();
     bool acceptPqAuthorization(const QByteArray &payload);
-    void requestDhParameters();
+    void requestDhParameters(); // Sends the request once the inner data is encrypted on the thread pool
     bool acceptDhAnswer(const QByteArray &payload);
     bool processServerDHParamsOK(const QByteArray &encryptedAnswer);
     void generateDh();
-    void requestDhGenerationResult();
+    void requestDhGenerationResult(); // Sends the request once g_b (and the auth key) is computed on the thread pool
     bool processServerDhAnswer(const QByteArray &payload);
 
     TLNumber128 clientNonce() const { return m_clientNonce; }
@@ -289,19 +310,39 @@ public:
     quint64 pq() const { return m_pq; }
     quint64 p() const { return m_p; }
     quint64 q() const { return m_q; }
+    AuthTimings authTimings() const { return m_authTimings; } // Of the last auth key generation
 
     QByteArray authKey() const { return m_authKey; }
     void setAuthKey(const QByteArray &newAuthKey);
     quint64 authId() const { return m_authId; }
 
+    // Temporary (PFS) auth keys
+    void setTemporaryKeyLifetime(quint32 seconds) { m_temporaryKeyLifetime = seconds; } // Non-zero to generate a temporary key
+    void setTemporaryKey(const QByteArray &key, quint64 salt, quint32 expiresAt, const QByteArray &permanentKey); // Bound on connect
+    void rotateTemporaryKey(const QByteArray &key, quint64 salt, quint32 expiresAt); // Binds the key in a new session
+    quint32 authKeyExpiresAt() const { return m_authKeyExpiresAt; } // Server time; zero for a permanent key
+    bool isBindingTemporaryKey() const { return m_temporaryKeyBindingId != 0; }
+
     quint64 serverSalt() const { return m_serverSalt; }
     void setServerSalt(const quint64 salt) { m_serverSalt = salt; }
+    QVector<ServerSalt> serverSalts() const { return m_serverSalts; }
+    void setServerSalts(const QVector<ServerSalt> &salts);
     quint64 sessionId() const { return m_sessionId; }
 
     QVector<TLDcOption> dcConfiguration() const { return m_dcConfiguration; }
 
-    qint32 deltaTime() const { return m_deltaTime; }
+    qint32 deltaTime() const { return m_timeOffset / 1000; }
     void setDeltaTime(const qint32 newDt);
+    qint64 timeOffset() const { return m_timeOffset; } // Server time minus local time, in ms
+    qint64 timeSyncRoundTripTime() const { return m_timeSyncRoundTripTime; } // Of the last clock sync, in ms
+
+    static qint64 timeFromMessageId(quint64 messageId); // In ms since epoch
+
+    qint64 roundTripTime() const { return m_rttEstimator.smoothedRtt(); } // Smoothed, in ms
+    qint64 roundTripTimeVariation() const { return m_rttEstimator.rttVariation(); }
+
+    void setRequestRateLimit(TelegramNamespace::RequestClass requestClass, int requestsPerMinute, int burst);
+    Telegram::RequestQueueStats requestQueueStats(TelegramNamespace::RequestClass requestClass) const;
 
     void processRedirectedPackage(const QByteArray &data);
 
@@ -319,11 +360,14 @@ signals:
     void phoneCodeRequired();
     void loggedOut(bool result);
     void errorReceived(int code, const QString &errorMessage, bool processed);
+    // The request id is the message id of the first attempt (the value returned by the request method).
+    void requestFailed(quint64 requestId, TLValue method, TelegramNamespace::RequestFailureReason reason);
     void authSignErrorReceived(TelegramNamespace::AuthSignError errorCode, const QString &errorMessage);
     void authorizationErrorReceived(TelegramNamespace::UnauthorizedError errorCode, const QString &errorMessage);
     void userNameStatusUpdated(const QString &userName, TelegramNamespace::UserNameStatus status);
     void usersReceived(const QVector<TLUser> &users);
     void contactListReceived(const QVector<quint32> &contactList);
+    void contactListNotModified();
     void contactListChanged(const QVector<quint32> &added, const QVector<quint32> &removed);
     void fileDataReceived(const TLUploadFile &file, quint32 requestId, quint32 offset);
     void fileDataSent(quint32 requestId);
@@ -333,14 +377,16 @@ signals:
     void channelsParticipantsReceived(quint32 channelId, const TLVector<TLChannelParticipant> &participants);
 
     void fullUserReceived(const TLUserFull &userFull);
-    void messagesHistoryReceived(const TLMessagesMessages &history, const TLInputPeer &peer);
+    void messagesHistoryReceived(const TLMessagesMessages &history, const TLInputPeer &peer, quint32 offsetId, quint32 addOffset, quint32 limit);
+    void messagesMessagesReceived(const TLMessagesMessages &messages, quint64 requestId);
     void messagesDialogsReceived(const TLMessagesDialogs &dialogs, quint32 offsetDate, quint32 offsetId, const TLInputPeer &offsetPeer, quint32 limit);
     void channelsDialogsReceived(const TLMessagesDialogs &dialogs, quint32 offsetId, quint32 limit);
     void messagesAffectedMessagesReceived(const TLMessagesAffectedMessages &affectedMessages);
 
     void updatesReceived(const TLUpdates &update, quint64 id);
     void updatesStateReceived(const TLUpdatesState &updatesState);
-    void updatesChannelDifferenceReceived(const TLUpdatesChannelDifference &channelDifference);
+    void updatesChannelDifferenceReceived(quint32 channelId, const TLUpdatesChannelDifference &channelDifference);
+    void updatesChannelDifferenceFailed(quint32 channelId, quint32 errorCode, const QString &errorMessage);
     void updatesDifferenceReceived(const TLUpdatesDifference &updatesDifference);
 
     void authExportedAuthorizationReceived(quint32 dc, quint32 id, const QByteArray &data);
@@ -358,6 +404,8 @@ protected:
     void processMessageAck(CTelegramStream &stream);
     void processIgnoredMessageNotification(CTelegramStream &stream);
     void processPingPong(CTelegramStream &stream);
+    void processFutureSalts(CTelegramStream &stream);
+    void processMessagesStateInfo(CTelegramStream &stream);
 
     // Generated Telegram API RPC process declarations
     void processAccountChangePhone(RpcProcessingContext *context);
@@ -497,25 +545,53 @@ protected:
     SAesKey generateServerToClientAesKey(const QByteArray &messageKey) const;
 
     SAesKey generateAesKey(const QByteArray &messageKey, int xValue) const;
+    static SAesKey generateAesKey(const QByteArray &authKey, const QByteArray &messageKey, int xValue);
 
     void insertInitConnection(QByteArray *data) const;
 
     quint64 sendPlainPackage(const QByteArray &buffer);
-    quint64 sendEncryptedPackage(const QByteArray &buffer, bool savePackage = true);
+    quint64 sendEncryptedPackage(const QByteArray &buffer, bool savePackage = true, quint64 messageId = 0);
     quint64 sendEncryptedPackageAgain(quint64 id);
+    quint64 resendRequest(quint64 id);
+    quint64 sendRequest(const QByteArray &data);
+    void scheduleQueuedRequests();
+    bool processFloodWait(const QString &errorMessage, quint64 id, TLValue request);
+
+    void addPendingRequest(quint64 id, const QByteArray &data);
+    void movePendingRequest(quint64 id, quint64 newId);
+    void failRequest(quint64 id, TelegramNamespace::RequestFailureReason reason);
+    void connectTransport();
+    void resumePendingRequests();
+    void startNewSession();
+    void bindTemporaryKey();
+    quint64 rebindTemporaryKey(quint64 id);
+    QByteArray temporaryKeyBindingRequest(quint64 messageId) const;
+    bool isTemporaryKeyBinding(quint64 id) const;
+    void dropTemporaryKeyBinding();
+    void finishTemporaryKeyBinding(bool bound);
+    static int requestDeadline(TLValue method);
+    static bool isRequestIdempotent(TLValue method);
 
     void setStatus(ConnectionStatus status, ConnectionStatusReason reason);
     void setAuthState(AuthState newState);
 
     quint64 newMessageId();
+    void syncTime(quint64 badMessageId);
+    void updateServerSalt();
+    void requestFutureSaltsIfNeeded();
 
     QString userNameFromPackage(quint64 id) const;
 
+    void startAuthCryptoJob(CAuthCryptoJob *job);
+    void sendDhParametersRequest(const QByteArray &encryptedPackage);
+    void sendDhGenerationResultRequest(const QByteArray &gB);
+
     void startAuthTimer();
     void stopAuthTimer();
 
     void startPingTimer();
     void stopPingTimer();
+    void sendPing();
 
     void addMessageToAck(quint64 id);
 
@@ -525,20 +601,40 @@ protected slots:
     void onTransportTimeout();
     void onTimeToPing();
     void onTimeToAckMessages();
+    void onTimeToCheckRequests();
+    void onTimeToSendQueuedRequests();
+    void onAuthCryptoJobFinished(const QByteArray &result, const QByteArray &secondResult);
 
 protected:
+    struct PendingRequest {
+        quint64 requestId = 0; // The message id of the first attempt
+        TLValue method;
+        qint64 sentTime = 0; // Zero for the resent requests, their answers are not taken as the RTT samples
+        qint64 deadline = 0;
+        qint64 nextCheckTime = 0;
+        int checkInterval = 0;
+        int attempts = 1;
+        bool acked = false;
+    };
+
     bool checkClientServerNonse(CTelegramStream &stream) const;
 
     ConnectionStatus m_status;
     const CAppInformation *m_appInfo;
 
     QMap<quint64, QByteArray> m_submittedPackages; // <message id, package data>
+    QHash<quint64, PendingRequest> m_pendingRequests; // <message id, lifecycle state>
+    QHash<quint64, TLVector<quint64> > m_messagesStateRequests; // <msgs_state_req id, the requested message ids>
     QMap<quint64, quint32> m_requestedFilesIds; // <message id, file id>
 
     CTelegramTransport *m_transport;
     QTimer *m_authTimer;
     QTimer *m_pingTimer;
     QTimer *m_ackTimer;
+    QTimer *m_requestsTimer;
+    QTimer *m_requestQueueTimer;
+    CRequestRateLimiter m_rateLimiter;
+    CRttEstimator m_rttEstimator;
 
     AuthState m_authState;
 
@@ -547,12 +643,16 @@ protected:
     quint64 m_authKeyAuxHash;
     quint64 m_serverSalt;
     quint64 m_receivedServerSalt;
+    QVector<ServerSalt> m_serverSalts; // Sorted by validSince
+    quint64 m_futureSaltsRequestId;
     quint64 m_sessionId;
     quint64 m_lastMessageId;
     quint64 m_lastSentPingId;
     quint64 m_lastReceivedPingId;
     qint64 m_lastReceivedPingTime;
     qint64 m_lastSentPingTime;
+    qint64 m_lastReceivedPackageTime;
+    qint64 m_serverDisconnectionTime; // The server closes the connection if no ping comes until this time
     quint32 m_sequenceNumber;
     quint32 m_contentRelatedMessages;
 
@@ -560,8 +660,10 @@ protected:
 
     quint32 m_pingInterval;
     quint32 m_serverDisconnectionExtraTime;
-    qint32 m_deltaTime;
-    DeltaTimeHeuristicState m_deltaTimeHeuristicState;
+    qint64 m_timeOffset;
+    qint64 m_timeSyncRoundTripTime;
+    quint64 m_timeSyncMessageId; // The first message id generated with the current time offset
+    quint64 m_lastReceivedMessageId;
 
     TLNumber128 m_clientNonce;
     TLNumber128 m_serverNonce;
@@ -570,6 +672,8 @@ protected:
     quint64 m_pq;
     quint32 m_p;
     quint32 m_q;
+    AuthTimings m_authTimings;
+    QElapsedTimer m_authPhaseTimer;
 
     Telegram::RsaKey m_rsaKey;
     SAesKey m_tmpAesKey;
@@ -578,10 +682,18 @@ protected:
     QByteArray m_dhPrime;
     QByteArray m_gA;
     QByteArray m_b;
+    QByteArray m_dhAuthKey; // Computed along with g_b
+    CAuthCryptoJob *m_authCryptoJob; // The job in progress, the results of the other ones are outdated
 
     quint64 m_authRetryId;
 
+    quint32 m_temporaryKeyLifetime; // Of the key to generate
+    quint32 m_authKeyExpiresAt;
+    QByteArray m_permanentAuthKey; // The key to bind the temporary key to
+    quint64 m_temporaryKeyBindingId; // The request id (the message id of the first attempt)
+
     TLDcOption m_dcInfo;
+    QVector<Telegram::DcOption> m_dcAddresses;
 
     QVector<TLDcOption> m_dcConfiguration;
 
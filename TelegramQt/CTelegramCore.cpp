@@ -18,6 +18,7 @@
 #include "CTelegramCore.hpp"
 
 #include <QDebug>
+#include <QMetaMethod>
 
 #include "CAppInformation.hpp"
 #include "CTelegramDispatcher.hpp"
@@ -69,6 +70,8 @@ CTelegramCore::CTelegramCore(QObject *parent) :
             this, &CTelegramCore::selfUserAvailable);
     connect(m_private->m_dispatcher, &CTelegramDispatcher::userInfoReceived,
             this, &CTelegramCore::userInfoReceived);
+    connect(m_private->m_dispatcher, &CTelegramDispatcher::usersInfoReceived,
+            this, &CTelegramCore::usersInfoReceived);
 
     connect(m_private->m_authModule, &CTelegramAuthModule::loggedOut,
             this, &CTelegramCore::loggedOut);
@@ -95,6 +98,10 @@ CTelegramCore::CTelegramCore(QObject *parent) :
             this, &CTelegramCore::messageMediaDataReceived);
     connect(m_private->m_dispatcher, &CTelegramDispatcher::messageReceived,
             this, &CTelegramCore::messageReceived);
+    connect(m_private->m_dispatcher, &CTelegramDispatcher::messagesReceived,
+            this, &CTelegramCore::messagesReceived);
+    connect(m_private->m_dispatcher, &CTelegramDispatcher::messageMediaInfoReceived,
+            this, &CTelegramCore::messageMediaInfoReceived);
     connect(m_private->m_dispatcher, &CTelegramDispatcher::contactStatusChanged,
             this, &CTelegramCore::contactStatusChanged);
     connect(m_private->m_dispatcher, &CTelegramDispatcher::contactMessageActionChanged,
@@ -116,6 +123,16 @@ CTelegramCore::CTelegramCore(QObject *parent) :
             this, &CTelegramCore::chatAdded);
     connect(m_private->m_dispatcher, &CTelegramDispatcher::chatChanged,
             this, &CTelegramCore::chatChanged);
+    connect(m_private->m_dispatcher, &CTelegramDispatcher::chatParticipantAdded,
+            this, &CTelegramCore::chatParticipantAdded);
+    connect(m_private->m_dispatcher, &CTelegramDispatcher::chatParticipantRemoved,
+            this, &CTelegramCore::chatParticipantRemoved);
+    connect(m_private->m_dispatcher, &CTelegramDispatcher::chatsChanged,
+            this, &CTelegramCore::chatsChanged);
+    connect(m_private->m_dispatcher, &CTelegramDispatcher::updatesCatchUpProgress,
+            this, &CTelegramCore::updatesCatchUpProgress);
+    connect(m_private->m_dispatcher, &CTelegramDispatcher::requestFailed,
+            this, &CTelegramCore::requestFailed);
     connect(m_private->m_dispatcher, &CTelegramDispatcher::userNameStatusUpdated,
             this, &CTelegramCore::userNameStatusUpdated);
     connect(m_private->m_mediaModule, &CTelegramMediaModule::filePartReceived,
@@ -126,6 +143,45 @@ CTelegramCore::CTelegramCore(QObject *parent) :
             this, &CTelegramCore::fileRequestFinished);
 }
 
+void CTelegramCore::connectNotify(const QMetaMethod &signal)
+{
+    QObject::connectNotify(signal);
+    updatePerItemSignals();
+}
+
+void CTelegramCore::disconnectNotify(const QMetaMethod &signal)
+{
+    QObject::disconnectNotify(signal);
+    updatePerItemSignals();
+}
+
+void CTelegramCore::updatePerItemSignals()
+{
+    if (!m_private || !m_private->m_dispatcher) {
+        return;
+    }
+    static const QMetaMethod messageReceivedSignal = QMetaMethod::fromSignal(&CTelegramCore::messageReceived);
+    static const QMetaMethod messagesReceivedSignal = QMetaMethod::fromSignal(&CTelegramCore::messagesReceived);
+    static const QMetaMethod userInfoReceivedSignal = QMetaMethod::fromSignal(&CTelegramCore::userInfoReceived);
+    static const QMetaMethod usersInfoReceivedSignal = QMetaMethod::fromSignal(&CTelegramCore::usersInfoReceived);
+    static const QMetaMethod chatAddedSignal = QMetaMethod::fromSignal(&CTelegramCore::chatAdded);
+    static const QMetaMethod chatChangedSignal = QMetaMethod::fromSignal(&CTelegramCore::chatChanged);
+    static const QMetaMethod chatsChangedSignal = QMetaMethod::fromSignal(&CTelegramCore::chatsChanged);
+
+    // The per item signals are dropped only for the clients which use just the batched variant
+    int perItemSignals = CTelegramDispatcher::PerItemAllSignals;
+    if (isSignalConnected(messagesReceivedSignal) && !isSignalConnected(messageReceivedSignal)) {
+        perItemSignals &= ~CTelegramDispatcher::PerItemMessageSignals;
+    }
+    if (isSignalConnected(usersInfoReceivedSignal) && !isSignalConnected(userInfoReceivedSignal)) {
+        perItemSignals &= ~CTelegramDispatcher::PerItemUserSignals;
+    }
+    if (isSignalConnected(chatsChangedSignal) && !isSignalConnected(chatAddedSignal) && !isSignalConnected(chatChangedSignal)) {
+        perItemSignals &= ~CTelegramDispatcher::PerItemChatSignals;
+    }
+    m_private->m_dispatcher->setPerItemSignals(perItemSignals);
+}
+
 CTelegramCore::~CTelegramCore()
 {
     delete m_private->m_dispatcher;
@@ -242,6 +298,16 @@ bool CTelegramCore::setSecretInfo(const QByteArray &secret)
     return m_private->m_dispatcher->setSecretInfo(secret);
 }
 
+bool CTelegramCore::setPeerCacheFile(const QString &fileName)
+{
+    return m_private->m_dispatcher->setPeerCacheFile(fileName);
+}
+
+bool CTelegramCore::setMessageSearchIndexFile(const QString &fileName)
+{
+    return m_private->m_dispatcher->setMessageSearchIndexFile(fileName);
+}
+
 bool CTelegramCore::setServerConfiguration(const QVector<Telegram::DcOption> &dcs)
 {
     return m_private->m_dispatcher->setDcConfiguration(dcs);
@@ -347,6 +413,11 @@ bool CTelegramCore::requestHistory(const Telegram::Peer &peer, int offset, int l
     return m_private->m_dispatcher->requestHistory(peer, offset, limit);
 }
 
+bool CTelegramCore::requestMessageMediaInfo(quint32 messageId, const Telegram::Peer &peer)
+{
+    return m_private->m_dispatcher->requestMessageMedia(messageId, peer);
+}
+
 quint32 CTelegramCore::resolveUsername(const QString &userName)
 {
     return m_private->m_dispatcher->resolveUsername(userName);
@@ -433,6 +504,11 @@ bool CTelegramCore::getPasswordInfo(Telegram::PasswordInfo *passwordInfo, quint6
     return m_private->m_authModule->getPasswordData(passwordInfo, requestId);
 }
 
+QVector<Telegram::Message> CTelegramCore::searchMessages(const QString &query, const Telegram::Peer &peer, int limit) const
+{
+    return m_private->m_dispatcher->searchMessages(query, peer, limit);
+}
+
 Telegram::PasswordInfo CTelegramCore::getPasswordData() const
 {
     Telegram::PasswordInfo info;
@@ -470,6 +546,21 @@ void CTelegramCore::setMediaDataBufferSize(quint32 size)
     m_private->m_mediaModule->setMediaDataBufferSize(size);
 }
 
+void CTelegramCore::setMediaMessagesCacheSize(quint32 size)
+{
+    m_private->m_dispatcher->setMediaMessagesCacheSize(size);
+}
+
+void CTelegramCore::setHistoryCacheSize(quint32 size)
+{
+    m_private->m_dispatcher->setHistoryCacheSize(size);
+}
+
+void CTelegramCore::setRequestRateLimit(TelegramNamespace::RequestClass requestClass, int requestsPerMinute, int burst)
+{
+    m_private->m_dispatcher->setRequestRateLimit(requestClass, requestsPerMinute, burst);
+}
+
 QString CTelegramCore::selfPhone() const
 {
     return m_private->m_dispatcher->selfPhone();
@@ -485,6 +576,21 @@ quint32 CTelegramCore::maxMessageId() const
     return m_private->m_dispatcher->maxMessageId();
 }
 
+qint64 CTelegramCore::serverTimeOffset() const
+{
+    return m_private->m_dispatcher->serverTimeOffset();
+}
+
+qint64 CTelegramCore::roundTripTime(quint32 dc) const
+{
+    return m_private->m_dispatcher->roundTripTime(dc);
+}
+
+Telegram::RequestQueueStats CTelegramCore::requestQueueStats(TelegramNamespace::RequestClass requestClass) const
+{
+    return m_private->m_dispatcher->requestQueueStats(requestClass);
+}
+
 quint64 CTelegramCore::forwardMessage(const Telegram::Peer &peer, quint32 messageId)
 {
     return m_private->m_dispatcher->forwardMessage(peer, messageId);
@@ -64,6 +64,11 @@ public:
     Q_INVOKABLE quint32 selfId() const;
     // maxMessageId is an id of the last sent or received message. Updated *after* messageReceived and sentMessageIdReceived signal emission.
     Q_INVOKABLE quint32 maxMessageId() const;
+    // The server time minus the local time (in ms), as estimated from the server message ids.
+    Q_INVOKABLE qint64 serverTimeOffset() const;
+    // The smoothed round-trip time (in ms) of the connection to the DC (the main one by default), 0 if it is not measured yet.
+    Q_INVOKABLE qint64 roundTripTime(quint32 dc = 0) const;
+    Telegram::RequestQueueStats requestQueueStats(TelegramNamespace::RequestClass requestClass) const;
     Q_INVOKABLE QVector<quint32> contactList() const;
     Q_INVOKABLE QVector<Telegram::Peer> dialogs() const;
 
@@ -76,8 +81,14 @@ public:
     bool getChatInfo(Telegram::ChatInfo *info, const Telegram::Peer peer) const;
     bool getChatParticipants(QVector<quint32> *participants, quint32 chatId);
 
+    // Returns false if the media is not in the media cache (see setMediaMessagesCacheSize()). The evicted media is not
+    // fetched implicitly anymore: call requestMessageMediaInfo() and wait for messageMediaInfoReceived().
     bool getMessageMediaInfo(Telegram::MessageMediaInfo *messageInfo, quint32 messageId, const Telegram::Peer &peer) const;
     bool getPasswordInfo(Telegram::PasswordInfo *passwordInfo, quint64 requestId) const;
+
+    // Searches the local index (see setMessageSearchIndexFile()), the newest messages first. An invalid peer means all peers.
+    // The words match the whole words, a word ending with '*' (e.g. "tele*") matches as a prefix.
+    QVector<Telegram::Message> searchMessages(const QString &query, const Telegram::Peer &peer = Telegram::Peer(), int limit = 50) const;
     Q_INVOKABLE Telegram::PasswordInfo getPasswordData() const;
 
 public Q_SLOTS:
@@ -87,8 +98,16 @@ public Q_SLOTS:
     void setUpdatesEnabled(bool enable);
 
     // By default, the app would ping server every 15 000 ms and instruct the server to close connection after 10 000 more ms. Pass interval = 0 to disable ping.
+    // The interval is adapted to the network: it is up to twice longer on a stable link and shorter after a lost pong.
     void setPingInterval(quint32 interval, quint32 serverDisconnectionAdditionalTime = 10000);
     void setMediaDataBufferSize(quint32 size);
+    // Limits the memory (in bytes) used to keep the media of the received messages. See requestMessageMediaInfo() for the evicted media.
+    void setMediaMessagesCacheSize(quint32 size);
+    // Limits the memory (in bytes) used to keep the message history of each peer. Pass 0 to disable the history cache.
+    void setHistoryCacheSize(quint32 size);
+    // The requests of each class are sent at most requestsPerMinute (after a burst), the rest wait in a queue.
+    // A FLOOD_WAIT error pauses only the queue of the failed request. Pass requestsPerMinute = 0 to not limit the class.
+    void setRequestRateLimit(TelegramNamespace::RequestClass requestClass, int requestsPerMinute, int burst);
 
     bool connectToServer();
     void disconnectFromServer();
@@ -99,6 +118,12 @@ public Q_SLOTS:
 
     void resetConnectionData();
     bool setSecretInfo(const QByteArray &secret);
+    // The users, chats and dialogs of a restored session are loaded from the file and then reconciled with the server.
+    // Use a file per account. Pass an empty file name to disable the cache.
+    bool setPeerCacheFile(const QString &fileName);
+    // Enables the local full-text index of the received messages, the index is loaded from and saved to the file.
+    // Use a file per account. Pass an empty file name to disable the index.
+    bool setMessageSearchIndexFile(const QString &fileName);
 
     bool logOut();
 
@@ -118,9 +143,14 @@ public Q_SLOTS:
     void deleteContact(quint32 userId);
     void deleteContacts(const QVector<quint32> &userIds);
 
+    // The files of the other DCs are requested through extra connections. Once a connection to a DC is signed in, the
+    // next connections to the DC start with a pre-generated temporary key. The first connection to each DC in a session
+    // still generates its permanent key and imports the authorization before the request is sent.
     quint32 requestFile(const Telegram::RemoteFile *file);
 
     bool requestHistory(const Telegram::Peer &peer, int offset, int limit);
+    // Requests the media info of a message which is not in the media cache (anymore). Returns false if the request is not sent.
+    bool requestMessageMediaInfo(quint32 messageId, const Telegram::Peer &peer);
 
     quint32 resolveUsername(const QString &userName);
 
@@ -155,12 +185,20 @@ Q_SIGNALS:
     void connectionStateChanged(TelegramNamespace::ConnectionState state);
     void selfUserAvailable(quint32 userId);
     void userInfoReceived(quint32 userId);
+    // The batched signals are emitted once per event loop iteration, after the per item ones.
+    // Connect either variant, not both. If only the batched one is connected, the per item one is not emitted.
+    void usersInfoReceived(const QVector<quint32> &userIds);
 
     void phoneCodeRequired();
     void loggedOut(bool result);
     void authSignErrorReceived(TelegramNamespace::AuthSignError errorCode, const QString &errorMessage); // Error message description: https://core.telegram.org/api/errors#400-bad-request
     void contactListChanged();
     void dialogsChanged(const QVector<Telegram::Peer> &added, const QVector<Telegram::Peer> &removed);
+    // Emitted while the updates missed during the offline time are received; remainingPts is 0 on finish.
+    void updatesCatchUpProgress(quint32 remainingPts, quint32 processedMessages, quint32 messagesPerSecond);
+    // Emitted when a request is given up instead of waiting for the answer forever.
+    // The request id is the one returned by the request method (if any), the method is the TL name, e.g. "MessagesSendMessage".
+    void requestFailed(quint64 requestId, const QString &method, TelegramNamespace::RequestFailureReason reason);
     void contactProfileChanged(quint32 userId); // First, last or user name was changed
     void phoneStatusReceived(const QString &phone, bool registered);
     void passwordInfoReceived(quint64 requestId);
@@ -168,8 +206,11 @@ Q_SIGNALS:
     void avatarReceived(quint32 userId, const QByteArray &data, const QString &mimeType, const QString &avatarToken);
     void messageMediaDataReceived(Telegram::Peer peer, quint32 messageId, const QByteArray &data,
                                   const QString &mimeType, TelegramNamespace::MessageType type, quint32 offset, quint32 size);
+    // Emitted when the media info requested by requestMessageMediaInfo() is received, so getMessageMediaInfo() would succeed.
+    void messageMediaInfoReceived(Telegram::Peer peer, quint32 messageId);
 
     void messageReceived(const Telegram::Message &message);
+    void messagesReceived(const QVector<Telegram::Message> &messages);
 
     void contactStatusChanged(quint32 userId, TelegramNamespace::ContactStatus status);
     void contactMessageActionChanged(quint32 userId, TelegramNamespace::MessageAction action);
@@ -183,6 +224,9 @@ Q_SIGNALS:
     void createdChatIdReceived(quint64 randomId, quint32 resolvedId); // Signal chatAdded(resolvedId) would be emitted after this signal.
     void chatAdded(quint32 chatId);
     void chatChanged(quint32 chatId);
+    void chatParticipantAdded(quint32 chatId, quint32 userId);
+    void chatParticipantRemoved(quint32 chatId, quint32 userId);
+    void chatsChanged(const QVector<quint32> &chatIds); // Added or changed chats
 
     void authorizationErrorReceived(TelegramNamespace::UnauthorizedError errorCode, const QString &errorMessage);
 
@@ -211,6 +255,11 @@ public Q_SLOTS:
     // - connectToServer()
     // - disconnectFromServer()
 
+protected:
+    void connectNotify(const QMetaMethod &signal) override;
+    void disconnectNotify(const QMetaMethod &signal) override;
+    void updatePerItemSignals();
+
 private:
     class Private;
     friend class Private;
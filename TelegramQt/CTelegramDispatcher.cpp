@@ -21,6 +21,9 @@
 #include "TelegramNamespace_p.hpp"
 #include "CTelegramConnection.hpp"
 #include "CTelegramModule.hpp"
+#include "CTelegramTransport.hpp"
+#include "CMessageSearchIndex.hpp"
+#include "CPeerCache.hpp"
 #include "CRawStream.hpp"
 #include "Debug_p.hpp"
 #include "Utils.hpp"
@@ -32,8 +35,10 @@ using namespace Telegram;
 #include <QTimer>
 
 #include <QCryptographicHash>
+#include <QDateTime>
 #include <QDebug>
 #include <algorithm>
+#include <limits>
 
 #ifdef DEVELOPER_BUILD
 #include "TLTypesDebug.hpp"
@@ -47,8 +52,8 @@ static const QVector<Telegram::DcOption> s_builtInDcs = {
         Telegram::DcOption(QLatin1String("91.108.56.165")  , 443),
 };
 
-const quint32 secretFormatVersion = 4;
-//Format v4:
+const quint32 secretFormatVersion = 6;
+//Format v6:
 //quint32 secretFormatVersion
 //qint32 deltaTime
 
@@ -82,12 +87,37 @@ const quint32 secretFormatVersion = 4;
 //    }
 //}
 
+//quint32 chatIdsCount
+//quint32 chatId (N = chatIdsCount, index is the public chat id)
+
+//quint32 serverSaltsCount
+//ServerSalt (N = serverSaltsCount) {
+//    quint32 validSince
+//    quint32 validUntil
+//    quint64 salt
+//}
+
 const int s_userTypingActionPeriod = 6000; // 6 sec
 const int s_localTypingDuration = 5000; // 5 sec
 const int s_localTypingRecommendedRepeatInterval = 400; // (s_userTypingActionPeriod - s_localTypingDuration) / 2. Minus 100 ms for insurance.
 static const quint32 s_dialogsLimit = 30;
+static const quint32 s_defaultMediaMessagesCacheSize = 4 * 1024 * 1024; // 4 Mb
+static const quint32 s_defaultHistoryCacheSize = 512 * 1024; // 512 Kb per peer
+static const int s_peerCacheSyncInterval = 2000; // 2 sec
+static const int s_differenceChunkSize = 100; // Messages and updates processed per event loop iteration
+static const int s_maxPendingDifferences = 2; // Received, but not processed yet difference slices
+static const int s_maxChannelDifferenceRequests = 3; // Concurrent updates.getChannelDifference requests
+static const quint32 s_channelDifferenceLimit = 10000;
 
 static const int s_autoConnectionIndexInvalid = -1; // App logic rely on (s_autoConnectionIndexInvalid + 1 == 0)
+static const int s_resumeConnectionBaseDelay = 250; // ms, the first attempt is made at once, then the delay is doubled
+static const int s_resumeConnectionMaxDelay = 8000; // ms
+static const int s_resumeConnectionMaxAttempts = 6; // Then the connection is initialized from scratch
+
+static const quint32 s_temporaryKeyLifetime = 24 * 60 * 60; // 24 hours
+static const quint32 s_temporaryKeyMinLifetime = 60 * 60; // A key from the pool serves a connection for an hour at least
+static const quint32 s_temporaryKeyRotationMargin = 10 * 60; // The key of a connection is replaced 10 min before its expiration
+static const int s_temporaryKeysCheckInterval = 60 * 1000; // 1 min
 
 static const quint32 s_legacyDcInfoTlType = 0x2ec2a43cu; // Scheme23_DcOption
 static const quint32 s_legacyVectorTlType = 0x1cb5c415u; // Scheme23_Vector;
@@ -111,16 +141,58 @@ CTelegramDispatcher::CTelegramDispatcher(QObject *parent) :
     m_wantedActiveDc(0),
     m_autoConnectionDcIndex(s_autoConnectionIndexInvalid),
     m_mainConnection(0),
+    m_temporaryKeys(/* keysPerDc */ 1, s_temporaryKeyMinLifetime),
+    m_temporaryKeysTimer(new QTimer(this)),
     m_reconnectMainConnectionTimer(nullptr),
+    m_resumeMainConnectionTimer(new QTimer(this)),
+    m_mainConnectionResumeAttempts(0),
+    m_resumedConnectionState(TelegramNamespace::ConnectionStateDisconnected),
     m_updateRequestId(0),
     m_updatesStateIsLocked(false),
+    m_pendingDifferenceMessageIndex(-1),
+    m_pendingDifferenceUpdateIndex(0),
+    m_differenceRequested(false),
+    m_requestedDifferencePts(0),
+    m_differenceProcessingTimer(new QTimer(this)),
+    m_catchUpProcessedMessages(0),
+    m_channelDifferenceScheduler(s_maxChannelDifferenceRequests),
+    m_channelDifferenceTimer(new QTimer(this)),
     m_selfUserId(0),
     m_maxMessageId(0),
+    m_peerCache(nullptr),
+    m_searchIndex(nullptr),
+    m_peerCacheSyncTimer(new QTimer(this)),
+    m_batchedSignalsTimer(new QTimer(this)),
+    m_perItemSignals(PerItemAllSignals),
     m_typingUpdateTimer(new QTimer(this))
 {
     m_typingUpdateTimer->setSingleShot(true);
     connect(m_typingUpdateTimer, &QTimer::timeout, this, &CTelegramDispatcher::messageActionTimerTimeout);
 
+    m_peerCacheSyncTimer->setSingleShot(true);
+    m_peerCacheSyncTimer->setInterval(s_peerCacheSyncInterval);
+    connect(m_peerCacheSyncTimer, &QTimer::timeout, this, &CTelegramDispatcher::syncPeerCache);
+
+    m_resumeMainConnectionTimer->setSingleShot(true);
+    connect(m_resumeMainConnectionTimer, &QTimer::timeout, this, &CTelegramDispatcher::onMainConnectionResumeTimerTriggered);
+
+    m_temporaryKeysTimer->setInterval(s_temporaryKeysCheckInterval);
+    connect(m_temporaryKeysTimer, &QTimer::timeout, this, &CTelegramDispatcher::onTemporaryKeysTimerTriggered);
+
+    m_differenceProcessingTimer->setSingleShot(true);
+    m_differenceProcessingTimer->setInterval(0);
+    connect(m_differenceProcessingTimer, &QTimer::timeout, this, &CTelegramDispatcher::processPendingDifferences);
+
+    m_channelDifferenceTimer->setSingleShot(true);
+    connect(m_channelDifferenceTimer, &QTimer::timeout, this, &CTelegramDispatcher::requestChannelDifferences);
+
+    m_batchedSignalsTimer->setSingleShot(true);
+    m_batchedSignalsTimer->setInterval(0);
+    connect(m_batchedSignalsTimer, &QTimer::timeout, this, &CTelegramDispatcher::emitBatchedSignals);
+
+    m_mediaMessages.setMaxCost(s_defaultMediaMessagesCacheSize);
+    m_historyCache.setMemoryLimit(s_defaultHistoryCacheSize);
+
     resetConnectionData();
     resetDcConfiguration();
 }
@@ -128,6 +200,8 @@ CTelegramDispatcher::CTelegramDispatcher(QObject *parent) :
 CTelegramDispatcher::~CTelegramDispatcher()
 {
     disconnectFromServer();
+    delete m_peerCache;
+    delete m_searchIndex;
 }
 
 void CTelegramDispatcher::plugModule(CTelegramModule *module)
@@ -168,11 +242,12 @@ qint32 CTelegramDispatcher::localTypingRecommendedRepeatInterval()
 
 QString CTelegramDispatcher::selfPhone() const
 {
-    if (!m_selfUserId || !m_users.value(m_selfUserId)) {
+    const TLUser *selfUser = m_users.value(m_selfUserId);
+    if (!selfUser) {
         return QString();
     }
 
-    return m_users.value(m_selfUserId)->phone;
+    return selfUser->phone;
 }
 
 quint32 CTelegramDispatcher::selfId() const
@@ -188,6 +263,27 @@ quint32 CTelegramDispatcher::maxMessageId() const
     return 0;
 }
 
+qint64 CTelegramDispatcher::serverTimeOffset() const
+{
+    if (mainConnection()) {
+        return mainConnection()->timeOffset();
+    }
+    return qint64(m_deltaTime) * 1000;
+}
+
+qint64 CTelegramDispatcher::roundTripTime(quint32 dc) const
+{
+    if (mainConnection() && (!dc || (mainConnection()->dcInfo().id == dc))) {
+        return mainConnection()->roundTripTime();
+    }
+    for (const CTelegramConnection *connection : m_extraConnections) {
+        if (connection->dcInfo().id == dc) {
+            return connection->roundTripTime();
+        }
+    }
+    return 0;
+}
+
 QVector<quint32> CTelegramDispatcher::contactIdList() const
 {
     return m_contactIdList;
@@ -195,12 +291,12 @@ QVector<quint32> CTelegramDispatcher::contactIdList() const
 
 QVector<quint32> CTelegramDispatcher::chatIdList() const
 {
-    return m_chatIds;
+    return m_chatIds.chatIds();
 }
 
 QVector<Telegram::Peer> CTelegramDispatcher::dialogs() const
 {
-    return m_dialogs.keys().toVector();
+    return m_dialogs.keys();
 }
 
 void CTelegramDispatcher::addContacts(const QStringList &phoneNumbers, bool replace)
@@ -299,6 +395,19 @@ QByteArray CTelegramDispatcher::connectionSecretInfo() const
         outputStream << quint32(0); // dialogs count
     }
 
+    outputStream << quint32(m_chatIds.count());
+    for (quint32 chatId : m_chatIds.chatIds()) {
+        outputStream << chatId;
+    }
+
+    const QVector<CTelegramConnection::ServerSalt> serverSalts = mainConnection()->serverSalts();
+    outputStream << quint32(serverSalts.count());
+    for (const CTelegramConnection::ServerSalt &salt : serverSalts) {
+        outputStream << salt.validSince;
+        outputStream << salt.validUntil;
+        outputStream << salt.salt;
+    }
+
     return output;
 }
 
@@ -317,6 +426,87 @@ void CTelegramDispatcher::setAutoReconnection(bool enable)
     m_autoReconnectionEnabled = enable;
 }
 
+void CTelegramDispatcher::setMediaMessagesCacheSize(quint32 size)
+{
+    m_mediaMessages.setMaxCost(int(qMin<quint32>(size, std::numeric_limits<int>::max())));
+}
+
+void CTelegramDispatcher::setHistoryCacheSize(quint32 size)
+{
+    m_historyCache.setMemoryLimit(int(qMin<quint32>(size, std::numeric_limits<int>::max())));
+}
+
+void CTelegramDispatcher::setRequestRateLimit(TelegramNamespace::RequestClass requestClass, int requestsPerMinute, int burst)
+{
+    m_requestRateLimits.insert(requestClass, qMakePair(requestsPerMinute, burst));
+    if (mainConnection()) {
+        mainConnection()->setRequestRateLimit(requestClass, requestsPerMinute, burst);
+    }
+    for (CTelegramConnection *connection : m_extraConnections) {
+        connection->setRequestRateLimit(requestClass, requestsPerMinute, burst);
+    }
+}
+
+Telegram::RequestQueueStats CTelegramDispatcher::requestQueueStats(TelegramNamespace::RequestClass requestClass) const
+{
+    // Sum up the queues of all DCs
+    QVector<CTelegramConnection *> connections = m_extraConnections;
+    if (mainConnection()) {
+        connections.prepend(mainConnection());
+    }
+
+    Telegram::RequestQueueStats result;
+    qint64 totalWaitTime = 0;
+    for (const CTelegramConnection *connection : connections) {
+        const Telegram::RequestQueueStats stats = connection->requestQueueStats(requestClass);
+        result.queueDepth += stats.queueDepth;
+        result.delayedCount += stats.delayedCount;
+        totalWaitTime += stats.averageWaitTime * stats.delayedCount;
+        result.maxWaitTime = qMax(result.maxWaitTime, stats.maxWaitTime);
+        result.oldestWaitTime = qMax(result.oldestWaitTime, stats.oldestWaitTime);
+        result.floodWaitRemaining = qMax(result.floodWaitRemaining, stats.floodWaitRemaining);
+    }
+    if (result.delayedCount) {
+        result.averageWaitTime = totalWaitTime / result.delayedCount;
+    }
+    return result;
+}
+
+bool CTelegramDispatcher::setPeerCacheFile(const QString &fileName)
+{
+    if (connectionState() != TelegramNamespace::ConnectionStateDisconnected) {
+        qWarning() << "CTelegramDispatcher::setPeerCacheFile(): Connection is already in progress.";
+        return false;
+    }
+
+    delete m_peerCache; // Writes the pending changes
+    m_peerCache = nullptr;
+    if (!fileName.isEmpty()) {
+        m_peerCache = new CPeerCache(fileName);
+    }
+    return true;
+}
+
+bool CTelegramDispatcher::setMessageSearchIndexFile(const QString &fileName)
+{
+    delete m_searchIndex; // Writes the pending changes
+    m_searchIndex = nullptr;
+    if (!fileName.isEmpty()) {
+        m_searchIndex = new CMessageSearchIndex(fileName);
+        m_searchIndex->load();
+    }
+    return true;
+}
+
+QVector<Telegram::Message> CTelegramDispatcher::searchMessages(const QString &query, const Telegram::Peer &peer, int limit) const
+{
+    if (!m_searchIndex) {
+        qWarning() << Q_FUNC_INFO << "The search index is not enabled";
+        return {};
+    }
+    return m_searchIndex->search(query, peer, limit);
+}
+
 bool CTelegramDispatcher::setDcConfiguration(const QVector<Telegram::DcOption> &dcs)
 {
     if (connectionState() != TelegramNamespace::ConnectionStateDisconnected) {
@@ -347,10 +537,10 @@ bool CTelegramDispatcher::connectToTheNextDcAddress()
         qWarning() << "CTelegramDispatcher::connectToTheNextDcAddress(): Connection address is not set";
         return false;
     }
-    ++m_autoConnectionDcIndex;
+    ++m_autoConnectionDcIndex; // All of the addresses are raced at once, so this is the number of the failed races
 
-    qDebug() << "CTelegramDispatcher::tryNextBuiltInDcAddress(): Dc index (not a dc id):" << m_autoConnectionDcIndex;
-    if (m_autoConnectionDcIndex >= m_connectionAddresses.count()) {
+    qDebug() << "CTelegramDispatcher::tryNextBuiltInDcAddress(): Connection round:" << m_autoConnectionDcIndex;
+    if (m_autoConnectionDcIndex > 0) {
         if (m_autoReconnectionEnabled) {
             qDebug() << "CTelegramDispatcher::tryNextBuiltInDcAddress(): Could not connect to any known dc. Reconnection enabled -> wrap up and try again.";
             m_autoConnectionDcIndex = 0;
@@ -361,10 +551,13 @@ bool CTelegramDispatcher::connectToTheNextDcAddress()
         }
     }
 
+    const QVector<Telegram::DcOption> addresses = m_addressLatencies.sorted(m_connectionAddresses);
     TLDcOption dcInfo;
-    dcInfo.ipAddress = m_connectionAddresses.at(m_autoConnectionDcIndex).address;
-    dcInfo.port = m_connectionAddresses.at(m_autoConnectionDcIndex).port;
-    setMainConnection(createConnection(dcInfo));
+    dcInfo.ipAddress = addresses.first().address;
+    dcInfo.port = addresses.first().port;
+    CTelegramConnection *connection = createConnection(dcInfo);
+    connection->setDcAddresses(addresses);
+    setMainConnection(connection);
     initConnectionSharedFinal();
     return true;
 }
@@ -374,7 +567,9 @@ void CTelegramDispatcher::connectToTheWantedDc()
     setMainConnection(createConnection(m_mainDcInfo));
     m_mainConnection->setAuthKey(m_authKey);
     m_mainConnection->setServerSalt(m_serverSalt);
+    m_mainConnection->setServerSalts(m_serverSalts);
     initConnectionSharedFinal();
+    loadPeerCache();
 }
 
 bool CTelegramDispatcher::setSecretInfo(const QByteArray &secret)
@@ -462,6 +657,7 @@ bool CTelegramDispatcher::setSecretInfo(const QByteArray &secret)
         inputStream >> dialogsCount;
         QHash<Telegram::Peer,TLDialog> dialogs;
         dialogs.reserve(dialogsCount + 5);
+        QHash<quint32, quint32> restoredChannelPts;
         for (quint32 i = 0; i < dialogsCount; ++i) {
             TLDialog dialog;
             quint8 dialogType = 0;
@@ -494,10 +690,13 @@ bool CTelegramDispatcher::setSecretInfo(const QByteArray &secret)
 
             if (dialogType == DialogTypeChannel) {
                 inputStream >> dialog.pts;
+                restoredChannelPts.insert(peer.id, dialog.pts);
             }
             dialogs.insert(peer, dialog);
         }
-        // Do not apply loaded dialogs, because we can not clean them up properly on dialogs received
+        // Do not apply loaded dialogs, because we can not clean them up properly on dialogs received.
+        // The channels pts are used to catch up the channels once the actual dialogs are received.
+        m_restoredChannelPts = restoredChannelPts;
     } else if (format >= 2) {
         quint32 legacyVectorTlType;
         quint32 chatIdsVectorSize = 0;
@@ -509,10 +708,43 @@ bool CTelegramDispatcher::setSecretInfo(const QByteArray &secret)
             return false;
         }
 
-        m_chatIds.resize(chatIdsVectorSize);
+        QVector<quint32> chatIds(chatIdsVectorSize);
+        for (int i = 0; i < chatIds.count(); ++i) {
+            inputStream >> chatIds[i];
+        }
+        m_chatIds.setChatIds(chatIds);
+    }
+
+    if (format >= 5) {
+        quint32 chatIdsCount = 0;
+        inputStream >> chatIdsCount;
+        QVector<quint32> chatIds;
+        for (quint32 i = 0; (i < chatIdsCount) && !inputStream.atEnd(); ++i) {
+            quint32 chatId = 0;
+            inputStream >> chatId;
+            chatIds.append(chatId);
+        }
+        if (inputStream.error()) {
+            qWarning() << Q_FUNC_INFO << "Read error occurred.";
+            return false;
+        }
+        m_chatIds.setChatIds(chatIds);
+    }
 
-        for (int i = 0; i < m_chatIds.count(); ++i) {
-            inputStream >> m_chatIds[i];
+    QVector<CTelegramConnection::ServerSalt> serverSalts;
+    if (format >= 6) {
+        quint32 serverSaltsCount = 0;
+        inputStream >> serverSaltsCount;
+        for (quint32 i = 0; (i < serverSaltsCount) && !inputStream.atEnd(); ++i) {
+            CTelegramConnection::ServerSalt salt;
+            inputStream >> salt.validSince;
+            inputStream >> salt.validUntil;
+            inputStream >> salt.salt;
+            serverSalts.append(salt);
+        }
+        if (inputStream.error()) {
+            qWarning() << Q_FUNC_INFO << "Read error occurred.";
+            return false;
         }
     }
 
@@ -521,6 +753,7 @@ bool CTelegramDispatcher::setSecretInfo(const QByteArray &secret)
     m_wantedActiveDc = dcInfo.id;
     m_authKey = authKey;
     m_serverSalt = serverSalt;
+    m_serverSalts = serverSalts;
 
     return true;
 }
@@ -529,6 +762,7 @@ void CTelegramDispatcher::resetConnectionData()
 {
     m_autoConnectionDcIndex = s_autoConnectionIndexInvalid;
     m_deltaTime = 0;
+    m_serverSalts.clear();
     m_updateRequestId = 0;
     m_updatesState.pts = 1;
     m_updatesState.qts = 1;
@@ -541,13 +775,11 @@ void CTelegramDispatcher::resetConnectionData()
     m_delayedPackages.clear();
     qDeleteAll(m_users);
     m_users.clear();
-    qDeleteAll(m_knownMediaMessages);
-    m_knownMediaMessages.clear();
-    for (auto peerMessages : m_channelMediaMessages) {
-        qDeleteAll(*peerMessages);
-    }
-    qDeleteAll(m_channelMediaMessages);
-    m_channelMediaMessages.clear();
+    m_mediaMessages.clear();
+    m_requestedMediaMessages.clear();
+    m_requestedMediaKeys.clear();
+    m_historyCache.clear();
+    m_cachedHistoryMessages.clear();
     m_contactIdList.clear();
     m_contactsMessageActions.clear();
     m_localMessageActions.clear();
@@ -555,6 +787,8 @@ void CTelegramDispatcher::resetConnectionData()
     qDeleteAll(m_chatInfo);
     m_chatInfo.clear();
     m_chatFullInfo.clear();
+    m_chatParticipants.clear();
+    m_changedFullChats.clear();
     m_wantedActiveDc = 0;
 
     for (CTelegramModule *module : m_modules) {
@@ -571,29 +805,202 @@ void CTelegramDispatcher::initConnectionSharedFinal()
 {
     m_initializationState = StepFirst;
     m_requestedSteps = 0;
+    m_resumeMainConnectionTimer->stop();
+    m_resumedConnectionState = TelegramNamespace::ConnectionStateDisconnected;
     setConnectionState(TelegramNamespace::ConnectionStateConnecting);
     m_updatesStateIsLocked = false;
+    m_pendingDifferences.clear();
+    m_pendingDifferenceMessageIndex = -1;
+    m_pendingDifferenceUpdateIndex = 0;
+    m_differenceRequested = false;
+    m_differenceProcessingTimer->stop();
+    m_catchUpTime.invalidate();
+    m_channelDifferenceScheduler.requeueActive(); // The dialogs are requested again and restart the requests
+    m_channelDifferenceRequests.clear();
+    m_channelDifferenceTimer->stop();
     // TODO: Check if the reset() method is a more appropriate place for the selfUserId reset.
     m_selfUserId = 0;
     m_mainConnection->connectToDc();
 }
 
+void CTelegramDispatcher::resetPeers()
+{
+    // Everything known about the peers of the previous account, including the restored from its cache
+    const QVector<Telegram::Peer> removedDialogs = m_dialogs.keys();
+    const bool hadContacts = !m_contactIdList.isEmpty();
+
+    qDeleteAll(m_users);
+    m_users.clear();
+    qDeleteAll(m_chatInfo);
+    m_chatInfo.clear();
+    m_chatIds.clear();
+    m_chatFullInfo.clear();
+    m_chatParticipants.clear();
+    m_changedFullChats.clear();
+    m_dialogs.clear();
+    m_changedDialogs.clear();
+    m_listedDialogs.clear();
+    m_restoredChannelPts.clear();
+    m_contactIdList.clear();
+    m_mediaMessages.clear();
+    m_requestedMediaMessages.clear();
+    m_requestedMediaKeys.clear();
+    m_historyCache.clear();
+    m_cachedHistoryMessages.clear();
+    m_batchedUserIds.clear();
+    m_batchedChatIds.clear();
+    m_batchedChatIdsSet.clear();
+    m_maxMessageId = 0;
+    m_selfUserId = 0;
+    if (m_searchIndex) {
+        m_searchIndex->clear();
+    }
+
+    if (!removedDialogs.isEmpty()) {
+        emit dialogsChanged({}, removedDialogs);
+    }
+    if (hadContacts) {
+        emit contactListChanged();
+    }
+}
+
+void CTelegramDispatcher::loadPeerCache()
+{
+    // The cache is loaded only for a restored session and only once, the reconnection keeps the peers in memory
+    if (!m_peerCache || !m_users.isEmpty()) {
+        return;
+    }
+    if (!m_peerCache->load()) {
+        return;
+    }
+    qDebug() << Q_FUNC_INFO << m_peerCache->fileName();
+
+    m_selfUserId = m_peerCache->selfUserId();
+    onUsersReceived(m_peerCache->users());
+    onChatsReceived(m_peerCache->chats());
+    for (const TLChatFull &chat : m_peerCache->fullChats()) {
+        updateFullChat(chat);
+    }
+
+    QVector<quint32> contactIdList = m_peerCache->contactIdList();
+    std::sort(contactIdList.begin(), contactIdList.end());
+    if (m_contactIdList != contactIdList) {
+        m_contactIdList = contactIdList;
+        emit contactListChanged();
+    }
+
+    QVector<Telegram::Peer> newDialogs;
+    for (const TLDialog &dialog : m_peerCache->dialogs()) {
+        const Telegram::Peer peer = toPublicPeer(dialog.peer);
+        if (!peer.isValid()) {
+            continue;
+        }
+        bool isNewDialog = false;
+        TLDialog &existDialog = m_dialogs.findOrInsert(peer, &isNewDialog);
+        if (isNewDialog) {
+            existDialog = dialog;
+            newDialogs.append(peer);
+        }
+    }
+    if (!newDialogs.isEmpty()) {
+        emit dialogsChanged(newDialogs, {});
+    }
+    m_maxMessageId = m_peerCache->maxMessageId();
+}
+
+void CTelegramDispatcher::schedulePeerCacheSync()
+{
+    if ((m_peerCache || m_searchIndex) && !m_peerCacheSyncTimer->isActive()) {
+        m_peerCacheSyncTimer->start();
+    }
+}
+
+void CTelegramDispatcher::syncPeerCache()
+{
+    if (m_searchIndex) {
+        m_searchIndex->sync();
+    }
+    if (!m_peerCache) {
+        return;
+    }
+
+    for (const Telegram::Peer &peer : m_changedDialogs) {
+        if (const TLDialog *dialog = m_dialogs.find(peer)) {
+            m_peerCache->insertDialog(peer, *dialog);
+        }
+    }
+    m_changedDialogs.clear();
+    for (quint32 chatId : m_changedFullChats) {
+        if (const TLChatFull *fullChat = m_chatFullInfo.find(chatId)) {
+            m_peerCache->insertFullChat(*fullChat);
+        }
+    }
+    m_changedFullChats.clear();
+    m_peerCache->setContactIdList(m_contactIdList);
+    if (m_initializationState & StepDialogs) {
+        m_peerCache->setMaxMessageId(m_maxMessageId);
+    }
+    m_peerCache->sync();
+}
+
+void CTelegramDispatcher::scheduleBatchedSignals()
+{
+    if (!m_batchedSignalsTimer->isActive()) {
+        m_batchedSignalsTimer->start();
+    }
+}
+
+void CTelegramDispatcher::emitBatchedSignals()
+{
+    // The history served from the cache is processed here, so requestHistory() never emits synchronously
+    if (!m_cachedHistoryMessages.isEmpty()) {
+        const QVector<TLMessage> messages = m_cachedHistoryMessages;
+        m_cachedHistoryMessages.clear();
+        for (const TLMessage &message : messages) {
+            processMessageReceived(message);
+        }
+    }
+
+    // Users first, so the receivers know the senders of the messages
+    if (!m_batchedUserIds.isEmpty()) {
+        const QVector<quint32> userIds = m_batchedUserIds;
+        m_batchedUserIds.clear();
+        emit usersInfoReceived(userIds);
+    }
+    if (!m_batchedChatIds.isEmpty()) {
+        const QVector<quint32> chatIds = m_batchedChatIds;
+        m_batchedChatIds.clear();
+        m_batchedChatIdsSet.clear();
+        emit chatsChanged(chatIds);
+    }
+    if (!m_batchedMessages.isEmpty()) {
+        const QVector<Telegram::Message> messages = m_batchedMessages;
+        m_batchedMessages.clear();
+        emit messagesReceived(messages);
+    }
+}
+
 void CTelegramDispatcher::disconnectFromServer()
 {
+    m_resumeMainConnectionTimer->stop();
+    m_resumedConnectionState = TelegramNamespace::ConnectionStateDisconnected;
     setConnectionState(TelegramNamespace::ConnectionStateDisconnected);
 
+    m_peerCacheSyncTimer->stop();
+    syncPeerCache();
+
     setMainConnection(nullptr);
     clearExtraConnections();
 
+    m_temporaryKeysTimer->stop();
+    m_temporaryKeys.clear();
+    m_permanentKeys.clear();
+
     m_askedUserIds.clear();
 }
 
 bool CTelegramDispatcher::requestHistory(const Telegram::Peer &peer, quint32 offset, quint32 limit)
 {
-    if (!mainConnection()) {
-        return false;
-    }
-
     const TLInputPeer inputPeer = toInputPeer(peer);
 
     if (inputPeer.tlType == TLValue::InputPeerEmpty) {
@@ -601,12 +1008,29 @@ bool CTelegramDispatcher::requestHistory(const Telegram::Peer &peer, quint32 off
         return false;
     }
 
-    quint32 offsetId = m_maxMessageId + 1;
-    if (m_dialogs.contains(peer)) {
-        offsetId = m_dialogs.value(peer).topMessage + 1;
+    QVector<CMessageHistoryCache::Request> missingPages;
+    const QVector<TLMessage> cachedMessages = m_historyCache.messages(peer, offset, limit, &missingPages);
+
+    if (!missingPages.isEmpty() && !mainConnection()) {
+        return false;
     }
 
-    mainConnection()->messagesGetHistory(inputPeer, /* offsetId */ offsetId, /* addOffset */ offset, limit, /* maxId */ 0, /* minId */ 0);
+    if (!cachedMessages.isEmpty()) {
+        m_cachedHistoryMessages += cachedMessages;
+        scheduleBatchedSignals();
+    }
+
+    quint32 topMessageId = m_maxMessageId;
+    if (const TLDialog *dialog = m_dialogs.find(peer)) {
+        topMessageId = dialog->topMessage;
+    }
+    topMessageId = qMax(topMessageId, m_historyCache.topMessageId(peer));
+
+    // Fetch only the gaps of the cached history
+    for (const CMessageHistoryCache::Request &page : missingPages) {
+        const quint32 offsetId = page.offsetId ? page.offsetId : topMessageId + 1;
+        mainConnection()->messagesGetHistory(inputPeer, offsetId, page.addOffset, page.limit, /* maxId */ 0, /* minId */ 0);
+    }
 
     return true;
 }
@@ -885,11 +1309,12 @@ QString CTelegramDispatcher::chatTitle(quint32 chatId) const
         return QString();
     }
 
-    if (!m_chatInfo.contains(chatId)) {
+    const TLChat *chat = m_chatInfo.value(chatId);
+    if (!chat) {
         return QString();
     }
 
-    return m_chatInfo.value(chatId)->title;
+    return chat->title;
 }
 
 bool CTelegramDispatcher::setWantedDc(quint32 dc)
@@ -903,25 +1328,27 @@ bool CTelegramDispatcher::setWantedDc(quint32 dc)
 
 bool CTelegramDispatcher::getDialogInfo(Telegram::DialogInfo *info, const Telegram::Peer peer) const
 {
-    if (!info || !m_dialogs.contains(peer)) {
+    if (!info) {
         return false;
     }
-    
-    const TLDialog &dialog = m_dialogs.value(peer);
-    
+    const TLDialog *dialog = m_dialogs.find(peer);
+    if (!dialog) {
+        return false;
+    }
+
     info->d->peer = peer;
-    info->d->muteUntil = dialog.notifySettings.muteUntil;
+    info->d->muteUntil = dialog->notifySettings.muteUntil;
     return true;
 }
 
 bool CTelegramDispatcher::getUserInfo(Telegram::UserInfo *userInfo, quint32 userId) const
 {
-    if (!m_users.contains(userId)) {
+    const TLUser *user = m_users.value(userId);
+    if (!user) {
         qDebug() << Q_FUNC_INFO << "Unknown user" << userId;
         return false;
     }
 
-    const TLUser *user = m_users.value(userId);
     TLUser &info = *userInfo->d;
     info = *user;
     return true;
@@ -933,25 +1360,25 @@ bool CTelegramDispatcher::getChatInfo(Telegram::ChatInfo *outputChat, const Tele
         return false;
     }
 
-    if (!m_chatInfo.contains(peer.id)) {
+    if (!outputChat) {
         return false;
     }
 
-    if (!outputChat) {
+    const TLChat *chat = m_chatInfo.value(peer.id);
+    if (!chat) {
         return false;
     }
 
-    const TLChat *chat = m_chatInfo.value(peer.id);
     TLChat &info = *outputChat->d;
     info = *chat;
 
     // Apply some participants count correction
-    if (m_chatFullInfo.contains(peer.id)) {
-        const TLChatFull &chatFull = m_chatFullInfo.value(peer.id);
-        if (chatFull.tlType == TLValue::ChatFull) {
-            info.participantsCount = chatFull.participants.participants.count();
+    if (const TLChatFull *chatFull = m_chatFullInfo.find(peer.id)) {
+        if (chatFull->tlType == TLValue::ChatFull) {
+            const CChatParticipants *chatParticipants = m_chatParticipants.find(peer.id);
+            info.participantsCount = chatParticipants ? chatParticipants->count() : 0;
         } else {
-            info.participantsCount = chatFull.participantsCount;
+            info.participantsCount = chatFull->participantsCount;
         }
     }
 
@@ -966,15 +1393,16 @@ bool CTelegramDispatcher::getChatParticipants(QVector<quint32> *participants, qu
 
     participants->clear();
 
-    if (!m_chatInfo.contains(chatId)) {
+    const TLChat *chat = m_chatInfo.value(chatId);
+    if (!chat) {
         mainConnection()->messagesGetChats(TLVector<quint32>() << chatId); // The chat can be a channel as well
         return true; // Pending
     }
 
-    const TLChat *chat = m_chatInfo.value(chatId);
     const TLInputChannel inputChannel = toInputChannel(chat);
 
-    if (!m_chatFullInfo.contains(chatId)) {
+    const TLChatFull *fullChatPointer = m_chatFullInfo.find(chatId);
+    if (!fullChatPointer) {
         switch (chat->tlType) {
         case TLValue::Channel:
             mainConnection()->channelsGetFullChannel(inputChannel);
@@ -989,51 +1417,66 @@ bool CTelegramDispatcher::getChatParticipants(QVector<quint32> *participants, qu
         return false;
     }
 
-    const TLChatFull &fullChat = m_chatFullInfo.value(chatId);
-
-    if (fullChat.tlType == TLValue::ChatFull) {
-        foreach (const TLChatParticipant &participant, fullChat.participants.participants) {
-            participants->append(participant.userId);
-        }
-    } else if (fullChat.tlType == TLValue::ChannelFull) {
-        if (!m_channelParticipants.contains(chatId)) {
+    const CChatParticipants *chatParticipants = m_chatParticipants.find(chatId);
+    if (!chatParticipants) {
+        if (fullChatPointer->tlType == TLValue::ChannelFull) {
             mainConnection()->channelsGetParticipants(inputChannel, TLChannelParticipantsFilter(), 0, 300);
-            return true;
-        }
-        foreach (const TLChannelParticipant &participant, m_channelParticipants.value(chatId)) {
-            participants->append(participant.userId);
         }
+        return true;
     }
 
+    *participants = chatParticipants->userIds();
     return true;
 }
 
 void CTelegramDispatcher::onUsersReceived(const QVector<TLUser> &users)
 {
     qDebug() << Q_FUNC_INFO << users.count();
+    if (m_peerCache && m_peerCache->selfUserId()) {
+        for (const TLUser &user : users) {
+            if (user.self() && (m_peerCache->selfUserId() != user.id)) {
+                qWarning() << Q_FUNC_INFO << "The peer cache belongs to another account; drop it.";
+                m_peerCache->clear();
+                resetPeers();
+                break;
+            }
+        }
+    }
     foreach (const TLUser &user, users) {
-        TLUser *existsUser = m_users.value(user.id);
-        if (existsUser) {
-            *existsUser = user;
+        bool isNewUser = false;
+        TLUser *&existsUser = m_users.findOrInsert(user.id, &isNewUser);
+        if (isNewUser) {
+            existsUser = new TLUser(user);
         } else {
-            m_users.insert(user.id, new TLUser(user));
+            *existsUser = user;
         }
         if (user.self()) {
             if (m_selfUserId && (m_selfUserId != user.id)) {
                 qWarning() << "Got self user with different id.";
             }
             m_selfUserId = user.id;
+            if (m_peerCache) {
+                m_peerCache->setSelfUserId(user.id);
+            }
             emit selfUserAvailable(user.id);
         }
+        if (m_peerCache) {
+            m_peerCache->insertUser(user);
+        }
         int indexOfRequest = m_askedUserIds.indexOf(user.id);
         if (indexOfRequest >= 0) {
             m_askedUserIds.remove(indexOfRequest);
         }
-        if (!existsUser) {
+        if (isNewUser) {
             emit peerAdded(toPublicPeer(user));
-            emit userInfoReceived(user.id);
+            if (m_perItemSignals & PerItemUserSignals) {
+                emit userInfoReceived(user.id);
+            }
+            m_batchedUserIds.append(user.id);
+            scheduleBatchedSignals();
         }
     }
+    schedulePeerCacheSync();
     if (!m_askedInitialUsers.isEmpty()) {
         for (int i = m_askedInitialUsers.count() - 1; i >= 0; --i) {
             const TLInputUser &askedUser = m_askedInitialUsers.at(i);
@@ -1059,7 +1502,12 @@ void CTelegramDispatcher::onUsersReceived(const QVector<TLUser> &users)
 
 void CTelegramDispatcher::onChannelsParticipantsReceived(quint32 channelId, TLVector<TLChannelParticipant> participants)
 {
-    m_channelParticipants.insert(channelId, participants);
+    QVector<quint32> userIds;
+    userIds.reserve(participants.count());
+    for (const TLChannelParticipant &participant : participants) {
+        userIds.append(participant.userId);
+    }
+    m_chatParticipants[channelId].setUserIds(userIds);
     emitChatChanged(channelId);
 }
 
@@ -1073,11 +1521,18 @@ void CTelegramDispatcher::onContactListReceived(const QVector<quint32> &contactL
     if (m_contactIdList != newContactList) {
         m_contactIdList = newContactList;
         emit contactListChanged();
+        schedulePeerCacheSync();
     }
 
     continueInitialization(StepContactList);
 }
 
+void CTelegramDispatcher::onContactListNotModified()
+{
+    qDebug() << Q_FUNC_INFO << "The contact list is up to date";
+    continueInitialization(StepContactList);
+}
+
 void CTelegramDispatcher::onContactListChanged(const QVector<quint32> &added, const QVector<quint32> &removed)
 {
     qDebug() << Q_FUNC_INFO << added << removed;
@@ -1111,6 +1566,7 @@ void CTelegramDispatcher::onContactListChanged(const QVector<quint32> &added, co
     if (m_contactIdList != newContactList) {
         m_contactIdList = newContactList;
         emit contactListChanged();
+        schedulePeerCacheSync();
     }
 }
 
@@ -1155,13 +1611,48 @@ void CTelegramDispatcher::messageActionTimerTimeout()
     }
 }
 
-void CTelegramDispatcher::onMessagesHistoryReceived(const TLMessagesMessages &messages)
+void CTelegramDispatcher::onMessagesHistoryReceived(const TLMessagesMessages &messages, const TLInputPeer &inputPeer, quint32 offsetId, quint32 addOffset, quint32 limit)
 {
+    CMessageHistoryCache::Request request;
+    request.offsetId = offsetId;
+    request.addOffset = addOffset;
+    request.limit = limit;
+    m_historyCache.insertPage(toPublicPeer(inputPeer), request, messages);
+
     foreach (const TLMessage &message, messages.messages) {
         processMessageReceived(message);
     }
 }
 
+void CTelegramDispatcher::onMessagesMessagesReceived(const TLMessagesMessages &messages, quint64 requestId)
+{
+    // The messages are requested only to restore evicted media, so they are not reported as received
+    onUsersReceived(messages.users);
+    onChatsReceived(messages.chats);
+
+    if (!m_requestedMediaMessages.contains(requestId)) {
+        return;
+    }
+    // The request is finished even if the message is deleted (messageEmpty), so it can be requested again
+    const quint64 key = m_requestedMediaMessages.take(requestId);
+    m_requestedMediaKeys.remove(key);
+
+    for (const TLMessage &message : messages.messages) {
+        if (message.tlType != TLValue::Message) {
+            continue;
+        }
+        const Telegram::Peer peer = toPublicPeer(message);
+        if (mediaMessageKey(peer, message.id) != key) {
+            continue;
+        }
+        if (message.media.tlType == TLValue::MessageMediaEmpty) {
+            continue;
+        }
+        addMessageMedia(peer, message);
+        emit messageMediaInfoReceived(peer, message.id);
+    }
+}
+
 void CTelegramDispatcher::onMessagesDialogsReceived(const TLMessagesDialogs &dialogs, quint32 offsetDate, quint32 offsetId, const TLInputPeer &offsetPeer, quint32 limit)
 {
 #ifdef DEVELOPER_BUILD
@@ -1175,19 +1666,34 @@ void CTelegramDispatcher::onMessagesDialogsReceived(const TLMessagesDialogs &dia
     onChatsReceived(dialogs.chats);
     qDebug() << Q_FUNC_INFO << "received dialogs:" << dialogs.dialogs.count();
 
+    // The dates of the last messages are the priorities of the channels catch up
+    QHash<quint32, quint32> channelMessageDates;
+    for (const TLMessage &message : dialogs.messages) {
+        if (message.toId.tlType == TLValue::PeerChannel) {
+            quint32 &date = channelMessageDates[message.toId.channelId];
+            date = qMax(date, message.date);
+        }
+    }
+
+    if (!offsetDate && !offsetId) {
+        m_listedDialogs.clear();
+    }
+
     QVector<Telegram::Peer> newDialogs;
     // Apply dialogs
     for (const TLDialog &dialog : dialogs.dialogs) {
         const Telegram::Peer p = toPublicPeer(dialog.peer);
-        if (m_dialogs.contains(p)) {
+        m_listedDialogs.insert(p);
+        markDialogChanged(p);
+        bool isNewDialog = false;
+        TLDialog &existDialog = m_dialogs.findOrInsert(p, &isNewDialog);
+        if (!isNewDialog) {
             qDebug() << Q_FUNC_INFO << "Update dialog" << p;
-            TLDialog &existDialog = m_dialogs[p];
             if (dialog.tlType == TLValue::DialogChannel) {
                 // update channel from
                 if (existDialog.pts < dialog.pts) {
                     qDebug() << "Dialog pts should be updated from" << existDialog.pts << "to" << dialog.pts;
-                    const TLInputChannel inputChannel = toInputChannel(existDialog);
-                    mainConnection()->updatesGetChannelDifference(inputChannel, TLChannelMessagesFilter(), existDialog.pts, /* limit */ 10000);
+                    m_channelDifferenceScheduler.schedule(p.id, existDialog.pts, channelMessageDates.value(p.id));
                 } else if (existDialog.pts > dialog.pts) {
                     qWarning() << "Stored dialog pts is bigger than the received one. Something is very wrong (" << existDialog.pts << "vs" << dialog.pts << ").";
                 }
@@ -1199,13 +1705,21 @@ void CTelegramDispatcher::onMessagesDialogsReceived(const TLMessagesDialogs &dia
             existDialog = dialog;
         } else {
             qDebug() << Q_FUNC_INFO << "Add dialog" << p;
-            m_dialogs.insert(p, dialog);
+            existDialog = dialog;
             newDialogs.append(p);
+            if (dialog.tlType == TLValue::DialogChannel) {
+                const quint32 restoredPts = m_restoredChannelPts.take(p.id);
+                if (restoredPts && (restoredPts < dialog.pts)) {
+                    m_channelDifferenceScheduler.schedule(p.id, restoredPts, channelMessageDates.value(p.id));
+                }
+            }
         }
     }
+    requestChannelDifferences();
     if (!newDialogs.isEmpty()) {
         emit dialogsChanged(newDialogs, {});
     }
+    schedulePeerCacheSync();
 
     if (dialogs.tlType == TLValue::MessagesDialogsSlice) {
         quint32 lastDate = 0;
@@ -1254,6 +1768,18 @@ void CTelegramDispatcher::onMessagesDialogsReceived(const TLMessagesDialogs &dia
         }
     }
 
+    if ((dialogs.tlType == TLValue::MessagesDialogs) || dialogs.dialogs.isEmpty()) {
+        // The list is complete; the rest are restored from the peer cache, but left (or deleted) since then
+        QVector<Telegram::Peer> removedDialogs;
+        for (const Telegram::Peer &peer : m_dialogs.keys()) {
+            if (!m_listedDialogs.contains(peer)) {
+                removedDialogs.append(peer);
+            }
+        }
+        removeDialogs(removedDialogs);
+    }
+    m_listedDialogs.clear();
+
     if (!(m_initializationState & StepDialogs)) {
         if (!dialogs.messages.isEmpty()) {
             m_maxMessageId = dialogs.messages.last().id;
@@ -1314,7 +1840,21 @@ void CTelegramDispatcher::getInitialDialogs()
 void CTelegramDispatcher::getContacts()
 {
     qDebug() << Q_FUNC_INFO;
-    mainConnection()->contactsGetContacts(QString()); // Empty hash argument for now.
+
+    // The hash is MD5 of the sorted contact ids separated by commas.
+    // If it matches the server side list, the contacts (restored from the peer cache) are not sent again.
+    QString hash;
+    if (!m_contactIdList.isEmpty()) {
+        QByteArray ids;
+        for (quint32 id : m_contactIdList) {
+            if (!ids.isEmpty()) {
+                ids.append(',');
+            }
+            ids.append(QByteArray::number(id));
+        }
+        hash = QString::fromLatin1(QCryptographicHash::hash(ids, QCryptographicHash::Md5).toHex());
+    }
+    mainConnection()->contactsGetContacts(hash);
 }
 
 void CTelegramDispatcher::getUpdatesState()
@@ -1338,54 +1878,138 @@ void CTelegramDispatcher::getDifference()
         qWarning() << "Unexpected getDifference() call!";
         return;
     }
-    mainConnection()->updatesGetDifference(m_updatesState.pts, m_updatesState.date, m_updatesState.qts);
+    if (m_differenceRequested || !m_pendingDifferences.isEmpty()) {
+        // The state is checked again once the pending differences are processed
+        return;
+    }
+    requestDifference(m_updatesState);
+}
+
+void CTelegramDispatcher::requestDifference(const TLUpdatesState &state)
+{
+    m_differenceRequested = true;
+    m_requestedDifferencePts = state.pts;
+    mainConnection()->updatesGetDifference(state.pts, state.date, state.qts);
 }
 
 void CTelegramDispatcher::onUpdatesDifferenceReceived(const TLUpdatesDifference &updatesDifference)
 {
+    m_differenceRequested = false;
+
     switch (updatesDifference.tlType) {
     case TLValue::UpdatesDifference:
     case TLValue::UpdatesDifferenceSlice:
         qDebug() << Q_FUNC_INFO << "UpdatesDifference" << updatesDifference.newMessages.count();
-        foreach (const TLChat &chat, updatesDifference.chats) {
-            updateChat(chat);
+        if (!m_catchUpTime.isValid()) {
+            m_catchUpTime.start();
+            m_catchUpProcessedMessages = 0;
+        }
+        m_pendingDifferences.enqueue(updatesDifference);
+
+        if (updatesDifference.tlType == TLValue::UpdatesDifferenceSlice) {
+            // Fetch the next slice while this one is processed.
+            // Looks like updatesDifference.intermediateState is always null nowadays; the next slice is requested
+            // with the committed state after the processing in this case.
+            const TLUpdatesState &nextState = updatesDifference.intermediateState;
+            if ((nextState.pts > m_requestedDifferencePts) && (m_pendingDifferences.count() < s_maxPendingDifferences)) {
+                requestDifference(nextState);
+            }
         }
+        if (!m_differenceProcessingTimer->isActive()) {
+            m_differenceProcessingTimer->start();
+        }
+        break;
+    case TLValue::UpdatesDifferenceEmpty:
+        qDebug() << Q_FUNC_INFO << "UpdatesDifferenceEmpty";
 
-        foreach (const TLMessage &message, updatesDifference.newMessages) {
+        // Try to update actual and local state in this weird case.
+        QTimer::singleShot(10, this, SLOT(getUpdatesState()));
+        break;
+    default:
+        qDebug() << Q_FUNC_INFO << "unknown diff type:" << updatesDifference.tlType;
+        if (m_pendingDifferences.isEmpty()) {
+            checkStateAndCallGetDifference();
+        }
+        break;
+    }
+}
+
+void CTelegramDispatcher::processPendingDifferences()
+{
+    // Process up to s_differenceChunkSize messages and updates, then yield to the event loop
+    int budget = s_differenceChunkSize;
+    while (!m_pendingDifferences.isEmpty() && (budget > 0)) {
+        const TLUpdatesDifference &difference = m_pendingDifferences.head();
+        if (m_pendingDifferenceMessageIndex < 0) {
+            foreach (const TLChat &chat, difference.chats) {
+                updateChat(chat);
+            }
+            m_pendingDifferenceMessageIndex = 0;
+        }
+
+        while ((m_pendingDifferenceMessageIndex < difference.newMessages.count()) && (budget > 0)) {
+            const TLMessage &message = difference.newMessages.at(m_pendingDifferenceMessageIndex);
+            ++m_pendingDifferenceMessageIndex;
+            ++m_catchUpProcessedMessages;
+            --budget;
+            m_historyCache.addNewMessage(toPublicPeer(message), message);
             if ((message.tlType != TLValue::MessageService) && (filterReceivedMessage(getPublicMessageFlags(message.flags)))) {
                 continue;
             }
 
             processMessageReceived(message);
         }
-        if (updatesDifference.tlType == TLValue::UpdatesDifference) {
-            setUpdateState(updatesDifference.state.pts, updatesDifference.state.seq, updatesDifference.state.date);
-        } else { // UpdatesDifferenceSlice
-            // Looks like updatesDifference.intermediateState is always null nowadays.
-            setUpdateState(updatesDifference.intermediateState.pts, updatesDifference.intermediateState.seq, updatesDifference.intermediateState.date);
+        if (m_pendingDifferenceMessageIndex < difference.newMessages.count()) {
+            break;
         }
 
-        foreach (const TLUpdate &update, updatesDifference.otherUpdates) {
-            processUpdate(update);
+        if (m_pendingDifferenceUpdateIndex == 0) {
+            if (difference.tlType == TLValue::UpdatesDifference) {
+                setUpdateState(difference.state.pts, difference.state.seq, difference.state.date);
+            } else { // UpdatesDifferenceSlice
+                setUpdateState(difference.intermediateState.pts, difference.intermediateState.seq, difference.intermediateState.date);
+            }
         }
 
-        break;
-    case TLValue::UpdatesDifferenceEmpty:
-        qDebug() << Q_FUNC_INFO << "UpdatesDifferenceEmpty";
+        while ((m_pendingDifferenceUpdateIndex < difference.otherUpdates.count()) && (budget > 0)) {
+            processUpdate(difference.otherUpdates.at(m_pendingDifferenceUpdateIndex));
+            ++m_pendingDifferenceUpdateIndex;
+            --budget;
+        }
+        if (m_pendingDifferenceUpdateIndex < difference.otherUpdates.count()) {
+            break;
+        }
 
-        // Try to update actual and local state in this weird case.
-        QTimer::singleShot(10, this, SLOT(getUpdatesState()));
+        m_pendingDifferences.dequeue();
+        m_pendingDifferenceMessageIndex = -1;
+        m_pendingDifferenceUpdateIndex = 0;
+    }
+
+    if (!m_pendingDifferences.isEmpty()) {
+        emitCatchUpProgress();
+        m_differenceProcessingTimer->start();
         return;
-        break;
-    default:
-        qDebug() << Q_FUNC_INFO << "unknown diff type:" << updatesDifference.tlType;
-        break;
     }
 
-    checkStateAndCallGetDifference();
+    if (!m_differenceRequested) {
+        checkStateAndCallGetDifference();
+    } else {
+        emitCatchUpProgress();
+    }
 }
 
-void CTelegramDispatcher::onUpdatesChannelDifferenceReceived(const TLUpdatesChannelDifference &updatesDifference)
+void CTelegramDispatcher::emitCatchUpProgress()
+{
+    if (!m_catchUpTime.isValid()) {
+        return;
+    }
+    const quint32 remainingPts = m_actualState.pts > m_updatesState.pts ? m_actualState.pts - m_updatesState.pts : 0;
+    const qint64 elapsed = qMax<qint64>(m_catchUpTime.elapsed(), 1);
+    const quint32 messagesPerSecond = quint32(m_catchUpProcessedMessages * 1000ll / elapsed);
+    emit updatesCatchUpProgress(remainingPts, m_catchUpProcessedMessages, messagesPerSecond);
+}
+
+void CTelegramDispatcher::onUpdatesChannelDifferenceReceived(quint32 channelId, const TLUpdatesChannelDifference &updatesDifference)
 {
 #ifdef DEVELOPER_BUILD
     qDebug() << Q_FUNC_INFO << updatesDifference;
@@ -1399,6 +2023,7 @@ void CTelegramDispatcher::onUpdatesChannelDifferenceReceived(const TLUpdatesChan
         }
 
         foreach (const TLMessage &message, updatesDifference.newMessages) {
+            m_historyCache.addNewMessage(toPublicPeer(message), message);
             if ((message.tlType != TLValue::MessageService) && (filterReceivedMessage(getPublicMessageFlags(message.flags)))) {
                 continue;
             }
@@ -1419,6 +2044,7 @@ void CTelegramDispatcher::onUpdatesChannelDifferenceReceived(const TLUpdatesChan
         break;
     case TLValue::UpdatesChannelDifferenceTooLong:
         qDebug() << Q_FUNC_INFO << "UpdatesChannelDifferenceTooLong" << "not implemented yet";
+        m_historyCache.clear(Telegram::Peer::fromChannelId(channelId));
         break;
     case TLValue::UpdatesChannelDifferenceEmpty:
         qDebug() << Q_FUNC_INFO << "UpdatesChannelDifferenceEmpty" << "(NOP, but may be we need to do something?)";
@@ -1427,6 +2053,79 @@ void CTelegramDispatcher::onUpdatesChannelDifferenceReceived(const TLUpdatesChan
         qDebug() << Q_FUNC_INFO << "unknown diff type:" << updatesDifference.tlType;
         break;
     }
+
+    if (updatesDifference.tlType != TLValue::UpdatesChannelDifferenceTooLong) {
+        TLDialog *dialog = m_dialogs.find(Telegram::Peer::fromChannelId(channelId));
+        if (dialog && (dialog->pts < updatesDifference.pts)) {
+            dialog->pts = updatesDifference.pts;
+            markDialogChanged(Telegram::Peer::fromChannelId(channelId));
+        }
+    }
+
+    if ((updatesDifference.tlType == TLValue::UpdatesChannelDifference) && !updatesDifference.final()) {
+        m_channelDifferenceScheduler.resume(channelId, updatesDifference.pts);
+    } else {
+        m_channelDifferenceScheduler.finish(channelId);
+    }
+    removeChannelDifferenceRequest(channelId);
+    requestChannelDifferences();
+}
+
+void CTelegramDispatcher::onUpdatesChannelDifferenceFailed(quint32 channelId, quint32 errorCode, const QString &errorMessage)
+{
+    removeChannelDifferenceRequest(channelId);
+    static const QString floodWaitPrefix = QStringLiteral("FLOOD_WAIT_");
+    if ((errorCode == 420) && errorMessage.startsWith(floodWaitPrefix)) {
+        bool ok = false;
+        const int seconds = errorMessage.mid(floodWaitPrefix.length()).toInt(&ok);
+        if (ok) {
+            qDebug() << Q_FUNC_INFO << "Channel difference requests are paused for" << seconds << "seconds";
+            m_channelDifferenceScheduler.floodWait(channelId, seconds, QDateTime::currentMSecsSinceEpoch());
+            requestChannelDifferences();
+            return;
+        }
+    }
+
+    qWarning() << Q_FUNC_INFO << "Unable to get the difference of channel" << channelId << errorCode << errorMessage;
+    m_channelDifferenceScheduler.finish(channelId);
+    requestChannelDifferences();
+}
+
+void CTelegramDispatcher::removeChannelDifferenceRequest(quint32 channelId)
+{
+    for (auto it = m_channelDifferenceRequests.begin(); it != m_channelDifferenceRequests.end(); ) {
+        if (it.value() == channelId) {
+            it = m_channelDifferenceRequests.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void CTelegramDispatcher::requestChannelDifferences()
+{
+    if (!mainConnection() || (mainConnection()->status() < CTelegramConnection::ConnectionStatusConnected)) {
+        return;
+    }
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    quint32 channelId = 0;
+    quint32 pts = 0;
+    while (m_channelDifferenceScheduler.takeNext(now, &channelId, &pts)) {
+        const TLChat *chat = m_chatInfo.value(channelId);
+        if (!chat) {
+            qWarning() << Q_FUNC_INFO << "Unknown channel" << channelId;
+            m_channelDifferenceScheduler.finish(channelId);
+            continue;
+        }
+        const quint64 requestId = mainConnection()->updatesGetChannelDifference(toInputChannel(chat), TLChannelMessagesFilter(), pts, s_channelDifferenceLimit);
+        m_channelDifferenceRequests.insert(requestId, channelId);
+    }
+
+    const qint64 nextRequestTime = m_channelDifferenceScheduler.nextRequestTime(now);
+    if (nextRequestTime > now) {
+        m_channelDifferenceTimer->start(int(qMin<qint64>(nextRequestTime - now, std::numeric_limits<int>::max())));
+    }
 }
 
 void CTelegramDispatcher::onChatsReceived(const QVector<TLChat> &chats)
@@ -1478,6 +2177,7 @@ void CTelegramDispatcher::processUpdate(const TLUpdate &update)
 #ifdef DEVELOPER_BUILD
     qDebug() << Q_FUNC_INFO << update;
 #endif
+    schedulePeerCacheSync();
 
     switch (update.tlType) {
     case TLValue::UpdateNewMessage:
@@ -1507,18 +2207,29 @@ void CTelegramDispatcher::processUpdate(const TLUpdate &update)
     {
         qDebug() << Q_FUNC_INFO << "UpdateNewMessage";
         const Telegram::Peer peer = toPublicPeer(update.message.toId);
-        if (m_dialogs.contains(peer)) {
-            const TLDialog &dialog = m_dialogs.value(peer);
-            if (update.message.id <= dialog.topMessage) {
-                break;
-            }
+        const TLDialog *dialog = m_dialogs.find(peer);
+        if (dialog && (update.message.id <= dialog->topMessage)) {
+            break;
         }
+        m_historyCache.addNewMessage(toPublicPeer(update.message), update.message);
         processMessageReceived(update.message);
     }
         break;
     case TLValue::UpdateMessageID:
         updateSentMessageId(update.randomId, update.id);
         break;
+    case TLValue::UpdateDeleteMessages:
+        m_historyCache.removeMessages(update.messages);
+        if (m_searchIndex) {
+            m_searchIndex->removeMessages(update.messages);
+        }
+        break;
+    case TLValue::UpdateDeleteChannelMessages:
+        m_historyCache.removeMessages(Telegram::Peer::fromChannelId(update.channelId), update.messages);
+        if (m_searchIndex) {
+            m_searchIndex->removeMessages(Telegram::Peer::fromChannelId(update.channelId), update.messages);
+        }
+        break;
 //    case TLValue::UpdateReadMessages:
 //        foreach (quint32 messageId, update.messages) {
 //            const QPair<QString, quint64> phoneAndId = m_messagesMap.value(messageId);
@@ -1645,17 +2356,17 @@ void CTelegramDispatcher::processUpdate(const TLUpdate &update)
 //        update.maxDate;
 //        update.date;
 //        break;
-//    case TLValue::UpdateChatParticipantAdd:
-//        update.chatId;
-//        update.userId;
-//        update.inviterId;
-//        update.version;
-//        break;
-//    case TLValue::UpdateChatParticipantDelete:
-//        update.chatId;
-//        update.userId;
-//        update.version;
-//        break;
+    case TLValue::UpdateChatParticipantAdd: {
+        TLChatParticipant participant;
+        participant.userId = update.userId;
+        participant.inviterId = update.inviterId;
+        participant.date = update.date;
+        addChatParticipant(update.chatId, participant);
+        break;
+    }
+    case TLValue::UpdateChatParticipantDelete:
+        removeChatParticipant(update.chatId, update.userId);
+        break;
     case TLValue::UpdateDcOptions: {
         int dcUpdatesReplaced = 0;
         int dcUpdatesInserted = 0;
@@ -1689,8 +2400,9 @@ void CTelegramDispatcher::processUpdate(const TLUpdate &update)
             qDebug() << Q_FUNC_INFO << update.tlType << "Unable to resolve peer" << update.peer.tlType << update.peer.userId << update.peer.chatId;
 #endif
         }
-        if (m_dialogs.contains(peer)) {
-            m_dialogs[peer].readInboxMaxId = update.maxId;
+        if (TLDialog *dialog = m_dialogs.find(peer)) {
+            dialog->readInboxMaxId = update.maxId;
+            markDialogChanged(peer);
         }
         if (update.tlType == TLValue::UpdateReadHistoryInbox) {
             emit messageReadInbox(peer, update.maxId);
@@ -1702,8 +2414,9 @@ void CTelegramDispatcher::processUpdate(const TLUpdate &update)
     case TLValue::UpdateReadChannelInbox:
     {
         const Telegram::Peer peer = Telegram::Peer(update.channelId, Telegram::Peer::Channel);
-        if (m_dialogs.contains(peer)) {
-            m_dialogs[peer].readInboxMaxId = update.maxId;
+        if (TLDialog *dialog = m_dialogs.find(peer)) {
+            dialog->readInboxMaxId = update.maxId;
+            markDialogChanged(peer);
         }
         emit messageReadInbox(peer, update.maxId);
     }
@@ -1725,8 +2438,9 @@ void CTelegramDispatcher::processUpdate(const TLUpdate &update)
     case TLValue::UpdateNewChannelMessage:
     {
         const Telegram::Peer peer = toPublicPeer(update.message.toId);
-        if (m_dialogs.contains(peer)) {
-            m_dialogs[peer].pts = update.pts;
+        if (TLDialog *dialog = m_dialogs.find(peer)) {
+            dialog->pts = update.pts;
+            markDialogChanged(peer);
         }
     }
         break;
@@ -1734,8 +2448,9 @@ void CTelegramDispatcher::processUpdate(const TLUpdate &update)
     {
         const Telegram::Peer peer = Telegram::Peer(update.channelId, Telegram::Peer::Channel);
         qDebug() << Q_FUNC_INFO << "DeleteChannelMessages is not implemented yet" << update.channelId << update.messages << update.pts << update.ptsCount;
-        if (m_dialogs.contains(peer)) {
-            m_dialogs[peer].pts = update.pts;
+        if (TLDialog *dialog = m_dialogs.find(peer)) {
+            dialog->pts = update.pts;
+            markDialogChanged(peer);
         }
     }
         break;
@@ -1758,18 +2473,18 @@ void CTelegramDispatcher::internalProcessMessageReceived(const TLMessage &messag
     if (message.tlType == TLValue::MessageEmpty) {
         return;
     }
+    schedulePeerCacheSync();
 
     if (message.tlType == TLValue::MessageService) {
         const TLMessageAction &action = message.action;
         const quint32 chatId = message.toId.chatId;
-        if (!m_chatInfo.contains(chatId)) {
-            m_chatInfo.insert(chatId, new TLChat());
+        TLChat *&chatSlot = m_chatInfo.findOrInsert(chatId);
+        if (!chatSlot) {
+            chatSlot = new TLChat();
         }
-        TLChat *chat = m_chatInfo.value(chatId);
-        TLChatFull fullChat = m_chatFullInfo.value(chatId);
+        TLChat *chat = chatSlot;
 
         chat->id = chatId;
-        fullChat.id = chatId;
         switch (action.tlType) {
         case TLValue::MessageActionChatCreate:
             chat->title = action.title;
@@ -1777,46 +2492,28 @@ void CTelegramDispatcher::internalProcessMessageReceived(const TLMessage &messag
             emitChatChanged(chatId);
             break;
         case TLValue::MessageActionChatAddUser: {
-            TLVector<TLChatParticipant> participants = fullChat.participants.participants;
-            for (int i = 0; i < participants.count(); ++i) {
-                if (participants.at(i).userId == action.userId) {
-                    return;
-                }
-            }
-
             TLChatParticipant newParticipant;
             newParticipant.userId = action.userId;
-            participants.append(newParticipant);
-
-            fullChat.participants.participants = participants;
-            chat->participantsCount = participants.count();
-            emitChatChanged(chatId);
-            updateFullChat(fullChat);
+            newParticipant.inviterId = message.fromId;
+            newParticipant.date = message.date;
+            addChatParticipant(chatId, newParticipant);
             }
             break;
-        case TLValue::MessageActionChatDeleteUser: {
-            TLVector<TLChatParticipant> participants = fullChat.participants.participants;
-            for (int i = 0; i < participants.count(); ++i) {
-                if (participants.at(i).userId == action.userId) {
-                    participants.remove(i);
-                    break;
-                }
-            }
-
-            fullChat.participants.participants = participants;
-            chat->participantsCount = participants.count();
-            emitChatChanged(chatId);
-            updateFullChat(fullChat);
-            }
+        case TLValue::MessageActionChatDeleteUser:
+            removeChatParticipant(chatId, action.userId);
             break;
         case TLValue::MessageActionChatEditTitle:
             chat->title = action.title;
             emitChatChanged(chatId);
             break;
         case TLValue::MessageActionChatEditPhoto:
-        case TLValue::MessageActionChatDeletePhoto:
+        case TLValue::MessageActionChatDeletePhoto: {
+            TLChatFull &fullChat = m_chatFullInfo[chatId];
+            fullChat.id = chatId; // The full chat can be newly created
             fullChat.chatPhoto = action.photo;
-            updateFullChat(fullChat);
+            m_changedFullChats.insert(chatId);
+            emitChatChanged(chatId);
+            }
             break;
         default:
             qWarning() << Q_FUNC_INFO << "Unimplemented service message type" << action.tlType.toString();
@@ -1844,15 +2541,7 @@ void CTelegramDispatcher::internalProcessMessageReceived(const TLMessage &messag
         apiMessage.replyToMessageId = message.replyToMsgId;
     }
 
-    Telegram::Peer peer;
-    if ((message.toId.tlType != TLValue::PeerUser) || (messageFlags & TelegramNamespace::MessageFlagOut)) {
-        // To a group chat or an outgoing message
-        peer = toPublicPeer(message.toId);
-    } else {
-        // Personal chat from someone
-        peer = Telegram::Peer(message.fromId, Telegram::Peer::User);
-    }
-
+    const Telegram::Peer peer = toPublicPeer(message);
     if (!peer.isValid()) {
         qWarning() << Q_FUNC_INFO << "Unknown peer type!";
         return;
@@ -1872,66 +2561,224 @@ void CTelegramDispatcher::internalProcessMessageReceived(const TLMessage &messag
     }
 
     if (message.media.tlType != TLValue::MessageMediaEmpty) {
-        QHash<quint32, TLMessage*> *peerHash = nullptr;
-        if (peer.type == Telegram::Peer::Channel) {
-            if (!m_channelMediaMessages.contains(peer.id)) {
-                m_channelMediaMessages.insert(peer.id, new QHash<quint32, TLMessage*>());
-            }
-            peerHash = m_channelMediaMessages.value(peer.id);
-        } else {
-            peerHash = &m_knownMediaMessages;
-        }
-        if (!peerHash) { // Should never happen, right?
-            qWarning() << Q_FUNC_INFO << "Something went wrong. Unable to process media message, memory leak is very possible";
-            return;
-        }
-        peerHash->insert(message.id, new TLMessage(message));
+        addMessageMedia(peer, message);
+    }
+
+    if (m_searchIndex) {
+        m_searchIndex->addMessage(apiMessage);
     }
 
-    emit messageReceived(apiMessage);
+    if (m_perItemSignals & PerItemMessageSignals) {
+        emit messageReceived(apiMessage);
+    }
+    m_batchedMessages.append(apiMessage);
+    scheduleBatchedSignals();
 }
 
-void CTelegramDispatcher::emitChatChanged(quint32 id)
+void CTelegramDispatcher::addMessageMedia(const Telegram::Peer &peer, const TLMessage &message)
+{
+    TLMessageMedia *media = new TLMessageMedia(compactMessageMedia(message.media));
+
+    // Rough estimation of the used memory, which is enough to keep the cache within its budget
+    int cost = sizeof(TLMessageMedia);
+    cost += (media->caption.size() + media->phoneNumber.size() + media->firstName.size() + media->lastName.size()
+             + media->title.size() + media->address.size() + media->provider.size() + media->venueId.size()) * sizeof(QChar);
+    cost += media->photo.sizes.count() * sizeof(TLPhotoSize);
+    for (const TLPhotoSize &size : media->photo.sizes) {
+        cost += size.bytes.size();
+    }
+    cost += media->video.thumb.bytes.size() + media->document.thumb.bytes.size();
+    cost += media->document.attributes.count() * sizeof(TLDocumentAttribute);
+    cost += (media->webpage.url.size() + media->webpage.displayUrl.size() + media->webpage.siteName.size()
+             + media->webpage.title.size() + media->webpage.description.size()) * sizeof(QChar);
+
+    m_mediaMessages.insert(mediaMessageKey(peer, message.id), media, cost);
+}
+
+TLMessageMedia CTelegramDispatcher::compactMessageMedia(const TLMessageMedia &media)
+{
+    // Keep the photo sizes and the thumbnails, but only the text of the web page (not its photo and document)
+    TLMessageMedia result = media;
+
+    TLWebPage webpage;
+    webpage.tlType = media.webpage.tlType;
+    webpage.id = media.webpage.id;
+    webpage.url = media.webpage.url;
+    webpage.displayUrl = media.webpage.displayUrl;
+    webpage.siteName = media.webpage.siteName;
+    webpage.title = media.webpage.title;
+    webpage.description = media.webpage.description;
+    result.webpage = webpage;
+    return result;
+}
+
+quint64 CTelegramDispatcher::mediaMessageKey(const Telegram::Peer &peer, quint32 messageId)
 {
-    if (!m_chatIds.contains(id)) {
-        m_chatIds.append(id);
+    // Ids of the user and chat messages are unique per account, the channels have their own id sequences
+    const quint64 channelId = peer.type == Telegram::Peer::Channel ? peer.id : 0;
+    return (channelId << 32) | messageId;
+}
 
+void CTelegramDispatcher::emitChatChanged(quint32 id)
+{
+    if (m_chatIds.insert(id)) {
         if (m_updateRequestId) {
             qDebug() << Q_FUNC_INFO << "Chat change is result of creation request:" << m_updateRequestId << id;
             emit createdChatIdReceived(m_updateRequestId, id);
         }
 
-        if (m_chatInfo.contains(id)) {
-            const TLChat *chat = m_chatInfo.value(id);
+        if (const TLChat *chat = m_chatInfo.value(id)) {
             emit peerAdded(toPublicPeer(chat));
         }
-        emit chatAdded(id);
-    } else {
+        if (m_perItemSignals & PerItemChatSignals) {
+            emit chatAdded(id);
+        }
+    } else if (m_perItemSignals & PerItemChatSignals) {
         emit chatChanged(id);
     }
+    if (!m_batchedChatIdsSet.contains(id)) {
+        m_batchedChatIdsSet.insert(id);
+        m_batchedChatIds.append(id);
+        scheduleBatchedSignals();
+    }
 }
 
 void CTelegramDispatcher::updateChat(const TLChat &newChat)
 {
-    if (!m_chatInfo.contains(newChat.id)) {
-        TLChat *newChatInstance = new TLChat(newChat);
-        m_chatInfo.insert(newChat.id, newChatInstance);
+    if (m_peerCache) {
+        if (isRemovedChat(newChat)) {
+            // The dialog itself is removed on the next complete dialogs listing
+            m_peerCache->removeChat(newChat.id);
+            m_peerCache->removeFullChat(newChat.id);
+            m_changedFullChats.remove(newChat.id);
+        } else {
+            m_peerCache->insertChat(newChat);
+        }
+        schedulePeerCacheSync();
+    }
+    bool isNewChat = false;
+    TLChat *&chat = m_chatInfo.findOrInsert(newChat.id, &isNewChat);
+    if (isNewChat) {
+        chat = new TLChat(newChat);
     } else {
-        *m_chatInfo[newChat.id] = newChat;
+        *chat = newChat;
     }
     emitChatChanged(newChat.id);
 }
 
+bool CTelegramDispatcher::isRemovedChat(const TLChat &chat)
+{
+    // Not left(): it is set on every public channel the user is not a member of
+    switch (chat.tlType) {
+    case TLValue::ChatForbidden:
+    case TLValue::ChannelForbidden:
+        return true;
+    case TLValue::Chat:
+        return chat.kicked() || chat.deactivated();
+    case TLValue::Channel:
+        return chat.kicked();
+    default:
+        return false;
+    }
+}
+
+void CTelegramDispatcher::markDialogChanged(const Telegram::Peer &peer)
+{
+    if (m_peerCache) {
+        m_changedDialogs.insert(peer);
+        schedulePeerCacheSync();
+    }
+}
+
+void CTelegramDispatcher::removeDialogs(const QVector<Telegram::Peer> &peers)
+{
+    QVector<Telegram::Peer> removedDialogs;
+    for (const Telegram::Peer &peer : peers) {
+        if (!m_dialogs.remove(peer)) {
+            continue;
+        }
+        m_changedDialogs.remove(peer);
+        if (m_peerCache) {
+            m_peerCache->removeDialog(peer);
+        }
+        removedDialogs.append(peer);
+    }
+    if (removedDialogs.isEmpty()) {
+        return;
+    }
+    schedulePeerCacheSync();
+    emit dialogsChanged({}, removedDialogs);
+}
+
 void CTelegramDispatcher::updateFullChat(const TLChatFull &newChat)
 {
-    if (!m_chatFullInfo.contains(newChat.id)) {
-        m_chatFullInfo.insert(newChat.id, newChat);
-    } else {
-        m_chatFullInfo[newChat.id] = newChat;
+    if (m_peerCache) {
+        m_peerCache->insertFullChat(newChat);
+        schedulePeerCacheSync();
+    }
+    m_chatFullInfo.insert(newChat.id, newChat);
+    if (newChat.tlType == TLValue::ChatFull) {
+        // The channel participants are requested separately (see onChannelsParticipantsReceived())
+        QVector<quint32> userIds;
+        userIds.reserve(newChat.participants.participants.count());
+        for (const TLChatParticipant &participant : newChat.participants.participants) {
+            userIds.append(participant.userId);
+        }
+        m_chatParticipants[newChat.id].setUserIds(userIds);
+        m_changedFullChats.remove(newChat.id);
     }
     emitChatChanged(newChat.id);
 }
 
+bool CTelegramDispatcher::addChatParticipant(quint32 chatId, const TLChatParticipant &participant)
+{
+    CChatParticipants &chatParticipants = m_chatParticipants[chatId];
+    if (!chatParticipants.addUserId(participant.userId)) {
+        return false;
+    }
+
+    // The full chat keeps the participant details
+    TLChatFull &fullChat = m_chatFullInfo[chatId];
+    fullChat.id = chatId; // The full chat can be newly created
+    fullChat.participants.chatId = chatId;
+    fullChat.participants.participants.append(participant);
+    m_changedFullChats.insert(chatId);
+    schedulePeerCacheSync();
+
+    if (TLChat *chat = m_chatInfo.value(chatId)) {
+        chat->participantsCount = chatParticipants.count();
+    }
+    emit chatParticipantAdded(chatId, participant.userId);
+    emitChatChanged(chatId);
+    return true;
+}
+
+bool CTelegramDispatcher::removeChatParticipant(quint32 chatId, quint32 userId)
+{
+    CChatParticipants *chatParticipants = m_chatParticipants.find(chatId);
+    if (!chatParticipants || !chatParticipants->removeUserId(userId)) {
+        return false;
+    }
+    if (TLChatFull *fullChat = m_chatFullInfo.find(chatId)) {
+        TLVector<TLChatParticipant> &participants = fullChat->participants.participants;
+        for (int i = 0; i < participants.count(); ++i) {
+            if (participants.at(i).userId == userId) {
+                participants.remove(i);
+                break;
+            }
+        }
+    }
+    m_changedFullChats.insert(chatId);
+    schedulePeerCacheSync();
+
+    if (TLChat *chat = m_chatInfo.value(chatId)) {
+        chat->participantsCount = chatParticipants->count();
+    }
+    emit chatParticipantRemoved(chatId, userId);
+    emitChatChanged(chatId);
+    return true;
+}
+
 TLInputPeer CTelegramDispatcher::toInputPeer(const Telegram::Peer &peer) const
 {
     TLInputPeer inputPeer;
@@ -1941,10 +2788,10 @@ TLInputPeer CTelegramDispatcher::toInputPeer(const Telegram::Peer &peer) const
         inputPeer.chatId = peer.id;
         break;
     case Telegram::Peer::Channel:
-        if (m_chatInfo.contains(peer.id)) {
+        if (const TLChat *chat = m_chatInfo.value(peer.id)) {
             inputPeer.tlType = TLValue::InputPeerChannel;
             inputPeer.channelId = peer.id;
-            inputPeer.accessHash = m_chatInfo.value(peer.id)->accessHash;
+            inputPeer.accessHash = chat->accessHash;
         } else {
             qWarning() << Q_FUNC_INFO << "Unknown public channel id" << peer.id;
         }
@@ -1953,10 +2800,10 @@ TLInputPeer CTelegramDispatcher::toInputPeer(const Telegram::Peer &peer) const
         if (peer.id == m_selfUserId) {
             inputPeer.tlType = TLValue::InputPeerSelf;
         } else {
-            if (m_users.contains(peer.id)) {
+            if (const TLUser *user = m_users.value(peer.id)) {
                 inputPeer.tlType = TLValue::InputPeerUser;
                 inputPeer.userId = peer.id;
-                inputPeer.accessHash = m_users.value(peer.id)->accessHash;
+                inputPeer.accessHash = user->accessHash;
             } else {
                 qWarning() << Q_FUNC_INFO << "Unknown user" << peer.id;
             }
@@ -2022,6 +2869,16 @@ Telegram::Peer CTelegramDispatcher::toPublicPeer(const TLChat *chat) const
     }
 }
 
+Telegram::Peer CTelegramDispatcher::toPublicPeer(const TLMessage &message) const
+{
+    if ((message.toId.tlType != TLValue::PeerUser) || (message.flags & TelegramMessageFlagOut)) {
+        // To a group chat or an outgoing message
+        return toPublicPeer(message.toId);
+    }
+    // Personal chat from someone
+    return Telegram::Peer(message.fromId, Telegram::Peer::User);
+}
+
 TLPeer CTelegramDispatcher::toTLPeer(const Telegram::Peer &peer) const
 {
     TLPeer result;
@@ -2077,11 +2934,11 @@ TLInputChannel CTelegramDispatcher::toInputChannel(const Telegram::Peer &peer)
         return TLInputChannel();
     }
 
-    if (!m_chatInfo.contains(peer.id)) {
+    const TLChat *chat = m_chatInfo.value(peer.id);
+    if (!chat) {
         qWarning() << Q_FUNC_INFO << "Unknown channel id" << peer.id;
         return TLInputChannel();
     }
-    const TLChat *chat = m_chatInfo.value(peer.id);
     return toInputChannel(chat);
 }
 
@@ -2103,11 +2960,11 @@ TLInputChannel CTelegramDispatcher::toInputChannel(const TLDialog &dialog)
         return TLInputChannel();
     }
 
-    if (!m_chatInfo.contains(dialog.peer.channelId)) {
+    const TLChat *chat = m_chatInfo.value(dialog.peer.channelId);
+    if (!chat) {
         qWarning() << Q_FUNC_INFO << "Unknown channel id" << dialog.peer.channelId;
         return TLInputChannel();
     }
-    const TLChat *chat = m_chatInfo.value(dialog.peer.channelId);
     return toInputChannel(chat);
 }
 
@@ -2130,13 +2987,26 @@ CTelegramConnection *CTelegramDispatcher::getExtraConnection(quint32 dc)
     }
 
     CTelegramConnection *connection = createConnection(dcInfo);
-    if (mainConnection()->dcInfo().id == dc) {
+    // The pool is used only once a permanent key of the dc is known; otherwise the connection runs the DH exchange
+    const QByteArray dcPermanentKey = permanentKey(dc);
+    const CTemporaryKeyPool::Key temporaryKey = dcPermanentKey.isEmpty() ? CTemporaryKeyPool::Key() : m_temporaryKeys.take(dc, serverTime());
+    if (temporaryKey.isValid()) {
+        // A pre-generated key, the connection is signed in once the key is bound to the permanent one
+        connection->setDeltaTime(temporaryKey.deltaTime);
+        connection->setTemporaryKey(temporaryKey.authKey, temporaryKey.serverSalt, temporaryKey.expiresAt, dcPermanentKey);
+    } else if (mainConnection()->dcInfo().id == dc) {
         connection->setDeltaTime(mainConnection()->deltaTime());
         connection->setAuthKey(mainConnection()->authKey());
         connection->setServerSalt(mainConnection()->serverSalt());
+        connection->setServerSalts(mainConnection()->serverSalts());
+    } else if (!dcPermanentKey.isEmpty()) {
+        connection->setAuthKey(dcPermanentKey); // The salt is corrected by the server
     }
 
     m_extraConnections.append(connection);
+    if (!dcPermanentKey.isEmpty()) {
+        requestTemporaryKeys(dc); // Refill the pool for the next connection
+    }
 
 #ifdef DEVELOPER_BUILD
     qDebug() << Q_FUNC_INFO << dc << connection;
@@ -2154,18 +3024,41 @@ void CTelegramDispatcher::onConnectionAuthChanged(int newStateInt, quint32 dc)
         return;
     }
 
+    const quint32 generatorDc = m_temporaryKeyGenerators.key(connection, 0);
+    if (generatorDc) {
+        // The connection serves only to generate a temporary key
+        if (newState == CTelegramConnection::AuthStateHaveAKey) {
+            CTemporaryKeyPool::Key key;
+            key.authKey = connection->authKey();
+            key.serverSalt = connection->serverSalt();
+            key.expiresAt = connection->authKeyExpiresAt();
+            key.deltaTime = connection->deltaTime();
+            m_temporaryKeys.add(generatorDc, key);
+
+            m_temporaryKeyGenerators.remove(generatorDc);
+            disconnect(connection, nullptr, this, nullptr);
+            clearConnection(connection);
+            requestTemporaryKeys(generatorDc);
+        }
+        return;
+    }
+
     qDebug() << Q_FUNC_INFO << "Delayed packages:" << m_delayedPackages.keys() << m_delayedPackages.count();
 
     if (connection == mainConnection()) {
         if (newState == CTelegramConnection::AuthStateSignedIn) {
             connect(connection, &CTelegramConnection::contactListReceived,
                     this, &CTelegramDispatcher::onContactListReceived);
+            connect(connection, &CTelegramConnection::contactListNotModified,
+                    this, &CTelegramDispatcher::onContactListNotModified);
             connect(connection, &CTelegramConnection::contactListChanged,
                     this, &CTelegramDispatcher::onContactListChanged);
             connect(connection, &CTelegramConnection::updatesReceived,
                     this, &CTelegramDispatcher::onUpdatesReceived);
             connect(connection, &CTelegramConnection::messagesHistoryReceived,
                     this, &CTelegramDispatcher::onMessagesHistoryReceived);
+            connect(connection, &CTelegramConnection::messagesMessagesReceived,
+                    this, &CTelegramDispatcher::onMessagesMessagesReceived);
             connect(connection, &CTelegramConnection::messagesDialogsReceived,
                     this, &CTelegramDispatcher::onMessagesDialogsReceived);
             connect(connection, &CTelegramConnection::messagesAffectedMessagesReceived,
@@ -2176,6 +3069,8 @@ void CTelegramDispatcher::onConnectionAuthChanged(int newStateInt, quint32 dc)
                     this, &CTelegramDispatcher::onUpdatesDifferenceReceived);
             connect(connection, &CTelegramConnection::updatesChannelDifferenceReceived,
                     this, &CTelegramDispatcher::onUpdatesChannelDifferenceReceived);
+            connect(connection, &CTelegramConnection::updatesChannelDifferenceFailed,
+                    this, &CTelegramDispatcher::onUpdatesChannelDifferenceFailed);
             connect(connection, &CTelegramConnection::authExportedAuthorizationReceived,
                     this, &CTelegramDispatcher::onAuthExportedAuthorizationReceived);
             connect(connection, &CTelegramConnection::messagesChatsReceived,
@@ -2191,11 +3086,17 @@ void CTelegramDispatcher::onConnectionAuthChanged(int newStateInt, quint32 dc)
             continueInitialization(StepHasKey);
         } else if (newState == CTelegramConnection::AuthStateSignedIn) {
             continueInitialization(StepSignIn);
+            m_temporaryKeysTimer->start();
+            requestTemporaryKeys(dc);
         }
     } else {
         if (newState == CTelegramConnection::AuthStateHaveAKey) {
             qDebug() << Q_FUNC_INFO << "ensureSignedConnection" << connection;
             ensureSignedConnection(connection);
+        } else if ((newState == CTelegramConnection::AuthStateSignedIn) && !connection->authKeyExpiresAt()) {
+            // Keep the permanent key of the dc to bind the temporary keys of the next connections to
+            m_permanentKeys.insert(dc, connection->authKey());
+            requestTemporaryKeys(dc);
         }
     }
 
@@ -2214,6 +3115,43 @@ void CTelegramDispatcher::onConnectionAuthChanged(int newStateInt, quint32 dc)
     }
 }
 
+void CTelegramDispatcher::onConnectionRequestFailed(quint64 requestId, TLValue method, TelegramNamespace::RequestFailureReason reason)
+{
+    qWarning() << Q_FUNC_INFO << requestId << method << reason;
+
+    // Let the media be requested again
+    if (m_requestedMediaMessages.contains(requestId)) {
+        m_requestedMediaKeys.remove(m_requestedMediaMessages.take(requestId));
+    }
+
+    if (sender() == mainConnection()) {
+        switch (method) {
+        case TLValue::UpdatesGetState:
+            m_updatesStateIsLocked = false;
+            break;
+        case TLValue::UpdatesGetDifference:
+            // The difference is requested again on the next state check
+            m_differenceRequested = false;
+            break;
+        case TLValue::UpdatesGetChannelDifference: {
+            // Release the slot and request the channel again later
+            const quint32 channelId = m_channelDifferenceRequests.take(requestId);
+            if (channelId && m_channelDifferenceScheduler.isActive(channelId)) {
+                if (!m_channelDifferenceScheduler.retry(channelId, QDateTime::currentMSecsSinceEpoch())) {
+                    qWarning() << Q_FUNC_INFO << "Unable to get the difference of channel" << channelId << "(no answer)";
+                }
+                requestChannelDifferences();
+            }
+        }
+            break;
+        default:
+            break;
+        }
+    }
+
+    emit requestFailed(requestId, method.toString(), reason);
+}
+
 void CTelegramDispatcher::onConnectionStatusChanged(int newStatusInt, int reasonInt, quint32 dc)
 {
     const CTelegramConnection::ConnectionStatus newStatus = static_cast<CTelegramConnection::ConnectionStatus>(newStatusInt);
@@ -2226,6 +3164,34 @@ void CTelegramDispatcher::onConnectionStatusChanged(int newStatusInt, int reason
         return;
     }
 
+    const quint32 generatorDc = m_temporaryKeyGenerators.key(connection, 0);
+    if (generatorDc) {
+        if (newStatus == CTelegramConnection::ConnectionStatusDisconnected) {
+            // The key is generated again on the next check
+            qDebug() << Q_FUNC_INFO << "Temporary key generation failed for dc" << generatorDc;
+            m_temporaryKeyGenerators.remove(generatorDc);
+            disconnect(connection, nullptr, this, nullptr);
+            connection->deleteLater();
+        }
+        return;
+    }
+
+    if ((newStatus == CTelegramConnection::ConnectionStatusConnected) && connection->transport()) {
+        m_addressLatencies.addSample(connection->transport()->remoteAddress(), connection->transport()->connectTime());
+    }
+
+    if (connection == mainConnection()) {
+        if ((newStatus == CTelegramConnection::ConnectionStatusDisconnected)
+                && ((reason == CTelegramConnection::ConnectionStatusReasonRemote) || (reason == CTelegramConnection::ConnectionStatusReasonTimeout))
+                && resumeMainConnection()) {
+            return;
+        }
+        if ((newStatus == CTelegramConnection::ConnectionStatusConnected)
+                && (m_resumedConnectionState != TelegramNamespace::ConnectionStateDisconnected)) {
+            onMainConnectionResumed();
+        }
+    }
+
     if (newStatus == CTelegramConnection::ConnectionStatusDisconnected) {
         switch (reason) {
         case CTelegramConnection::ConnectionStatusReasonLocal:
@@ -2361,6 +3327,72 @@ void CTelegramDispatcher::onMainConnectionRetryTimerTriggered()
     connectToServer();
 }
 
+bool CTelegramDispatcher::resumeMainConnection()
+{
+    // A network blip should not cost the whole initialization, so the main connection is reopened with the same
+    // auth key, server salt and session id. The requests in flight are sent again (see CTelegramConnection::reconnectToDc()).
+    if (mainConnection()->authState() < CTelegramConnection::AuthStateHaveAKey) {
+        return false;
+    }
+
+    if (m_resumedConnectionState == TelegramNamespace::ConnectionStateDisconnected) {
+        if (connectionState() < TelegramNamespace::ConnectionStateConnected) {
+            return false;
+        }
+        m_resumedConnectionState = connectionState();
+        m_mainConnectionResumeAttempts = 0;
+        setConnectionState(TelegramNamespace::ConnectionStateConnecting);
+    } else if (m_mainConnectionResumeAttempts >= s_resumeConnectionMaxAttempts) {
+        // The connection is dropped by onConnectionFailed(), its pending requests are failed in clearConnection()
+        qWarning() << Q_FUNC_INFO << "Unable to resume the session, connect from scratch";
+        m_resumedConnectionState = TelegramNamespace::ConnectionStateDisconnected;
+        setConnectionState(TelegramNamespace::ConnectionStateDisconnected);
+        return false;
+    }
+
+    int delay = 0;
+    if (m_mainConnectionResumeAttempts) {
+        // Half of the delay is random, so the clients disconnected at once do not come back at once
+        const int maxDelay = qMin(s_resumeConnectionBaseDelay << (m_mainConnectionResumeAttempts - 1), s_resumeConnectionMaxDelay);
+        quint32 random = 0;
+        Utils::randomBytes(&random);
+        delay = maxDelay / 2 + int(random % quint32(maxDelay / 2 + 1));
+    }
+    ++m_mainConnectionResumeAttempts;
+
+    qDebug() << Q_FUNC_INFO << "attempt" << m_mainConnectionResumeAttempts << "in" << delay << "ms";
+    m_resumeMainConnectionTimer->start(delay);
+    return true;
+}
+
+void CTelegramDispatcher::onConnectionAttemptFailed(const Telegram::DcOption &address)
+{
+    qDebug() << Q_FUNC_INFO << address.address << address.port;
+    m_addressLatencies.addFailure(address);
+}
+
+void CTelegramDispatcher::onMainConnectionResumeTimerTriggered()
+{
+    if (!mainConnection() || (m_resumedConnectionState == TelegramNamespace::ConnectionStateDisconnected)) {
+        return;
+    }
+    mainConnection()->reconnectToDc();
+}
+
+void CTelegramDispatcher::onMainConnectionResumed()
+{
+    qDebug() << Q_FUNC_INFO << "after" << m_mainConnectionResumeAttempts << "attempts";
+    const TelegramNamespace::ConnectionState state = m_resumedConnectionState;
+    m_resumedConnectionState = TelegramNamespace::ConnectionStateDisconnected;
+    m_mainConnectionResumeAttempts = 0;
+    setConnectionState(state);
+
+    if (state == TelegramNamespace::ConnectionStateReady) {
+        // Get only the updates missed while the connection was closed
+        getDifference();
+    }
+}
+
 void CTelegramDispatcher::onUpdatesReceived(const TLUpdates &updates, quint64 id)
 {
 #ifdef DEVELOPER_BUILD
@@ -2494,7 +3526,7 @@ void CTelegramDispatcher::onAuthExportedAuthorizationReceived(quint32 dc, quint3
         }
     }
 
-    if (connection && (connection->authState() == CTelegramConnection::AuthStateHaveAKey)) {
+    if (connection && (connection->authState() == CTelegramConnection::AuthStateHaveAKey) && !connection->authKeyExpiresAt()) {
         connection->authImportAuthorization(id, data);
     }
 }
@@ -2545,6 +3577,7 @@ void CTelegramDispatcher::continueInitialization(CTelegramDispatcher::Initializa
         m_deltaTime = mainConnection()->deltaTime();
         m_authKey = mainConnection()->authKey();
         m_serverSalt = mainConnection()->serverSalt();
+        m_serverSalts = mainConnection()->serverSalts();
         m_mainDcInfo = mainConnection()->dcInfo();
     }
 
@@ -2571,7 +3604,11 @@ void CTelegramDispatcher::continueInitialization(CTelegramDispatcher::Initializa
     if (neededSteps & StepDialogs) {
         getInitialDialogs();
         m_requestedSteps |= StepDialogs;
-        return;
+        if (m_dialogs.isEmpty()) {
+            return;
+        }
+        // The dialogs restored from the peer cache are good enough to start; they are reconciled in background.
+        m_initializationState |= StepDialogs;
     }
 
     if (neededSteps & StepUpdates) {
@@ -2685,13 +3722,13 @@ void CTelegramDispatcher::updateSentMessageId(quint64 randomId, quint32 resolved
 {
     if (m_randomMessageToPeerMap.contains(randomId)) {
         const Telegram::Peer peer = m_randomMessageToPeerMap.take(randomId);
-        if (m_dialogs.contains(peer)) {
-            TLDialog &dialog = m_dialogs[peer];
-            if (resolvedId > dialog.topMessage) {
-                qDebug() << "Up top dialog message from" << dialog.topMessage << "to" << resolvedId;
-                dialog.topMessage = resolvedId;
-            }
+        TLDialog *dialog = m_dialogs.find(peer);
+        if (dialog && (resolvedId > dialog->topMessage)) {
+            qDebug() << "Up top dialog message from" << dialog->topMessage << "to" << resolvedId;
+            dialog->topMessage = resolvedId;
+            markDialogChanged(peer);
         }
+        m_historyCache.addUnknownMessage(peer, resolvedId);
     }
     qDebug() << Q_FUNC_INFO << "Sent message id received:" << resolvedId << "is the id of message" << randomId;
     ensureMaxMessageId(resolvedId);
@@ -2703,8 +3740,13 @@ void CTelegramDispatcher::checkStateAndCallGetDifference()
     m_updatesStateIsLocked = m_actualState.pts > m_updatesState.pts;
 
     if (m_updatesStateIsLocked) {
+        emitCatchUpProgress();
         QTimer::singleShot(10, this, SLOT(getDifference()));
     } else {
+        if (m_catchUpTime.isValid()) {
+            emitCatchUpProgress(); // Reports zero remaining pts
+            m_catchUpTime.invalidate();
+        }
         continueInitialization(StepUpdates);
     }
 }
@@ -2718,6 +3760,10 @@ CTelegramConnection *CTelegramDispatcher::createConnection(const TLDcOption &dcI
     connection->setDeltaTime(m_deltaTime);
 
     connect(connection, &CTelegramConnection::connectionFailed, this, &CTelegramDispatcher::onConnectionFailed);
+    connect(connection, &CTelegramConnection::requestFailed, this, &CTelegramDispatcher::onConnectionRequestFailed);
+    for (auto it = m_requestRateLimits.constBegin(); it != m_requestRateLimits.constEnd(); ++it) {
+        connection->setRequestRateLimit(static_cast<TelegramNamespace::RequestClass>(it.key()), it.value().first, it.value().second);
+    }
     connect(connection, &CTelegramConnection::authStateChanged, this, &CTelegramDispatcher::onConnectionAuthChanged);
     connect(connection, &CTelegramConnection::statusChanged, this, &CTelegramDispatcher::onConnectionStatusChanged);
     connect(connection, &CTelegramConnection::dcConfigurationReceived, this, &CTelegramDispatcher::onDcConfigurationUpdated);
@@ -2730,6 +3776,26 @@ CTelegramConnection *CTelegramDispatcher::createConnection(const TLDcOption &dcI
         module->onNewConnection(connection);
     }
 
+    if (connection->transport()) {
+        connect(connection->transport(), &CTelegramTransport::connectionAttemptFailed, this, &CTelegramDispatcher::onConnectionAttemptFailed);
+    }
+
+    if (dcInfo.id) {
+        // Race all of the known addresses of the DC
+        QVector<Telegram::DcOption> addresses;
+        addresses.append(Telegram::DcOption(dcInfo.ipAddress, dcInfo.port));
+        for (const TLDcOption &option : m_dcConfiguration) {
+            if ((option.id != dcInfo.id) || (option.mediaOnly() != dcInfo.mediaOnly())) {
+                continue;
+            }
+            const Telegram::DcOption address(option.ipAddress, option.port);
+            if ((address.address != dcInfo.ipAddress) || (address.port != dcInfo.port)) {
+                addresses.append(address);
+            }
+        }
+        connection->setDcAddresses(m_addressLatencies.sorted(addresses));
+    }
+
     return connection;
 }
 
@@ -2739,6 +3805,10 @@ void CTelegramDispatcher::ensureSignedConnection(CTelegramConnection *connection
         connection->connectToDc();
     } else {
         if (connection->authState() == CTelegramConnection::AuthStateHaveAKey) { // Need an exported auth to sign in
+            if (connection->authKeyExpiresAt()) {
+                return; // A temporary key, signed in once it is bound
+            }
+
             quint32 dc = connection->dcInfo().id;
 
             if (dc == 0) {
@@ -2750,6 +3820,7 @@ void CTelegramDispatcher::ensureSignedConnection(CTelegramConnection *connection
                 connection->setDeltaTime(mainConnection()->deltaTime());
                 connection->setAuthKey(mainConnection()->authKey());
                 connection->setServerSalt(mainConnection()->serverSalt());
+                connection->setServerSalts(mainConnection()->serverSalts());
                 return;
             }
 
@@ -2769,6 +3840,8 @@ void CTelegramDispatcher::clearConnection(CTelegramConnection *connection)
     if (!connection) {
         return;
     }
+    // A remotely closed connection is already disconnected and keeps its requests for a reconnection
+    connection->failPendingRequests(TelegramNamespace::RequestFailureConnectionClosed);
     connection->disconnectFromDc();
     connection->deleteLater();
 }
@@ -2782,6 +3855,74 @@ void CTelegramDispatcher::clearExtraConnections()
     }
 
     m_extraConnections.clear();
+
+    foreach (CTelegramConnection *connection, m_temporaryKeyGenerators) {
+        disconnect(connection, nullptr, this, nullptr);
+        clearConnection(connection);
+    }
+
+    m_temporaryKeyGenerators.clear();
+}
+
+QByteArray CTelegramDispatcher::permanentKey(quint32 dc) const
+{
+    if (mainConnection() && (mainConnection()->dcInfo().id == dc) && (mainConnection()->authState() == CTelegramConnection::AuthStateSignedIn)) {
+        return mainConnection()->authKey();
+    }
+    return m_permanentKeys.value(dc);
+}
+
+void CTelegramDispatcher::requestTemporaryKeys(quint32 dc)
+{
+    if (m_temporaryKeyGenerators.contains(dc) || !m_temporaryKeys.missingCount(dc, serverTime())) {
+        return;
+    }
+
+    const TLDcOption dcInfo = dcInfoById(dc);
+    if (dcInfo.ipAddress.isEmpty()) {
+        return;
+    }
+
+    qDebug() << Q_FUNC_INFO << "Generate a temporary key for dc" << dc;
+    CTelegramConnection *connection = createConnection(dcInfo);
+    connection->setTemporaryKeyLifetime(s_temporaryKeyLifetime);
+    m_temporaryKeyGenerators.insert(dc, connection);
+    connection->connectToDc();
+}
+
+quint32 CTelegramDispatcher::serverTime() const
+{
+    return QDateTime::currentMSecsSinceEpoch() / 1000 + m_deltaTime;
+}
+
+void CTelegramDispatcher::onTemporaryKeysTimerTriggered()
+{
+    const quint32 now = serverTime();
+    m_temporaryKeys.removeExpired(now);
+
+    for (CTelegramConnection *connection : m_extraConnections) {
+        const quint32 expiresAt = connection->authKeyExpiresAt();
+        if (!expiresAt || connection->isBindingTemporaryKey() || (expiresAt > now + s_temporaryKeyRotationMargin)) {
+            continue;
+        }
+        const CTemporaryKeyPool::Key key = m_temporaryKeys.take(connection->dcInfo().id, now);
+        if (key.isValid()) {
+            connection->rotateTemporaryKey(key.authKey, key.serverSalt, key.expiresAt);
+        } // Otherwise the connection is rotated on the next check, once a key is generated
+    }
+
+    QSet<quint32> dcs;
+    if (mainConnection()) {
+        dcs.insert(mainConnection()->dcInfo().id);
+    }
+    for (auto it = m_permanentKeys.constBegin(); it != m_permanentKeys.constEnd(); ++it) {
+        dcs.insert(it.key());
+    }
+    for (quint32 dc : dcs) {
+        if (!permanentKey(dc).isEmpty()) {
+            requestTemporaryKeys(dc);
+        }
+    }
 }
 
 void CTelegramDispatcher::ensureMainConnectToWantedDc()
@@ -2844,15 +3985,36 @@ const TLChat *CTelegramDispatcher::getChat(const Telegram::Peer &peer) const
     }
 }
 
-const TLMessage *CTelegramDispatcher::getMessage(quint32 messageId, const Telegram::Peer &peer) const
+const TLMessageMedia *CTelegramDispatcher::getMessageMedia(quint32 messageId, const Telegram::Peer &peer) const
+{
+    return m_mediaMessages.object(mediaMessageKey(peer, messageId));
+}
+
+bool CTelegramDispatcher::requestMessageMedia(quint32 messageId, const Telegram::Peer &peer)
 {
+    const quint64 key = mediaMessageKey(peer, messageId);
+    if (m_mediaMessages.contains(key)) {
+        return false;
+    }
+    if (m_requestedMediaKeys.contains(key)) {
+        return true; // Already requested
+    }
+    if (!mainConnection()) {
+        return false;
+    }
+
+    const TLVector<quint32> ids = { messageId };
+    quint64 requestId = 0;
     if (peer.type == Telegram::Peer::Channel) {
-        QHash<quint32, TLMessage*> *peerMessages = m_channelMediaMessages.value(peer.id); // message id, message
-        if (!peerMessages) {
-            return nullptr;
+        const TLInputChannel inputChannel = toInputChannel(peer);
+        if (inputChannel.tlType == TLValue::InputChannelEmpty) {
+            return false;
         }
-
-        return peerMessages->value(messageId);
+        requestId = mainConnection()->channelsGetMessages(inputChannel, ids);
+    } else {
+        requestId = mainConnection()->messagesGetMessages(ids);
     }
-    return m_knownMediaMessages.value(messageId);
+    m_requestedMediaMessages.insert(requestId, key);
+    m_requestedMediaKeys.insert(key);
+    return true;
 }
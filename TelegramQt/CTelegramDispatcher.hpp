@@ -20,11 +20,23 @@
 
 #include <QObject>
 
+#include <QCache>
+#include <QElapsedTimer>
 #include <QHash>
 #include <QPair>
+#include <QQueue>
+#include <QSet>
 #include <QStringList>
 #include <QVector>
 
+#include "CAddressLatencyCache.hpp"
+#include "CChannelDifferenceScheduler.hpp"
+#include "CChatIdMap.hpp"
+#include "CChatParticipants.hpp"
+#include "CMessageHistoryCache.hpp"
+#include "CPeerTable.hpp"
+#include "CTelegramConnection.hpp"
+#include "CTemporaryKeyPool.hpp"
 #include "FileRequestDescriptor.hpp"
 #include "TLTypes.hpp"
 #include "TelegramNamespace.hpp"
@@ -34,7 +46,8 @@ QT_FORWARD_DECLARE_CLASS(QIODevice)
 QT_FORWARD_DECLARE_CLASS(QTimer)
 
 class CAppInformation;
-class CTelegramConnection;
+class CMessageSearchIndex;
+class CPeerCache;
 class CTelegramModule;
 
 namespace Telegram
@@ -42,8 +55,8 @@ namespace Telegram
 
 inline uint qHash(const Peer &key, uint seed)
 {
-    quint32 s = seed;
-    return key.id ^ s;
+    // A user, a chat and a channel can have the same id
+    return ::qHash((quint64(key.type) << 32) | key.id, seed);
 }
 
 }
@@ -90,6 +103,8 @@ public:
     quint32 selfId() const;
 
     quint32 maxMessageId() const;
+    qint64 serverTimeOffset() const;
+    qint64 roundTripTime(quint32 dc) const;
     QVector<quint32> contactIdList() const;
     QVector<quint32> chatIdList() const;
     QVector<Telegram::Peer> dialogs() const;
@@ -103,6 +118,22 @@ public:
     void setMessageReceivingFilter(TelegramNamespace::MessageFlags flags);
     void setAcceptableMessageTypes(TelegramNamespace::MessageTypeFlags types);
     void setAutoReconnection(bool enable);
+    void setMediaMessagesCacheSize(quint32 size);
+
+    enum PerItemSignal {
+        PerItemMessageSignals = 1 << 0, // messageReceived()
+        PerItemUserSignals = 1 << 1, // userInfoReceived()
+        PerItemChatSignals = 1 << 2, // chatAdded(), chatChanged()
+        PerItemAllSignals = PerItemMessageSignals|PerItemUserSignals|PerItemChatSignals
+    };
+    // The kinds not listed are delivered by the batched signals only (no copies for the unused per item signals)
+    void setPerItemSignals(int perItemSignals) { m_perItemSignals = perItemSignals; }
+    void setHistoryCacheSize(quint32 size);
+    void setRequestRateLimit(TelegramNamespace::RequestClass requestClass, int requestsPerMinute, int burst);
+    Telegram::RequestQueueStats requestQueueStats(TelegramNamespace::RequestClass requestClass) const;
+    bool setPeerCacheFile(const QString &fileName);
+    bool setMessageSearchIndexFile(const QString &fileName);
+    QVector<Telegram::Message> searchMessages(const QString &query, const Telegram::Peer &peer, int limit) const;
 
     bool setDcConfiguration(const QVector<Telegram::DcOption> &dcs);
     bool connectToServer();
@@ -110,6 +141,7 @@ public:
     void disconnectFromServer();
 
     bool requestHistory(const Telegram::Peer &peer, quint32 offset, quint32 limit);
+    bool requestMessageMedia(quint32 messageId, const Telegram::Peer &peer);
     quint32 resolveUsername(const QString &userName);
 
     quint64 sendMessage(const Telegram::Peer &peer, const QString &message);
@@ -142,12 +174,16 @@ public:
     void clearExtraConnections();
     void ensureMainConnectToWantedDc();
 
+    QByteArray permanentKey(quint32 dc) const; // Empty if there is no signed in key for the dc yet
+    void requestTemporaryKeys(quint32 dc); // Generates the missing keys of the pool in the background
+    quint32 serverTime() const;
+
     TLDcOption dcInfoById(quint32 dc) const;
 
     // Getters
     const TLUser *getUser(quint32 userId) const;
     const TLChat *getChat(const Telegram::Peer &peer) const;
-    const TLMessage *getMessage(quint32 messageId, const Telegram::Peer &peer) const;
+    const TLMessageMedia *getMessageMedia(quint32 messageId, const Telegram::Peer &peer) const;
 
     bool getDialogInfo(Telegram::DialogInfo *info, const Telegram::Peer peer) const;
     bool getUserInfo(Telegram::UserInfo *userInfo, quint32 userId) const;
@@ -160,6 +196,7 @@ public:
     Telegram::Peer toPublicPeer(const TLPeer &peer) const;
     Telegram::Peer toPublicPeer(const TLUser &user) const;
     Telegram::Peer toPublicPeer(const TLChat *chat) const;
+    Telegram::Peer toPublicPeer(const TLMessage &message) const;
     TLPeer toTLPeer(const Telegram::Peer &peer) const;
     TLInputUser toInputUser(quint32 id) const;
     TLInputChannel toInputChannel(const Telegram::Peer &peer);
@@ -170,6 +207,7 @@ signals:
     void connectionStateChanged(TelegramNamespace::ConnectionState status);
     void selfUserAvailable(quint32 userId);
     void userInfoReceived(quint32 userId);
+    void usersInfoReceived(const QVector<quint32> &userIds);
 
     void userNameStatusUpdated(const QString &userName, TelegramNamespace::UserNameStatus status);
     void contactListChanged();
@@ -177,6 +215,8 @@ signals:
     void contactProfileChanged(quint32 userId);
 
     void messageReceived(const Telegram::Message &message);
+    void messagesReceived(const QVector<Telegram::Message> &messages);
+    void messageMediaInfoReceived(Telegram::Peer peer, quint32 messageId);
 
     void contactStatusChanged(quint32 userId, TelegramNamespace::ContactStatus status);
     void contactMessageActionChanged(quint32 userId, TelegramNamespace::MessageAction action);
@@ -190,6 +230,12 @@ signals:
     void createdChatIdReceived(quint64 randomId, quint32 resolvedId);
     void chatAdded(quint32 chatId);
     void chatChanged(quint32 chatId);
+    void chatParticipantAdded(quint32 chatId, quint32 userId);
+    void chatParticipantRemoved(quint32 chatId, quint32 userId);
+    void chatsChanged(const QVector<quint32> &chatIds);
+
+    void updatesCatchUpProgress(quint32 remainingPts, quint32 processedMessages, quint32 messagesPerSecond);
+    void requestFailed(quint64 requestId, const QString &method, TelegramNamespace::RequestFailureReason reason);
 
 protected slots:
     void onConnectionAuthChanged(int newState, quint32 dc);
@@ -198,7 +244,11 @@ protected slots:
     void onConnectionDcIdUpdated(quint32 connectionId, quint32 newDcId);
     void onPackageRedirected(const QByteArray &data, quint32 dc);
     void onConnectionFailed(CTelegramConnection *connection);
+    void onConnectionRequestFailed(quint64 requestId, TLValue method, TelegramNamespace::RequestFailureReason reason);
     void onMainConnectionRetryTimerTriggered();
+    void onMainConnectionResumeTimerTriggered();
+    void onConnectionAttemptFailed(const Telegram::DcOption &address);
+    void onTemporaryKeysTimerTriggered();
 
     void onUpdatesReceived(const TLUpdates &updates, quint64 id);
     void onAuthExportedAuthorizationReceived(quint32 dc, quint32 id, const QByteArray &data);
@@ -207,21 +257,28 @@ protected slots:
     void onChannelsParticipantsReceived(quint32 channelId, TLVector<TLChannelParticipant> participants);
 
     void onContactListReceived(const QVector<quint32> &contactIdList);
+    void onContactListNotModified();
     void onContactListChanged(const QVector<quint32> &added, const QVector<quint32> &removed);
     void messageActionTimerTimeout();
 
-    void onMessagesHistoryReceived(const TLMessagesMessages &messages);
+    void onMessagesHistoryReceived(const TLMessagesMessages &messages, const TLInputPeer &inputPeer, quint32 offsetId, quint32 addOffset, quint32 limit);
+    void onMessagesMessagesReceived(const TLMessagesMessages &messages, quint64 requestId);
     void onMessagesDialogsReceived(const TLMessagesDialogs &dialogs, quint32 offsetDate, quint32 offsetId, const TLInputPeer &offsetPeer, quint32 limit);
     void onMessagesAffectedMessagesReceived(const TLMessagesAffectedMessages &affectedMessages);
 
     void getDcConfiguration();
     void getContacts();
     void getUpdatesState();
+    void syncPeerCache();
+    void emitBatchedSignals();
     void onUpdatesStateReceived(const TLUpdatesState &updatesState);
 
     void getDifference();
+    void processPendingDifferences();
     void onUpdatesDifferenceReceived(const TLUpdatesDifference &updatesDifference);
-    void onUpdatesChannelDifferenceReceived(const TLUpdatesChannelDifference &updatesDifference);
+    void onUpdatesChannelDifferenceReceived(quint32 channelId, const TLUpdatesChannelDifference &updatesDifference);
+    void onUpdatesChannelDifferenceFailed(quint32 channelId, quint32 errorCode, const QString &errorMessage);
+    void requestChannelDifferences();
 
     void onChatsReceived(const QVector<TLChat> &chats);
     void onMessagesFullChatReceived(const TLChatFull &chat, const QVector<TLChat> &chats, const QVector<TLUser> &users);
@@ -233,13 +290,27 @@ protected:
 
     void processMessageReceived(const TLMessage &message);
     void internalProcessMessageReceived(const TLMessage &message);
+    void addMessageMedia(const Telegram::Peer &peer, const TLMessage &message);
+    static TLMessageMedia compactMessageMedia(const TLMessageMedia &media);
+    static quint64 mediaMessageKey(const Telegram::Peer &peer, quint32 messageId);
 
     void emitChatChanged(quint32 id);
     void updateChat(const TLChat &newChat);
+    static bool isRemovedChat(const TLChat &chat);
+    void markDialogChanged(const Telegram::Peer &peer);
+    void removeDialogs(const QVector<Telegram::Peer> &peers);
+    void removeChannelDifferenceRequest(quint32 channelId);
     void updateFullChat(const TLChatFull &newChat);
+    bool addChatParticipant(quint32 chatId, const TLChatParticipant &participant);
+    bool removeChatParticipant(quint32 chatId, quint32 userId);
 
     void initConnectionSharedFinal();
 
+    void resetPeers();
+    void loadPeerCache();
+    void schedulePeerCacheSync();
+    void scheduleBatchedSignals();
+
     void getInitialUsers();
     void getInitialDialogs();
 
@@ -256,7 +327,11 @@ protected:
     void updateSentMessageId(quint64 randomId, quint32 resolvedId);
 
     void checkStateAndCallGetDifference();
+    void requestDifference(const TLUpdatesState &state);
+    void emitCatchUpProgress();
     bool connectToTheNextDcAddress();
+    bool resumeMainConnection();
+    void onMainConnectionResumed();
     void connectToTheWantedDc();
 
     void continueInitialization(InitializationStep justDone);
@@ -306,6 +381,7 @@ protected:
     qint32 m_deltaTime;
     QByteArray m_authKey;
     quint64 m_serverSalt;
+    QVector<CTelegramConnection::ServerSalt> m_serverSalts;
     TLDcOption m_mainDcInfo;
 
     TelegramNamespace::MessageFlags m_messageReceivingFilterFlags;
@@ -320,31 +396,71 @@ protected:
 
     QVector<Telegram::DcOption> m_connectionAddresses;
     QVector<TLDcOption> m_dcConfiguration;
+    CAddressLatencyCache m_addressLatencies; // Not stored, the network could be changed between the sessions
     CTelegramConnection *m_mainConnection;
     QVector<CTelegramConnection *> m_extraConnections;
+    CTemporaryKeyPool m_temporaryKeys;
+    QHash<quint32, CTelegramConnection *> m_temporaryKeyGenerators; // Dc to the connection which generates a key
+    QHash<quint32, QByteArray> m_permanentKeys; // Of the other DCs, not stored
+    QTimer *m_temporaryKeysTimer; // Refills the pool and rotates the keys of the extra connections
+    QHash<int, QPair<int, int> > m_requestRateLimits; // Request class, requests per minute and burst
     QString m_requestedCodeForPhone;
     QTimer *m_reconnectMainConnectionTimer;
+    QTimer *m_resumeMainConnectionTimer;
+    int m_mainConnectionResumeAttempts;
+    TelegramNamespace::ConnectionState m_resumedConnectionState; // To restore once the session is resumed, Disconnected if not resuming
 
     quint64 m_updateRequestId;
     TLUpdatesState m_updatesState; // Current application update state (may be older than actual server-side message box state)
     TLUpdatesState m_actualState; // State reported by server as actual
     bool m_updatesStateIsLocked; // True if we are (going to) getting updatesDifference.
+
+    // Updates catch up: the next difference slice is fetched while the current one is processed in chunks
+    QQueue<TLUpdatesDifference> m_pendingDifferences;
+    int m_pendingDifferenceMessageIndex; // -1 if the chats of the head difference are not applied yet
+    int m_pendingDifferenceUpdateIndex;
+    bool m_differenceRequested;
+    quint32 m_requestedDifferencePts;
+    QTimer *m_differenceProcessingTimer;
+    QElapsedTimer m_catchUpTime;
+    quint32 m_catchUpProcessedMessages;
+
+    CChannelDifferenceScheduler m_channelDifferenceScheduler;
+    QTimer *m_channelDifferenceTimer; // Resumes the channel differences requests after a flood wait or a retry delay
+    QHash<quint64, quint32> m_channelDifferenceRequests; // Request id, channel id
+    QHash<quint32, quint32> m_restoredChannelPts; // Channel id, pts (from the secret info)
     bool m_emitOnlyIncomingUnreadMessages;
 
     QHash<quint32, QPair<quint32,QByteArray> > m_exportedAuthentications; // dc, <id, auth data>
     QHash<quint32, QByteArray> m_delayedPackages; // dc, package data
-    QHash<quint32, TLUser*> m_users;
+    CPeerTable<quint32, TLUser*> m_users;
     QVector<quint32> m_askedUserIds;
     QVector<TLInputUser> m_askedInitialUsers;
 
-    QHash<quint32, TLMessage*> m_knownMediaMessages; // message id, message
-    QHash<quint32, QHash<quint32, TLMessage*> *> m_channelMediaMessages; // ChannelId to <message id, message>
+    QCache<quint64, TLMessageMedia> m_mediaMessages; // Media message key (see mediaMessageKey()), media. The cost is in bytes.
+    QHash<quint64, quint64> m_requestedMediaMessages; // Request id, media message key
+    QSet<quint64> m_requestedMediaKeys; // Keys of m_requestedMediaMessages
+
+    CMessageHistoryCache m_historyCache;
+    QVector<TLMessage> m_cachedHistoryMessages; // Served from the history cache, processed on the batched signals emission
 
     quint32 m_selfUserId;
     quint32 m_maxMessageId;
 
     QVector<quint32> m_contactIdList;
 
+    CPeerCache *m_peerCache;
+    CMessageSearchIndex *m_searchIndex;
+    QTimer *m_peerCacheSyncTimer;
+
+    // Batched variants of the per item signals, emitted once per event loop iteration
+    QTimer *m_batchedSignalsTimer;
+    QVector<Telegram::Message> m_batchedMessages;
+    QVector<quint32> m_batchedUserIds;
+    QVector<quint32> m_batchedChatIds;
+    QSet<quint32> m_batchedChatIdsSet;
+    int m_perItemSignals;
+
     // fileId is program-specific handler, not related to Telegram.
     QHash<quint64,quint64> m_rpcIdToMessageRandomIdMap; // RPC Id, Random Id
     QHash<quint64,Telegram::Peer> m_randomMessageToPeerMap; // Random Id, Peer
@@ -353,12 +469,15 @@ protected:
     QVector<TypingStatus> m_contactsMessageActions;
     QVector<TypingStatus> m_localMessageActions;
 
-    TLVector<quint32> m_chatIds; // Telegram chat ids vector. Index is "public chat id".
+    CChatIdMap m_chatIds; // Telegram chat id <-> "public chat id"
 
-    QHash<Telegram::Peer,TLDialog> m_dialogs;
-    QHash<quint32, TLChat*> m_chatInfo; // Telegram chat id to Chat map
-    QHash<quint32, TLChatFull> m_chatFullInfo; // Telegram chat id to ChatFull map
-    QHash<quint32, TLVector<TLChannelParticipant> > m_channelParticipants; // Telegram chat id to ChatFull map
+    CPeerTable<Telegram::Peer, TLDialog> m_dialogs;
+    CPeerTable<quint32, TLChat*> m_chatInfo; // Telegram chat id to Chat map
+    CPeerTable<quint32, TLChatFull> m_chatFullInfo; // Telegram chat id to ChatFull map
+    CPeerTable<quint32, CChatParticipants> m_chatParticipants; // Telegram chat id to participants index
+    QSet<quint32> m_changedFullChats; // Full chats changed after the last peer cache sync
+    QSet<Telegram::Peer> m_changedDialogs; // Dialogs changed after the last peer cache sync
+    QSet<Telegram::Peer> m_listedDialogs; // Dialogs received since the start of the dialogs listing
 
     QVector<CTelegramModule*> m_modules;
 
@@ -95,15 +95,15 @@ quint32 CTelegramMediaModule::requestFile(const Telegram::RemoteFile *file, quin
 
 bool CTelegramMediaModule::getMessageMediaInfo(Telegram::MessageMediaInfo *messageInfo, quint32 messageId, const Telegram::Peer &peer) const
 {
-    const TLMessage *message = getMessage(messageId, peer);
-    if (!message) {
+    const TLMessageMedia *media = getMessageMedia(messageId, peer);
+    if (!media) {
+        // The evicted media can be requested with CTelegramCore::requestMessageMediaInfo()
         qDebug() << Q_FUNC_INFO << "Unknown media message" << messageId;
         return false;
     }
 
-    const TLMessageMedia &media = message->media;
     TLMessageMedia &info = *messageInfo->d;
-    info = media;
+    info = *media;
     return true;
 }
 
@@ -100,9 +100,9 @@ const TLChat *CTelegramModule::getChat(const Telegram::Peer &peer) const
     return m_dispatcher->getChat(peer);
 }
 
-const TLMessage *CTelegramModule::getMessage(quint32 messageId, const Telegram::Peer &peer) const
+const TLMessageMedia *CTelegramModule::getMessageMedia(quint32 messageId, const Telegram::Peer &peer) const
 {
-    return m_dispatcher->getMessage(messageId, peer);
+    return m_dispatcher->getMessageMedia(messageId, peer);
 }
 
 TLInputPeer CTelegramModule::toInputPeer(const Telegram::Peer &peer) const
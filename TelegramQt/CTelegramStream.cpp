@@ -27,12 +27,14 @@ template CTelegramStream &CTelegramStream::operator>>(TLVector<quint32> &v);
 template CTelegramStream &CTelegramStream::operator>>(TLVector<qint64> &v);
 template CTelegramStream &CTelegramStream::operator>>(TLVector<quint64> &v);
 template CTelegramStream &CTelegramStream::operator>>(TLVector<QString> &v);
+template CTelegramStream &CTelegramStream::operator>>(TLVector<TLString> &v);
 
 template CTelegramStream &CTelegramStream::operator<<(const TLVector<qint32> &v);
 template CTelegramStream &CTelegramStream::operator<<(const TLVector<quint32> &v);
 template CTelegramStream &CTelegramStream::operator<<(const TLVector<qint64> &v);
 template CTelegramStream &CTelegramStream::operator<<(const TLVector<quint64> &v);
 template CTelegramStream &CTelegramStream::operator<<(const TLVector<QString> &v);
+template CTelegramStream &CTelegramStream::operator<<(const TLVector<TLString> &v);
 
 template CTelegramStream &CTelegramStream::operator>>(TLNumber128 &v);
 template CTelegramStream &CTelegramStream::operator>>(TLNumber256 &v);
@@ -126,6 +128,30 @@ CTelegramStream &CTelegramStream::operator<<(const TLDcOption &dcOption)
     return *this;
 }
 
+quint32 CTelegramStream::serializedSize(const QString &str)
+{
+    // Count the UTF-8 length without the actual conversion; an unpaired surrogate is encoded as '?'
+    quint32 length = 0;
+    const int size = str.size();
+    for (int i = 0; i < size; ++i) {
+        const ushort c = str.at(i).unicode();
+        if (c < 0x80) {
+            length += 1;
+        } else if (c < 0x800) {
+            length += 2;
+        } else if (QChar::isHighSurrogate(c) && (i + 1 < size) && QChar::isLowSurrogate(str.at(i + 1).unicode())) {
+            length += 4;
+            ++i;
+        } else if (QChar::isSurrogate(c)) {
+            length += 1;
+        } else {
+            length += 3;
+        }
+    }
+    return serializedBytesSize(length);
+}
+
+#ifndef TELEGRAMQT_TABLE_DECODER
 // Generated read operators implementation
 CTelegramStream &CTelegramStream::operator>>(TLAccountDaysTTL &accountDaysTTLValue)
 {
@@ -436,20 +462,15 @@ CTelegramStream &CTelegramStream::operator>>(TLChannelParticipant &channelPartic
 
     switch (result.tlType) {
     case TLValue::ChannelParticipant:
-        *this >> result.userId;
-        *this >> result.date;
+        readFixedLayout(result.userId, result.date);
         break;
     case TLValue::ChannelParticipantSelf:
     case TLValue::ChannelParticipantModerator:
     case TLValue::ChannelParticipantEditor:
-        *this >> result.userId;
-        *this >> result.inviterId;
-        *this >> result.date;
+        readFixedLayout(result.userId, result.inviterId, result.date);
         break;
     case TLValue::ChannelParticipantKicked:
-        *this >> result.userId;
-        *this >> result.kickedBy;
-        *this >> result.date;
+        readFixedLayout(result.userId, result.kickedBy, result.date);
         break;
     case TLValue::ChannelParticipantCreator:
         *this >> result.userId;
@@ -513,9 +534,7 @@ CTelegramStream &CTelegramStream::operator>>(TLChatParticipant &chatParticipantV
     switch (result.tlType) {
     case TLValue::ChatParticipant:
     case TLValue::ChatParticipantAdmin:
-        *this >> result.userId;
-        *this >> result.inviterId;
-        *this >> result.date;
+        readFixedLayout(result.userId, result.inviterId, result.date);
         break;
     case TLValue::ChatParticipantCreator:
         *this >> result.userId;
@@ -585,8 +604,7 @@ CTelegramStream &CTelegramStream::operator>>(TLContactBlocked &contactBlockedVal
 
     switch (result.tlType) {
     case TLValue::ContactBlocked:
-        *this >> result.userId;
-        *this >> result.date;
+        readFixedLayout(result.userId, result.date);
         break;
     default:
         break;
@@ -626,8 +644,7 @@ CTelegramStream &CTelegramStream::operator>>(TLContactSuggested &contactSuggeste
 
     switch (result.tlType) {
     case TLValue::ContactSuggested:
-        *this >> result.userId;
-        *this >> result.mutualContacts;
+        readFixedLayout(result.userId, result.mutualContacts);
         break;
     default:
         break;
@@ -670,11 +687,7 @@ CTelegramStream &CTelegramStream::operator>>(TLEncryptedChat &encryptedChatValue
         *this >> result.id;
         break;
     case TLValue::EncryptedChatWaiting:
-        *this >> result.id;
-        *this >> result.accessHash;
-        *this >> result.date;
-        *this >> result.adminId;
-        *this >> result.participantId;
+        readFixedLayout(result.id, result.accessHash, result.date, result.adminId, result.participantId);
         break;
     case TLValue::EncryptedChatRequested:
         *this >> result.id;
@@ -712,11 +725,7 @@ CTelegramStream &CTelegramStream::operator>>(TLEncryptedFile &encryptedFileValue
     case TLValue::EncryptedFileEmpty:
         break;
     case TLValue::EncryptedFile:
-        *this >> result.id;
-        *this >> result.accessHash;
-        *this >> result.size;
-        *this >> result.dcId;
-        *this >> result.keyFingerprint;
+        readFixedLayout(result.id, result.accessHash, result.size, result.dcId, result.keyFingerprint);
         break;
     default:
         break;
@@ -805,15 +814,10 @@ CTelegramStream &CTelegramStream::operator>>(TLFileLocation &fileLocationValue)
 
     switch (result.tlType) {
     case TLValue::FileLocationUnavailable:
-        *this >> result.volumeId;
-        *this >> result.localId;
-        *this >> result.secret;
+        readFixedLayout(result.volumeId, result.localId, result.secret);
         break;
     case TLValue::FileLocation:
-        *this >> result.dcId;
-        *this >> result.volumeId;
-        *this >> result.localId;
-        *this >> result.secret;
+        readFixedLayout(result.dcId, result.volumeId, result.localId, result.secret);
         break;
     default:
         break;
@@ -834,8 +838,7 @@ CTelegramStream &CTelegramStream::operator>>(TLGeoPoint &geoPointValue)
     case TLValue::GeoPointEmpty:
         break;
     case TLValue::GeoPoint:
-        *this >> result.longitude;
-        *this >> result.latitude;
+        readFixedLayout(result.longitude, result.latitude);
         break;
     default:
         break;
@@ -937,8 +940,7 @@ CTelegramStream &CTelegramStream::operator>>(TLImportedContact &importedContactV
 
     switch (result.tlType) {
     case TLValue::ImportedContact:
-        *this >> result.userId;
-        *this >> result.clientId;
+        readFixedLayout(result.userId, result.clientId);
         break;
     default:
         break;
@@ -981,8 +983,7 @@ CTelegramStream &CTelegramStream::operator>>(TLInputAudio &inputAudioValue)
     case TLValue::InputAudioEmpty:
         break;
     case TLValue::InputAudio:
-        *this >> result.id;
-        *this >> result.accessHash;
+        readFixedLayout(result.id, result.accessHash);
         break;
     default:
         break;
@@ -1003,8 +1004,7 @@ CTelegramStream &CTelegramStream::operator>>(TLInputChannel &inputChannelValue)
     case TLValue::InputChannelEmpty:
         break;
     case TLValue::InputChannel:
-        *this >> result.channelId;
-        *this >> result.accessHash;
+        readFixedLayout(result.channelId, result.accessHash);
         break;
     default:
         break;
@@ -1047,8 +1047,7 @@ CTelegramStream &CTelegramStream::operator>>(TLInputDocument &inputDocumentValue
     case TLValue::InputDocumentEmpty:
         break;
     case TLValue::InputDocument:
-        *this >> result.id;
-        *this >> result.accessHash;
+        readFixedLayout(result.id, result.accessHash);
         break;
     default:
         break;
@@ -1067,8 +1066,7 @@ CTelegramStream &CTelegramStream::operator>>(TLInputEncryptedChat &inputEncrypte
 
     switch (result.tlType) {
     case TLValue::InputEncryptedChat:
-        *this >> result.chatId;
-        *this >> result.accessHash;
+        readFixedLayout(result.chatId, result.accessHash);
         break;
     default:
         break;
@@ -1095,13 +1093,10 @@ CTelegramStream &CTelegramStream::operator>>(TLInputEncryptedFile &inputEncrypte
         *this >> result.keyFingerprint;
         break;
     case TLValue::InputEncryptedFile:
-        *this >> result.id;
-        *this >> result.accessHash;
+        readFixedLayout(result.id, result.accessHash);
         break;
     case TLValue::InputEncryptedFileBigUploaded:
-        *this >> result.id;
-        *this >> result.parts;
-        *this >> result.keyFingerprint;
+        readFixedLayout(result.id, result.parts, result.keyFingerprint);
         break;
     default:
         break;
@@ -1147,16 +1142,13 @@ CTelegramStream &CTelegramStream::operator>>(TLInputFileLocation &inputFileLocat
 
     switch (result.tlType) {
     case TLValue::InputFileLocation:
-        *this >> result.volumeId;
-        *this >> result.localId;
-        *this >> result.secret;
+        readFixedLayout(result.volumeId, result.localId, result.secret);
         break;
     case TLValue::InputVideoFileLocation:
     case TLValue::InputEncryptedFileLocation:
     case TLValue::InputAudioFileLocation:
     case TLValue::InputDocumentFileLocation:
-        *this >> result.id;
-        *this >> result.accessHash;
+        readFixedLayout(result.id, result.accessHash);
         break;
     default:
         break;
@@ -1177,8 +1169,7 @@ CTelegramStream &CTelegramStream::operator>>(TLInputGeoPoint &inputGeoPointValue
     case TLValue::InputGeoPointEmpty:
         break;
     case TLValue::InputGeoPoint:
-        *this >> result.latitude;
-        *this >> result.longitude;
+        readFixedLayout(result.latitude, result.longitude);
         break;
     default:
         break;
@@ -1203,12 +1194,10 @@ CTelegramStream &CTelegramStream::operator>>(TLInputPeer &inputPeerValue)
         *this >> result.chatId;
         break;
     case TLValue::InputPeerUser:
-        *this >> result.userId;
-        *this >> result.accessHash;
+        readFixedLayout(result.userId, result.accessHash);
         break;
     case TLValue::InputPeerChannel:
-        *this >> result.channelId;
-        *this >> result.accessHash;
+        readFixedLayout(result.channelId, result.accessHash);
         break;
     default:
         break;
@@ -1270,8 +1259,7 @@ CTelegramStream &CTelegramStream::operator>>(TLInputPhoto &inputPhotoValue)
     case TLValue::InputPhotoEmpty:
         break;
     case TLValue::InputPhoto:
-        *this >> result.id;
-        *this >> result.accessHash;
+        readFixedLayout(result.id, result.accessHash);
         break;
     default:
         break;
@@ -1292,9 +1280,7 @@ CTelegramStream &CTelegramStream::operator>>(TLInputPhotoCrop &inputPhotoCropVal
     case TLValue::InputPhotoCropAuto:
         break;
     case TLValue::InputPhotoCrop:
-        *this >> result.cropLeft;
-        *this >> result.cropTop;
-        *this >> result.cropWidth;
+        readFixedLayout(result.cropLeft, result.cropTop, result.cropWidth);
         break;
     default:
         break;
@@ -1333,8 +1319,7 @@ CTelegramStream &CTelegramStream::operator>>(TLInputStickerSet &inputStickerSetV
     case TLValue::InputStickerSetEmpty:
         break;
     case TLValue::InputStickerSetID:
-        *this >> result.id;
-        *this >> result.accessHash;
+        readFixedLayout(result.id, result.accessHash);
         break;
     case TLValue::InputStickerSetShortName:
         *this >> result.shortName;
@@ -1359,8 +1344,7 @@ CTelegramStream &CTelegramStream::operator>>(TLInputUser &inputUserValue)
     case TLValue::InputUserSelf:
         break;
     case TLValue::InputUser:
-        *this >> result.userId;
-        *this >> result.accessHash;
+        readFixedLayout(result.userId, result.accessHash);
         break;
     default:
         break;
@@ -1381,8 +1365,7 @@ CTelegramStream &CTelegramStream::operator>>(TLInputVideo &inputVideoValue)
     case TLValue::InputVideoEmpty:
         break;
     case TLValue::InputVideo:
-        *this >> result.id;
-        *this >> result.accessHash;
+        readFixedLayout(result.id, result.accessHash);
         break;
     default:
         break;
@@ -1447,8 +1430,7 @@ CTelegramStream &CTelegramStream::operator>>(TLMessageEntity &messageEntityValue
     case TLValue::MessageEntityBold:
     case TLValue::MessageEntityItalic:
     case TLValue::MessageEntityCode:
-        *this >> result.offset;
-        *this >> result.length;
+        readFixedLayout(result.offset, result.length);
         break;
     case TLValue::MessageEntityPre:
         *this >> result.offset;
@@ -1477,10 +1459,7 @@ CTelegramStream &CTelegramStream::operator>>(TLMessageGroup &messageGroupValue)
 
     switch (result.tlType) {
     case TLValue::MessageGroup:
-        *this >> result.minId;
-        *this >> result.maxId;
-        *this >> result.count;
-        *this >> result.date;
+        readFixedLayout(result.minId, result.maxId, result.count, result.date);
         break;
     default:
         break;
@@ -1499,8 +1478,7 @@ CTelegramStream &CTelegramStream::operator>>(TLMessageRange &messageRangeValue)
 
     switch (result.tlType) {
     case TLValue::MessageRange:
-        *this >> result.minId;
-        *this >> result.maxId;
+        readFixedLayout(result.minId, result.maxId);
         break;
     default:
         break;
@@ -1519,9 +1497,7 @@ CTelegramStream &CTelegramStream::operator>>(TLMessagesAffectedHistory &messages
 
     switch (result.tlType) {
     case TLValue::MessagesAffectedHistory:
-        *this >> result.pts;
-        *this >> result.ptsCount;
-        *this >> result.offset;
+        readFixedLayout(result.pts, result.ptsCount, result.offset);
         break;
     default:
         break;
@@ -1540,8 +1516,7 @@ CTelegramStream &CTelegramStream::operator>>(TLMessagesAffectedMessages &message
 
     switch (result.tlType) {
     case TLValue::MessagesAffectedMessages:
-        *this >> result.pts;
-        *this >> result.ptsCount;
+        readFixedLayout(result.pts, result.ptsCount);
         break;
     default:
         break;
@@ -1800,8 +1775,7 @@ CTelegramStream &CTelegramStream::operator>>(TLReceivedNotifyMessage &receivedNo
 
     switch (result.tlType) {
     case TLValue::ReceivedNotifyMessage:
-        *this >> result.id;
-        *this >> result.flags;
+        readFixedLayout(result.id, result.flags);
         break;
     default:
         break;
@@ -1919,11 +1893,7 @@ CTelegramStream &CTelegramStream::operator>>(TLUpdatesState &updatesStateValue)
 
     switch (result.tlType) {
     case TLValue::UpdatesState:
-        *this >> result.pts;
-        *this >> result.qts;
-        *this >> result.date;
-        *this >> result.seq;
-        *this >> result.unreadCount;
+        readFixedLayout(result.pts, result.qts, result.date, result.seq, result.unreadCount);
         break;
     default:
         break;
@@ -2237,8 +2207,7 @@ CTelegramStream &CTelegramStream::operator>>(TLDocumentAttribute &documentAttrib
 
     switch (result.tlType) {
     case TLValue::DocumentAttributeImageSize:
-        *this >> result.w;
-        *this >> result.h;
+        readFixedLayout(result.w, result.h);
         break;
     case TLValue::DocumentAttributeAnimated:
         break;
@@ -2247,9 +2216,7 @@ CTelegramStream &CTelegramStream::operator>>(TLDocumentAttribute &documentAttrib
         *this >> result.stickerset;
         break;
     case TLValue::DocumentAttributeVideo:
-        *this >> result.duration;
-        *this >> result.w;
-        *this >> result.h;
+        readFixedLayout(result.duration, result.w, result.h);
         break;
     case TLValue::DocumentAttributeAudio:
         *this >> result.duration;
@@ -3406,8 +3373,7 @@ CTelegramStream &CTelegramStream::operator>>(TLWebPage &webPageValue)
         *this >> result.id;
         break;
     case TLValue::WebPagePending:
-        *this >> result.id;
-        *this >> result.date;
+        readFixedLayout(result.id, result.date);
         break;
     case TLValue::WebPage:
         *this >> result.flags;
@@ -3742,8 +3708,7 @@ CTelegramStream &CTelegramStream::operator>>(TLUpdate &updateValue)
         *this >> result.ptsCount;
         break;
     case TLValue::UpdateMessageID:
-        *this >> result.id;
-        *this >> result.randomId;
+        readFixedLayout(result.id, result.randomId);
         break;
     case TLValue::UpdateDeleteMessages:
     case TLValue::UpdateReadMessagesContents:
@@ -3780,8 +3745,7 @@ CTelegramStream &CTelegramStream::operator>>(TLUpdate &updateValue)
         *this >> result.previous;
         break;
     case TLValue::UpdateContactRegistered:
-        *this >> result.userId;
-        *this >> result.date;
+        readFixedLayout(result.userId, result.date);
         break;
     case TLValue::UpdateContactLink:
         *this >> result.userId;
@@ -3806,21 +3770,13 @@ CTelegramStream &CTelegramStream::operator>>(TLUpdate &updateValue)
         *this >> result.date;
         break;
     case TLValue::UpdateEncryptedMessagesRead:
-        *this >> result.chatId;
-        *this >> result.maxDate;
-        *this >> result.date;
+        readFixedLayout(result.chatId, result.maxDate, result.date);
         break;
     case TLValue::UpdateChatParticipantAdd:
-        *this >> result.chatId;
-        *this >> result.userId;
-        *this >> result.inviterId;
-        *this >> result.date;
-        *this >> result.version;
+        readFixedLayout(result.chatId, result.userId, result.inviterId, result.date, result.version);
         break;
     case TLValue::UpdateChatParticipantDelete:
-        *this >> result.chatId;
-        *this >> result.userId;
-        *this >> result.version;
+        readFixedLayout(result.chatId, result.userId, result.version);
         break;
     case TLValue::UpdateDcOptions:
         *this >> result.dcOptions;
@@ -3868,8 +3824,7 @@ CTelegramStream &CTelegramStream::operator>>(TLUpdate &updateValue)
         *this >> result.group;
         break;
     case TLValue::UpdateReadChannelInbox:
-        *this >> result.channelId;
-        *this >> result.maxId;
+        readFixedLayout(result.channelId, result.maxId);
         break;
     case TLValue::UpdateDeleteChannelMessages:
         *this >> result.channelId;
@@ -3878,9 +3833,7 @@ CTelegramStream &CTelegramStream::operator>>(TLUpdate &updateValue)
         *this >> result.ptsCount;
         break;
     case TLValue::UpdateChannelMessageViews:
-        *this >> result.channelId;
-        *this >> result.id;
-        *this >> result.views;
+        readFixedLayout(result.channelId, result.id, result.views);
         break;
     case TLValue::UpdateChatAdmins:
         *this >> result.chatId;
@@ -4073,8 +4026,7 @@ CTelegramStream &CTelegramStream::operator>>(TLUpdatesDifference &updatesDiffere
 
     switch (result.tlType) {
     case TLValue::UpdatesDifferenceEmpty:
-        *this >> result.date;
-        *this >> result.seq;
+        readFixedLayout(result.date, result.seq);
         break;
     case TLValue::UpdatesDifference:
         *this >> result.newMessages;
@@ -4102,6 +4054,7 @@ CTelegramStream &CTelegramStream::operator>>(TLUpdatesDifference &updatesDiffere
 }
 
 // End of generated read operators implementation
+#endif // TELEGRAMQT_TABLE_DECODER
 
 // Generated write operators implementation
 CTelegramStream &CTelegramStream::operator<<(const TLAccountDaysTTL &accountDaysTTLValue)
@@ -4205,8 +4158,7 @@ CTelegramStream &CTelegramStream::operator<<(const TLInputAudio &inputAudioValue
     case TLValue::InputAudioEmpty:
         break;
     case TLValue::InputAudio:
-        *this << inputAudioValue.id;
-        *this << inputAudioValue.accessHash;
+        writeFixedLayout(inputAudioValue.id, inputAudioValue.accessHash);
         break;
     default:
         break;
@@ -4223,8 +4175,7 @@ CTelegramStream &CTelegramStream::operator<<(const TLInputChannel &inputChannelV
     case TLValue::InputChannelEmpty:
         break;
     case TLValue::InputChannel:
-        *this << inputChannelValue.channelId;
-        *this << inputChannelValue.accessHash;
+        writeFixedLayout(inputChannelValue.channelId, inputChannelValue.accessHash);
         break;
     default:
         break;
@@ -4259,8 +4210,7 @@ CTelegramStream &CTelegramStream::operator<<(const TLInputDocument &inputDocumen
     case TLValue::InputDocumentEmpty:
         break;
     case TLValue::InputDocument:
-        *this << inputDocumentValue.id;
-        *this << inputDocumentValue.accessHash;
+        writeFixedLayout(inputDocumentValue.id, inputDocumentValue.accessHash);
         break;
     default:
         break;
@@ -4275,8 +4225,7 @@ CTelegramStream &CTelegramStream::operator<<(const TLInputEncryptedChat &inputEn
 
     switch (inputEncryptedChatValue.tlType) {
     case TLValue::InputEncryptedChat:
-        *this << inputEncryptedChatValue.chatId;
-        *this << inputEncryptedChatValue.accessHash;
+        writeFixedLayout(inputEncryptedChatValue.chatId, inputEncryptedChatValue.accessHash);
         break;
     default:
         break;
@@ -4299,13 +4248,10 @@ CTelegramStream &CTelegramStream::operator<<(const TLInputEncryptedFile &inputEn
         *this << inputEncryptedFileValue.keyFingerprint;
         break;
     case TLValue::InputEncryptedFile:
-        *this << inputEncryptedFileValue.id;
-        *this << inputEncryptedFileValue.accessHash;
+        writeFixedLayout(inputEncryptedFileValue.id, inputEncryptedFileValue.accessHash);
         break;
     case TLValue::InputEncryptedFileBigUploaded:
-        *this << inputEncryptedFileValue.id;
-        *this << inputEncryptedFileValue.parts;
-        *this << inputEncryptedFileValue.keyFingerprint;
+        writeFixedLayout(inputEncryptedFileValue.id, inputEncryptedFileValue.parts, inputEncryptedFileValue.keyFingerprint);
         break;
     default:
         break;
@@ -4343,16 +4289,13 @@ CTelegramStream &CTelegramStream::operator<<(const TLInputFileLocation &inputFil
 
     switch (inputFileLocationValue.tlType) {
     case TLValue::InputFileLocation:
-        *this << inputFileLocationValue.volumeId;
-        *this << inputFileLocationValue.localId;
-        *this << inputFileLocationValue.secret;
+        writeFixedLayout(inputFileLocationValue.volumeId, inputFileLocationValue.localId, inputFileLocationValue.secret);
         break;
     case TLValue::InputVideoFileLocation:
     case TLValue::InputEncryptedFileLocation:
     case TLValue::InputAudioFileLocation:
     case TLValue::InputDocumentFileLocation:
-        *this << inputFileLocationValue.id;
-        *this << inputFileLocationValue.accessHash;
+        writeFixedLayout(inputFileLocationValue.id, inputFileLocationValue.accessHash);
         break;
     default:
         break;
@@ -4369,8 +4312,7 @@ CTelegramStream &CTelegramStream::operator<<(const TLInputGeoPoint &inputGeoPoin
     case TLValue::InputGeoPointEmpty:
         break;
     case TLValue::InputGeoPoint:
-        *this << inputGeoPointValue.latitude;
-        *this << inputGeoPointValue.longitude;
+        writeFixedLayout(inputGeoPointValue.latitude, inputGeoPointValue.longitude);
         break;
     default:
         break;
@@ -4391,12 +4333,10 @@ CTelegramStream &CTelegramStream::operator<<(const TLInputPeer &inputPeerValue)
         *this << inputPeerValue.chatId;
         break;
     case TLValue::InputPeerUser:
-        *this << inputPeerValue.userId;
-        *this << inputPeerValue.accessHash;
+        writeFixedLayout(inputPeerValue.userId, inputPeerValue.accessHash);
         break;
     case TLValue::InputPeerChannel:
-        *this << inputPeerValue.channelId;
-        *this << inputPeerValue.accessHash;
+        writeFixedLayout(inputPeerValue.channelId, inputPeerValue.accessHash);
         break;
     default:
         break;
@@ -4431,8 +4371,7 @@ CTelegramStream &CTelegramStream::operator<<(const TLInputPhoto &inputPhotoValue
     case TLValue::InputPhotoEmpty:
         break;
     case TLValue::InputPhoto:
-        *this << inputPhotoValue.id;
-        *this << inputPhotoValue.accessHash;
+        writeFixedLayout(inputPhotoValue.id, inputPhotoValue.accessHash);
         break;
     default:
         break;
@@ -4449,9 +4388,7 @@ CTelegramStream &CTelegramStream::operator<<(const TLInputPhotoCrop &inputPhotoC
     case TLValue::InputPhotoCropAuto:
         break;
     case TLValue::InputPhotoCrop:
-        *this << inputPhotoCropValue.cropLeft;
-        *this << inputPhotoCropValue.cropTop;
-        *this << inputPhotoCropValue.cropWidth;
+        writeFixedLayout(inputPhotoCropValue.cropLeft, inputPhotoCropValue.cropTop, inputPhotoCropValue.cropWidth);
         break;
     default:
         break;
@@ -4482,8 +4419,7 @@ CTelegramStream &CTelegramStream::operator<<(const TLInputStickerSet &inputStick
     case TLValue::InputStickerSetEmpty:
         break;
     case TLValue::InputStickerSetID:
-        *this << inputStickerSetValue.id;
-        *this << inputStickerSetValue.accessHash;
+        writeFixedLayout(inputStickerSetValue.id, inputStickerSetValue.accessHash);
         break;
     case TLValue::InputStickerSetShortName:
         *this << inputStickerSetValue.shortName;
@@ -4504,8 +4440,7 @@ CTelegramStream &CTelegramStream::operator<<(const TLInputUser &inputUserValue)
     case TLValue::InputUserSelf:
         break;
     case TLValue::InputUser:
-        *this << inputUserValue.userId;
-        *this << inputUserValue.accessHash;
+        writeFixedLayout(inputUserValue.userId, inputUserValue.accessHash);
         break;
     default:
         break;
@@ -4522,8 +4457,7 @@ CTelegramStream &CTelegramStream::operator<<(const TLInputVideo &inputVideoValue
     case TLValue::InputVideoEmpty:
         break;
     case TLValue::InputVideo:
-        *this << inputVideoValue.id;
-        *this << inputVideoValue.accessHash;
+        writeFixedLayout(inputVideoValue.id, inputVideoValue.accessHash);
         break;
     default:
         break;
@@ -4576,8 +4510,7 @@ CTelegramStream &CTelegramStream::operator<<(const TLMessageEntity &messageEntit
     case TLValue::MessageEntityBold:
     case TLValue::MessageEntityItalic:
     case TLValue::MessageEntityCode:
-        *this << messageEntityValue.offset;
-        *this << messageEntityValue.length;
+        writeFixedLayout(messageEntityValue.offset, messageEntityValue.length);
         break;
     case TLValue::MessageEntityPre:
         *this << messageEntityValue.offset;
@@ -4602,8 +4535,7 @@ CTelegramStream &CTelegramStream::operator<<(const TLMessageRange &messageRangeV
 
     switch (messageRangeValue.tlType) {
     case TLValue::MessageRange:
-        *this << messageRangeValue.minId;
-        *this << messageRangeValue.maxId;
+        writeFixedLayout(messageRangeValue.minId, messageRangeValue.maxId);
         break;
     default:
         break;
@@ -4704,8 +4636,7 @@ CTelegramStream &CTelegramStream::operator<<(const TLDocumentAttribute &document
 
     switch (documentAttributeValue.tlType) {
     case TLValue::DocumentAttributeImageSize:
-        *this << documentAttributeValue.w;
-        *this << documentAttributeValue.h;
+        writeFixedLayout(documentAttributeValue.w, documentAttributeValue.h);
         break;
     case TLValue::DocumentAttributeAnimated:
         break;
@@ -4714,9 +4645,7 @@ CTelegramStream &CTelegramStream::operator<<(const TLDocumentAttribute &document
         *this << documentAttributeValue.stickerset;
         break;
     case TLValue::DocumentAttributeVideo:
-        *this << documentAttributeValue.duration;
-        *this << documentAttributeValue.w;
-        *this << documentAttributeValue.h;
+        writeFixedLayout(documentAttributeValue.duration, documentAttributeValue.w, documentAttributeValue.h);
         break;
     case TLValue::DocumentAttributeAudio:
         *this << documentAttributeValue.duration;
@@ -4970,3 +4899,877 @@ CTelegramStream &CTelegramStream::operator<<(const TLReplyMarkup &replyMarkupVal
 }
 
 // End of generated write operators implementation
+
+// Generated serialized size implementation
+quint32 CTelegramStream::serializedSize(const TLAccountDaysTTL &accountDaysTTLValue)
+{
+    quint32 size = 4;
+
+    switch (accountDaysTTLValue.tlType) {
+    case TLValue::AccountDaysTTL:
+        size = TLAccountDaysTTL::AccountDaysTTLSize;
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLAccountPasswordInputSettings &accountPasswordInputSettingsValue)
+{
+    quint32 size = 4;
+
+    switch (accountPasswordInputSettingsValue.tlType) {
+    case TLValue::AccountPasswordInputSettings:
+        size += serializedSize(accountPasswordInputSettingsValue.flags);
+        if (accountPasswordInputSettingsValue.flags & 1 << 0) {
+            size += serializedSize(accountPasswordInputSettingsValue.newSalt);
+        }
+        if (accountPasswordInputSettingsValue.flags & 1 << 0) {
+            size += serializedSize(accountPasswordInputSettingsValue.newPasswordHash);
+        }
+        if (accountPasswordInputSettingsValue.flags & 1 << 0) {
+            size += serializedSize(accountPasswordInputSettingsValue.hint);
+        }
+        if (accountPasswordInputSettingsValue.flags & 1 << 1) {
+            size += serializedSize(accountPasswordInputSettingsValue.email);
+        }
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLChannelParticipantRole &channelParticipantRoleValue)
+{
+    quint32 size = 4;
+
+    switch (channelParticipantRoleValue.tlType) {
+    case TLValue::ChannelRoleEmpty:
+    case TLValue::ChannelRoleModerator:
+    case TLValue::ChannelRoleEditor:
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLChannelParticipantsFilter &channelParticipantsFilterValue)
+{
+    quint32 size = 4;
+
+    switch (channelParticipantsFilterValue.tlType) {
+    case TLValue::ChannelParticipantsRecent:
+    case TLValue::ChannelParticipantsAdmins:
+    case TLValue::ChannelParticipantsKicked:
+    case TLValue::ChannelParticipantsBots:
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLInputAppEvent &inputAppEventValue)
+{
+    quint32 size = 4;
+
+    switch (inputAppEventValue.tlType) {
+    case TLValue::InputAppEvent:
+        size += serializedSize(inputAppEventValue.time);
+        size += serializedSize(inputAppEventValue.type);
+        size += serializedSize(inputAppEventValue.peer);
+        size += serializedSize(inputAppEventValue.data);
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLInputAudio &inputAudioValue)
+{
+    quint32 size = 4;
+
+    switch (inputAudioValue.tlType) {
+    case TLValue::InputAudioEmpty:
+        break;
+    case TLValue::InputAudio:
+        size = TLInputAudio::InputAudioSize;
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLInputChannel &inputChannelValue)
+{
+    quint32 size = 4;
+
+    switch (inputChannelValue.tlType) {
+    case TLValue::InputChannelEmpty:
+        break;
+    case TLValue::InputChannel:
+        size = TLInputChannel::InputChannelSize;
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLInputContact &inputContactValue)
+{
+    quint32 size = 4;
+
+    switch (inputContactValue.tlType) {
+    case TLValue::InputPhoneContact:
+        size += serializedSize(inputContactValue.clientId);
+        size += serializedSize(inputContactValue.phone);
+        size += serializedSize(inputContactValue.firstName);
+        size += serializedSize(inputContactValue.lastName);
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLInputDocument &inputDocumentValue)
+{
+    quint32 size = 4;
+
+    switch (inputDocumentValue.tlType) {
+    case TLValue::InputDocumentEmpty:
+        break;
+    case TLValue::InputDocument:
+        size = TLInputDocument::InputDocumentSize;
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLInputEncryptedChat &inputEncryptedChatValue)
+{
+    quint32 size = 4;
+
+    switch (inputEncryptedChatValue.tlType) {
+    case TLValue::InputEncryptedChat:
+        size = TLInputEncryptedChat::InputEncryptedChatSize;
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLInputEncryptedFile &inputEncryptedFileValue)
+{
+    quint32 size = 4;
+
+    switch (inputEncryptedFileValue.tlType) {
+    case TLValue::InputEncryptedFileEmpty:
+        break;
+    case TLValue::InputEncryptedFileUploaded:
+        size += serializedSize(inputEncryptedFileValue.id);
+        size += serializedSize(inputEncryptedFileValue.parts);
+        size += serializedSize(inputEncryptedFileValue.md5Checksum);
+        size += serializedSize(inputEncryptedFileValue.keyFingerprint);
+        break;
+    case TLValue::InputEncryptedFile:
+        size = TLInputEncryptedFile::InputEncryptedFileSize;
+        break;
+    case TLValue::InputEncryptedFileBigUploaded:
+        size = TLInputEncryptedFile::InputEncryptedFileBigUploadedSize;
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLInputFile &inputFileValue)
+{
+    quint32 size = 4;
+
+    switch (inputFileValue.tlType) {
+    case TLValue::InputFile:
+        size += serializedSize(inputFileValue.id);
+        size += serializedSize(inputFileValue.parts);
+        size += serializedSize(inputFileValue.name);
+        size += serializedSize(inputFileValue.md5Checksum);
+        break;
+    case TLValue::InputFileBig:
+        size += serializedSize(inputFileValue.id);
+        size += serializedSize(inputFileValue.parts);
+        size += serializedSize(inputFileValue.name);
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLInputFileLocation &inputFileLocationValue)
+{
+    quint32 size = 4;
+
+    switch (inputFileLocationValue.tlType) {
+    case TLValue::InputFileLocation:
+        size = TLInputFileLocation::InputFileLocationSize;
+        break;
+    case TLValue::InputVideoFileLocation:
+        size = TLInputFileLocation::InputVideoFileLocationSize;
+        break;
+    case TLValue::InputEncryptedFileLocation:
+        size = TLInputFileLocation::InputEncryptedFileLocationSize;
+        break;
+    case TLValue::InputAudioFileLocation:
+        size = TLInputFileLocation::InputAudioFileLocationSize;
+        break;
+    case TLValue::InputDocumentFileLocation:
+        size = TLInputFileLocation::InputDocumentFileLocationSize;
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLInputGeoPoint &inputGeoPointValue)
+{
+    quint32 size = 4;
+
+    switch (inputGeoPointValue.tlType) {
+    case TLValue::InputGeoPointEmpty:
+        break;
+    case TLValue::InputGeoPoint:
+        size = TLInputGeoPoint::InputGeoPointSize;
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLInputPeer &inputPeerValue)
+{
+    quint32 size = 4;
+
+    switch (inputPeerValue.tlType) {
+    case TLValue::InputPeerEmpty:
+    case TLValue::InputPeerSelf:
+        break;
+    case TLValue::InputPeerChat:
+        size = TLInputPeer::InputPeerChatSize;
+        break;
+    case TLValue::InputPeerUser:
+        size = TLInputPeer::InputPeerUserSize;
+        break;
+    case TLValue::InputPeerChannel:
+        size = TLInputPeer::InputPeerChannelSize;
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLInputPeerNotifySettings &inputPeerNotifySettingsValue)
+{
+    quint32 size = 4;
+
+    switch (inputPeerNotifySettingsValue.tlType) {
+    case TLValue::InputPeerNotifySettings:
+        size += serializedSize(inputPeerNotifySettingsValue.muteUntil);
+        size += serializedSize(inputPeerNotifySettingsValue.sound);
+        size += serializedSize(inputPeerNotifySettingsValue.showPreviews);
+        size += serializedSize(inputPeerNotifySettingsValue.eventsMask);
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLInputPhoto &inputPhotoValue)
+{
+    quint32 size = 4;
+
+    switch (inputPhotoValue.tlType) {
+    case TLValue::InputPhotoEmpty:
+        break;
+    case TLValue::InputPhoto:
+        size = TLInputPhoto::InputPhotoSize;
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLInputPhotoCrop &inputPhotoCropValue)
+{
+    quint32 size = 4;
+
+    switch (inputPhotoCropValue.tlType) {
+    case TLValue::InputPhotoCropAuto:
+        break;
+    case TLValue::InputPhotoCrop:
+        size = TLInputPhotoCrop::InputPhotoCropSize;
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLInputPrivacyKey &inputPrivacyKeyValue)
+{
+    quint32 size = 4;
+
+    switch (inputPrivacyKeyValue.tlType) {
+    case TLValue::InputPrivacyKeyStatusTimestamp:
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLInputStickerSet &inputStickerSetValue)
+{
+    quint32 size = 4;
+
+    switch (inputStickerSetValue.tlType) {
+    case TLValue::InputStickerSetEmpty:
+        break;
+    case TLValue::InputStickerSetID:
+        size = TLInputStickerSet::InputStickerSetIDSize;
+        break;
+    case TLValue::InputStickerSetShortName:
+        size += serializedSize(inputStickerSetValue.shortName);
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLInputUser &inputUserValue)
+{
+    quint32 size = 4;
+
+    switch (inputUserValue.tlType) {
+    case TLValue::InputUserEmpty:
+    case TLValue::InputUserSelf:
+        break;
+    case TLValue::InputUser:
+        size = TLInputUser::InputUserSize;
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLInputVideo &inputVideoValue)
+{
+    quint32 size = 4;
+
+    switch (inputVideoValue.tlType) {
+    case TLValue::InputVideoEmpty:
+        break;
+    case TLValue::InputVideo:
+        size = TLInputVideo::InputVideoSize;
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLKeyboardButton &keyboardButtonValue)
+{
+    quint32 size = 4;
+
+    switch (keyboardButtonValue.tlType) {
+    case TLValue::KeyboardButton:
+        size += serializedSize(keyboardButtonValue.text);
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLKeyboardButtonRow &keyboardButtonRowValue)
+{
+    quint32 size = 4;
+
+    switch (keyboardButtonRowValue.tlType) {
+    case TLValue::KeyboardButtonRow:
+        size += serializedSize(keyboardButtonRowValue.buttons);
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLMessageEntity &messageEntityValue)
+{
+    quint32 size = 4;
+
+    switch (messageEntityValue.tlType) {
+    case TLValue::MessageEntityUnknown:
+        size = TLMessageEntity::MessageEntityUnknownSize;
+        break;
+    case TLValue::MessageEntityMention:
+        size = TLMessageEntity::MessageEntityMentionSize;
+        break;
+    case TLValue::MessageEntityHashtag:
+        size = TLMessageEntity::MessageEntityHashtagSize;
+        break;
+    case TLValue::MessageEntityBotCommand:
+        size = TLMessageEntity::MessageEntityBotCommandSize;
+        break;
+    case TLValue::MessageEntityUrl:
+        size = TLMessageEntity::MessageEntityUrlSize;
+        break;
+    case TLValue::MessageEntityEmail:
+        size = TLMessageEntity::MessageEntityEmailSize;
+        break;
+    case TLValue::MessageEntityBold:
+        size = TLMessageEntity::MessageEntityBoldSize;
+        break;
+    case TLValue::MessageEntityItalic:
+        size = TLMessageEntity::MessageEntityItalicSize;
+        break;
+    case TLValue::MessageEntityCode:
+        size = TLMessageEntity::MessageEntityCodeSize;
+        break;
+    case TLValue::MessageEntityPre:
+        size += serializedSize(messageEntityValue.offset);
+        size += serializedSize(messageEntityValue.length);
+        size += serializedSize(messageEntityValue.language);
+        break;
+    case TLValue::MessageEntityTextUrl:
+        size += serializedSize(messageEntityValue.offset);
+        size += serializedSize(messageEntityValue.length);
+        size += serializedSize(messageEntityValue.url);
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLMessageRange &messageRangeValue)
+{
+    quint32 size = 4;
+
+    switch (messageRangeValue.tlType) {
+    case TLValue::MessageRange:
+        size = TLMessageRange::MessageRangeSize;
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLMessagesFilter &messagesFilterValue)
+{
+    quint32 size = 4;
+
+    switch (messagesFilterValue.tlType) {
+    case TLValue::InputMessagesFilterEmpty:
+    case TLValue::InputMessagesFilterPhotos:
+    case TLValue::InputMessagesFilterVideo:
+    case TLValue::InputMessagesFilterPhotoVideo:
+    case TLValue::InputMessagesFilterPhotoVideoDocuments:
+    case TLValue::InputMessagesFilterDocument:
+    case TLValue::InputMessagesFilterAudio:
+    case TLValue::InputMessagesFilterAudioDocuments:
+    case TLValue::InputMessagesFilterUrl:
+    case TLValue::InputMessagesFilterGif:
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLReportReason &reportReasonValue)
+{
+    quint32 size = 4;
+
+    switch (reportReasonValue.tlType) {
+    case TLValue::InputReportReasonSpam:
+    case TLValue::InputReportReasonViolence:
+    case TLValue::InputReportReasonPornography:
+        break;
+    case TLValue::InputReportReasonOther:
+        size += serializedSize(reportReasonValue.text);
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLSendMessageAction &sendMessageActionValue)
+{
+    quint32 size = 4;
+
+    switch (sendMessageActionValue.tlType) {
+    case TLValue::SendMessageTypingAction:
+    case TLValue::SendMessageCancelAction:
+    case TLValue::SendMessageRecordVideoAction:
+    case TLValue::SendMessageRecordAudioAction:
+    case TLValue::SendMessageGeoLocationAction:
+    case TLValue::SendMessageChooseContactAction:
+        break;
+    case TLValue::SendMessageUploadVideoAction:
+        size = TLSendMessageAction::SendMessageUploadVideoActionSize;
+        break;
+    case TLValue::SendMessageUploadAudioAction:
+        size = TLSendMessageAction::SendMessageUploadAudioActionSize;
+        break;
+    case TLValue::SendMessageUploadPhotoAction:
+        size = TLSendMessageAction::SendMessageUploadPhotoActionSize;
+        break;
+    case TLValue::SendMessageUploadDocumentAction:
+        size = TLSendMessageAction::SendMessageUploadDocumentActionSize;
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLChannelMessagesFilter &channelMessagesFilterValue)
+{
+    quint32 size = 4;
+
+    switch (channelMessagesFilterValue.tlType) {
+    case TLValue::ChannelMessagesFilterEmpty:
+    case TLValue::ChannelMessagesFilterCollapsed:
+        break;
+    case TLValue::ChannelMessagesFilter:
+        size += serializedSize(channelMessagesFilterValue.flags);
+        size += serializedSize(channelMessagesFilterValue.ranges);
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLDocumentAttribute &documentAttributeValue)
+{
+    quint32 size = 4;
+
+    switch (documentAttributeValue.tlType) {
+    case TLValue::DocumentAttributeImageSize:
+        size = TLDocumentAttribute::DocumentAttributeImageSizeSize;
+        break;
+    case TLValue::DocumentAttributeAnimated:
+        break;
+    case TLValue::DocumentAttributeSticker:
+        size += serializedSize(documentAttributeValue.alt);
+        size += serializedSize(documentAttributeValue.stickerset);
+        break;
+    case TLValue::DocumentAttributeVideo:
+        size = TLDocumentAttribute::DocumentAttributeVideoSize;
+        break;
+    case TLValue::DocumentAttributeAudio:
+        size += serializedSize(documentAttributeValue.duration);
+        size += serializedSize(documentAttributeValue.title);
+        size += serializedSize(documentAttributeValue.performer);
+        break;
+    case TLValue::DocumentAttributeFilename:
+        size += serializedSize(documentAttributeValue.fileName);
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLInputBotInlineMessage &inputBotInlineMessageValue)
+{
+    quint32 size = 4;
+
+    switch (inputBotInlineMessageValue.tlType) {
+    case TLValue::InputBotInlineMessageMediaAuto:
+        size += serializedSize(inputBotInlineMessageValue.caption);
+        break;
+    case TLValue::InputBotInlineMessageText:
+        size += serializedSize(inputBotInlineMessageValue.flags);
+        size += serializedSize(inputBotInlineMessageValue.message);
+        if (inputBotInlineMessageValue.flags & 1 << 1) {
+            size += serializedSize(inputBotInlineMessageValue.entities);
+        }
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLInputBotInlineResult &inputBotInlineResultValue)
+{
+    quint32 size = 4;
+
+    switch (inputBotInlineResultValue.tlType) {
+    case TLValue::InputBotInlineResult:
+        size += serializedSize(inputBotInlineResultValue.flags);
+        size += serializedSize(inputBotInlineResultValue.id);
+        size += serializedSize(inputBotInlineResultValue.type);
+        if (inputBotInlineResultValue.flags & 1 << 1) {
+            size += serializedSize(inputBotInlineResultValue.title);
+        }
+        if (inputBotInlineResultValue.flags & 1 << 2) {
+            size += serializedSize(inputBotInlineResultValue.description);
+        }
+        if (inputBotInlineResultValue.flags & 1 << 3) {
+            size += serializedSize(inputBotInlineResultValue.url);
+        }
+        if (inputBotInlineResultValue.flags & 1 << 4) {
+            size += serializedSize(inputBotInlineResultValue.thumbUrl);
+        }
+        if (inputBotInlineResultValue.flags & 1 << 5) {
+            size += serializedSize(inputBotInlineResultValue.contentUrl);
+        }
+        if (inputBotInlineResultValue.flags & 1 << 5) {
+            size += serializedSize(inputBotInlineResultValue.contentType);
+        }
+        if (inputBotInlineResultValue.flags & 1 << 6) {
+            size += serializedSize(inputBotInlineResultValue.w);
+        }
+        if (inputBotInlineResultValue.flags & 1 << 6) {
+            size += serializedSize(inputBotInlineResultValue.h);
+        }
+        if (inputBotInlineResultValue.flags & 1 << 7) {
+            size += serializedSize(inputBotInlineResultValue.duration);
+        }
+        size += serializedSize(inputBotInlineResultValue.sendMessage);
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLInputChatPhoto &inputChatPhotoValue)
+{
+    quint32 size = 4;
+
+    switch (inputChatPhotoValue.tlType) {
+    case TLValue::InputChatPhotoEmpty:
+        break;
+    case TLValue::InputChatUploadedPhoto:
+        size += serializedSize(inputChatPhotoValue.file);
+        size += serializedSize(inputChatPhotoValue.crop);
+        break;
+    case TLValue::InputChatPhoto:
+        size += serializedSize(inputChatPhotoValue.id);
+        size += serializedSize(inputChatPhotoValue.crop);
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLInputMedia &inputMediaValue)
+{
+    quint32 size = 4;
+
+    switch (inputMediaValue.tlType) {
+    case TLValue::InputMediaEmpty:
+        break;
+    case TLValue::InputMediaUploadedPhoto:
+        size += serializedSize(inputMediaValue.file);
+        size += serializedSize(inputMediaValue.caption);
+        break;
+    case TLValue::InputMediaPhoto:
+        size += serializedSize(inputMediaValue.inputPhotoId);
+        size += serializedSize(inputMediaValue.caption);
+        break;
+    case TLValue::InputMediaGeoPoint:
+        size += serializedSize(inputMediaValue.geoPoint);
+        break;
+    case TLValue::InputMediaContact:
+        size += serializedSize(inputMediaValue.phoneNumber);
+        size += serializedSize(inputMediaValue.firstName);
+        size += serializedSize(inputMediaValue.lastName);
+        break;
+    case TLValue::InputMediaUploadedVideo:
+        size += serializedSize(inputMediaValue.file);
+        size += serializedSize(inputMediaValue.duration);
+        size += serializedSize(inputMediaValue.w);
+        size += serializedSize(inputMediaValue.h);
+        size += serializedSize(inputMediaValue.mimeType);
+        size += serializedSize(inputMediaValue.caption);
+        break;
+    case TLValue::InputMediaUploadedThumbVideo:
+        size += serializedSize(inputMediaValue.file);
+        size += serializedSize(inputMediaValue.thumb);
+        size += serializedSize(inputMediaValue.duration);
+        size += serializedSize(inputMediaValue.w);
+        size += serializedSize(inputMediaValue.h);
+        size += serializedSize(inputMediaValue.mimeType);
+        size += serializedSize(inputMediaValue.caption);
+        break;
+    case TLValue::InputMediaVideo:
+        size += serializedSize(inputMediaValue.inputVideoId);
+        size += serializedSize(inputMediaValue.caption);
+        break;
+    case TLValue::InputMediaUploadedAudio:
+        size += serializedSize(inputMediaValue.file);
+        size += serializedSize(inputMediaValue.duration);
+        size += serializedSize(inputMediaValue.mimeType);
+        break;
+    case TLValue::InputMediaAudio:
+        size += serializedSize(inputMediaValue.inputAudioId);
+        break;
+    case TLValue::InputMediaUploadedDocument:
+        size += serializedSize(inputMediaValue.file);
+        size += serializedSize(inputMediaValue.mimeType);
+        size += serializedSize(inputMediaValue.attributes);
+        size += serializedSize(inputMediaValue.caption);
+        break;
+    case TLValue::InputMediaUploadedThumbDocument:
+        size += serializedSize(inputMediaValue.file);
+        size += serializedSize(inputMediaValue.thumb);
+        size += serializedSize(inputMediaValue.mimeType);
+        size += serializedSize(inputMediaValue.attributes);
+        size += serializedSize(inputMediaValue.caption);
+        break;
+    case TLValue::InputMediaDocument:
+        size += serializedSize(inputMediaValue.inputDocumentId);
+        size += serializedSize(inputMediaValue.caption);
+        break;
+    case TLValue::InputMediaVenue:
+        size += serializedSize(inputMediaValue.geoPoint);
+        size += serializedSize(inputMediaValue.title);
+        size += serializedSize(inputMediaValue.address);
+        size += serializedSize(inputMediaValue.provider);
+        size += serializedSize(inputMediaValue.venueId);
+        break;
+    case TLValue::InputMediaGifExternal:
+        size += serializedSize(inputMediaValue.url);
+        size += serializedSize(inputMediaValue.q);
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLInputNotifyPeer &inputNotifyPeerValue)
+{
+    quint32 size = 4;
+
+    switch (inputNotifyPeerValue.tlType) {
+    case TLValue::InputNotifyPeer:
+        size += serializedSize(inputNotifyPeerValue.peer);
+        break;
+    case TLValue::InputNotifyUsers:
+    case TLValue::InputNotifyChats:
+    case TLValue::InputNotifyAll:
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLInputPrivacyRule &inputPrivacyRuleValue)
+{
+    quint32 size = 4;
+
+    switch (inputPrivacyRuleValue.tlType) {
+    case TLValue::InputPrivacyValueAllowContacts:
+    case TLValue::InputPrivacyValueAllowAll:
+    case TLValue::InputPrivacyValueDisallowContacts:
+    case TLValue::InputPrivacyValueDisallowAll:
+        break;
+    case TLValue::InputPrivacyValueAllowUsers:
+    case TLValue::InputPrivacyValueDisallowUsers:
+        size += serializedSize(inputPrivacyRuleValue.users);
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+quint32 CTelegramStream::serializedSize(const TLReplyMarkup &replyMarkupValue)
+{
+    quint32 size = 4;
+
+    switch (replyMarkupValue.tlType) {
+    case TLValue::ReplyKeyboardHide:
+        size = TLReplyMarkup::ReplyKeyboardHideSize;
+        break;
+    case TLValue::ReplyKeyboardForceReply:
+        size = TLReplyMarkup::ReplyKeyboardForceReplySize;
+        break;
+    case TLValue::ReplyKeyboardMarkup:
+        size += serializedSize(replyMarkupValue.flags);
+        size += serializedSize(replyMarkupValue.rows);
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+// End of generated serialized size implementation
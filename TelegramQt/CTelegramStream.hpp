@@ -23,8 +23,11 @@
 
 #include "CRawStream.hpp"
 #include "TLNumbers.hpp"
+#include "TLString.hpp"
 #include "TLTypes.hpp"
 
+struct TLTypeDescriptor;
+
 class CTelegramStream : public CRawStreamEx
 {
 public:
@@ -38,6 +41,9 @@ public:
     CTelegramStream &operator>>(QString &str);
     CTelegramStream &operator<<(const QString &str);
 
+    CTelegramStream &operator>>(TLString &str);
+    CTelegramStream &operator<<(const TLString &str);
+
     CTelegramStream &operator>>(bool &data);
     CTelegramStream &operator<<(const bool &data);
 
@@ -57,6 +63,27 @@ public:
     template <int Size>
     CTelegramStream &operator>>(TLNumber<Size> &n);
 
+    // The exact number of bytes, which the value takes in the stream
+    static constexpr quint32 serializedSize(TLValue) { return 4; }
+    static constexpr quint32 serializedSize(bool) { return 4; }
+    static constexpr quint32 serializedSize(quint32) { return 4; }
+    static constexpr quint32 serializedSize(quint64) { return 8; }
+    static constexpr quint32 serializedSize(double) { return 8; }
+    static constexpr quint32 serializedBytesSize(quint32 length)
+    {
+        return ((length < 0xfe ? length + 1 : length + 4) + 3) & ~3u;
+    }
+    static quint32 serializedSize(const QByteArray &data) { return serializedBytesSize(data.size()); }
+    static quint32 serializedSize(const TLString &str) { return serializedBytesSize(str.utf8Size()); }
+    static quint32 serializedSize(const QString &str);
+
+    template <typename T>
+    static quint32 serializedSize(const TLVector<T> &v);
+    template <typename T>
+    static quint32 serializedSize(const TLVector<T*> &v);
+    template <int Size>
+    static constexpr quint32 serializedSize(const TLNumber<Size> &) { return Size / 8; }
+
     // Generated read operators
     CTelegramStream &operator>>(TLAccountDaysTTL &accountDaysTTLValue);
     CTelegramStream &operator>>(TLAccountPassword &accountPasswordValue);
@@ -241,13 +268,87 @@ public:
     CTelegramStream &operator<<(const TLInputPrivacyRule &inputPrivacyRuleValue);
     CTelegramStream &operator<<(const TLReplyMarkup &replyMarkupValue);
     // End of generated write operators
+
+    // Generated serialized size declarations
+    static quint32 serializedSize(const TLAccountDaysTTL &accountDaysTTLValue);
+    static quint32 serializedSize(const TLAccountPasswordInputSettings &accountPasswordInputSettingsValue);
+    static quint32 serializedSize(const TLChannelParticipantRole &channelParticipantRoleValue);
+    static quint32 serializedSize(const TLChannelParticipantsFilter &channelParticipantsFilterValue);
+    static quint32 serializedSize(const TLInputAppEvent &inputAppEventValue);
+    static quint32 serializedSize(const TLInputAudio &inputAudioValue);
+    static quint32 serializedSize(const TLInputChannel &inputChannelValue);
+    static quint32 serializedSize(const TLInputContact &inputContactValue);
+    static quint32 serializedSize(const TLInputDocument &inputDocumentValue);
+    static quint32 serializedSize(const TLInputEncryptedChat &inputEncryptedChatValue);
+    static quint32 serializedSize(const TLInputEncryptedFile &inputEncryptedFileValue);
+    static quint32 serializedSize(const TLInputFile &inputFileValue);
+    static quint32 serializedSize(const TLInputFileLocation &inputFileLocationValue);
+    static quint32 serializedSize(const TLInputGeoPoint &inputGeoPointValue);
+    static quint32 serializedSize(const TLInputPeer &inputPeerValue);
+    static quint32 serializedSize(const TLInputPeerNotifySettings &inputPeerNotifySettingsValue);
+    static quint32 serializedSize(const TLInputPhoto &inputPhotoValue);
+    static quint32 serializedSize(const TLInputPhotoCrop &inputPhotoCropValue);
+    static quint32 serializedSize(const TLInputPrivacyKey &inputPrivacyKeyValue);
+    static quint32 serializedSize(const TLInputStickerSet &inputStickerSetValue);
+    static quint32 serializedSize(const TLInputUser &inputUserValue);
+    static quint32 serializedSize(const TLInputVideo &inputVideoValue);
+    static quint32 serializedSize(const TLKeyboardButton &keyboardButtonValue);
+    static quint32 serializedSize(const TLKeyboardButtonRow &keyboardButtonRowValue);
+    static quint32 serializedSize(const TLMessageEntity &messageEntityValue);
+    static quint32 serializedSize(const TLMessageRange &messageRangeValue);
+    static quint32 serializedSize(const TLMessagesFilter &messagesFilterValue);
+    static quint32 serializedSize(const TLReportReason &reportReasonValue);
+    static quint32 serializedSize(const TLSendMessageAction &sendMessageActionValue);
+    static quint32 serializedSize(const TLChannelMessagesFilter &channelMessagesFilterValue);
+    static quint32 serializedSize(const TLDocumentAttribute &documentAttributeValue);
+    static quint32 serializedSize(const TLInputBotInlineMessage &inputBotInlineMessageValue);
+    static quint32 serializedSize(const TLInputBotInlineResult &inputBotInlineResultValue);
+    static quint32 serializedSize(const TLInputChatPhoto &inputChatPhotoValue);
+    static quint32 serializedSize(const TLInputMedia &inputMediaValue);
+    static quint32 serializedSize(const TLInputNotifyPeer &inputNotifyPeerValue);
+    static quint32 serializedSize(const TLInputPrivacyRule &inputPrivacyRuleValue);
+    static quint32 serializedSize(const TLReplyMarkup &replyMarkupValue);
+    // End of generated serialized size declarations
+
+#ifdef TELEGRAMQT_TABLE_DECODER
+protected:
+    // Reads a TL type described by the generated tables (see CTelegramStreamTables.cpp)
+    void readByDescriptor(void *object, TLValue *tlType, const TLTypeDescriptor &descriptor);
+#endif
 };
 
+template <typename T>
+quint32 CTelegramStream::serializedSize(const TLVector<T> &v)
+{
+    quint32 size = 8; // Vector type id and the length
+    for (const T &value : v) {
+        size += serializedSize(value);
+    }
+    return size;
+}
+
+template <typename T>
+quint32 CTelegramStream::serializedSize(const TLVector<T*> &v)
+{
+    quint32 size = 8; // Vector type id and the length
+    for (const T *value : v) {
+        size += serializedSize(*value);
+    }
+    return size;
+}
+
 inline CTelegramStream &CTelegramStream::operator>>(QString &str)
 {
-    QByteArray data;
-    *this >> data;
-    str = QString::fromUtf8(data);
+    QByteArray buffer;
+    int offset;
+    int size;
+    if (readBytesSlice(&buffer, &offset, &size)) {
+        str = QString::fromUtf8(buffer.constData() + offset, size);
+    } else {
+        QByteArray data;
+        *this >> data;
+        str = QString::fromUtf8(data);
+    }
     return *this;
 }
 
@@ -257,6 +358,27 @@ inline CTelegramStream &CTelegramStream::operator<<(const QString &str)
     return *this;
 }
 
+inline CTelegramStream &CTelegramStream::operator>>(TLString &str)
+{
+    QByteArray buffer;
+    int offset;
+    int size;
+    if (readBytesSlice(&buffer, &offset, &size)) {
+        str = TLString::fromSlice(buffer, offset, size);
+    } else {
+        QByteArray data;
+        *this >> data;
+        str = TLString::fromUtf8(data);
+    }
+    return *this;
+}
+
+inline CTelegramStream &CTelegramStream::operator<<(const TLString &str)
+{
+    *this << str.toUtf8();
+    return *this;
+}
+
 inline CTelegramStream &CTelegramStream::operator>>(bool &data)
 {
     TLValue val;
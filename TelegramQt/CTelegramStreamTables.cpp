@@ -0,0 +1,4040 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+/* Table-driven replacement of the generated read operators.
+ *
+ * Instead of an expanded switch per type, each type is described by a constant table of constructors
+ * and fields, and the single readByDescriptor() loop decodes all of them. This trades some speed
+ * on the hot path for a much smaller object code. Enabled by the TABLE_DECODER build option.
+ */
+
+#include "CTelegramStream.hpp"
+#include "CTelegramStream_p.hpp"
+
+#include <QDebug>
+
+typedef void *(*TLFieldAccessor)(void *object);
+typedef void (*TLFieldReader)(CTelegramStream &stream, void *field);
+
+struct TLFieldDescriptor
+{
+    enum Kind : quint8 {
+        UInt32,
+        UInt64,
+        Double,
+        Bool,
+        String,
+        Bytes,
+        Custom, // Read with the reader function
+    };
+
+    TLFieldAccessor field;
+    Kind kind;
+    qint8 flagBit; // -1 if the field is always present
+    TLFieldAccessor flags;
+    TLFieldReader reader;
+};
+
+struct TLConstructorDescriptor
+{
+    quint32 id;
+    quint16 firstField;
+    quint16 fieldsCount;
+};
+
+struct TLTypeDescriptor
+{
+    const TLConstructorDescriptor *constructors;
+    quint32 constructorsCount;
+    const TLFieldDescriptor *fields;
+};
+
+// The TL types are not standard-layout (TLVector adds a member to QVector), so the fields are addressed
+// with member pointers rather than offsetof(). The instances are shared by the constructors of a type.
+template <typename T, typename F, F T::*member>
+static void *fieldAddress(void *object)
+{
+    return &(static_cast<T*>(object)->*member);
+}
+
+template <typename T>
+static void readField(CTelegramStream &stream, void *field)
+{
+    stream >> *static_cast<T*>(field);
+}
+
+template <typename T>
+static void readPointerField(CTelegramStream &stream, void *field)
+{
+    T **value = static_cast<T**>(field);
+    if (!*value) {
+        *value = new T();
+    }
+    stream >> **value;
+}
+
+void CTelegramStream::readByDescriptor(void *object, TLValue *tlType, const TLTypeDescriptor &descriptor)
+{
+    *this >> *tlType;
+
+    const TLConstructorDescriptor *constructor = nullptr;
+    for (quint32 i = 0; i < descriptor.constructorsCount; ++i) {
+        if (descriptor.constructors[i].id == *tlType) {
+            constructor = &descriptor.constructors[i];
+            break;
+        }
+    }
+
+    if (!constructor) {
+        return; // Unknown constructor; the same as the default branch of the expanded code
+    }
+
+    const TLFieldDescriptor *field = descriptor.fields + constructor->firstField;
+    const TLFieldDescriptor *end = field + constructor->fieldsCount;
+
+    for ( ; field != end; ++field) {
+        if (field->flagBit >= 0) {
+            const quint32 flags = *static_cast<const quint32*>(field->flags(object));
+            if (!(flags & 1 << field->flagBit)) {
+                continue;
+            }
+        }
+
+        void *data = field->field(object);
+        switch (field->kind) {
+        case TLFieldDescriptor::UInt32:
+            *this >> *static_cast<quint32*>(data);
+            break;
+        case TLFieldDescriptor::UInt64:
+            *this >> *static_cast<quint64*>(data);
+            break;
+        case TLFieldDescriptor::Double:
+            *this >> *static_cast<double*>(data);
+            break;
+        case TLFieldDescriptor::Bool:
+            *this >> *static_cast<bool*>(data);
+            break;
+        case TLFieldDescriptor::String:
+            *this >> *static_cast<QString*>(data);
+            break;
+        case TLFieldDescriptor::Bytes:
+            *this >> *static_cast<QByteArray*>(data);
+            break;
+        case TLFieldDescriptor::Custom:
+            field->reader(*this, data);
+            break;
+        }
+    }
+}
+
+// Generated read tables
+static const TLFieldDescriptor s_accountDaysTTLFields[] = {
+    { &fieldAddress<TLAccountDaysTTL, decltype(TLAccountDaysTTL::days), &TLAccountDaysTTL::days>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_accountDaysTTLConstructors[] = {
+    { TLValue::AccountDaysTTL, 0, 1 },
+};
+
+static const TLTypeDescriptor s_accountDaysTTLDescriptor = { s_accountDaysTTLConstructors, 1, s_accountDaysTTLFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLAccountDaysTTL &accountDaysTTLValue)
+{
+    TLAccountDaysTTL result;
+
+    readByDescriptor(&result, &result.tlType, s_accountDaysTTLDescriptor);
+
+    accountDaysTTLValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_accountPasswordFields[] = {
+    { &fieldAddress<TLAccountPassword, decltype(TLAccountPassword::newSalt), &TLAccountPassword::newSalt>, TLFieldDescriptor::Bytes, -1, nullptr, nullptr },
+    { &fieldAddress<TLAccountPassword, decltype(TLAccountPassword::emailUnconfirmedPattern), &TLAccountPassword::emailUnconfirmedPattern>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLAccountPassword, decltype(TLAccountPassword::currentSalt), &TLAccountPassword::currentSalt>, TLFieldDescriptor::Bytes, -1, nullptr, nullptr },
+    { &fieldAddress<TLAccountPassword, decltype(TLAccountPassword::newSalt), &TLAccountPassword::newSalt>, TLFieldDescriptor::Bytes, -1, nullptr, nullptr },
+    { &fieldAddress<TLAccountPassword, decltype(TLAccountPassword::hint), &TLAccountPassword::hint>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLAccountPassword, decltype(TLAccountPassword::hasRecovery), &TLAccountPassword::hasRecovery>, TLFieldDescriptor::Bool, -1, nullptr, nullptr },
+    { &fieldAddress<TLAccountPassword, decltype(TLAccountPassword::emailUnconfirmedPattern), &TLAccountPassword::emailUnconfirmedPattern>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_accountPasswordConstructors[] = {
+    { TLValue::AccountNoPassword, 0, 2 },
+    { TLValue::AccountPassword, 2, 5 },
+};
+
+static const TLTypeDescriptor s_accountPasswordDescriptor = { s_accountPasswordConstructors, 2, s_accountPasswordFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLAccountPassword &accountPasswordValue)
+{
+    TLAccountPassword result;
+
+    readByDescriptor(&result, &result.tlType, s_accountPasswordDescriptor);
+
+    accountPasswordValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_accountPasswordInputSettingsFields[] = {
+    { &fieldAddress<TLAccountPasswordInputSettings, decltype(TLAccountPasswordInputSettings::flags), &TLAccountPasswordInputSettings::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLAccountPasswordInputSettings, decltype(TLAccountPasswordInputSettings::newSalt), &TLAccountPasswordInputSettings::newSalt>, TLFieldDescriptor::Bytes, 0, &fieldAddress<TLAccountPasswordInputSettings, decltype(TLAccountPasswordInputSettings::flags), &TLAccountPasswordInputSettings::flags>, nullptr },
+    { &fieldAddress<TLAccountPasswordInputSettings, decltype(TLAccountPasswordInputSettings::newPasswordHash), &TLAccountPasswordInputSettings::newPasswordHash>, TLFieldDescriptor::Bytes, 0, &fieldAddress<TLAccountPasswordInputSettings, decltype(TLAccountPasswordInputSettings::flags), &TLAccountPasswordInputSettings::flags>, nullptr },
+    { &fieldAddress<TLAccountPasswordInputSettings, decltype(TLAccountPasswordInputSettings::hint), &TLAccountPasswordInputSettings::hint>, TLFieldDescriptor::String, 0, &fieldAddress<TLAccountPasswordInputSettings, decltype(TLAccountPasswordInputSettings::flags), &TLAccountPasswordInputSettings::flags>, nullptr },
+    { &fieldAddress<TLAccountPasswordInputSettings, decltype(TLAccountPasswordInputSettings::email), &TLAccountPasswordInputSettings::email>, TLFieldDescriptor::String, 1, &fieldAddress<TLAccountPasswordInputSettings, decltype(TLAccountPasswordInputSettings::flags), &TLAccountPasswordInputSettings::flags>, nullptr },
+};
+
+static const TLConstructorDescriptor s_accountPasswordInputSettingsConstructors[] = {
+    { TLValue::AccountPasswordInputSettings, 0, 5 },
+};
+
+static const TLTypeDescriptor s_accountPasswordInputSettingsDescriptor = { s_accountPasswordInputSettingsConstructors, 1, s_accountPasswordInputSettingsFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLAccountPasswordInputSettings &accountPasswordInputSettingsValue)
+{
+    TLAccountPasswordInputSettings result;
+
+    readByDescriptor(&result, &result.tlType, s_accountPasswordInputSettingsDescriptor);
+
+    accountPasswordInputSettingsValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_accountPasswordSettingsFields[] = {
+    { &fieldAddress<TLAccountPasswordSettings, decltype(TLAccountPasswordSettings::email), &TLAccountPasswordSettings::email>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_accountPasswordSettingsConstructors[] = {
+    { TLValue::AccountPasswordSettings, 0, 1 },
+};
+
+static const TLTypeDescriptor s_accountPasswordSettingsDescriptor = { s_accountPasswordSettingsConstructors, 1, s_accountPasswordSettingsFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLAccountPasswordSettings &accountPasswordSettingsValue)
+{
+    TLAccountPasswordSettings result;
+
+    readByDescriptor(&result, &result.tlType, s_accountPasswordSettingsDescriptor);
+
+    accountPasswordSettingsValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_accountSentChangePhoneCodeFields[] = {
+    { &fieldAddress<TLAccountSentChangePhoneCode, decltype(TLAccountSentChangePhoneCode::phoneCodeHash), &TLAccountSentChangePhoneCode::phoneCodeHash>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLAccountSentChangePhoneCode, decltype(TLAccountSentChangePhoneCode::sendCallTimeout), &TLAccountSentChangePhoneCode::sendCallTimeout>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_accountSentChangePhoneCodeConstructors[] = {
+    { TLValue::AccountSentChangePhoneCode, 0, 2 },
+};
+
+static const TLTypeDescriptor s_accountSentChangePhoneCodeDescriptor = { s_accountSentChangePhoneCodeConstructors, 1, s_accountSentChangePhoneCodeFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLAccountSentChangePhoneCode &accountSentChangePhoneCodeValue)
+{
+    TLAccountSentChangePhoneCode result;
+
+    readByDescriptor(&result, &result.tlType, s_accountSentChangePhoneCodeDescriptor);
+
+    accountSentChangePhoneCodeValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_audioFields[] = {
+    { &fieldAddress<TLAudio, decltype(TLAudio::id), &TLAudio::id>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLAudio, decltype(TLAudio::id), &TLAudio::id>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLAudio, decltype(TLAudio::accessHash), &TLAudio::accessHash>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLAudio, decltype(TLAudio::date), &TLAudio::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLAudio, decltype(TLAudio::duration), &TLAudio::duration>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLAudio, decltype(TLAudio::mimeType), &TLAudio::mimeType>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLAudio, decltype(TLAudio::size), &TLAudio::size>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLAudio, decltype(TLAudio::dcId), &TLAudio::dcId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_audioConstructors[] = {
+    { TLValue::AudioEmpty, 0, 1 },
+    { TLValue::Audio, 1, 7 },
+};
+
+static const TLTypeDescriptor s_audioDescriptor = { s_audioConstructors, 2, s_audioFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLAudio &audioValue)
+{
+    TLAudio result;
+
+    readByDescriptor(&result, &result.tlType, s_audioDescriptor);
+
+    audioValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_authCheckedPhoneFields[] = {
+    { &fieldAddress<TLAuthCheckedPhone, decltype(TLAuthCheckedPhone::phoneRegistered), &TLAuthCheckedPhone::phoneRegistered>, TLFieldDescriptor::Bool, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_authCheckedPhoneConstructors[] = {
+    { TLValue::AuthCheckedPhone, 0, 1 },
+};
+
+static const TLTypeDescriptor s_authCheckedPhoneDescriptor = { s_authCheckedPhoneConstructors, 1, s_authCheckedPhoneFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLAuthCheckedPhone &authCheckedPhoneValue)
+{
+    TLAuthCheckedPhone result;
+
+    readByDescriptor(&result, &result.tlType, s_authCheckedPhoneDescriptor);
+
+    authCheckedPhoneValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_authExportedAuthorizationFields[] = {
+    { &fieldAddress<TLAuthExportedAuthorization, decltype(TLAuthExportedAuthorization::id), &TLAuthExportedAuthorization::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLAuthExportedAuthorization, decltype(TLAuthExportedAuthorization::bytes), &TLAuthExportedAuthorization::bytes>, TLFieldDescriptor::Bytes, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_authExportedAuthorizationConstructors[] = {
+    { TLValue::AuthExportedAuthorization, 0, 2 },
+};
+
+static const TLTypeDescriptor s_authExportedAuthorizationDescriptor = { s_authExportedAuthorizationConstructors, 1, s_authExportedAuthorizationFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLAuthExportedAuthorization &authExportedAuthorizationValue)
+{
+    TLAuthExportedAuthorization result;
+
+    readByDescriptor(&result, &result.tlType, s_authExportedAuthorizationDescriptor);
+
+    authExportedAuthorizationValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_authPasswordRecoveryFields[] = {
+    { &fieldAddress<TLAuthPasswordRecovery, decltype(TLAuthPasswordRecovery::emailPattern), &TLAuthPasswordRecovery::emailPattern>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_authPasswordRecoveryConstructors[] = {
+    { TLValue::AuthPasswordRecovery, 0, 1 },
+};
+
+static const TLTypeDescriptor s_authPasswordRecoveryDescriptor = { s_authPasswordRecoveryConstructors, 1, s_authPasswordRecoveryFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLAuthPasswordRecovery &authPasswordRecoveryValue)
+{
+    TLAuthPasswordRecovery result;
+
+    readByDescriptor(&result, &result.tlType, s_authPasswordRecoveryDescriptor);
+
+    authPasswordRecoveryValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_authSentCodeFields[] = {
+    { &fieldAddress<TLAuthSentCode, decltype(TLAuthSentCode::phoneRegistered), &TLAuthSentCode::phoneRegistered>, TLFieldDescriptor::Bool, -1, nullptr, nullptr },
+    { &fieldAddress<TLAuthSentCode, decltype(TLAuthSentCode::phoneCodeHash), &TLAuthSentCode::phoneCodeHash>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLAuthSentCode, decltype(TLAuthSentCode::sendCallTimeout), &TLAuthSentCode::sendCallTimeout>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLAuthSentCode, decltype(TLAuthSentCode::isPassword), &TLAuthSentCode::isPassword>, TLFieldDescriptor::Bool, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_authSentCodeConstructors[] = {
+    { TLValue::AuthSentCode, 0, 4 },
+    { TLValue::AuthSentAppCode, 0, 4 },
+};
+
+static const TLTypeDescriptor s_authSentCodeDescriptor = { s_authSentCodeConstructors, 2, s_authSentCodeFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLAuthSentCode &authSentCodeValue)
+{
+    TLAuthSentCode result;
+
+    readByDescriptor(&result, &result.tlType, s_authSentCodeDescriptor);
+
+    authSentCodeValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_authorizationFields[] = {
+    { &fieldAddress<TLAuthorization, decltype(TLAuthorization::hash), &TLAuthorization::hash>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLAuthorization, decltype(TLAuthorization::flags), &TLAuthorization::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLAuthorization, decltype(TLAuthorization::deviceModel), &TLAuthorization::deviceModel>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLAuthorization, decltype(TLAuthorization::platform), &TLAuthorization::platform>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLAuthorization, decltype(TLAuthorization::systemVersion), &TLAuthorization::systemVersion>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLAuthorization, decltype(TLAuthorization::apiId), &TLAuthorization::apiId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLAuthorization, decltype(TLAuthorization::appName), &TLAuthorization::appName>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLAuthorization, decltype(TLAuthorization::appVersion), &TLAuthorization::appVersion>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLAuthorization, decltype(TLAuthorization::dateCreated), &TLAuthorization::dateCreated>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLAuthorization, decltype(TLAuthorization::dateActive), &TLAuthorization::dateActive>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLAuthorization, decltype(TLAuthorization::ip), &TLAuthorization::ip>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLAuthorization, decltype(TLAuthorization::country), &TLAuthorization::country>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLAuthorization, decltype(TLAuthorization::region), &TLAuthorization::region>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_authorizationConstructors[] = {
+    { TLValue::Authorization, 0, 13 },
+};
+
+static const TLTypeDescriptor s_authorizationDescriptor = { s_authorizationConstructors, 1, s_authorizationFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLAuthorization &authorizationValue)
+{
+    TLAuthorization result;
+
+    readByDescriptor(&result, &result.tlType, s_authorizationDescriptor);
+
+    authorizationValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_botCommandFields[] = {
+    { &fieldAddress<TLBotCommand, decltype(TLBotCommand::command), &TLBotCommand::command>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLBotCommand, decltype(TLBotCommand::description), &TLBotCommand::description>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_botCommandConstructors[] = {
+    { TLValue::BotCommand, 0, 2 },
+};
+
+static const TLTypeDescriptor s_botCommandDescriptor = { s_botCommandConstructors, 1, s_botCommandFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLBotCommand &botCommandValue)
+{
+    TLBotCommand result;
+
+    readByDescriptor(&result, &result.tlType, s_botCommandDescriptor);
+
+    botCommandValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_botInfoFields[] = {
+    { &fieldAddress<TLBotInfo, decltype(TLBotInfo::userId), &TLBotInfo::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLBotInfo, decltype(TLBotInfo::version), &TLBotInfo::version>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLBotInfo, decltype(TLBotInfo::shareText), &TLBotInfo::shareText>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLBotInfo, decltype(TLBotInfo::description), &TLBotInfo::description>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLBotInfo, decltype(TLBotInfo::commands), &TLBotInfo::commands>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLBotCommand>> },
+};
+
+static const TLConstructorDescriptor s_botInfoConstructors[] = {
+    { TLValue::BotInfoEmpty, 0, 0 },
+    { TLValue::BotInfo, 0, 5 },
+};
+
+static const TLTypeDescriptor s_botInfoDescriptor = { s_botInfoConstructors, 2, s_botInfoFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLBotInfo &botInfoValue)
+{
+    TLBotInfo result;
+
+    readByDescriptor(&result, &result.tlType, s_botInfoDescriptor);
+
+    botInfoValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_channelParticipantFields[] = {
+    { &fieldAddress<TLChannelParticipant, decltype(TLChannelParticipant::userId), &TLChannelParticipant::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChannelParticipant, decltype(TLChannelParticipant::date), &TLChannelParticipant::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChannelParticipant, decltype(TLChannelParticipant::userId), &TLChannelParticipant::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChannelParticipant, decltype(TLChannelParticipant::inviterId), &TLChannelParticipant::inviterId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChannelParticipant, decltype(TLChannelParticipant::date), &TLChannelParticipant::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChannelParticipant, decltype(TLChannelParticipant::userId), &TLChannelParticipant::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChannelParticipant, decltype(TLChannelParticipant::kickedBy), &TLChannelParticipant::kickedBy>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChannelParticipant, decltype(TLChannelParticipant::date), &TLChannelParticipant::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChannelParticipant, decltype(TLChannelParticipant::userId), &TLChannelParticipant::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_channelParticipantConstructors[] = {
+    { TLValue::ChannelParticipant, 0, 2 },
+    { TLValue::ChannelParticipantSelf, 2, 3 },
+    { TLValue::ChannelParticipantModerator, 2, 3 },
+    { TLValue::ChannelParticipantEditor, 2, 3 },
+    { TLValue::ChannelParticipantKicked, 5, 3 },
+    { TLValue::ChannelParticipantCreator, 8, 1 },
+};
+
+static const TLTypeDescriptor s_channelParticipantDescriptor = { s_channelParticipantConstructors, 6, s_channelParticipantFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLChannelParticipant &channelParticipantValue)
+{
+    TLChannelParticipant result;
+
+    readByDescriptor(&result, &result.tlType, s_channelParticipantDescriptor);
+
+    channelParticipantValue = result;
+
+    return *this;
+}
+
+static const TLConstructorDescriptor s_channelParticipantRoleConstructors[] = {
+    { TLValue::ChannelRoleEmpty, 0, 0 },
+    { TLValue::ChannelRoleModerator, 0, 0 },
+    { TLValue::ChannelRoleEditor, 0, 0 },
+};
+
+static const TLTypeDescriptor s_channelParticipantRoleDescriptor = { s_channelParticipantRoleConstructors, 3, nullptr };
+
+CTelegramStream &CTelegramStream::operator>>(TLChannelParticipantRole &channelParticipantRoleValue)
+{
+    TLChannelParticipantRole result;
+
+    readByDescriptor(&result, &result.tlType, s_channelParticipantRoleDescriptor);
+
+    channelParticipantRoleValue = result;
+
+    return *this;
+}
+
+static const TLConstructorDescriptor s_channelParticipantsFilterConstructors[] = {
+    { TLValue::ChannelParticipantsRecent, 0, 0 },
+    { TLValue::ChannelParticipantsAdmins, 0, 0 },
+    { TLValue::ChannelParticipantsKicked, 0, 0 },
+    { TLValue::ChannelParticipantsBots, 0, 0 },
+};
+
+static const TLTypeDescriptor s_channelParticipantsFilterDescriptor = { s_channelParticipantsFilterConstructors, 4, nullptr };
+
+CTelegramStream &CTelegramStream::operator>>(TLChannelParticipantsFilter &channelParticipantsFilterValue)
+{
+    TLChannelParticipantsFilter result;
+
+    readByDescriptor(&result, &result.tlType, s_channelParticipantsFilterDescriptor);
+
+    channelParticipantsFilterValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_chatParticipantFields[] = {
+    { &fieldAddress<TLChatParticipant, decltype(TLChatParticipant::userId), &TLChatParticipant::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChatParticipant, decltype(TLChatParticipant::inviterId), &TLChatParticipant::inviterId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChatParticipant, decltype(TLChatParticipant::date), &TLChatParticipant::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChatParticipant, decltype(TLChatParticipant::userId), &TLChatParticipant::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_chatParticipantConstructors[] = {
+    { TLValue::ChatParticipant, 0, 3 },
+    { TLValue::ChatParticipantCreator, 3, 1 },
+    { TLValue::ChatParticipantAdmin, 0, 3 },
+};
+
+static const TLTypeDescriptor s_chatParticipantDescriptor = { s_chatParticipantConstructors, 3, s_chatParticipantFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLChatParticipant &chatParticipantValue)
+{
+    TLChatParticipant result;
+
+    readByDescriptor(&result, &result.tlType, s_chatParticipantDescriptor);
+
+    chatParticipantValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_chatParticipantsFields[] = {
+    { &fieldAddress<TLChatParticipants, decltype(TLChatParticipants::flags), &TLChatParticipants::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChatParticipants, decltype(TLChatParticipants::chatId), &TLChatParticipants::chatId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChatParticipants, decltype(TLChatParticipants::selfParticipant), &TLChatParticipants::selfParticipant>, TLFieldDescriptor::Custom, 0, &fieldAddress<TLChatParticipants, decltype(TLChatParticipants::flags), &TLChatParticipants::flags>, &readField<TLChatParticipant> },
+    { &fieldAddress<TLChatParticipants, decltype(TLChatParticipants::chatId), &TLChatParticipants::chatId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChatParticipants, decltype(TLChatParticipants::participants), &TLChatParticipants::participants>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLChatParticipant>> },
+    { &fieldAddress<TLChatParticipants, decltype(TLChatParticipants::version), &TLChatParticipants::version>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_chatParticipantsConstructors[] = {
+    { TLValue::ChatParticipantsForbidden, 0, 3 },
+    { TLValue::ChatParticipants, 3, 3 },
+};
+
+static const TLTypeDescriptor s_chatParticipantsDescriptor = { s_chatParticipantsConstructors, 2, s_chatParticipantsFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLChatParticipants &chatParticipantsValue)
+{
+    TLChatParticipants result;
+
+    readByDescriptor(&result, &result.tlType, s_chatParticipantsDescriptor);
+
+    chatParticipantsValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_contactFields[] = {
+    { &fieldAddress<TLContact, decltype(TLContact::userId), &TLContact::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLContact, decltype(TLContact::mutual), &TLContact::mutual>, TLFieldDescriptor::Bool, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_contactConstructors[] = {
+    { TLValue::Contact, 0, 2 },
+};
+
+static const TLTypeDescriptor s_contactDescriptor = { s_contactConstructors, 1, s_contactFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLContact &contactValue)
+{
+    TLContact result;
+
+    readByDescriptor(&result, &result.tlType, s_contactDescriptor);
+
+    contactValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_contactBlockedFields[] = {
+    { &fieldAddress<TLContactBlocked, decltype(TLContactBlocked::userId), &TLContactBlocked::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLContactBlocked, decltype(TLContactBlocked::date), &TLContactBlocked::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_contactBlockedConstructors[] = {
+    { TLValue::ContactBlocked, 0, 2 },
+};
+
+static const TLTypeDescriptor s_contactBlockedDescriptor = { s_contactBlockedConstructors, 1, s_contactBlockedFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLContactBlocked &contactBlockedValue)
+{
+    TLContactBlocked result;
+
+    readByDescriptor(&result, &result.tlType, s_contactBlockedDescriptor);
+
+    contactBlockedValue = result;
+
+    return *this;
+}
+
+static const TLConstructorDescriptor s_contactLinkConstructors[] = {
+    { TLValue::ContactLinkUnknown, 0, 0 },
+    { TLValue::ContactLinkNone, 0, 0 },
+    { TLValue::ContactLinkHasPhone, 0, 0 },
+    { TLValue::ContactLinkContact, 0, 0 },
+};
+
+static const TLTypeDescriptor s_contactLinkDescriptor = { s_contactLinkConstructors, 4, nullptr };
+
+CTelegramStream &CTelegramStream::operator>>(TLContactLink &contactLinkValue)
+{
+    TLContactLink result;
+
+    readByDescriptor(&result, &result.tlType, s_contactLinkDescriptor);
+
+    contactLinkValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_contactSuggestedFields[] = {
+    { &fieldAddress<TLContactSuggested, decltype(TLContactSuggested::userId), &TLContactSuggested::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLContactSuggested, decltype(TLContactSuggested::mutualContacts), &TLContactSuggested::mutualContacts>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_contactSuggestedConstructors[] = {
+    { TLValue::ContactSuggested, 0, 2 },
+};
+
+static const TLTypeDescriptor s_contactSuggestedDescriptor = { s_contactSuggestedConstructors, 1, s_contactSuggestedFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLContactSuggested &contactSuggestedValue)
+{
+    TLContactSuggested result;
+
+    readByDescriptor(&result, &result.tlType, s_contactSuggestedDescriptor);
+
+    contactSuggestedValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_disabledFeatureFields[] = {
+    { &fieldAddress<TLDisabledFeature, decltype(TLDisabledFeature::feature), &TLDisabledFeature::feature>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLDisabledFeature, decltype(TLDisabledFeature::description), &TLDisabledFeature::description>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_disabledFeatureConstructors[] = {
+    { TLValue::DisabledFeature, 0, 2 },
+};
+
+static const TLTypeDescriptor s_disabledFeatureDescriptor = { s_disabledFeatureConstructors, 1, s_disabledFeatureFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLDisabledFeature &disabledFeatureValue)
+{
+    TLDisabledFeature result;
+
+    readByDescriptor(&result, &result.tlType, s_disabledFeatureDescriptor);
+
+    disabledFeatureValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_encryptedChatFields[] = {
+    { &fieldAddress<TLEncryptedChat, decltype(TLEncryptedChat::id), &TLEncryptedChat::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedChat, decltype(TLEncryptedChat::id), &TLEncryptedChat::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedChat, decltype(TLEncryptedChat::accessHash), &TLEncryptedChat::accessHash>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedChat, decltype(TLEncryptedChat::date), &TLEncryptedChat::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedChat, decltype(TLEncryptedChat::adminId), &TLEncryptedChat::adminId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedChat, decltype(TLEncryptedChat::participantId), &TLEncryptedChat::participantId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedChat, decltype(TLEncryptedChat::id), &TLEncryptedChat::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedChat, decltype(TLEncryptedChat::accessHash), &TLEncryptedChat::accessHash>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedChat, decltype(TLEncryptedChat::date), &TLEncryptedChat::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedChat, decltype(TLEncryptedChat::adminId), &TLEncryptedChat::adminId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedChat, decltype(TLEncryptedChat::participantId), &TLEncryptedChat::participantId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedChat, decltype(TLEncryptedChat::gA), &TLEncryptedChat::gA>, TLFieldDescriptor::Bytes, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedChat, decltype(TLEncryptedChat::id), &TLEncryptedChat::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedChat, decltype(TLEncryptedChat::accessHash), &TLEncryptedChat::accessHash>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedChat, decltype(TLEncryptedChat::date), &TLEncryptedChat::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedChat, decltype(TLEncryptedChat::adminId), &TLEncryptedChat::adminId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedChat, decltype(TLEncryptedChat::participantId), &TLEncryptedChat::participantId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedChat, decltype(TLEncryptedChat::gAOrB), &TLEncryptedChat::gAOrB>, TLFieldDescriptor::Bytes, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedChat, decltype(TLEncryptedChat::keyFingerprint), &TLEncryptedChat::keyFingerprint>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_encryptedChatConstructors[] = {
+    { TLValue::EncryptedChatEmpty, 0, 1 },
+    { TLValue::EncryptedChatWaiting, 1, 5 },
+    { TLValue::EncryptedChatRequested, 6, 6 },
+    { TLValue::EncryptedChat, 12, 7 },
+    { TLValue::EncryptedChatDiscarded, 0, 1 },
+};
+
+static const TLTypeDescriptor s_encryptedChatDescriptor = { s_encryptedChatConstructors, 5, s_encryptedChatFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLEncryptedChat &encryptedChatValue)
+{
+    TLEncryptedChat result;
+
+    readByDescriptor(&result, &result.tlType, s_encryptedChatDescriptor);
+
+    encryptedChatValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_encryptedFileFields[] = {
+    { &fieldAddress<TLEncryptedFile, decltype(TLEncryptedFile::id), &TLEncryptedFile::id>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedFile, decltype(TLEncryptedFile::accessHash), &TLEncryptedFile::accessHash>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedFile, decltype(TLEncryptedFile::size), &TLEncryptedFile::size>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedFile, decltype(TLEncryptedFile::dcId), &TLEncryptedFile::dcId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedFile, decltype(TLEncryptedFile::keyFingerprint), &TLEncryptedFile::keyFingerprint>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_encryptedFileConstructors[] = {
+    { TLValue::EncryptedFileEmpty, 0, 0 },
+    { TLValue::EncryptedFile, 0, 5 },
+};
+
+static const TLTypeDescriptor s_encryptedFileDescriptor = { s_encryptedFileConstructors, 2, s_encryptedFileFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLEncryptedFile &encryptedFileValue)
+{
+    TLEncryptedFile result;
+
+    readByDescriptor(&result, &result.tlType, s_encryptedFileDescriptor);
+
+    encryptedFileValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_encryptedMessageFields[] = {
+    { &fieldAddress<TLEncryptedMessage, decltype(TLEncryptedMessage::randomId), &TLEncryptedMessage::randomId>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedMessage, decltype(TLEncryptedMessage::chatId), &TLEncryptedMessage::chatId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedMessage, decltype(TLEncryptedMessage::date), &TLEncryptedMessage::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedMessage, decltype(TLEncryptedMessage::bytes), &TLEncryptedMessage::bytes>, TLFieldDescriptor::Bytes, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedMessage, decltype(TLEncryptedMessage::file), &TLEncryptedMessage::file>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLEncryptedFile> },
+    { &fieldAddress<TLEncryptedMessage, decltype(TLEncryptedMessage::randomId), &TLEncryptedMessage::randomId>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedMessage, decltype(TLEncryptedMessage::chatId), &TLEncryptedMessage::chatId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedMessage, decltype(TLEncryptedMessage::date), &TLEncryptedMessage::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLEncryptedMessage, decltype(TLEncryptedMessage::bytes), &TLEncryptedMessage::bytes>, TLFieldDescriptor::Bytes, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_encryptedMessageConstructors[] = {
+    { TLValue::EncryptedMessage, 0, 5 },
+    { TLValue::EncryptedMessageService, 5, 4 },
+};
+
+static const TLTypeDescriptor s_encryptedMessageDescriptor = { s_encryptedMessageConstructors, 2, s_encryptedMessageFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLEncryptedMessage &encryptedMessageValue)
+{
+    TLEncryptedMessage result;
+
+    readByDescriptor(&result, &result.tlType, s_encryptedMessageDescriptor);
+
+    encryptedMessageValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_errorFields[] = {
+    { &fieldAddress<TLError, decltype(TLError::code), &TLError::code>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLError, decltype(TLError::text), &TLError::text>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_errorConstructors[] = {
+    { TLValue::Error, 0, 2 },
+};
+
+static const TLTypeDescriptor s_errorDescriptor = { s_errorConstructors, 1, s_errorFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLError &errorValue)
+{
+    TLError result;
+
+    readByDescriptor(&result, &result.tlType, s_errorDescriptor);
+
+    errorValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_exportedChatInviteFields[] = {
+    { &fieldAddress<TLExportedChatInvite, decltype(TLExportedChatInvite::link), &TLExportedChatInvite::link>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_exportedChatInviteConstructors[] = {
+    { TLValue::ChatInviteEmpty, 0, 0 },
+    { TLValue::ChatInviteExported, 0, 1 },
+};
+
+static const TLTypeDescriptor s_exportedChatInviteDescriptor = { s_exportedChatInviteConstructors, 2, s_exportedChatInviteFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLExportedChatInvite &exportedChatInviteValue)
+{
+    TLExportedChatInvite result;
+
+    readByDescriptor(&result, &result.tlType, s_exportedChatInviteDescriptor);
+
+    exportedChatInviteValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_fileLocationFields[] = {
+    { &fieldAddress<TLFileLocation, decltype(TLFileLocation::volumeId), &TLFileLocation::volumeId>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLFileLocation, decltype(TLFileLocation::localId), &TLFileLocation::localId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLFileLocation, decltype(TLFileLocation::secret), &TLFileLocation::secret>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLFileLocation, decltype(TLFileLocation::dcId), &TLFileLocation::dcId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLFileLocation, decltype(TLFileLocation::volumeId), &TLFileLocation::volumeId>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLFileLocation, decltype(TLFileLocation::localId), &TLFileLocation::localId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLFileLocation, decltype(TLFileLocation::secret), &TLFileLocation::secret>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_fileLocationConstructors[] = {
+    { TLValue::FileLocationUnavailable, 0, 3 },
+    { TLValue::FileLocation, 3, 4 },
+};
+
+static const TLTypeDescriptor s_fileLocationDescriptor = { s_fileLocationConstructors, 2, s_fileLocationFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLFileLocation &fileLocationValue)
+{
+    TLFileLocation result;
+
+    readByDescriptor(&result, &result.tlType, s_fileLocationDescriptor);
+
+    fileLocationValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_geoPointFields[] = {
+    { &fieldAddress<TLGeoPoint, decltype(TLGeoPoint::longitude), &TLGeoPoint::longitude>, TLFieldDescriptor::Double, -1, nullptr, nullptr },
+    { &fieldAddress<TLGeoPoint, decltype(TLGeoPoint::latitude), &TLGeoPoint::latitude>, TLFieldDescriptor::Double, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_geoPointConstructors[] = {
+    { TLValue::GeoPointEmpty, 0, 0 },
+    { TLValue::GeoPoint, 0, 2 },
+};
+
+static const TLTypeDescriptor s_geoPointDescriptor = { s_geoPointConstructors, 2, s_geoPointFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLGeoPoint &geoPointValue)
+{
+    TLGeoPoint result;
+
+    readByDescriptor(&result, &result.tlType, s_geoPointDescriptor);
+
+    geoPointValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_helpAppChangelogFields[] = {
+    { &fieldAddress<TLHelpAppChangelog, decltype(TLHelpAppChangelog::text), &TLHelpAppChangelog::text>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_helpAppChangelogConstructors[] = {
+    { TLValue::HelpAppChangelogEmpty, 0, 0 },
+    { TLValue::HelpAppChangelog, 0, 1 },
+};
+
+static const TLTypeDescriptor s_helpAppChangelogDescriptor = { s_helpAppChangelogConstructors, 2, s_helpAppChangelogFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLHelpAppChangelog &helpAppChangelogValue)
+{
+    TLHelpAppChangelog result;
+
+    readByDescriptor(&result, &result.tlType, s_helpAppChangelogDescriptor);
+
+    helpAppChangelogValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_helpAppUpdateFields[] = {
+    { &fieldAddress<TLHelpAppUpdate, decltype(TLHelpAppUpdate::id), &TLHelpAppUpdate::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLHelpAppUpdate, decltype(TLHelpAppUpdate::critical), &TLHelpAppUpdate::critical>, TLFieldDescriptor::Bool, -1, nullptr, nullptr },
+    { &fieldAddress<TLHelpAppUpdate, decltype(TLHelpAppUpdate::url), &TLHelpAppUpdate::url>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLHelpAppUpdate, decltype(TLHelpAppUpdate::text), &TLHelpAppUpdate::text>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_helpAppUpdateConstructors[] = {
+    { TLValue::HelpAppUpdate, 0, 4 },
+    { TLValue::HelpNoAppUpdate, 0, 0 },
+};
+
+static const TLTypeDescriptor s_helpAppUpdateDescriptor = { s_helpAppUpdateConstructors, 2, s_helpAppUpdateFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLHelpAppUpdate &helpAppUpdateValue)
+{
+    TLHelpAppUpdate result;
+
+    readByDescriptor(&result, &result.tlType, s_helpAppUpdateDescriptor);
+
+    helpAppUpdateValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_helpInviteTextFields[] = {
+    { &fieldAddress<TLHelpInviteText, decltype(TLHelpInviteText::message), &TLHelpInviteText::message>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_helpInviteTextConstructors[] = {
+    { TLValue::HelpInviteText, 0, 1 },
+};
+
+static const TLTypeDescriptor s_helpInviteTextDescriptor = { s_helpInviteTextConstructors, 1, s_helpInviteTextFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLHelpInviteText &helpInviteTextValue)
+{
+    TLHelpInviteText result;
+
+    readByDescriptor(&result, &result.tlType, s_helpInviteTextDescriptor);
+
+    helpInviteTextValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_helpTermsOfServiceFields[] = {
+    { &fieldAddress<TLHelpTermsOfService, decltype(TLHelpTermsOfService::text), &TLHelpTermsOfService::text>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_helpTermsOfServiceConstructors[] = {
+    { TLValue::HelpTermsOfService, 0, 1 },
+};
+
+static const TLTypeDescriptor s_helpTermsOfServiceDescriptor = { s_helpTermsOfServiceConstructors, 1, s_helpTermsOfServiceFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLHelpTermsOfService &helpTermsOfServiceValue)
+{
+    TLHelpTermsOfService result;
+
+    readByDescriptor(&result, &result.tlType, s_helpTermsOfServiceDescriptor);
+
+    helpTermsOfServiceValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_importedContactFields[] = {
+    { &fieldAddress<TLImportedContact, decltype(TLImportedContact::userId), &TLImportedContact::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLImportedContact, decltype(TLImportedContact::clientId), &TLImportedContact::clientId>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_importedContactConstructors[] = {
+    { TLValue::ImportedContact, 0, 2 },
+};
+
+static const TLTypeDescriptor s_importedContactDescriptor = { s_importedContactConstructors, 1, s_importedContactFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLImportedContact &importedContactValue)
+{
+    TLImportedContact result;
+
+    readByDescriptor(&result, &result.tlType, s_importedContactDescriptor);
+
+    importedContactValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_inputAppEventFields[] = {
+    { &fieldAddress<TLInputAppEvent, decltype(TLInputAppEvent::time), &TLInputAppEvent::time>, TLFieldDescriptor::Double, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputAppEvent, decltype(TLInputAppEvent::type), &TLInputAppEvent::type>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputAppEvent, decltype(TLInputAppEvent::peer), &TLInputAppEvent::peer>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputAppEvent, decltype(TLInputAppEvent::data), &TLInputAppEvent::data>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_inputAppEventConstructors[] = {
+    { TLValue::InputAppEvent, 0, 4 },
+};
+
+static const TLTypeDescriptor s_inputAppEventDescriptor = { s_inputAppEventConstructors, 1, s_inputAppEventFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLInputAppEvent &inputAppEventValue)
+{
+    TLInputAppEvent result;
+
+    readByDescriptor(&result, &result.tlType, s_inputAppEventDescriptor);
+
+    inputAppEventValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_inputAudioFields[] = {
+    { &fieldAddress<TLInputAudio, decltype(TLInputAudio::id), &TLInputAudio::id>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputAudio, decltype(TLInputAudio::accessHash), &TLInputAudio::accessHash>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_inputAudioConstructors[] = {
+    { TLValue::InputAudioEmpty, 0, 0 },
+    { TLValue::InputAudio, 0, 2 },
+};
+
+static const TLTypeDescriptor s_inputAudioDescriptor = { s_inputAudioConstructors, 2, s_inputAudioFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLInputAudio &inputAudioValue)
+{
+    TLInputAudio result;
+
+    readByDescriptor(&result, &result.tlType, s_inputAudioDescriptor);
+
+    inputAudioValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_inputChannelFields[] = {
+    { &fieldAddress<TLInputChannel, decltype(TLInputChannel::channelId), &TLInputChannel::channelId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputChannel, decltype(TLInputChannel::accessHash), &TLInputChannel::accessHash>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_inputChannelConstructors[] = {
+    { TLValue::InputChannelEmpty, 0, 0 },
+    { TLValue::InputChannel, 0, 2 },
+};
+
+static const TLTypeDescriptor s_inputChannelDescriptor = { s_inputChannelConstructors, 2, s_inputChannelFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLInputChannel &inputChannelValue)
+{
+    TLInputChannel result;
+
+    readByDescriptor(&result, &result.tlType, s_inputChannelDescriptor);
+
+    inputChannelValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_inputContactFields[] = {
+    { &fieldAddress<TLInputContact, decltype(TLInputContact::clientId), &TLInputContact::clientId>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputContact, decltype(TLInputContact::phone), &TLInputContact::phone>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputContact, decltype(TLInputContact::firstName), &TLInputContact::firstName>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputContact, decltype(TLInputContact::lastName), &TLInputContact::lastName>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_inputContactConstructors[] = {
+    { TLValue::InputPhoneContact, 0, 4 },
+};
+
+static const TLTypeDescriptor s_inputContactDescriptor = { s_inputContactConstructors, 1, s_inputContactFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLInputContact &inputContactValue)
+{
+    TLInputContact result;
+
+    readByDescriptor(&result, &result.tlType, s_inputContactDescriptor);
+
+    inputContactValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_inputDocumentFields[] = {
+    { &fieldAddress<TLInputDocument, decltype(TLInputDocument::id), &TLInputDocument::id>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputDocument, decltype(TLInputDocument::accessHash), &TLInputDocument::accessHash>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_inputDocumentConstructors[] = {
+    { TLValue::InputDocumentEmpty, 0, 0 },
+    { TLValue::InputDocument, 0, 2 },
+};
+
+static const TLTypeDescriptor s_inputDocumentDescriptor = { s_inputDocumentConstructors, 2, s_inputDocumentFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLInputDocument &inputDocumentValue)
+{
+    TLInputDocument result;
+
+    readByDescriptor(&result, &result.tlType, s_inputDocumentDescriptor);
+
+    inputDocumentValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_inputEncryptedChatFields[] = {
+    { &fieldAddress<TLInputEncryptedChat, decltype(TLInputEncryptedChat::chatId), &TLInputEncryptedChat::chatId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputEncryptedChat, decltype(TLInputEncryptedChat::accessHash), &TLInputEncryptedChat::accessHash>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_inputEncryptedChatConstructors[] = {
+    { TLValue::InputEncryptedChat, 0, 2 },
+};
+
+static const TLTypeDescriptor s_inputEncryptedChatDescriptor = { s_inputEncryptedChatConstructors, 1, s_inputEncryptedChatFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLInputEncryptedChat &inputEncryptedChatValue)
+{
+    TLInputEncryptedChat result;
+
+    readByDescriptor(&result, &result.tlType, s_inputEncryptedChatDescriptor);
+
+    inputEncryptedChatValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_inputEncryptedFileFields[] = {
+    { &fieldAddress<TLInputEncryptedFile, decltype(TLInputEncryptedFile::id), &TLInputEncryptedFile::id>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputEncryptedFile, decltype(TLInputEncryptedFile::parts), &TLInputEncryptedFile::parts>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputEncryptedFile, decltype(TLInputEncryptedFile::md5Checksum), &TLInputEncryptedFile::md5Checksum>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputEncryptedFile, decltype(TLInputEncryptedFile::keyFingerprint), &TLInputEncryptedFile::keyFingerprint>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputEncryptedFile, decltype(TLInputEncryptedFile::id), &TLInputEncryptedFile::id>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputEncryptedFile, decltype(TLInputEncryptedFile::accessHash), &TLInputEncryptedFile::accessHash>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputEncryptedFile, decltype(TLInputEncryptedFile::id), &TLInputEncryptedFile::id>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputEncryptedFile, decltype(TLInputEncryptedFile::parts), &TLInputEncryptedFile::parts>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputEncryptedFile, decltype(TLInputEncryptedFile::keyFingerprint), &TLInputEncryptedFile::keyFingerprint>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_inputEncryptedFileConstructors[] = {
+    { TLValue::InputEncryptedFileEmpty, 0, 0 },
+    { TLValue::InputEncryptedFileUploaded, 0, 4 },
+    { TLValue::InputEncryptedFile, 4, 2 },
+    { TLValue::InputEncryptedFileBigUploaded, 6, 3 },
+};
+
+static const TLTypeDescriptor s_inputEncryptedFileDescriptor = { s_inputEncryptedFileConstructors, 4, s_inputEncryptedFileFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLInputEncryptedFile &inputEncryptedFileValue)
+{
+    TLInputEncryptedFile result;
+
+    readByDescriptor(&result, &result.tlType, s_inputEncryptedFileDescriptor);
+
+    inputEncryptedFileValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_inputFileFields[] = {
+    { &fieldAddress<TLInputFile, decltype(TLInputFile::id), &TLInputFile::id>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputFile, decltype(TLInputFile::parts), &TLInputFile::parts>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputFile, decltype(TLInputFile::name), &TLInputFile::name>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputFile, decltype(TLInputFile::md5Checksum), &TLInputFile::md5Checksum>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputFile, decltype(TLInputFile::id), &TLInputFile::id>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputFile, decltype(TLInputFile::parts), &TLInputFile::parts>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputFile, decltype(TLInputFile::name), &TLInputFile::name>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_inputFileConstructors[] = {
+    { TLValue::InputFile, 0, 4 },
+    { TLValue::InputFileBig, 4, 3 },
+};
+
+static const TLTypeDescriptor s_inputFileDescriptor = { s_inputFileConstructors, 2, s_inputFileFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLInputFile &inputFileValue)
+{
+    TLInputFile result;
+
+    readByDescriptor(&result, &result.tlType, s_inputFileDescriptor);
+
+    inputFileValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_inputFileLocationFields[] = {
+    { &fieldAddress<TLInputFileLocation, decltype(TLInputFileLocation::volumeId), &TLInputFileLocation::volumeId>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputFileLocation, decltype(TLInputFileLocation::localId), &TLInputFileLocation::localId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputFileLocation, decltype(TLInputFileLocation::secret), &TLInputFileLocation::secret>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputFileLocation, decltype(TLInputFileLocation::id), &TLInputFileLocation::id>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputFileLocation, decltype(TLInputFileLocation::accessHash), &TLInputFileLocation::accessHash>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_inputFileLocationConstructors[] = {
+    { TLValue::InputFileLocation, 0, 3 },
+    { TLValue::InputVideoFileLocation, 3, 2 },
+    { TLValue::InputEncryptedFileLocation, 3, 2 },
+    { TLValue::InputAudioFileLocation, 3, 2 },
+    { TLValue::InputDocumentFileLocation, 3, 2 },
+};
+
+static const TLTypeDescriptor s_inputFileLocationDescriptor = { s_inputFileLocationConstructors, 5, s_inputFileLocationFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLInputFileLocation &inputFileLocationValue)
+{
+    TLInputFileLocation result;
+
+    readByDescriptor(&result, &result.tlType, s_inputFileLocationDescriptor);
+
+    inputFileLocationValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_inputGeoPointFields[] = {
+    { &fieldAddress<TLInputGeoPoint, decltype(TLInputGeoPoint::latitude), &TLInputGeoPoint::latitude>, TLFieldDescriptor::Double, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputGeoPoint, decltype(TLInputGeoPoint::longitude), &TLInputGeoPoint::longitude>, TLFieldDescriptor::Double, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_inputGeoPointConstructors[] = {
+    { TLValue::InputGeoPointEmpty, 0, 0 },
+    { TLValue::InputGeoPoint, 0, 2 },
+};
+
+static const TLTypeDescriptor s_inputGeoPointDescriptor = { s_inputGeoPointConstructors, 2, s_inputGeoPointFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLInputGeoPoint &inputGeoPointValue)
+{
+    TLInputGeoPoint result;
+
+    readByDescriptor(&result, &result.tlType, s_inputGeoPointDescriptor);
+
+    inputGeoPointValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_inputPeerFields[] = {
+    { &fieldAddress<TLInputPeer, decltype(TLInputPeer::chatId), &TLInputPeer::chatId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputPeer, decltype(TLInputPeer::userId), &TLInputPeer::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputPeer, decltype(TLInputPeer::accessHash), &TLInputPeer::accessHash>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputPeer, decltype(TLInputPeer::channelId), &TLInputPeer::channelId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputPeer, decltype(TLInputPeer::accessHash), &TLInputPeer::accessHash>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_inputPeerConstructors[] = {
+    { TLValue::InputPeerEmpty, 0, 0 },
+    { TLValue::InputPeerSelf, 0, 0 },
+    { TLValue::InputPeerChat, 0, 1 },
+    { TLValue::InputPeerUser, 1, 2 },
+    { TLValue::InputPeerChannel, 3, 2 },
+};
+
+static const TLTypeDescriptor s_inputPeerDescriptor = { s_inputPeerConstructors, 5, s_inputPeerFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLInputPeer &inputPeerValue)
+{
+    TLInputPeer result;
+
+    readByDescriptor(&result, &result.tlType, s_inputPeerDescriptor);
+
+    inputPeerValue = result;
+
+    return *this;
+}
+
+static const TLConstructorDescriptor s_inputPeerNotifyEventsConstructors[] = {
+    { TLValue::InputPeerNotifyEventsEmpty, 0, 0 },
+    { TLValue::InputPeerNotifyEventsAll, 0, 0 },
+};
+
+static const TLTypeDescriptor s_inputPeerNotifyEventsDescriptor = { s_inputPeerNotifyEventsConstructors, 2, nullptr };
+
+CTelegramStream &CTelegramStream::operator>>(TLInputPeerNotifyEvents &inputPeerNotifyEventsValue)
+{
+    TLInputPeerNotifyEvents result;
+
+    readByDescriptor(&result, &result.tlType, s_inputPeerNotifyEventsDescriptor);
+
+    inputPeerNotifyEventsValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_inputPeerNotifySettingsFields[] = {
+    { &fieldAddress<TLInputPeerNotifySettings, decltype(TLInputPeerNotifySettings::muteUntil), &TLInputPeerNotifySettings::muteUntil>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputPeerNotifySettings, decltype(TLInputPeerNotifySettings::sound), &TLInputPeerNotifySettings::sound>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputPeerNotifySettings, decltype(TLInputPeerNotifySettings::showPreviews), &TLInputPeerNotifySettings::showPreviews>, TLFieldDescriptor::Bool, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputPeerNotifySettings, decltype(TLInputPeerNotifySettings::eventsMask), &TLInputPeerNotifySettings::eventsMask>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_inputPeerNotifySettingsConstructors[] = {
+    { TLValue::InputPeerNotifySettings, 0, 4 },
+};
+
+static const TLTypeDescriptor s_inputPeerNotifySettingsDescriptor = { s_inputPeerNotifySettingsConstructors, 1, s_inputPeerNotifySettingsFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLInputPeerNotifySettings &inputPeerNotifySettingsValue)
+{
+    TLInputPeerNotifySettings result;
+
+    readByDescriptor(&result, &result.tlType, s_inputPeerNotifySettingsDescriptor);
+
+    inputPeerNotifySettingsValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_inputPhotoFields[] = {
+    { &fieldAddress<TLInputPhoto, decltype(TLInputPhoto::id), &TLInputPhoto::id>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputPhoto, decltype(TLInputPhoto::accessHash), &TLInputPhoto::accessHash>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_inputPhotoConstructors[] = {
+    { TLValue::InputPhotoEmpty, 0, 0 },
+    { TLValue::InputPhoto, 0, 2 },
+};
+
+static const TLTypeDescriptor s_inputPhotoDescriptor = { s_inputPhotoConstructors, 2, s_inputPhotoFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLInputPhoto &inputPhotoValue)
+{
+    TLInputPhoto result;
+
+    readByDescriptor(&result, &result.tlType, s_inputPhotoDescriptor);
+
+    inputPhotoValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_inputPhotoCropFields[] = {
+    { &fieldAddress<TLInputPhotoCrop, decltype(TLInputPhotoCrop::cropLeft), &TLInputPhotoCrop::cropLeft>, TLFieldDescriptor::Double, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputPhotoCrop, decltype(TLInputPhotoCrop::cropTop), &TLInputPhotoCrop::cropTop>, TLFieldDescriptor::Double, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputPhotoCrop, decltype(TLInputPhotoCrop::cropWidth), &TLInputPhotoCrop::cropWidth>, TLFieldDescriptor::Double, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_inputPhotoCropConstructors[] = {
+    { TLValue::InputPhotoCropAuto, 0, 0 },
+    { TLValue::InputPhotoCrop, 0, 3 },
+};
+
+static const TLTypeDescriptor s_inputPhotoCropDescriptor = { s_inputPhotoCropConstructors, 2, s_inputPhotoCropFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLInputPhotoCrop &inputPhotoCropValue)
+{
+    TLInputPhotoCrop result;
+
+    readByDescriptor(&result, &result.tlType, s_inputPhotoCropDescriptor);
+
+    inputPhotoCropValue = result;
+
+    return *this;
+}
+
+static const TLConstructorDescriptor s_inputPrivacyKeyConstructors[] = {
+    { TLValue::InputPrivacyKeyStatusTimestamp, 0, 0 },
+};
+
+static const TLTypeDescriptor s_inputPrivacyKeyDescriptor = { s_inputPrivacyKeyConstructors, 1, nullptr };
+
+CTelegramStream &CTelegramStream::operator>>(TLInputPrivacyKey &inputPrivacyKeyValue)
+{
+    TLInputPrivacyKey result;
+
+    readByDescriptor(&result, &result.tlType, s_inputPrivacyKeyDescriptor);
+
+    inputPrivacyKeyValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_inputStickerSetFields[] = {
+    { &fieldAddress<TLInputStickerSet, decltype(TLInputStickerSet::id), &TLInputStickerSet::id>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputStickerSet, decltype(TLInputStickerSet::accessHash), &TLInputStickerSet::accessHash>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputStickerSet, decltype(TLInputStickerSet::shortName), &TLInputStickerSet::shortName>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_inputStickerSetConstructors[] = {
+    { TLValue::InputStickerSetEmpty, 0, 0 },
+    { TLValue::InputStickerSetID, 0, 2 },
+    { TLValue::InputStickerSetShortName, 2, 1 },
+};
+
+static const TLTypeDescriptor s_inputStickerSetDescriptor = { s_inputStickerSetConstructors, 3, s_inputStickerSetFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLInputStickerSet &inputStickerSetValue)
+{
+    TLInputStickerSet result;
+
+    readByDescriptor(&result, &result.tlType, s_inputStickerSetDescriptor);
+
+    inputStickerSetValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_inputUserFields[] = {
+    { &fieldAddress<TLInputUser, decltype(TLInputUser::userId), &TLInputUser::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputUser, decltype(TLInputUser::accessHash), &TLInputUser::accessHash>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_inputUserConstructors[] = {
+    { TLValue::InputUserEmpty, 0, 0 },
+    { TLValue::InputUserSelf, 0, 0 },
+    { TLValue::InputUser, 0, 2 },
+};
+
+static const TLTypeDescriptor s_inputUserDescriptor = { s_inputUserConstructors, 3, s_inputUserFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLInputUser &inputUserValue)
+{
+    TLInputUser result;
+
+    readByDescriptor(&result, &result.tlType, s_inputUserDescriptor);
+
+    inputUserValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_inputVideoFields[] = {
+    { &fieldAddress<TLInputVideo, decltype(TLInputVideo::id), &TLInputVideo::id>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputVideo, decltype(TLInputVideo::accessHash), &TLInputVideo::accessHash>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_inputVideoConstructors[] = {
+    { TLValue::InputVideoEmpty, 0, 0 },
+    { TLValue::InputVideo, 0, 2 },
+};
+
+static const TLTypeDescriptor s_inputVideoDescriptor = { s_inputVideoConstructors, 2, s_inputVideoFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLInputVideo &inputVideoValue)
+{
+    TLInputVideo result;
+
+    readByDescriptor(&result, &result.tlType, s_inputVideoDescriptor);
+
+    inputVideoValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_keyboardButtonFields[] = {
+    { &fieldAddress<TLKeyboardButton, decltype(TLKeyboardButton::text), &TLKeyboardButton::text>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_keyboardButtonConstructors[] = {
+    { TLValue::KeyboardButton, 0, 1 },
+};
+
+static const TLTypeDescriptor s_keyboardButtonDescriptor = { s_keyboardButtonConstructors, 1, s_keyboardButtonFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLKeyboardButton &keyboardButtonValue)
+{
+    TLKeyboardButton result;
+
+    readByDescriptor(&result, &result.tlType, s_keyboardButtonDescriptor);
+
+    keyboardButtonValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_keyboardButtonRowFields[] = {
+    { &fieldAddress<TLKeyboardButtonRow, decltype(TLKeyboardButtonRow::buttons), &TLKeyboardButtonRow::buttons>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLKeyboardButton>> },
+};
+
+static const TLConstructorDescriptor s_keyboardButtonRowConstructors[] = {
+    { TLValue::KeyboardButtonRow, 0, 1 },
+};
+
+static const TLTypeDescriptor s_keyboardButtonRowDescriptor = { s_keyboardButtonRowConstructors, 1, s_keyboardButtonRowFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLKeyboardButtonRow &keyboardButtonRowValue)
+{
+    TLKeyboardButtonRow result;
+
+    readByDescriptor(&result, &result.tlType, s_keyboardButtonRowDescriptor);
+
+    keyboardButtonRowValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_messageEntityFields[] = {
+    { &fieldAddress<TLMessageEntity, decltype(TLMessageEntity::offset), &TLMessageEntity::offset>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageEntity, decltype(TLMessageEntity::length), &TLMessageEntity::length>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageEntity, decltype(TLMessageEntity::offset), &TLMessageEntity::offset>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageEntity, decltype(TLMessageEntity::length), &TLMessageEntity::length>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageEntity, decltype(TLMessageEntity::language), &TLMessageEntity::language>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageEntity, decltype(TLMessageEntity::offset), &TLMessageEntity::offset>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageEntity, decltype(TLMessageEntity::length), &TLMessageEntity::length>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageEntity, decltype(TLMessageEntity::url), &TLMessageEntity::url>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_messageEntityConstructors[] = {
+    { TLValue::MessageEntityUnknown, 0, 2 },
+    { TLValue::MessageEntityMention, 0, 2 },
+    { TLValue::MessageEntityHashtag, 0, 2 },
+    { TLValue::MessageEntityBotCommand, 0, 2 },
+    { TLValue::MessageEntityUrl, 0, 2 },
+    { TLValue::MessageEntityEmail, 0, 2 },
+    { TLValue::MessageEntityBold, 0, 2 },
+    { TLValue::MessageEntityItalic, 0, 2 },
+    { TLValue::MessageEntityCode, 0, 2 },
+    { TLValue::MessageEntityPre, 2, 3 },
+    { TLValue::MessageEntityTextUrl, 5, 3 },
+};
+
+static const TLTypeDescriptor s_messageEntityDescriptor = { s_messageEntityConstructors, 11, s_messageEntityFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLMessageEntity &messageEntityValue)
+{
+    TLMessageEntity result;
+
+    readByDescriptor(&result, &result.tlType, s_messageEntityDescriptor);
+
+    messageEntityValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_messageGroupFields[] = {
+    { &fieldAddress<TLMessageGroup, decltype(TLMessageGroup::minId), &TLMessageGroup::minId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageGroup, decltype(TLMessageGroup::maxId), &TLMessageGroup::maxId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageGroup, decltype(TLMessageGroup::count), &TLMessageGroup::count>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageGroup, decltype(TLMessageGroup::date), &TLMessageGroup::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_messageGroupConstructors[] = {
+    { TLValue::MessageGroup, 0, 4 },
+};
+
+static const TLTypeDescriptor s_messageGroupDescriptor = { s_messageGroupConstructors, 1, s_messageGroupFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLMessageGroup &messageGroupValue)
+{
+    TLMessageGroup result;
+
+    readByDescriptor(&result, &result.tlType, s_messageGroupDescriptor);
+
+    messageGroupValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_messageRangeFields[] = {
+    { &fieldAddress<TLMessageRange, decltype(TLMessageRange::minId), &TLMessageRange::minId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageRange, decltype(TLMessageRange::maxId), &TLMessageRange::maxId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_messageRangeConstructors[] = {
+    { TLValue::MessageRange, 0, 2 },
+};
+
+static const TLTypeDescriptor s_messageRangeDescriptor = { s_messageRangeConstructors, 1, s_messageRangeFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLMessageRange &messageRangeValue)
+{
+    TLMessageRange result;
+
+    readByDescriptor(&result, &result.tlType, s_messageRangeDescriptor);
+
+    messageRangeValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_messagesAffectedHistoryFields[] = {
+    { &fieldAddress<TLMessagesAffectedHistory, decltype(TLMessagesAffectedHistory::pts), &TLMessagesAffectedHistory::pts>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessagesAffectedHistory, decltype(TLMessagesAffectedHistory::ptsCount), &TLMessagesAffectedHistory::ptsCount>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessagesAffectedHistory, decltype(TLMessagesAffectedHistory::offset), &TLMessagesAffectedHistory::offset>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_messagesAffectedHistoryConstructors[] = {
+    { TLValue::MessagesAffectedHistory, 0, 3 },
+};
+
+static const TLTypeDescriptor s_messagesAffectedHistoryDescriptor = { s_messagesAffectedHistoryConstructors, 1, s_messagesAffectedHistoryFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLMessagesAffectedHistory &messagesAffectedHistoryValue)
+{
+    TLMessagesAffectedHistory result;
+
+    readByDescriptor(&result, &result.tlType, s_messagesAffectedHistoryDescriptor);
+
+    messagesAffectedHistoryValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_messagesAffectedMessagesFields[] = {
+    { &fieldAddress<TLMessagesAffectedMessages, decltype(TLMessagesAffectedMessages::pts), &TLMessagesAffectedMessages::pts>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessagesAffectedMessages, decltype(TLMessagesAffectedMessages::ptsCount), &TLMessagesAffectedMessages::ptsCount>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_messagesAffectedMessagesConstructors[] = {
+    { TLValue::MessagesAffectedMessages, 0, 2 },
+};
+
+static const TLTypeDescriptor s_messagesAffectedMessagesDescriptor = { s_messagesAffectedMessagesConstructors, 1, s_messagesAffectedMessagesFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLMessagesAffectedMessages &messagesAffectedMessagesValue)
+{
+    TLMessagesAffectedMessages result;
+
+    readByDescriptor(&result, &result.tlType, s_messagesAffectedMessagesDescriptor);
+
+    messagesAffectedMessagesValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_messagesDhConfigFields[] = {
+    { &fieldAddress<TLMessagesDhConfig, decltype(TLMessagesDhConfig::random), &TLMessagesDhConfig::random>, TLFieldDescriptor::Bytes, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessagesDhConfig, decltype(TLMessagesDhConfig::g), &TLMessagesDhConfig::g>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessagesDhConfig, decltype(TLMessagesDhConfig::p), &TLMessagesDhConfig::p>, TLFieldDescriptor::Bytes, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessagesDhConfig, decltype(TLMessagesDhConfig::version), &TLMessagesDhConfig::version>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessagesDhConfig, decltype(TLMessagesDhConfig::random), &TLMessagesDhConfig::random>, TLFieldDescriptor::Bytes, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_messagesDhConfigConstructors[] = {
+    { TLValue::MessagesDhConfigNotModified, 0, 1 },
+    { TLValue::MessagesDhConfig, 1, 4 },
+};
+
+static const TLTypeDescriptor s_messagesDhConfigDescriptor = { s_messagesDhConfigConstructors, 2, s_messagesDhConfigFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLMessagesDhConfig &messagesDhConfigValue)
+{
+    TLMessagesDhConfig result;
+
+    readByDescriptor(&result, &result.tlType, s_messagesDhConfigDescriptor);
+
+    messagesDhConfigValue = result;
+
+    return *this;
+}
+
+static const TLConstructorDescriptor s_messagesFilterConstructors[] = {
+    { TLValue::InputMessagesFilterEmpty, 0, 0 },
+    { TLValue::InputMessagesFilterPhotos, 0, 0 },
+    { TLValue::InputMessagesFilterVideo, 0, 0 },
+    { TLValue::InputMessagesFilterPhotoVideo, 0, 0 },
+    { TLValue::InputMessagesFilterPhotoVideoDocuments, 0, 0 },
+    { TLValue::InputMessagesFilterDocument, 0, 0 },
+    { TLValue::InputMessagesFilterAudio, 0, 0 },
+    { TLValue::InputMessagesFilterAudioDocuments, 0, 0 },
+    { TLValue::InputMessagesFilterUrl, 0, 0 },
+    { TLValue::InputMessagesFilterGif, 0, 0 },
+};
+
+static const TLTypeDescriptor s_messagesFilterDescriptor = { s_messagesFilterConstructors, 10, nullptr };
+
+CTelegramStream &CTelegramStream::operator>>(TLMessagesFilter &messagesFilterValue)
+{
+    TLMessagesFilter result;
+
+    readByDescriptor(&result, &result.tlType, s_messagesFilterDescriptor);
+
+    messagesFilterValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_messagesSentEncryptedMessageFields[] = {
+    { &fieldAddress<TLMessagesSentEncryptedMessage, decltype(TLMessagesSentEncryptedMessage::date), &TLMessagesSentEncryptedMessage::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessagesSentEncryptedMessage, decltype(TLMessagesSentEncryptedMessage::date), &TLMessagesSentEncryptedMessage::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessagesSentEncryptedMessage, decltype(TLMessagesSentEncryptedMessage::file), &TLMessagesSentEncryptedMessage::file>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLEncryptedFile> },
+};
+
+static const TLConstructorDescriptor s_messagesSentEncryptedMessageConstructors[] = {
+    { TLValue::MessagesSentEncryptedMessage, 0, 1 },
+    { TLValue::MessagesSentEncryptedFile, 1, 2 },
+};
+
+static const TLTypeDescriptor s_messagesSentEncryptedMessageDescriptor = { s_messagesSentEncryptedMessageConstructors, 2, s_messagesSentEncryptedMessageFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLMessagesSentEncryptedMessage &messagesSentEncryptedMessageValue)
+{
+    TLMessagesSentEncryptedMessage result;
+
+    readByDescriptor(&result, &result.tlType, s_messagesSentEncryptedMessageDescriptor);
+
+    messagesSentEncryptedMessageValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_nearestDcFields[] = {
+    { &fieldAddress<TLNearestDc, decltype(TLNearestDc::country), &TLNearestDc::country>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLNearestDc, decltype(TLNearestDc::thisDc), &TLNearestDc::thisDc>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLNearestDc, decltype(TLNearestDc::nearestDc), &TLNearestDc::nearestDc>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_nearestDcConstructors[] = {
+    { TLValue::NearestDc, 0, 3 },
+};
+
+static const TLTypeDescriptor s_nearestDcDescriptor = { s_nearestDcConstructors, 1, s_nearestDcFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLNearestDc &nearestDcValue)
+{
+    TLNearestDc result;
+
+    readByDescriptor(&result, &result.tlType, s_nearestDcDescriptor);
+
+    nearestDcValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_peerFields[] = {
+    { &fieldAddress<TLPeer, decltype(TLPeer::userId), &TLPeer::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLPeer, decltype(TLPeer::chatId), &TLPeer::chatId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLPeer, decltype(TLPeer::channelId), &TLPeer::channelId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_peerConstructors[] = {
+    { TLValue::PeerUser, 0, 1 },
+    { TLValue::PeerChat, 1, 1 },
+    { TLValue::PeerChannel, 2, 1 },
+};
+
+static const TLTypeDescriptor s_peerDescriptor = { s_peerConstructors, 3, s_peerFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLPeer &peerValue)
+{
+    TLPeer result;
+
+    readByDescriptor(&result, &result.tlType, s_peerDescriptor);
+
+    peerValue = result;
+
+    return *this;
+}
+
+static const TLConstructorDescriptor s_peerNotifyEventsConstructors[] = {
+    { TLValue::PeerNotifyEventsEmpty, 0, 0 },
+    { TLValue::PeerNotifyEventsAll, 0, 0 },
+};
+
+static const TLTypeDescriptor s_peerNotifyEventsDescriptor = { s_peerNotifyEventsConstructors, 2, nullptr };
+
+CTelegramStream &CTelegramStream::operator>>(TLPeerNotifyEvents &peerNotifyEventsValue)
+{
+    TLPeerNotifyEvents result;
+
+    readByDescriptor(&result, &result.tlType, s_peerNotifyEventsDescriptor);
+
+    peerNotifyEventsValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_peerNotifySettingsFields[] = {
+    { &fieldAddress<TLPeerNotifySettings, decltype(TLPeerNotifySettings::muteUntil), &TLPeerNotifySettings::muteUntil>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLPeerNotifySettings, decltype(TLPeerNotifySettings::sound), &TLPeerNotifySettings::sound>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLPeerNotifySettings, decltype(TLPeerNotifySettings::showPreviews), &TLPeerNotifySettings::showPreviews>, TLFieldDescriptor::Bool, -1, nullptr, nullptr },
+    { &fieldAddress<TLPeerNotifySettings, decltype(TLPeerNotifySettings::eventsMask), &TLPeerNotifySettings::eventsMask>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_peerNotifySettingsConstructors[] = {
+    { TLValue::PeerNotifySettingsEmpty, 0, 0 },
+    { TLValue::PeerNotifySettings, 0, 4 },
+};
+
+static const TLTypeDescriptor s_peerNotifySettingsDescriptor = { s_peerNotifySettingsConstructors, 2, s_peerNotifySettingsFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLPeerNotifySettings &peerNotifySettingsValue)
+{
+    TLPeerNotifySettings result;
+
+    readByDescriptor(&result, &result.tlType, s_peerNotifySettingsDescriptor);
+
+    peerNotifySettingsValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_photoSizeFields[] = {
+    { &fieldAddress<TLPhotoSize, decltype(TLPhotoSize::type), &TLPhotoSize::type>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLPhotoSize, decltype(TLPhotoSize::type), &TLPhotoSize::type>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLPhotoSize, decltype(TLPhotoSize::location), &TLPhotoSize::location>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLFileLocation> },
+    { &fieldAddress<TLPhotoSize, decltype(TLPhotoSize::w), &TLPhotoSize::w>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLPhotoSize, decltype(TLPhotoSize::h), &TLPhotoSize::h>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLPhotoSize, decltype(TLPhotoSize::size), &TLPhotoSize::size>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLPhotoSize, decltype(TLPhotoSize::type), &TLPhotoSize::type>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLPhotoSize, decltype(TLPhotoSize::location), &TLPhotoSize::location>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLFileLocation> },
+    { &fieldAddress<TLPhotoSize, decltype(TLPhotoSize::w), &TLPhotoSize::w>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLPhotoSize, decltype(TLPhotoSize::h), &TLPhotoSize::h>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLPhotoSize, decltype(TLPhotoSize::bytes), &TLPhotoSize::bytes>, TLFieldDescriptor::Bytes, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_photoSizeConstructors[] = {
+    { TLValue::PhotoSizeEmpty, 0, 1 },
+    { TLValue::PhotoSize, 1, 5 },
+    { TLValue::PhotoCachedSize, 6, 5 },
+};
+
+static const TLTypeDescriptor s_photoSizeDescriptor = { s_photoSizeConstructors, 3, s_photoSizeFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLPhotoSize &photoSizeValue)
+{
+    TLPhotoSize result;
+
+    readByDescriptor(&result, &result.tlType, s_photoSizeDescriptor);
+
+    photoSizeValue = result;
+
+    return *this;
+}
+
+static const TLConstructorDescriptor s_privacyKeyConstructors[] = {
+    { TLValue::PrivacyKeyStatusTimestamp, 0, 0 },
+};
+
+static const TLTypeDescriptor s_privacyKeyDescriptor = { s_privacyKeyConstructors, 1, nullptr };
+
+CTelegramStream &CTelegramStream::operator>>(TLPrivacyKey &privacyKeyValue)
+{
+    TLPrivacyKey result;
+
+    readByDescriptor(&result, &result.tlType, s_privacyKeyDescriptor);
+
+    privacyKeyValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_privacyRuleFields[] = {
+    { &fieldAddress<TLPrivacyRule, decltype(TLPrivacyRule::users), &TLPrivacyRule::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<quint32>> },
+};
+
+static const TLConstructorDescriptor s_privacyRuleConstructors[] = {
+    { TLValue::PrivacyValueAllowContacts, 0, 0 },
+    { TLValue::PrivacyValueAllowAll, 0, 0 },
+    { TLValue::PrivacyValueAllowUsers, 0, 1 },
+    { TLValue::PrivacyValueDisallowContacts, 0, 0 },
+    { TLValue::PrivacyValueDisallowAll, 0, 0 },
+    { TLValue::PrivacyValueDisallowUsers, 0, 1 },
+};
+
+static const TLTypeDescriptor s_privacyRuleDescriptor = { s_privacyRuleConstructors, 6, s_privacyRuleFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLPrivacyRule &privacyRuleValue)
+{
+    TLPrivacyRule result;
+
+    readByDescriptor(&result, &result.tlType, s_privacyRuleDescriptor);
+
+    privacyRuleValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_receivedNotifyMessageFields[] = {
+    { &fieldAddress<TLReceivedNotifyMessage, decltype(TLReceivedNotifyMessage::id), &TLReceivedNotifyMessage::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLReceivedNotifyMessage, decltype(TLReceivedNotifyMessage::flags), &TLReceivedNotifyMessage::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_receivedNotifyMessageConstructors[] = {
+    { TLValue::ReceivedNotifyMessage, 0, 2 },
+};
+
+static const TLTypeDescriptor s_receivedNotifyMessageDescriptor = { s_receivedNotifyMessageConstructors, 1, s_receivedNotifyMessageFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLReceivedNotifyMessage &receivedNotifyMessageValue)
+{
+    TLReceivedNotifyMessage result;
+
+    readByDescriptor(&result, &result.tlType, s_receivedNotifyMessageDescriptor);
+
+    receivedNotifyMessageValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_reportReasonFields[] = {
+    { &fieldAddress<TLReportReason, decltype(TLReportReason::text), &TLReportReason::text>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_reportReasonConstructors[] = {
+    { TLValue::InputReportReasonSpam, 0, 0 },
+    { TLValue::InputReportReasonViolence, 0, 0 },
+    { TLValue::InputReportReasonPornography, 0, 0 },
+    { TLValue::InputReportReasonOther, 0, 1 },
+};
+
+static const TLTypeDescriptor s_reportReasonDescriptor = { s_reportReasonConstructors, 4, s_reportReasonFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLReportReason &reportReasonValue)
+{
+    TLReportReason result;
+
+    readByDescriptor(&result, &result.tlType, s_reportReasonDescriptor);
+
+    reportReasonValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_sendMessageActionFields[] = {
+    { &fieldAddress<TLSendMessageAction, decltype(TLSendMessageAction::progress), &TLSendMessageAction::progress>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_sendMessageActionConstructors[] = {
+    { TLValue::SendMessageTypingAction, 0, 0 },
+    { TLValue::SendMessageCancelAction, 0, 0 },
+    { TLValue::SendMessageRecordVideoAction, 0, 0 },
+    { TLValue::SendMessageUploadVideoAction, 0, 1 },
+    { TLValue::SendMessageRecordAudioAction, 0, 0 },
+    { TLValue::SendMessageUploadAudioAction, 0, 1 },
+    { TLValue::SendMessageUploadPhotoAction, 0, 1 },
+    { TLValue::SendMessageUploadDocumentAction, 0, 1 },
+    { TLValue::SendMessageGeoLocationAction, 0, 0 },
+    { TLValue::SendMessageChooseContactAction, 0, 0 },
+};
+
+static const TLTypeDescriptor s_sendMessageActionDescriptor = { s_sendMessageActionConstructors, 10, s_sendMessageActionFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLSendMessageAction &sendMessageActionValue)
+{
+    TLSendMessageAction result;
+
+    readByDescriptor(&result, &result.tlType, s_sendMessageActionDescriptor);
+
+    sendMessageActionValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_stickerPackFields[] = {
+    { &fieldAddress<TLStickerPack, decltype(TLStickerPack::emoticon), &TLStickerPack::emoticon>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLStickerPack, decltype(TLStickerPack::documents), &TLStickerPack::documents>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<quint64>> },
+};
+
+static const TLConstructorDescriptor s_stickerPackConstructors[] = {
+    { TLValue::StickerPack, 0, 2 },
+};
+
+static const TLTypeDescriptor s_stickerPackDescriptor = { s_stickerPackConstructors, 1, s_stickerPackFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLStickerPack &stickerPackValue)
+{
+    TLStickerPack result;
+
+    readByDescriptor(&result, &result.tlType, s_stickerPackDescriptor);
+
+    stickerPackValue = result;
+
+    return *this;
+}
+
+static const TLConstructorDescriptor s_storageFileTypeConstructors[] = {
+    { TLValue::StorageFileUnknown, 0, 0 },
+    { TLValue::StorageFileJpeg, 0, 0 },
+    { TLValue::StorageFileGif, 0, 0 },
+    { TLValue::StorageFilePng, 0, 0 },
+    { TLValue::StorageFilePdf, 0, 0 },
+    { TLValue::StorageFileMp3, 0, 0 },
+    { TLValue::StorageFileMov, 0, 0 },
+    { TLValue::StorageFilePartial, 0, 0 },
+    { TLValue::StorageFileMp4, 0, 0 },
+    { TLValue::StorageFileWebp, 0, 0 },
+};
+
+static const TLTypeDescriptor s_storageFileTypeDescriptor = { s_storageFileTypeConstructors, 10, nullptr };
+
+CTelegramStream &CTelegramStream::operator>>(TLStorageFileType &storageFileTypeValue)
+{
+    TLStorageFileType result;
+
+    readByDescriptor(&result, &result.tlType, s_storageFileTypeDescriptor);
+
+    storageFileTypeValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_updatesStateFields[] = {
+    { &fieldAddress<TLUpdatesState, decltype(TLUpdatesState::pts), &TLUpdatesState::pts>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdatesState, decltype(TLUpdatesState::qts), &TLUpdatesState::qts>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdatesState, decltype(TLUpdatesState::date), &TLUpdatesState::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdatesState, decltype(TLUpdatesState::seq), &TLUpdatesState::seq>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdatesState, decltype(TLUpdatesState::unreadCount), &TLUpdatesState::unreadCount>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_updatesStateConstructors[] = {
+    { TLValue::UpdatesState, 0, 5 },
+};
+
+static const TLTypeDescriptor s_updatesStateDescriptor = { s_updatesStateConstructors, 1, s_updatesStateFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLUpdatesState &updatesStateValue)
+{
+    TLUpdatesState result;
+
+    readByDescriptor(&result, &result.tlType, s_updatesStateDescriptor);
+
+    updatesStateValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_uploadFileFields[] = {
+    { &fieldAddress<TLUploadFile, decltype(TLUploadFile::type), &TLUploadFile::type>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLStorageFileType> },
+    { &fieldAddress<TLUploadFile, decltype(TLUploadFile::mtime), &TLUploadFile::mtime>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUploadFile, decltype(TLUploadFile::bytes), &TLUploadFile::bytes>, TLFieldDescriptor::Bytes, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_uploadFileConstructors[] = {
+    { TLValue::UploadFile, 0, 3 },
+};
+
+static const TLTypeDescriptor s_uploadFileDescriptor = { s_uploadFileConstructors, 1, s_uploadFileFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLUploadFile &uploadFileValue)
+{
+    TLUploadFile result;
+
+    readByDescriptor(&result, &result.tlType, s_uploadFileDescriptor);
+
+    uploadFileValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_userProfilePhotoFields[] = {
+    { &fieldAddress<TLUserProfilePhoto, decltype(TLUserProfilePhoto::photoId), &TLUserProfilePhoto::photoId>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLUserProfilePhoto, decltype(TLUserProfilePhoto::photoSmall), &TLUserProfilePhoto::photoSmall>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLFileLocation> },
+    { &fieldAddress<TLUserProfilePhoto, decltype(TLUserProfilePhoto::photoBig), &TLUserProfilePhoto::photoBig>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLFileLocation> },
+};
+
+static const TLConstructorDescriptor s_userProfilePhotoConstructors[] = {
+    { TLValue::UserProfilePhotoEmpty, 0, 0 },
+    { TLValue::UserProfilePhoto, 0, 3 },
+};
+
+static const TLTypeDescriptor s_userProfilePhotoDescriptor = { s_userProfilePhotoConstructors, 2, s_userProfilePhotoFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLUserProfilePhoto &userProfilePhotoValue)
+{
+    TLUserProfilePhoto result;
+
+    readByDescriptor(&result, &result.tlType, s_userProfilePhotoDescriptor);
+
+    userProfilePhotoValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_userStatusFields[] = {
+    { &fieldAddress<TLUserStatus, decltype(TLUserStatus::expires), &TLUserStatus::expires>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUserStatus, decltype(TLUserStatus::wasOnline), &TLUserStatus::wasOnline>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_userStatusConstructors[] = {
+    { TLValue::UserStatusEmpty, 0, 0 },
+    { TLValue::UserStatusOnline, 0, 1 },
+    { TLValue::UserStatusOffline, 1, 1 },
+    { TLValue::UserStatusRecently, 0, 0 },
+    { TLValue::UserStatusLastWeek, 0, 0 },
+    { TLValue::UserStatusLastMonth, 0, 0 },
+};
+
+static const TLTypeDescriptor s_userStatusDescriptor = { s_userStatusConstructors, 6, s_userStatusFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLUserStatus &userStatusValue)
+{
+    TLUserStatus result;
+
+    readByDescriptor(&result, &result.tlType, s_userStatusDescriptor);
+
+    userStatusValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_videoFields[] = {
+    { &fieldAddress<TLVideo, decltype(TLVideo::id), &TLVideo::id>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLVideo, decltype(TLVideo::id), &TLVideo::id>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLVideo, decltype(TLVideo::accessHash), &TLVideo::accessHash>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLVideo, decltype(TLVideo::date), &TLVideo::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLVideo, decltype(TLVideo::duration), &TLVideo::duration>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLVideo, decltype(TLVideo::mimeType), &TLVideo::mimeType>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLVideo, decltype(TLVideo::size), &TLVideo::size>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLVideo, decltype(TLVideo::thumb), &TLVideo::thumb>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLPhotoSize> },
+    { &fieldAddress<TLVideo, decltype(TLVideo::dcId), &TLVideo::dcId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLVideo, decltype(TLVideo::w), &TLVideo::w>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLVideo, decltype(TLVideo::h), &TLVideo::h>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_videoConstructors[] = {
+    { TLValue::VideoEmpty, 0, 1 },
+    { TLValue::Video, 1, 10 },
+};
+
+static const TLTypeDescriptor s_videoDescriptor = { s_videoConstructors, 2, s_videoFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLVideo &videoValue)
+{
+    TLVideo result;
+
+    readByDescriptor(&result, &result.tlType, s_videoDescriptor);
+
+    videoValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_wallPaperFields[] = {
+    { &fieldAddress<TLWallPaper, decltype(TLWallPaper::id), &TLWallPaper::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLWallPaper, decltype(TLWallPaper::title), &TLWallPaper::title>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLWallPaper, decltype(TLWallPaper::sizes), &TLWallPaper::sizes>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLPhotoSize>> },
+    { &fieldAddress<TLWallPaper, decltype(TLWallPaper::color), &TLWallPaper::color>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLWallPaper, decltype(TLWallPaper::id), &TLWallPaper::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLWallPaper, decltype(TLWallPaper::title), &TLWallPaper::title>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLWallPaper, decltype(TLWallPaper::bgColor), &TLWallPaper::bgColor>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLWallPaper, decltype(TLWallPaper::color), &TLWallPaper::color>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_wallPaperConstructors[] = {
+    { TLValue::WallPaper, 0, 4 },
+    { TLValue::WallPaperSolid, 4, 4 },
+};
+
+static const TLTypeDescriptor s_wallPaperDescriptor = { s_wallPaperConstructors, 2, s_wallPaperFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLWallPaper &wallPaperValue)
+{
+    TLWallPaper result;
+
+    readByDescriptor(&result, &result.tlType, s_wallPaperDescriptor);
+
+    wallPaperValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_accountAuthorizationsFields[] = {
+    { &fieldAddress<TLAccountAuthorizations, decltype(TLAccountAuthorizations::authorizations), &TLAccountAuthorizations::authorizations>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLAuthorization>> },
+};
+
+static const TLConstructorDescriptor s_accountAuthorizationsConstructors[] = {
+    { TLValue::AccountAuthorizations, 0, 1 },
+};
+
+static const TLTypeDescriptor s_accountAuthorizationsDescriptor = { s_accountAuthorizationsConstructors, 1, s_accountAuthorizationsFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLAccountAuthorizations &accountAuthorizationsValue)
+{
+    TLAccountAuthorizations result;
+
+    readByDescriptor(&result, &result.tlType, s_accountAuthorizationsDescriptor);
+
+    accountAuthorizationsValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_botInlineMessageFields[] = {
+    { &fieldAddress<TLBotInlineMessage, decltype(TLBotInlineMessage::caption), &TLBotInlineMessage::caption>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLBotInlineMessage, decltype(TLBotInlineMessage::flags), &TLBotInlineMessage::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLBotInlineMessage, decltype(TLBotInlineMessage::message), &TLBotInlineMessage::message>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLBotInlineMessage, decltype(TLBotInlineMessage::entities), &TLBotInlineMessage::entities>, TLFieldDescriptor::Custom, 1, &fieldAddress<TLBotInlineMessage, decltype(TLBotInlineMessage::flags), &TLBotInlineMessage::flags>, &readField<TLVector<TLMessageEntity>> },
+};
+
+static const TLConstructorDescriptor s_botInlineMessageConstructors[] = {
+    { TLValue::BotInlineMessageMediaAuto, 0, 1 },
+    { TLValue::BotInlineMessageText, 1, 3 },
+};
+
+static const TLTypeDescriptor s_botInlineMessageDescriptor = { s_botInlineMessageConstructors, 2, s_botInlineMessageFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLBotInlineMessage &botInlineMessageValue)
+{
+    TLBotInlineMessage result;
+
+    readByDescriptor(&result, &result.tlType, s_botInlineMessageDescriptor);
+
+    botInlineMessageValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_channelMessagesFilterFields[] = {
+    { &fieldAddress<TLChannelMessagesFilter, decltype(TLChannelMessagesFilter::flags), &TLChannelMessagesFilter::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChannelMessagesFilter, decltype(TLChannelMessagesFilter::ranges), &TLChannelMessagesFilter::ranges>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLMessageRange>> },
+};
+
+static const TLConstructorDescriptor s_channelMessagesFilterConstructors[] = {
+    { TLValue::ChannelMessagesFilterEmpty, 0, 0 },
+    { TLValue::ChannelMessagesFilter, 0, 2 },
+    { TLValue::ChannelMessagesFilterCollapsed, 0, 0 },
+};
+
+static const TLTypeDescriptor s_channelMessagesFilterDescriptor = { s_channelMessagesFilterConstructors, 3, s_channelMessagesFilterFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLChannelMessagesFilter &channelMessagesFilterValue)
+{
+    TLChannelMessagesFilter result;
+
+    readByDescriptor(&result, &result.tlType, s_channelMessagesFilterDescriptor);
+
+    channelMessagesFilterValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_chatPhotoFields[] = {
+    { &fieldAddress<TLChatPhoto, decltype(TLChatPhoto::photoSmall), &TLChatPhoto::photoSmall>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLFileLocation> },
+    { &fieldAddress<TLChatPhoto, decltype(TLChatPhoto::photoBig), &TLChatPhoto::photoBig>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLFileLocation> },
+};
+
+static const TLConstructorDescriptor s_chatPhotoConstructors[] = {
+    { TLValue::ChatPhotoEmpty, 0, 0 },
+    { TLValue::ChatPhoto, 0, 2 },
+};
+
+static const TLTypeDescriptor s_chatPhotoDescriptor = { s_chatPhotoConstructors, 2, s_chatPhotoFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLChatPhoto &chatPhotoValue)
+{
+    TLChatPhoto result;
+
+    readByDescriptor(&result, &result.tlType, s_chatPhotoDescriptor);
+
+    chatPhotoValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_contactStatusFields[] = {
+    { &fieldAddress<TLContactStatus, decltype(TLContactStatus::userId), &TLContactStatus::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLContactStatus, decltype(TLContactStatus::status), &TLContactStatus::status>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLUserStatus> },
+};
+
+static const TLConstructorDescriptor s_contactStatusConstructors[] = {
+    { TLValue::ContactStatus, 0, 2 },
+};
+
+static const TLTypeDescriptor s_contactStatusDescriptor = { s_contactStatusConstructors, 1, s_contactStatusFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLContactStatus &contactStatusValue)
+{
+    TLContactStatus result;
+
+    readByDescriptor(&result, &result.tlType, s_contactStatusDescriptor);
+
+    contactStatusValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_dcOptionFields[] = {
+    { &fieldAddress<TLDcOption, decltype(TLDcOption::flags), &TLDcOption::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLDcOption, decltype(TLDcOption::id), &TLDcOption::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLDcOption, decltype(TLDcOption::ipAddress), &TLDcOption::ipAddress>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLDcOption, decltype(TLDcOption::port), &TLDcOption::port>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_dcOptionConstructors[] = {
+    { TLValue::DcOption, 0, 4 },
+};
+
+static const TLTypeDescriptor s_dcOptionDescriptor = { s_dcOptionConstructors, 1, s_dcOptionFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLDcOption &dcOptionValue)
+{
+    TLDcOption result;
+
+    readByDescriptor(&result, &result.tlType, s_dcOptionDescriptor);
+
+    dcOptionValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_dialogFields[] = {
+    { &fieldAddress<TLDialog, decltype(TLDialog::peer), &TLDialog::peer>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLPeer> },
+    { &fieldAddress<TLDialog, decltype(TLDialog::topMessage), &TLDialog::topMessage>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLDialog, decltype(TLDialog::readInboxMaxId), &TLDialog::readInboxMaxId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLDialog, decltype(TLDialog::unreadCount), &TLDialog::unreadCount>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLDialog, decltype(TLDialog::notifySettings), &TLDialog::notifySettings>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLPeerNotifySettings> },
+    { &fieldAddress<TLDialog, decltype(TLDialog::peer), &TLDialog::peer>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLPeer> },
+    { &fieldAddress<TLDialog, decltype(TLDialog::topMessage), &TLDialog::topMessage>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLDialog, decltype(TLDialog::topImportantMessage), &TLDialog::topImportantMessage>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLDialog, decltype(TLDialog::readInboxMaxId), &TLDialog::readInboxMaxId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLDialog, decltype(TLDialog::unreadCount), &TLDialog::unreadCount>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLDialog, decltype(TLDialog::unreadImportantCount), &TLDialog::unreadImportantCount>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLDialog, decltype(TLDialog::notifySettings), &TLDialog::notifySettings>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLPeerNotifySettings> },
+    { &fieldAddress<TLDialog, decltype(TLDialog::pts), &TLDialog::pts>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_dialogConstructors[] = {
+    { TLValue::Dialog, 0, 5 },
+    { TLValue::DialogChannel, 5, 8 },
+};
+
+static const TLTypeDescriptor s_dialogDescriptor = { s_dialogConstructors, 2, s_dialogFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLDialog &dialogValue)
+{
+    TLDialog result;
+
+    readByDescriptor(&result, &result.tlType, s_dialogDescriptor);
+
+    dialogValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_documentAttributeFields[] = {
+    { &fieldAddress<TLDocumentAttribute, decltype(TLDocumentAttribute::w), &TLDocumentAttribute::w>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLDocumentAttribute, decltype(TLDocumentAttribute::h), &TLDocumentAttribute::h>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLDocumentAttribute, decltype(TLDocumentAttribute::alt), &TLDocumentAttribute::alt>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLDocumentAttribute, decltype(TLDocumentAttribute::stickerset), &TLDocumentAttribute::stickerset>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLInputStickerSet> },
+    { &fieldAddress<TLDocumentAttribute, decltype(TLDocumentAttribute::duration), &TLDocumentAttribute::duration>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLDocumentAttribute, decltype(TLDocumentAttribute::w), &TLDocumentAttribute::w>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLDocumentAttribute, decltype(TLDocumentAttribute::h), &TLDocumentAttribute::h>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLDocumentAttribute, decltype(TLDocumentAttribute::duration), &TLDocumentAttribute::duration>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLDocumentAttribute, decltype(TLDocumentAttribute::title), &TLDocumentAttribute::title>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLDocumentAttribute, decltype(TLDocumentAttribute::performer), &TLDocumentAttribute::performer>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLDocumentAttribute, decltype(TLDocumentAttribute::fileName), &TLDocumentAttribute::fileName>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_documentAttributeConstructors[] = {
+    { TLValue::DocumentAttributeImageSize, 0, 2 },
+    { TLValue::DocumentAttributeAnimated, 0, 0 },
+    { TLValue::DocumentAttributeSticker, 2, 2 },
+    { TLValue::DocumentAttributeVideo, 4, 3 },
+    { TLValue::DocumentAttributeAudio, 7, 3 },
+    { TLValue::DocumentAttributeFilename, 10, 1 },
+};
+
+static const TLTypeDescriptor s_documentAttributeDescriptor = { s_documentAttributeConstructors, 6, s_documentAttributeFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLDocumentAttribute &documentAttributeValue)
+{
+    TLDocumentAttribute result;
+
+    readByDescriptor(&result, &result.tlType, s_documentAttributeDescriptor);
+
+    documentAttributeValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_inputBotInlineMessageFields[] = {
+    { &fieldAddress<TLInputBotInlineMessage, decltype(TLInputBotInlineMessage::caption), &TLInputBotInlineMessage::caption>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputBotInlineMessage, decltype(TLInputBotInlineMessage::flags), &TLInputBotInlineMessage::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputBotInlineMessage, decltype(TLInputBotInlineMessage::message), &TLInputBotInlineMessage::message>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputBotInlineMessage, decltype(TLInputBotInlineMessage::entities), &TLInputBotInlineMessage::entities>, TLFieldDescriptor::Custom, 1, &fieldAddress<TLInputBotInlineMessage, decltype(TLInputBotInlineMessage::flags), &TLInputBotInlineMessage::flags>, &readField<TLVector<TLMessageEntity>> },
+};
+
+static const TLConstructorDescriptor s_inputBotInlineMessageConstructors[] = {
+    { TLValue::InputBotInlineMessageMediaAuto, 0, 1 },
+    { TLValue::InputBotInlineMessageText, 1, 3 },
+};
+
+static const TLTypeDescriptor s_inputBotInlineMessageDescriptor = { s_inputBotInlineMessageConstructors, 2, s_inputBotInlineMessageFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLInputBotInlineMessage &inputBotInlineMessageValue)
+{
+    TLInputBotInlineMessage result;
+
+    readByDescriptor(&result, &result.tlType, s_inputBotInlineMessageDescriptor);
+
+    inputBotInlineMessageValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_inputBotInlineResultFields[] = {
+    { &fieldAddress<TLInputBotInlineResult, decltype(TLInputBotInlineResult::flags), &TLInputBotInlineResult::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputBotInlineResult, decltype(TLInputBotInlineResult::id), &TLInputBotInlineResult::id>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputBotInlineResult, decltype(TLInputBotInlineResult::type), &TLInputBotInlineResult::type>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputBotInlineResult, decltype(TLInputBotInlineResult::title), &TLInputBotInlineResult::title>, TLFieldDescriptor::String, 1, &fieldAddress<TLInputBotInlineResult, decltype(TLInputBotInlineResult::flags), &TLInputBotInlineResult::flags>, nullptr },
+    { &fieldAddress<TLInputBotInlineResult, decltype(TLInputBotInlineResult::description), &TLInputBotInlineResult::description>, TLFieldDescriptor::String, 2, &fieldAddress<TLInputBotInlineResult, decltype(TLInputBotInlineResult::flags), &TLInputBotInlineResult::flags>, nullptr },
+    { &fieldAddress<TLInputBotInlineResult, decltype(TLInputBotInlineResult::url), &TLInputBotInlineResult::url>, TLFieldDescriptor::String, 3, &fieldAddress<TLInputBotInlineResult, decltype(TLInputBotInlineResult::flags), &TLInputBotInlineResult::flags>, nullptr },
+    { &fieldAddress<TLInputBotInlineResult, decltype(TLInputBotInlineResult::thumbUrl), &TLInputBotInlineResult::thumbUrl>, TLFieldDescriptor::String, 4, &fieldAddress<TLInputBotInlineResult, decltype(TLInputBotInlineResult::flags), &TLInputBotInlineResult::flags>, nullptr },
+    { &fieldAddress<TLInputBotInlineResult, decltype(TLInputBotInlineResult::contentUrl), &TLInputBotInlineResult::contentUrl>, TLFieldDescriptor::String, 5, &fieldAddress<TLInputBotInlineResult, decltype(TLInputBotInlineResult::flags), &TLInputBotInlineResult::flags>, nullptr },
+    { &fieldAddress<TLInputBotInlineResult, decltype(TLInputBotInlineResult::contentType), &TLInputBotInlineResult::contentType>, TLFieldDescriptor::String, 5, &fieldAddress<TLInputBotInlineResult, decltype(TLInputBotInlineResult::flags), &TLInputBotInlineResult::flags>, nullptr },
+    { &fieldAddress<TLInputBotInlineResult, decltype(TLInputBotInlineResult::w), &TLInputBotInlineResult::w>, TLFieldDescriptor::UInt32, 6, &fieldAddress<TLInputBotInlineResult, decltype(TLInputBotInlineResult::flags), &TLInputBotInlineResult::flags>, nullptr },
+    { &fieldAddress<TLInputBotInlineResult, decltype(TLInputBotInlineResult::h), &TLInputBotInlineResult::h>, TLFieldDescriptor::UInt32, 6, &fieldAddress<TLInputBotInlineResult, decltype(TLInputBotInlineResult::flags), &TLInputBotInlineResult::flags>, nullptr },
+    { &fieldAddress<TLInputBotInlineResult, decltype(TLInputBotInlineResult::duration), &TLInputBotInlineResult::duration>, TLFieldDescriptor::UInt32, 7, &fieldAddress<TLInputBotInlineResult, decltype(TLInputBotInlineResult::flags), &TLInputBotInlineResult::flags>, nullptr },
+    { &fieldAddress<TLInputBotInlineResult, decltype(TLInputBotInlineResult::sendMessage), &TLInputBotInlineResult::sendMessage>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLInputBotInlineMessage> },
+};
+
+static const TLConstructorDescriptor s_inputBotInlineResultConstructors[] = {
+    { TLValue::InputBotInlineResult, 0, 13 },
+};
+
+static const TLTypeDescriptor s_inputBotInlineResultDescriptor = { s_inputBotInlineResultConstructors, 1, s_inputBotInlineResultFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLInputBotInlineResult &inputBotInlineResultValue)
+{
+    TLInputBotInlineResult result;
+
+    readByDescriptor(&result, &result.tlType, s_inputBotInlineResultDescriptor);
+
+    inputBotInlineResultValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_inputChatPhotoFields[] = {
+    { &fieldAddress<TLInputChatPhoto, decltype(TLInputChatPhoto::file), &TLInputChatPhoto::file>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLInputFile> },
+    { &fieldAddress<TLInputChatPhoto, decltype(TLInputChatPhoto::crop), &TLInputChatPhoto::crop>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLInputPhotoCrop> },
+    { &fieldAddress<TLInputChatPhoto, decltype(TLInputChatPhoto::id), &TLInputChatPhoto::id>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLInputPhoto> },
+    { &fieldAddress<TLInputChatPhoto, decltype(TLInputChatPhoto::crop), &TLInputChatPhoto::crop>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLInputPhotoCrop> },
+};
+
+static const TLConstructorDescriptor s_inputChatPhotoConstructors[] = {
+    { TLValue::InputChatPhotoEmpty, 0, 0 },
+    { TLValue::InputChatUploadedPhoto, 0, 2 },
+    { TLValue::InputChatPhoto, 2, 2 },
+};
+
+static const TLTypeDescriptor s_inputChatPhotoDescriptor = { s_inputChatPhotoConstructors, 3, s_inputChatPhotoFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLInputChatPhoto &inputChatPhotoValue)
+{
+    TLInputChatPhoto result;
+
+    readByDescriptor(&result, &result.tlType, s_inputChatPhotoDescriptor);
+
+    inputChatPhotoValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_inputMediaFields[] = {
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::file), &TLInputMedia::file>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLInputFile> },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::caption), &TLInputMedia::caption>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::inputPhotoId), &TLInputMedia::inputPhotoId>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLInputPhoto> },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::caption), &TLInputMedia::caption>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::geoPoint), &TLInputMedia::geoPoint>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLInputGeoPoint> },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::phoneNumber), &TLInputMedia::phoneNumber>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::firstName), &TLInputMedia::firstName>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::lastName), &TLInputMedia::lastName>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::file), &TLInputMedia::file>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLInputFile> },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::duration), &TLInputMedia::duration>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::w), &TLInputMedia::w>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::h), &TLInputMedia::h>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::mimeType), &TLInputMedia::mimeType>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::caption), &TLInputMedia::caption>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::file), &TLInputMedia::file>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLInputFile> },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::thumb), &TLInputMedia::thumb>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLInputFile> },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::duration), &TLInputMedia::duration>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::w), &TLInputMedia::w>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::h), &TLInputMedia::h>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::mimeType), &TLInputMedia::mimeType>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::caption), &TLInputMedia::caption>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::inputVideoId), &TLInputMedia::inputVideoId>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLInputVideo> },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::caption), &TLInputMedia::caption>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::file), &TLInputMedia::file>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLInputFile> },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::duration), &TLInputMedia::duration>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::mimeType), &TLInputMedia::mimeType>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::inputAudioId), &TLInputMedia::inputAudioId>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLInputAudio> },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::file), &TLInputMedia::file>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLInputFile> },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::mimeType), &TLInputMedia::mimeType>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::attributes), &TLInputMedia::attributes>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLDocumentAttribute>> },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::caption), &TLInputMedia::caption>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::file), &TLInputMedia::file>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLInputFile> },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::thumb), &TLInputMedia::thumb>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLInputFile> },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::mimeType), &TLInputMedia::mimeType>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::attributes), &TLInputMedia::attributes>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLDocumentAttribute>> },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::caption), &TLInputMedia::caption>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::inputDocumentId), &TLInputMedia::inputDocumentId>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLInputDocument> },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::caption), &TLInputMedia::caption>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::geoPoint), &TLInputMedia::geoPoint>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLInputGeoPoint> },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::title), &TLInputMedia::title>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::address), &TLInputMedia::address>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::provider), &TLInputMedia::provider>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::venueId), &TLInputMedia::venueId>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::url), &TLInputMedia::url>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLInputMedia, decltype(TLInputMedia::q), &TLInputMedia::q>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_inputMediaConstructors[] = {
+    { TLValue::InputMediaEmpty, 0, 0 },
+    { TLValue::InputMediaUploadedPhoto, 0, 2 },
+    { TLValue::InputMediaPhoto, 2, 2 },
+    { TLValue::InputMediaGeoPoint, 4, 1 },
+    { TLValue::InputMediaContact, 5, 3 },
+    { TLValue::InputMediaUploadedVideo, 8, 6 },
+    { TLValue::InputMediaUploadedThumbVideo, 14, 7 },
+    { TLValue::InputMediaVideo, 21, 2 },
+    { TLValue::InputMediaUploadedAudio, 23, 3 },
+    { TLValue::InputMediaAudio, 26, 1 },
+    { TLValue::InputMediaUploadedDocument, 27, 4 },
+    { TLValue::InputMediaUploadedThumbDocument, 31, 5 },
+    { TLValue::InputMediaDocument, 36, 2 },
+    { TLValue::InputMediaVenue, 38, 5 },
+    { TLValue::InputMediaGifExternal, 43, 2 },
+};
+
+static const TLTypeDescriptor s_inputMediaDescriptor = { s_inputMediaConstructors, 15, s_inputMediaFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLInputMedia &inputMediaValue)
+{
+    TLInputMedia result;
+
+    readByDescriptor(&result, &result.tlType, s_inputMediaDescriptor);
+
+    inputMediaValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_inputNotifyPeerFields[] = {
+    { &fieldAddress<TLInputNotifyPeer, decltype(TLInputNotifyPeer::peer), &TLInputNotifyPeer::peer>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLInputPeer> },
+};
+
+static const TLConstructorDescriptor s_inputNotifyPeerConstructors[] = {
+    { TLValue::InputNotifyPeer, 0, 1 },
+    { TLValue::InputNotifyUsers, 0, 0 },
+    { TLValue::InputNotifyChats, 0, 0 },
+    { TLValue::InputNotifyAll, 0, 0 },
+};
+
+static const TLTypeDescriptor s_inputNotifyPeerDescriptor = { s_inputNotifyPeerConstructors, 4, s_inputNotifyPeerFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLInputNotifyPeer &inputNotifyPeerValue)
+{
+    TLInputNotifyPeer result;
+
+    readByDescriptor(&result, &result.tlType, s_inputNotifyPeerDescriptor);
+
+    inputNotifyPeerValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_inputPrivacyRuleFields[] = {
+    { &fieldAddress<TLInputPrivacyRule, decltype(TLInputPrivacyRule::users), &TLInputPrivacyRule::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLInputUser>> },
+};
+
+static const TLConstructorDescriptor s_inputPrivacyRuleConstructors[] = {
+    { TLValue::InputPrivacyValueAllowContacts, 0, 0 },
+    { TLValue::InputPrivacyValueAllowAll, 0, 0 },
+    { TLValue::InputPrivacyValueAllowUsers, 0, 1 },
+    { TLValue::InputPrivacyValueDisallowContacts, 0, 0 },
+    { TLValue::InputPrivacyValueDisallowAll, 0, 0 },
+    { TLValue::InputPrivacyValueDisallowUsers, 0, 1 },
+};
+
+static const TLTypeDescriptor s_inputPrivacyRuleDescriptor = { s_inputPrivacyRuleConstructors, 6, s_inputPrivacyRuleFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLInputPrivacyRule &inputPrivacyRuleValue)
+{
+    TLInputPrivacyRule result;
+
+    readByDescriptor(&result, &result.tlType, s_inputPrivacyRuleDescriptor);
+
+    inputPrivacyRuleValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_notifyPeerFields[] = {
+    { &fieldAddress<TLNotifyPeer, decltype(TLNotifyPeer::peer), &TLNotifyPeer::peer>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLPeer> },
+};
+
+static const TLConstructorDescriptor s_notifyPeerConstructors[] = {
+    { TLValue::NotifyPeer, 0, 1 },
+    { TLValue::NotifyUsers, 0, 0 },
+    { TLValue::NotifyChats, 0, 0 },
+    { TLValue::NotifyAll, 0, 0 },
+};
+
+static const TLTypeDescriptor s_notifyPeerDescriptor = { s_notifyPeerConstructors, 4, s_notifyPeerFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLNotifyPeer &notifyPeerValue)
+{
+    TLNotifyPeer result;
+
+    readByDescriptor(&result, &result.tlType, s_notifyPeerDescriptor);
+
+    notifyPeerValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_photoFields[] = {
+    { &fieldAddress<TLPhoto, decltype(TLPhoto::id), &TLPhoto::id>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLPhoto, decltype(TLPhoto::id), &TLPhoto::id>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLPhoto, decltype(TLPhoto::accessHash), &TLPhoto::accessHash>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLPhoto, decltype(TLPhoto::date), &TLPhoto::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLPhoto, decltype(TLPhoto::sizes), &TLPhoto::sizes>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLPhotoSize>> },
+};
+
+static const TLConstructorDescriptor s_photoConstructors[] = {
+    { TLValue::PhotoEmpty, 0, 1 },
+    { TLValue::Photo, 1, 4 },
+};
+
+static const TLTypeDescriptor s_photoDescriptor = { s_photoConstructors, 2, s_photoFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLPhoto &photoValue)
+{
+    TLPhoto result;
+
+    readByDescriptor(&result, &result.tlType, s_photoDescriptor);
+
+    photoValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_replyMarkupFields[] = {
+    { &fieldAddress<TLReplyMarkup, decltype(TLReplyMarkup::flags), &TLReplyMarkup::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLReplyMarkup, decltype(TLReplyMarkup::flags), &TLReplyMarkup::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLReplyMarkup, decltype(TLReplyMarkup::rows), &TLReplyMarkup::rows>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLKeyboardButtonRow>> },
+};
+
+static const TLConstructorDescriptor s_replyMarkupConstructors[] = {
+    { TLValue::ReplyKeyboardHide, 0, 1 },
+    { TLValue::ReplyKeyboardForceReply, 0, 1 },
+    { TLValue::ReplyKeyboardMarkup, 1, 2 },
+};
+
+static const TLTypeDescriptor s_replyMarkupDescriptor = { s_replyMarkupConstructors, 3, s_replyMarkupFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLReplyMarkup &replyMarkupValue)
+{
+    TLReplyMarkup result;
+
+    readByDescriptor(&result, &result.tlType, s_replyMarkupDescriptor);
+
+    replyMarkupValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_stickerSetFields[] = {
+    { &fieldAddress<TLStickerSet, decltype(TLStickerSet::flags), &TLStickerSet::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLStickerSet, decltype(TLStickerSet::id), &TLStickerSet::id>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLStickerSet, decltype(TLStickerSet::accessHash), &TLStickerSet::accessHash>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLStickerSet, decltype(TLStickerSet::title), &TLStickerSet::title>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLStickerSet, decltype(TLStickerSet::shortName), &TLStickerSet::shortName>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLStickerSet, decltype(TLStickerSet::count), &TLStickerSet::count>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLStickerSet, decltype(TLStickerSet::hash), &TLStickerSet::hash>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_stickerSetConstructors[] = {
+    { TLValue::StickerSet, 0, 7 },
+};
+
+static const TLTypeDescriptor s_stickerSetDescriptor = { s_stickerSetConstructors, 1, s_stickerSetFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLStickerSet &stickerSetValue)
+{
+    TLStickerSet result;
+
+    readByDescriptor(&result, &result.tlType, s_stickerSetDescriptor);
+
+    stickerSetValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_userFields[] = {
+    { &fieldAddress<TLUser, decltype(TLUser::id), &TLUser::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUser, decltype(TLUser::flags), &TLUser::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUser, decltype(TLUser::id), &TLUser::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUser, decltype(TLUser::accessHash), &TLUser::accessHash>, TLFieldDescriptor::UInt64, 0, &fieldAddress<TLUser, decltype(TLUser::flags), &TLUser::flags>, nullptr },
+    { &fieldAddress<TLUser, decltype(TLUser::firstName), &TLUser::firstName>, TLFieldDescriptor::String, 1, &fieldAddress<TLUser, decltype(TLUser::flags), &TLUser::flags>, nullptr },
+    { &fieldAddress<TLUser, decltype(TLUser::lastName), &TLUser::lastName>, TLFieldDescriptor::String, 2, &fieldAddress<TLUser, decltype(TLUser::flags), &TLUser::flags>, nullptr },
+    { &fieldAddress<TLUser, decltype(TLUser::username), &TLUser::username>, TLFieldDescriptor::String, 3, &fieldAddress<TLUser, decltype(TLUser::flags), &TLUser::flags>, nullptr },
+    { &fieldAddress<TLUser, decltype(TLUser::phone), &TLUser::phone>, TLFieldDescriptor::String, 4, &fieldAddress<TLUser, decltype(TLUser::flags), &TLUser::flags>, nullptr },
+    { &fieldAddress<TLUser, decltype(TLUser::photo), &TLUser::photo>, TLFieldDescriptor::Custom, 5, &fieldAddress<TLUser, decltype(TLUser::flags), &TLUser::flags>, &readField<TLUserProfilePhoto> },
+    { &fieldAddress<TLUser, decltype(TLUser::status), &TLUser::status>, TLFieldDescriptor::Custom, 6, &fieldAddress<TLUser, decltype(TLUser::flags), &TLUser::flags>, &readField<TLUserStatus> },
+    { &fieldAddress<TLUser, decltype(TLUser::botInfoVersion), &TLUser::botInfoVersion>, TLFieldDescriptor::UInt32, 14, &fieldAddress<TLUser, decltype(TLUser::flags), &TLUser::flags>, nullptr },
+    { &fieldAddress<TLUser, decltype(TLUser::restrictionReason), &TLUser::restrictionReason>, TLFieldDescriptor::String, 18, &fieldAddress<TLUser, decltype(TLUser::flags), &TLUser::flags>, nullptr },
+    { &fieldAddress<TLUser, decltype(TLUser::botInlinePlaceholder), &TLUser::botInlinePlaceholder>, TLFieldDescriptor::String, 19, &fieldAddress<TLUser, decltype(TLUser::flags), &TLUser::flags>, nullptr },
+};
+
+static const TLConstructorDescriptor s_userConstructors[] = {
+    { TLValue::UserEmpty, 0, 1 },
+    { TLValue::User, 1, 12 },
+};
+
+static const TLTypeDescriptor s_userDescriptor = { s_userConstructors, 2, s_userFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLUser &userValue)
+{
+    TLUser result;
+
+    readByDescriptor(&result, &result.tlType, s_userDescriptor);
+
+    userValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_accountPrivacyRulesFields[] = {
+    { &fieldAddress<TLAccountPrivacyRules, decltype(TLAccountPrivacyRules::rules), &TLAccountPrivacyRules::rules>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLPrivacyRule>> },
+    { &fieldAddress<TLAccountPrivacyRules, decltype(TLAccountPrivacyRules::users), &TLAccountPrivacyRules::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUser>> },
+};
+
+static const TLConstructorDescriptor s_accountPrivacyRulesConstructors[] = {
+    { TLValue::AccountPrivacyRules, 0, 2 },
+};
+
+static const TLTypeDescriptor s_accountPrivacyRulesDescriptor = { s_accountPrivacyRulesConstructors, 1, s_accountPrivacyRulesFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLAccountPrivacyRules &accountPrivacyRulesValue)
+{
+    TLAccountPrivacyRules result;
+
+    readByDescriptor(&result, &result.tlType, s_accountPrivacyRulesDescriptor);
+
+    accountPrivacyRulesValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_authAuthorizationFields[] = {
+    { &fieldAddress<TLAuthAuthorization, decltype(TLAuthAuthorization::user), &TLAuthAuthorization::user>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLUser> },
+};
+
+static const TLConstructorDescriptor s_authAuthorizationConstructors[] = {
+    { TLValue::AuthAuthorization, 0, 1 },
+};
+
+static const TLTypeDescriptor s_authAuthorizationDescriptor = { s_authAuthorizationConstructors, 1, s_authAuthorizationFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLAuthAuthorization &authAuthorizationValue)
+{
+    TLAuthAuthorization result;
+
+    readByDescriptor(&result, &result.tlType, s_authAuthorizationDescriptor);
+
+    authAuthorizationValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_channelsChannelParticipantFields[] = {
+    { &fieldAddress<TLChannelsChannelParticipant, decltype(TLChannelsChannelParticipant::participant), &TLChannelsChannelParticipant::participant>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLChannelParticipant> },
+    { &fieldAddress<TLChannelsChannelParticipant, decltype(TLChannelsChannelParticipant::users), &TLChannelsChannelParticipant::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUser>> },
+};
+
+static const TLConstructorDescriptor s_channelsChannelParticipantConstructors[] = {
+    { TLValue::ChannelsChannelParticipant, 0, 2 },
+};
+
+static const TLTypeDescriptor s_channelsChannelParticipantDescriptor = { s_channelsChannelParticipantConstructors, 1, s_channelsChannelParticipantFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLChannelsChannelParticipant &channelsChannelParticipantValue)
+{
+    TLChannelsChannelParticipant result;
+
+    readByDescriptor(&result, &result.tlType, s_channelsChannelParticipantDescriptor);
+
+    channelsChannelParticipantValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_channelsChannelParticipantsFields[] = {
+    { &fieldAddress<TLChannelsChannelParticipants, decltype(TLChannelsChannelParticipants::count), &TLChannelsChannelParticipants::count>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChannelsChannelParticipants, decltype(TLChannelsChannelParticipants::participants), &TLChannelsChannelParticipants::participants>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLChannelParticipant>> },
+    { &fieldAddress<TLChannelsChannelParticipants, decltype(TLChannelsChannelParticipants::users), &TLChannelsChannelParticipants::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUser>> },
+};
+
+static const TLConstructorDescriptor s_channelsChannelParticipantsConstructors[] = {
+    { TLValue::ChannelsChannelParticipants, 0, 3 },
+};
+
+static const TLTypeDescriptor s_channelsChannelParticipantsDescriptor = { s_channelsChannelParticipantsConstructors, 1, s_channelsChannelParticipantsFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLChannelsChannelParticipants &channelsChannelParticipantsValue)
+{
+    TLChannelsChannelParticipants result;
+
+    readByDescriptor(&result, &result.tlType, s_channelsChannelParticipantsDescriptor);
+
+    channelsChannelParticipantsValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_chatFields[] = {
+    { &fieldAddress<TLChat, decltype(TLChat::id), &TLChat::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChat, decltype(TLChat::flags), &TLChat::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChat, decltype(TLChat::id), &TLChat::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChat, decltype(TLChat::title), &TLChat::title>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLChat, decltype(TLChat::photo), &TLChat::photo>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLChatPhoto> },
+    { &fieldAddress<TLChat, decltype(TLChat::participantsCount), &TLChat::participantsCount>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChat, decltype(TLChat::date), &TLChat::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChat, decltype(TLChat::version), &TLChat::version>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChat, decltype(TLChat::migratedTo), &TLChat::migratedTo>, TLFieldDescriptor::Custom, 6, &fieldAddress<TLChat, decltype(TLChat::flags), &TLChat::flags>, &readField<TLInputChannel> },
+    { &fieldAddress<TLChat, decltype(TLChat::id), &TLChat::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChat, decltype(TLChat::title), &TLChat::title>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLChat, decltype(TLChat::flags), &TLChat::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChat, decltype(TLChat::id), &TLChat::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChat, decltype(TLChat::accessHash), &TLChat::accessHash>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLChat, decltype(TLChat::title), &TLChat::title>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLChat, decltype(TLChat::username), &TLChat::username>, TLFieldDescriptor::String, 6, &fieldAddress<TLChat, decltype(TLChat::flags), &TLChat::flags>, nullptr },
+    { &fieldAddress<TLChat, decltype(TLChat::photo), &TLChat::photo>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLChatPhoto> },
+    { &fieldAddress<TLChat, decltype(TLChat::date), &TLChat::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChat, decltype(TLChat::version), &TLChat::version>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChat, decltype(TLChat::restrictionReason), &TLChat::restrictionReason>, TLFieldDescriptor::String, 9, &fieldAddress<TLChat, decltype(TLChat::flags), &TLChat::flags>, nullptr },
+    { &fieldAddress<TLChat, decltype(TLChat::id), &TLChat::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChat, decltype(TLChat::accessHash), &TLChat::accessHash>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLChat, decltype(TLChat::title), &TLChat::title>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_chatConstructors[] = {
+    { TLValue::ChatEmpty, 0, 1 },
+    { TLValue::Chat, 1, 8 },
+    { TLValue::ChatForbidden, 9, 2 },
+    { TLValue::Channel, 11, 9 },
+    { TLValue::ChannelForbidden, 20, 3 },
+};
+
+static const TLTypeDescriptor s_chatDescriptor = { s_chatConstructors, 5, s_chatFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLChat &chatValue)
+{
+    TLChat result;
+
+    readByDescriptor(&result, &result.tlType, s_chatDescriptor);
+
+    chatValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_chatFullFields[] = {
+    { &fieldAddress<TLChatFull, decltype(TLChatFull::id), &TLChatFull::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChatFull, decltype(TLChatFull::participants), &TLChatFull::participants>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLChatParticipants> },
+    { &fieldAddress<TLChatFull, decltype(TLChatFull::chatPhoto), &TLChatFull::chatPhoto>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLPhoto> },
+    { &fieldAddress<TLChatFull, decltype(TLChatFull::notifySettings), &TLChatFull::notifySettings>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLPeerNotifySettings> },
+    { &fieldAddress<TLChatFull, decltype(TLChatFull::exportedInvite), &TLChatFull::exportedInvite>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLExportedChatInvite> },
+    { &fieldAddress<TLChatFull, decltype(TLChatFull::botInfo), &TLChatFull::botInfo>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLBotInfo>> },
+    { &fieldAddress<TLChatFull, decltype(TLChatFull::flags), &TLChatFull::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChatFull, decltype(TLChatFull::id), &TLChatFull::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChatFull, decltype(TLChatFull::about), &TLChatFull::about>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLChatFull, decltype(TLChatFull::participantsCount), &TLChatFull::participantsCount>, TLFieldDescriptor::UInt32, 0, &fieldAddress<TLChatFull, decltype(TLChatFull::flags), &TLChatFull::flags>, nullptr },
+    { &fieldAddress<TLChatFull, decltype(TLChatFull::adminsCount), &TLChatFull::adminsCount>, TLFieldDescriptor::UInt32, 1, &fieldAddress<TLChatFull, decltype(TLChatFull::flags), &TLChatFull::flags>, nullptr },
+    { &fieldAddress<TLChatFull, decltype(TLChatFull::kickedCount), &TLChatFull::kickedCount>, TLFieldDescriptor::UInt32, 2, &fieldAddress<TLChatFull, decltype(TLChatFull::flags), &TLChatFull::flags>, nullptr },
+    { &fieldAddress<TLChatFull, decltype(TLChatFull::readInboxMaxId), &TLChatFull::readInboxMaxId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChatFull, decltype(TLChatFull::unreadCount), &TLChatFull::unreadCount>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChatFull, decltype(TLChatFull::unreadImportantCount), &TLChatFull::unreadImportantCount>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChatFull, decltype(TLChatFull::chatPhoto), &TLChatFull::chatPhoto>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLPhoto> },
+    { &fieldAddress<TLChatFull, decltype(TLChatFull::notifySettings), &TLChatFull::notifySettings>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLPeerNotifySettings> },
+    { &fieldAddress<TLChatFull, decltype(TLChatFull::exportedInvite), &TLChatFull::exportedInvite>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLExportedChatInvite> },
+    { &fieldAddress<TLChatFull, decltype(TLChatFull::botInfo), &TLChatFull::botInfo>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLBotInfo>> },
+    { &fieldAddress<TLChatFull, decltype(TLChatFull::migratedFromChatId), &TLChatFull::migratedFromChatId>, TLFieldDescriptor::UInt32, 4, &fieldAddress<TLChatFull, decltype(TLChatFull::flags), &TLChatFull::flags>, nullptr },
+    { &fieldAddress<TLChatFull, decltype(TLChatFull::migratedFromMaxId), &TLChatFull::migratedFromMaxId>, TLFieldDescriptor::UInt32, 4, &fieldAddress<TLChatFull, decltype(TLChatFull::flags), &TLChatFull::flags>, nullptr },
+};
+
+static const TLConstructorDescriptor s_chatFullConstructors[] = {
+    { TLValue::ChatFull, 0, 6 },
+    { TLValue::ChannelFull, 6, 15 },
+};
+
+static const TLTypeDescriptor s_chatFullDescriptor = { s_chatFullConstructors, 2, s_chatFullFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLChatFull &chatFullValue)
+{
+    TLChatFull result;
+
+    readByDescriptor(&result, &result.tlType, s_chatFullDescriptor);
+
+    chatFullValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_chatInviteFields[] = {
+    { &fieldAddress<TLChatInvite, decltype(TLChatInvite::chat), &TLChatInvite::chat>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLChat> },
+    { &fieldAddress<TLChatInvite, decltype(TLChatInvite::flags), &TLChatInvite::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLChatInvite, decltype(TLChatInvite::title), &TLChatInvite::title>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_chatInviteConstructors[] = {
+    { TLValue::ChatInviteAlready, 0, 1 },
+    { TLValue::ChatInvite, 1, 2 },
+};
+
+static const TLTypeDescriptor s_chatInviteDescriptor = { s_chatInviteConstructors, 2, s_chatInviteFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLChatInvite &chatInviteValue)
+{
+    TLChatInvite result;
+
+    readByDescriptor(&result, &result.tlType, s_chatInviteDescriptor);
+
+    chatInviteValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_configFields[] = {
+    { &fieldAddress<TLConfig, decltype(TLConfig::date), &TLConfig::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLConfig, decltype(TLConfig::expires), &TLConfig::expires>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLConfig, decltype(TLConfig::testMode), &TLConfig::testMode>, TLFieldDescriptor::Bool, -1, nullptr, nullptr },
+    { &fieldAddress<TLConfig, decltype(TLConfig::thisDc), &TLConfig::thisDc>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLConfig, decltype(TLConfig::dcOptions), &TLConfig::dcOptions>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLDcOption>> },
+    { &fieldAddress<TLConfig, decltype(TLConfig::chatSizeMax), &TLConfig::chatSizeMax>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLConfig, decltype(TLConfig::megagroupSizeMax), &TLConfig::megagroupSizeMax>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLConfig, decltype(TLConfig::forwardedCountMax), &TLConfig::forwardedCountMax>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLConfig, decltype(TLConfig::onlineUpdatePeriodMs), &TLConfig::onlineUpdatePeriodMs>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLConfig, decltype(TLConfig::offlineBlurTimeoutMs), &TLConfig::offlineBlurTimeoutMs>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLConfig, decltype(TLConfig::offlineIdleTimeoutMs), &TLConfig::offlineIdleTimeoutMs>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLConfig, decltype(TLConfig::onlineCloudTimeoutMs), &TLConfig::onlineCloudTimeoutMs>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLConfig, decltype(TLConfig::notifyCloudDelayMs), &TLConfig::notifyCloudDelayMs>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLConfig, decltype(TLConfig::notifyDefaultDelayMs), &TLConfig::notifyDefaultDelayMs>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLConfig, decltype(TLConfig::chatBigSize), &TLConfig::chatBigSize>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLConfig, decltype(TLConfig::pushChatPeriodMs), &TLConfig::pushChatPeriodMs>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLConfig, decltype(TLConfig::pushChatLimit), &TLConfig::pushChatLimit>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLConfig, decltype(TLConfig::savedGifsLimit), &TLConfig::savedGifsLimit>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLConfig, decltype(TLConfig::disabledFeatures), &TLConfig::disabledFeatures>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLDisabledFeature>> },
+};
+
+static const TLConstructorDescriptor s_configConstructors[] = {
+    { TLValue::Config, 0, 19 },
+};
+
+static const TLTypeDescriptor s_configDescriptor = { s_configConstructors, 1, s_configFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLConfig &configValue)
+{
+    TLConfig result;
+
+    readByDescriptor(&result, &result.tlType, s_configDescriptor);
+
+    configValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_contactsBlockedFields[] = {
+    { &fieldAddress<TLContactsBlocked, decltype(TLContactsBlocked::blocked), &TLContactsBlocked::blocked>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLContactBlocked>> },
+    { &fieldAddress<TLContactsBlocked, decltype(TLContactsBlocked::users), &TLContactsBlocked::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUser>> },
+    { &fieldAddress<TLContactsBlocked, decltype(TLContactsBlocked::count), &TLContactsBlocked::count>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLContactsBlocked, decltype(TLContactsBlocked::blocked), &TLContactsBlocked::blocked>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLContactBlocked>> },
+    { &fieldAddress<TLContactsBlocked, decltype(TLContactsBlocked::users), &TLContactsBlocked::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUser>> },
+};
+
+static const TLConstructorDescriptor s_contactsBlockedConstructors[] = {
+    { TLValue::ContactsBlocked, 0, 2 },
+    { TLValue::ContactsBlockedSlice, 2, 3 },
+};
+
+static const TLTypeDescriptor s_contactsBlockedDescriptor = { s_contactsBlockedConstructors, 2, s_contactsBlockedFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLContactsBlocked &contactsBlockedValue)
+{
+    TLContactsBlocked result;
+
+    readByDescriptor(&result, &result.tlType, s_contactsBlockedDescriptor);
+
+    contactsBlockedValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_contactsContactsFields[] = {
+    { &fieldAddress<TLContactsContacts, decltype(TLContactsContacts::contacts), &TLContactsContacts::contacts>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLContact>> },
+    { &fieldAddress<TLContactsContacts, decltype(TLContactsContacts::users), &TLContactsContacts::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUser>> },
+};
+
+static const TLConstructorDescriptor s_contactsContactsConstructors[] = {
+    { TLValue::ContactsContactsNotModified, 0, 0 },
+    { TLValue::ContactsContacts, 0, 2 },
+};
+
+static const TLTypeDescriptor s_contactsContactsDescriptor = { s_contactsContactsConstructors, 2, s_contactsContactsFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLContactsContacts &contactsContactsValue)
+{
+    TLContactsContacts result;
+
+    readByDescriptor(&result, &result.tlType, s_contactsContactsDescriptor);
+
+    contactsContactsValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_contactsFoundFields[] = {
+    { &fieldAddress<TLContactsFound, decltype(TLContactsFound::results), &TLContactsFound::results>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLPeer>> },
+    { &fieldAddress<TLContactsFound, decltype(TLContactsFound::chats), &TLContactsFound::chats>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLChat>> },
+    { &fieldAddress<TLContactsFound, decltype(TLContactsFound::users), &TLContactsFound::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUser>> },
+};
+
+static const TLConstructorDescriptor s_contactsFoundConstructors[] = {
+    { TLValue::ContactsFound, 0, 3 },
+};
+
+static const TLTypeDescriptor s_contactsFoundDescriptor = { s_contactsFoundConstructors, 1, s_contactsFoundFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLContactsFound &contactsFoundValue)
+{
+    TLContactsFound result;
+
+    readByDescriptor(&result, &result.tlType, s_contactsFoundDescriptor);
+
+    contactsFoundValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_contactsImportedContactsFields[] = {
+    { &fieldAddress<TLContactsImportedContacts, decltype(TLContactsImportedContacts::imported), &TLContactsImportedContacts::imported>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLImportedContact>> },
+    { &fieldAddress<TLContactsImportedContacts, decltype(TLContactsImportedContacts::retryContacts), &TLContactsImportedContacts::retryContacts>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<quint64>> },
+    { &fieldAddress<TLContactsImportedContacts, decltype(TLContactsImportedContacts::users), &TLContactsImportedContacts::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUser>> },
+};
+
+static const TLConstructorDescriptor s_contactsImportedContactsConstructors[] = {
+    { TLValue::ContactsImportedContacts, 0, 3 },
+};
+
+static const TLTypeDescriptor s_contactsImportedContactsDescriptor = { s_contactsImportedContactsConstructors, 1, s_contactsImportedContactsFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLContactsImportedContacts &contactsImportedContactsValue)
+{
+    TLContactsImportedContacts result;
+
+    readByDescriptor(&result, &result.tlType, s_contactsImportedContactsDescriptor);
+
+    contactsImportedContactsValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_contactsLinkFields[] = {
+    { &fieldAddress<TLContactsLink, decltype(TLContactsLink::myLink), &TLContactsLink::myLink>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLContactLink> },
+    { &fieldAddress<TLContactsLink, decltype(TLContactsLink::foreignLink), &TLContactsLink::foreignLink>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLContactLink> },
+    { &fieldAddress<TLContactsLink, decltype(TLContactsLink::user), &TLContactsLink::user>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLUser> },
+};
+
+static const TLConstructorDescriptor s_contactsLinkConstructors[] = {
+    { TLValue::ContactsLink, 0, 3 },
+};
+
+static const TLTypeDescriptor s_contactsLinkDescriptor = { s_contactsLinkConstructors, 1, s_contactsLinkFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLContactsLink &contactsLinkValue)
+{
+    TLContactsLink result;
+
+    readByDescriptor(&result, &result.tlType, s_contactsLinkDescriptor);
+
+    contactsLinkValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_contactsResolvedPeerFields[] = {
+    { &fieldAddress<TLContactsResolvedPeer, decltype(TLContactsResolvedPeer::peer), &TLContactsResolvedPeer::peer>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLPeer> },
+    { &fieldAddress<TLContactsResolvedPeer, decltype(TLContactsResolvedPeer::chats), &TLContactsResolvedPeer::chats>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLChat>> },
+    { &fieldAddress<TLContactsResolvedPeer, decltype(TLContactsResolvedPeer::users), &TLContactsResolvedPeer::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUser>> },
+};
+
+static const TLConstructorDescriptor s_contactsResolvedPeerConstructors[] = {
+    { TLValue::ContactsResolvedPeer, 0, 3 },
+};
+
+static const TLTypeDescriptor s_contactsResolvedPeerDescriptor = { s_contactsResolvedPeerConstructors, 1, s_contactsResolvedPeerFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLContactsResolvedPeer &contactsResolvedPeerValue)
+{
+    TLContactsResolvedPeer result;
+
+    readByDescriptor(&result, &result.tlType, s_contactsResolvedPeerDescriptor);
+
+    contactsResolvedPeerValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_contactsSuggestedFields[] = {
+    { &fieldAddress<TLContactsSuggested, decltype(TLContactsSuggested::results), &TLContactsSuggested::results>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLContactSuggested>> },
+    { &fieldAddress<TLContactsSuggested, decltype(TLContactsSuggested::users), &TLContactsSuggested::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUser>> },
+};
+
+static const TLConstructorDescriptor s_contactsSuggestedConstructors[] = {
+    { TLValue::ContactsSuggested, 0, 2 },
+};
+
+static const TLTypeDescriptor s_contactsSuggestedDescriptor = { s_contactsSuggestedConstructors, 1, s_contactsSuggestedFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLContactsSuggested &contactsSuggestedValue)
+{
+    TLContactsSuggested result;
+
+    readByDescriptor(&result, &result.tlType, s_contactsSuggestedDescriptor);
+
+    contactsSuggestedValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_documentFields[] = {
+    { &fieldAddress<TLDocument, decltype(TLDocument::id), &TLDocument::id>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLDocument, decltype(TLDocument::id), &TLDocument::id>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLDocument, decltype(TLDocument::accessHash), &TLDocument::accessHash>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLDocument, decltype(TLDocument::date), &TLDocument::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLDocument, decltype(TLDocument::mimeType), &TLDocument::mimeType>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLDocument, decltype(TLDocument::size), &TLDocument::size>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLDocument, decltype(TLDocument::thumb), &TLDocument::thumb>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLPhotoSize> },
+    { &fieldAddress<TLDocument, decltype(TLDocument::dcId), &TLDocument::dcId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLDocument, decltype(TLDocument::attributes), &TLDocument::attributes>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLDocumentAttribute>> },
+};
+
+static const TLConstructorDescriptor s_documentConstructors[] = {
+    { TLValue::DocumentEmpty, 0, 1 },
+    { TLValue::Document, 1, 8 },
+};
+
+static const TLTypeDescriptor s_documentDescriptor = { s_documentConstructors, 2, s_documentFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLDocument &documentValue)
+{
+    TLDocument result;
+
+    readByDescriptor(&result, &result.tlType, s_documentDescriptor);
+
+    documentValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_foundGifFields[] = {
+    { &fieldAddress<TLFoundGif, decltype(TLFoundGif::url), &TLFoundGif::url>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLFoundGif, decltype(TLFoundGif::thumbUrl), &TLFoundGif::thumbUrl>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLFoundGif, decltype(TLFoundGif::contentUrl), &TLFoundGif::contentUrl>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLFoundGif, decltype(TLFoundGif::contentType), &TLFoundGif::contentType>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLFoundGif, decltype(TLFoundGif::w), &TLFoundGif::w>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLFoundGif, decltype(TLFoundGif::h), &TLFoundGif::h>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLFoundGif, decltype(TLFoundGif::url), &TLFoundGif::url>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLFoundGif, decltype(TLFoundGif::photo), &TLFoundGif::photo>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLPhoto> },
+    { &fieldAddress<TLFoundGif, decltype(TLFoundGif::document), &TLFoundGif::document>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLDocument> },
+};
+
+static const TLConstructorDescriptor s_foundGifConstructors[] = {
+    { TLValue::FoundGif, 0, 6 },
+    { TLValue::FoundGifCached, 6, 3 },
+};
+
+static const TLTypeDescriptor s_foundGifDescriptor = { s_foundGifConstructors, 2, s_foundGifFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLFoundGif &foundGifValue)
+{
+    TLFoundGif result;
+
+    readByDescriptor(&result, &result.tlType, s_foundGifDescriptor);
+
+    foundGifValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_helpSupportFields[] = {
+    { &fieldAddress<TLHelpSupport, decltype(TLHelpSupport::phoneNumber), &TLHelpSupport::phoneNumber>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLHelpSupport, decltype(TLHelpSupport::user), &TLHelpSupport::user>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLUser> },
+};
+
+static const TLConstructorDescriptor s_helpSupportConstructors[] = {
+    { TLValue::HelpSupport, 0, 2 },
+};
+
+static const TLTypeDescriptor s_helpSupportDescriptor = { s_helpSupportConstructors, 1, s_helpSupportFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLHelpSupport &helpSupportValue)
+{
+    TLHelpSupport result;
+
+    readByDescriptor(&result, &result.tlType, s_helpSupportDescriptor);
+
+    helpSupportValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_messageActionFields[] = {
+    { &fieldAddress<TLMessageAction, decltype(TLMessageAction::title), &TLMessageAction::title>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageAction, decltype(TLMessageAction::users), &TLMessageAction::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<quint32>> },
+    { &fieldAddress<TLMessageAction, decltype(TLMessageAction::title), &TLMessageAction::title>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageAction, decltype(TLMessageAction::photo), &TLMessageAction::photo>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLPhoto> },
+    { &fieldAddress<TLMessageAction, decltype(TLMessageAction::users), &TLMessageAction::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<quint32>> },
+    { &fieldAddress<TLMessageAction, decltype(TLMessageAction::userId), &TLMessageAction::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageAction, decltype(TLMessageAction::inviterId), &TLMessageAction::inviterId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageAction, decltype(TLMessageAction::channelId), &TLMessageAction::channelId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageAction, decltype(TLMessageAction::title), &TLMessageAction::title>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageAction, decltype(TLMessageAction::chatId), &TLMessageAction::chatId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_messageActionConstructors[] = {
+    { TLValue::MessageActionEmpty, 0, 0 },
+    { TLValue::MessageActionChatCreate, 0, 2 },
+    { TLValue::MessageActionChatEditTitle, 2, 1 },
+    { TLValue::MessageActionChatEditPhoto, 3, 1 },
+    { TLValue::MessageActionChatDeletePhoto, 0, 0 },
+    { TLValue::MessageActionChatAddUser, 4, 1 },
+    { TLValue::MessageActionChatDeleteUser, 5, 1 },
+    { TLValue::MessageActionChatJoinedByLink, 6, 1 },
+    { TLValue::MessageActionChannelCreate, 2, 1 },
+    { TLValue::MessageActionChatMigrateTo, 7, 1 },
+    { TLValue::MessageActionChannelMigrateFrom, 8, 2 },
+};
+
+static const TLTypeDescriptor s_messageActionDescriptor = { s_messageActionConstructors, 11, s_messageActionFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLMessageAction &messageActionValue)
+{
+    TLMessageAction result;
+
+    readByDescriptor(&result, &result.tlType, s_messageActionDescriptor);
+
+    messageActionValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_messagesAllStickersFields[] = {
+    { &fieldAddress<TLMessagesAllStickers, decltype(TLMessagesAllStickers::hash), &TLMessagesAllStickers::hash>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessagesAllStickers, decltype(TLMessagesAllStickers::sets), &TLMessagesAllStickers::sets>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLStickerSet>> },
+};
+
+static const TLConstructorDescriptor s_messagesAllStickersConstructors[] = {
+    { TLValue::MessagesAllStickersNotModified, 0, 0 },
+    { TLValue::MessagesAllStickers, 0, 2 },
+};
+
+static const TLTypeDescriptor s_messagesAllStickersDescriptor = { s_messagesAllStickersConstructors, 2, s_messagesAllStickersFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLMessagesAllStickers &messagesAllStickersValue)
+{
+    TLMessagesAllStickers result;
+
+    readByDescriptor(&result, &result.tlType, s_messagesAllStickersDescriptor);
+
+    messagesAllStickersValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_messagesChatFullFields[] = {
+    { &fieldAddress<TLMessagesChatFull, decltype(TLMessagesChatFull::fullChat), &TLMessagesChatFull::fullChat>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLChatFull> },
+    { &fieldAddress<TLMessagesChatFull, decltype(TLMessagesChatFull::chats), &TLMessagesChatFull::chats>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLChat>> },
+    { &fieldAddress<TLMessagesChatFull, decltype(TLMessagesChatFull::users), &TLMessagesChatFull::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUser>> },
+};
+
+static const TLConstructorDescriptor s_messagesChatFullConstructors[] = {
+    { TLValue::MessagesChatFull, 0, 3 },
+};
+
+static const TLTypeDescriptor s_messagesChatFullDescriptor = { s_messagesChatFullConstructors, 1, s_messagesChatFullFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLMessagesChatFull &messagesChatFullValue)
+{
+    TLMessagesChatFull result;
+
+    readByDescriptor(&result, &result.tlType, s_messagesChatFullDescriptor);
+
+    messagesChatFullValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_messagesChatsFields[] = {
+    { &fieldAddress<TLMessagesChats, decltype(TLMessagesChats::chats), &TLMessagesChats::chats>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLChat>> },
+};
+
+static const TLConstructorDescriptor s_messagesChatsConstructors[] = {
+    { TLValue::MessagesChats, 0, 1 },
+};
+
+static const TLTypeDescriptor s_messagesChatsDescriptor = { s_messagesChatsConstructors, 1, s_messagesChatsFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLMessagesChats &messagesChatsValue)
+{
+    TLMessagesChats result;
+
+    readByDescriptor(&result, &result.tlType, s_messagesChatsDescriptor);
+
+    messagesChatsValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_messagesFoundGifsFields[] = {
+    { &fieldAddress<TLMessagesFoundGifs, decltype(TLMessagesFoundGifs::nextOffset), &TLMessagesFoundGifs::nextOffset>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessagesFoundGifs, decltype(TLMessagesFoundGifs::results), &TLMessagesFoundGifs::results>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLFoundGif>> },
+};
+
+static const TLConstructorDescriptor s_messagesFoundGifsConstructors[] = {
+    { TLValue::MessagesFoundGifs, 0, 2 },
+};
+
+static const TLTypeDescriptor s_messagesFoundGifsDescriptor = { s_messagesFoundGifsConstructors, 1, s_messagesFoundGifsFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLMessagesFoundGifs &messagesFoundGifsValue)
+{
+    TLMessagesFoundGifs result;
+
+    readByDescriptor(&result, &result.tlType, s_messagesFoundGifsDescriptor);
+
+    messagesFoundGifsValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_messagesSavedGifsFields[] = {
+    { &fieldAddress<TLMessagesSavedGifs, decltype(TLMessagesSavedGifs::hash), &TLMessagesSavedGifs::hash>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessagesSavedGifs, decltype(TLMessagesSavedGifs::gifs), &TLMessagesSavedGifs::gifs>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLDocument>> },
+};
+
+static const TLConstructorDescriptor s_messagesSavedGifsConstructors[] = {
+    { TLValue::MessagesSavedGifsNotModified, 0, 0 },
+    { TLValue::MessagesSavedGifs, 0, 2 },
+};
+
+static const TLTypeDescriptor s_messagesSavedGifsDescriptor = { s_messagesSavedGifsConstructors, 2, s_messagesSavedGifsFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLMessagesSavedGifs &messagesSavedGifsValue)
+{
+    TLMessagesSavedGifs result;
+
+    readByDescriptor(&result, &result.tlType, s_messagesSavedGifsDescriptor);
+
+    messagesSavedGifsValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_messagesStickerSetFields[] = {
+    { &fieldAddress<TLMessagesStickerSet, decltype(TLMessagesStickerSet::set), &TLMessagesStickerSet::set>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLStickerSet> },
+    { &fieldAddress<TLMessagesStickerSet, decltype(TLMessagesStickerSet::packs), &TLMessagesStickerSet::packs>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLStickerPack>> },
+    { &fieldAddress<TLMessagesStickerSet, decltype(TLMessagesStickerSet::documents), &TLMessagesStickerSet::documents>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLDocument>> },
+};
+
+static const TLConstructorDescriptor s_messagesStickerSetConstructors[] = {
+    { TLValue::MessagesStickerSet, 0, 3 },
+};
+
+static const TLTypeDescriptor s_messagesStickerSetDescriptor = { s_messagesStickerSetConstructors, 1, s_messagesStickerSetFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLMessagesStickerSet &messagesStickerSetValue)
+{
+    TLMessagesStickerSet result;
+
+    readByDescriptor(&result, &result.tlType, s_messagesStickerSetDescriptor);
+
+    messagesStickerSetValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_messagesStickersFields[] = {
+    { &fieldAddress<TLMessagesStickers, decltype(TLMessagesStickers::hash), &TLMessagesStickers::hash>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessagesStickers, decltype(TLMessagesStickers::stickers), &TLMessagesStickers::stickers>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLDocument>> },
+};
+
+static const TLConstructorDescriptor s_messagesStickersConstructors[] = {
+    { TLValue::MessagesStickersNotModified, 0, 0 },
+    { TLValue::MessagesStickers, 0, 2 },
+};
+
+static const TLTypeDescriptor s_messagesStickersDescriptor = { s_messagesStickersConstructors, 2, s_messagesStickersFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLMessagesStickers &messagesStickersValue)
+{
+    TLMessagesStickers result;
+
+    readByDescriptor(&result, &result.tlType, s_messagesStickersDescriptor);
+
+    messagesStickersValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_photosPhotoFields[] = {
+    { &fieldAddress<TLPhotosPhoto, decltype(TLPhotosPhoto::photo), &TLPhotosPhoto::photo>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLPhoto> },
+    { &fieldAddress<TLPhotosPhoto, decltype(TLPhotosPhoto::users), &TLPhotosPhoto::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUser>> },
+};
+
+static const TLConstructorDescriptor s_photosPhotoConstructors[] = {
+    { TLValue::PhotosPhoto, 0, 2 },
+};
+
+static const TLTypeDescriptor s_photosPhotoDescriptor = { s_photosPhotoConstructors, 1, s_photosPhotoFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLPhotosPhoto &photosPhotoValue)
+{
+    TLPhotosPhoto result;
+
+    readByDescriptor(&result, &result.tlType, s_photosPhotoDescriptor);
+
+    photosPhotoValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_photosPhotosFields[] = {
+    { &fieldAddress<TLPhotosPhotos, decltype(TLPhotosPhotos::photos), &TLPhotosPhotos::photos>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLPhoto>> },
+    { &fieldAddress<TLPhotosPhotos, decltype(TLPhotosPhotos::users), &TLPhotosPhotos::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUser>> },
+    { &fieldAddress<TLPhotosPhotos, decltype(TLPhotosPhotos::count), &TLPhotosPhotos::count>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLPhotosPhotos, decltype(TLPhotosPhotos::photos), &TLPhotosPhotos::photos>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLPhoto>> },
+    { &fieldAddress<TLPhotosPhotos, decltype(TLPhotosPhotos::users), &TLPhotosPhotos::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUser>> },
+};
+
+static const TLConstructorDescriptor s_photosPhotosConstructors[] = {
+    { TLValue::PhotosPhotos, 0, 2 },
+    { TLValue::PhotosPhotosSlice, 2, 3 },
+};
+
+static const TLTypeDescriptor s_photosPhotosDescriptor = { s_photosPhotosConstructors, 2, s_photosPhotosFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLPhotosPhotos &photosPhotosValue)
+{
+    TLPhotosPhotos result;
+
+    readByDescriptor(&result, &result.tlType, s_photosPhotosDescriptor);
+
+    photosPhotosValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_userFullFields[] = {
+    { &fieldAddress<TLUserFull, decltype(TLUserFull::user), &TLUserFull::user>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLUser> },
+    { &fieldAddress<TLUserFull, decltype(TLUserFull::link), &TLUserFull::link>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLContactsLink> },
+    { &fieldAddress<TLUserFull, decltype(TLUserFull::profilePhoto), &TLUserFull::profilePhoto>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLPhoto> },
+    { &fieldAddress<TLUserFull, decltype(TLUserFull::notifySettings), &TLUserFull::notifySettings>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLPeerNotifySettings> },
+    { &fieldAddress<TLUserFull, decltype(TLUserFull::blocked), &TLUserFull::blocked>, TLFieldDescriptor::Bool, -1, nullptr, nullptr },
+    { &fieldAddress<TLUserFull, decltype(TLUserFull::botInfo), &TLUserFull::botInfo>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLBotInfo> },
+};
+
+static const TLConstructorDescriptor s_userFullConstructors[] = {
+    { TLValue::UserFull, 0, 6 },
+};
+
+static const TLTypeDescriptor s_userFullDescriptor = { s_userFullConstructors, 1, s_userFullFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLUserFull &userFullValue)
+{
+    TLUserFull result;
+
+    readByDescriptor(&result, &result.tlType, s_userFullDescriptor);
+
+    userFullValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_webPageFields[] = {
+    { &fieldAddress<TLWebPage, decltype(TLWebPage::id), &TLWebPage::id>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLWebPage, decltype(TLWebPage::id), &TLWebPage::id>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLWebPage, decltype(TLWebPage::date), &TLWebPage::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLWebPage, decltype(TLWebPage::flags), &TLWebPage::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLWebPage, decltype(TLWebPage::id), &TLWebPage::id>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLWebPage, decltype(TLWebPage::url), &TLWebPage::url>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLWebPage, decltype(TLWebPage::displayUrl), &TLWebPage::displayUrl>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLWebPage, decltype(TLWebPage::type), &TLWebPage::type>, TLFieldDescriptor::String, 0, &fieldAddress<TLWebPage, decltype(TLWebPage::flags), &TLWebPage::flags>, nullptr },
+    { &fieldAddress<TLWebPage, decltype(TLWebPage::siteName), &TLWebPage::siteName>, TLFieldDescriptor::String, 1, &fieldAddress<TLWebPage, decltype(TLWebPage::flags), &TLWebPage::flags>, nullptr },
+    { &fieldAddress<TLWebPage, decltype(TLWebPage::title), &TLWebPage::title>, TLFieldDescriptor::String, 2, &fieldAddress<TLWebPage, decltype(TLWebPage::flags), &TLWebPage::flags>, nullptr },
+    { &fieldAddress<TLWebPage, decltype(TLWebPage::description), &TLWebPage::description>, TLFieldDescriptor::String, 3, &fieldAddress<TLWebPage, decltype(TLWebPage::flags), &TLWebPage::flags>, nullptr },
+    { &fieldAddress<TLWebPage, decltype(TLWebPage::photo), &TLWebPage::photo>, TLFieldDescriptor::Custom, 4, &fieldAddress<TLWebPage, decltype(TLWebPage::flags), &TLWebPage::flags>, &readField<TLPhoto> },
+    { &fieldAddress<TLWebPage, decltype(TLWebPage::embedUrl), &TLWebPage::embedUrl>, TLFieldDescriptor::String, 5, &fieldAddress<TLWebPage, decltype(TLWebPage::flags), &TLWebPage::flags>, nullptr },
+    { &fieldAddress<TLWebPage, decltype(TLWebPage::embedType), &TLWebPage::embedType>, TLFieldDescriptor::String, 5, &fieldAddress<TLWebPage, decltype(TLWebPage::flags), &TLWebPage::flags>, nullptr },
+    { &fieldAddress<TLWebPage, decltype(TLWebPage::embedWidth), &TLWebPage::embedWidth>, TLFieldDescriptor::UInt32, 6, &fieldAddress<TLWebPage, decltype(TLWebPage::flags), &TLWebPage::flags>, nullptr },
+    { &fieldAddress<TLWebPage, decltype(TLWebPage::embedHeight), &TLWebPage::embedHeight>, TLFieldDescriptor::UInt32, 6, &fieldAddress<TLWebPage, decltype(TLWebPage::flags), &TLWebPage::flags>, nullptr },
+    { &fieldAddress<TLWebPage, decltype(TLWebPage::duration), &TLWebPage::duration>, TLFieldDescriptor::UInt32, 7, &fieldAddress<TLWebPage, decltype(TLWebPage::flags), &TLWebPage::flags>, nullptr },
+    { &fieldAddress<TLWebPage, decltype(TLWebPage::author), &TLWebPage::author>, TLFieldDescriptor::String, 8, &fieldAddress<TLWebPage, decltype(TLWebPage::flags), &TLWebPage::flags>, nullptr },
+    { &fieldAddress<TLWebPage, decltype(TLWebPage::document), &TLWebPage::document>, TLFieldDescriptor::Custom, 9, &fieldAddress<TLWebPage, decltype(TLWebPage::flags), &TLWebPage::flags>, &readField<TLDocument> },
+};
+
+static const TLConstructorDescriptor s_webPageConstructors[] = {
+    { TLValue::WebPageEmpty, 0, 1 },
+    { TLValue::WebPagePending, 1, 2 },
+    { TLValue::WebPage, 3, 16 },
+};
+
+static const TLTypeDescriptor s_webPageDescriptor = { s_webPageConstructors, 3, s_webPageFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLWebPage &webPageValue)
+{
+    TLWebPage result;
+
+    readByDescriptor(&result, &result.tlType, s_webPageDescriptor);
+
+    webPageValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_botInlineResultFields[] = {
+    { &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::id), &TLBotInlineResult::id>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::type), &TLBotInlineResult::type>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::document), &TLBotInlineResult::document>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLDocument> },
+    { &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::sendMessage), &TLBotInlineResult::sendMessage>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLBotInlineMessage> },
+    { &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::id), &TLBotInlineResult::id>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::type), &TLBotInlineResult::type>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::photo), &TLBotInlineResult::photo>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLPhoto> },
+    { &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::sendMessage), &TLBotInlineResult::sendMessage>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLBotInlineMessage> },
+    { &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::flags), &TLBotInlineResult::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::id), &TLBotInlineResult::id>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::type), &TLBotInlineResult::type>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::title), &TLBotInlineResult::title>, TLFieldDescriptor::String, 1, &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::flags), &TLBotInlineResult::flags>, nullptr },
+    { &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::description), &TLBotInlineResult::description>, TLFieldDescriptor::String, 2, &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::flags), &TLBotInlineResult::flags>, nullptr },
+    { &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::url), &TLBotInlineResult::url>, TLFieldDescriptor::String, 3, &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::flags), &TLBotInlineResult::flags>, nullptr },
+    { &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::thumbUrl), &TLBotInlineResult::thumbUrl>, TLFieldDescriptor::String, 4, &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::flags), &TLBotInlineResult::flags>, nullptr },
+    { &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::contentUrl), &TLBotInlineResult::contentUrl>, TLFieldDescriptor::String, 5, &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::flags), &TLBotInlineResult::flags>, nullptr },
+    { &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::contentType), &TLBotInlineResult::contentType>, TLFieldDescriptor::String, 5, &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::flags), &TLBotInlineResult::flags>, nullptr },
+    { &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::w), &TLBotInlineResult::w>, TLFieldDescriptor::UInt32, 6, &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::flags), &TLBotInlineResult::flags>, nullptr },
+    { &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::h), &TLBotInlineResult::h>, TLFieldDescriptor::UInt32, 6, &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::flags), &TLBotInlineResult::flags>, nullptr },
+    { &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::duration), &TLBotInlineResult::duration>, TLFieldDescriptor::UInt32, 7, &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::flags), &TLBotInlineResult::flags>, nullptr },
+    { &fieldAddress<TLBotInlineResult, decltype(TLBotInlineResult::sendMessage), &TLBotInlineResult::sendMessage>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLBotInlineMessage> },
+};
+
+static const TLConstructorDescriptor s_botInlineResultConstructors[] = {
+    { TLValue::BotInlineMediaResultDocument, 0, 4 },
+    { TLValue::BotInlineMediaResultPhoto, 4, 4 },
+    { TLValue::BotInlineResult, 8, 13 },
+};
+
+static const TLTypeDescriptor s_botInlineResultDescriptor = { s_botInlineResultConstructors, 3, s_botInlineResultFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLBotInlineResult &botInlineResultValue)
+{
+    TLBotInlineResult result;
+
+    readByDescriptor(&result, &result.tlType, s_botInlineResultDescriptor);
+
+    botInlineResultValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_messageMediaFields[] = {
+    { &fieldAddress<TLMessageMedia, decltype(TLMessageMedia::photo), &TLMessageMedia::photo>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLPhoto> },
+    { &fieldAddress<TLMessageMedia, decltype(TLMessageMedia::caption), &TLMessageMedia::caption>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageMedia, decltype(TLMessageMedia::video), &TLMessageMedia::video>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVideo> },
+    { &fieldAddress<TLMessageMedia, decltype(TLMessageMedia::caption), &TLMessageMedia::caption>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageMedia, decltype(TLMessageMedia::geo), &TLMessageMedia::geo>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLGeoPoint> },
+    { &fieldAddress<TLMessageMedia, decltype(TLMessageMedia::phoneNumber), &TLMessageMedia::phoneNumber>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageMedia, decltype(TLMessageMedia::firstName), &TLMessageMedia::firstName>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageMedia, decltype(TLMessageMedia::lastName), &TLMessageMedia::lastName>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageMedia, decltype(TLMessageMedia::userId), &TLMessageMedia::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageMedia, decltype(TLMessageMedia::document), &TLMessageMedia::document>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLDocument> },
+    { &fieldAddress<TLMessageMedia, decltype(TLMessageMedia::caption), &TLMessageMedia::caption>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageMedia, decltype(TLMessageMedia::audio), &TLMessageMedia::audio>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLAudio> },
+    { &fieldAddress<TLMessageMedia, decltype(TLMessageMedia::webpage), &TLMessageMedia::webpage>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLWebPage> },
+    { &fieldAddress<TLMessageMedia, decltype(TLMessageMedia::geo), &TLMessageMedia::geo>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLGeoPoint> },
+    { &fieldAddress<TLMessageMedia, decltype(TLMessageMedia::title), &TLMessageMedia::title>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageMedia, decltype(TLMessageMedia::address), &TLMessageMedia::address>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageMedia, decltype(TLMessageMedia::provider), &TLMessageMedia::provider>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessageMedia, decltype(TLMessageMedia::venueId), &TLMessageMedia::venueId>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_messageMediaConstructors[] = {
+    { TLValue::MessageMediaEmpty, 0, 0 },
+    { TLValue::MessageMediaPhoto, 0, 2 },
+    { TLValue::MessageMediaVideo, 2, 2 },
+    { TLValue::MessageMediaGeo, 4, 1 },
+    { TLValue::MessageMediaContact, 5, 4 },
+    { TLValue::MessageMediaUnsupported, 0, 0 },
+    { TLValue::MessageMediaDocument, 9, 2 },
+    { TLValue::MessageMediaAudio, 11, 1 },
+    { TLValue::MessageMediaWebPage, 12, 1 },
+    { TLValue::MessageMediaVenue, 13, 5 },
+};
+
+static const TLTypeDescriptor s_messageMediaDescriptor = { s_messageMediaConstructors, 10, s_messageMediaFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLMessageMedia &messageMediaValue)
+{
+    TLMessageMedia result;
+
+    readByDescriptor(&result, &result.tlType, s_messageMediaDescriptor);
+
+    messageMediaValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_messagesBotResultsFields[] = {
+    { &fieldAddress<TLMessagesBotResults, decltype(TLMessagesBotResults::flags), &TLMessagesBotResults::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessagesBotResults, decltype(TLMessagesBotResults::queryId), &TLMessagesBotResults::queryId>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessagesBotResults, decltype(TLMessagesBotResults::nextOffset), &TLMessagesBotResults::nextOffset>, TLFieldDescriptor::String, 1, &fieldAddress<TLMessagesBotResults, decltype(TLMessagesBotResults::flags), &TLMessagesBotResults::flags>, nullptr },
+    { &fieldAddress<TLMessagesBotResults, decltype(TLMessagesBotResults::results), &TLMessagesBotResults::results>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLBotInlineResult>> },
+};
+
+static const TLConstructorDescriptor s_messagesBotResultsConstructors[] = {
+    { TLValue::MessagesBotResults, 0, 4 },
+};
+
+static const TLTypeDescriptor s_messagesBotResultsDescriptor = { s_messagesBotResultsConstructors, 1, s_messagesBotResultsFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLMessagesBotResults &messagesBotResultsValue)
+{
+    TLMessagesBotResults result;
+
+    readByDescriptor(&result, &result.tlType, s_messagesBotResultsDescriptor);
+
+    messagesBotResultsValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_messageFields[] = {
+    { &fieldAddress<TLMessage, decltype(TLMessage::id), &TLMessage::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessage, decltype(TLMessage::flags), &TLMessage::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessage, decltype(TLMessage::id), &TLMessage::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessage, decltype(TLMessage::fromId), &TLMessage::fromId>, TLFieldDescriptor::UInt32, 8, &fieldAddress<TLMessage, decltype(TLMessage::flags), &TLMessage::flags>, nullptr },
+    { &fieldAddress<TLMessage, decltype(TLMessage::toId), &TLMessage::toId>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLPeer> },
+    { &fieldAddress<TLMessage, decltype(TLMessage::fwdFromId), &TLMessage::fwdFromId>, TLFieldDescriptor::Custom, 2, &fieldAddress<TLMessage, decltype(TLMessage::flags), &TLMessage::flags>, &readField<TLPeer> },
+    { &fieldAddress<TLMessage, decltype(TLMessage::fwdDate), &TLMessage::fwdDate>, TLFieldDescriptor::UInt32, 2, &fieldAddress<TLMessage, decltype(TLMessage::flags), &TLMessage::flags>, nullptr },
+    { &fieldAddress<TLMessage, decltype(TLMessage::viaBotId), &TLMessage::viaBotId>, TLFieldDescriptor::UInt32, 11, &fieldAddress<TLMessage, decltype(TLMessage::flags), &TLMessage::flags>, nullptr },
+    { &fieldAddress<TLMessage, decltype(TLMessage::replyToMsgId), &TLMessage::replyToMsgId>, TLFieldDescriptor::UInt32, 3, &fieldAddress<TLMessage, decltype(TLMessage::flags), &TLMessage::flags>, nullptr },
+    { &fieldAddress<TLMessage, decltype(TLMessage::date), &TLMessage::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessage, decltype(TLMessage::message), &TLMessage::message>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessage, decltype(TLMessage::media), &TLMessage::media>, TLFieldDescriptor::Custom, 9, &fieldAddress<TLMessage, decltype(TLMessage::flags), &TLMessage::flags>, &readField<TLMessageMedia> },
+    { &fieldAddress<TLMessage, decltype(TLMessage::replyMarkup), &TLMessage::replyMarkup>, TLFieldDescriptor::Custom, 6, &fieldAddress<TLMessage, decltype(TLMessage::flags), &TLMessage::flags>, &readField<TLReplyMarkup> },
+    { &fieldAddress<TLMessage, decltype(TLMessage::entities), &TLMessage::entities>, TLFieldDescriptor::Custom, 7, &fieldAddress<TLMessage, decltype(TLMessage::flags), &TLMessage::flags>, &readField<TLVector<TLMessageEntity>> },
+    { &fieldAddress<TLMessage, decltype(TLMessage::views), &TLMessage::views>, TLFieldDescriptor::UInt32, 10, &fieldAddress<TLMessage, decltype(TLMessage::flags), &TLMessage::flags>, nullptr },
+    { &fieldAddress<TLMessage, decltype(TLMessage::flags), &TLMessage::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessage, decltype(TLMessage::id), &TLMessage::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessage, decltype(TLMessage::fromId), &TLMessage::fromId>, TLFieldDescriptor::UInt32, 8, &fieldAddress<TLMessage, decltype(TLMessage::flags), &TLMessage::flags>, nullptr },
+    { &fieldAddress<TLMessage, decltype(TLMessage::toId), &TLMessage::toId>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLPeer> },
+    { &fieldAddress<TLMessage, decltype(TLMessage::date), &TLMessage::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessage, decltype(TLMessage::action), &TLMessage::action>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLMessageAction> },
+};
+
+static const TLConstructorDescriptor s_messageConstructors[] = {
+    { TLValue::MessageEmpty, 0, 1 },
+    { TLValue::Message, 1, 14 },
+    { TLValue::MessageService, 15, 6 },
+};
+
+static const TLTypeDescriptor s_messageDescriptor = { s_messageConstructors, 3, s_messageFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLMessage &messageValue)
+{
+    TLMessage result;
+
+    readByDescriptor(&result, &result.tlType, s_messageDescriptor);
+
+    messageValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_messagesDialogsFields[] = {
+    { &fieldAddress<TLMessagesDialogs, decltype(TLMessagesDialogs::dialogs), &TLMessagesDialogs::dialogs>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLDialog>> },
+    { &fieldAddress<TLMessagesDialogs, decltype(TLMessagesDialogs::messages), &TLMessagesDialogs::messages>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLMessage>> },
+    { &fieldAddress<TLMessagesDialogs, decltype(TLMessagesDialogs::chats), &TLMessagesDialogs::chats>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLChat>> },
+    { &fieldAddress<TLMessagesDialogs, decltype(TLMessagesDialogs::users), &TLMessagesDialogs::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUser>> },
+    { &fieldAddress<TLMessagesDialogs, decltype(TLMessagesDialogs::count), &TLMessagesDialogs::count>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessagesDialogs, decltype(TLMessagesDialogs::dialogs), &TLMessagesDialogs::dialogs>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLDialog>> },
+    { &fieldAddress<TLMessagesDialogs, decltype(TLMessagesDialogs::messages), &TLMessagesDialogs::messages>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLMessage>> },
+    { &fieldAddress<TLMessagesDialogs, decltype(TLMessagesDialogs::chats), &TLMessagesDialogs::chats>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLChat>> },
+    { &fieldAddress<TLMessagesDialogs, decltype(TLMessagesDialogs::users), &TLMessagesDialogs::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUser>> },
+};
+
+static const TLConstructorDescriptor s_messagesDialogsConstructors[] = {
+    { TLValue::MessagesDialogs, 0, 4 },
+    { TLValue::MessagesDialogsSlice, 4, 5 },
+};
+
+static const TLTypeDescriptor s_messagesDialogsDescriptor = { s_messagesDialogsConstructors, 2, s_messagesDialogsFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLMessagesDialogs &messagesDialogsValue)
+{
+    TLMessagesDialogs result;
+
+    readByDescriptor(&result, &result.tlType, s_messagesDialogsDescriptor);
+
+    messagesDialogsValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_messagesMessagesFields[] = {
+    { &fieldAddress<TLMessagesMessages, decltype(TLMessagesMessages::messages), &TLMessagesMessages::messages>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLMessage>> },
+    { &fieldAddress<TLMessagesMessages, decltype(TLMessagesMessages::chats), &TLMessagesMessages::chats>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLChat>> },
+    { &fieldAddress<TLMessagesMessages, decltype(TLMessagesMessages::users), &TLMessagesMessages::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUser>> },
+    { &fieldAddress<TLMessagesMessages, decltype(TLMessagesMessages::count), &TLMessagesMessages::count>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessagesMessages, decltype(TLMessagesMessages::messages), &TLMessagesMessages::messages>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLMessage>> },
+    { &fieldAddress<TLMessagesMessages, decltype(TLMessagesMessages::chats), &TLMessagesMessages::chats>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLChat>> },
+    { &fieldAddress<TLMessagesMessages, decltype(TLMessagesMessages::users), &TLMessagesMessages::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUser>> },
+    { &fieldAddress<TLMessagesMessages, decltype(TLMessagesMessages::flags), &TLMessagesMessages::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessagesMessages, decltype(TLMessagesMessages::pts), &TLMessagesMessages::pts>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessagesMessages, decltype(TLMessagesMessages::count), &TLMessagesMessages::count>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLMessagesMessages, decltype(TLMessagesMessages::messages), &TLMessagesMessages::messages>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLMessage>> },
+    { &fieldAddress<TLMessagesMessages, decltype(TLMessagesMessages::collapsed), &TLMessagesMessages::collapsed>, TLFieldDescriptor::Custom, 0, &fieldAddress<TLMessagesMessages, decltype(TLMessagesMessages::flags), &TLMessagesMessages::flags>, &readField<TLVector<TLMessageGroup>> },
+    { &fieldAddress<TLMessagesMessages, decltype(TLMessagesMessages::chats), &TLMessagesMessages::chats>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLChat>> },
+    { &fieldAddress<TLMessagesMessages, decltype(TLMessagesMessages::users), &TLMessagesMessages::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUser>> },
+};
+
+static const TLConstructorDescriptor s_messagesMessagesConstructors[] = {
+    { TLValue::MessagesMessages, 0, 3 },
+    { TLValue::MessagesMessagesSlice, 3, 4 },
+    { TLValue::MessagesChannelMessages, 7, 7 },
+};
+
+static const TLTypeDescriptor s_messagesMessagesDescriptor = { s_messagesMessagesConstructors, 3, s_messagesMessagesFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLMessagesMessages &messagesMessagesValue)
+{
+    TLMessagesMessages result;
+
+    readByDescriptor(&result, &result.tlType, s_messagesMessagesDescriptor);
+
+    messagesMessagesValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_updateFields[] = {
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::message), &TLUpdate::message>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLMessage> },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::pts), &TLUpdate::pts>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::ptsCount), &TLUpdate::ptsCount>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::id), &TLUpdate::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::randomId), &TLUpdate::randomId>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::messages), &TLUpdate::messages>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<quint32>> },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::pts), &TLUpdate::pts>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::ptsCount), &TLUpdate::ptsCount>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::userId), &TLUpdate::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::action), &TLUpdate::action>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLSendMessageAction> },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::chatId), &TLUpdate::chatId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::userId), &TLUpdate::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::action), &TLUpdate::action>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLSendMessageAction> },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::participants), &TLUpdate::participants>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLChatParticipants> },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::userId), &TLUpdate::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::status), &TLUpdate::status>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLUserStatus> },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::userId), &TLUpdate::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::firstName), &TLUpdate::firstName>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::lastName), &TLUpdate::lastName>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::username), &TLUpdate::username>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::userId), &TLUpdate::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::date), &TLUpdate::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::photo), &TLUpdate::photo>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLUserProfilePhoto> },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::previous), &TLUpdate::previous>, TLFieldDescriptor::Bool, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::userId), &TLUpdate::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::date), &TLUpdate::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::userId), &TLUpdate::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::myLink), &TLUpdate::myLink>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLContactLink> },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::foreignLink), &TLUpdate::foreignLink>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLContactLink> },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::authKeyId), &TLUpdate::authKeyId>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::date), &TLUpdate::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::device), &TLUpdate::device>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::location), &TLUpdate::location>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::encryptedMessage), &TLUpdate::encryptedMessage>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLEncryptedMessage> },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::qts), &TLUpdate::qts>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::chatId), &TLUpdate::chatId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::chat), &TLUpdate::chat>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLEncryptedChat> },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::date), &TLUpdate::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::chatId), &TLUpdate::chatId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::maxDate), &TLUpdate::maxDate>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::date), &TLUpdate::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::chatId), &TLUpdate::chatId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::userId), &TLUpdate::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::inviterId), &TLUpdate::inviterId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::date), &TLUpdate::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::version), &TLUpdate::version>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::chatId), &TLUpdate::chatId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::userId), &TLUpdate::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::version), &TLUpdate::version>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::dcOptions), &TLUpdate::dcOptions>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLDcOption>> },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::userId), &TLUpdate::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::blocked), &TLUpdate::blocked>, TLFieldDescriptor::Bool, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::notifyPeer), &TLUpdate::notifyPeer>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLNotifyPeer> },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::notifySettings), &TLUpdate::notifySettings>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLPeerNotifySettings> },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::type), &TLUpdate::type>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::stringMessage), &TLUpdate::stringMessage>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::media), &TLUpdate::media>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLMessageMedia> },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::popup), &TLUpdate::popup>, TLFieldDescriptor::Bool, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::key), &TLUpdate::key>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLPrivacyKey> },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::rules), &TLUpdate::rules>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLPrivacyRule>> },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::userId), &TLUpdate::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::phone), &TLUpdate::phone>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::peer), &TLUpdate::peer>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLPeer> },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::maxId), &TLUpdate::maxId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::pts), &TLUpdate::pts>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::ptsCount), &TLUpdate::ptsCount>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::webpage), &TLUpdate::webpage>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLWebPage> },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::pts), &TLUpdate::pts>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::ptsCount), &TLUpdate::ptsCount>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::channelId), &TLUpdate::channelId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::channelId), &TLUpdate::channelId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::group), &TLUpdate::group>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLMessageGroup> },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::channelId), &TLUpdate::channelId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::maxId), &TLUpdate::maxId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::channelId), &TLUpdate::channelId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::messages), &TLUpdate::messages>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<quint32>> },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::pts), &TLUpdate::pts>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::ptsCount), &TLUpdate::ptsCount>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::channelId), &TLUpdate::channelId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::id), &TLUpdate::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::views), &TLUpdate::views>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::chatId), &TLUpdate::chatId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::enabled), &TLUpdate::enabled>, TLFieldDescriptor::Bool, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::version), &TLUpdate::version>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::chatId), &TLUpdate::chatId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::userId), &TLUpdate::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::isAdmin), &TLUpdate::isAdmin>, TLFieldDescriptor::Bool, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::version), &TLUpdate::version>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::stickerset), &TLUpdate::stickerset>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLMessagesStickerSet> },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::order), &TLUpdate::order>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<quint64>> },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::queryId), &TLUpdate::queryId>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::userId), &TLUpdate::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::query), &TLUpdate::query>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdate, decltype(TLUpdate::offset), &TLUpdate::offset>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+};
+
+static const TLConstructorDescriptor s_updateConstructors[] = {
+    { TLValue::UpdateNewMessage, 0, 3 },
+    { TLValue::UpdateMessageID, 3, 2 },
+    { TLValue::UpdateDeleteMessages, 5, 3 },
+    { TLValue::UpdateUserTyping, 8, 2 },
+    { TLValue::UpdateChatUserTyping, 10, 3 },
+    { TLValue::UpdateChatParticipants, 13, 1 },
+    { TLValue::UpdateUserStatus, 14, 2 },
+    { TLValue::UpdateUserName, 16, 4 },
+    { TLValue::UpdateUserPhoto, 20, 4 },
+    { TLValue::UpdateContactRegistered, 24, 2 },
+    { TLValue::UpdateContactLink, 26, 3 },
+    { TLValue::UpdateNewAuthorization, 29, 4 },
+    { TLValue::UpdateNewEncryptedMessage, 33, 2 },
+    { TLValue::UpdateEncryptedChatTyping, 35, 1 },
+    { TLValue::UpdateEncryption, 36, 2 },
+    { TLValue::UpdateEncryptedMessagesRead, 38, 3 },
+    { TLValue::UpdateChatParticipantAdd, 41, 5 },
+    { TLValue::UpdateChatParticipantDelete, 46, 3 },
+    { TLValue::UpdateDcOptions, 49, 1 },
+    { TLValue::UpdateUserBlocked, 50, 2 },
+    { TLValue::UpdateNotifySettings, 52, 2 },
+    { TLValue::UpdateServiceNotification, 54, 4 },
+    { TLValue::UpdatePrivacy, 58, 2 },
+    { TLValue::UpdateUserPhone, 60, 2 },
+    { TLValue::UpdateReadHistoryInbox, 62, 4 },
+    { TLValue::UpdateReadHistoryOutbox, 62, 4 },
+    { TLValue::UpdateWebPage, 66, 3 },
+    { TLValue::UpdateReadMessagesContents, 5, 3 },
+    { TLValue::UpdateChannelTooLong, 69, 1 },
+    { TLValue::UpdateChannel, 69, 1 },
+    { TLValue::UpdateChannelGroup, 70, 2 },
+    { TLValue::UpdateNewChannelMessage, 0, 3 },
+    { TLValue::UpdateReadChannelInbox, 72, 2 },
+    { TLValue::UpdateDeleteChannelMessages, 74, 4 },
+    { TLValue::UpdateChannelMessageViews, 78, 3 },
+    { TLValue::UpdateChatAdmins, 81, 3 },
+    { TLValue::UpdateChatParticipantAdmin, 84, 4 },
+    { TLValue::UpdateNewStickerSet, 88, 1 },
+    { TLValue::UpdateStickerSetsOrder, 89, 1 },
+    { TLValue::UpdateStickerSets, 0, 0 },
+    { TLValue::UpdateSavedGifs, 0, 0 },
+    { TLValue::UpdateBotInlineQuery, 90, 4 },
+};
+
+static const TLTypeDescriptor s_updateDescriptor = { s_updateConstructors, 42, s_updateFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLUpdate &updateValue)
+{
+    TLUpdate result;
+
+    readByDescriptor(&result, &result.tlType, s_updateDescriptor);
+
+    updateValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_updatesFields[] = {
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::flags), &TLUpdates::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::id), &TLUpdates::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::userId), &TLUpdates::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::message), &TLUpdates::message>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::pts), &TLUpdates::pts>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::ptsCount), &TLUpdates::ptsCount>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::date), &TLUpdates::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::fwdFromId), &TLUpdates::fwdFromId>, TLFieldDescriptor::Custom, 2, &fieldAddress<TLUpdates, decltype(TLUpdates::flags), &TLUpdates::flags>, &readField<TLPeer> },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::fwdDate), &TLUpdates::fwdDate>, TLFieldDescriptor::UInt32, 2, &fieldAddress<TLUpdates, decltype(TLUpdates::flags), &TLUpdates::flags>, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::viaBotId), &TLUpdates::viaBotId>, TLFieldDescriptor::UInt32, 11, &fieldAddress<TLUpdates, decltype(TLUpdates::flags), &TLUpdates::flags>, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::replyToMsgId), &TLUpdates::replyToMsgId>, TLFieldDescriptor::UInt32, 3, &fieldAddress<TLUpdates, decltype(TLUpdates::flags), &TLUpdates::flags>, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::entities), &TLUpdates::entities>, TLFieldDescriptor::Custom, 7, &fieldAddress<TLUpdates, decltype(TLUpdates::flags), &TLUpdates::flags>, &readField<TLVector<TLMessageEntity>> },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::flags), &TLUpdates::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::id), &TLUpdates::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::fromId), &TLUpdates::fromId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::chatId), &TLUpdates::chatId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::message), &TLUpdates::message>, TLFieldDescriptor::String, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::pts), &TLUpdates::pts>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::ptsCount), &TLUpdates::ptsCount>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::date), &TLUpdates::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::fwdFromId), &TLUpdates::fwdFromId>, TLFieldDescriptor::Custom, 2, &fieldAddress<TLUpdates, decltype(TLUpdates::flags), &TLUpdates::flags>, &readField<TLPeer> },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::fwdDate), &TLUpdates::fwdDate>, TLFieldDescriptor::UInt32, 2, &fieldAddress<TLUpdates, decltype(TLUpdates::flags), &TLUpdates::flags>, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::viaBotId), &TLUpdates::viaBotId>, TLFieldDescriptor::UInt32, 11, &fieldAddress<TLUpdates, decltype(TLUpdates::flags), &TLUpdates::flags>, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::replyToMsgId), &TLUpdates::replyToMsgId>, TLFieldDescriptor::UInt32, 3, &fieldAddress<TLUpdates, decltype(TLUpdates::flags), &TLUpdates::flags>, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::entities), &TLUpdates::entities>, TLFieldDescriptor::Custom, 7, &fieldAddress<TLUpdates, decltype(TLUpdates::flags), &TLUpdates::flags>, &readField<TLVector<TLMessageEntity>> },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::update), &TLUpdates::update>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLUpdate> },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::date), &TLUpdates::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::updates), &TLUpdates::updates>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUpdate>> },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::users), &TLUpdates::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUser>> },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::chats), &TLUpdates::chats>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLChat>> },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::date), &TLUpdates::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::seqStart), &TLUpdates::seqStart>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::seq), &TLUpdates::seq>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::updates), &TLUpdates::updates>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUpdate>> },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::users), &TLUpdates::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUser>> },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::chats), &TLUpdates::chats>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLChat>> },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::date), &TLUpdates::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::seq), &TLUpdates::seq>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::flags), &TLUpdates::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::id), &TLUpdates::id>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::pts), &TLUpdates::pts>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::ptsCount), &TLUpdates::ptsCount>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::date), &TLUpdates::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::media), &TLUpdates::media>, TLFieldDescriptor::Custom, 9, &fieldAddress<TLUpdates, decltype(TLUpdates::flags), &TLUpdates::flags>, &readField<TLMessageMedia> },
+    { &fieldAddress<TLUpdates, decltype(TLUpdates::entities), &TLUpdates::entities>, TLFieldDescriptor::Custom, 7, &fieldAddress<TLUpdates, decltype(TLUpdates::flags), &TLUpdates::flags>, &readField<TLVector<TLMessageEntity>> },
+};
+
+static const TLConstructorDescriptor s_updatesConstructors[] = {
+    { TLValue::UpdatesTooLong, 0, 0 },
+    { TLValue::UpdateShortMessage, 0, 12 },
+    { TLValue::UpdateShortChatMessage, 12, 13 },
+    { TLValue::UpdateShort, 25, 2 },
+    { TLValue::UpdatesCombined, 27, 6 },
+    { TLValue::Updates, 33, 5 },
+    { TLValue::UpdateShortSentMessage, 38, 7 },
+};
+
+static const TLTypeDescriptor s_updatesDescriptor = { s_updatesConstructors, 7, s_updatesFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLUpdates &updatesValue)
+{
+    TLUpdates result;
+
+    readByDescriptor(&result, &result.tlType, s_updatesDescriptor);
+
+    updatesValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_updatesChannelDifferenceFields[] = {
+    { &fieldAddress<TLUpdatesChannelDifference, decltype(TLUpdatesChannelDifference::flags), &TLUpdatesChannelDifference::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdatesChannelDifference, decltype(TLUpdatesChannelDifference::pts), &TLUpdatesChannelDifference::pts>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdatesChannelDifference, decltype(TLUpdatesChannelDifference::timeout), &TLUpdatesChannelDifference::timeout>, TLFieldDescriptor::UInt32, 1, &fieldAddress<TLUpdatesChannelDifference, decltype(TLUpdatesChannelDifference::flags), &TLUpdatesChannelDifference::flags>, nullptr },
+    { &fieldAddress<TLUpdatesChannelDifference, decltype(TLUpdatesChannelDifference::flags), &TLUpdatesChannelDifference::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdatesChannelDifference, decltype(TLUpdatesChannelDifference::pts), &TLUpdatesChannelDifference::pts>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdatesChannelDifference, decltype(TLUpdatesChannelDifference::timeout), &TLUpdatesChannelDifference::timeout>, TLFieldDescriptor::UInt32, 1, &fieldAddress<TLUpdatesChannelDifference, decltype(TLUpdatesChannelDifference::flags), &TLUpdatesChannelDifference::flags>, nullptr },
+    { &fieldAddress<TLUpdatesChannelDifference, decltype(TLUpdatesChannelDifference::topMessage), &TLUpdatesChannelDifference::topMessage>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdatesChannelDifference, decltype(TLUpdatesChannelDifference::topImportantMessage), &TLUpdatesChannelDifference::topImportantMessage>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdatesChannelDifference, decltype(TLUpdatesChannelDifference::readInboxMaxId), &TLUpdatesChannelDifference::readInboxMaxId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdatesChannelDifference, decltype(TLUpdatesChannelDifference::unreadCount), &TLUpdatesChannelDifference::unreadCount>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdatesChannelDifference, decltype(TLUpdatesChannelDifference::unreadImportantCount), &TLUpdatesChannelDifference::unreadImportantCount>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdatesChannelDifference, decltype(TLUpdatesChannelDifference::messages), &TLUpdatesChannelDifference::messages>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLMessage>> },
+    { &fieldAddress<TLUpdatesChannelDifference, decltype(TLUpdatesChannelDifference::chats), &TLUpdatesChannelDifference::chats>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLChat>> },
+    { &fieldAddress<TLUpdatesChannelDifference, decltype(TLUpdatesChannelDifference::users), &TLUpdatesChannelDifference::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUser>> },
+    { &fieldAddress<TLUpdatesChannelDifference, decltype(TLUpdatesChannelDifference::flags), &TLUpdatesChannelDifference::flags>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdatesChannelDifference, decltype(TLUpdatesChannelDifference::pts), &TLUpdatesChannelDifference::pts>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdatesChannelDifference, decltype(TLUpdatesChannelDifference::timeout), &TLUpdatesChannelDifference::timeout>, TLFieldDescriptor::UInt32, 1, &fieldAddress<TLUpdatesChannelDifference, decltype(TLUpdatesChannelDifference::flags), &TLUpdatesChannelDifference::flags>, nullptr },
+    { &fieldAddress<TLUpdatesChannelDifference, decltype(TLUpdatesChannelDifference::newMessages), &TLUpdatesChannelDifference::newMessages>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLMessage>> },
+    { &fieldAddress<TLUpdatesChannelDifference, decltype(TLUpdatesChannelDifference::otherUpdates), &TLUpdatesChannelDifference::otherUpdates>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUpdate>> },
+    { &fieldAddress<TLUpdatesChannelDifference, decltype(TLUpdatesChannelDifference::chats), &TLUpdatesChannelDifference::chats>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLChat>> },
+    { &fieldAddress<TLUpdatesChannelDifference, decltype(TLUpdatesChannelDifference::users), &TLUpdatesChannelDifference::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUser>> },
+};
+
+static const TLConstructorDescriptor s_updatesChannelDifferenceConstructors[] = {
+    { TLValue::UpdatesChannelDifferenceEmpty, 0, 3 },
+    { TLValue::UpdatesChannelDifferenceTooLong, 3, 11 },
+    { TLValue::UpdatesChannelDifference, 14, 7 },
+};
+
+static const TLTypeDescriptor s_updatesChannelDifferenceDescriptor = { s_updatesChannelDifferenceConstructors, 3, s_updatesChannelDifferenceFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLUpdatesChannelDifference &updatesChannelDifferenceValue)
+{
+    TLUpdatesChannelDifference result;
+
+    readByDescriptor(&result, &result.tlType, s_updatesChannelDifferenceDescriptor);
+
+    updatesChannelDifferenceValue = result;
+
+    return *this;
+}
+
+static const TLFieldDescriptor s_updatesDifferenceFields[] = {
+    { &fieldAddress<TLUpdatesDifference, decltype(TLUpdatesDifference::date), &TLUpdatesDifference::date>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdatesDifference, decltype(TLUpdatesDifference::seq), &TLUpdatesDifference::seq>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },
+    { &fieldAddress<TLUpdatesDifference, decltype(TLUpdatesDifference::newMessages), &TLUpdatesDifference::newMessages>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLMessage>> },
+    { &fieldAddress<TLUpdatesDifference, decltype(TLUpdatesDifference::newEncryptedMessages), &TLUpdatesDifference::newEncryptedMessages>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLEncryptedMessage>> },
+    { &fieldAddress<TLUpdatesDifference, decltype(TLUpdatesDifference::otherUpdates), &TLUpdatesDifference::otherUpdates>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUpdate>> },
+    { &fieldAddress<TLUpdatesDifference, decltype(TLUpdatesDifference::chats), &TLUpdatesDifference::chats>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLChat>> },
+    { &fieldAddress<TLUpdatesDifference, decltype(TLUpdatesDifference::users), &TLUpdatesDifference::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUser>> },
+    { &fieldAddress<TLUpdatesDifference, decltype(TLUpdatesDifference::state), &TLUpdatesDifference::state>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLUpdatesState> },
+    { &fieldAddress<TLUpdatesDifference, decltype(TLUpdatesDifference::newMessages), &TLUpdatesDifference::newMessages>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLMessage>> },
+    { &fieldAddress<TLUpdatesDifference, decltype(TLUpdatesDifference::newEncryptedMessages), &TLUpdatesDifference::newEncryptedMessages>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLEncryptedMessage>> },
+    { &fieldAddress<TLUpdatesDifference, decltype(TLUpdatesDifference::otherUpdates), &TLUpdatesDifference::otherUpdates>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUpdate>> },
+    { &fieldAddress<TLUpdatesDifference, decltype(TLUpdatesDifference::chats), &TLUpdatesDifference::chats>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLChat>> },
+    { &fieldAddress<TLUpdatesDifference, decltype(TLUpdatesDifference::users), &TLUpdatesDifference::users>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLVector<TLUser>> },
+    { &fieldAddress<TLUpdatesDifference, decltype(TLUpdatesDifference::intermediateState), &TLUpdatesDifference::intermediateState>, TLFieldDescriptor::Custom, -1, nullptr, &readField<TLUpdatesState> },
+};
+
+static const TLConstructorDescriptor s_updatesDifferenceConstructors[] = {
+    { TLValue::UpdatesDifferenceEmpty, 0, 2 },
+    { TLValue::UpdatesDifference, 2, 6 },
+    { TLValue::UpdatesDifferenceSlice, 8, 6 },
+};
+
+static const TLTypeDescriptor s_updatesDifferenceDescriptor = { s_updatesDifferenceConstructors, 3, s_updatesDifferenceFields };
+
+CTelegramStream &CTelegramStream::operator>>(TLUpdatesDifference &updatesDifferenceValue)
+{
+    TLUpdatesDifference result;
+
+    readByDescriptor(&result, &result.tlType, s_updatesDifferenceDescriptor);
+
+    updatesDifferenceValue = result;
+
+    return *this;
+}
+
+// End of generated read tables
@@ -30,7 +30,11 @@ CTelegramStream &CTelegramStream::operator>>(TLVector<T> &v)
     if (result.tlType == TLValue::Vector) {
         quint32 length = 0;
         *this >> length;
-        for (quint32 i = 0; i < length; ++i) {
+        if (length > quint32(bytesAvailable()) / 4) { // Each TL value takes at least four bytes
+            setError();
+            length = 0;
+        }
+        for (quint32 i = 0; (i < length) && !error(); ++i) {
             T value;
             *this >> value;
             result.append(value);
@@ -51,7 +55,11 @@ CTelegramStream &CTelegramStream::operator>>(TLVector<T*> &v)
     if (result.tlType == TLValue::Vector) {
         quint32 length = 0;
         *this >> length;
-        for (quint32 i = 0; i < length; ++i) {
+        if (length > quint32(bytesAvailable()) / 4) { // Each TL value takes at least four bytes
+            setError();
+            length = 0;
+        }
+        for (quint32 i = 0; (i < length) && !error(); ++i) {
             T *value = new T;
             *this >> *value;
             result.append(value);
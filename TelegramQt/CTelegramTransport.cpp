@@ -16,11 +16,22 @@
 
 #include "CTelegramTransport.hpp"
 
+#include <QDebug>
+
 CTelegramTransport::CTelegramTransport(QObject *parent) :
     QObject(parent)
 {
 }
 
+void CTelegramTransport::connectToHosts(const QVector<Telegram::DcOption> &addresses)
+{
+    if (addresses.isEmpty()) {
+        qWarning() << Q_FUNC_INFO << "No address to connect to";
+        return;
+    }
+    connectToHost(addresses.first().address, addresses.first().port);
+}
+
 quint64 CTelegramTransport::getNewMessageId(quint64 supposedId)
 {
     // Client message identifiers are divisible by 4, server message identifiers modulo 4 yield 1 if the message is a response to a client message, and 3 otherwise.
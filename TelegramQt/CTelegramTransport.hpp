@@ -22,6 +22,9 @@
 
 #include <QByteArray>
 #include <QAbstractSocket>
+#include <QVector>
+
+#include "TelegramNamespace.hpp"
 
 class CTelegramTransport : public QObject
 {
@@ -29,14 +32,22 @@ class CTelegramTransport : public QObject
 public:
     explicit CTelegramTransport(QObject *parent = nullptr);
     virtual void connectToHost(const QString &ipAddress, quint32 port) = 0;
+    virtual void connectToHosts(const QVector<Telegram::DcOption> &addresses); // Connects to the first reachable address
     virtual void disconnectFromHost() = 0;
     quint64 getNewMessageId(quint64 supposedId);
+    void resetMessageId() { m_lastMessageId = 0; } // Lets the ids go back after the clock moved back
 
     QAbstractSocket::SocketError error() const { return m_error; }
     QAbstractSocket::SocketState state() const { return m_state; }
+
+    // Of the established connection
+    Telegram::DcOption remoteAddress() const { return m_remoteAddress; }
+    qint64 connectTime() const { return m_connectTime; } // In ms
+
 signals:
     void error(QAbstractSocket::SocketError error);
     void stateChanged(QAbstractSocket::SocketState state);
+    void connectionAttemptFailed(const Telegram::DcOption &address);
 
     void timeout();
 
@@ -55,6 +66,9 @@ protected:
     virtual void readEvent() {}
     virtual void writeEvent() {}
 
+    Telegram::DcOption m_remoteAddress;
+    qint64 m_connectTime = 0;
+
 private:
     QAbstractSocket::SocketError m_error;
     QAbstractSocket::SocketState m_state;
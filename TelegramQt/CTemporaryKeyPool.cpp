@@ -0,0 +1,84 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#include "CTemporaryKeyPool.hpp"
+
+CTemporaryKeyPool::CTemporaryKeyPool(int keysPerDc, quint32 minLifetime) :
+    m_keysPerDc(keysPerDc),
+    m_minLifetime(minLifetime)
+{
+}
+
+void CTemporaryKeyPool::add(quint32 dc, const Key &key)
+{
+    if (!key.isValid()) {
+        return;
+    }
+
+    QVector<Key> &keys = m_keys[dc];
+    int index = keys.count();
+    while ((index > 0) && (keys.at(index - 1).expiresAt > key.expiresAt)) {
+        --index;
+    }
+    keys.insert(index, key);
+}
+
+CTemporaryKeyPool::Key CTemporaryKeyPool::take(quint32 dc, quint32 now)
+{
+    if (!m_keys.contains(dc)) {
+        return Key();
+    }
+
+    QVector<Key> &keys = m_keys[dc];
+    for (int i = 0; i < keys.count(); ++i) {
+        if (isUsable(keys.at(i), now)) {
+            const Key key = keys.at(i);
+            keys.remove(0, i + 1); // The preceding keys expire too soon
+            return key;
+        }
+    }
+    keys.clear();
+    return Key();
+}
+
+int CTemporaryKeyPool::count(quint32 dc, quint32 now) const
+{
+    int result = 0;
+    for (const Key &key : m_keys.value(dc)) {
+        if (isUsable(key, now)) {
+            ++result;
+        }
+    }
+    return result;
+}
+
+int CTemporaryKeyPool::missingCount(quint32 dc, quint32 now) const
+{
+    return qMax(0, m_keysPerDc - count(dc, now));
+}
+
+void CTemporaryKeyPool::removeExpired(quint32 now)
+{
+    for (auto it = m_keys.begin(); it != m_keys.end(); ++it) {
+        QVector<Key> &keys = it.value();
+        int expired = 0;
+        while ((expired < keys.count()) && !isUsable(keys.at(expired), now)) {
+            ++expired;
+        }
+        keys.remove(0, expired);
+    }
+}
@@ -0,0 +1,66 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#ifndef CTEMPORARYKEYPOOL_HPP
+#define CTEMPORARYKEYPOOL_HPP
+
+#include <QByteArray>
+#include <QHash>
+#include <QVector>
+
+/* The pre-generated temporary (PFS) auth keys, per DC.
+ *
+ * A key is generated in the background with a short-living connection (see CTelegramConnection::setTemporaryKeyLifetime())
+ * and is bound to the permanent key by the connection which takes it. A key is usable if it lives long enough to serve
+ * a connection for a while; the earliest expiring usable key is taken first. All of the times are the server unix time.
+ */
+class CTemporaryKeyPool
+{
+public:
+    struct Key {
+        QByteArray authKey;
+        quint64 serverSalt = 0;
+        quint32 expiresAt = 0;
+        qint32 deltaTime = 0;
+
+        bool isValid() const { return !authKey.isEmpty(); }
+    };
+
+    explicit CTemporaryKeyPool(int keysPerDc = 1, quint32 minLifetime = 60 * 60);
+
+    int keysPerDc() const { return m_keysPerDc; }
+    void setKeysPerDc(int count) { m_keysPerDc = count; }
+    quint32 minLifetime() const { return m_minLifetime; }
+
+    void add(quint32 dc, const Key &key);
+    Key take(quint32 dc, quint32 now); // An invalid key if there is no usable one
+
+    int count(quint32 dc, quint32 now) const; // Of the usable keys
+    int missingCount(quint32 dc, quint32 now) const;
+
+    void removeExpired(quint32 now); // Drops the keys which are not usable anymore
+    void clear() { m_keys.clear(); }
+
+protected:
+    bool isUsable(const Key &key, quint32 now) const { return key.expiresAt > now + m_minLifetime; }
+
+    QHash<quint32, QVector<Key> > m_keys; // Sorted by the expiration time
+    int m_keysPerDc;
+    quint32 m_minLifetime;
+};
+
+#endif // CTEMPORARYKEYPOOL_HPP
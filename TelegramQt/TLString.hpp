@@ -0,0 +1,99 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#ifndef TLSTRING_HPP
+#define TLSTRING_HPP
+
+#include <QByteArray>
+#include <QString>
+
+#include <string.h>
+
+/* TL string stored as UTF-8.
+ *
+ * A string read from a buffer-backed stream is a slice of the (implicitly shared) response buffer,
+ * so reading does neither allocate nor transcode. Conversion to QString happens on demand and
+ * is explicit in both directions, so that every transcoding copy is visible at the call site.
+ * Note that a slice retains the whole response, so call squeeze() on strings that outlive it.
+ *
+ * The generator uses this type for TL "string" fields with the --utf8-strings option.
+ */
+class TLString
+{
+public:
+    TLString() = default;
+    explicit TLString(const QString &str) :
+        m_data(str.toUtf8()),
+        m_size(m_data.size())
+    {
+    }
+
+    static TLString fromUtf8(const QByteArray &utf8)
+    {
+        return fromSlice(utf8, 0, utf8.size());
+    }
+
+    static TLString fromSlice(const QByteArray &buffer, int offset, int size)
+    {
+        TLString result;
+        result.m_data = buffer;
+        result.m_offset = offset;
+        result.m_size = size;
+        return result;
+    }
+
+    bool isEmpty() const { return m_size == 0; }
+    bool isSlice() const { return m_size != m_data.size(); }
+    int utf8Size() const { return m_size; }
+    const char *constData() const { return m_data.constData() + m_offset; }
+
+    QByteArray toUtf8() const
+    {
+        if (!isSlice()) {
+            return m_data;
+        }
+        return QByteArray(constData(), m_size);
+    }
+
+    QString toString() const { return QString::fromUtf8(constData(), m_size); }
+    explicit operator QString() const { return toString(); }
+
+    void squeeze()
+    {
+        if (isSlice()) {
+            m_data = toUtf8();
+            m_offset = 0;
+        }
+    }
+
+    bool operator==(const TLString &another) const
+    {
+        return (m_size == another.m_size) && (memcmp(constData(), another.constData(), m_size) == 0);
+    }
+
+    bool operator!=(const TLString &another) const
+    {
+        return !(*this == another);
+    }
+
+protected:
+    QByteArray m_data;
+    int m_offset = 0;
+    int m_size = 0;
+};
+
+#endif // TLSTRING_HPP
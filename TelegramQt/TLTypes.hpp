@@ -19,6 +19,7 @@
 #define TLTYPES_HPP
 
 #include "TLValues.hpp"
+#include "TLString.hpp"
 
 #include <QMetaType>
 #include <QVector>
@@ -79,6 +80,7 @@ struct TLAccountDaysTTL {
             return false;
         };
     }
+    static constexpr quint32 AccountDaysTTLSize = 8;
     quint32 days;
     TLValue tlType;
 };
@@ -185,6 +187,7 @@ struct TLAudio {
             return false;
         };
     }
+    static constexpr quint32 AudioEmptySize = 12;
     quint64 id;
     quint64 accessHash;
     quint32 date;
@@ -363,6 +366,12 @@ struct TLChannelParticipant {
             return false;
         };
     }
+    static constexpr quint32 ChannelParticipantSize = 12;
+    static constexpr quint32 ChannelParticipantSelfSize = 16;
+    static constexpr quint32 ChannelParticipantModeratorSize = 16;
+    static constexpr quint32 ChannelParticipantEditorSize = 16;
+    static constexpr quint32 ChannelParticipantKickedSize = 16;
+    static constexpr quint32 ChannelParticipantCreatorSize = 8;
     quint32 userId;
     quint32 date;
     quint32 inviterId;
@@ -422,6 +431,9 @@ struct TLChatParticipant {
             return false;
         };
     }
+    static constexpr quint32 ChatParticipantSize = 16;
+    static constexpr quint32 ChatParticipantCreatorSize = 8;
+    static constexpr quint32 ChatParticipantAdminSize = 16;
     quint32 userId;
     quint32 inviterId;
     quint32 date;
@@ -488,6 +500,7 @@ struct TLContactBlocked {
             return false;
         };
     }
+    static constexpr quint32 ContactBlockedSize = 12;
     quint32 userId;
     quint32 date;
     TLValue tlType;
@@ -525,6 +538,7 @@ struct TLContactSuggested {
             return false;
         };
     }
+    static constexpr quint32 ContactSuggestedSize = 12;
     quint32 userId;
     quint32 mutualContacts;
     TLValue tlType;
@@ -569,6 +583,9 @@ struct TLEncryptedChat {
             return false;
         };
     }
+    static constexpr quint32 EncryptedChatEmptySize = 8;
+    static constexpr quint32 EncryptedChatWaitingSize = 28;
+    static constexpr quint32 EncryptedChatDiscardedSize = 8;
     quint32 id;
     quint64 accessHash;
     quint32 date;
@@ -598,6 +615,7 @@ struct TLEncryptedFile {
             return false;
         };
     }
+    static constexpr quint32 EncryptedFileSize = 32;
     quint64 id;
     quint64 accessHash;
     quint32 size;
@@ -682,6 +700,8 @@ struct TLFileLocation {
             return false;
         };
     }
+    static constexpr quint32 FileLocationUnavailableSize = 24;
+    static constexpr quint32 FileLocationSize = 28;
     quint64 volumeId;
     quint32 localId;
     quint64 secret;
@@ -704,6 +724,7 @@ struct TLGeoPoint {
             return false;
         };
     }
+    static constexpr quint32 GeoPointSize = 20;
     double longitude;
     double latitude;
     TLValue tlType;
@@ -794,6 +815,7 @@ struct TLImportedContact {
             return false;
         };
     }
+    static constexpr quint32 ImportedContactSize = 16;
     quint32 userId;
     quint64 clientId;
     TLValue tlType;
@@ -835,6 +857,7 @@ struct TLInputAudio {
             return false;
         };
     }
+    static constexpr quint32 InputAudioSize = 20;
     quint64 id;
     quint64 accessHash;
     TLValue tlType;
@@ -855,6 +878,7 @@ struct TLInputChannel {
             return false;
         };
     }
+    static constexpr quint32 InputChannelSize = 16;
     quint32 channelId;
     quint64 accessHash;
     TLValue tlType;
@@ -895,6 +919,7 @@ struct TLInputDocument {
             return false;
         };
     }
+    static constexpr quint32 InputDocumentSize = 20;
     quint64 id;
     quint64 accessHash;
     TLValue tlType;
@@ -914,6 +939,7 @@ struct TLInputEncryptedChat {
             return false;
         };
     }
+    static constexpr quint32 InputEncryptedChatSize = 16;
     quint32 chatId;
     quint64 accessHash;
     TLValue tlType;
@@ -938,6 +964,8 @@ struct TLInputEncryptedFile {
             return false;
         };
     }
+    static constexpr quint32 InputEncryptedFileSize = 20;
+    static constexpr quint32 InputEncryptedFileBigUploadedSize = 20;
     quint64 id;
     quint32 parts;
     QString md5Checksum;
@@ -989,6 +1017,11 @@ struct TLInputFileLocation {
             return false;
         };
     }
+    static constexpr quint32 InputFileLocationSize = 24;
+    static constexpr quint32 InputVideoFileLocationSize = 20;
+    static constexpr quint32 InputEncryptedFileLocationSize = 20;
+    static constexpr quint32 InputAudioFileLocationSize = 20;
+    static constexpr quint32 InputDocumentFileLocationSize = 20;
     quint64 volumeId;
     quint32 localId;
     quint64 secret;
@@ -1012,6 +1045,7 @@ struct TLInputGeoPoint {
             return false;
         };
     }
+    static constexpr quint32 InputGeoPointSize = 20;
     double latitude;
     double longitude;
     TLValue tlType;
@@ -1037,6 +1071,9 @@ struct TLInputPeer {
             return false;
         };
     }
+    static constexpr quint32 InputPeerChatSize = 8;
+    static constexpr quint32 InputPeerUserSize = 16;
+    static constexpr quint32 InputPeerChannelSize = 16;
     quint32 chatId;
     quint32 userId;
     quint64 accessHash;
@@ -1097,6 +1134,7 @@ struct TLInputPhoto {
             return false;
         };
     }
+    static constexpr quint32 InputPhotoSize = 20;
     quint64 id;
     quint64 accessHash;
     TLValue tlType;
@@ -1118,6 +1156,7 @@ struct TLInputPhotoCrop {
             return false;
         };
     }
+    static constexpr quint32 InputPhotoCropSize = 28;
     double cropLeft;
     double cropTop;
     double cropWidth;
@@ -1155,6 +1194,7 @@ struct TLInputStickerSet {
             return false;
         };
     }
+    static constexpr quint32 InputStickerSetIDSize = 20;
     quint64 id;
     quint64 accessHash;
     QString shortName;
@@ -1177,6 +1217,7 @@ struct TLInputUser {
             return false;
         };
     }
+    static constexpr quint32 InputUserSize = 16;
     quint32 userId;
     quint64 accessHash;
     TLValue tlType;
@@ -1197,6 +1238,7 @@ struct TLInputVideo {
             return false;
         };
     }
+    static constexpr quint32 InputVideoSize = 20;
     quint64 id;
     quint64 accessHash;
     TLValue tlType;
@@ -1258,6 +1300,15 @@ struct TLMessageEntity {
             return false;
         };
     }
+    static constexpr quint32 MessageEntityUnknownSize = 12;
+    static constexpr quint32 MessageEntityMentionSize = 12;
+    static constexpr quint32 MessageEntityHashtagSize = 12;
+    static constexpr quint32 MessageEntityBotCommandSize = 12;
+    static constexpr quint32 MessageEntityUrlSize = 12;
+    static constexpr quint32 MessageEntityEmailSize = 12;
+    static constexpr quint32 MessageEntityBoldSize = 12;
+    static constexpr quint32 MessageEntityItalicSize = 12;
+    static constexpr quint32 MessageEntityCodeSize = 12;
     quint32 offset;
     quint32 length;
     QString language;
@@ -1281,6 +1332,7 @@ struct TLMessageGroup {
             return false;
         };
     }
+    static constexpr quint32 MessageGroupSize = 20;
     quint32 minId;
     quint32 maxId;
     quint32 count;
@@ -1302,6 +1354,7 @@ struct TLMessageRange {
             return false;
         };
     }
+    static constexpr quint32 MessageRangeSize = 12;
     quint32 minId;
     quint32 maxId;
     TLValue tlType;
@@ -1322,6 +1375,7 @@ struct TLMessagesAffectedHistory {
             return false;
         };
     }
+    static constexpr quint32 MessagesAffectedHistorySize = 16;
     quint32 pts;
     quint32 ptsCount;
     quint32 offset;
@@ -1342,6 +1396,7 @@ struct TLMessagesAffectedMessages {
             return false;
         };
     }
+    static constexpr quint32 MessagesAffectedMessagesSize = 12;
     quint32 pts;
     quint32 ptsCount;
     TLValue tlType;
@@ -1407,6 +1462,7 @@ struct TLMessagesSentEncryptedMessage {
             return false;
         };
     }
+    static constexpr quint32 MessagesSentEncryptedMessageSize = 8;
     quint32 date;
     TLEncryptedFile file;
     TLValue tlType;
@@ -1449,6 +1505,9 @@ struct TLPeer {
             return false;
         };
     }
+    static constexpr quint32 PeerUserSize = 8;
+    static constexpr quint32 PeerChatSize = 8;
+    static constexpr quint32 PeerChannelSize = 8;
     quint32 userId;
     quint32 chatId;
     quint32 channelId;
@@ -1570,6 +1629,7 @@ struct TLReceivedNotifyMessage {
             return false;
         };
     }
+    static constexpr quint32 ReceivedNotifyMessageSize = 12;
     quint32 id;
     quint32 flags;
     TLValue tlType;
@@ -1616,6 +1676,10 @@ struct TLSendMessageAction {
             return false;
         };
     }
+    static constexpr quint32 SendMessageUploadVideoActionSize = 8;
+    static constexpr quint32 SendMessageUploadAudioActionSize = 8;
+    static constexpr quint32 SendMessageUploadPhotoActionSize = 8;
+    static constexpr quint32 SendMessageUploadDocumentActionSize = 8;
     quint32 progress;
     TLValue tlType;
 };
@@ -1678,6 +1742,7 @@ struct TLUpdatesState {
             return false;
         };
     }
+    static constexpr quint32 UpdatesStateSize = 24;
     quint32 pts;
     quint32 qts;
     quint32 date;
@@ -1744,6 +1809,8 @@ struct TLUserStatus {
             return false;
         };
     }
+    static constexpr quint32 UserStatusOnlineSize = 8;
+    static constexpr quint32 UserStatusOfflineSize = 8;
     quint32 expires;
     quint32 wasOnline;
     TLValue tlType;
@@ -1770,6 +1837,7 @@ struct TLVideo {
             return false;
         };
     }
+    static constexpr quint32 VideoEmptySize = 12;
     quint64 id;
     quint64 accessHash;
     quint32 date;
@@ -1989,6 +2057,8 @@ struct TLDocumentAttribute {
             return false;
         };
     }
+    static constexpr quint32 DocumentAttributeImageSizeSize = 12;
+    static constexpr quint32 DocumentAttributeVideoSize = 16;
     quint32 w;
     quint32 h;
     QString alt;
@@ -2218,6 +2288,7 @@ struct TLPhoto {
             return false;
         };
     }
+    static constexpr quint32 PhotoEmptySize = 12;
     quint64 id;
     quint64 accessHash;
     quint32 date;
@@ -2245,6 +2316,8 @@ struct TLReplyMarkup {
         SingleUse = 1 << 1,
         Selective = 1 << 2,
     };
+    static constexpr quint32 ReplyKeyboardHideSize = 8;
+    static constexpr quint32 ReplyKeyboardForceReplySize = 8;
     bool selective() const { return flags & Selective; }
     bool singleUse() const { return flags & SingleUse; }
     bool resize() const { return flags & Resize; }
@@ -2326,6 +2399,7 @@ struct TLUser {
         Restricted = 1 << 18,
         BotInlinePlaceholder = 1 << 19,
     };
+    static constexpr quint32 UserEmptySize = 8;
     bool self() const { return flags & Self; }
     bool contact() const { return flags & Contact; }
     bool mutualContact() const { return flags & MutualContact; }
@@ -2458,6 +2532,7 @@ struct TLChat {
         RestrictionReason = 1 << 9,
         Restricted = 1 << 9,
     };
+    static constexpr quint32 ChatEmptySize = 8;
     bool creator() const { return flags & Creator; }
     bool kicked() const { return flags & Kicked; }
     bool left() const { return flags & Left; }
@@ -2761,6 +2836,7 @@ struct TLDocument {
             return false;
         };
     }
+    static constexpr quint32 DocumentEmptySize = 12;
     quint64 id;
     quint64 accessHash;
     quint32 date;
@@ -2841,6 +2917,9 @@ struct TLMessageAction {
             return false;
         };
     }
+    static constexpr quint32 MessageActionChatDeleteUserSize = 8;
+    static constexpr quint32 MessageActionChatJoinedByLinkSize = 8;
+    static constexpr quint32 MessageActionChatMigrateToSize = 8;
     QString title;
     TLVector<quint32> users;
     TLPhoto photo;
@@ -3070,6 +3149,8 @@ struct TLWebPage {
         Author = 1 << 8,
         Document = 1 << 9,
     };
+    static constexpr quint32 WebPageEmptySize = 12;
+    static constexpr quint32 WebPagePendingSize = 16;
     quint64 id;
     quint32 date;
     quint32 flags;
@@ -3240,6 +3321,7 @@ struct TLMessage {
         Views = 1 << 10,
         ViaBotId = 1 << 11,
     };
+    static constexpr quint32 MessageEmptySize = 8;
     bool unread() const { return flags & Unread; }
     bool out() const { return flags & Out; }
     bool mentioned() const { return flags & Mentioned; }
@@ -3388,6 +3470,16 @@ struct TLUpdate {
             return false;
         };
     }
+    static constexpr quint32 UpdateMessageIDSize = 16;
+    static constexpr quint32 UpdateContactRegisteredSize = 12;
+    static constexpr quint32 UpdateEncryptedChatTypingSize = 8;
+    static constexpr quint32 UpdateEncryptedMessagesReadSize = 16;
+    static constexpr quint32 UpdateChatParticipantAddSize = 24;
+    static constexpr quint32 UpdateChatParticipantDeleteSize = 16;
+    static constexpr quint32 UpdateChannelTooLongSize = 8;
+    static constexpr quint32 UpdateChannelSize = 8;
+    static constexpr quint32 UpdateReadChannelInboxSize = 12;
+    static constexpr quint32 UpdateChannelMessageViewsSize = 16;
     TLMessage message;
     quint32 pts;
     quint32 ptsCount;
@@ -3573,6 +3665,7 @@ struct TLUpdatesDifference {
             return false;
         };
     }
+    static constexpr quint32 UpdatesDifferenceEmptySize = 12;
     quint32 date;
     quint32 seq;
     TLVector<TLMessage> newMessages;
@@ -31,6 +31,7 @@ public:
         // Generated TLValues (proto)
         ResPQ = 0x05162463,
         PQInnerData = 0x83c95aec,
+        PQInnerDataTemp = 0x3c6a84d4,
         ServerDHParamsFail = 0x79cb045d,
         ServerDHParamsOk = 0xd0e8075c,
         ServerDHInnerData = 0xb5890dba,
@@ -48,6 +49,7 @@ public:
         Pong = 0x347773c5,
         DestroySessionOk = 0xe22045fc,
         DestroySessionNone = 0x62d350c9,
+        BindAuthKeyInner = 0x75a3f765,
         NewSessionCreated = 0x9ec20908,
         MsgContainer = 0x73f1f8dc,
         MsgCopy = 0xe06046b2,
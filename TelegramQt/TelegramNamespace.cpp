@@ -43,6 +43,8 @@ void TelegramNamespace::registerTypes()
         qRegisterMetaType<TelegramNamespace::AuthSignError>("TelegramNamespace::AuthSignError");
         qRegisterMetaType<TelegramNamespace::UnauthorizedError>("TelegramNamespace::UnauthorizedError");
         qRegisterMetaType<Telegram::PasswordInfo>("Telegram::PasswordInfo");
+        qRegisterMetaType<QVector<quint32> >("QVector<quint32>");
+        qRegisterMetaType<QVector<Telegram::Message> >("QVector<Telegram::Message>");
         registered = true;
     }
 }
@@ -117,6 +117,25 @@ public:
     };
     Q_ENUM(ConnectionState)
 
+    enum RequestFailureReason {
+        RequestFailureTimeout, // No answer within the request deadline
+        RequestFailureRetryLimit, // The request was lost too many times
+        RequestFailureAnswerLost, // The request is processed, but the answer is lost and the request is not safe to repeat
+        RequestFailureConnectionClosed, // The connection is closed (locally, or dropped after a remote close)
+        RequestFailureFloodWait, // The server asked to wait longer than the request deadline
+        RequestFailureUnknownOutcome, // The server knows nothing about the request, it may or may not be processed
+    };
+    Q_ENUM(RequestFailureReason)
+
+    enum RequestClass {
+        RequestClassInteractive, // Latency-sensitive requests (updates, typing, read state, auth), not limited
+        RequestClassMessages, // Sending and forwarding of messages
+        RequestClassContacts, // Import and search of contacts, user info
+        RequestClassFiles, // Upload and download of the files (e.g. avatars)
+        RequestClassHistory, // History, search and participants fetching
+    };
+    Q_ENUM(RequestClass)
+
     enum ContactLastOnline {
         ContactLastOnlineUnknown,
         ContactLastOnlineRecently,
@@ -224,6 +243,16 @@ struct Peer
     }
 };
 
+struct RequestQueueStats
+{
+    int queueDepth = 0; // Requests waiting to be sent
+    quint32 delayedCount = 0; // Requests sent after a wait in the queue
+    qint64 averageWaitTime = 0; // Of the delayed requests, in ms
+    qint64 maxWaitTime = 0; // In ms
+    qint64 oldestWaitTime = 0; // The wait time of the first queued request, in ms
+    qint64 floodWaitRemaining = 0; // In ms
+};
+
 struct DcOption
 {
     DcOption() : port(0) { }
@@ -36,6 +36,17 @@ SOURCES = CTelegramCore.cpp \
     CTelegramTransportModule.cpp \
     CRawStream.cpp \
     CTelegramStream.cpp \
+    CTelegramStreamExtraOperators.cpp \
+    CPeerCache.cpp \
+    CChannelDifferenceScheduler.cpp \
+    CChatParticipants.cpp \
+    CMessageHistoryCache.cpp \
+    CMessageSearchIndex.cpp \
+    CRequestRateLimiter.cpp \
+    CRttEstimator.cpp \
+    CAddressLatencyCache.cpp \
+    CAuthCryptoJob.cpp \
+    CTemporaryKeyPool.cpp \
     Debug.cpp \
     Utils.cpp \
     FileRequestDescriptor.cpp \
@@ -69,6 +80,19 @@ HEADERS = CTelegramCore.hpp \
     CTelegramTransportModule.hpp \
     CTelegramStream.hpp \
     CTelegramStream_p.hpp \
+    CTelegramStreamExtraOperators.hpp \
+    CPeerCache.hpp \
+    CPeerTable.hpp \
+    CChatParticipants.hpp \
+    CChatIdMap.hpp \
+    CChannelDifferenceScheduler.hpp \
+    CMessageHistoryCache.hpp \
+    CMessageSearchIndex.hpp \
+    CRequestRateLimiter.hpp \
+    CRttEstimator.hpp \
+    CAddressLatencyCache.hpp \
+    CAuthCryptoJob.hpp \
+    CTemporaryKeyPool.hpp \
     CRawStream.hpp \
     Utils.hpp \
     FileRequestDescriptor.hpp \
@@ -78,6 +102,7 @@ HEADERS = CTelegramCore.hpp \
     CClientTcpTransport.hpp \
     TLTypes.hpp \
     TLNumbers.hpp \
+    TLString.hpp \
     crypto-aes.hpp \
     crypto-rsa.hpp \
     CTelegramConnection.hpp \
@@ -94,6 +119,11 @@ contains(options, developer-build) {
     DEFINES += QT_DEPRECATED_WARNINGS
 }
 
+contains(options, table-decoder) {
+    SOURCES += CTelegramStreamTables.cpp
+    DEFINES += TELEGRAMQT_TABLE_DECODER
+}
+
 OTHER_FILES += CMakeLists.txt
 
 # Installation
@@ -157,50 +157,91 @@ quint64 Utils::greatestCommonOddDivisor(quint64 a, quint64 b)
     return b == 0 ? a : b;
 }
 
-// Yet another copy of some unknown pq-solver algorithm.
-// Links:
-// https://github.com/DrKLO/Telegram/blob/433f59c5b9ed17543d8e206c83f0bc7c7edb43a6/TMessagesProj/jni/jni.c#L86
-// https://github.com/ex3ndr/telegram-mt/blob/91b1186e567b0484d6f371b8e5c61c425daf867e/src/main/java/org/telegram/mtproto/secure/pq/PQLopatin.java#L35
-// https://github.com/vysheng/tg/blob/1dad2e89933085ea1e3d9fb1becb1907ce5de55f/mtproto-client.c#L296
+// (a * b) % m without an overflow
+static quint64 multiplyModulo(quint64 a, quint64 b, quint64 m)
+{
+#ifdef __SIZEOF_INT128__
+    return quint64((unsigned __int128)a * b % m);
+#else
+    quint64 result = 0;
+    a %= m;
+    while (b) {
+        if (b & 1) {
+            result = (result >= m - a) ? result - (m - a) : result + a;
+        }
+        a = (a >= m - a) ? a - (m - a) : a + a;
+        b >>= 1;
+    }
+    return result;
+#endif
+}
+
+static quint64 greatestCommonDivisor(quint64 a, quint64 b)
+{
+    while (b) {
+        const quint64 r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+// Pollard's rho with the Brent's cycle detection and the batched gcd (R. P. Brent, "An improved Monte Carlo
+// factorization algorithm", 1980). The seeds are fixed, so the result and the time are reproducible.
 quint64 Utils::findDivider(quint64 number)
 {
-    int it = 0;
-    quint64 g = 0;
-    for (int i = 0; i < 3 || it < 10000; i++) {
-        const quint64 q = ((rand() & 15) + 17) % number;
-        quint64 x = (quint64) rand() % (number - 1) + 1;
-        quint64 y = x;
-        const quint32 lim = 1 << (i + 18);
-        for (quint32 j = 1; j < lim; j++) {
-            ++it;
-            quint64 a = x;
-            quint64 b = x;
-            quint64 c = q;
-            while (b) {
-                if (b & 1) {
-                    c += a;
-                    if (c >= number) {
-                        c -= number;
-                    }
-                }
-                a += a;
-                if (a >= number) {
-                    a -= number;
-                }
-                b >>= 1;
-            }
-            x = c;
-            const quint64 z = x < y ? number + x - y : x - y;
-            g = greatestCommonOddDivisor(z, number);
-            if (g != 1) {
-                return g;
+    if (number < 4) {
+        return 1;
+    }
+    if (!(number & 1)) {
+        return 2;
+    }
+
+    static const quint64 batchSize = 128; // Steps per gcd
+    static const quint64 maxCycleLength = 1 << 22; // The pq factors are 32-bit, so about 2^16 steps are expected
+    static const quint64 maxIncrement = 16;
+
+    for (quint64 c = 1; (c <= maxIncrement) && (c < number); ++c) {
+        // y = y^2 + c (mod number)
+        auto next = [number, c](quint64 y) {
+            const quint64 square = multiplyModulo(y, y, number);
+            return (square >= number - c) ? square - (number - c) : square + c;
+        };
+        auto distance = [](quint64 a, quint64 b) {
+            return a > b ? a - b : b - a;
+        };
+
+        quint64 x = 0;
+        quint64 y = 2;
+        quint64 ys = y;
+        quint64 product = 1;
+        quint64 g = 1;
+
+        for (quint64 r = 1; (g == 1) && (r <= maxCycleLength); r <<= 1) {
+            x = y;
+            for (quint64 i = 0; i < r; ++i) {
+                y = next(y);
             }
-            if (!(j & (j - 1))) {
-                y = x;
+            for (quint64 k = 0; (k < r) && (g == 1); k += batchSize) {
+                ys = y;
+                const quint64 steps = qMin(batchSize, r - k);
+                for (quint64 i = 0; i < steps; ++i) {
+                    y = next(y);
+                    product = multiplyModulo(product, distance(x, y), number);
+                }
+                g = greatestCommonDivisor(product, number);
             }
         }
 
-        if (g > 1 && g < number) {
+        if (g == number) {
+            // The batch has overshot, step back to the single steps
+            do {
+                ys = next(ys);
+                g = greatestCommonDivisor(distance(x, ys), number);
+            } while (g == 1);
+        }
+
+        if ((g != 1) && (g != number)) {
             return g;
         }
     }
@@ -2,6 +2,17 @@ TEMPLATE = subdirs
 SUBDIRS += tst_CTelegramTransport
 SUBDIRS += tst_CTelegramConnection
 SUBDIRS += tst_CTelegramStream
+SUBDIRS += tst_CTelegramStreamCorpus
+SUBDIRS += tst_CPeerTable
+SUBDIRS += tst_CChatIdMap
+SUBDIRS += tst_CChatParticipants
+SUBDIRS += tst_CChannelDifferenceScheduler
+SUBDIRS += tst_CMessageHistoryCache
+SUBDIRS += tst_CMessageSearchIndex
+SUBDIRS += tst_CRequestRateLimiter
+SUBDIRS += tst_CRttEstimator
+SUBDIRS += tst_CAddressLatencyCache
+SUBDIRS += tst_CTemporaryKeyPool
 SUBDIRS += tst_TelegramRemoteFile
 SUBDIRS += tst_CTelegramDispatcher
 SUBDIRS += tst_utils
@@ -0,0 +1,118 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#include <QObject>
+
+#include "CAddressLatencyCache.hpp"
+
+#include <QTest>
+#include <QDebug>
+
+using Telegram::DcOption;
+
+static const DcOption c_ipv4First(QLatin1String("149.154.167.50"), 443);
+static const DcOption c_ipv4Second(QLatin1String("149.154.167.51"), 443);
+static const DcOption c_ipv6First(QLatin1String("2001:67c:4e8:f002::a"), 443);
+static const DcOption c_ipv6Second(QLatin1String("2001:67c:4e8:f002::b"), 443);
+
+static QStringList addressList(const QVector<DcOption> &addresses)
+{
+    QStringList result;
+    for (const DcOption &address : addresses) {
+        result.append(address.address);
+    }
+    return result;
+}
+
+class tst_CAddressLatencyCache : public QObject
+{
+    Q_OBJECT
+public:
+    explicit tst_CAddressLatencyCache(QObject *parent = nullptr);
+
+private slots:
+    void latency();
+    void interleaveFamilies();
+    void knownFirst();
+    void failedLast();
+
+};
+
+tst_CAddressLatencyCache::tst_CAddressLatencyCache(QObject *parent) :
+    QObject(parent)
+{
+}
+
+void tst_CAddressLatencyCache::latency()
+{
+    CAddressLatencyCache cache;
+    QCOMPARE(cache.latency(c_ipv4First), qint64(-1));
+
+    cache.addSample(c_ipv4First, 100);
+    QCOMPARE(cache.latency(c_ipv4First), qint64(100));
+    cache.addSample(c_ipv4First, 200);
+    QCOMPARE(cache.latency(c_ipv4First), qint64(125));
+
+    // The port is a part of the address
+    QCOMPARE(cache.latency(DcOption(c_ipv4First.address, 80)), qint64(-1));
+
+    cache.clear();
+    QCOMPARE(cache.latency(c_ipv4First), qint64(-1));
+}
+
+void tst_CAddressLatencyCache::interleaveFamilies()
+{
+    QVERIFY(CAddressLatencyCache::isIpv6(c_ipv6First));
+    QVERIFY(!CAddressLatencyCache::isIpv6(c_ipv4First));
+
+    CAddressLatencyCache cache;
+    const QVector<DcOption> addresses = { c_ipv6First, c_ipv6Second, c_ipv4First, c_ipv4Second };
+    const QVector<DcOption> expected = { c_ipv6First, c_ipv4First, c_ipv6Second, c_ipv4Second };
+    QCOMPARE(addressList(cache.sorted(addresses)), addressList(expected));
+}
+
+void tst_CAddressLatencyCache::knownFirst()
+{
+    CAddressLatencyCache cache;
+    cache.addSample(c_ipv4Second, 300);
+    cache.addSample(c_ipv6Second, 100);
+
+    const QVector<DcOption> addresses = { c_ipv4First, c_ipv4Second, c_ipv6First, c_ipv6Second };
+    const QVector<DcOption> expected = { c_ipv6Second, c_ipv4Second, c_ipv4First, c_ipv6First };
+    QCOMPARE(addressList(cache.sorted(addresses)), addressList(expected));
+}
+
+void tst_CAddressLatencyCache::failedLast()
+{
+    CAddressLatencyCache cache;
+    cache.addSample(c_ipv4First, 50);
+    cache.addFailure(c_ipv4First);
+    cache.addFailure(c_ipv4First);
+    cache.addFailure(c_ipv6First);
+
+    const QVector<DcOption> addresses = { c_ipv4First, c_ipv6First, c_ipv4Second };
+    const QVector<DcOption> expected = { c_ipv4Second, c_ipv6First, c_ipv4First };
+    QCOMPARE(addressList(cache.sorted(addresses)), addressList(expected));
+
+    // A successful connection resets the failures
+    cache.addSample(c_ipv4First, 50);
+    QCOMPARE(cache.sorted(addresses).first().address, c_ipv4First.address);
+}
+
+QTEST_MAIN(tst_CAddressLatencyCache)
+
+#include "tst_CAddressLatencyCache.moc"
@@ -0,0 +1,4 @@
+include(../tests.pri)
+
+TARGET = tst_addresslatencycache
+SOURCES = tst_CAddressLatencyCache.cpp
@@ -0,0 +1,216 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#include <QObject>
+
+#include "CChannelDifferenceScheduler.hpp"
+
+#include <QTest>
+#include <QDebug>
+
+class tst_CChannelDifferenceScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    explicit tst_CChannelDifferenceScheduler(QObject *parent = nullptr);
+
+private slots:
+    void priorities();
+    void activeRequestsLimit();
+    void scheduleMerge();
+    void resume();
+    void floodWait();
+    void requeueActive();
+    void retryBackoff();
+
+};
+
+tst_CChannelDifferenceScheduler::tst_CChannelDifferenceScheduler(QObject *parent) :
+    QObject(parent)
+{
+}
+
+void tst_CChannelDifferenceScheduler::priorities()
+{
+    CChannelDifferenceScheduler scheduler(/* maxActiveRequests */ 10);
+    scheduler.schedule(1, 100, 1000);
+    scheduler.schedule(2, 200, 3000);
+    scheduler.schedule(3, 300, 2000);
+
+    quint32 channelId = 0;
+    quint32 pts = 0;
+    QVector<quint32> order;
+    while (scheduler.takeNext(0, &channelId, &pts)) {
+        order.append(channelId);
+        QCOMPARE(pts, channelId * 100);
+    }
+    QCOMPARE(order, QVector<quint32>({ 2, 3, 1 }));
+    QCOMPARE(scheduler.activeCount(), 3);
+    QCOMPARE(scheduler.pendingCount(), 0);
+}
+
+void tst_CChannelDifferenceScheduler::activeRequestsLimit()
+{
+    CChannelDifferenceScheduler scheduler(/* maxActiveRequests */ 2);
+    for (quint32 i = 1; i <= 5; ++i) {
+        scheduler.schedule(i, i, i);
+    }
+
+    quint32 channelId = 0;
+    quint32 pts = 0;
+    QVERIFY(scheduler.takeNext(0, &channelId, &pts));
+    QCOMPARE(channelId, 5u);
+    QVERIFY(scheduler.takeNext(0, &channelId, &pts));
+    QCOMPARE(channelId, 4u);
+    QVERIFY(!scheduler.takeNext(0, &channelId, &pts));
+    QCOMPARE(scheduler.nextRequestTime(0), qint64(-1)); // Waits for a response
+
+    scheduler.finish(5);
+    QCOMPARE(scheduler.nextRequestTime(0), qint64(0));
+    QVERIFY(scheduler.takeNext(0, &channelId, &pts));
+    QCOMPARE(channelId, 3u);
+    QCOMPARE(scheduler.activeCount(), 2);
+    QCOMPARE(scheduler.pendingCount(), 2);
+}
+
+void tst_CChannelDifferenceScheduler::scheduleMerge()
+{
+    CChannelDifferenceScheduler scheduler(/* maxActiveRequests */ 1);
+    scheduler.schedule(1, 50, 10);
+    scheduler.schedule(2, 70, 20);
+    scheduler.schedule(1, 60, 30); // Keeps the lowest pts, raises the priority
+    QCOMPARE(scheduler.pendingCount(), 2);
+
+    quint32 channelId = 0;
+    quint32 pts = 0;
+    QVERIFY(scheduler.takeNext(0, &channelId, &pts));
+    QCOMPARE(channelId, 1u);
+    QCOMPARE(pts, 50u);
+
+    scheduler.schedule(1, 80, 100); // Active, covered by the request in flight
+    QVERIFY(!scheduler.isPending(1));
+    QCOMPARE(scheduler.pendingCount(), 1);
+}
+
+void tst_CChannelDifferenceScheduler::resume()
+{
+    CChannelDifferenceScheduler scheduler(/* maxActiveRequests */ 1);
+    scheduler.schedule(1, 10, 10);
+    scheduler.schedule(2, 20, 20);
+
+    quint32 channelId = 0;
+    quint32 pts = 0;
+    QVERIFY(scheduler.takeNext(0, &channelId, &pts));
+    QCOMPARE(channelId, 2u);
+
+    scheduler.resume(2, 25); // Not final: continue the started channel first
+    QVERIFY(scheduler.takeNext(0, &channelId, &pts));
+    QCOMPARE(channelId, 2u);
+    QCOMPARE(pts, 25u);
+
+    scheduler.finish(2);
+    QVERIFY(scheduler.takeNext(0, &channelId, &pts));
+    QCOMPARE(channelId, 1u);
+}
+
+void tst_CChannelDifferenceScheduler::floodWait()
+{
+    CChannelDifferenceScheduler scheduler(/* maxActiveRequests */ 3);
+    scheduler.schedule(1, 10, 10);
+    scheduler.schedule(2, 20, 20);
+
+    quint32 channelId = 0;
+    quint32 pts = 0;
+    QVERIFY(scheduler.takeNext(1000, &channelId, &pts));
+    QCOMPARE(channelId, 2u);
+
+    scheduler.floodWait(2, /* seconds */ 5, /* now */ 1000);
+    QVERIFY(scheduler.isPending(2));
+    QVERIFY(!scheduler.takeNext(1000, &channelId, &pts));
+    QVERIFY(!scheduler.takeNext(5999, &channelId, &pts));
+    QCOMPARE(scheduler.nextRequestTime(1000), qint64(6000));
+
+    QVERIFY(scheduler.takeNext(6000, &channelId, &pts));
+    QCOMPARE(channelId, 2u);
+    QCOMPARE(pts, 20u);
+}
+
+void tst_CChannelDifferenceScheduler::requeueActive()
+{
+    CChannelDifferenceScheduler scheduler(/* maxActiveRequests */ 2);
+    scheduler.schedule(1, 10, 10);
+    scheduler.schedule(2, 20, 20);
+
+    quint32 channelId = 0;
+    quint32 pts = 0;
+    QVERIFY(scheduler.takeNext(0, &channelId, &pts));
+    QVERIFY(scheduler.takeNext(0, &channelId, &pts));
+    QCOMPARE(scheduler.activeCount(), 2);
+
+    scheduler.requeueActive();
+    QCOMPARE(scheduler.activeCount(), 0);
+    QCOMPARE(scheduler.pendingCount(), 2);
+    QVERIFY(scheduler.takeNext(0, &channelId, &pts));
+    QCOMPARE(channelId, 2u);
+}
+
+void tst_CChannelDifferenceScheduler::retryBackoff()
+{
+    CChannelDifferenceScheduler scheduler(/* maxActiveRequests */ 1);
+    scheduler.schedule(1, 10, 10);
+    scheduler.schedule(2, 20, 20);
+
+    quint32 channelId = 0;
+    quint32 pts = 0;
+    QVERIFY(scheduler.takeNext(1000, &channelId, &pts));
+    QCOMPARE(channelId, 2u);
+
+    // The failed channel releases the slot and waits, the other one goes first
+    QVERIFY(scheduler.retry(2, /* now */ 1000));
+    QCOMPARE(scheduler.activeCount(), 0);
+    QVERIFY(scheduler.isPending(2));
+    QVERIFY(scheduler.takeNext(1000, &channelId, &pts));
+    QCOMPARE(channelId, 1u);
+    scheduler.finish(1);
+
+    const qint64 firstRetryTime = 1000 + CChannelDifferenceScheduler::retryDelay(1);
+    QCOMPARE(scheduler.nextRequestTime(1000), firstRetryTime);
+    QVERIFY(!scheduler.takeNext(firstRetryTime - 1, &channelId, &pts));
+    QVERIFY(scheduler.takeNext(firstRetryTime, &channelId, &pts));
+    QCOMPARE(channelId, 2u);
+    QCOMPARE(pts, 20u);
+
+    // The delay grows with the failures
+    QVERIFY(scheduler.retry(2, firstRetryTime));
+    QCOMPARE(scheduler.nextRequestTime(firstRetryTime), firstRetryTime + CChannelDifferenceScheduler::retryDelay(2));
+    QVERIFY(CChannelDifferenceScheduler::retryDelay(2) > CChannelDifferenceScheduler::retryDelay(1));
+
+    // The channel is dropped after the retries limit
+    qint64 now = firstRetryTime;
+    for (int i = 2; i <= CChannelDifferenceScheduler::maxRetries(); ++i) {
+        now = scheduler.nextRequestTime(now);
+        QVERIFY(scheduler.takeNext(now, &channelId, &pts));
+        QCOMPARE(channelId, 2u);
+        QCOMPARE(scheduler.retry(2, now), i < CChannelDifferenceScheduler::maxRetries());
+    }
+    QCOMPARE(scheduler.pendingCount(), 0);
+    QCOMPARE(scheduler.activeCount(), 0);
+}
+
+QTEST_MAIN(tst_CChannelDifferenceScheduler)
+
+#include "tst_CChannelDifferenceScheduler.moc"
@@ -0,0 +1,4 @@
+include(../tests.pri)
+
+TARGET = tst_channeldifferencescheduler
+SOURCES = tst_CChannelDifferenceScheduler.cpp
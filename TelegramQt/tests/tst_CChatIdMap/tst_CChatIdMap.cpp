@@ -0,0 +1,119 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#include <QObject>
+
+#include "CChatIdMap.hpp"
+
+#include <QTest>
+#include <QDebug>
+
+class tst_CChatIdMap : public QObject
+{
+    Q_OBJECT
+public:
+    explicit tst_CChatIdMap(QObject *parent = nullptr);
+
+private slots:
+    void insert();
+    void growthKeepsPublicIds();
+    void setChatIds();
+
+};
+
+tst_CChatIdMap::tst_CChatIdMap(QObject *parent) :
+    QObject(parent)
+{
+}
+
+void tst_CChatIdMap::insert()
+{
+    CChatIdMap map;
+    QVERIFY(map.isEmpty());
+    QCOMPARE(map.publicId(100), -1);
+
+    int publicId = -1;
+    QVERIFY(map.insert(100, &publicId));
+    QCOMPARE(publicId, 0);
+    QVERIFY(map.insert(50, &publicId));
+    QCOMPARE(publicId, 1);
+    QVERIFY(!map.insert(100, &publicId)); // Known chat keeps its public id
+    QCOMPARE(publicId, 0);
+
+    QCOMPARE(map.count(), 2);
+    QVERIFY(map.contains(50));
+    QVERIFY(!map.contains(51));
+    QCOMPARE(map.publicId(50), 1);
+    QCOMPARE(map.chatId(0), quint32(100));
+    QCOMPARE(map.chatId(1), quint32(50));
+    QCOMPARE(map.chatId(2), quint32(0)); // Unknown public id
+    QCOMPARE(map.chatIds(), QVector<quint32>({ 100, 50 }));
+}
+
+void tst_CChatIdMap::growthKeepsPublicIds()
+{
+    // Many rehashes of the underlying table must not change the assigned public ids
+    CChatIdMap map;
+    const quint32 count = 20000;
+    for (quint32 i = 0; i < count; ++i) {
+        const quint32 chatId = 1000000 - i * 7;
+        int publicId = -1;
+        QVERIFY(map.insert(chatId, &publicId));
+        QCOMPARE(publicId, int(i));
+    }
+    QCOMPARE(map.count(), int(count));
+    for (quint32 i = 0; i < count; ++i) {
+        const quint32 chatId = 1000000 - i * 7;
+        QCOMPARE(map.publicId(chatId), int(i));
+        QCOMPARE(map.chatId(int(i)), chatId);
+    }
+}
+
+void tst_CChatIdMap::setChatIds()
+{
+    CChatIdMap map;
+    map.insert(1);
+
+    // The restored ids replace the map, the index is the public id
+    map.setChatIds({ 30, 10, 20 });
+    QCOMPARE(map.count(), 3);
+    QVERIFY(!map.contains(1));
+    QCOMPARE(map.publicId(30), 0);
+    QCOMPARE(map.publicId(10), 1);
+    QCOMPARE(map.publicId(20), 2);
+    QCOMPARE(map.chatIds(), QVector<quint32>({ 30, 10, 20 }));
+
+    // A duplicated id keeps its slot, so the next public ids are not shifted
+    map.setChatIds({ 30, 10, 20, 10, 50 });
+    QCOMPARE(map.count(), 5);
+    QCOMPARE(map.publicId(10), 1);
+    QCOMPARE(map.publicId(50), 4);
+    QCOMPARE(map.chatId(4), quint32(50));
+    QCOMPARE(map.chatIds(), QVector<quint32>({ 30, 10, 20, 10, 50 }));
+
+    int publicId = -1;
+    QVERIFY(map.insert(40, &publicId));
+    QCOMPARE(publicId, 5);
+
+    map.clear();
+    QVERIFY(map.isEmpty());
+    QCOMPARE(map.publicId(30), -1);
+}
+
+QTEST_APPLESS_MAIN(tst_CChatIdMap)
+
+#include "tst_CChatIdMap.moc"
@@ -0,0 +1,5 @@
+include(../tests.pri)
+
+TARGET = tst_chatidmap
+SOURCES = tst_CChatIdMap.cpp
+HEADERS += ../../CChatIdMap.hpp
@@ -0,0 +1,128 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#include <QObject>
+
+#include "CChatParticipants.hpp"
+
+#include <QTest>
+#include <QDebug>
+#include <algorithm>
+
+class tst_CChatParticipants : public QObject
+{
+    Q_OBJECT
+public:
+    explicit tst_CChatParticipants(QObject *parent = nullptr);
+
+private slots:
+    void addUserId();
+    void removeUserId();
+    void setUserIds();
+    void mixedChanges();
+
+};
+
+tst_CChatParticipants::tst_CChatParticipants(QObject *parent) :
+    QObject(parent)
+{
+}
+
+void tst_CChatParticipants::addUserId()
+{
+    CChatParticipants participants;
+    QVERIFY(participants.isEmpty());
+
+    QVERIFY(participants.addUserId(30));
+    QVERIFY(participants.addUserId(10));
+    QVERIFY(participants.addUserId(20));
+    QVERIFY(!participants.addUserId(10)); // Already known
+
+    QCOMPARE(participants.count(), 3);
+    QCOMPARE(participants.userIds(), QVector<quint32>({ 10, 20, 30 }));
+    QVERIFY(participants.contains(20));
+    QVERIFY(!participants.contains(40));
+}
+
+void tst_CChatParticipants::removeUserId()
+{
+    CChatParticipants participants;
+    participants.setUserIds({ 10, 20, 30 });
+
+    QVERIFY(participants.removeUserId(20));
+    QVERIFY(!participants.removeUserId(20)); // Already removed
+    QVERIFY(!participants.removeUserId(40)); // Never known
+
+    QCOMPARE(participants.count(), 2);
+    QCOMPARE(participants.userIds(), QVector<quint32>({ 10, 30 }));
+    QVERIFY(!participants.contains(20));
+
+    QVERIFY(participants.removeUserId(10));
+    QVERIFY(participants.removeUserId(30));
+    QVERIFY(participants.isEmpty());
+    QVERIFY(participants.userIds().isEmpty());
+}
+
+void tst_CChatParticipants::setUserIds()
+{
+    CChatParticipants participants;
+    participants.setUserIds({ 50, 10, 30, 10 }); // Unsorted, with a duplicate
+    QCOMPARE(participants.userIds(), QVector<quint32>({ 10, 30, 50 }));
+
+    // The full list replaces the previous one, including the membership answers
+    participants.setUserIds({ 20, 30 });
+    QCOMPARE(participants.count(), 2);
+    QCOMPARE(participants.userIds(), QVector<quint32>({ 20, 30 }));
+    QVERIFY(!participants.contains(10));
+    QVERIFY(!participants.contains(50));
+    QVERIFY(participants.contains(20));
+
+    QVERIFY(participants.addUserId(10));
+    QCOMPARE(participants.userIds(), QVector<quint32>({ 10, 20, 30 }));
+
+    participants.setUserIds({ });
+    QVERIFY(participants.isEmpty());
+    QVERIFY(!participants.contains(10));
+}
+
+void tst_CChatParticipants::mixedChanges()
+{
+    CChatParticipants participants;
+    QSet<quint32> reference;
+    quint32 seed = 1;
+    for (int i = 0; i < 10000; ++i) {
+        seed = seed * 1103515245 + 12345;
+        const quint32 userId = (seed >> 8) % 500 + 1;
+        if (seed & 1) {
+            QCOMPARE(participants.addUserId(userId), !reference.contains(userId));
+            reference.insert(userId);
+        } else {
+            QCOMPARE(participants.removeUserId(userId), reference.remove(userId));
+        }
+    }
+
+    QVector<quint32> expected = reference.toList().toVector();
+    std::sort(expected.begin(), expected.end());
+    QCOMPARE(participants.userIds(), expected);
+    for (quint32 userId = 1; userId <= 500; ++userId) {
+        QCOMPARE(participants.contains(userId), reference.contains(userId));
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_CChatParticipants)
+
+#include "tst_CChatParticipants.moc"
@@ -0,0 +1,4 @@
+include(../tests.pri)
+
+TARGET = tst_chatparticipants
+SOURCES = tst_CChatParticipants.cpp
@@ -0,0 +1,241 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#include <QObject>
+
+#include "CMessageHistoryCache.hpp"
+
+#include <QTest>
+#include <QDebug>
+
+typedef CMessageHistoryCache::Request Request;
+
+class tst_CMessageHistoryCache : public QObject
+{
+    Q_OBJECT
+public:
+    explicit tst_CMessageHistoryCache(QObject *parent = nullptr);
+
+private slots:
+    void servePages();
+    void fetchGaps();
+    void newMessages();
+    void deleteMessages();
+    void memoryLimit();
+    void historyEnd();
+
+};
+
+static TLMessage message(quint32 id)
+{
+    TLMessage result;
+    result.tlType = TLValue::Message;
+    result.id = id;
+    return result;
+}
+
+// Messages from..to (from is the newest) of a history with the given total count
+static TLMessagesMessages slice(quint32 from, quint32 to, quint32 totalCount)
+{
+    TLMessagesMessages result;
+    result.tlType = TLValue::MessagesMessagesSlice;
+    result.count = totalCount;
+    for (quint32 id = from; id >= to; --id) {
+        result.messages.append(message(id));
+    }
+    return result;
+}
+
+static Request request(quint32 offsetId, quint32 addOffset, quint32 limit)
+{
+    Request result;
+    result.offsetId = offsetId;
+    result.addOffset = addOffset;
+    result.limit = limit;
+    return result;
+}
+
+static QVector<quint32> ids(const QVector<TLMessage> &messages)
+{
+    QVector<quint32> result;
+    for (const TLMessage &message : messages) {
+        result.append(message.id);
+    }
+    return result;
+}
+
+static const Telegram::Peer c_peer = Telegram::Peer(5);
+
+tst_CMessageHistoryCache::tst_CMessageHistoryCache(QObject *parent) :
+    QObject(parent)
+{
+}
+
+void tst_CMessageHistoryCache::servePages()
+{
+    CMessageHistoryCache cache(1024 * 1024);
+    QVector<Request> missing;
+    QVERIFY(cache.messages(c_peer, 0, 20, &missing).isEmpty());
+    QCOMPARE(missing.count(), 1);
+    QCOMPARE(missing.first().offsetId, 0u); // The top of the history
+    QCOMPARE(missing.first().addOffset, 0u);
+    QCOMPARE(missing.first().limit, 20u);
+
+    cache.insertPage(c_peer, request(1001, 0, 20), slice(1000, 981, 1000));
+    QCOMPARE(cache.cachedCount(c_peer), 20);
+    QCOMPARE(cache.totalCount(c_peer), 1000);
+    QCOMPARE(cache.topMessageId(c_peer), 1000u);
+
+    missing.clear();
+    const QVector<TLMessage> messages = cache.messages(c_peer, 5, 10, &missing);
+    QVERIFY(missing.isEmpty());
+    QCOMPARE(messages.count(), 10);
+    QCOMPARE(messages.first().id, 995u);
+    QCOMPARE(messages.last().id, 986u);
+}
+
+void tst_CMessageHistoryCache::fetchGaps()
+{
+    CMessageHistoryCache cache(1024 * 1024);
+    cache.insertPage(c_peer, request(1001, 0, 20), slice(1000, 981, 1000));
+
+    QVector<Request> missing;
+    QCOMPARE(cache.messages(c_peer, 10, 20, &missing).count(), 10);
+    QCOMPARE(missing.count(), 1);
+    QCOMPARE(missing.first().offsetId, 981u);
+    QCOMPARE(missing.first().addOffset, 0u);
+    QCOMPARE(missing.first().limit, 10u);
+
+    // A distant page is placed after a gap of known size
+    missing.clear();
+    QVERIFY(cache.messages(c_peer, 100, 10, &missing).isEmpty());
+    QCOMPARE(missing.count(), 1);
+    QCOMPARE(missing.first().offsetId, 981u);
+    QCOMPARE(missing.first().addOffset, 80u);
+    cache.insertPage(c_peer, request(981, 80, 10), slice(900, 891, 1000));
+
+    missing.clear();
+    QCOMPARE(ids(cache.messages(c_peer, 95, 20, &missing)).first(), 900u);
+    QCOMPARE(missing.count(), 2);
+    QCOMPARE(missing.at(0).offsetId, 981u);
+    QCOMPARE(missing.at(0).addOffset, 75u);
+    QCOMPARE(missing.at(0).limit, 5u);
+    QCOMPARE(missing.at(1).offsetId, 891u);
+    QCOMPARE(missing.at(1).addOffset, 0u);
+    QCOMPARE(missing.at(1).limit, 5u);
+
+    // Filling the gap merges the runs
+    cache.insertPage(c_peer, request(981, 0, 80), slice(980, 901, 1000));
+    missing.clear();
+    QCOMPARE(cache.messages(c_peer, 0, 110, &missing).count(), 110);
+    QVERIFY(missing.isEmpty());
+}
+
+void tst_CMessageHistoryCache::newMessages()
+{
+    CMessageHistoryCache cache(1024 * 1024);
+    cache.insertPage(c_peer, request(1001, 0, 20), slice(1000, 981, 1000));
+    cache.insertPage(c_peer, request(981, 80, 10), slice(900, 891, 1000));
+
+    cache.addNewMessage(c_peer, message(1001));
+    QCOMPARE(cache.totalCount(c_peer), 1001);
+
+    QVector<Request> missing;
+    QCOMPARE(ids(cache.messages(c_peer, 0, 2, &missing)), QVector<quint32>({ 1001, 1000 }));
+    QCOMPARE(ids(cache.messages(c_peer, 101, 1, &missing)), QVector<quint32>({ 900 }));
+    QVERIFY(missing.isEmpty());
+
+    // A sent message leaves a gap at the top
+    cache.addUnknownMessage(c_peer, 1002);
+    QCOMPARE(ids(cache.messages(c_peer, 0, 2, &missing)), QVector<quint32>({ 1001 }));
+    QCOMPARE(missing.count(), 1);
+    QCOMPARE(missing.first().offsetId, 0u);
+    QCOMPARE(missing.first().limit, 1u);
+
+    // A page requested before the new messages arrived is placed by the message ids
+    cache.insertPage(c_peer, request(981, 0, 10), slice(980, 971, 1000));
+    missing.clear();
+    QCOMPARE(ids(cache.messages(c_peer, 22, 1, &missing)), QVector<quint32>({ 980 }));
+    QVERIFY(missing.isEmpty());
+}
+
+void tst_CMessageHistoryCache::deleteMessages()
+{
+    CMessageHistoryCache cache(1024 * 1024);
+    cache.insertPage(c_peer, request(1001, 0, 20), slice(1000, 981, 1000));
+    cache.insertPage(c_peer, request(981, 80, 10), slice(900, 891, 1000));
+
+    const Telegram::Peer channel = Telegram::Peer::fromChannelId(7);
+    cache.insertPage(channel, request(1001, 0, 20), slice(1000, 981, 1000));
+    cache.insertPage(channel, request(981, 80, 10), slice(900, 891, 1000));
+
+    // A cached message
+    cache.removeMessages(channel, { 999 });
+    QVector<Request> missing;
+    QCOMPARE(ids(cache.messages(channel, 0, 2, &missing)), QVector<quint32>({ 1000, 998 }));
+    QCOMPARE(ids(cache.messages(channel, 99, 1, &missing)), QVector<quint32>({ 900 }));
+
+    // A channel message in the gap shrinks the gap
+    cache.removeMessages(channel, { 950 });
+    QCOMPARE(ids(cache.messages(channel, 98, 1, &missing)), QVector<quint32>({ 900 }));
+    QVERIFY(missing.isEmpty());
+    QCOMPARE(cache.totalCount(channel), 998);
+
+    // A message in the gap can be of any user or chat, so the older runs are dropped
+    cache.removeMessages({ 950 });
+    QCOMPARE(cache.cachedCount(c_peer), 20);
+    QCOMPARE(cache.cachedCount(channel), 29);
+}
+
+void tst_CMessageHistoryCache::memoryLimit()
+{
+    CMessageHistoryCache cache(CMessageHistoryCache::messageSize(message(0)) * 10);
+    cache.insertPage(c_peer, request(1001, 0, 20), slice(1000, 981, 1000));
+    QCOMPARE(cache.cachedCount(c_peer), 10);
+
+    // The oldest messages are dropped
+    cache.addNewMessage(c_peer, message(1001));
+    QVector<Request> missing;
+    QCOMPARE(ids(cache.messages(c_peer, 0, 10, &missing)).first(), 1001u);
+    QCOMPARE(cache.messages(c_peer, 0, 20, &missing).count(), 10);
+    QCOMPARE(missing.count(), 1);
+    QCOMPARE(missing.first().offsetId, 992u);
+
+    cache.setMemoryLimit(0);
+    QCOMPARE(cache.cachedCount(c_peer), 0);
+    cache.insertPage(c_peer, request(1002, 0, 20), slice(1001, 982, 1000));
+    QCOMPARE(cache.cachedCount(c_peer), 0);
+}
+
+void tst_CMessageHistoryCache::historyEnd()
+{
+    CMessageHistoryCache cache(1024 * 1024);
+    TLMessagesMessages page = slice(5, 1, 0);
+    page.tlType = TLValue::MessagesMessages;
+    cache.insertPage(c_peer, request(6, 0, 20), page);
+    QCOMPARE(cache.totalCount(c_peer), 5);
+
+    QVector<Request> missing;
+    QCOMPARE(cache.messages(c_peer, 0, 20, &missing).count(), 5);
+    QVERIFY(missing.isEmpty());
+    QVERIFY(cache.messages(c_peer, 10, 20, &missing).isEmpty());
+    QVERIFY(missing.isEmpty());
+}
+
+QTEST_MAIN(tst_CMessageHistoryCache)
+
+#include "tst_CMessageHistoryCache.moc"
@@ -0,0 +1,4 @@
+include(../tests.pri)
+
+TARGET = tst_messagehistorycache
+SOURCES = tst_CMessageHistoryCache.cpp
@@ -0,0 +1,183 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#include <QObject>
+
+#include "CMessageSearchIndex.hpp"
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QDebug>
+
+class tst_CMessageSearchIndex : public QObject
+{
+    Q_OBJECT
+public:
+    explicit tst_CMessageSearchIndex(QObject *parent = nullptr);
+
+private slots:
+    void tokenize();
+    void wordSearch();
+    void prefixSearch();
+    void peerSearch();
+    void editAndRemove();
+    void persistence();
+
+};
+
+static Telegram::Message message(const Telegram::Peer &peer, quint32 id, const QString &text, quint32 timestamp = 0)
+{
+    Telegram::Message result;
+    result.setPeer(peer);
+    result.id = id;
+    result.text = text;
+    result.timestamp = timestamp ? timestamp : id;
+    return result;
+}
+
+static QVector<quint32> ids(const QVector<Telegram::Message> &messages)
+{
+    QVector<quint32> result;
+    for (const Telegram::Message &message : messages) {
+        result.append(message.id);
+    }
+    return result;
+}
+
+static const Telegram::Peer c_user = Telegram::Peer::fromUserId(10);
+static const Telegram::Peer c_chat = Telegram::Peer::fromChatId(1);
+static const Telegram::Peer c_channel = Telegram::Peer::fromChannelId(20);
+
+tst_CMessageSearchIndex::tst_CMessageSearchIndex(QObject *parent) :
+    QObject(parent)
+{
+}
+
+void tst_CMessageSearchIndex::tokenize()
+{
+    QCOMPARE(CMessageSearchIndex::tokenize(QStringLiteral("Hello, World! hello...")), QStringList({ QStringLiteral("hello"), QStringLiteral("world") }));
+    QCOMPARE(CMessageSearchIndex::tokenize(QStringLiteral("e-mail  2017")), QStringList({ QStringLiteral("e"), QStringLiteral("mail"), QStringLiteral("2017") }));
+    QCOMPARE(CMessageSearchIndex::tokenize(QString::fromUtf8("Привет, МИР")), QStringList({ QString::fromUtf8("привет"), QString::fromUtf8("мир") }));
+    QVERIFY(CMessageSearchIndex::tokenize(QStringLiteral(" ... ")).isEmpty());
+}
+
+void tst_CMessageSearchIndex::wordSearch()
+{
+    CMessageSearchIndex index;
+    index.addMessage(message(c_user, 1, QStringLiteral("The quick brown fox")));
+    index.addMessage(message(c_user, 2, QStringLiteral("A quick reply")));
+    index.addMessage(message(c_chat, 3, QStringLiteral("Brown bread")));
+    QCOMPARE(index.count(), 3);
+
+    QCOMPARE(ids(index.search(QStringLiteral("quick"))), QVector<quint32>({ 2, 1 })); // The newest first
+    QCOMPARE(ids(index.search(QStringLiteral("QUICK brown"))), QVector<quint32>({ 1 }));
+    QCOMPARE(ids(index.search(QStringLiteral("brown"))), QVector<quint32>({ 3, 1 }));
+    QVERIFY(index.search(QStringLiteral("qui")).isEmpty());
+    QVERIFY(index.search(QStringLiteral("quick bread")).isEmpty());
+    QCOMPARE(ids(index.search(QStringLiteral("quick"), Telegram::Peer(), /* limit */ 1)), QVector<quint32>({ 2 }));
+
+    const QVector<Telegram::Message> found = index.search(QStringLiteral("bread"));
+    QCOMPARE(found.count(), 1);
+    QCOMPARE(found.first().text, QStringLiteral("Brown bread"));
+    QVERIFY(found.first().peer() == c_chat);
+}
+
+void tst_CMessageSearchIndex::prefixSearch()
+{
+    CMessageSearchIndex index;
+    index.addMessage(message(c_user, 1, QStringLiteral("telegram")));
+    index.addMessage(message(c_user, 2, QStringLiteral("telephone and television")));
+    index.addMessage(message(c_user, 3, QStringLiteral("tea")));
+
+    QCOMPARE(ids(index.search(QStringLiteral("tele*"))), QVector<quint32>({ 2, 1 }));
+    QCOMPARE(ids(index.search(QStringLiteral("te*"))), QVector<quint32>({ 3, 2, 1 }));
+    QCOMPARE(ids(index.search(QStringLiteral("and tele*"))), QVector<quint32>({ 2 }));
+    QVERIFY(index.search(QStringLiteral("telex*")).isEmpty());
+}
+
+void tst_CMessageSearchIndex::peerSearch()
+{
+    CMessageSearchIndex index;
+    index.addMessage(message(c_user, 1, QStringLiteral("meeting at noon")));
+    index.addMessage(message(c_chat, 2, QStringLiteral("meeting is moved")));
+    index.addMessage(message(c_channel, 1, QStringLiteral("meeting notes")));
+
+    QCOMPARE(index.count(), 3); // The channel message ids do not clash with the common ones
+    QCOMPARE(index.search(QStringLiteral("meeting")).count(), 3);
+    QCOMPARE(ids(index.search(QStringLiteral("meeting"), c_chat)), QVector<quint32>({ 2 }));
+    QCOMPARE(index.search(QStringLiteral("meeting"), c_channel).first().text, QStringLiteral("meeting notes"));
+}
+
+void tst_CMessageSearchIndex::editAndRemove()
+{
+    CMessageSearchIndex index;
+    index.addMessage(message(c_user, 1, QStringLiteral("first draft")));
+    index.addMessage(message(c_user, 1, QStringLiteral("final version")));
+    QCOMPARE(index.count(), 1);
+    QVERIFY(index.search(QStringLiteral("draft")).isEmpty());
+    QCOMPARE(ids(index.search(QStringLiteral("final"))), QVector<quint32>({ 1 }));
+
+    index.addMessage(message(c_channel, 1, QStringLiteral("final notes")));
+    index.removeMessages({ 1 });
+    QCOMPARE(ids(index.search(QStringLiteral("final"))), QVector<quint32>({ 1 }));
+    QVERIFY(index.contains(c_channel, 1));
+
+    index.removeMessages(c_channel, { 1 });
+    QCOMPARE(index.count(), 0);
+    QVERIFY(index.search(QStringLiteral("final")).isEmpty());
+}
+
+void tst_CMessageSearchIndex::persistence()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.path() + QStringLiteral("/index");
+
+    {
+        CMessageSearchIndex index(fileName);
+        QVERIFY(!index.load());
+        index.addMessage(message(c_user, 1, QStringLiteral("keep this")));
+        index.addMessage(message(c_user, 2, QStringLiteral("drop this")));
+        index.addMessage(message(c_channel, 1, QString::fromUtf8("сохранить это")));
+        index.sync();
+        index.removeMessages({ 2 });
+        index.addMessage(message(c_user, 1, QStringLiteral("keep this edited")));
+    } // The destructor writes the pending records
+
+    CMessageSearchIndex index(fileName);
+    QVERIFY(index.load());
+    QCOMPARE(index.count(), 2);
+    QCOMPARE(index.search(QStringLiteral("this")).first().text, QStringLiteral("keep this edited"));
+    QVERIFY(index.search(QStringLiteral("drop")).isEmpty());
+    QCOMPARE(ids(index.search(QString::fromUtf8("сохр*"), c_channel)), QVector<quint32>({ 1 }));
+
+    // A truncated record is dropped
+    index.addMessage(message(c_chat, 5, QStringLiteral("partial record")));
+    index.sync();
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.resize(file.size() - 3));
+    file.close();
+    QVERIFY(index.load());
+    QCOMPARE(index.count(), 2);
+    QVERIFY(index.search(QStringLiteral("partial")).isEmpty());
+}
+
+QTEST_MAIN(tst_CMessageSearchIndex)
+
+#include "tst_CMessageSearchIndex.moc"
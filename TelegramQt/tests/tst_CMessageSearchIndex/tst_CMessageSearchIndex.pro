@@ -0,0 +1,4 @@
+include(../tests.pri)
+
+TARGET = tst_messagesearchindex
+SOURCES = tst_CMessageSearchIndex.cpp
@@ -0,0 +1,348 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#include <QObject>
+
+#include "CPeerTable.hpp"
+#include "CTelegramDispatcher.hpp"
+
+#include <QHash>
+#include <QTest>
+#include <QDebug>
+
+static const int c_benchmarkPeersCount = 100000;
+
+class tst_CPeerTable : public QObject
+{
+    Q_OBJECT
+public:
+    explicit tst_CPeerTable(QObject *parent = nullptr);
+
+private slots:
+    void peerTypes();
+    void findOrInsert();
+    void removeKeepsProbeSequences();
+    void removeInProbeChain();
+    void removeWrappedAround();
+    void growth();
+    void iteration();
+    void peerHash();
+    void lookupBenchmark_data();
+    void lookupBenchmark();
+    void insertBenchmark_data();
+    void insertBenchmark();
+
+protected:
+    static QVector<Telegram::Peer> benchmarkPeers();
+    static int homeBucket(quint32 id, int capacity);
+    static QVector<quint32> idsWithHomeBucket(int bucket, int capacity, int count, quint32 firstId = 1);
+
+};
+
+tst_CPeerTable::tst_CPeerTable(QObject *parent) :
+    QObject(parent)
+{
+}
+
+QVector<Telegram::Peer> tst_CPeerTable::benchmarkPeers()
+{
+    // Dense ids of all types, as the server assigns them
+    QVector<Telegram::Peer> peers;
+    peers.reserve(c_benchmarkPeersCount);
+    for (int i = 0; i < c_benchmarkPeersCount; ++i) {
+        peers.append(Telegram::Peer(1000 + i / 3, static_cast<Telegram::Peer::Type>(i % 3)));
+    }
+    return peers;
+}
+
+// The same Fibonacci hashing as CPeerTable uses, to build the collisions on purpose
+int tst_CPeerTable::homeBucket(quint32 id, int capacity)
+{
+    const quint64 hash = quint64(id) * Q_UINT64_C(0x9E3779B97F4A7C15);
+    return int(hash >> 32) & (capacity - 1);
+}
+
+QVector<quint32> tst_CPeerTable::idsWithHomeBucket(int bucket, int capacity, int count, quint32 firstId)
+{
+    QVector<quint32> ids;
+    for (quint32 id = firstId; ids.count() < count; ++id) {
+        if (homeBucket(id, capacity) == bucket) {
+            ids.append(id);
+        }
+    }
+    return ids;
+}
+
+void tst_CPeerTable::peerTypes()
+{
+    CPeerTable<Telegram::Peer, int> table;
+    table.insert(Telegram::Peer(10, Telegram::Peer::User), 1);
+    table.insert(Telegram::Peer(10, Telegram::Peer::Chat), 2);
+    table.insert(Telegram::Peer(10, Telegram::Peer::Channel), 3);
+
+    QCOMPARE(table.count(), 3);
+    QCOMPARE(table.value(Telegram::Peer(10, Telegram::Peer::User)), 1);
+    QCOMPARE(table.value(Telegram::Peer(10, Telegram::Peer::Chat)), 2);
+    QCOMPARE(table.value(Telegram::Peer(10, Telegram::Peer::Channel)), 3);
+    QVERIFY(!table.contains(Telegram::Peer(11, Telegram::Peer::User)));
+    QCOMPARE(table.value(Telegram::Peer(11, Telegram::Peer::User), -1), -1);
+}
+
+void tst_CPeerTable::findOrInsert()
+{
+    CPeerTable<quint32, int> table;
+    QVERIFY(!table.find(5));
+
+    bool inserted = false;
+    table.findOrInsert(5, &inserted) = 50;
+    QVERIFY(inserted);
+    int &value = table.findOrInsert(5, &inserted);
+    QVERIFY(!inserted);
+    QCOMPARE(value, 50);
+    ++value;
+
+    QVERIFY(table.find(5));
+    QCOMPARE(*table.find(5), 51);
+    QCOMPARE(table.count(), 1);
+}
+
+void tst_CPeerTable::removeKeepsProbeSequences()
+{
+    CPeerTable<quint32, quint32> table;
+    QHash<quint32, quint32> reference;
+    quint32 seed = 1;
+    for (int i = 0; i < 100000; ++i) {
+        seed = seed * 1103515245 + 12345;
+        const quint32 key = (seed >> 8) % 2000 + 1;
+        if (seed & 1) {
+            table.insert(key, quint32(i));
+            reference.insert(key, quint32(i));
+        } else {
+            QCOMPARE(table.remove(key), reference.remove(key) > 0);
+        }
+    }
+
+    QCOMPARE(table.count(), reference.count());
+    for (quint32 key = 1; key <= 2000; ++key) {
+        QCOMPARE(table.contains(key), reference.contains(key));
+        QCOMPARE(table.value(key), reference.value(key));
+    }
+}
+
+void tst_CPeerTable::removeInProbeChain()
+{
+    // The minimal table has 16 buckets. Three ids with the home bucket 5 take 5, 6 and 7,
+    // an id with the home bucket 6 is pushed to 8.
+    const QVector<quint32> sameHome = idsWithHomeBucket(5, 16, 3);
+    const quint32 nextHome = idsWithHomeBucket(6, 16, 1).first();
+
+    CPeerTable<quint32, quint32> table;
+    for (quint32 id : sameHome) {
+        table.insert(id, id * 10);
+    }
+    table.insert(nextHome, nextHome * 10);
+    QCOMPARE(table.count(), 4);
+
+    // Removal from the middle of the chain must shift the rest back, not cut the chain
+    QVERIFY(table.remove(sameHome.at(1)));
+    QCOMPARE(table.count(), 3);
+    QVERIFY(!table.contains(sameHome.at(1)));
+    QCOMPARE(table.value(sameHome.at(0)), sameHome.at(0) * 10);
+    QCOMPARE(table.value(sameHome.at(2)), sameHome.at(2) * 10);
+    QCOMPARE(table.value(nextHome), nextHome * 10);
+
+    // The head of the chain
+    QVERIFY(table.remove(sameHome.at(0)));
+    QCOMPARE(table.value(sameHome.at(2)), sameHome.at(2) * 10);
+    QCOMPARE(table.value(nextHome), nextHome * 10);
+
+    // The freed buckets are reused
+    table.insert(sameHome.at(1), 1);
+    QCOMPARE(table.value(sameHome.at(1)), quint32(1));
+    QCOMPARE(table.count(), 3);
+}
+
+void tst_CPeerTable::removeWrappedAround()
+{
+    // Three ids with the home bucket 15 (the last one) take 15, 0 and 1,
+    // an id with the home bucket 0 is pushed to 2 and an id with the home bucket 1 to 3.
+    const QVector<quint32> lastHome = idsWithHomeBucket(15, 16, 3);
+    const quint32 firstHome = idsWithHomeBucket(0, 16, 1).first();
+    const quint32 secondHome = idsWithHomeBucket(1, 16, 1).first();
+
+    CPeerTable<quint32, quint32> table;
+    for (quint32 id : lastHome) {
+        table.insert(id, id);
+    }
+    table.insert(firstHome, firstHome);
+    table.insert(secondHome, secondHome);
+
+    // The removed entry is in bucket 15, the shifted ones are behind the end of the buckets
+    QVERIFY(table.remove(lastHome.at(0)));
+    QVERIFY(!table.contains(lastHome.at(0)));
+    QCOMPARE(table.value(lastHome.at(1)), lastHome.at(1));
+    QCOMPARE(table.value(lastHome.at(2)), lastHome.at(2));
+    QCOMPARE(table.value(firstHome), firstHome);
+    QCOMPARE(table.value(secondHome), secondHome);
+
+    // The removed entry is in bucket 0 (the wrapped part of the chain)
+    QVERIFY(table.remove(lastHome.at(2)));
+    QCOMPARE(table.value(lastHome.at(1)), lastHome.at(1));
+    QCOMPARE(table.value(firstHome), firstHome);
+    QCOMPARE(table.value(secondHome), secondHome);
+    QCOMPARE(table.count(), 3);
+
+    int count = 0;
+    for (auto it = table.constBegin(); it != table.constEnd(); ++it) {
+        QCOMPARE(it.key(), it.value());
+        ++count;
+    }
+    QCOMPARE(count, 3);
+}
+
+void tst_CPeerTable::growth()
+{
+    CPeerTable<quint32, quint32> table;
+    for (quint32 id = 1; id <= 10000; ++id) {
+        table.insert(id, id + 1);
+        // The entries inserted before a rehash are still there
+        if ((id & (id - 1)) == 0) {
+            for (quint32 known = 1; known <= id; ++known) {
+                QCOMPARE(table.value(known), known + 1);
+            }
+        }
+    }
+    QCOMPARE(table.count(), 10000);
+    for (quint32 id = 1; id <= 10000; ++id) {
+        QCOMPARE(table.value(id), id + 1);
+    }
+    QVERIFY(!table.contains(10001));
+
+    // reserve() of a smaller size does not shrink the table
+    table.reserve(10);
+    QCOMPARE(table.count(), 10000);
+    QCOMPARE(table.value(5000), quint32(5001));
+
+    CPeerTable<quint32, quint32> reserved;
+    reserved.reserve(1000);
+    for (quint32 id = 1; id <= 1000; ++id) {
+        reserved.insert(id, id);
+    }
+    QCOMPARE(reserved.count(), 1000);
+    QCOMPARE(reserved.value(999), quint32(999));
+}
+
+void tst_CPeerTable::iteration()
+{
+    CPeerTable<Telegram::Peer, quint32> table;
+    const QVector<Telegram::Peer> peers = benchmarkPeers().mid(0, 1000);
+    for (const Telegram::Peer &peer : peers) {
+        table.insert(peer, peer.id);
+    }
+
+    int count = 0;
+    for (auto it = table.constBegin(); it != table.constEnd(); ++it) {
+        QCOMPARE(it.key().id, it.value());
+        ++count;
+    }
+    QCOMPARE(count, peers.count());
+    QCOMPARE(table.keys().count(), peers.count());
+}
+
+void tst_CPeerTable::peerHash()
+{
+    const Telegram::Peer user(10, Telegram::Peer::User);
+    const Telegram::Peer chat(10, Telegram::Peer::Chat);
+    const Telegram::Peer channel(10, Telegram::Peer::Channel);
+    QVERIFY(Telegram::qHash(user, 0) != Telegram::qHash(chat, 0));
+    QVERIFY(Telegram::qHash(chat, 0) != Telegram::qHash(channel, 0));
+}
+
+void tst_CPeerTable::lookupBenchmark_data()
+{
+    QTest::addColumn<bool>("peerTable");
+    QTest::newRow("QHash") << false;
+    QTest::newRow("CPeerTable") << true;
+}
+
+void tst_CPeerTable::lookupBenchmark()
+{
+    QFETCH(bool, peerTable);
+    const QVector<Telegram::Peer> peers = benchmarkPeers();
+
+    CPeerTable<Telegram::Peer, quint32> table;
+    QHash<Telegram::Peer, quint32> hash;
+    for (const Telegram::Peer &peer : peers) {
+        table.insert(peer, peer.id);
+        hash.insert(peer, peer.id);
+    }
+
+    quint64 sum = 0;
+    if (peerTable) {
+        QBENCHMARK {
+            for (const Telegram::Peer &peer : peers) {
+                if (const quint32 *value = table.find(peer)) {
+                    sum += *value;
+                }
+            }
+        }
+    } else {
+        QBENCHMARK {
+            for (const Telegram::Peer &peer : peers) {
+                if (hash.contains(peer)) {
+                    sum += hash.value(peer);
+                }
+            }
+        }
+    }
+    QVERIFY(sum > 0);
+}
+
+void tst_CPeerTable::insertBenchmark_data()
+{
+    lookupBenchmark_data();
+}
+
+void tst_CPeerTable::insertBenchmark()
+{
+    QFETCH(bool, peerTable);
+    const QVector<Telegram::Peer> peers = benchmarkPeers();
+
+    int count = 0;
+    if (peerTable) {
+        QBENCHMARK {
+            CPeerTable<Telegram::Peer, quint32> table;
+            for (const Telegram::Peer &peer : peers) {
+                table.findOrInsert(peer) = peer.id;
+            }
+            count = table.count();
+        }
+    } else {
+        QBENCHMARK {
+            QHash<Telegram::Peer, quint32> hash;
+            for (const Telegram::Peer &peer : peers) {
+                hash.insert(peer, peer.id);
+            }
+            count = hash.count();
+        }
+    }
+    QCOMPARE(count, c_benchmarkPeersCount);
+}
+
+QTEST_APPLESS_MAIN(tst_CPeerTable)
+
+#include "tst_CPeerTable.moc"
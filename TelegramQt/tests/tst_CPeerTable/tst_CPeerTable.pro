@@ -0,0 +1,5 @@
+include(../tests.pri)
+
+TARGET = tst_peertable
+SOURCES = tst_CPeerTable.cpp
+HEADERS += ../../CPeerTable.hpp
@@ -0,0 +1,201 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#include <QObject>
+
+#include "CRequestRateLimiter.hpp"
+
+#include <QTest>
+#include <QDebug>
+
+class tst_CRequestRateLimiter : public QObject
+{
+    Q_OBJECT
+public:
+    explicit tst_CRequestRateLimiter(QObject *parent = nullptr);
+
+private slots:
+    void requestClasses();
+    void unlimitedByDefault();
+    void burstAndRate();
+    void queueOrder();
+    void floodWaitPausesOneClass();
+    void stats();
+
+protected:
+    static CRequestRateLimiter::Request request(quint64 id, qint64 time);
+
+};
+
+tst_CRequestRateLimiter::tst_CRequestRateLimiter(QObject *parent) :
+    QObject(parent)
+{
+}
+
+CRequestRateLimiter::Request tst_CRequestRateLimiter::request(quint64 id, qint64 time)
+{
+    CRequestRateLimiter::Request result;
+    result.requestId = id;
+    result.queueTime = time;
+    return result;
+}
+
+void tst_CRequestRateLimiter::requestClasses()
+{
+    QCOMPARE(CRequestRateLimiter::requestClass(TLValue::MessagesSendMessage), TelegramNamespace::RequestClassMessages);
+    QCOMPARE(CRequestRateLimiter::requestClass(TLValue::ContactsImportContacts), TelegramNamespace::RequestClassContacts);
+    QCOMPARE(CRequestRateLimiter::requestClass(TLValue::UploadGetFile), TelegramNamespace::RequestClassFiles);
+    QCOMPARE(CRequestRateLimiter::requestClass(TLValue::MessagesGetHistory), TelegramNamespace::RequestClassHistory);
+    QCOMPARE(CRequestRateLimiter::requestClass(TLValue::UpdatesGetDifference), TelegramNamespace::RequestClassInteractive);
+    QCOMPARE(CRequestRateLimiter::requestClass(TLValue::MessagesSetTyping), TelegramNamespace::RequestClassInteractive);
+}
+
+void tst_CRequestRateLimiter::unlimitedByDefault()
+{
+    CRequestRateLimiter limiter;
+    for (int i = 0; i < CRequestRateLimiter::RequestClassesCount; ++i) {
+        const CRequestRateLimiter::RequestClass requestClass = static_cast<CRequestRateLimiter::RequestClass>(i);
+        QCOMPARE(limiter.rate(requestClass), 0);
+        for (int j = 0; j < 100; ++j) {
+            QVERIFY(limiter.tryAcquire(requestClass, 0));
+        }
+    }
+    QCOMPARE(limiter.nextReadyTime(0), qint64(-1));
+
+    // A flood wait pauses the class, then the queued requests go at once
+    limiter.floodWait(TelegramNamespace::RequestClassMessages, 2, 0);
+    QVERIFY(!limiter.tryAcquire(TelegramNamespace::RequestClassMessages, 1000));
+    limiter.enqueue(TelegramNamespace::RequestClassMessages, request(1, 1000));
+    limiter.enqueue(TelegramNamespace::RequestClassMessages, request(2, 1000));
+    QCOMPARE(limiter.nextReadyTime(1000), qint64(2000));
+
+    CRequestRateLimiter::Request next;
+    QVERIFY(!limiter.takeNext(1999, &next));
+    QVERIFY(limiter.takeNext(2000, &next));
+    QCOMPARE(next.requestId, quint64(1));
+    QVERIFY(limiter.takeNext(2000, &next));
+    QCOMPARE(next.requestId, quint64(2));
+}
+
+void tst_CRequestRateLimiter::burstAndRate()
+{
+    CRequestRateLimiter limiter;
+    limiter.setRate(TelegramNamespace::RequestClassMessages, /* per minute */ 60, /* burst */ 3);
+
+    for (int i = 0; i < 3; ++i) {
+        QVERIFY(limiter.tryAcquire(TelegramNamespace::RequestClassMessages, 0));
+    }
+    QVERIFY(!limiter.tryAcquire(TelegramNamespace::RequestClassMessages, 0));
+    QVERIFY(!limiter.tryAcquire(TelegramNamespace::RequestClassMessages, 999));
+    QVERIFY(limiter.tryAcquire(TelegramNamespace::RequestClassMessages, 1000)); // One token per second
+    QVERIFY(!limiter.tryAcquire(TelegramNamespace::RequestClassMessages, 1500));
+
+    // The burst is not exceeded after a long idle time
+    for (int i = 0; i < 3; ++i) {
+        QVERIFY(limiter.tryAcquire(TelegramNamespace::RequestClassMessages, 100000));
+    }
+    QVERIFY(!limiter.tryAcquire(TelegramNamespace::RequestClassMessages, 100000));
+
+    // The interactive requests are not limited
+    for (int i = 0; i < 1000; ++i) {
+        QVERIFY(limiter.tryAcquire(TelegramNamespace::RequestClassInteractive, 0));
+    }
+}
+
+void tst_CRequestRateLimiter::queueOrder()
+{
+    CRequestRateLimiter limiter;
+    limiter.setRate(TelegramNamespace::RequestClassMessages, 60, 1);
+
+    QVERIFY(limiter.tryAcquire(TelegramNamespace::RequestClassMessages, 0));
+    limiter.enqueue(TelegramNamespace::RequestClassMessages, request(1, 0));
+    limiter.enqueue(TelegramNamespace::RequestClassMessages, request(2, 0));
+    QCOMPARE(limiter.queueDepth(TelegramNamespace::RequestClassMessages), 2);
+    QCOMPARE(limiter.nextReadyTime(0), qint64(1000));
+
+    // A new request does not overtake the queued ones
+    QVERIFY(!limiter.tryAcquire(TelegramNamespace::RequestClassMessages, 5000));
+
+    CRequestRateLimiter::Request next;
+    QVERIFY(limiter.takeNext(5000, &next));
+    QCOMPARE(next.requestId, quint64(1));
+    QVERIFY(!limiter.takeNext(5000, &next)); // The burst is 1
+    QCOMPARE(limiter.nextReadyTime(5000), qint64(6000));
+    QVERIFY(limiter.takeNext(6000, &next));
+    QCOMPARE(next.requestId, quint64(2));
+    QVERIFY(!limiter.takeNext(100000, &next));
+    QCOMPARE(limiter.nextReadyTime(100000), qint64(-1));
+}
+
+void tst_CRequestRateLimiter::floodWaitPausesOneClass()
+{
+    CRequestRateLimiter limiter;
+    limiter.setRate(TelegramNamespace::RequestClassMessages, 30, 5);
+    limiter.floodWait(TelegramNamespace::RequestClassMessages, 30, 1000);
+    QCOMPARE(limiter.pausedUntil(TelegramNamespace::RequestClassMessages), qint64(31000));
+
+    QVERIFY(!limiter.tryAcquire(TelegramNamespace::RequestClassMessages, 2000));
+    QVERIFY(limiter.tryAcquire(TelegramNamespace::RequestClassInteractive, 2000));
+    QVERIFY(limiter.tryAcquire(TelegramNamespace::RequestClassHistory, 2000));
+
+    limiter.enqueue(TelegramNamespace::RequestClassMessages, request(1, 2000));
+    limiter.enqueue(TelegramNamespace::RequestClassMessages, request(2, 2000));
+    limiter.enqueue(TelegramNamespace::RequestClassMessages, request(3, 2000), /* front */ true);
+    QCOMPARE(limiter.nextReadyTime(2000), qint64(31000));
+
+    CRequestRateLimiter::Request next;
+    QVERIFY(!limiter.takeNext(30999, &next));
+    QVERIFY(limiter.takeNext(31000, &next));
+    QCOMPARE(next.requestId, quint64(3));
+    // A single request is sent at the end of the pause, then the rate applies
+    QVERIFY(!limiter.takeNext(31000, &next));
+
+    const QVector<CRequestRateLimiter::Request> queued = limiter.takeQueued(TelegramNamespace::RequestClassMessages);
+    QCOMPARE(queued.count(), 2);
+    QCOMPARE(queued.first().requestId, quint64(1));
+    QCOMPARE(limiter.queueDepth(TelegramNamespace::RequestClassMessages), 0);
+}
+
+void tst_CRequestRateLimiter::stats()
+{
+    CRequestRateLimiter limiter;
+    limiter.setRate(TelegramNamespace::RequestClassContacts, 60, 1);
+    QVERIFY(limiter.tryAcquire(TelegramNamespace::RequestClassContacts, 0));
+    limiter.enqueue(TelegramNamespace::RequestClassContacts, request(1, 0));
+    limiter.enqueue(TelegramNamespace::RequestClassContacts, request(2, 500));
+
+    Telegram::RequestQueueStats stats = limiter.stats(TelegramNamespace::RequestClassContacts, 800);
+    QCOMPARE(stats.queueDepth, 2);
+    QCOMPARE(stats.oldestWaitTime, qint64(800));
+    QCOMPARE(stats.delayedCount, 0u);
+
+    CRequestRateLimiter::Request next;
+    QVERIFY(limiter.takeNext(1000, &next));
+    QVERIFY(limiter.takeNext(2000, &next));
+    limiter.floodWait(TelegramNamespace::RequestClassContacts, 10, 2000);
+
+    stats = limiter.stats(TelegramNamespace::RequestClassContacts, 2000);
+    QCOMPARE(stats.queueDepth, 0);
+    QCOMPARE(stats.delayedCount, 2u);
+    QCOMPARE(stats.averageWaitTime, qint64(1250)); // (1000 + 1500) / 2
+    QCOMPARE(stats.maxWaitTime, qint64(1500));
+    QCOMPARE(stats.floodWaitRemaining, qint64(10000));
+}
+
+QTEST_MAIN(tst_CRequestRateLimiter)
+
+#include "tst_CRequestRateLimiter.moc"
@@ -0,0 +1,4 @@
+include(../tests.pri)
+
+TARGET = tst_requestratelimiter
+SOURCES = tst_CRequestRateLimiter.cpp
@@ -0,0 +1,149 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#include <QObject>
+
+#include "CRttEstimator.hpp"
+
+#include <QTest>
+#include <QDebug>
+
+class tst_CRttEstimator : public QObject
+{
+    Q_OBJECT
+public:
+    explicit tst_CRttEstimator(QObject *parent = nullptr);
+
+private slots:
+    void smoothing();
+    void timeout();
+    void intervalGrowsOnStableLink();
+    void intervalShrinksOnJitter();
+    void lostPings();
+
+};
+
+tst_CRttEstimator::tst_CRttEstimator(QObject *parent) :
+    QObject(parent)
+{
+}
+
+void tst_CRttEstimator::smoothing()
+{
+    CRttEstimator estimator;
+    QCOMPARE(estimator.samplesCount(), 0);
+    QCOMPARE(estimator.smoothedRtt(), qint64(0));
+
+    estimator.addSample(100);
+    QCOMPARE(estimator.smoothedRtt(), qint64(100));
+    QCOMPARE(estimator.rttVariation(), qint64(50));
+
+    estimator.addSample(200);
+    QCOMPARE(estimator.smoothedRtt(), qint64(112));
+    QCOMPARE(estimator.rttVariation(), qint64(62));
+
+    estimator.addSample(60);
+    QCOMPARE(estimator.minRtt(), qint64(60));
+    QCOMPARE(estimator.samplesCount(), 3);
+
+    estimator.reset();
+    QCOMPARE(estimator.samplesCount(), 0);
+    QCOMPARE(estimator.smoothedRtt(), qint64(0));
+}
+
+void tst_CRttEstimator::timeout()
+{
+    CRttEstimator estimator;
+    QCOMPARE(estimator.timeout(), qint64(10000)); // No samples yet
+
+    estimator.addSample(100);
+    QCOMPARE(estimator.timeout(), qint64(2000)); // The minimal timeout
+
+    estimator.reset();
+    estimator.addSample(5000);
+    QCOMPARE(estimator.timeout(), qint64(15000)); // 5000 + 4 * 2500
+
+    estimator.addSample(60000);
+    QCOMPARE(estimator.timeout(), qint64(30000)); // The maximal timeout
+}
+
+void tst_CRttEstimator::intervalGrowsOnStableLink()
+{
+    CRttEstimator estimator;
+    estimator.setBaseInterval(15000);
+    QCOMPARE(estimator.pingInterval(), qint64(15000));
+
+    for (int i = 0; i < 2; ++i) {
+        estimator.pingAnswered(100);
+    }
+    QCOMPARE(estimator.pingInterval(), qint64(15000));
+    estimator.pingAnswered(100);
+    QCOMPARE(estimator.pingInterval(), qint64(22500));
+
+    for (int i = 0; i < 9; ++i) {
+        estimator.pingAnswered(100);
+    }
+    QCOMPARE(estimator.pingInterval(), qint64(30000)); // Up to twice of the base interval
+
+    estimator.setBaseInterval(10000);
+    QCOMPARE(estimator.pingInterval(), qint64(10000));
+}
+
+void tst_CRttEstimator::intervalShrinksOnJitter()
+{
+    CRttEstimator estimator;
+    estimator.setBaseInterval(15000);
+    for (int i = 0; i < 6; ++i) {
+        estimator.pingAnswered(100);
+    }
+    QCOMPARE(estimator.pingInterval(), qint64(30000));
+
+    estimator.pingAnswered(150); // Within the usual variation
+    QCOMPARE(estimator.pingInterval(), qint64(30000));
+
+    estimator.pingAnswered(1000);
+    QCOMPARE(estimator.pingInterval(), qint64(15000));
+    estimator.pingAnswered(3000);
+    QCOMPARE(estimator.pingInterval(), qint64(7500));
+    estimator.pingAnswered(20000);
+    QCOMPARE(estimator.pingInterval(), qint64(5000)); // The minimal interval
+}
+
+void tst_CRttEstimator::lostPings()
+{
+    CRttEstimator estimator;
+    estimator.setBaseInterval(15000);
+    estimator.pingAnswered(100);
+
+    estimator.pingLost();
+    QCOMPARE(estimator.lostPingsCount(), 1);
+    QCOMPARE(estimator.pingInterval(), qint64(5000));
+    estimator.pingLost();
+    QCOMPARE(estimator.lostPingsCount(), 2);
+
+    estimator.pingAnswered(100);
+    QCOMPARE(estimator.lostPingsCount(), 0);
+
+    // The minimal interval is not longer than the base one
+    estimator.setBaseInterval(3000);
+    estimator.pingLost();
+    QCOMPARE(estimator.pingInterval(), qint64(3000));
+}
+
+QTEST_MAIN(tst_CRttEstimator)
+
+#include "tst_CRttEstimator.moc"
@@ -0,0 +1,4 @@
+include(../tests.pri)
+
+TARGET = tst_rttestimator
+SOURCES = tst_CRttEstimator.cpp
@@ -17,6 +17,8 @@
 
 #include "CTestConnection.hpp"
 #include "CClientTcpTransport.hpp"
+#include "CTelegramStream.hpp"
+#include "Utils.hpp"
 
 CTestConnection::CTestConnection(QObject *parent) :
     CTelegramConnection(0, parent)
@@ -68,3 +70,44 @@ quint64 CTestConnection::testNewMessageId()
 {
     return newMessageId();
 }
+
+SAesKey CTestConnection::testGenerateAesKey(const QByteArray &authKey, const QByteArray &messageKey, int xValue)
+{
+    return generateAesKey(authKey, messageKey, xValue);
+}
+
+void CTestConnection::testBindTemporaryKey(const QByteArray &temporaryKey, const QByteArray &permanentKey, quint32 expiresAt)
+{
+    setTemporaryKey(temporaryKey, /* salt */ 1, expiresAt, permanentKey);
+    Utils::randomBytes(&m_sessionId);
+    m_contentRelatedMessages = 1; // The connection is initialized already (there is no app information to send)
+    bindTemporaryKey();
+}
+
+void CTestConnection::testProcessBadServerSalt(quint64 badMessageId, quint64 newServerSalt)
+{
+    // The new salt is taken from the header of the received package
+    m_receivedServerSalt = newServerSalt;
+
+    QByteArray data;
+    CTelegramStream outputStream(&data, /* write */ true);
+    outputStream << badMessageId;
+    outputStream << quint32(1); // Sequence number
+    outputStream << quint32(48); // Incorrect server salt
+    outputStream << newServerSalt;
+
+    CTelegramStream inputStream(data);
+    processIgnoredMessageNotification(inputStream);
+}
+
+void CTestConnection::testProcessRpcError(quint64 id, quint32 errorCode, const QString &errorMessage)
+{
+    QByteArray data;
+    CTelegramStream outputStream(&data, /* write */ true);
+    outputStream << errorCode;
+    outputStream << errorMessage;
+
+    CTelegramStream inputStream(data);
+    processRpcError(inputStream, id, TLValue::firstFromArray(m_submittedPackages.value(id)));
+}
+
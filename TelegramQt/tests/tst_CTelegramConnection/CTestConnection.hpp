@@ -37,8 +37,17 @@ public:
     void setB(const QByteArray &newB);
 
     SAesKey testGenerateClientToServerAesKey(const QByteArray &messageKey) const;
+    static SAesKey testGenerateAesKey(const QByteArray &authKey, const QByteArray &messageKey, int xValue);
     quint64 testNewMessageId();
 
+    void testBindTemporaryKey(const QByteArray &temporaryKey, const QByteArray &permanentKey, quint32 expiresAt);
+    quint64 testTemporaryKeyBindingId() const { return m_temporaryKeyBindingId; }
+    QList<quint64> testSubmittedPackageIds() const { return m_submittedPackages.keys(); }
+    QByteArray testSubmittedPackage(quint64 id) const { return m_submittedPackages.value(id); }
+    quint64 testPendingRequestId(quint64 id) const { return m_pendingRequests.value(id).requestId; }
+    void testProcessBadServerSalt(quint64 badMessageId, quint64 newServerSalt);
+    void testProcessRpcError(quint64 id, quint32 errorCode, const QString &errorMessage);
+
 };
 
 #endif // CTESTCONNECTION_HPP
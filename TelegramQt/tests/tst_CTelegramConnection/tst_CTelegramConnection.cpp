@@ -18,10 +18,15 @@
 #include <QObject>
 
 #include "CTestConnection.hpp"
+#include "CAuthCryptoJob.hpp"
 #include "CTelegramTransport.hpp"
+#include "CTelegramStream.hpp"
+#include "CRawStream.hpp"
+#include "Utils.hpp"
 #include "TelegramUtils.hpp"
 
 #include <QTest>
+#include <QSignalSpy>
 #include <QDebug>
 
 #include <QDateTime>
@@ -39,6 +44,8 @@ private slots:
     void testTimestampConversion();
     void testAuth();
     void testAesKeyGeneration();
+    void testAuthCryptoJob();
+    void testTemporaryKeyBindingSaltError();
 
 };
 
@@ -356,6 +363,89 @@ void tst_CTelegramConnection::testAesKeyGeneration()
     QCOMPARE(result.iv , aesIvArray);
 }
 
+void tst_CTelegramConnection::testAuthCryptoJob()
+{
+    const QByteArray prime = QByteArray::fromHex("c71caeb9c6b1c9048e6c522f70f13f73980d40238e3e21c14934d037563d930f");
+    const QByteArray gA = QByteArray::fromHex("0262aaba621cc4df587dc94cf8252258c0b9337dfb47545a49cdd5c9b8eae7f4");
+    const QByteArray b = QByteArray::fromHex("6f620afa575c9233eb4c014110a7bcaf49464f798a18a0981fea1e05e8da67d9");
+
+    CAuthCryptoJob *job = CAuthCryptoJob::dhExchange(3, prime, gA, b);
+    QSignalSpy spy(job, &CAuthCryptoJob::finished);
+    job->start();
+    QVERIFY(spy.wait());
+
+    const QList<QVariant> arguments = spy.takeFirst();
+    QCOMPARE(arguments.at(0).toByteArray(), Telegram::Utils::binaryNumberModExp(QByteArray::fromHex("00000003"), prime, b));
+    QCOMPARE(arguments.at(1).toByteArray(), Telegram::Utils::binaryNumberModExp(gA, prime, b));
+}
+
+// Returns the message id signed in the bind_auth_key_inner of an auth.bindTempAuthKey request
+static quint64 boundMessageId(const QByteArray &request, const QByteArray &permanentKey)
+{
+    CTelegramStream requestStream(request);
+    TLValue method;
+    quint64 permanentKeyId;
+    quint64 nonce;
+    quint32 expiresAt;
+    QByteArray encryptedMessage;
+    requestStream >> method;
+    requestStream >> permanentKeyId;
+    requestStream >> nonce;
+    requestStream >> expiresAt;
+    requestStream >> encryptedMessage;
+    if ((method != TLValue::AuthBindTempAuthKey) || requestStream.error()) {
+        return 0;
+    }
+
+    const QByteArray messageKey = encryptedMessage.mid(8, 16);
+    const QByteArray innerData = Utils::aesDecrypt(encryptedMessage.mid(8 + 16), CTestConnection::testGenerateAesKey(permanentKey, messageKey, 0));
+    CRawStream innerStream(innerData);
+    quint64 salt;
+    quint64 sessionId;
+    quint64 messageId;
+    innerStream >> salt;
+    innerStream >> sessionId;
+    innerStream >> messageId;
+    return messageId;
+}
+
+void tst_CTelegramConnection::testTemporaryKeyBindingSaltError()
+{
+    CTestConnection connection;
+    QByteArray temporaryKey(256, Qt::Uninitialized);
+    QByteArray permanentKey(256, Qt::Uninitialized);
+    Utils::randomBytes(&temporaryKey);
+    Utils::randomBytes(&permanentKey);
+
+    connection.testBindTemporaryKey(temporaryKey, permanentKey, /* expiresAt */ 1500000000);
+    const quint64 bindingRequestId = connection.testTemporaryKeyBindingId();
+    QVERIFY(bindingRequestId);
+    QCOMPARE(boundMessageId(connection.testSubmittedPackage(bindingRequestId), permanentKey), bindingRequestId);
+
+    // The request is sent again with a new message id, which must be signed in the inner message too
+    connection.testProcessBadServerSalt(bindingRequestId, /* newServerSalt */ 2);
+    QCOMPARE(connection.serverSalt(), quint64(2));
+    QCOMPARE(connection.testTemporaryKeyBindingId(), bindingRequestId);
+    QVERIFY(!connection.testSubmittedPackageIds().contains(bindingRequestId));
+
+    quint64 resentId = 0;
+    for (quint64 id : connection.testSubmittedPackageIds()) {
+        if (TLValue::firstFromArray(connection.testSubmittedPackage(id)) == TLValue::AuthBindTempAuthKey) {
+            resentId = id;
+        }
+    }
+    QVERIFY(resentId > bindingRequestId);
+    QCOMPARE(connection.testPendingRequestId(resentId), bindingRequestId);
+    QCOMPARE(boundMessageId(connection.testSubmittedPackage(resentId), permanentKey), resentId);
+
+    // An error of the resent request is matched by the request id, the connection goes on with the permanent key
+    connection.testProcessRpcError(resentId, 400, QStringLiteral("ENCRYPTED_MESSAGE_INVALID"));
+    QCOMPARE(connection.testTemporaryKeyBindingId(), quint64(0));
+    QCOMPARE(connection.authKey(), permanentKey);
+    QCOMPARE(connection.authState(), CTelegramConnection::AuthStateSignedIn);
+    QVERIFY(!connection.testSubmittedPackageIds().contains(resentId));
+}
+
 QTEST_MAIN(tst_CTelegramConnection)
 
 #include "tst_CTelegramConnection.moc"
@@ -17,6 +17,23 @@
 
 #include "CTestDispatcher.hpp"
 
+#include "CClientTcpTransport.hpp"
+#include "CTelegramStream.hpp"
+
+CTestDispatcherConnection::CTestDispatcherConnection(QObject *parent) :
+    CTelegramConnection(nullptr, parent)
+{
+    setTransport(new Telegram::Client::TcpTransport(this));
+}
+
+void CTestDispatcherConnection::testAddPendingRequest(quint64 id, TLValue method)
+{
+    QByteArray data;
+    CTelegramStream stream(&data, /* write */ true);
+    stream << method;
+    addPendingRequest(id, data);
+}
+
 CTestDispatcher::CTestDispatcher(QObject *parent) :
     CTelegramDispatcher(parent)
 {
@@ -27,7 +44,28 @@ void CTestDispatcher::testProcessUpdate(const TLUpdate &update)
     return processUpdate(update);
 }
 
+void CTestDispatcher::testProcessMessages(const QVector<TLMessage> &messages)
+{
+    for (const TLMessage &message : messages) {
+        processMessageReceived(message);
+    }
+}
+
 void CTestDispatcher::testSetDcConfiguration(const QVector<TLDcOption> newDcConfiguration)
 {
     m_dcConfiguration = newDcConfiguration;
 }
+
+void CTestDispatcher::testSetMainConnection(CTelegramConnection *connection)
+{
+    connect(connection, &CTelegramConnection::connectionFailed, this, &CTelegramDispatcher::onConnectionFailed);
+    connect(connection, &CTelegramConnection::requestFailed, this, &CTelegramDispatcher::onConnectionRequestFailed);
+    connect(connection, &CTelegramConnection::statusChanged, this, &CTelegramDispatcher::onConnectionStatusChanged);
+    setMainConnection(connection);
+}
+
+void CTestDispatcher::testSetResumingMainConnection(TelegramNamespace::ConnectionState resumedState, int attempts)
+{
+    m_resumedConnectionState = resumedState;
+    m_mainConnectionResumeAttempts = attempts;
+}
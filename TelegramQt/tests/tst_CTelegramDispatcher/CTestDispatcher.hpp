@@ -19,6 +19,18 @@
 #define CTESTDISPATCHER_HPP
 
 #include "CTelegramDispatcher.hpp"
+#include "CTelegramConnection.hpp"
+
+// A connection with the pending requests and no server
+class CTestDispatcherConnection : public CTelegramConnection
+{
+public:
+    explicit CTestDispatcherConnection(QObject *parent = 0);
+
+    void testAddPendingRequest(quint64 id, TLValue method);
+    void testSetAuthState(AuthState state) { m_authState = state; }
+    void testSetStatus(ConnectionStatus status, ConnectionStatusReason reason) { setStatus(status, reason); }
+};
 
 class CTestDispatcher : public CTelegramDispatcher
 {
@@ -27,8 +39,17 @@ public:
     explicit CTestDispatcher(QObject *parent = 0);
 
     void testProcessUpdate(const TLUpdate &update);
+    void testProcessMessages(const QVector<TLMessage> &messages);
+    void testProcessDifference(const TLUpdatesDifference &difference) { onUpdatesDifferenceReceived(difference); }
+    void testSetActualState(const TLUpdatesState &state) { m_actualState = state; }
+    TLUpdatesState testGetUpdatesState() const { return m_updatesState; }
     void testSetDcConfiguration(const QVector<TLDcOption> newDcConfiguration);
     QVector<TLDcOption> testGetDcConfiguration() const { return m_dcConfiguration; }
+    void testSetMainConnection(CTelegramConnection *connection);
+    void testSetResumingMainConnection(TelegramNamespace::ConnectionState resumedState, int attempts);
+    void testAddTemporaryKey(quint32 dc, const CTemporaryKeyPool::Key &key) { m_temporaryKeys.add(dc, key); }
+    int testGetTemporaryKeysCount(quint32 dc) const { return m_temporaryKeys.count(dc, serverTime()); }
+    int testGetTemporaryKeyGeneratorsCount() const { return m_temporaryKeyGenerators.count(); }
 
 };
 
@@ -20,9 +20,13 @@
 #include "CTestDispatcher.hpp"
 
 #include <QBuffer>
+#include <QCoreApplication>
+#include <QDateTime>
 #include <QTest>
 #include <QDebug>
 
+#include <algorithm>
+
 class tst_CTelegramDispatcher : public QObject
 {
     Q_OBJECT
@@ -30,7 +34,14 @@ public:
     explicit tst_CTelegramDispatcher(QObject *parent = 0);
 
 private slots:
+    void initTestCase();
     void testUpdateDcOptions();
+    void batchedMessagesSignal();
+    void differenceProcessedInChunks();
+    void catchUpBenchmark_data();
+    void catchUpBenchmark();
+    void resumeFallbackFailsRequests();
+    void firstDcConnectionWithoutPool();
 
 };
 
@@ -39,6 +50,38 @@ tst_CTelegramDispatcher::tst_CTelegramDispatcher(QObject *parent) :
 {
 }
 
+void tst_CTelegramDispatcher::initTestCase()
+{
+    TelegramNamespace::registerTypes();
+}
+
+static QVector<TLMessage> constructTextMessages(int count)
+{
+    QVector<TLMessage> messages;
+    messages.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        TLMessage message;
+        message.tlType = TLValue::Message;
+        message.id = i + 1;
+        message.fromId = 1000 + i % 50;
+        message.toId.tlType = TLValue::PeerChat;
+        message.toId.chatId = 10 + i % 20;
+        message.date = 1500000000 + i;
+        message.message = QStringLiteral("Message %1").arg(i);
+        message.media.tlType = TLValue::MessageMediaEmpty;
+        messages.append(message);
+    }
+    return messages;
+}
+
+// Process the events until all the queued signals are delivered
+static void deliverQueuedSignals(const int *receivedCount, int expectedCount)
+{
+    for (int i = 0; (i < 10) && (*receivedCount < expectedCount); ++i) {
+        QCoreApplication::processEvents();
+    }
+}
+
 static TLDcOption constructDcOption(quint32 id, QString ipAddress, quint32 port)
 {
     TLDcOption result;
@@ -99,6 +142,182 @@ void tst_CTelegramDispatcher::testUpdateDcOptions()
     }
 }
 
+void tst_CTelegramDispatcher::batchedMessagesSignal()
+{
+    const QVector<TLMessage> messages = constructTextMessages(100);
+
+    CTestDispatcher dispatcher;
+    int messageSignals = 0;
+    QVector<Telegram::Message> batchedMessages;
+    int batchedSignals = 0;
+    connect(&dispatcher, &CTelegramDispatcher::messageReceived, [&messageSignals]() {
+        ++messageSignals;
+    });
+    connect(&dispatcher, &CTelegramDispatcher::messagesReceived, [&batchedMessages, &batchedSignals](const QVector<Telegram::Message> &messages) {
+        batchedMessages += messages;
+        ++batchedSignals;
+    });
+
+    dispatcher.testProcessMessages(messages);
+    QCOMPARE(messageSignals, messages.count());
+    QCOMPARE(batchedSignals, 0); // Not before the control returns to the event loop
+
+    deliverQueuedSignals(&batchedSignals, 1);
+    QCOMPARE(batchedSignals, 1);
+    QCOMPARE(batchedMessages.count(), messages.count());
+    for (int i = 0; i < messages.count(); ++i) {
+        QCOMPARE(batchedMessages.at(i).id, messages.at(i).id);
+        QCOMPARE(batchedMessages.at(i).text, messages.at(i).message);
+    }
+}
+
+void tst_CTelegramDispatcher::differenceProcessedInChunks()
+{
+    TLUpdatesDifference difference;
+    difference.tlType = TLValue::UpdatesDifference;
+    difference.newMessages = constructTextMessages(250);
+    difference.state.pts = 300;
+
+    TLUpdatesState actualState;
+    actualState.pts = 1000;
+
+    CTestDispatcher dispatcher;
+    dispatcher.testSetActualState(actualState);
+
+    int receivedCount = 0;
+    connect(&dispatcher, &CTelegramDispatcher::messageReceived, [&receivedCount]() {
+        ++receivedCount;
+    });
+    quint32 remainingPts = 0;
+    quint32 processedMessages = 0;
+    connect(&dispatcher, &CTelegramDispatcher::updatesCatchUpProgress,
+            [&remainingPts, &processedMessages](quint32 remaining, quint32 processed) {
+        remainingPts = remaining;
+        processedMessages = processed;
+    });
+
+    dispatcher.testProcessDifference(difference);
+    QCOMPARE(receivedCount, 0); // Nothing is processed until the control returns to the event loop
+
+    QVector<int> chunks;
+    for (int i = 0; (i < 10) && (receivedCount < difference.newMessages.count()); ++i) {
+        const int previousCount = receivedCount;
+        QCoreApplication::processEvents();
+        if (receivedCount != previousCount) {
+            chunks.append(receivedCount - previousCount);
+        }
+    }
+    QCOMPARE(receivedCount, difference.newMessages.count());
+    QVERIFY(chunks.count() > 1);
+    QCOMPARE(dispatcher.testGetUpdatesState().pts, difference.state.pts);
+    QCOMPARE(processedMessages, quint32(difference.newMessages.count()));
+    QCOMPARE(remainingPts, actualState.pts - difference.state.pts);
+}
+
+void tst_CTelegramDispatcher::catchUpBenchmark_data()
+{
+    QTest::addColumn<bool>("batched");
+
+    QTest::newRow("per message signals") << false;
+    QTest::newRow("batched signals") << true;
+}
+
+void tst_CTelegramDispatcher::catchUpBenchmark()
+{
+    QFETCH(bool, batched);
+    const QVector<TLMessage> messages = constructTextMessages(10000);
+
+    // Queued connections as of a client receiving the messages in another thread;
+    // the receiver appends the messages to a model-like storage.
+    CTestDispatcher dispatcher;
+    QObject receiver;
+    QVector<Telegram::Message> received;
+    received.reserve(messages.count());
+    int receivedCount = 0;
+    if (batched) {
+        connect(&dispatcher, &CTelegramDispatcher::messagesReceived, &receiver,
+                [&received, &receivedCount](const QVector<Telegram::Message> &messages) {
+            received += messages;
+            receivedCount = received.count();
+        }, Qt::QueuedConnection);
+    } else {
+        connect(&dispatcher, &CTelegramDispatcher::messageReceived, &receiver,
+                [&received, &receivedCount](const Telegram::Message &message) {
+            received.append(message);
+            receivedCount = received.count();
+        }, Qt::QueuedConnection);
+    }
+
+    QBENCHMARK {
+        received.clear();
+        receivedCount = 0;
+        dispatcher.testProcessMessages(messages);
+        deliverQueuedSignals(&receivedCount, messages.count());
+    }
+    QCOMPARE(receivedCount, messages.count());
+}
+
+void tst_CTelegramDispatcher::resumeFallbackFailsRequests()
+{
+    CTestDispatcher dispatcher;
+    CTestDispatcherConnection *connection = new CTestDispatcherConnection(&dispatcher);
+    connection->testSetAuthState(CTelegramConnection::AuthStateSignedIn);
+    connection->testSetStatus(CTelegramConnection::ConnectionStatusConnected, CTelegramConnection::ConnectionStatusReasonNone);
+    connection->testAddPendingRequest(101, TLValue::MessagesSendMessage);
+    connection->testAddPendingRequest(102, TLValue::MessagesGetHistory);
+    dispatcher.testSetMainConnection(connection);
+
+    QVector<quint64> failedRequests;
+    QVector<TelegramNamespace::RequestFailureReason> failureReasons;
+    connect(&dispatcher, &CTelegramDispatcher::requestFailed,
+            [&failedRequests, &failureReasons](quint64 requestId, const QString &method, TelegramNamespace::RequestFailureReason reason) {
+        Q_UNUSED(method)
+        failedRequests.append(requestId);
+        failureReasons.append(reason);
+    });
+
+    // All the resume attempts are spent, so the remotely closed connection is dropped
+    dispatcher.testSetResumingMainConnection(TelegramNamespace::ConnectionStateReady, /* attempts */ 1000);
+    connection->testSetStatus(CTelegramConnection::ConnectionStatusDisconnected, CTelegramConnection::ConnectionStatusReasonRemote);
+
+    QCOMPARE(dispatcher.mainConnection(), static_cast<CTelegramConnection*>(nullptr));
+    std::sort(failedRequests.begin(), failedRequests.end());
+    QCOMPARE(failedRequests, QVector<quint64>({ 101, 102 }));
+    for (TelegramNamespace::RequestFailureReason reason : failureReasons) {
+        QCOMPARE(reason, TelegramNamespace::RequestFailureConnectionClosed);
+    }
+}
+
+void tst_CTelegramDispatcher::firstDcConnectionWithoutPool()
+{
+    CTestDispatcher dispatcher;
+    dispatcher.testSetDcConfiguration({
+                                          constructDcOption(1, QLatin1String("149.154.175.50"), 443),
+                                          constructDcOption(2, QLatin1String("149.154.167.51"), 443),
+                                      });
+    CTestDispatcherConnection *mainConnection = new CTestDispatcherConnection(&dispatcher);
+    mainConnection->setDcInfo(constructDcOption(1, QLatin1String("149.154.175.50"), 443));
+    mainConnection->testSetAuthState(CTelegramConnection::AuthStateSignedIn);
+    dispatcher.testSetMainConnection(mainConnection);
+
+    // A pooled key can not be bound without a permanent key of the dc, which is known only after the first sign in
+    CTemporaryKeyPool::Key key;
+    key.authKey = QByteArray(256, char(0x42));
+    key.serverSalt = 1;
+    key.expiresAt = QDateTime::currentMSecsSinceEpoch() / 1000 + 24 * 60 * 60;
+    dispatcher.testAddTemporaryKey(2, key);
+    QCOMPARE(dispatcher.testGetTemporaryKeysCount(2), 1);
+
+    CTelegramConnection *connection = dispatcher.getExtraConnection(2);
+    QVERIFY(connection);
+    QCOMPARE(connection->dcInfo().id, quint32(2));
+    QVERIFY(connection->authKey().isEmpty());
+    QCOMPARE(connection->authKeyExpiresAt(), quint32(0));
+    QVERIFY(!connection->isBindingTemporaryKey());
+    QCOMPARE(dispatcher.testGetTemporaryKeysCount(2), 1);
+    QCOMPARE(dispatcher.testGetTemporaryKeyGeneratorsCount(), 0);
+}
+
 QTEST_MAIN(tst_CTelegramDispatcher)
 
 #include "tst_CTelegramDispatcher.moc"
@@ -39,13 +39,17 @@ private slots:
     void stringsLimitSerialization();
     void shortStringSerialization();
     void longStringSerialization();
+    void utf8StringSlices();
     void intSerialization();
     void vectorOfIntsSerialization();
     void vectorDeserializationError();
     void pointerVectorSerialization();
     void pointerVectorDeserialization();
     void tlNumbersSerialization();
+    void fixedLayoutSerialization();
+    void serializedSize();
     void tlDcOptionDeserialization();
+    void messagesDecodingBenchmark();
     void readError();
 
 };
@@ -233,6 +237,46 @@ void tst_CTelegramStream::longStringSerialization()
     }
 }
 
+void tst_CTelegramStream::utf8StringSlices()
+{
+    const QString shortString = QStringLiteral("\u041f\u0440\u0438\u0432\u0435\u0442"); // Non-latin to check the transcoding
+    const QString longString = QString(300, QLatin1Char('x'));
+
+    QByteArray buffer;
+    {
+        CTelegramStream stream(&buffer, true);
+        stream << TLString(shortString);
+        stream << longString;
+        stream << quint32(0xdeadbeef);
+    }
+
+    CTelegramStream stream(buffer);
+    TLString shortResult;
+    TLString longResult;
+    quint32 tail;
+    stream >> shortResult;
+    stream >> longResult;
+    stream >> tail;
+
+    QVERIFY(!stream.error());
+    QVERIFY(shortResult.isSlice());
+    QCOMPARE(shortResult.toString(), shortString);
+    QCOMPARE(longResult.toString(), longString);
+    QCOMPARE(tail, quint32(0xdeadbeef));
+
+    longResult.squeeze();
+    QVERIFY(!longResult.isSlice());
+    QCOMPARE(longResult.toUtf8(), longString.toUtf8());
+    QVERIFY(shortResult == TLString(shortString));
+
+    // Truncated input
+    CTelegramStream truncatedStream(buffer.left(4));
+    TLString truncatedResult;
+    truncatedStream >> truncatedResult;
+    QVERIFY(truncatedStream.error());
+    QVERIFY(truncatedResult.isEmpty());
+}
+
 void tst_CTelegramStream::intSerialization()
 {
     QList<STestData> data;
@@ -440,6 +484,106 @@ void tst_CTelegramStream::tlNumbersSerialization()
     }
 }
 
+void tst_CTelegramStream::fixedLayoutSerialization()
+{
+    TLNumber128 number;
+    number.parts[0] = 0x0102030405060708ull;
+    number.parts[1] = 0x1112131415161718ull;
+
+    QByteArray perMember;
+    {
+        CTelegramStream stream(&perMember, true);
+        stream << quint32(0xdeadbeef);
+        stream << quint64(0x123456789abcdef0ull);
+        stream << 2.5;
+        stream << number;
+    }
+
+    QByteArray bulk;
+    {
+        CTelegramStream stream(&bulk, true);
+        stream.writeFixedLayout(quint32(0xdeadbeef), quint64(0x123456789abcdef0ull), 2.5, number);
+    }
+    QCOMPARE(bulk, perMember);
+    QCOMPARE(CTelegramStream::fixedLayoutSize<quint32, quint64, double, TLNumber128>(), perMember.size());
+
+    quint32 int32Value = 0;
+    quint64 int64Value = 0;
+    double doubleValue = 0;
+    TLNumber128 numberValue;
+    CTelegramStream stream(bulk);
+    stream.readFixedLayout(int32Value, int64Value, doubleValue, numberValue);
+    QVERIFY(!stream.error());
+    QCOMPARE(int32Value, quint32(0xdeadbeef));
+    QCOMPARE(int64Value, quint64(0x123456789abcdef0ull));
+    QCOMPARE(doubleValue, 2.5);
+    QVERIFY(numberValue == number);
+
+    // Generated codec of a fixed-layout constructor
+    QByteArray contactData;
+    {
+        CTelegramStream stream(&contactData, true);
+        stream << TLValue(TLValue::ContactBlocked);
+        stream << quint32(100);
+        stream << quint32(200);
+    }
+    QCOMPARE(quint32(contactData.size()), quint32(TLContactBlocked::ContactBlockedSize));
+    TLContactBlocked contact;
+    CTelegramStream contactStream(contactData);
+    contactStream >> contact;
+    QVERIFY(!contactStream.error());
+    QCOMPARE(contact.userId, quint32(100));
+    QCOMPARE(contact.date, quint32(200));
+
+    // Truncated input
+    CTelegramStream truncatedStream(contactData.left(8));
+    TLContactBlocked truncatedContact;
+    truncatedStream >> truncatedContact;
+    QVERIFY(truncatedStream.error());
+    QCOMPARE(truncatedContact.userId, quint32(0));
+}
+
+void tst_CTelegramStream::serializedSize()
+{
+    const QStringList strings = {
+        QString(),
+        QStringLiteral("abc"),
+        QStringLiteral("abcd"),
+        QStringLiteral("\u041f\u0440\u0438\u0432\u0435\u0442"),
+        QStringLiteral("\u20ac\U0001F600"), // Three and four bytes in UTF-8
+        QString(253, QLatin1Char('a')),
+        QString(254, QLatin1Char('a')),
+        QString(300, QChar(0x0444)),
+    };
+
+    for (const QString &str : strings) {
+        QByteArray data;
+        CTelegramStream stream(&data, true);
+        stream << str;
+        QCOMPARE(CTelegramStream::serializedSize(str), quint32(data.size()));
+        QCOMPARE(CTelegramStream::serializedSize(TLString(str)), quint32(data.size()));
+    }
+
+    TLInputPeer peer;
+    peer.tlType = TLValue::InputPeerUser;
+    peer.userId = 1;
+    peer.accessHash = 2;
+    const TLVector<TLInputPeer> peers = { peer, TLInputPeer() };
+    const TLVector<quint64> ids = { 1, 2, 3 };
+
+    QByteArray data;
+    CTelegramStream stream(&data, true);
+    stream << peer;
+    QCOMPARE(CTelegramStream::serializedSize(peer), quint32(data.size()));
+    QCOMPARE(CTelegramStream::serializedSize(peer), quint32(TLInputPeer::InputPeerUserSize));
+
+    data.clear();
+    CTelegramStream vectorStream(&data, true);
+    vectorStream << peers;
+    vectorStream << ids;
+    QCOMPARE(CTelegramStream::serializedSize(peers) + CTelegramStream::serializedSize(ids), quint32(data.size()));
+}
+
 void tst_CTelegramStream::tlDcOptionDeserialization()
 {
     QByteArray dcOptionsData;
@@ -481,6 +625,43 @@ void tst_CTelegramStream::tlDcOptionDeserialization()
     QVERIFY(readOptionsVector.isValid());
 }
 
+void tst_CTelegramStream::messagesDecodingBenchmark()
+{
+    // Measures whichever decoder is built (see the TABLE_DECODER option)
+    static const int messagesCount = 1000;
+
+    QByteArray data;
+    CTelegramStream outputStream(&data, /* write */ true);
+    outputStream << TLValue(TLValue::Vector);
+    outputStream << quint32(messagesCount);
+    for (int i = 0; i < messagesCount; ++i) {
+        outputStream << TLValue(TLValue::Message);
+        outputStream << quint32(1 << 8); // flags: fromId
+        outputStream << quint32(i); // id
+        outputStream << quint32(1000 + i); // fromId
+        outputStream << TLValue(TLValue::PeerUser);
+        outputStream << quint32(2000); // toId.userId
+        outputStream << quint32(1480000000 + i); // date
+        outputStream << QStringLiteral("Benchmark message");
+    }
+
+    TLVector<TLMessage> messages;
+
+    QBENCHMARK {
+        CTelegramStream inputStream(data);
+        inputStream >> messages;
+    }
+
+    QCOMPARE(messages.count(), messagesCount);
+    const TLMessage &lastMessage = messages.last();
+    QCOMPARE(lastMessage.tlType, TLValue(TLValue::Message));
+    QCOMPARE(lastMessage.id, quint32(messagesCount - 1));
+    QCOMPARE(lastMessage.fromId, quint32(1000 + messagesCount - 1));
+    QCOMPARE(lastMessage.toId.tlType, TLValue(TLValue::PeerUser));
+    QCOMPARE(lastMessage.toId.userId, quint32(2000));
+    QCOMPARE(lastMessage.message, QStringLiteral("Benchmark message"));
+}
+
 void tst_CTelegramStream::readError()
 {
     {
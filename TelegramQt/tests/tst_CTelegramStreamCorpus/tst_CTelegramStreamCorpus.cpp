@@ -0,0 +1,635 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#include <QObject>
+
+#include "CTelegramStream_p.hpp"
+#include "CTelegramStreamExtraOperators.hpp"
+#include "Generator.hpp"
+
+#include <QFile>
+#include <QTest>
+#include <QDebug>
+
+#include <random>
+
+#ifndef TELEGRAMQT_SCHEME_FILE
+#error "TELEGRAMQT_SCHEME_FILE should point to the scheme used to generate the TL types"
+#endif
+
+static const quint32 c_seed = 45;
+static const int c_maxDepth = 4; // Deeper values get no optional members and empty vectors
+static const int c_depthLimit = 32; // Fail instead of endless recursion on a type without finite values
+static const int c_roundTripInstances = 16;
+static const int c_truncatedInstances = 4;
+static const int c_malformedInstances = 64;
+static const int c_benchmarkInstances = 64;
+
+/* Writes random, but valid values of the scheme types.
+ * The values are built from the generator type model, so the corpus is independent of the code under test.
+ */
+class CorpusWriter
+{
+public:
+    explicit CorpusWriter(const QList<TLType> &types);
+
+    void reset(quint32 seed);
+    bool hasType(const QString &typeName) const { return m_types.contains(typeName); }
+    bool isValid() const { return m_valid; }
+
+    QByteArray randomValue(const QString &typeName);
+    QByteArray randomValues(const QString &typeName, int count);
+
+protected:
+    void writeValue(CTelegramStream &stream, const QString &typeName, int depth);
+    void writeSubType(CTelegramStream &stream, const TLSubType &subType, int depth);
+    quint32 randomInt(quint32 max) { return std::uniform_int_distribution<quint32>(0, max - 1)(m_random); }
+    QString randomString();
+    QByteArray randomBytes();
+
+    static bool isNativeType(const QString &typeName);
+
+    QHash<QString, TLType> m_types;
+    QHash<QString, int> m_simplestSubTypes;
+    std::mt19937 m_random;
+    bool m_valid = true;
+};
+
+CorpusWriter::CorpusWriter(const QList<TLType> &types)
+{
+    for (const TLType &type : types) {
+        m_types.insert(type.name, type);
+
+        // The subtype with the least number of the nested values ends the recursion
+        int simplestIndex = 0;
+        int simplestNestedCount = -1;
+        for (int i = 0; i < type.subTypes.count(); ++i) {
+            int nestedCount = 0;
+            for (const TLParam &member : type.subTypes.at(i).members) {
+                if (!member.dependOnFlag() && !isNativeType(member.type())) {
+                    ++nestedCount;
+                }
+            }
+            if ((simplestNestedCount < 0) || (nestedCount < simplestNestedCount)) {
+                simplestIndex = i;
+                simplestNestedCount = nestedCount;
+            }
+        }
+        m_simplestSubTypes.insert(type.name, simplestIndex);
+    }
+    reset(c_seed);
+}
+
+void CorpusWriter::reset(quint32 seed)
+{
+    m_random.seed(seed);
+    m_valid = true;
+}
+
+QByteArray CorpusWriter::randomValue(const QString &typeName)
+{
+    return randomValues(typeName, 1);
+}
+
+QByteArray CorpusWriter::randomValues(const QString &typeName, int count)
+{
+    QByteArray data;
+    CTelegramStream stream(&data, /* write */ true);
+    for (int i = 0; i < count; ++i) {
+        writeValue(stream, typeName, 0);
+    }
+    return data;
+}
+
+bool CorpusWriter::isNativeType(const QString &typeName)
+{
+    return typeName == QLatin1String("quint32")
+            || typeName == QLatin1String("quint64")
+            || typeName == QLatin1String("double")
+            || typeName == QLatin1String("bool")
+            || typeName == QLatin1String("QString")
+            || typeName == QLatin1String("QByteArray")
+            || typeName == QLatin1String("TLNumber128")
+            || typeName == QLatin1String("TLNumber256");
+}
+
+void CorpusWriter::writeValue(CTelegramStream &stream, const QString &typeName, int depth)
+{
+    if (depth > c_depthLimit) {
+        m_valid = false;
+        return;
+    }
+
+    if (typeName == QLatin1String("quint32")) {
+        stream << quint32(m_random());
+    } else if (typeName == QLatin1String("quint64")) {
+        stream << (quint64(m_random()) << 32 | m_random());
+    } else if (typeName == QLatin1String("double")) {
+        stream << std::uniform_real_distribution<double>(-1e6, 1e6)(m_random);
+    } else if (typeName == QLatin1String("bool")) {
+        stream << bool(m_random() & 1);
+    } else if (typeName == QLatin1String("QString")) {
+        stream << randomString();
+    } else if (typeName == QLatin1String("QByteArray")) {
+        stream << randomBytes();
+    } else if (typeName == QLatin1String("TLNumber128")) {
+        TLNumber128 number;
+        for (quint64 &part : number.parts) {
+            part = quint64(m_random()) << 32 | m_random();
+        }
+        stream << number;
+    } else if (typeName == QLatin1String("TLNumber256")) {
+        TLNumber256 number;
+        for (quint64 &part : number.parts) {
+            part = quint64(m_random()) << 32 | m_random();
+        }
+        stream << number;
+    } else if (typeName.startsWith(QLatin1String("TLVector<"))) {
+        const QString elementType = Generator::getTypeOrVectorType(typeName);
+        const quint32 count = depth < c_maxDepth ? randomInt(4) : 0;
+        stream << TLValue(TLValue::Vector);
+        stream << count;
+        for (quint32 i = 0; i < count; ++i) {
+            writeValue(stream, elementType, depth + 1);
+        }
+    } else if (m_types.contains(typeName)) {
+        const TLType &type = m_types[typeName];
+        const int index = depth < c_maxDepth ? int(randomInt(type.subTypes.count())) : m_simplestSubTypes.value(typeName);
+        writeSubType(stream, type.subTypes.at(index), depth);
+    } else {
+        qWarning() << Q_FUNC_INFO << "Unknown type" << typeName;
+        m_valid = false;
+    }
+}
+
+void CorpusWriter::writeSubType(CTelegramStream &stream, const TLSubType &subType, int depth)
+{
+    stream << TLValue(subType.id);
+
+    QStringList flagMembers;
+    for (const TLParam &member : subType.members) {
+        if (member.dependOnFlag()) {
+            flagMembers.append(member.flagMember);
+        }
+    }
+
+    QHash<QString, quint32> flags;
+    for (const TLParam &member : subType.members) {
+        if (member.dependOnFlag()) {
+            if (!(flags.value(member.flagMember) & 1u << member.flagBit)) {
+                continue;
+            }
+            if (member.type() == QLatin1String("TLTrue")) {
+                continue; // No extra data behind the flag
+            }
+        }
+        if (flagMembers.contains(member.getAlias())) {
+            const quint32 value = depth < c_maxDepth ? quint32(m_random()) : 0;
+            flags.insert(member.getAlias(), value);
+            stream << value;
+            continue;
+        }
+        writeValue(stream, member.type(), depth + 1);
+    }
+}
+
+QString CorpusWriter::randomString()
+{
+    // Valid UTF-16 only: an unpaired surrogate would not survive the UTF-8 round trip
+    const int length = (randomInt(16) == 0) ? int(254 + randomInt(300)) : int(randomInt(24));
+    QString result;
+    result.reserve(length * 2);
+    for (int i = 0; i < length; ++i) {
+        switch (randomInt(4)) {
+        case 0:
+        case 1:
+            result.append(QChar(ushort(0x20 + randomInt(0x5f))));
+            break;
+        case 2:
+            result.append(QChar(ushort(0xa0 + randomInt(0xd800 - 0xa0))));
+            break;
+        default: {
+            const uint ucs4 = 0x10000 + randomInt(0x100000);
+            result.append(QChar(QChar::highSurrogate(ucs4)));
+            result.append(QChar(QChar::lowSurrogate(ucs4)));
+            break;
+        }
+        }
+    }
+    return result;
+}
+
+QByteArray CorpusWriter::randomBytes()
+{
+    const int length = (randomInt(16) == 0) ? int(254 + randomInt(1024)) : int(randomInt(32));
+    QByteArray result(length, Qt::Uninitialized);
+    for (char &c : result) {
+        c = char(m_random());
+    }
+    return result;
+}
+
+template <typename T>
+static bool decodeValue(const QByteArray &data)
+{
+    CTelegramStream stream(data);
+    T value;
+    stream >> value;
+    return !stream.error() && stream.atEnd();
+}
+
+template <typename T>
+static bool roundTripValue(const QByteArray &data, QByteArray *output)
+{
+    CTelegramStream inputStream(data);
+    T value;
+    inputStream >> value;
+    if (inputStream.error() || !inputStream.atEnd()) {
+        return false;
+    }
+
+    CTelegramStream outputStream(output, /* write */ true);
+    outputStream << value;
+    return !outputStream.error();
+}
+
+template <typename T>
+static void benchmarkDecoding(const QByteArray &corpus, int count)
+{
+    QBENCHMARK {
+        CTelegramStream stream(corpus);
+        T value;
+        for (int i = 0; i < count; ++i) {
+            stream >> value;
+        }
+    }
+}
+
+template <typename T>
+static void benchmarkEncoding(const QByteArray &corpus, int count)
+{
+    QVector<T> values(count);
+    CTelegramStream inputStream(corpus);
+    for (T &value : values) {
+        inputStream >> value;
+    }
+
+    QBENCHMARK {
+        CTelegramStream stream(CTelegramStream::WriteOnly, corpus.size());
+        for (const T &value : values) {
+            stream << value;
+        }
+    }
+}
+
+struct TypeCodec
+{
+    template <typename T>
+    static TypeCodec create()
+    {
+        TypeCodec codec;
+        codec.decode = &decodeValue<T>;
+        codec.roundTrip = &roundTripValue<T>;
+        codec.benchmarkDecoding = &::benchmarkDecoding<T>;
+        codec.benchmarkEncoding = &::benchmarkEncoding<T>;
+        return codec;
+    }
+
+    bool (*decode)(const QByteArray &data) = nullptr;
+    bool (*roundTrip)(const QByteArray &data, QByteArray *output) = nullptr;
+    void (*benchmarkDecoding)(const QByteArray &corpus, int count) = nullptr;
+    void (*benchmarkEncoding)(const QByteArray &corpus, int count) = nullptr;
+};
+
+static QHash<QString, TypeCodec> typeCodecs()
+{
+    QHash<QString, TypeCodec> codecs;
+    // Generated corpus codecs
+    codecs.insert(QStringLiteral("TLAccountDaysTTL"), TypeCodec::create<TLAccountDaysTTL>());
+    codecs.insert(QStringLiteral("TLAccountPassword"), TypeCodec::create<TLAccountPassword>());
+    codecs.insert(QStringLiteral("TLAccountPasswordInputSettings"), TypeCodec::create<TLAccountPasswordInputSettings>());
+    codecs.insert(QStringLiteral("TLAccountPasswordSettings"), TypeCodec::create<TLAccountPasswordSettings>());
+    codecs.insert(QStringLiteral("TLAccountSentChangePhoneCode"), TypeCodec::create<TLAccountSentChangePhoneCode>());
+    codecs.insert(QStringLiteral("TLAudio"), TypeCodec::create<TLAudio>());
+    codecs.insert(QStringLiteral("TLAuthCheckedPhone"), TypeCodec::create<TLAuthCheckedPhone>());
+    codecs.insert(QStringLiteral("TLAuthExportedAuthorization"), TypeCodec::create<TLAuthExportedAuthorization>());
+    codecs.insert(QStringLiteral("TLAuthPasswordRecovery"), TypeCodec::create<TLAuthPasswordRecovery>());
+    codecs.insert(QStringLiteral("TLAuthSentCode"), TypeCodec::create<TLAuthSentCode>());
+    codecs.insert(QStringLiteral("TLAuthorization"), TypeCodec::create<TLAuthorization>());
+    codecs.insert(QStringLiteral("TLBotCommand"), TypeCodec::create<TLBotCommand>());
+    codecs.insert(QStringLiteral("TLBotInfo"), TypeCodec::create<TLBotInfo>());
+    codecs.insert(QStringLiteral("TLChannelParticipant"), TypeCodec::create<TLChannelParticipant>());
+    codecs.insert(QStringLiteral("TLChannelParticipantRole"), TypeCodec::create<TLChannelParticipantRole>());
+    codecs.insert(QStringLiteral("TLChannelParticipantsFilter"), TypeCodec::create<TLChannelParticipantsFilter>());
+    codecs.insert(QStringLiteral("TLChatParticipant"), TypeCodec::create<TLChatParticipant>());
+    codecs.insert(QStringLiteral("TLChatParticipants"), TypeCodec::create<TLChatParticipants>());
+    codecs.insert(QStringLiteral("TLContact"), TypeCodec::create<TLContact>());
+    codecs.insert(QStringLiteral("TLContactBlocked"), TypeCodec::create<TLContactBlocked>());
+    codecs.insert(QStringLiteral("TLContactLink"), TypeCodec::create<TLContactLink>());
+    codecs.insert(QStringLiteral("TLContactSuggested"), TypeCodec::create<TLContactSuggested>());
+    codecs.insert(QStringLiteral("TLDisabledFeature"), TypeCodec::create<TLDisabledFeature>());
+    codecs.insert(QStringLiteral("TLEncryptedChat"), TypeCodec::create<TLEncryptedChat>());
+    codecs.insert(QStringLiteral("TLEncryptedFile"), TypeCodec::create<TLEncryptedFile>());
+    codecs.insert(QStringLiteral("TLEncryptedMessage"), TypeCodec::create<TLEncryptedMessage>());
+    codecs.insert(QStringLiteral("TLError"), TypeCodec::create<TLError>());
+    codecs.insert(QStringLiteral("TLExportedChatInvite"), TypeCodec::create<TLExportedChatInvite>());
+    codecs.insert(QStringLiteral("TLFileLocation"), TypeCodec::create<TLFileLocation>());
+    codecs.insert(QStringLiteral("TLGeoPoint"), TypeCodec::create<TLGeoPoint>());
+    codecs.insert(QStringLiteral("TLHelpAppChangelog"), TypeCodec::create<TLHelpAppChangelog>());
+    codecs.insert(QStringLiteral("TLHelpAppUpdate"), TypeCodec::create<TLHelpAppUpdate>());
+    codecs.insert(QStringLiteral("TLHelpInviteText"), TypeCodec::create<TLHelpInviteText>());
+    codecs.insert(QStringLiteral("TLHelpTermsOfService"), TypeCodec::create<TLHelpTermsOfService>());
+    codecs.insert(QStringLiteral("TLImportedContact"), TypeCodec::create<TLImportedContact>());
+    codecs.insert(QStringLiteral("TLInputAppEvent"), TypeCodec::create<TLInputAppEvent>());
+    codecs.insert(QStringLiteral("TLInputAudio"), TypeCodec::create<TLInputAudio>());
+    codecs.insert(QStringLiteral("TLInputChannel"), TypeCodec::create<TLInputChannel>());
+    codecs.insert(QStringLiteral("TLInputContact"), TypeCodec::create<TLInputContact>());
+    codecs.insert(QStringLiteral("TLInputDocument"), TypeCodec::create<TLInputDocument>());
+    codecs.insert(QStringLiteral("TLInputEncryptedChat"), TypeCodec::create<TLInputEncryptedChat>());
+    codecs.insert(QStringLiteral("TLInputEncryptedFile"), TypeCodec::create<TLInputEncryptedFile>());
+    codecs.insert(QStringLiteral("TLInputFile"), TypeCodec::create<TLInputFile>());
+    codecs.insert(QStringLiteral("TLInputFileLocation"), TypeCodec::create<TLInputFileLocation>());
+    codecs.insert(QStringLiteral("TLInputGeoPoint"), TypeCodec::create<TLInputGeoPoint>());
+    codecs.insert(QStringLiteral("TLInputPeer"), TypeCodec::create<TLInputPeer>());
+    codecs.insert(QStringLiteral("TLInputPeerNotifyEvents"), TypeCodec::create<TLInputPeerNotifyEvents>());
+    codecs.insert(QStringLiteral("TLInputPeerNotifySettings"), TypeCodec::create<TLInputPeerNotifySettings>());
+    codecs.insert(QStringLiteral("TLInputPhoto"), TypeCodec::create<TLInputPhoto>());
+    codecs.insert(QStringLiteral("TLInputPhotoCrop"), TypeCodec::create<TLInputPhotoCrop>());
+    codecs.insert(QStringLiteral("TLInputPrivacyKey"), TypeCodec::create<TLInputPrivacyKey>());
+    codecs.insert(QStringLiteral("TLInputStickerSet"), TypeCodec::create<TLInputStickerSet>());
+    codecs.insert(QStringLiteral("TLInputUser"), TypeCodec::create<TLInputUser>());
+    codecs.insert(QStringLiteral("TLInputVideo"), TypeCodec::create<TLInputVideo>());
+    codecs.insert(QStringLiteral("TLKeyboardButton"), TypeCodec::create<TLKeyboardButton>());
+    codecs.insert(QStringLiteral("TLKeyboardButtonRow"), TypeCodec::create<TLKeyboardButtonRow>());
+    codecs.insert(QStringLiteral("TLMessageEntity"), TypeCodec::create<TLMessageEntity>());
+    codecs.insert(QStringLiteral("TLMessageGroup"), TypeCodec::create<TLMessageGroup>());
+    codecs.insert(QStringLiteral("TLMessageRange"), TypeCodec::create<TLMessageRange>());
+    codecs.insert(QStringLiteral("TLMessagesAffectedHistory"), TypeCodec::create<TLMessagesAffectedHistory>());
+    codecs.insert(QStringLiteral("TLMessagesAffectedMessages"), TypeCodec::create<TLMessagesAffectedMessages>());
+    codecs.insert(QStringLiteral("TLMessagesDhConfig"), TypeCodec::create<TLMessagesDhConfig>());
+    codecs.insert(QStringLiteral("TLMessagesFilter"), TypeCodec::create<TLMessagesFilter>());
+    codecs.insert(QStringLiteral("TLMessagesSentEncryptedMessage"), TypeCodec::create<TLMessagesSentEncryptedMessage>());
+    codecs.insert(QStringLiteral("TLNearestDc"), TypeCodec::create<TLNearestDc>());
+    codecs.insert(QStringLiteral("TLPeer"), TypeCodec::create<TLPeer>());
+    codecs.insert(QStringLiteral("TLPeerNotifyEvents"), TypeCodec::create<TLPeerNotifyEvents>());
+    codecs.insert(QStringLiteral("TLPeerNotifySettings"), TypeCodec::create<TLPeerNotifySettings>());
+    codecs.insert(QStringLiteral("TLPhotoSize"), TypeCodec::create<TLPhotoSize>());
+    codecs.insert(QStringLiteral("TLPrivacyKey"), TypeCodec::create<TLPrivacyKey>());
+    codecs.insert(QStringLiteral("TLPrivacyRule"), TypeCodec::create<TLPrivacyRule>());
+    codecs.insert(QStringLiteral("TLReceivedNotifyMessage"), TypeCodec::create<TLReceivedNotifyMessage>());
+    codecs.insert(QStringLiteral("TLReportReason"), TypeCodec::create<TLReportReason>());
+    codecs.insert(QStringLiteral("TLSendMessageAction"), TypeCodec::create<TLSendMessageAction>());
+    codecs.insert(QStringLiteral("TLStickerPack"), TypeCodec::create<TLStickerPack>());
+    codecs.insert(QStringLiteral("TLStorageFileType"), TypeCodec::create<TLStorageFileType>());
+    codecs.insert(QStringLiteral("TLUpdatesState"), TypeCodec::create<TLUpdatesState>());
+    codecs.insert(QStringLiteral("TLUploadFile"), TypeCodec::create<TLUploadFile>());
+    codecs.insert(QStringLiteral("TLUserProfilePhoto"), TypeCodec::create<TLUserProfilePhoto>());
+    codecs.insert(QStringLiteral("TLUserStatus"), TypeCodec::create<TLUserStatus>());
+    codecs.insert(QStringLiteral("TLVideo"), TypeCodec::create<TLVideo>());
+    codecs.insert(QStringLiteral("TLWallPaper"), TypeCodec::create<TLWallPaper>());
+    codecs.insert(QStringLiteral("TLAccountAuthorizations"), TypeCodec::create<TLAccountAuthorizations>());
+    codecs.insert(QStringLiteral("TLBotInlineMessage"), TypeCodec::create<TLBotInlineMessage>());
+    codecs.insert(QStringLiteral("TLChannelMessagesFilter"), TypeCodec::create<TLChannelMessagesFilter>());
+    codecs.insert(QStringLiteral("TLChatPhoto"), TypeCodec::create<TLChatPhoto>());
+    codecs.insert(QStringLiteral("TLContactStatus"), TypeCodec::create<TLContactStatus>());
+    codecs.insert(QStringLiteral("TLDcOption"), TypeCodec::create<TLDcOption>());
+    codecs.insert(QStringLiteral("TLDialog"), TypeCodec::create<TLDialog>());
+    codecs.insert(QStringLiteral("TLDocumentAttribute"), TypeCodec::create<TLDocumentAttribute>());
+    codecs.insert(QStringLiteral("TLInputBotInlineMessage"), TypeCodec::create<TLInputBotInlineMessage>());
+    codecs.insert(QStringLiteral("TLInputBotInlineResult"), TypeCodec::create<TLInputBotInlineResult>());
+    codecs.insert(QStringLiteral("TLInputChatPhoto"), TypeCodec::create<TLInputChatPhoto>());
+    codecs.insert(QStringLiteral("TLInputMedia"), TypeCodec::create<TLInputMedia>());
+    codecs.insert(QStringLiteral("TLInputNotifyPeer"), TypeCodec::create<TLInputNotifyPeer>());
+    codecs.insert(QStringLiteral("TLInputPrivacyRule"), TypeCodec::create<TLInputPrivacyRule>());
+    codecs.insert(QStringLiteral("TLNotifyPeer"), TypeCodec::create<TLNotifyPeer>());
+    codecs.insert(QStringLiteral("TLPhoto"), TypeCodec::create<TLPhoto>());
+    codecs.insert(QStringLiteral("TLReplyMarkup"), TypeCodec::create<TLReplyMarkup>());
+    codecs.insert(QStringLiteral("TLStickerSet"), TypeCodec::create<TLStickerSet>());
+    codecs.insert(QStringLiteral("TLUser"), TypeCodec::create<TLUser>());
+    codecs.insert(QStringLiteral("TLAccountPrivacyRules"), TypeCodec::create<TLAccountPrivacyRules>());
+    codecs.insert(QStringLiteral("TLAuthAuthorization"), TypeCodec::create<TLAuthAuthorization>());
+    codecs.insert(QStringLiteral("TLChannelsChannelParticipant"), TypeCodec::create<TLChannelsChannelParticipant>());
+    codecs.insert(QStringLiteral("TLChannelsChannelParticipants"), TypeCodec::create<TLChannelsChannelParticipants>());
+    codecs.insert(QStringLiteral("TLChat"), TypeCodec::create<TLChat>());
+    codecs.insert(QStringLiteral("TLChatFull"), TypeCodec::create<TLChatFull>());
+    codecs.insert(QStringLiteral("TLChatInvite"), TypeCodec::create<TLChatInvite>());
+    codecs.insert(QStringLiteral("TLConfig"), TypeCodec::create<TLConfig>());
+    codecs.insert(QStringLiteral("TLContactsBlocked"), TypeCodec::create<TLContactsBlocked>());
+    codecs.insert(QStringLiteral("TLContactsContacts"), TypeCodec::create<TLContactsContacts>());
+    codecs.insert(QStringLiteral("TLContactsFound"), TypeCodec::create<TLContactsFound>());
+    codecs.insert(QStringLiteral("TLContactsImportedContacts"), TypeCodec::create<TLContactsImportedContacts>());
+    codecs.insert(QStringLiteral("TLContactsLink"), TypeCodec::create<TLContactsLink>());
+    codecs.insert(QStringLiteral("TLContactsResolvedPeer"), TypeCodec::create<TLContactsResolvedPeer>());
+    codecs.insert(QStringLiteral("TLContactsSuggested"), TypeCodec::create<TLContactsSuggested>());
+    codecs.insert(QStringLiteral("TLDocument"), TypeCodec::create<TLDocument>());
+    codecs.insert(QStringLiteral("TLFoundGif"), TypeCodec::create<TLFoundGif>());
+    codecs.insert(QStringLiteral("TLHelpSupport"), TypeCodec::create<TLHelpSupport>());
+    codecs.insert(QStringLiteral("TLMessageAction"), TypeCodec::create<TLMessageAction>());
+    codecs.insert(QStringLiteral("TLMessagesAllStickers"), TypeCodec::create<TLMessagesAllStickers>());
+    codecs.insert(QStringLiteral("TLMessagesChatFull"), TypeCodec::create<TLMessagesChatFull>());
+    codecs.insert(QStringLiteral("TLMessagesChats"), TypeCodec::create<TLMessagesChats>());
+    codecs.insert(QStringLiteral("TLMessagesFoundGifs"), TypeCodec::create<TLMessagesFoundGifs>());
+    codecs.insert(QStringLiteral("TLMessagesSavedGifs"), TypeCodec::create<TLMessagesSavedGifs>());
+    codecs.insert(QStringLiteral("TLMessagesStickerSet"), TypeCodec::create<TLMessagesStickerSet>());
+    codecs.insert(QStringLiteral("TLMessagesStickers"), TypeCodec::create<TLMessagesStickers>());
+    codecs.insert(QStringLiteral("TLPhotosPhoto"), TypeCodec::create<TLPhotosPhoto>());
+    codecs.insert(QStringLiteral("TLPhotosPhotos"), TypeCodec::create<TLPhotosPhotos>());
+    codecs.insert(QStringLiteral("TLUserFull"), TypeCodec::create<TLUserFull>());
+    codecs.insert(QStringLiteral("TLWebPage"), TypeCodec::create<TLWebPage>());
+    codecs.insert(QStringLiteral("TLBotInlineResult"), TypeCodec::create<TLBotInlineResult>());
+    codecs.insert(QStringLiteral("TLMessageMedia"), TypeCodec::create<TLMessageMedia>());
+    codecs.insert(QStringLiteral("TLMessagesBotResults"), TypeCodec::create<TLMessagesBotResults>());
+    codecs.insert(QStringLiteral("TLMessage"), TypeCodec::create<TLMessage>());
+    codecs.insert(QStringLiteral("TLMessagesDialogs"), TypeCodec::create<TLMessagesDialogs>());
+    codecs.insert(QStringLiteral("TLMessagesMessages"), TypeCodec::create<TLMessagesMessages>());
+    codecs.insert(QStringLiteral("TLUpdate"), TypeCodec::create<TLUpdate>());
+    codecs.insert(QStringLiteral("TLUpdates"), TypeCodec::create<TLUpdates>());
+    codecs.insert(QStringLiteral("TLUpdatesChannelDifference"), TypeCodec::create<TLUpdatesChannelDifference>());
+    codecs.insert(QStringLiteral("TLUpdatesDifference"), TypeCodec::create<TLUpdatesDifference>());
+    // End of generated corpus codecs
+    return codecs;
+}
+
+class tst_CTelegramStreamCorpus : public QObject
+{
+    Q_OBJECT
+public:
+    explicit tst_CTelegramStreamCorpus(QObject *parent = nullptr);
+
+private slots:
+    void initTestCase();
+    void roundTrip_data();
+    void roundTrip();
+    void truncatedInput_data();
+    void truncatedInput();
+    void malformedInput_data();
+    void malformedInput();
+    void decodingBenchmark_data();
+    void decodingBenchmark();
+    void encodingBenchmark_data();
+    void encodingBenchmark();
+
+protected:
+    void addTypeRows();
+    void resetWriter(const QString &typeName);
+
+    QScopedPointer<CorpusWriter> m_writer;
+    QHash<QString, TypeCodec> m_codecs;
+};
+
+tst_CTelegramStreamCorpus::tst_CTelegramStreamCorpus(QObject *parent) :
+    QObject(parent)
+{
+}
+
+void tst_CTelegramStreamCorpus::initTestCase()
+{
+    QFile schemeFile(QStringLiteral(TELEGRAMQT_SCHEME_FILE));
+    QVERIFY2(schemeFile.open(QIODevice::ReadOnly), qPrintable(schemeFile.fileName()));
+
+    Generator generator;
+    QVERIFY(generator.loadFromText(schemeFile.readAll()));
+    QVERIFY(generator.resolveTypes());
+
+    m_writer.reset(new CorpusWriter(generator.solvedTypes()));
+    m_codecs = typeCodecs();
+    QVERIFY(!m_codecs.isEmpty());
+
+    for (const QString &typeName : m_codecs.keys()) {
+        QVERIFY2(m_writer->hasType(typeName), qPrintable(typeName));
+    }
+}
+
+void tst_CTelegramStreamCorpus::addTypeRows()
+{
+    QTest::addColumn<QString>("typeName");
+
+    QStringList typeNames = m_codecs.keys();
+    typeNames.sort();
+    for (const QString &typeName : typeNames) {
+        QTest::newRow(typeName.toLatin1().constData()) << typeName;
+    }
+}
+
+void tst_CTelegramStreamCorpus::resetWriter(const QString &typeName)
+{
+    // Per-type seed to get the same corpus regardless of the tests order and filtering
+    m_writer->reset(c_seed ^ qHash(typeName));
+}
+
+void tst_CTelegramStreamCorpus::roundTrip_data()
+{
+    addTypeRows();
+}
+
+void tst_CTelegramStreamCorpus::roundTrip()
+{
+    QFETCH(QString, typeName);
+    const TypeCodec codec = m_codecs.value(typeName);
+    resetWriter(typeName);
+
+    for (int i = 0; i < c_roundTripInstances; ++i) {
+        const QByteArray data = m_writer->randomValue(typeName);
+        QVERIFY(m_writer->isValid());
+
+        QByteArray encoded;
+        QVERIFY2(codec.roundTrip(data, &encoded), data.toHex().constData());
+        QCOMPARE(encoded.toHex(), data.toHex());
+    }
+}
+
+void tst_CTelegramStreamCorpus::truncatedInput_data()
+{
+    addTypeRows();
+}
+
+void tst_CTelegramStreamCorpus::truncatedInput()
+{
+    QFETCH(QString, typeName);
+    const TypeCodec codec = m_codecs.value(typeName);
+    resetWriter(typeName);
+
+    for (int i = 0; i < c_truncatedInstances; ++i) {
+        const QByteArray data = m_writer->randomValue(typeName);
+        const int step = qMax(1, data.size() / 64);
+        for (int length = 0; length < data.size(); length += step) {
+            QVERIFY2(!codec.decode(data.left(length)), qPrintable(QStringLiteral("Truncated to %1 of %2 bytes").arg(length).arg(data.size())));
+        }
+    }
+}
+
+void tst_CTelegramStreamCorpus::malformedInput_data()
+{
+    addTypeRows();
+}
+
+void tst_CTelegramStreamCorpus::malformedInput()
+{
+    // The decoders have to stop on any input; the result does not matter
+    QFETCH(QString, typeName);
+    const TypeCodec codec = m_codecs.value(typeName);
+    resetWriter(typeName);
+    std::mt19937 random(c_seed);
+
+    static const quint32 specialWords[] = { 0, 0xfe, 0xff, 0xffffff, 0xfffffffe, 0xffffffff, TLValue::Vector, TLValue::BoolTrue };
+
+    for (int i = 0; i < c_malformedInstances; ++i) {
+        QByteArray data = m_writer->randomValue(typeName);
+        const int mutations = 1 + random() % 4;
+        for (int j = 0; j < mutations; ++j) {
+            const int position = random() % data.size();
+            if (random() & 1) {
+                data[position] = char(random());
+            } else {
+                const quint32 word = specialWords[random() % (sizeof(specialWords) / sizeof(specialWords[0]))];
+                data.replace(position & ~3, 4, reinterpret_cast<const char*>(&word), 4);
+            }
+        }
+        codec.decode(data);
+        codec.decode(data.mid(4)); // Misaligned constructor id
+    }
+}
+
+void tst_CTelegramStreamCorpus::decodingBenchmark_data()
+{
+    addTypeRows();
+}
+
+void tst_CTelegramStreamCorpus::decodingBenchmark()
+{
+    QFETCH(QString, typeName);
+    resetWriter(typeName);
+    const QByteArray corpus = m_writer->randomValues(typeName, c_benchmarkInstances);
+    m_codecs.value(typeName).benchmarkDecoding(corpus, c_benchmarkInstances);
+}
+
+void tst_CTelegramStreamCorpus::encodingBenchmark_data()
+{
+    addTypeRows();
+}
+
+void tst_CTelegramStreamCorpus::encodingBenchmark()
+{
+    QFETCH(QString, typeName);
+    resetWriter(typeName);
+    const QByteArray corpus = m_writer->randomValues(typeName, c_benchmarkInstances);
+    m_codecs.value(typeName).benchmarkEncoding(corpus, c_benchmarkInstances);
+}
+
+QTEST_APPLESS_MAIN(tst_CTelegramStreamCorpus)
+
+#include "tst_CTelegramStreamCorpus.moc"
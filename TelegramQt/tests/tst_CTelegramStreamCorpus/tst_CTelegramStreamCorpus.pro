@@ -0,0 +1,14 @@
+include(../tests.pri)
+
+TARGET = tst_telegramstreamcorpus
+SOURCES = tst_CTelegramStreamCorpus.cpp
+
+# The corpus values are built from the generator type model
+INCLUDEPATH += $$PWD/../../../generator
+SOURCES += $$PWD/../../../generator/Generator.cpp
+HEADERS += $$PWD/../../../generator/Generator.hpp
+
+DEFINES += TELEGRAMQT_SCHEME_FILE=\\\"$$PWD/../../../generator/scheme-45.tl\\\"
+
+CONFIG += link_pkgconfig
+PKGCONFIG += zlib
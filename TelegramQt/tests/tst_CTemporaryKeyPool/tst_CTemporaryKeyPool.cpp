@@ -0,0 +1,111 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#include <QObject>
+
+#include "CTemporaryKeyPool.hpp"
+
+#include <QTest>
+#include <QDebug>
+
+static const quint32 c_now = 1500000000;
+static const quint32 c_minLifetime = 3600;
+
+static CTemporaryKeyPool::Key makeKey(const char *data, quint32 expiresAt)
+{
+    CTemporaryKeyPool::Key key;
+    key.authKey = QByteArray(data);
+    key.expiresAt = expiresAt;
+    return key;
+}
+
+class tst_CTemporaryKeyPool : public QObject
+{
+    Q_OBJECT
+public:
+    explicit tst_CTemporaryKeyPool(QObject *parent = nullptr);
+
+private slots:
+    void emptyPool();
+    void takeEarliestUsable();
+    void perDc();
+    void removeExpired();
+
+};
+
+tst_CTemporaryKeyPool::tst_CTemporaryKeyPool(QObject *parent) :
+    QObject(parent)
+{
+}
+
+void tst_CTemporaryKeyPool::emptyPool()
+{
+    CTemporaryKeyPool pool(2, c_minLifetime);
+    QCOMPARE(pool.count(1, c_now), 0);
+    QCOMPARE(pool.missingCount(1, c_now), 2);
+    QVERIFY(!pool.take(1, c_now).isValid());
+
+    pool.add(1, CTemporaryKeyPool::Key()); // Invalid keys are ignored
+    QCOMPARE(pool.count(1, c_now), 0);
+}
+
+void tst_CTemporaryKeyPool::takeEarliestUsable()
+{
+    CTemporaryKeyPool pool(2, c_minLifetime);
+    pool.add(1, makeKey("late", c_now + 86400));
+    pool.add(1, makeKey("early", c_now + 7200));
+    pool.add(1, makeKey("short", c_now + 600)); // Lives less than the minimal lifetime
+    QCOMPARE(pool.count(1, c_now), 2);
+    QCOMPARE(pool.missingCount(1, c_now), 0);
+
+    QCOMPARE(pool.take(1, c_now).authKey, QByteArray("early"));
+    QCOMPARE(pool.missingCount(1, c_now), 1);
+    QCOMPARE(pool.take(1, c_now).authKey, QByteArray("late"));
+    QVERIFY(!pool.take(1, c_now).isValid());
+}
+
+void tst_CTemporaryKeyPool::perDc()
+{
+    CTemporaryKeyPool pool(1, c_minLifetime);
+    pool.add(1, makeKey("dc1", c_now + 86400));
+    pool.add(2, makeKey("dc2", c_now + 86400));
+    QCOMPARE(pool.count(1, c_now), 1);
+    QCOMPARE(pool.count(3, c_now), 0);
+
+    QCOMPARE(pool.take(2, c_now).authKey, QByteArray("dc2"));
+    QCOMPARE(pool.count(1, c_now), 1);
+    QCOMPARE(pool.count(2, c_now), 0);
+}
+
+void tst_CTemporaryKeyPool::removeExpired()
+{
+    CTemporaryKeyPool pool(2, c_minLifetime);
+    pool.add(1, makeKey("first", c_now + 7200));
+    pool.add(1, makeKey("second", c_now + 86400));
+
+    pool.removeExpired(c_now + 3600);
+    QCOMPARE(pool.count(1, c_now + 3600), 1);
+    QCOMPARE(pool.take(1, c_now).authKey, QByteArray("second")); // The first one is removed
+
+    pool.add(1, makeKey("third", c_now + 86400));
+    pool.clear();
+    QCOMPARE(pool.count(1, c_now), 0);
+}
+
+QTEST_MAIN(tst_CTemporaryKeyPool)
+
+#include "tst_CTemporaryKeyPool.moc"
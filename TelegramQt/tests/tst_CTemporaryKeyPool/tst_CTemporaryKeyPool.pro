@@ -0,0 +1,4 @@
+include(../tests.pri)
+
+TARGET = tst_temporarykeypool
+SOURCES = tst_CTemporaryKeyPool.cpp
@@ -27,6 +27,28 @@
 
 using namespace Telegram;
 
+struct PqSample {
+    quint64 pq;
+    quint64 p;
+    quint64 q;
+};
+
+// Products of two 31-32 bit primes, fitting 63 bits like the pq values sent by the servers
+static const PqSample c_pqCorpus[] = {
+    { 0x17ed48941a08f981ull, 1229739323ull, 1402015859ull }, // The example from the MTProto documentation
+    { 0x658a4eaf6bdfac9dull, 2041101157ull, 3584705753ull },
+    { 0x47c50d667c9e2a69ull, 1302776399ull, 3969640903ull },
+    { 0x33c9fa5683f0523dull, 1659381877ull, 2248903081ull },
+    { 0x3f1f4a136111a0a7ull, 1178779937ull, 3858596039ull },
+    { 0x3029109bfdf2a9c5ull, 1232480111ull, 2815723531ull },
+    { 0x644fa3d25509b3f1ull, 1890284423ull, 3823856327ull },
+    { 0x3c4a244cc3621a3full, 1786909451ull, 2431194653ull },
+    { 0x4eaba61265168f9bull, 1928047447ull, 2940180317ull },
+    { 0x46f20ce2228c2ab5ull, 1750797859ull, 2919904583ull },
+    { 0x2ce6bdacd4341617ull, 1342951243ull, 2409232613ull },
+    { 0x493ae32a8cdcd66bull, 1516382579ull, 3479847209ull },
+};
+
 class tst_utils : public QObject
 {
     Q_OBJECT
@@ -42,6 +64,9 @@ private slots:
     void testRsaEncryption();
     void testRsaKey();
     void testRsaKeyIsValid();
+    void findDivider_data();
+    void findDivider();
+    void findDividerBenchmark();
 };
 
 tst_utils::tst_utils(QObject *parent) :
@@ -148,6 +173,41 @@ void tst_utils::testRsaKeyIsValid()
     QVERIFY2(!key.isValid(), "A key without a modulus is not valid");
 }
 
+void tst_utils::findDivider_data()
+{
+    QTest::addColumn<quint64>("pq");
+    QTest::addColumn<quint64>("p");
+    QTest::addColumn<quint64>("q");
+
+    for (const PqSample &sample : c_pqCorpus) {
+        QTest::newRow(QByteArray::number(sample.pq, 16).constData()) << sample.pq << sample.p << sample.q;
+    }
+    QTest::newRow("small") << quint64(15) << quint64(3) << quint64(5);
+    QTest::newRow("even") << quint64(2 * 1229739323ull) << quint64(2) << quint64(1229739323ull);
+}
+
+void tst_utils::findDivider()
+{
+    QFETCH(quint64, pq);
+    QFETCH(quint64, p);
+    QFETCH(quint64, q);
+
+    const quint64 divider = Utils::findDivider(pq);
+    QVERIFY2((divider == p) || (divider == q), QByteArray::number(divider).constData());
+    QCOMPARE(Utils::findDivider(pq), divider); // Deterministic
+}
+
+void tst_utils::findDividerBenchmark()
+{
+    quint64 sum = 0;
+    QBENCHMARK {
+        for (const PqSample &sample : c_pqCorpus) {
+            sum += Utils::findDivider(sample.pq);
+        }
+    }
+    QVERIFY(sum > 0);
+}
+
 QTEST_APPLESS_MAIN(tst_utils)
 
 #include "tst_utils.moc"
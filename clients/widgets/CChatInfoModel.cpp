@@ -26,7 +26,7 @@ CChatInfoModel::CChatInfoModel(CTelegramCore *backend, QObject *parent) :
 {
     setBackend(backend);
     connect(m_backend, SIGNAL(peerAdded(Telegram::Peer)), this, SLOT(onPeerAdded(Telegram::Peer)));
-    connect(m_backend, SIGNAL(chatChanged(quint32)), SLOT(onChatChanged(quint32)));
+    connect(m_backend, SIGNAL(chatsChanged(QVector<quint32>)), SLOT(onChatsChanged(QVector<quint32>)));
 }
 
 bool CChatInfoModel::hasPeer(const Telegram::Peer peer) const
@@ -197,6 +197,13 @@ void CChatInfoModel::onChatChanged(quint32 id)
     emit nameChanged(m_chats.at(i).peer());
 }
 
+void CChatInfoModel::onChatsChanged(const QVector<quint32> &ids)
+{
+    for (quint32 id : ids) {
+        onChatChanged(id);
+    }
+}
+
 void CChatInfoModel::updatePeerPicture(const PeerPicture &picture)
 {
     for (int i = 0; i < m_chats.count(); ++i) {
@@ -68,6 +68,7 @@ signals:
 protected slots:
     void onPeerAdded(const Telegram::Peer &peer);
     void onChatChanged(quint32 id);
+    void onChatsChanged(const QVector<quint32> &ids);
 
 protected:
     void updatePeerPicture(const PeerPicture &picture) override;
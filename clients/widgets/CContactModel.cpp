@@ -199,6 +199,33 @@ void CContactModel::addContact(quint32 id)
     endInsertRows();
 }
 
+void CContactModel::addContacts(const QVector<quint32> &ids)
+{
+    QSet<quint32> knownIds;
+    knownIds.reserve(m_contacts.count() + ids.count());
+    for (const SContact &contact : m_contacts) {
+        knownIds.insert(contact.id());
+    }
+
+    QVector<quint32> newIds;
+    for (quint32 id : ids) {
+        if (!knownIds.contains(id)) {
+            knownIds.insert(id);
+            newIds.append(id);
+        }
+    }
+    if (newIds.isEmpty()) {
+        return;
+    }
+    qDebug() << Q_FUNC_INFO << newIds;
+
+    beginInsertRows(QModelIndex(), m_contacts.count(), m_contacts.count() + newIds.count() - 1);
+    for (quint32 id : newIds) {
+        addContactId(id);
+    }
+    endInsertRows();
+}
+
 bool CContactModel::removeContact(quint32 id)
 {
     int contactIndex = indexOfContact(id);
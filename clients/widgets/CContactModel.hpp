@@ -82,6 +82,7 @@ public:
 
 public slots:
     void addContact(quint32 id);
+    void addContacts(const QVector<quint32> &ids);
     bool removeContact(quint32 id);
     void setContactList(const QVector<quint32> &newContactList);
     void setTypingStatus(quint32 id, TelegramNamespace::MessageAction action);
@@ -129,8 +129,8 @@ MainWindow::MainWindow(QWidget *parent) :
             SLOT(updateContactList()));
     connect(m_core, SIGNAL(dialogsChanged(QVector<Telegram::Peer>,QVector<Telegram::Peer>)),
             m_dialogModel, SLOT(syncDialogs(QVector<Telegram::Peer>,QVector<Telegram::Peer>)));
-    connect(m_core, SIGNAL(messageReceived(Telegram::Message)),
-            SLOT(onMessageReceived(Telegram::Message)));
+    connect(m_core, SIGNAL(messagesReceived(QVector<Telegram::Message>)),
+            SLOT(onMessagesReceived(QVector<Telegram::Message>)));
     connect(m_core, SIGNAL(contactChatMessageActionChanged(quint32,quint32,TelegramNamespace::MessageAction)),
             SLOT(onContactChatMessageActionChanged(quint32,quint32,TelegramNamespace::MessageAction)));
     connect(m_core, SIGNAL(contactMessageActionChanged(quint32,TelegramNamespace::MessageAction)),
@@ -147,7 +147,7 @@ MainWindow::MainWindow(QWidget *parent) :
             SLOT(onUserNameStatusUpdated(QString,TelegramNamespace::UserNameStatus)));
 
     connect(m_core, &CTelegramCore::selfUserAvailable, m_contactsModel, &CContactModel::addContact);
-    connect(m_core, &CTelegramCore::userInfoReceived, m_contactsModel, &CContactModel::addContact);
+    connect(m_core, &CTelegramCore::usersInfoReceived, m_contactsModel, &CContactModel::addContacts);
 
 //    connect(m_chatInfoModel, SIGNAL(chatAdded(quint32)), SLOT(onChatAdded(quint32)));
     connect(m_chatInfoModel, SIGNAL(chatChanged(quint32)), SLOT(onChatChanged(quint32)));
@@ -312,6 +312,13 @@ void MainWindow::onMessageReceived(const Telegram::Message &message)
     }
 }
 
+void MainWindow::onMessagesReceived(const QVector<Telegram::Message> &messages)
+{
+    for (const Telegram::Message &message : messages) {
+        onMessageReceived(message);
+    }
+}
+
 void MainWindow::onContactChatMessageActionChanged(quint32 chatId, quint32 userId, TelegramNamespace::MessageAction action)
 {
     if (m_activeChatId != chatId) {
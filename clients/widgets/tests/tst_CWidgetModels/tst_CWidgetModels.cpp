@@ -0,0 +1,181 @@
+/*
+   Copyright (C) 2017 Alexandr Akulich <akulichalexander@gmail.com>
+
+   This file is a part of TelegramQt library.
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+ */
+
+#include <QObject>
+
+#include "CTelegramCore.hpp"
+#include "CContactModel.hpp"
+#include "CFileManager.hpp"
+#include "CMessageModel.hpp"
+
+#include <QApplication>
+#include <QTest>
+#include <QDebug>
+
+// Emits the updates the way CTelegramCore does: either per item or batched.
+class CUpdatesSender : public QObject
+{
+    Q_OBJECT
+public:
+    explicit CUpdatesSender(QObject *parent = nullptr) :
+        QObject(parent)
+    {
+    }
+
+    void send(const QVector<quint32> &userIds, const QVector<Telegram::Message> &messages, bool batched)
+    {
+        if (batched) {
+            emit usersInfoReceived(userIds);
+            emit messagesReceived(messages);
+            return;
+        }
+        for (quint32 userId : userIds) {
+            emit userInfoReceived(userId);
+        }
+        for (const Telegram::Message &message : messages) {
+            emit messageReceived(message);
+        }
+    }
+
+signals:
+    void userInfoReceived(quint32 userId);
+    void usersInfoReceived(const QVector<quint32> &userIds);
+    void messageReceived(const Telegram::Message &message);
+    void messagesReceived(const QVector<Telegram::Message> &messages);
+
+};
+
+class tst_CWidgetModels : public QObject
+{
+    Q_OBJECT
+public:
+    explicit tst_CWidgetModels(QObject *parent = nullptr);
+
+private slots:
+    void addContacts();
+    void modelsBenchmark_data();
+    void modelsBenchmark();
+
+};
+
+tst_CWidgetModels::tst_CWidgetModels(QObject *parent) :
+    QObject(parent)
+{
+}
+
+static QVector<Telegram::Message> constructTextMessages(const QVector<quint32> &userIds, int count)
+{
+    QVector<Telegram::Message> messages;
+    messages.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        Telegram::Message message;
+        message.id = i + 1;
+        message.fromId = userIds.at(i % userIds.count());
+        message.setPeer(Telegram::Peer(message.fromId, Telegram::Peer::User));
+        message.timestamp = 1500000000 + i;
+        message.type = TelegramNamespace::MessageTypeText;
+        message.text = QStringLiteral("Message %1").arg(i);
+        messages.append(message);
+    }
+    return messages;
+}
+
+static QVector<quint32> constructUserIds(int count)
+{
+    QVector<quint32> userIds;
+    userIds.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        userIds.append(1000 + i);
+    }
+    return userIds;
+}
+
+static void deliverQueuedSignals(const QAbstractItemModel *model, int expectedCount)
+{
+    for (int i = 0; (i < 10) && (model->rowCount() < expectedCount); ++i) {
+        QCoreApplication::processEvents();
+    }
+}
+
+void tst_CWidgetModels::addContacts()
+{
+    CTelegramCore core;
+    CFileManager fileManager(&core);
+    CContactModel model(&core);
+    model.setFileManager(&fileManager);
+
+    model.addContacts({ 30, 10, 20, 10 });
+    QCOMPARE(model.rowCount(), 3);
+    model.addContact(20);
+    model.addContacts({ 20, 40 });
+    QCOMPARE(model.rowCount(), 4);
+    QCOMPARE(model.indexOfContact(40), 3);
+}
+
+void tst_CWidgetModels::modelsBenchmark_data()
+{
+    QTest::addColumn<bool>("batched");
+
+    QTest::newRow("per item signals") << false;
+    QTest::newRow("batched signals") << true;
+}
+
+void tst_CWidgetModels::modelsBenchmark()
+{
+    QFETCH(bool, batched);
+    const QVector<quint32> userIds = constructUserIds(200);
+    const QVector<Telegram::Message> messages = constructTextMessages(userIds, 2000);
+
+    CTelegramCore core;
+    CFileManager fileManager(&core);
+    CContactModel contactModel(&core);
+    contactModel.setFileManager(&fileManager);
+    CMessageModel messageModel(&core);
+    messageModel.setFileManager(&fileManager);
+    messageModel.setContactsModel(&contactModel);
+
+    // Queued connections as of the client receiving the updates from CTelegramCore
+    CUpdatesSender sender;
+    if (batched) {
+        connect(&sender, &CUpdatesSender::usersInfoReceived, &contactModel, &CContactModel::addContacts, Qt::QueuedConnection);
+        connect(&sender, &CUpdatesSender::messagesReceived, &messageModel,
+                [&messageModel](const QVector<Telegram::Message> &messages) {
+            for (const Telegram::Message &message : messages) {
+                messageModel.addMessage(message);
+            }
+        }, Qt::QueuedConnection);
+    } else {
+        connect(&sender, &CUpdatesSender::userInfoReceived, &contactModel, &CContactModel::addContact, Qt::QueuedConnection);
+        connect(&sender, &CUpdatesSender::messageReceived, &messageModel,
+                [&messageModel](const Telegram::Message &message) {
+            messageModel.addMessage(message);
+        }, Qt::QueuedConnection);
+    }
+
+    QBENCHMARK {
+        contactModel.clear();
+        messageModel.clear();
+        sender.send(userIds, messages, batched);
+        deliverQueuedSignals(&messageModel, messages.count());
+    }
+    QCOMPARE(contactModel.rowCount(), userIds.count());
+    QCOMPARE(messageModel.rowCount(), messages.count());
+}
+
+QTEST_MAIN(tst_CWidgetModels)
+
+#include "tst_CWidgetModels.moc"
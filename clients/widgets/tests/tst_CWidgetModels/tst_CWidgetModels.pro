@@ -0,0 +1,22 @@
+QT += core gui widgets network testlib
+TEMPLATE = app
+CONFIG += c++11
+
+INCLUDEPATH += $$PWD/../..
+INCLUDEPATH += $$PWD/../../../../TelegramQt
+
+LIBS += -lssl -lcrypto -lz
+LIBS += -L$$OUT_PWD/../../../../TelegramQt
+LIBS += -lTelegramQt$${QT_MAJOR_VERSION}
+
+TARGET = tst_widgetmodels
+SOURCES = tst_CWidgetModels.cpp \
+    ../../CFileManager.cpp \
+    ../../CPeerModel.cpp \
+    ../../CContactModel.cpp \
+    ../../CMessageModel.cpp
+
+HEADERS += ../../CFileManager.hpp \
+    ../../CPeerModel.hpp \
+    ../../CContactModel.hpp \
+    ../../CMessageModel.hpp
@@ -31,6 +31,7 @@ static const QString tlValueName = tlPrefix + QLatin1String("Value");
 static const QString tlTypeMember = QLatin1String("tlType");
 static const QString tlVectorType = QLatin1String("TLVector");
 static const QString tlTrueType = QLatin1String("TLTrue");
+static const QString tlStringType = QLatin1String("TLString");
 static const QStringList podTypes = QStringList() << "bool" << "quint32" << "quint64" << "double" << tlValueName;
 static const QStringList initTypesValues = QStringList() << "false" << "0" << "0" << "0" << "0";
 static const QStringList plainTypes = QStringList() << "Bool" << "#" << "int" << "long" << "double" << "string" << "bytes"
@@ -40,8 +41,19 @@ static const QStringList plainTypes = QStringList() << "Bool" << "#" << "int" <<
 static const QStringList nativeTypes = QStringList() << "bool" << "quint32" << "quint32" << "quint64" << "double" << "QString" << "QByteArray"
                                                      << QStringLiteral("TLNumber128")
                                                      << QStringLiteral("TLNumber256")
+                                                     << tlStringType
                                                         ;
 
+static const QStringList fixedLayoutTypes = QStringList() << "quint32" << "quint64" << "double"
+                                                          << QStringLiteral("TLNumber128")
+                                                          << QStringLiteral("TLNumber256")
+                                                             ;
+static const QList<int> fixedLayoutSizes = QList<int>() << 4 << 8 << 8 << 16 << 32;
+
+static const QStringList tableFieldTypes = QStringList() << "quint32" << "quint64" << "double" << "bool" << "QString" << "QByteArray";
+static const QStringList tableFieldKinds = QStringList() << "UInt32" << "UInt64" << "Double" << "Bool" << "String" << "Bytes";
+
+
 static const QString spacing = QString(4, QLatin1Char(' '));
 static const QString doubleSpacing = spacing + spacing;
 
@@ -55,6 +67,11 @@ static const QStringList typesBlackList = QStringList()
         << tlTrueType
            ;
 
+// Types with hand-written CTelegramStream write operators
+static const QStringList typesWithCustomWriters = QStringList()
+        << QLatin1String("TLDcOption")
+           ;
+
 QString ensureGoodName(const QString &name, const QVariantHash &context)
 {
     static const QStringList badNames = QStringList()
@@ -515,6 +532,7 @@ QString Generator::generateTLTypeDefinition(const TLType &type, bool addSpecSour
         code.append(memberFlags);
         code.append(spacing + "};\n");
     }
+    code.append(joinLinesWithPrepend(generateTLTypeFixedSizes(type), spacing));
     if (constExpr) {
         code.append(joinLinesWithPrepend(generateTLTypeMemberGetters(type), spacing + constExprSpace));
     } else {
@@ -550,6 +568,40 @@ QStringList Generator::generateTLTypeMemberFlags(const TLType &type)
     return result;
 }
 
+int Generator::fixedLayoutSize(const TLSubType &subType)
+{
+    int size = 4; // The type id
+    foreach (const TLParam &member, subType.members) {
+        if (member.dependOnFlag() && (member.type() == tlTrueType)) {
+            continue; // No extra data behind the flag
+        }
+        if (member.dependOnFlag() || member.accessByPointer()) {
+            return -1;
+        }
+        const int typeIndex = fixedLayoutTypes.indexOf(member.type());
+        if (typeIndex < 0) {
+            return -1;
+        }
+        size += fixedLayoutSizes.at(typeIndex);
+    }
+    return size;
+}
+
+QStringList Generator::generateTLTypeFixedSizes(const TLType &type)
+{
+    QStringList sizes;
+    foreach (const TLSubType &subType, type.subTypes) {
+        if (subType.members.isEmpty()) {
+            continue;
+        }
+        const int size = fixedLayoutSize(subType);
+        if (size > 0) {
+            sizes.append(QStringLiteral("static constexpr quint32 %1Size = %2;").arg(subType.name).arg(size));
+        }
+    }
+    return sizes;
+}
+
 QStringList Generator::generateTLTypeMemberGetters(const TLType &type)
 {
     QStringList memberGetters;
@@ -617,6 +669,19 @@ QString Generator::streamReadPerTypeImplementation(const QString &argName, const
 {
     Q_UNUSED(argName)
     QString code;
+    if (fixedLayoutSize(subType) > 0) {
+        QStringList members;
+        foreach (const TLParam &member, subType.members) {
+            if (member.type() != tlTrueType) {
+                members.append(QStringLiteral("result.") + member.getAlias());
+            }
+        }
+        if (members.count() > 1) {
+            code.append(doubleSpacing + QString("readFixedLayout(%1);\n").arg(members.join(QLatin1String(", "))));
+            code.append(QString("%1break;\n").arg(doubleSpacing));
+            return code;
+        }
+    }
     foreach (const TLParam &member, subType.members) {
         if (member.dependOnFlag()) {
             if (member.type() == tlTrueType) {
@@ -685,6 +750,20 @@ QString Generator::streamWritePerTypeFreeImplementation(const QString &argName,
 QString Generator::streamWritePerTypeImplementationBase(const QString &argName, const TLSubType &subType, const QString &streamGetter)
 {
     QString code;
+    if (fixedLayoutSize(subType) > 0) {
+        QStringList members;
+        foreach (const TLParam &member, subType.members) {
+            if (member.type() != tlTrueType) {
+                members.append(argName + QLatin1Char('.') + member.getAlias());
+            }
+        }
+        if (members.count() > 1) {
+            const QString writer = streamGetter == QLatin1String("*this") ? QStringLiteral("writeFixedLayout") : streamGetter + QStringLiteral(".writeFixedLayout");
+            code.append(doubleSpacing + QString("%1(%2);\n").arg(writer, members.join(QLatin1String(", "))));
+            code.append(QString("%1break;\n").arg(doubleSpacing));
+            return code;
+        }
+    }
     foreach (const TLParam &member, subType.members) {
         if (member.dependOnFlag()) {
             if (member.type() == tlTrueType) {
@@ -705,6 +784,53 @@ QString Generator::streamWritePerTypeImplementationBase(const QString &argName,
     return code;
 }
 
+QString Generator::serializedSizeImplementationHead(const QString &argName, const QString &typeName)
+{
+    QString code;
+    code.append(QString("quint32 %1::serializedSize(const %2 &%3)\n{\n").arg(streamClassName, typeName, argName));
+    code.append(QString("%1quint32 size = 4;\n\n%1switch (%2.tlType) {\n").arg(spacing, argName));
+    return code;
+}
+
+QString Generator::serializedSizeImplementationEnd(const QString &argName)
+{
+    Q_UNUSED(argName)
+
+    QString code;
+    code.append(QString("%1default:\n%1%1break;\n%1}\n\n").arg(spacing));
+    code.append(spacing + QString("return size;\n}\n\n"));
+    return code;
+}
+
+QString Generator::serializedSizePerTypeImplementation(const QString &argName, const TLSubType &subType, const QString &typeName)
+{
+    QString code;
+    if (!subType.members.isEmpty() && (fixedLayoutSize(subType) > 0)) {
+        // The size is known at compile time (see generateTLTypeFixedSizes())
+        code.append(doubleSpacing + QString("size = %1::%2Size;\n").arg(typeName, subType.name));
+        code.append(QString("%1break;\n").arg(doubleSpacing));
+        return code;
+    }
+    foreach (const TLParam &member, subType.members) {
+        if (member.dependOnFlag()) {
+            if (member.type() == tlTrueType) {
+                continue;
+            }
+            code.append(doubleSpacing + QString("if (%1.%2 & 1 << %3) {\n").arg(argName).arg(member.flagMember).arg(member.flagBit));
+            code.append(doubleSpacing + spacing + QString("size += serializedSize(%1.%2);\n").arg(argName).arg(member.getAlias()));
+            code.append(doubleSpacing + QLatin1Literal("}\n"));
+        } else {
+            if (member.accessByPointer() && !member.isVector()) {
+                code.append(doubleSpacing + QString("size += serializedSize(*%1.%2);\n").arg(argName).arg(member.getAlias()));
+            } else {
+                code.append(doubleSpacing + QString("size += serializedSize(%1.%2);\n").arg(argName).arg(member.getAlias()));
+            }
+        }
+    }
+    code.append(QString("%1break;\n").arg(doubleSpacing));
+    return code;
+}
+
 QString Generator::generateStreamOperatorDefinition(const TLType &type, std::function<QString (const QString &, const QString &)> head,
                                                     std::function<QString (const QString &, const TLSubType &)> generateSubtypeCode,
                                                     std::function<QString (const QString &)> end)
@@ -761,6 +887,92 @@ QString Generator::generateStreamReadOperatorDefinition(const TLType &type)
     return generateStreamOperatorDefinition(type, streamReadImplementationHead, streamReadPerTypeImplementation, streamReadImplementationEnd);
 }
 
+QString Generator::tableFieldAccessor(const QString &typeName, const QString &memberName)
+{
+    // A member pointer template argument instead of offsetof(), which is not defined for the TL types (not standard-layout)
+    return QStringLiteral("&fieldAddress<%1, decltype(%1::%2), &%1::%2>").arg(typeName, memberName);
+}
+
+QString Generator::generateStreamReadTableDefinition(const TLType &type)
+{
+    QString prefix = removePrefix(type.name);
+    prefix[0] = prefix.at(0).toLower();
+    const QString argName = prefix + QLatin1String("Value");
+    const QString fieldsName = QStringLiteral("s_%1Fields").arg(prefix);
+    const QString constructorsName = QStringLiteral("s_%1Constructors").arg(prefix);
+    const QString descriptorName = QStringLiteral("s_%1Descriptor").arg(prefix);
+
+    QStringList fieldBlocks; // Constructors with the same fields share the descriptors
+    QList<int> fieldBlockIndices;
+    QString fields;
+    QString constructors;
+    int fieldsCount = 0;
+
+    foreach (const TLSubType &subType, type.subTypes) {
+        QString block;
+        int blockSize = 0;
+        foreach (const TLParam &member, subType.members) {
+            if (member.dependOnFlag() && (member.type() == tlTrueType)) {
+                continue; // No extra data behind the flag
+            }
+            QString kind = QStringLiteral("Custom");
+            QString reader = QStringLiteral("nullptr");
+            const int typeIndex = tableFieldTypes.indexOf(member.type());
+            if (member.accessByPointer()) {
+                if (member.isVector()) {
+                    reader = QStringLiteral("&readField<%1<%2*> >").arg(tlVectorType, member.bareType());
+                } else {
+                    reader = QStringLiteral("&readPointerField<%1>").arg(member.type());
+                }
+            } else if (typeIndex >= 0) {
+                kind = tableFieldKinds.at(typeIndex);
+            } else {
+                reader = QStringLiteral("&readField<%1>").arg(member.type());
+            }
+            QString flag = QStringLiteral("-1, nullptr");
+            if (member.dependOnFlag()) {
+                flag = QStringLiteral("%1, %2").arg(member.flagBit).arg(tableFieldAccessor(type.name, member.flagMember));
+            }
+            block += spacing + QStringLiteral("{ %1, TLFieldDescriptor::%2, %3, %4 },\n").arg(tableFieldAccessor(type.name, member.getAlias()), kind, flag, reader);
+            ++blockSize;
+        }
+        int blockIndex = 0;
+        if (blockSize) {
+            const int existIndex = fieldBlocks.indexOf(block);
+            if (existIndex >= 0) {
+                blockIndex = fieldBlockIndices.at(existIndex);
+            } else {
+                blockIndex = fieldsCount;
+                fieldBlocks.append(block);
+                fieldBlockIndices.append(blockIndex);
+                fields += block;
+                fieldsCount += blockSize;
+            }
+        }
+        constructors += spacing + QStringLiteral("{ %1::%2, %3, %4 },\n").arg(tlValueName, subType.name).arg(blockIndex).arg(blockSize);
+    }
+
+    QString code;
+    if (fieldsCount) {
+        code += QStringLiteral("static const TLFieldDescriptor %1[] = {\n").arg(fieldsName);
+        code += fields;
+        code += QLatin1String("};\n\n");
+    }
+    code += QStringLiteral("static const TLConstructorDescriptor %1[] = {\n").arg(constructorsName);
+    code += constructors;
+    code += QLatin1String("};\n\n");
+    code += QStringLiteral("static const TLTypeDescriptor %1 = { %2, %3, %4 };\n\n")
+            .arg(descriptorName, constructorsName)
+            .arg(type.subTypes.count())
+            .arg(fieldsCount ? fieldsName : QStringLiteral("nullptr"));
+
+    code += QString("%1 &%1::operator>>(%2 &%3)\n{\n").arg(streamClassName, type.name, argName);
+    code += QString("%1%2 result;\n\n").arg(spacing, type.name);
+    code += QString("%1readByDescriptor(&result, &result.tlType, %2);\n\n").arg(spacing, descriptorName);
+    code += QString("%1%2 = result;\n\n%1return *this;\n}\n\n").arg(spacing, argName);
+    return code;
+}
+
 QString Generator::generateStreamReadVectorTemplate(const QString &type)
 {
     return QString(QLatin1String("template %1 &%1::operator>>(TLVector<%2> &v);")).arg(streamClassName, type);
@@ -793,6 +1005,23 @@ QString Generator::generateStreamWriteFreeOperatorDefinition(const TLType &type)
     return generateStreamOperatorDefinition(type, streamWriteFreeImplementationHead, streamWritePerTypeFreeImplementation, streamWriteFreeImplementationEnd);
 }
 
+QString Generator::generateSerializedSizeDeclaration(const TLType &type)
+{
+    QString argName = removePrefix(type.name);
+    argName[0] = argName.at(0).toLower();
+    argName += QLatin1String("Value");
+    return spacing + QString("static quint32 serializedSize(const %1 &%2);\n").arg(type.name).arg(argName);
+}
+
+QString Generator::generateSerializedSizeDefinition(const TLType &type)
+{
+    const QString typeName = type.name;
+    const auto perTypeImplementation = [typeName](const QString &argName, const TLSubType &subType) {
+        return serializedSizePerTypeImplementation(argName, subType, typeName);
+    };
+    return generateStreamOperatorDefinition(type, serializedSizeImplementationHead, perTypeImplementation, serializedSizeImplementationEnd);
+}
+
 QString Generator::generateStreamWriteVectorTemplate(const QString &type)
 {
     return QString(QLatin1String("template %1 &%1::operator<<(const TLVector<%2> &v);")).arg(streamClassName).arg(type);
@@ -838,6 +1067,8 @@ QString Generator::debugOperatorPerTypeImplementation(const QString &argName, co
         QString typeDebugStatement = QStringLiteral("type.%1");
         if (member.type().contains(QLatin1String("QByteArray"))) {
             typeDebugStatement = QStringLiteral("type.%1.toHex()");
+        } else if (member.type() == tlStringType) {
+            typeDebugStatement = QStringLiteral("type.%1.toString()");
         }
         typeDebugStatement = typeDebugStatement.arg(member.getAlias());
         if (member.dependOnFlag()) {
@@ -887,8 +1118,20 @@ QString Generator::generateConnectionMethodDefinition(const TLMethod &method, QS
 {
     QString result;
     result += QString("quint64 %1::%2(%3)\n{\n").arg(methodsClassName).arg(method.name).arg(formatMethodParams(method));
-    result += spacing + QLatin1String("QByteArray output;\n");
-    result += spacing + streamClassName + QLatin1String(" outputStream(&output, /* write */ true);\n");
+    result += spacing + QLatin1String("quint32 size = 4;\n");
+    foreach (const TLParam &param, method.params) {
+        if (param.dependOnFlag()) {
+            if (param.type() == tlTrueType) {
+                continue;
+            }
+            result += spacing + QString("if (%1 & 1 << %2) {\n").arg(param.flagMember).arg(param.flagBit);
+            result += spacing + spacing + QString("size += %1::serializedSize(%2);\n").arg(streamClassName, param.getAlias());
+            result += spacing + QLatin1String("}\n");
+        } else {
+            result += spacing + QString("size += %1::serializedSize(%2);\n").arg(streamClassName, param.getAlias());
+        }
+    }
+    result += spacing + streamClassName + QString(" outputStream(%1::WriteOnly, size);\n").arg(streamClassName);
 
     result += spacing + QString("outputStream << %1::%2;\n").arg(tlValueName, formatName(method.name, FirstLetterCase::Upper));
 
@@ -910,7 +1153,7 @@ QString Generator::generateConnectionMethodDefinition(const TLMethod &method, QS
         }
     }
 
-    result += spacing + QLatin1String("return sendEncryptedPackage(output);\n}\n\n");
+    result += spacing + QLatin1String("return sendRequest(outputStream.getData());\n}\n\n");
 
     return result;
 }
@@ -1225,7 +1468,8 @@ void Generator::getUsedAndVectorTypes(QStringList &usedTypes, QStringList &vecto
 }
 
 Generator::Generator() :
-    m_addSpecSources(false)
+    m_addSpecSources(false),
+    m_utf8Strings(false)
 {
 }
 
@@ -1240,6 +1484,7 @@ bool Generator::loadFromJson(const QByteArray &data)
     m_functions = readFunctionsJson(document);
     m_groups.append(m_types.keys());
     m_groups.append(m_functions.keys());
+    applyUtf8Strings();
     return true;
 }
 
@@ -1318,6 +1563,7 @@ bool Generator::loadFromText(const QByteArray &data)
         }
     }
 
+    applyUtf8Strings();
     return true;
 }
 
@@ -1344,9 +1590,13 @@ void Generator::generate()
     codeStreamReadDeclarations.clear();
     codeStreamReadDefinitions.clear();
     codeStreamReadTemplateInstancing.clear();
+    codeStreamReadTables.clear();
+    codeCorpusCodecs.clear();
     codeStreamWriteDeclarations.clear();
     codeStreamWriteDefinitions.clear();
     codeStreamWriteTemplateInstancing.clear();
+    codeSerializedSizeDeclarations.clear();
+    codeSerializedSizeDefinitions.clear();
     codeConnectionDeclarations.clear();
     codeConnectionDefinitions.clear();
     codeRpcProcessDeclarations.clear();
@@ -1520,15 +1770,20 @@ void Generator::generate()
 
         codeStreamReadDeclarations.append(generateStreamReadOperatorDeclaration(type));
         codeStreamReadDefinitions.append(generateStreamReadOperatorDefinition(type));
+        codeStreamReadTables.append(generateStreamReadTableDefinition(type));
 
         if (typesUsedForWrite.contains(type.name)) {
             codeStreamWriteDeclarations.append(generateStreamWriteOperatorDeclaration(type));
             codeStreamWriteDefinitions.append(generateStreamWriteOperatorDefinition(type));
-        } else {
+            codeSerializedSizeDeclarations.append(generateSerializedSizeDeclaration(type));
+            codeSerializedSizeDefinitions.append(generateSerializedSizeDefinition(type));
+        } else if (!typesWithCustomWriters.contains(type.name)) {
             codeStreamExtraWriteDeclarations.append(generateStreamWriteFreeOperatorDeclaration(&type));
             codeStreamExtraWriteDefinitions .append(generateStreamWriteFreeOperatorDefinition(type));
         }
 
+        codeCorpusCodecs.append(spacing + QStringLiteral("codecs.insert(QStringLiteral(\"%1\"), TypeCodec::create<%1>());\n").arg(type.name));
+
         codeDebugWriteDeclarations.append(generateDebugWriteOperatorDeclaration(type));
         codeDebugWriteDefinitions .append(generateDebugWriteOperatorDefinition(type));
     }
@@ -1649,6 +1904,44 @@ void Generator::setAddSpecSources(bool addSources)
     m_addSpecSources = addSources;
 }
 
+void Generator::setUtf8Strings(bool enabled)
+{
+    m_utf8Strings = enabled;
+}
+
+QString Generator::utf8StringType(const QString &type)
+{
+    static const QString nativeStringType = nativeTypes.at(plainTypes.indexOf(QLatin1String("string")));
+    if (type == nativeStringType) {
+        return tlStringType;
+    }
+    if (type == QString("%1<%2>").arg(tlVectorType, nativeStringType)) {
+        return QString("%1<%2>").arg(tlVectorType, tlStringType);
+    }
+    return type;
+}
+
+void Generator::applyUtf8Strings()
+{
+    if (!m_utf8Strings) {
+        return;
+    }
+
+    for (TLType &type : m_types) {
+        for (TLSubType &subType : type.subTypes) {
+            for (TLParam &member : subType.members) {
+                member.setType(utf8StringType(member.type()));
+            }
+        }
+    }
+    for (TLMethod &method : m_functions) {
+        method.type = utf8StringType(method.type);
+        for (TLParam &param : method.params) {
+            param.setType(utf8StringType(param.type()));
+        }
+    }
+}
+
 QString Generator::removeWord(QString input, QString word)
 {
     if (input.isEmpty()) {
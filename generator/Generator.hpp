@@ -154,14 +154,24 @@ public:
 
     void setAddSpecSources(bool addSources);
 
+    // Map TL "string" to TLString (UTF-8 slices of the response) instead of QString.
+    // Must be set before the schema is loaded.
+    void setUtf8Strings(bool enabled);
+    bool utf8Strings() const { return m_utf8Strings; }
+    static QString utf8StringType(const QString &type); // The type with the QString replaced by TLString
+
     static QString removeWord(QString input, QString word);
     static QString generateTLValuesDefinition(const TLType &type);
     static QString generateTLValuesDefinition(const TLMethod &method);
     static QString generateTLTypeDefinition(const TLType &type, bool addSpecSources = false);
     static QStringList generateTLTypeMemberFlags(const TLType &type);
+    static QStringList generateTLTypeFixedSizes(const TLType &type);
     static QStringList generateTLTypeMemberGetters(const TLType &type);
     static QStringList generateTLTypeMembers(const TLType &type);
 
+    // Returns the serialized size (including the type id) of a constructor with fixed-size members only or -1.
+    static int fixedLayoutSize(const TLSubType &subType);
+
     static QString streamReadImplementationHead(const QString &argName, const QString &typeName);
     static QString streamReadImplementationEnd(const QString &argName);
     static QString streamReadPerTypeImplementation(const QString &argName, const TLSubType &subType);
@@ -174,6 +184,10 @@ public:
     static QString streamWritePerTypeFreeImplementation(const QString &argName, const TLSubType &subType);
     static QString streamWritePerTypeImplementationBase(const QString &argName, const TLSubType &subType, const QString &streamGetter);
 
+    static QString serializedSizeImplementationHead(const QString &argName, const QString &typeName);
+    static QString serializedSizeImplementationEnd(const QString &argName);
+    static QString serializedSizePerTypeImplementation(const QString &argName, const TLSubType &subType, const QString &typeName);
+
     static QString generateStreamOperatorDefinition(const TLType &type,
                                                     std::function<QString(const QString &argName, const QString &typeName)> head,
                                                     std::function<QString(const QString &argName, const TLSubType &subType)> generateSubtypeCode,
@@ -183,11 +197,15 @@ public:
     static QString generateStreamReadFreeOperatorDeclaration(const NameWithEntityType *type);
     static QString generateStreamReadOperatorDefinition(const TLType &type);
     static QString generateStreamReadVectorTemplate(const QString &type);
+    static QString generateStreamReadTableDefinition(const TLType &type);
+    static QString tableFieldAccessor(const QString &typeName, const QString &memberName);
     static QString generateStreamWriteOperatorDeclaration(const TLType &type);
     static QString generateStreamWriteFreeOperatorDeclaration(const NameWithEntityType *type);
     static QString generateStreamWriteOperatorDefinition(const TLType &type);
     static QString generateStreamWriteFreeOperatorDefinition(const TLType &type);
     static QString generateStreamWriteVectorTemplate(const QString &type);
+    static QString generateSerializedSizeDeclaration(const TLType &type);
+    static QString generateSerializedSizeDefinition(const TLType &type);
     static QString generateStreamWriteFreeVectorTemplate(const QString &type);
 
     static QString generateDebugWriteOperatorDeclaration(const TLType &type);
@@ -209,18 +227,23 @@ public:
     static QList<TLType> solveTypes(QMap<QString, TLType> types, QMap<QString, TLType> *unresolved = nullptr);
 
     void getUsedAndVectorTypes(QStringList &usedTypes, QStringList &vectors) const;
+    void applyUtf8Strings();
 
     QString codeOfTLValues;
     QString codeOfTLTypes;
     QString codeStreamReadDeclarations;
     QString codeStreamReadDefinitions;
     QString codeStreamReadTemplateInstancing;
+    QString codeStreamReadTables;
     QString codeStreamWriteDeclarations;
     QString codeStreamWriteDefinitions;
     QString codeStreamWriteTemplateInstancing;
+    QString codeSerializedSizeDeclarations;
+    QString codeSerializedSizeDefinitions;
     QString codeStreamExtraReadDeclarations;
     QString codeStreamExtraWriteDeclarations;
     QString codeStreamExtraWriteDefinitions;
+    QString codeCorpusCodecs;
     QString codeConnectionDeclarations;
     QString codeConnectionDefinitions;
     QString codeRpcProcessDeclarations;
@@ -240,6 +263,7 @@ private:
     QMap<QString, TLMethod> m_functions;
     QVector<QStringList> m_groups;
     bool m_addSpecSources;
+    bool m_utf8Strings;
 };
 
 #endif // GENERATORNG_HPP
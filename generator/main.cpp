@@ -46,6 +46,7 @@ enum SchemaFormat {
 static bool s_dryRun = false;
 static bool s_dump = true;
 static bool s_addSpecSources = false;
+static bool s_utf8Strings = false;
 
 static const QByteArray c_textLayerMarker = QByteArrayLiteral("// LAYER ");
 
@@ -377,6 +378,7 @@ StatusCode generate(SchemaFormat format, const QString &specFileName)
 
     Generator generator;
     generator.setAddSpecSources(s_addSpecSources);
+    generator.setUtf8Strings(s_utf8Strings);
 
     bool success = true;
 
@@ -421,12 +423,16 @@ StatusCode generate(SchemaFormat format, const QString &specFileName)
     replacingHelper(QLatin1String("CTelegramStream.hpp"), 4, QLatin1String("read operators"), generator.codeStreamReadDeclarations);
     replacingHelper(QLatin1String("CTelegramStream.cpp"), 0, QLatin1String("read operators implementation"), generator.codeStreamReadDefinitions);
     replacingHelper(QLatin1String("CTelegramStream.cpp"), 0, QLatin1String("vector read templates instancing"), generator.codeStreamReadTemplateInstancing);
+    replacingHelper(QLatin1String("CTelegramStreamTables.cpp"), 0, QLatin1String("read tables"), generator.codeStreamReadTables);
     replacingHelper(QLatin1String("CTelegramStream.hpp"), 4, QLatin1String("write operators"), generator.codeStreamWriteDeclarations);
     replacingHelper(QLatin1String("CTelegramStream.cpp"), 0, QLatin1String("write operators implementation"), generator.codeStreamWriteDefinitions);
     replacingHelper(QLatin1String("CTelegramStream.cpp"), 0, QLatin1String("vector write templates instancing"), generator.codeStreamWriteTemplateInstancing);
+    replacingHelper(QLatin1String("CTelegramStream.hpp"), 4, QLatin1String("serialized size declarations"), generator.codeSerializedSizeDeclarations);
+    replacingHelper(QLatin1String("CTelegramStream.cpp"), 0, QLatin1String("serialized size implementation"), generator.codeSerializedSizeDefinitions);
 
     replacingHelper(QLatin1String("CTelegramStreamExtraOperators.hpp"), 0, QLatin1String("write operators"), generator.codeStreamExtraWriteDeclarations);
     replacingHelper(QLatin1String("CTelegramStreamExtraOperators.cpp"), 0, QLatin1String("write operators implementation"), generator.codeStreamExtraWriteDefinitions);
+    replacingHelper(QLatin1String("tests/tst_CTelegramStreamCorpus/tst_CTelegramStreamCorpus.cpp"), 4, QLatin1String("corpus codecs"), generator.codeCorpusCodecs);
 
     replacingHelper(QLatin1String("CTelegramConnection.hpp"), 4, QLatin1String("Telegram API methods declaration"), generator.codeConnectionDeclarations);
     replacingHelper(QLatin1String("CTelegramConnection.cpp"), 0, QLatin1String("Telegram API methods implementation"), generator.codeConnectionDefinitions);
@@ -476,6 +482,9 @@ int main(int argc, char *argv[])
     QCommandLineOption addSpecSourcesOption(QStringLiteral("add-spec-sources"));
     parser.addOption(addSpecSourcesOption);
 
+    QCommandLineOption utf8StringsOption(QStringLiteral("utf8-strings"));
+    parser.addOption(utf8StringsOption);
+
     QCommandLineOption fetchTextOption(QStringLiteral("fetch-text"));
     fetchTextOption.setValueName(QStringLiteral("url"));
     parser.addOption(fetchTextOption);
@@ -503,6 +512,7 @@ int main(int argc, char *argv[])
     s_dryRun = parser.isSet(dryRunOption);
     s_dump = parser.isSet(dumpOption);
     s_addSpecSources = parser.isSet(addSpecSourcesOption);
+    s_utf8Strings = parser.isSet(utf8StringsOption);
     s_inputDir = parser.value(inputDirOption);
     if (s_inputDir.isEmpty()) {
         s_inputDir = QStringLiteral("./");
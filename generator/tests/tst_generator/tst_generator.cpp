@@ -86,6 +86,9 @@ private slots:
     void checkTypeWithMemberConflicts();
     void recursiveTypeMembers();
     void doubleRecursiveTypeMembers();
+    void utf8StringMembers();
+    void fixedLayoutCodecs();
+    void readTables();
 };
 
 tst_Generator::tst_Generator(QObject *parent) :
@@ -235,6 +238,108 @@ void tst_Generator::doubleRecursiveTypeMembers()
     }
 }
 
+void tst_Generator::utf8StringMembers()
+{
+    const QStringList sources = c_sourcesRichText;
+    const QString generatedTypeName = Generator::parseLine(c_sourcesRichText.first()).typeName;
+    const QStringList functions = {
+        QStringLiteral("account.checkUsername#2714d86c username:string = Bool;"),
+    };
+    const QByteArray textData = generateTextSpec(sources, functions);
+    Generator generator;
+    generator.setUtf8Strings(true);
+    QVERIFY(generator.utf8Strings());
+    const bool loaded = generator.loadFromText(textData) && generator.resolveTypes();
+    QVERIFY(loaded);
+
+    // The option is per generator
+    Generator defaultGenerator;
+    QVERIFY(!defaultGenerator.utf8Strings());
+    QVERIFY(defaultGenerator.loadFromText(textData) && defaultGenerator.resolveTypes());
+    const QStringList defaultMembers = Generator::generateTLTypeMembers(getSolvedType(defaultGenerator, generatedTypeName));
+    QVERIFY(defaultMembers.contains(QStringLiteral("QString email;")));
+
+    const TLMethod method = generator.functions().value(QStringLiteral("accountCheckUsername"));
+    QCOMPARE(method.params.count(), 1);
+    QCOMPARE(method.params.first().type(), QStringLiteral("TLString"));
+    QCOMPARE(defaultGenerator.functions().value(QStringLiteral("accountCheckUsername")).params.first().type(), QStringLiteral("QString"));
+
+    const TLType solvedType = getSolvedType(generator, generatedTypeName);
+    QVERIFY(!solvedType.name.isEmpty());
+    const QStringList structMembers = Generator::generateTLTypeMembers(solvedType);
+    static const QStringList checkList = {
+        QStringLiteral("TLString email;"),
+        QStringLiteral("TLString stringText;"),
+        QStringLiteral("quint64 webpageId;"),
+    };
+    for (const QString &mustHaveMember : checkList) {
+        if (!structMembers.contains(mustHaveMember)) {
+            QString message = QStringLiteral("The member \"%1\" is missing in the generated struct of the type %2.").arg(mustHaveMember, generatedTypeName);
+            QFAIL(message.toUtf8().constData());
+        }
+    }
+}
+
+void tst_Generator::fixedLayoutCodecs()
+{
+    const QStringList sources = {
+        QStringLiteral("inputPeerEmpty#7f3b18ea = InputPeer;"),
+        QStringLiteral("inputPeerChat#179be863 chat_id:int = InputPeer;"),
+        QStringLiteral("inputPeerUser#7b8e7de6 user_id:int access_hash:long = InputPeer;"),
+    };
+    const QByteArray textData = generateTextSpec(sources);
+    Generator generator;
+    QVERIFY(generator.loadFromText(textData));
+    QVERIFY(generator.resolveTypes());
+    const TLType solvedType = getSolvedType(generator, Generator::parseLine(sources.first()).typeName);
+    QVERIFY(!solvedType.name.isEmpty());
+    QCOMPARE(solvedType.subTypes.count(), 3);
+
+    QHash<QString,int> sizes;
+    for (const TLSubType &subType : solvedType.subTypes) {
+        sizes.insert(subType.name, Generator::fixedLayoutSize(subType));
+    }
+    QCOMPARE(sizes.value(QStringLiteral("InputPeerEmpty")), 4);
+    QCOMPARE(sizes.value(QStringLiteral("InputPeerChat")), 8);
+    QCOMPARE(sizes.value(QStringLiteral("InputPeerUser")), 16);
+
+    const QStringList sizeConstants = Generator::generateTLTypeFixedSizes(solvedType);
+    QVERIFY(sizeConstants.contains(QStringLiteral("static constexpr quint32 InputPeerUserSize = 16;")));
+    QVERIFY(!sizeConstants.contains(QStringLiteral("static constexpr quint32 InputPeerEmptySize = 4;")));
+
+    const QString readCode = Generator::generateStreamReadOperatorDefinition(solvedType);
+    QVERIFY(readCode.contains(QStringLiteral("readFixedLayout(result.userId, result.accessHash);")));
+    QVERIFY(readCode.contains(QStringLiteral("*this >> result.chatId;")));
+
+    const QString sizeCode = Generator::generateSerializedSizeDefinition(solvedType);
+    QVERIFY(sizeCode.contains(QStringLiteral("size = TLInputPeer::InputPeerUserSize;")));
+    QVERIFY(sizeCode.contains(QStringLiteral("size = TLInputPeer::InputPeerChatSize;")));
+    QVERIFY(!sizeCode.contains(QStringLiteral("InputPeerEmptySize")));
+}
+
+void tst_Generator::readTables()
+{
+    const QStringList sources = {
+        QStringLiteral("inputPeerEmpty#7f3b18ea = InputPeer;"),
+        QStringLiteral("inputPeerUser#7b8e7de6 user_id:int access_hash:long = InputPeer;"),
+        QStringLiteral("inputPeerChannel#20adaef8 channel_id:int access_hash:long = InputPeer;"),
+    };
+    const QByteArray textData = generateTextSpec(sources);
+    Generator generator;
+    QVERIFY(generator.loadFromText(textData));
+    QVERIFY(generator.resolveTypes());
+    const TLType solvedType = getSolvedType(generator, Generator::parseLine(sources.first()).typeName);
+    QVERIFY(!solvedType.name.isEmpty());
+
+    const QString tablesCode = Generator::generateStreamReadTableDefinition(solvedType);
+    QVERIFY(tablesCode.contains(QStringLiteral("{ &fieldAddress<TLInputPeer, decltype(TLInputPeer::userId), &TLInputPeer::userId>, TLFieldDescriptor::UInt32, -1, nullptr, nullptr },")));
+    QVERIFY(tablesCode.contains(QStringLiteral("{ &fieldAddress<TLInputPeer, decltype(TLInputPeer::accessHash), &TLInputPeer::accessHash>, TLFieldDescriptor::UInt64, -1, nullptr, nullptr },")));
+    QVERIFY(!tablesCode.contains(QStringLiteral("offsetof")));
+    QVERIFY(tablesCode.contains(QStringLiteral("{ TLValue::InputPeerEmpty, 0, 0 },")));
+    QVERIFY(tablesCode.contains(QStringLiteral("static const TLTypeDescriptor s_inputPeerDescriptor = { s_inputPeerConstructors, 3, s_inputPeerFields };")));
+    QVERIFY(tablesCode.contains(QStringLiteral("readByDescriptor(&result, &result.tlType, s_inputPeerDescriptor);")));
+}
+
 QTEST_APPLESS_MAIN(tst_Generator)
 
 #include "tst_generator.moc"
@@ -1,5 +1,6 @@
 #options = developer-build
 #options += static-lib
+#options += table-decoder
 
 # Installation directories
 isEmpty(INSTALL_PREFIX) {
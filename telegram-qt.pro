@@ -69,6 +69,9 @@ contains(options, developer-build) {
     } else {
         message("Use Qt 5.6.0 or higher to build GeneratorNG")
     }
+    equals(BUILD_WIDGETS_CLIENT, "true") {
+        SUBDIRS += clients/widgets/tests
+    }
 }
 
 OTHER_FILES += CMakeLists.txt